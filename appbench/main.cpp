@@ -100,7 +100,9 @@ static int runQtApplication(int argc, char* argv[], qtwebapp::LoggerWithFile *lo
           // This will run the task from the application event loop
           QTimer::singleShot(0, &m, SLOT(run()));
 
-          return a.exec();
+          int res = a.exec();
+
+          return m.getNbFailures() != 0 ? 1 : res;
           }
 
       int main(int argc, char* argv[])
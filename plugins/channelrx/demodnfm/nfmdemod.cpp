@@ -57,6 +57,7 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
     m_thread = new QThread(this);
     m_basebandSink = new NFMDemodBaseband();
     m_basebandSink->moveToThread(m_thread);
+    m_basebandSink->setChannelStream(&m_channelStream);
 
 	applySettings(m_settings, true);
 
@@ -157,6 +158,9 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
             << " m_reverseAPIPort: " << settings.m_reverseAPIPort
             << " m_reverseAPIDeviceIndex: " << settings.m_reverseAPIDeviceIndex
             << " m_reverseAPIChannelIndex: " << settings.m_reverseAPIChannelIndex
+            << " m_wsStreamEnable: " << settings.m_wsStreamEnable
+            << " m_wsStreamAddress: " << settings.m_wsStreamAddress
+            << " m_wsStreamPort: " << settings.m_wsStreamPort
             << " force: " << force;
 
     QList<QString> reverseAPIKeys;
@@ -206,6 +210,22 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force) {
         reverseAPIKeys.append("audioDeviceName");
     }
+    if ((settings.m_wsStreamEnable != m_settings.m_wsStreamEnable) || force) {
+        reverseAPIKeys.append("wsStreamEnable");
+    }
+    if ((settings.m_wsStreamAddress != m_settings.m_wsStreamAddress) || force) {
+        reverseAPIKeys.append("wsStreamAddress");
+    }
+    if ((settings.m_wsStreamPort != m_settings.m_wsStreamPort) || force) {
+        reverseAPIKeys.append("wsStreamPort");
+    }
+
+    if ((settings.m_wsStreamEnable != m_settings.m_wsStreamEnable)
+     || (settings.m_wsStreamAddress != m_settings.m_wsStreamAddress)
+     || (settings.m_wsStreamPort != m_settings.m_wsStreamPort) || force)
+    {
+        applyChannelStream(settings);
+    }
 
     if (m_settings.m_streamIndex != settings.m_streamIndex)
     {
@@ -236,6 +256,20 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     m_settings = settings;
 }
 
+void NFMDemod::applyChannelStream(const NFMDemodSettings& settings)
+{
+    if (m_channelStream.socketOpened()) {
+        m_channelStream.closeSocket();
+    }
+
+    m_channelStream.setListeningAddress(settings.m_wsStreamAddress);
+    m_channelStream.setPort(settings.m_wsStreamPort);
+
+    if (settings.m_wsStreamEnable) {
+        m_channelStream.openSocket();
+    }
+}
+
 QByteArray NFMDemod::serialize() const
 {
     return m_settings.serialize();
@@ -360,6 +394,15 @@ void NFMDemod::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("reverseAPIChannelIndex")) {
         settings.m_reverseAPIChannelIndex = response.getNfmDemodSettings()->getReverseApiChannelIndex();
     }
+    if (channelSettingsKeys.contains("wsStreamEnable")) {
+        settings.m_wsStreamEnable = response.getNfmDemodSettings()->getWsStreamEnable() != 0;
+    }
+    if (channelSettingsKeys.contains("wsStreamAddress")) {
+        settings.m_wsStreamAddress = *response.getNfmDemodSettings()->getWsStreamAddress();
+    }
+    if (channelSettingsKeys.contains("wsStreamPort")) {
+        settings.m_wsStreamPort = response.getNfmDemodSettings()->getWsStreamPort();
+    }
 }
 
 int NFMDemod::webapiReportGet(
@@ -413,6 +456,15 @@ void NFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& resp
     response.getNfmDemodSettings()->setReverseApiPort(settings.m_reverseAPIPort);
     response.getNfmDemodSettings()->setReverseApiDeviceIndex(settings.m_reverseAPIDeviceIndex);
     response.getNfmDemodSettings()->setReverseApiChannelIndex(settings.m_reverseAPIChannelIndex);
+    response.getNfmDemodSettings()->setWsStreamEnable(settings.m_wsStreamEnable ? 1 : 0);
+
+    if (response.getNfmDemodSettings()->getWsStreamAddress()) {
+        *response.getNfmDemodSettings()->getWsStreamAddress() = settings.m_wsStreamAddress;
+    } else {
+        response.getNfmDemodSettings()->setWsStreamAddress(new QString(settings.m_wsStreamAddress));
+    }
+
+    response.getNfmDemodSettings()->setWsStreamPort(settings.m_wsStreamPort);
 }
 
 void NFMDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
@@ -498,6 +550,15 @@ void NFMDemod::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, co
     if (channelSettingsKeys.contains("streamIndex") || force) {
         swgNFMDemodSettings->setStreamIndex(settings.m_streamIndex);
     }
+    if (channelSettingsKeys.contains("wsStreamEnable") || force) {
+        swgNFMDemodSettings->setWsStreamEnable(settings.m_wsStreamEnable ? 1 : 0);
+    }
+    if (channelSettingsKeys.contains("wsStreamAddress") || force) {
+        swgNFMDemodSettings->setWsStreamAddress(new QString(settings.m_wsStreamAddress));
+    }
+    if (channelSettingsKeys.contains("wsStreamPort") || force) {
+        swgNFMDemodSettings->setWsStreamPort(settings.m_wsStreamPort);
+    }
 
     QString channelSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/channel/%4/settings")
             .arg(settings.m_reverseAPIAddress)
@@ -26,6 +26,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
 #include "util/message.h"
+#include "websockets/wschannelstream.h"
 
 #include "nfmdemodbaseband.h"
 #include "nfmdemodsettings.h"
@@ -127,6 +128,7 @@ private:
     NFMDemodBaseband* m_basebandSink;
 	NFMDemodSettings m_settings;
     int m_basebandSampleRate; //!< stored from device message used when starting baseband sink
+    WSChannelStream m_channelStream;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
@@ -134,6 +136,7 @@ private:
     static const int m_udpBlockSize;
 
     void applySettings(const NFMDemodSettings& settings, bool force = false);
+    void applyChannelStream(const NFMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const NFMDemodSettings& settings, bool force);
 
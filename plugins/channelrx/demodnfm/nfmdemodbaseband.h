@@ -67,6 +67,7 @@ public:
     bool getSquelchOpen() const { return m_sink.getSquelchOpen(); }
     const Real *getCtcssToneSet(int& nbTones) const { return m_sink.getCtcssToneSet(nbTones); }
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_sink.setMessageQueueToGUI(messageQueue); }
+    void setChannelStream(WSChannelStream *channelStream) { m_sink.setChannelStream(channelStream); }
     unsigned int getAudioSampleRate() const { return m_sink.getAudioSampleRate(); }
     void setBasebandSampleRate(int sampleRate);
 
@@ -60,6 +60,9 @@ void NFMDemodSettings::resetToDefaults()
     m_reverseAPIPort = 8888;
     m_reverseAPIDeviceIndex = 0;
     m_reverseAPIChannelIndex = 0;
+    m_wsStreamEnable = false;
+    m_wsStreamAddress = "127.0.0.1";
+    m_wsStreamPort = 8890;
 }
 
 QByteArray NFMDemodSettings::serialize() const
@@ -90,6 +93,9 @@ QByteArray NFMDemodSettings::serialize() const
     s.writeU32(19, m_reverseAPIDeviceIndex);
     s.writeU32(20, m_reverseAPIChannelIndex);
     s.writeS32(21, m_streamIndex);
+    s.writeBool(22, m_wsStreamEnable);
+    s.writeString(23, m_wsStreamAddress);
+    s.writeU32(24, m_wsStreamPort);
 
     return s.final();
 }
@@ -151,6 +157,15 @@ bool NFMDemodSettings::deserialize(const QByteArray& data)
         d.readU32(20, &utmp, 0);
         m_reverseAPIChannelIndex = utmp > 99 ? 99 : utmp;
         d.readS32(21, &m_streamIndex, 0);
+        d.readBool(22, &m_wsStreamEnable, false);
+        d.readString(23, &m_wsStreamAddress, "127.0.0.1");
+        d.readU32(24, &utmp, 8890);
+
+        if ((utmp > 1023) && (utmp < 65535)) {
+            m_wsStreamPort = utmp;
+        } else {
+            m_wsStreamPort = 8890;
+        }
 
         return true;
     }
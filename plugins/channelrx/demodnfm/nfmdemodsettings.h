@@ -49,6 +49,9 @@ struct NFMDemodSettings
     uint16_t m_reverseAPIPort;
     uint16_t m_reverseAPIDeviceIndex;
     uint16_t m_reverseAPIChannelIndex;
+    bool m_wsStreamEnable;       //!< Serve channel audio and I/Q on a WebSocket
+    QString m_wsStreamAddress;   //!< WebSocket listening address
+    uint16_t m_wsStreamPort;     //!< WebSocket listening port
 
     Serializable *m_channelMarker;
 
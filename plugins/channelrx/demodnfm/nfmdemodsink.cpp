@@ -28,6 +28,7 @@
 #include "dsp/dspcommands.h"
 #include "dsp/devicesamplemimo.h"
 #include "device/deviceapi.h"
+#include "websockets/wschannelstream.h"
 
 #include "nfmdemodreport.h"
 #include "nfmdemodsink.h"
@@ -54,7 +55,9 @@ NFMDemodSink::NFMDemodSink() :
         m_magsqCount(0),
         m_afSquelch(),
         m_squelchDelayLine(24000),
-        m_messageQueueToGUI(nullptr)
+        m_messageQueueToGUI(nullptr),
+        m_channelStream(nullptr),
+        m_streamAudioIndex(0)
 {
 	m_agcLevel = 1.0;
     m_audioBuffer.resize(1<<14);
@@ -70,12 +73,17 @@ NFMDemodSink::~NFMDemodSink()
 void NFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
 	Complex ci;
+    bool streamIQ = m_channelStream && m_channelStream->hasIQSubscribers();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
+        if (streamIQ) {
+            m_streamIQBuffer.push_back(Sample(c.real(), c.imag()));
+        }
+
         if (m_interpolatorDistance < 1.0f) // interpolate
         {
             while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
@@ -94,6 +102,33 @@ void NFMDemodSink::feed(const SampleVector::const_iterator& begin, const SampleV
         }
     }
 
+    if (streamIQ)
+    {
+        m_channelStream->writeIQ(m_streamIQBuffer.begin(), m_streamIQBuffer.end());
+        m_streamIQBuffer.clear();
+    }
+
+    streamAudio();
+}
+
+void NFMDemodSink::streamAudio()
+{
+    if (m_channelStream && (m_audioBufferFill > m_streamAudioIndex)) {
+        m_channelStream->writeAudio(&m_audioBuffer[m_streamAudioIndex], m_audioBufferFill - m_streamAudioIndex);
+    }
+
+    m_streamAudioIndex = m_audioBufferFill;
+}
+
+void NFMDemodSink::setChannelStream(WSChannelStream *channelStream)
+{
+    m_channelStream = channelStream;
+
+    if (m_channelStream)
+    {
+        m_channelStream->setAudioFormat(m_audioSampleRate, false);
+        m_channelStream->setIQSampleRate(m_channelSampleRate);
+    }
 }
 
 void NFMDemodSink::processOneSample(Complex &ci)
@@ -253,6 +288,7 @@ void NFMDemodSink::processOneSample(Complex &ci)
 
     if (m_audioBufferFill >= m_audioBuffer.size())
     {
+        streamAudio();
         uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
         if (res != m_audioBufferFill)
@@ -262,6 +298,7 @@ void NFMDemodSink::processOneSample(Complex &ci)
         }
 
         m_audioBufferFill = 0;
+        m_streamAudioIndex = 0;
     }
 }
 
@@ -287,6 +324,10 @@ void NFMDemodSink::applyChannelSettings(int channelSampleRate, int channelFreque
 
     m_channelSampleRate = channelSampleRate;
     m_channelFrequencyOffset = channelFrequencyOffset;
+
+    if (m_channelStream) {
+        m_channelStream->setIQSampleRate(m_channelSampleRate);
+    }
 }
 
 void NFMDemodSink::applySettings(const NFMDemodSettings& settings, bool force)
@@ -382,4 +423,8 @@ void NFMDemodSink::applyAudioSampleRate(unsigned int sampleRate)
     m_squelchDelayLine.resize(sampleRate/2);
 
     m_audioSampleRate = sampleRate;
+
+    if (m_channelStream) {
+        m_channelStream->setAudioFormat(m_audioSampleRate, false);
+    }
 }
\ No newline at end of file
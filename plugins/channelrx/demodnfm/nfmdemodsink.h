@@ -35,6 +35,8 @@
 
 #include "nfmdemodsettings.h"
 
+class WSChannelStream;
+
 class NFMDemodSink : public ChannelSampleSink {
 public:
     NFMDemodSink();
@@ -74,6 +76,7 @@ public:
     void applyChannelSettings(int channelSampleRate, int channelFrequencyOffset, bool force = false);
     void applySettings(const NFMDemodSettings& settings, bool force = false);
     void setMessageQueueToGUI(MessageQueue *messageQueue) { m_messageQueueToGUI = messageQueue; }
+    void setChannelStream(WSChannelStream *channelStream);
 
     AudioFifo *getAudioFifo() { return &m_audioFifo; }
     void applyAudioSampleRate(unsigned int sampleRate);
@@ -136,11 +139,15 @@ private:
 
     PhaseDiscriminators m_phaseDiscri;
     MessageQueue *m_messageQueueToGUI;
+    WSChannelStream *m_channelStream;
+    SampleVector m_streamIQBuffer;  //!< channel I/Q of a feed call for the channel stream
+    uint m_streamAudioIndex;        //!< audio samples before this index in m_audioBuffer were given to the channel stream
 
     static const double afSqTones[];
     static const double afSqTones_lowrate[];
 
     void processOneSample(Complex &ci);
+    void streamAudio();
     MessageQueue *getMessageQueueToGUI() { return m_messageQueueToGUI; }
 
     inline float arctan2(Real y, Real x)
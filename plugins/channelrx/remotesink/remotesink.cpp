@@ -29,6 +29,8 @@
 #include <QThread>
 
 #include "SWGChannelSettings.h"
+#include "SWGChannelReport.h"
+#include "SWGRemoteSinkReport.h"
 
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
@@ -36,8 +38,10 @@
 #include "dsp/devicesamplemimo.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "device/deviceapi.h"
+#include "channel/remotecodec.h"
 
 #include "remotesinkbaseband.h"
+#include "remotesinksender.h"
 
 MESSAGE_CLASS_DEFINITION(RemoteSink::MsgConfigureRemoteSink, Message)
 
@@ -48,7 +52,9 @@ RemoteSink::RemoteSink(DeviceAPI *deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
         m_deviceAPI(deviceAPI),
         m_frequencyOffset(0),
-        m_basebandSampleRate(0)
+        m_basebandSampleRate(0),
+        m_reportNbPackets(0),
+        m_reportNbSyscalls(0)
 {
     setObjectName(m_channelId);
 
@@ -57,6 +63,7 @@ RemoteSink::RemoteSink(DeviceAPI *deviceAPI) :
     m_basebandSink->moveToThread(m_thread);
 
     applySettings(m_settings, true);
+    m_reportTimer.start();
 
     m_deviceAPI->addChannelSink(this);
     m_deviceAPI->addChannelSinkAPI(this);
@@ -174,6 +181,10 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
             << " m_streamIndex: " << settings.m_streamIndex
+            << " m_fecPipelineDepth: " << settings.m_fecPipelineDepth
+            << " m_codec: " << settings.m_codec
+            << " m_sharedMemory: " << settings.m_sharedMemory
+            << " m_shmName: " << settings.m_shmName
             << " force: " << force;
 
     QList<QString> reverseAPIKeys;
@@ -185,6 +196,18 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
     if ((m_settings.m_txDelay != settings.m_txDelay) || force) {
         reverseAPIKeys.append("txDelay");
     }
+    if ((m_settings.m_fecPipelineDepth != settings.m_fecPipelineDepth) || force) {
+        reverseAPIKeys.append("fecPipelineDepth");
+    }
+    if ((m_settings.m_codec != settings.m_codec) || force) {
+        reverseAPIKeys.append("codec");
+    }
+    if ((m_settings.m_sharedMemory != settings.m_sharedMemory) || force) {
+        reverseAPIKeys.append("sharedMemory");
+    }
+    if ((m_settings.m_shmName != settings.m_shmName) || force) {
+        reverseAPIKeys.append("shmName");
+    }
     if ((m_settings.m_dataAddress != settings.m_dataAddress) || force) {
         reverseAPIKeys.append("dataAddress");
     }
@@ -297,6 +320,17 @@ int RemoteSink::webapiSettingsPutPatch(
     return 200;
 }
 
+int RemoteSink::webapiReportGet(
+        SWGSDRangel::SWGChannelReport& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setRemoteSinkReport(new SWGSDRangel::SWGRemoteSinkReport());
+    response.getRemoteSinkReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
 void RemoteSink::webapiUpdateChannelSettings(
         RemoteSinkSettings& settings,
         const QStringList& channelSettingsKeys,
@@ -324,6 +358,26 @@ void RemoteSink::webapiUpdateChannelSettings(
         }
     }
 
+    if (channelSettingsKeys.contains("fecPipelineDepth"))
+    {
+        int fecPipelineDepth = response.getRemoteSinkSettings()->getFecPipelineDepth();
+        settings.m_fecPipelineDepth = fecPipelineDepth < 1 ? 1 : fecPipelineDepth > 16 ? 16 : fecPipelineDepth;
+    }
+
+    if (channelSettingsKeys.contains("codec"))
+    {
+        int codec = response.getRemoteSinkSettings()->getCodec();
+        settings.m_codec = RemoteCodec::isValid(codec) ? codec : 0;
+    }
+
+    if (channelSettingsKeys.contains("sharedMemory")) {
+        settings.m_sharedMemory = response.getRemoteSinkSettings()->getSharedMemory() != 0;
+    }
+
+    if (channelSettingsKeys.contains("shmName")) {
+        settings.m_shmName = *response.getRemoteSinkSettings()->getShmName();
+    }
+
     if (channelSettingsKeys.contains("dataAddress")) {
         settings.m_dataAddress = *response.getRemoteSinkSettings()->getDataAddress();
     }
@@ -380,6 +434,15 @@ void RemoteSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& re
 {
     response.getRemoteSinkSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
     response.getRemoteSinkSettings()->setTxDelay(settings.m_txDelay);
+    response.getRemoteSinkSettings()->setFecPipelineDepth(settings.m_fecPipelineDepth);
+    response.getRemoteSinkSettings()->setCodec(settings.m_codec);
+    response.getRemoteSinkSettings()->setSharedMemory(settings.m_sharedMemory ? 1 : 0);
+
+    if (response.getRemoteSinkSettings()->getShmName()) {
+        *response.getRemoteSinkSettings()->getShmName() = settings.m_shmName;
+    } else {
+        response.getRemoteSinkSettings()->setShmName(new QString(settings.m_shmName));
+    }
 
     if (response.getRemoteSinkSettings()->getDataAddress()) {
         *response.getRemoteSinkSettings()->getDataAddress() = settings.m_dataAddress;
@@ -412,6 +475,26 @@ void RemoteSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& re
     response.getRemoteSinkSettings()->setReverseApiChannelIndex(settings.m_reverseAPIChannelIndex);
 }
 
+void RemoteSink::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    const RemoteSinkSender *sender = m_basebandSink->getSender();
+    uint64_t nbPackets = sender->getNbPackets();
+    uint64_t nbSyscalls = sender->getNbSyscalls();
+    qint64 elapsed = m_reportTimer.restart();
+
+    response.getRemoteSinkReport()->setPacketsCount(nbPackets);
+    response.getRemoteSinkReport()->setSyscallsCount(nbSyscalls);
+    response.getRemoteSinkReport()->setPacketsPerSecond(elapsed > 0 ? ((nbPackets - m_reportNbPackets) * 1000.0f) / elapsed : 0.0f);
+    response.getRemoteSinkReport()->setPacketsPerSyscall(nbSyscalls > m_reportNbSyscalls ?
+        (float) (nbPackets - m_reportNbPackets) / (nbSyscalls - m_reportNbSyscalls) : 0.0f);
+    response.getRemoteSinkReport()->setSendMode((int) sender->getSendMode());
+    response.getRemoteSinkReport()->setLossyBlocksCount(m_basebandSink->getNbLossyBlocks());
+    response.getRemoteSinkReport()->setDroppedBitsCount(m_basebandSink->getNbDroppedLSBs());
+
+    m_reportNbPackets = nbPackets;
+    m_reportNbSyscalls = nbSyscalls;
+}
+
 void RemoteSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RemoteSinkSettings& settings, bool force)
 {
     SWGSDRangel::SWGChannelSettings *swgChannelSettings = new SWGSDRangel::SWGChannelSettings();
@@ -431,6 +514,18 @@ void RemoteSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys,
     {
         swgRemoteSinkSettings->setTxDelay(settings.m_txDelay);
     }
+    if (channelSettingsKeys.contains("fecPipelineDepth") || force) {
+        swgRemoteSinkSettings->setFecPipelineDepth(settings.m_fecPipelineDepth);
+    }
+    if (channelSettingsKeys.contains("codec") || force) {
+        swgRemoteSinkSettings->setCodec(settings.m_codec);
+    }
+    if (channelSettingsKeys.contains("sharedMemory") || force) {
+        swgRemoteSinkSettings->setSharedMemory(settings.m_sharedMemory ? 1 : 0);
+    }
+    if (channelSettingsKeys.contains("shmName") || force) {
+        swgRemoteSinkSettings->setShmName(new QString(settings.m_shmName));
+    }
     if (channelSettingsKeys.contains("dataAddress") || force) {
         swgRemoteSinkSettings->setDataAddress(new QString(settings.m_dataAddress));
     }
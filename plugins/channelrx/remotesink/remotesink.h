@@ -26,6 +26,7 @@
 
 #include <QObject>
 #include <QNetworkRequest>
+#include <QElapsedTimer>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -97,6 +98,10 @@ public:
             SWGSDRangel::SWGChannelSettings& response,
             QString& errorMessage);
 
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage);
+
     static void webapiFormatChannelSettings(
         SWGSDRangel::SWGChannelSettings& response,
         const RemoteSinkSettings& settings);
@@ -128,9 +133,14 @@ private:
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
+    QElapsedTimer m_reportTimer;   //!< Time since the previous report for the transmission rates
+    uint64_t m_reportNbPackets;    //!< Datagrams sent at the previous report
+    uint64_t m_reportNbSyscalls;   //!< System calls at the previous report
+
     void applySettings(const RemoteSinkSettings& settings, bool force = false);
     static void validateFilterChainHash(RemoteSinkSettings& settings);
     void calculateFrequencyOffset();
+    void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const RemoteSinkSettings& settings, bool force);
 
 private slots:
@@ -68,6 +68,9 @@ public:
     MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; } //!< Get the queue for asynchronous inbound communication
     int getChannelSampleRate() const;
     void setBasebandSampleRate(int sampleRate);
+    const RemoteSinkSender *getSender() const { return m_sink.getSender(); }
+    uint64_t getNbLossyBlocks() const { return m_sink.getNbLossyBlocks(); }
+    uint64_t getNbDroppedLSBs() const { return m_sink.getNbDroppedLSBs(); }
 
 private:
     SampleSinkFifo m_sampleFifo;
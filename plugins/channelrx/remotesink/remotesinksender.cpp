@@ -24,23 +24,67 @@
 
 #include <thread>
 #include <chrono>
+#include <algorithm>
+#include <vector>
 
 #include <QUdpSocket>
+#include <QRunnable>
+#include <QThread>
 
 #include "cm256cc/cm256.h"
 
 #include "channel/remotedatablock.h"
 #include "remotesinksender.h"
 
+class RemoteSinkSender::EncodeTask : public QRunnable
+{
+public:
+    EncodeTask(RemoteSinkSender *sender, quint64 sequence, RemoteDataBlock *dataBlock) :
+        m_sender(sender),
+        m_sequence(sequence),
+        m_dataBlock(dataBlock)
+    {}
+
+    virtual void run()
+    {
+        encodeDataBlock(m_sender->m_cm256p, m_dataBlock);
+        m_sender->encoded(m_sequence);
+        emit m_sender->frameEncoded();
+    }
+
+private:
+    RemoteSinkSender *m_sender;
+    quint64 m_sequence;
+    RemoteDataBlock *m_dataBlock;
+};
+
 RemoteSinkSender::RemoteSinkSender() :
     m_fifo(20, this),
     m_address(QHostAddress::LocalHost),
-    m_socket(nullptr)
+    m_socket(nullptr),
+    m_batchSender("RemoteSinkSender"),
+    m_gso(false),
+    m_sendMode(SendQt),
+    m_nbPackets(0),
+    m_nbSyscalls(0),
+    m_fecPipelineDepth(4),
+    m_nextSubmit(0),
+    m_nextSend(0)
 {
     qDebug("RemoteSinkSender::RemoteSinkSender");
     m_cm256p = m_cm256.isInitialized() ? &m_cm256 : nullptr;
     m_socket = new QUdpSocket(this);
 
+    if (m_batchSender.isOpen())
+    {
+        m_gso = m_batchSender.probeGSO(RemoteUdpSize);
+        qDebug("RemoteSinkSender::RemoteSinkSender: sendmmsg %s UDP GSO", m_gso ? "with" : "without");
+    }
+    else
+    {
+        qDebug("RemoteSinkSender::RemoteSinkSender: using Qt socket");
+    }
+
     QObject::connect(
         &m_fifo,
         &RemoteSinkFifo::dataBlockServed,
@@ -48,11 +92,20 @@ RemoteSinkSender::RemoteSinkSender() :
         &RemoteSinkSender::handleData,
         Qt::QueuedConnection
     );
+
+    QObject::connect(
+        this,
+        &RemoteSinkSender::frameEncoded,
+        this,
+        &RemoteSinkSender::sendEncoded,
+        Qt::QueuedConnection
+    );
 }
 
 RemoteSinkSender::~RemoteSinkSender()
 {
     qDebug("RemoteSinkSender::~RemoteSinkSender");
+    m_encoderPool.waitForDone();
     delete m_socket;
 }
 
@@ -71,81 +124,206 @@ void RemoteSinkSender::handleData()
         remainder = m_fifo.readDataBlock(&dataBlock);
 
         if (dataBlock) {
-            sendDataBlock(dataBlock);
+            queueDataBlock(dataBlock);
+        }
+    }
+
+    sendEncoded();
+}
+
+void RemoteSinkSender::queueDataBlock(RemoteDataBlock *dataBlock)
+{
+    unsigned int depth = m_fecPipelineDepth.load();
+    bool fec = (dataBlock->m_txControlBlock.m_nbBlocksFEC != 0) && m_cm256p;
+
+    if ((depth <= 1) && m_pipeline.empty()) // serial processing
+    {
+        if (fec) {
+            encodeDataBlock(m_cm256p, dataBlock);
+        }
+
+        transmitDataBlock(dataBlock);
+        return;
+    }
+
+    // make room in the pipeline by transmitting the head frame as soon as it is encoded
+    while (m_pipeline.size() >= std::max(1U, depth))
+    {
+        m_pipelineMutex.lock();
+
+        while (m_encodedFrames.count(m_nextSend) == 0) {
+            m_pipelineCondition.wait(&m_pipelineMutex);
+        }
+
+        m_pipelineMutex.unlock();
+        sendEncoded();
+    }
+
+    int nbThreads = std::max(1, std::min((int) depth, QThread::idealThreadCount()));
+
+    if (m_encoderPool.maxThreadCount() != nbThreads) {
+        m_encoderPool.setMaxThreadCount(nbThreads);
+    }
+
+    quint64 sequence = m_nextSubmit++;
+    m_pipeline.push_back(dataBlock);
+
+    if (fec) {
+        m_encoderPool.start(new EncodeTask(this, sequence, dataBlock));
+    } else {
+        encoded(sequence);
+    }
+}
+
+void RemoteSinkSender::encoded(quint64 sequence)
+{
+    QMutexLocker mutexLocker(&m_pipelineMutex);
+    m_encodedFrames.insert(sequence);
+    m_pipelineCondition.wakeAll();
+}
+
+void RemoteSinkSender::sendEncoded()
+{
+    // frames are transmitted in the order they were queued whatever the order of completion
+    while (!m_pipeline.empty())
+    {
+        m_pipelineMutex.lock();
+        bool ready = m_encodedFrames.erase(m_nextSend) != 0;
+        m_pipelineMutex.unlock();
+
+        if (!ready) {
+            break;
         }
+
+        RemoteDataBlock *dataBlock = m_pipeline.front();
+        m_pipeline.pop_front();
+        m_nextSend++;
+        transmitDataBlock(dataBlock);
     }
 }
 
-void RemoteSinkSender::sendDataBlock(RemoteDataBlock *dataBlock)
+void RemoteSinkSender::encodeDataBlock(CM256 *cm256, RemoteDataBlock *dataBlock)
 {
 	CM256::cm256_encoder_params cm256Params;  //!< Main interface with CM256 encoder
 	CM256::cm256_block descriptorBlocks[256]; //!< Pointers to data for CM256 encoder
-	RemoteProtectedBlock fecBlocks[256];   //!< FEC data
+	std::vector<RemoteProtectedBlock> fecBlocks(dataBlock->m_txControlBlock.m_nbBlocksFEC); //!< FEC data
 
     uint16_t frameIndex = dataBlock->m_txControlBlock.m_frameIndex;
-    int nbBlocksFEC = dataBlock->m_txControlBlock.m_nbBlocksFEC;
-    int txDelay = dataBlock->m_txControlBlock.m_txDelay;
-    m_address.setAddress(dataBlock->m_txControlBlock.m_dataAddress);
-    uint16_t dataPort = dataBlock->m_txControlBlock.m_dataPort;
     RemoteSuperBlock *txBlockx = dataBlock->m_superBlocks;
 
-    if ((nbBlocksFEC == 0) || !m_cm256p) // Do not FEC encode
+    cm256Params.BlockBytes = sizeof(RemoteProtectedBlock);
+    cm256Params.OriginalCount = RemoteNbOrginalBlocks;
+    cm256Params.RecoveryCount = dataBlock->m_txControlBlock.m_nbBlocksFEC;
+
+    // Fill pointers to data
+    for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
     {
-        if (m_socket)
-        {
-            for (int i = 0; i < RemoteNbOrginalBlocks; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
-            }
+        if (i >= cm256Params.OriginalCount) {
+            memset((void *) &txBlockx[i].m_protectedBlock, 0, sizeof(RemoteProtectedBlock));
         }
+
+        txBlockx[i].m_header.m_frameIndex = frameIndex;
+        txBlockx[i].m_header.m_blockIndex = i;
+        txBlockx[i].m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+        txBlockx[i].m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+        descriptorBlocks[i].Block = (void *) &(txBlockx[i].m_protectedBlock);
+        descriptorBlocks[i].Index = txBlockx[i].m_header.m_blockIndex;
     }
-    else
+
+    // Encode FEC blocks
+    if (cm256->cm256_encode(cm256Params, descriptorBlocks, fecBlocks.data()))
+    {
+        qWarning("RemoteSinkSender::encodeDataBlock: CM256 encode failed. No transmission.");
+        // TODO: send without FEC changing meta data to set indication of no FEC
+    }
+
+    // Merge FEC with data to transmit
+    for (int i = 0; i < cm256Params.RecoveryCount; i++)
+    {
+        txBlockx[i + cm256Params.OriginalCount].m_protectedBlock = fecBlocks[i];
+    }
+}
+
+void RemoteSinkSender::transmitDataBlock(RemoteDataBlock *dataBlock)
+{
+    int nbBlocksFEC = m_cm256p ? dataBlock->m_txControlBlock.m_nbBlocksFEC : 0;
+    m_address.setAddress(dataBlock->m_txControlBlock.m_dataAddress);
+
+    // Transmit all blocks
+    sendBlocks(
+        dataBlock->m_superBlocks,
+        RemoteNbOrginalBlocks + nbBlocksFEC,
+        dataBlock->m_txControlBlock.m_dataPort,
+        dataBlock->m_txControlBlock.m_txDelay
+    );
+
+    dataBlock->m_txControlBlock.m_processed = true;
+}
+
+void RemoteSinkSender::sendBlocks(RemoteSuperBlock *txBlocks, int nbBlocks, uint16_t dataPort, int txDelay)
+{
+    if (m_batchSender.canSend(m_address))
     {
-        cm256Params.BlockBytes = sizeof(RemoteProtectedBlock);
-        cm256Params.OriginalCount = RemoteNbOrginalBlocks;
-        cm256Params.RecoveryCount = nbBlocksFEC;
+        // without pacing the whole frame goes in one burst. With pacing the average rate is kept.
+        int burstSize = txDelay > 0 ? std::max(1, m_burstPeriodUs / txDelay) : nbBlocks;
 
-        // Fill pointers to data
-        for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; ++i)
+        for (int i = 0; i < nbBlocks; i += burstSize)
         {
-            if (i >= cm256Params.OriginalCount) {
-                memset((void *) &txBlockx[i].m_protectedBlock, 0, sizeof(RemoteProtectedBlock));
+            int nbBurstBlocks = std::min(burstSize, nbBlocks - i);
+
+            if (!sendBurst(&txBlocks[i], nbBurstBlocks, dataPort))
+            {
+                qWarning("RemoteSinkSender::sendBlocks: UDP GSO failed. Using sendmmsg without GSO");
+                m_gso = false;
+                sendBurst(&txBlocks[i], nbBurstBlocks, dataPort);
             }
 
-            txBlockx[i].m_header.m_frameIndex = frameIndex;
-            txBlockx[i].m_header.m_blockIndex = i;
-            txBlockx[i].m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
-            txBlockx[i].m_header.m_sampleBits = SDR_RX_SAMP_SZ;
-            descriptorBlocks[i].Block = (void *) &(txBlockx[i].m_protectedBlock);
-            descriptorBlocks[i].Index = txBlockx[i].m_header.m_blockIndex;
+            if (txDelay > 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(nbBurstBlocks*txDelay));
+            }
         }
 
-        // Encode FEC blocks
-        if (m_cm256p->cm256_encode(cm256Params, descriptorBlocks, fecBlocks))
-        {
-            qWarning("RemoteSinkSender::handleDataBlock: CM256 encode failed. No transmission.");
-            // TODO: send without FEC changing meta data to set indication of no FEC
-        }
+        return;
+    }
 
-        // Merge FEC with data to transmit
-        for (int i = 0; i < cm256Params.RecoveryCount; i++)
-        {
-            txBlockx[i + cm256Params.OriginalCount].m_protectedBlock = fecBlocks[i];
-        }
+    if (m_socket)
+    {
+        m_sendMode = SendQt;
 
-        // Transmit all blocks
-        if (m_socket)
+        for (int i = 0; i < nbBlocks; i++)
         {
-            for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
-            }
+            // send block via UDP
+            m_socket->writeDatagram((const char*)&txBlocks[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
+            m_nbPackets++;
+            m_nbSyscalls++;
+            std::this_thread::sleep_for(std::chrono::microseconds(txDelay));
         }
     }
+}
 
-    dataBlock->m_txControlBlock.m_processed = true;
+bool RemoteSinkSender::sendBurst(RemoteSuperBlock *txBlocks, int nbBlocks, uint16_t dataPort)
+{
+    // super blocks are packed and contiguous so a GSO message is a single buffer of consecutive blocks
+    UDPBatchSender::Message messages[UDPBatchSender::m_maxMessages];
+    int messageSize = m_gso ? m_gsoMaxSegments : 1;
+    int nbMessages = 0;
+
+    for (int i = 0; (i < nbBlocks) && (nbMessages < UDPBatchSender::m_maxMessages); i += messageSize, nbMessages++) {
+        messages[nbMessages] = UDPBatchSender::Message{&txBlocks[i], (unsigned int) (std::min(messageSize, nbBlocks - i) * RemoteUdpSize)};
+    }
+
+    m_sendMode = m_gso ? SendGSO : SendMMsg;
+    int nbSyscalls = 0;
+    int nbSent = m_batchSender.send(messages, nbMessages, m_address, dataPort, m_gso ? RemoteUdpSize : 0, &nbSyscalls);
+    m_nbSyscalls += nbSyscalls;
+
+    if (nbSent < 0) {
+        return false; // offload not supported on the route
+    }
+
+    for (int i = 0; i < nbSent; i++) {
+        m_nbPackets += messages[i].m_size / RemoteUdpSize;
+    }
+
+    return true;
 }
@@ -24,19 +24,26 @@
 #ifndef PLUGINS_CHANNELRX_REMOTESINK_REMOTESINKSENDER_H_
 #define PLUGINS_CHANNELRX_REMOTESINK_REMOTESINKSENDER_H_
 
+#include <atomic>
+#include <deque>
+#include <set>
+
 #include <QObject>
 #include <QMutex>
 #include <QWaitCondition>
 #include <QHostAddress>
+#include <QThreadPool>
 
 #include "cm256cc/cm256.h"
 
 #include "util/message.h"
 #include "util/messagequeue.h"
+#include "util/udpbatchsender.h"
 
 #include "remotesinkfifo.h"
 
 class RemoteDataBlock;
+struct RemoteSuperBlock;
 class CM256;
 class QUdpSocket;
 
@@ -47,20 +54,61 @@ public:
     RemoteSinkSender();
     ~RemoteSinkSender();
 
+    enum SendMode
+    {
+        SendQt,     //!< One datagram per write through the Qt socket
+        SendMMsg,   //!< Bursts of datagrams per sendmmsg system call
+        SendGSO     //!< Bursts of datagrams segmented by the kernel (UDP GSO) per sendmmsg system call
+    };
+
     RemoteDataBlock *getDataBlock();
+    uint64_t getNbPackets() const { return m_nbPackets.load(); }
+    uint64_t getNbSyscalls() const { return m_nbSyscalls.load(); }
+    SendMode getSendMode() const { return m_sendMode.load(); }
+    /** Maximum number of frames FEC encoded in parallel by the pool threads. With 1 frames are encoded in the sender thread */
+    void setFECPipelineDepth(unsigned int depth) { m_fecPipelineDepth = depth < 1 ? 1 : depth; }
+
+signals:
+    void frameEncoded(); //!< Emitted from the pool threads
 
 private:
+    class EncodeTask;
+
     RemoteSinkFifo m_fifo;
-    CM256 m_cm256;
+    CM256 m_cm256;                       //!< Shared by the pool threads. Encoding only reads its tables
     CM256 *m_cm256p;
 
     QHostAddress m_address;
     QUdpSocket *m_socket;
+    UDPBatchSender m_batchSender;        //!< Native socket for batched transmissions
+    bool m_gso;                          //!< UDP GSO is supported
+    std::atomic<SendMode> m_sendMode;    //!< Last transmission path
+    std::atomic<uint64_t> m_nbPackets;   //!< Datagrams sent
+    std::atomic<uint64_t> m_nbSyscalls;  //!< System calls used to send them
+
+    std::atomic<unsigned int> m_fecPipelineDepth;
+    QThreadPool m_encoderPool;
+    std::deque<RemoteDataBlock*> m_pipeline; //!< Frames waiting for transmission in order (sender thread)
+    quint64 m_nextSubmit;                //!< Sequence number of the next frame entering the pipeline
+    quint64 m_nextSend;                  //!< Sequence number of the frame at the head of the pipeline
+    QMutex m_pipelineMutex;              //!< Protects the set below
+    QWaitCondition m_pipelineCondition;
+    std::set<quint64> m_encodedFrames;   //!< Sequence numbers of the frames ready for transmission
+
+    static const int m_burstPeriodUs = 1000; //!< With pacing datagrams are sent in bursts spanning this time
+    static const int m_gsoMaxSegments = 64;  //!< Maximum number of datagrams of a UDP GSO message
 
-    void sendDataBlock(RemoteDataBlock *dataBlock);
+    void queueDataBlock(RemoteDataBlock *dataBlock);
+    void encoded(quint64 sequence);      //!< Called from the pool threads
+    static void encodeDataBlock(CM256 *cm256, RemoteDataBlock *dataBlock);
+    void transmitDataBlock(RemoteDataBlock *dataBlock);
+    void sendBlocks(RemoteSuperBlock *txBlocks, int nbBlocks, uint16_t dataPort, int txDelay);
+    void sendBlocksQt(RemoteSuperBlock *txBlocks, int nbBlocks, uint16_t dataPort, int txDelay);
+    bool sendBurst(RemoteSuperBlock *txBlocks, int nbBlocks, uint16_t dataPort);
 
 private slots:
     void handleData();
+    void sendEncoded();
 };
 
 #endif // PLUGINS_CHANNELRX_REMOTESINK_REMOTESINKSENDER_H_
@@ -27,6 +27,7 @@
 
 #include "util/simpleserializer.h"
 #include "settings/serializable.h"
+#include "channel/remotecodec.h"
 
 
 RemoteSinkSettings::RemoteSinkSettings()
@@ -46,6 +47,10 @@ void RemoteSinkSettings::resetToDefaults()
     m_filterChainHash = 0;
     m_channelMarker = nullptr;
     m_streamIndex = 0;
+    m_fecPipelineDepth = 4;
+    m_codec = 0;
+    m_sharedMemory = false;
+    m_shmName = "sdrangel_remote";
     m_useReverseAPI = false;
     m_reverseAPIAddress = "127.0.0.1";
     m_reverseAPIPort = 8888;
@@ -70,6 +75,10 @@ QByteArray RemoteSinkSettings::serialize() const
     s.writeU32(12, m_log2Decim);
     s.writeU32(13, m_filterChainHash);
     s.writeS32(14, m_streamIndex);
+    s.writeU32(15, m_fecPipelineDepth);
+    s.writeU32(16, m_codec);
+    s.writeBool(17, m_sharedMemory);
+    s.writeString(18, m_shmName);
 
     return s.final();
 }
@@ -127,6 +136,12 @@ bool RemoteSinkSettings::deserialize(const QByteArray& data)
         m_log2Decim = tmp > 6 ? 6 : tmp;
         d.readU32(13, &m_filterChainHash, 0);
         d.readS32(14, &m_streamIndex, 0);
+        d.readU32(15, &tmp, 4);
+        m_fecPipelineDepth = tmp < 1 ? 1 : tmp > 16 ? 16 : tmp;
+        d.readU32(16, &tmp, 0);
+        m_codec = RemoteCodec::isValid(tmp) ? tmp : 0;
+        d.readBool(17, &m_sharedMemory, false);
+        d.readString(18, &m_shmName, "sdrangel_remote");
 
         return true;
     }
@@ -40,6 +40,10 @@ struct RemoteSinkSettings
     uint32_t m_log2Decim;
     uint32_t m_filterChainHash;
     int m_streamIndex; //!< MIMO channel. Not relevant when connected to SI (single Rx).
+    uint32_t m_fecPipelineDepth; //!< Maximum number of frames FEC encoded in parallel
+    uint32_t m_codec;            //!< Sample compression (RemoteCodec::Codec)
+    bool m_sharedMemory;         //!< Samples go to the shared memory ring m_shmName instead of UDP
+    QString m_shmName;           //!< Shared memory ring name for local Remote Input instances
     bool m_useReverseAPI;
     QString m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -18,6 +18,8 @@
 #include <QMutexLocker>
 #include <QThread>
 
+#include <algorithm>
+
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
 
@@ -31,6 +33,9 @@ RemoteSinkSink::RemoteSinkSink() :
         m_txBlockIndex(0),
         m_frameCount(0),
         m_sampleIndex(0),
+        m_codec(RemoteCodec::CodecRaw),
+        m_nbLossyBlocks(0),
+        m_nbDroppedLSBs(0),
         m_dataBlock(nullptr),
         m_deviceCenterFrequency(0),
         m_frequencyOffset(0),
@@ -70,10 +75,10 @@ void RemoteSinkSink::stopSender()
 	m_senderThread->wait();
 }
 
-void RemoteSinkSink::setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim)
+void RemoteSinkSink::setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim, int codec)
 {
     double txDelayRatio = txDelay / 100.0;
-    int samplesPerBlock = RemoteNbBytesPerBlock / sizeof(Sample);
+    int samplesPerBlock = RemoteCodec::getNbSamplesPerBlock((RemoteCodec::Codec) codec, (SDR_RX_SAMP_SZ <= 16 ? 2 : 4));
     int sampleRate = m_basebandSampleRate / (1<<log2Decim);
     double delay = sampleRate == 0 ? 1.0 : (127*samplesPerBlock*txDelayRatio) / sampleRate;
     delay /= 128 + nbBlocksFEC;
@@ -92,6 +97,12 @@ void RemoteSinkSink::setNbBlocksFEC(int nbBlocksFEC)
 
 void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
 {
+    if (m_shmRing.isOpen())
+    {
+        feedSharedMemory(begin, end);
+        return;
+    }
+
     SampleVector::const_iterator it = begin;
 
     while (it != end)
@@ -105,10 +116,11 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
             RemoteMetaDataFEC metaData;
             uint64_t nowus = TimeUtil::nowus();
             // gettimeofday(&tv, 0);
+            m_codec = (RemoteCodec::Codec) m_settings.m_codec; // codec changes only at frame boundaries
 
             metaData.m_centerFrequency = m_deviceCenterFrequency + m_frequencyOffset;
             metaData.m_sampleRate = m_basebandSampleRate / (1<<m_settings.m_log2Decim);
-            metaData.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+            metaData.m_sampleBytes = (m_codec << 4) | (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
             metaData.m_sampleBits = SDR_RX_SAMP_SZ;
             metaData.m_nbOriginalBlocks = RemoteNbOrginalBlocks;
             metaData.m_nbFECBlocks = m_nbBlocksFEC;
@@ -128,6 +140,7 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
             superBlock.m_header.m_blockIndex = m_txBlockIndex;
             superBlock.m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
             superBlock.m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+            superBlock.m_header.m_codec = m_codec;
 
             RemoteMetaDataFEC *destMeta = (RemoteMetaDataFEC *) &superBlock.m_protectedBlock;
             *destMeta = metaData;
@@ -137,7 +150,8 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
                 qDebug() << "RemoteSinkSink::feed: meta: "
                         << "|" << metaData.m_centerFrequency
                         << ":" << metaData.m_sampleRate
-                        << ":" << (int) (metaData.m_sampleBytes & 0xF)
+                        << ":" << (int) metaData.getSampleBytes()
+                        << ":" << (int) metaData.getCodec()
                         << ":" << (int) metaData.m_sampleBits
                         << "|" << (int) metaData.m_nbOriginalBlocks
                         << ":" << (int) metaData.m_nbFECBlocks
@@ -150,11 +164,14 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
             m_txBlockIndex = 1; // next Tx block with data
         } // block zero
 
-        // handle different sample sizes...
-        int samplesPerBlock = RemoteNbBytesPerBlock / (SDR_RX_SAMP_SZ <= 16 ? 4 : 8); // two I or Q samples
+        // handle different sample sizes and codecs...
+        int samplesPerBlock = RemoteCodec::getNbSamplesPerBlock(m_codec, (SDR_RX_SAMP_SZ <= 16 ? 2 : 4));
+        uint8_t *blockSamples = m_codec == RemoteCodec::CodecRaw ?
+            m_superBlock.m_protectedBlock.buf : (uint8_t *) m_codecSamples; // compressed blocks are coded when complete
+
         if (m_sampleIndex + inRemainingSamples < samplesPerBlock) // there is still room in the current super block
         {
-            memcpy((void *) &m_superBlock.m_protectedBlock.buf[m_sampleIndex*sizeof(Sample)],
+            memcpy((void *) &blockSamples[m_sampleIndex*sizeof(Sample)],
                     (const void *) &(*(begin+inSamplesIndex)),
                     inRemainingSamples * sizeof(Sample));
             m_sampleIndex += inRemainingSamples;
@@ -162,16 +179,28 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
         }
         else // complete super block and initiate the next if not end of frame
         {
-            memcpy((void *) &m_superBlock.m_protectedBlock.buf[m_sampleIndex*sizeof(Sample)],
+            memcpy((void *) &blockSamples[m_sampleIndex*sizeof(Sample)],
                     (const void *) &(*(begin+inSamplesIndex)),
                     (samplesPerBlock - m_sampleIndex) * sizeof(Sample));
             it += samplesPerBlock - m_sampleIndex;
             m_sampleIndex = 0;
 
+            if (m_codec != RemoteCodec::CodecRaw)
+            {
+                unsigned int droppedLSBs = RemoteCodec::encode(m_codec, m_codecSamples, (SDR_RX_SAMP_SZ <= 16 ? 2 : 4), m_superBlock.m_protectedBlock);
+
+                if (droppedLSBs != 0)
+                {
+                    m_nbLossyBlocks.fetch_add(1, std::memory_order_relaxed);
+                    m_nbDroppedLSBs.fetch_add(droppedLSBs, std::memory_order_relaxed);
+                }
+            }
+
             m_superBlock.m_header.m_frameIndex = m_frameCount;
             m_superBlock.m_header.m_blockIndex = m_txBlockIndex;
             m_superBlock.m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
             m_superBlock.m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+            m_superBlock.m_header.m_codec = m_codec;
             m_dataBlock->m_superBlocks[m_txBlockIndex] = m_superBlock;
 
             if (m_txBlockIndex == RemoteNbOrginalBlocks - 1) // frame complete
@@ -197,6 +226,40 @@ void RemoteSinkSink::feed(const SampleVector::const_iterator& begin, const Sampl
     }
 }
 
+void RemoteSinkSink::feedSharedMemory(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    // no frames, FEC nor compression: the samples are appended to the ring as they come
+    RemoteMetaDataFEC metaData;
+    uint64_t nowus = TimeUtil::nowus();
+    metaData.m_centerFrequency = m_deviceCenterFrequency + m_frequencyOffset;
+    metaData.m_sampleRate = m_basebandSampleRate / (1<<m_settings.m_log2Decim);
+    metaData.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
+    metaData.m_sampleBits = SDR_RX_SAMP_SZ;
+    metaData.m_nbOriginalBlocks = 0;
+    metaData.m_nbFECBlocks = 0;
+    metaData.m_tv_sec = nowus / 1000000UL;
+    metaData.m_tv_usec = nowus % 1000000UL;
+
+    if (!(metaData == m_currentMetaFEC))
+    {
+        qDebug() << "RemoteSinkSink::feedSharedMemory: meta: "
+                << "|" << metaData.m_centerFrequency
+                << ":" << metaData.m_sampleRate
+                << ":" << (int) metaData.getSampleBytes()
+                << ":" << (int) metaData.m_sampleBits;
+
+        m_currentMetaFEC = metaData;
+        m_shmRing.setMeta(metaData);
+    }
+
+    const uint8_t *samples = (const uint8_t *) &(*begin);
+    std::size_t nbBytes = (end - begin) * sizeof(Sample);
+
+    for (std::size_t index = 0; index < nbBytes; index += m_shmRing.getCapacity()) {
+        m_shmRing.write(&samples[index], std::min(nbBytes - index, (std::size_t) m_shmRing.getCapacity()));
+    }
+}
+
 void RemoteSinkSink::applySettings(const RemoteSinkSettings& settings, bool force)
 {
     qDebug() << "RemoteSinkSink::applySettings:"
@@ -205,8 +268,32 @@ void RemoteSinkSink::applySettings(const RemoteSinkSettings& settings, bool forc
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
             << " m_streamIndex: " << settings.m_streamIndex
+            << " m_codec: " << settings.m_codec
+            << " m_sharedMemory: " << settings.m_sharedMemory
+            << " m_shmName: " << settings.m_shmName
             << " force: " << force;
 
+    if ((m_settings.m_sharedMemory != settings.m_sharedMemory)
+     || (m_settings.m_shmName != settings.m_shmName) || force)
+    {
+        if (settings.m_sharedMemory)
+        {
+            if (m_shmRing.create(settings.m_shmName)) {
+                m_currentMetaFEC.init(); // publish meta data in the new ring
+            } else {
+                qWarning("RemoteSinkSink::applySettings: cannot create shared memory %s. Use UDP",
+                    settings.m_shmName.toStdString().c_str());
+            }
+        }
+        else
+        {
+            m_shmRing.close();
+        }
+
+        m_txBlockIndex = 0; // restart UDP frames from the beginning
+        m_sampleIndex = 0;
+    }
+
     if ((m_settings.m_dataAddress != settings.m_dataAddress) || force) {
         m_dataAddress = settings.m_dataAddress;
     }
@@ -215,15 +302,20 @@ void RemoteSinkSink::applySettings(const RemoteSinkSettings& settings, bool forc
         m_dataPort = settings.m_dataPort;
     }
 
+    if ((m_settings.m_fecPipelineDepth != settings.m_fecPipelineDepth) || force) {
+        m_remoteSinkSender->setFECPipelineDepth(settings.m_fecPipelineDepth);
+    }
+
     if ((m_settings.m_log2Decim != settings.m_log2Decim)
      || (m_settings.m_filterChainHash != settings.m_filterChainHash)
      || (m_settings.m_nbFECBlocks != settings.m_nbFECBlocks)
-     || (m_settings.m_txDelay != settings.m_txDelay) || force)
+     || (m_settings.m_txDelay != settings.m_txDelay)
+     || (m_settings.m_codec != settings.m_codec) || force)
     {
         double shiftFactor = HBFilterChainConverter::getShiftFactor(settings.m_log2Decim, settings.m_filterChainHash);
         m_frequencyOffset = round(shiftFactor*m_basebandSampleRate);
         setNbBlocksFEC(settings.m_nbFECBlocks);
-        setTxDelay(settings.m_txDelay, settings.m_nbFECBlocks, settings.m_log2Decim);
+        setTxDelay(settings.m_txDelay, settings.m_nbFECBlocks, settings.m_log2Decim, settings.m_codec);
     }
 
     m_settings = settings;
@@ -234,5 +326,5 @@ void RemoteSinkSink::applyBasebandSampleRate(uint32_t sampleRate)
     m_basebandSampleRate = sampleRate;
     double shiftFactor = HBFilterChainConverter::getShiftFactor(m_settings.m_log2Decim, m_settings.m_filterChainHash);
     m_frequencyOffset = round(shiftFactor*m_basebandSampleRate);
-    setTxDelay(m_settings.m_txDelay, m_settings.m_nbFECBlocks, m_settings.m_log2Decim);
+    setTxDelay(m_settings.m_txDelay, m_settings.m_nbFECBlocks, m_settings.m_log2Decim, m_settings.m_codec);
 }
\ No newline at end of file
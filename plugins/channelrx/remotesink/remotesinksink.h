@@ -18,10 +18,14 @@
 #ifndef INCLUDE_REMOTESINKSINK_H_
 #define INCLUDE_REMOTESINKSINK_H_
 
+#include <atomic>
+
 #include <QObject>
 
 #include "dsp/channelsamplesink.h"
 #include "channel/remotedatablock.h"
+#include "channel/remotecodec.h"
+#include "channel/remoteshmring.h"
 
 
 #include "remotesinksettings.h"
@@ -44,6 +48,9 @@ public:
     void applySettings(const RemoteSinkSettings& settings, bool force = false);
     void applyBasebandSampleRate(uint32_t sampleRate);
     void setDeviceCenterFrequency(uint64_t frequency) { m_deviceCenterFrequency = frequency; }
+    const RemoteSinkSender *getSender() const { return m_remoteSinkSender; }
+    uint64_t getNbLossyBlocks() const { return m_nbLossyBlocks.load(); }
+    uint64_t getNbDroppedLSBs() const { return m_nbDroppedLSBs.load(); }
 
 private:
     RemoteSinkSettings m_settings;
@@ -54,8 +61,13 @@ private:
     uint16_t m_frameCount;               //!< transmission frame count
     int m_sampleIndex;                   //!< Current sample index in protected block data
     RemoteSuperBlock m_superBlock;
+    RemoteCodec::Codec m_codec;          //!< Sample codec of the current frame
+    Sample m_codecSamples[RemoteCodec::m_maxNbSamplesPerBlock]; //!< Samples of the current block when compressed
+    std::atomic<uint64_t> m_nbLossyBlocks;  //!< Blocks coded with least significant bits dropped
+    std::atomic<uint64_t> m_nbDroppedLSBs;  //!< Least significant bits dropped summed over the blocks
     RemoteMetaDataFEC m_currentMetaFEC;
     RemoteDataBlock *m_dataBlock;
+    RemoteShmRing m_shmRing;             //!< Shared memory transport when open
 
     uint64_t m_deviceCenterFrequency;
     int64_t m_frequencyOffset;
@@ -66,7 +78,8 @@ private:
     uint16_t m_dataPort;
 
     void setNbBlocksFEC(int nbBlocksFEC);
-    void setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim);
+    void setTxDelay(int txDelay, int nbBlocksFEC, int log2Decim, int codec);
+    void feedSharedMemory(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 };
 
 #endif // INCLUDE_REMOTESINKSINK_H_
\ No newline at end of file
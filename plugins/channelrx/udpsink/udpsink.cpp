@@ -151,6 +151,8 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
             << " m_udpAddressStr: " << settings.m_udpAddress
             << " m_udpPort: " << settings.m_udpPort
             << " m_audioPort: " << settings.m_audioPort
+            << " m_datagramSize: " << settings.m_datagramSize
+            << " m_multicastTTL: " << settings.m_multicastTTL
             << " m_streamIndex: " << settings.m_streamIndex
             << " m_useReverseAPI: " << settings.m_useReverseAPI
             << " m_reverseAPIAddress: " << settings.m_reverseAPIAddress
@@ -209,6 +211,12 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
     if ((settings.m_audioPort != m_settings.m_audioPort) || force) {
         reverseAPIKeys.append("audioPort");
     }
+    if ((settings.m_datagramSize != m_settings.m_datagramSize) || force) {
+        reverseAPIKeys.append("datagramSize");
+    }
+    if ((settings.m_multicastTTL != m_settings.m_multicastTTL) || force) {
+        reverseAPIKeys.append("multicastTTL");
+    }
 
     if (m_settings.m_streamIndex != settings.m_streamIndex)
     {
@@ -353,6 +361,16 @@ void UDPSink::webapiUpdateChannelSettings(
     if (channelSettingsKeys.contains("audioPort")) {
         settings.m_audioPort = response.getUdpSinkSettings()->getAudioPort();
     }
+    if (channelSettingsKeys.contains("datagramSize"))
+    {
+        int datagramSize = response.getUdpSinkSettings()->getDatagramSize();
+        settings.m_datagramSize = datagramSize < 64 ? 64 : datagramSize > 8192 ? 8192 : datagramSize;
+    }
+    if (channelSettingsKeys.contains("multicastTTL"))
+    {
+        int multicastTTL = response.getUdpSinkSettings()->getMulticastTtl();
+        settings.m_multicastTTL = multicastTTL < 1 ? 1 : multicastTTL > 255 ? 255 : multicastTTL;
+    }
     if (channelSettingsKeys.contains("rgbColor")) {
         settings.m_rgbColor = response.getUdpSinkSettings()->getRgbColor();
     }
@@ -415,6 +433,8 @@ void UDPSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& respo
 
     response.getUdpSinkSettings()->setUdpPort(settings.m_udpPort);
     response.getUdpSinkSettings()->setAudioPort(settings.m_audioPort);
+    response.getUdpSinkSettings()->setDatagramSize(settings.m_datagramSize);
+    response.getUdpSinkSettings()->setMulticastTtl(settings.m_multicastTTL);
     response.getUdpSinkSettings()->setRgbColor(settings.m_rgbColor);
 
     if (response.getUdpSinkSettings()->getTitle()) {
@@ -508,6 +528,12 @@ void UDPSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys, con
     if (channelSettingsKeys.contains("audioPort") || force) {
         swgUDPSinkSettings->setAudioPort(settings.m_audioPort);
     }
+    if (channelSettingsKeys.contains("datagramSize") || force) {
+        swgUDPSinkSettings->setDatagramSize(settings.m_datagramSize);
+    }
+    if (channelSettingsKeys.contains("multicastTTL") || force) {
+        swgUDPSinkSettings->setMulticastTtl(settings.m_multicastTTL);
+    }
     if (channelSettingsKeys.contains("rgbColor") || force) {
         swgUDPSinkSettings->setRgbColor(settings.m_rgbColor);
     }
@@ -49,6 +49,8 @@ void UDPSinkSettings::resetToDefaults()
     m_udpAddress = "127.0.0.1";
     m_udpPort = 9998;
     m_audioPort = 9997;
+    m_datagramSize = 512;
+    m_multicastTTL = 1;
     m_rgbColor = QColor(225, 25, 99).rgb();
     m_title = "UDP Sample Sink";
     m_useReverseAPI = false;
@@ -93,6 +95,8 @@ QByteArray UDPSinkSettings::serialize() const
     s.writeU32(26, m_reverseAPIDeviceIndex);
     s.writeU32(27, m_reverseAPIChannelIndex);
     s.writeS32(28, m_streamIndex);
+    s.writeU32(29, m_datagramSize);
+    s.writeS32(30, m_multicastTTL);
 
     return s.final();
 
@@ -183,6 +187,10 @@ bool UDPSinkSettings::deserialize(const QByteArray& data)
         d.readU32(27, &u32tmp, 0);
         m_reverseAPIChannelIndex = u32tmp > 99 ? 99 : u32tmp;
         d.readS32(28, &m_streamIndex, 0);
+        d.readU32(29, &u32tmp, 512);
+        m_datagramSize = u32tmp < 64 ? 64 : u32tmp > 8192 ? 8192 : u32tmp;
+        d.readS32(30, &s32tmp, 1);
+        m_multicastTTL = s32tmp < 1 ? 1 : s32tmp > 255 ? 255 : s32tmp;
 
         return true;
     }
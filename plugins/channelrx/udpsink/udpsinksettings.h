@@ -60,6 +60,8 @@ struct UDPSinkSettings
     QString m_udpAddress;
     uint16_t m_udpPort;
     uint16_t m_audioPort;
+    uint32_t m_datagramSize; //!< UDP payload size in bytes
+    int m_multicastTTL;      //!< Time to live of datagrams sent to a multicast address
 
     QString m_title;
 
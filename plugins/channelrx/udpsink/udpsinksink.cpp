@@ -21,6 +21,12 @@
 #include <QNetworkReply>
 #include <QBuffer>
 
+#include <cmath>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 #include "SWGChannelSettings.h"
 #include "SWGUDPSinkSettings.h"
 #include "SWGChannelReport.h"
@@ -43,6 +49,7 @@ UDPSinkSink::UDPSinkSink() :
         m_outMovingAverage(480, 1e-10),
         m_inMovingAverage(480, 1e-10),
         m_amMovingAverage(1200, 1e-10),
+        m_outputIndex(0),
         m_audioFifo(24000),
         m_spectrum(nullptr),
         m_spectrumEnabled(false),
@@ -115,8 +122,24 @@ void UDPSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVe
 	Complex ci;
 	fftfilt::cmplx* sideband;
 	double l, r;
+	const UDPSinkSettings::SampleFormat sampleFormat = m_settings.m_sampleFormat;
+	const bool agc = m_settings.m_agc &&
+        (sampleFormat != UDPSinkSettings::FormatNFM) &&
+        (sampleFormat != UDPSinkSettings::FormatNFMMono) &&
+        (sampleFormat != UDPSinkSettings::FormatIQ16) &&
+        (sampleFormat != UDPSinkSettings::FormatIQ24);
+
+    // The block goes through three stages:
+    // 1. channelization and demodulation to the floating point values in m_outputBuffer (stateful, per sample)
+    // 2. conversion of these values to the wire format directly in the datagrams staging buffer (SIMD)
+    // 3. transmission of the complete datagrams in a batch
+    // At most one channel sample is produced per input sample so the spectrum buffer never grows in the loop
+    if (m_sampleBuffer.size() < (unsigned int) (end - begin)) {
+        m_sampleBuffer.resize(end - begin);
+    }
 
-	m_sampleBuffer.clear();
+    unsigned int nbChannelSamples = 0;
+    m_outputIndex = 0;
 
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
@@ -128,11 +151,7 @@ void UDPSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVe
 		    double inMagSq;
 		    double agcFactor = 1.0;
 
-            if ((m_settings.m_agc) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatNFM) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatNFMMono) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatIQ16) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatIQ24))
+            if (agc)
             {
                 agcFactor = m_agc.feedAndGetValue(ci);
                 inMagSq = m_agc.getMagSq();
@@ -145,112 +164,85 @@ void UDPSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVe
 		    m_inMovingAverage.feed(inMagSq / (SDR_RX_SCALED*SDR_RX_SCALED));
 		    m_inMagsq = m_inMovingAverage.average();
 
-			Sample ss(ci.real(), ci.imag());
-			m_sampleBuffer.push_back(ss);
+			m_sampleBuffer[nbChannelSamples++] = Sample(ci.real(), ci.imag());
 
 			m_sampleDistanceRemain += m_channelSampleRate / m_settings.m_outputSampleRate;
 
 			calculateSquelch(m_inMagsq);
 
-			if (m_settings.m_sampleFormat == UDPSinkSettings::FormatLSB) // binaural LSB
+			if ((sampleFormat == UDPSinkSettings::FormatLSB) || (sampleFormat == UDPSinkSettings::FormatUSB)) // binaural SSB
 			{
 			    ci *= agcFactor;
-				int n_out = UDPFilter->runSSB(ci, &sideband, false);
+				int n_out = UDPFilter->runSSB(ci, &sideband, sampleFormat == UDPSinkSettings::FormatUSB);
 
 				if (n_out)
 				{
-					for (int i = 0; i < n_out; i++)
-					{
-						l = m_squelchOpen ? sideband[i].real() * m_settings.m_gain : 0;
-						r = m_squelchOpen ? sideband[i].imag() * m_settings.m_gain : 0;
-						udpWrite(l, r);
-					    m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
-					}
-				}
-			}
-			if (m_settings.m_sampleFormat == UDPSinkSettings::FormatUSB) // binaural USB
-			{
-			    ci *= agcFactor;
-				int n_out = UDPFilter->runSSB(ci, &sideband, true);
+				    Real *out = outputRoom(2*n_out);
 
-				if (n_out)
-				{
 					for (int i = 0; i < n_out; i++)
 					{
 						l = m_squelchOpen ? sideband[i].real() * m_settings.m_gain : 0;
 						r = m_squelchOpen ? sideband[i].imag() * m_settings.m_gain : 0;
-                        udpWrite(l, r);
-						m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
+						out[2*i] = l;
+						out[2*i+1] = r;
+					    m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatNFM)
+			else if (sampleFormat == UDPSinkSettings::FormatNFM)
 			{
                 Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_gain : 0;
-				udpWriteNorm(discri, discri);
+                Real *out = outputRoom(2);
+                out[0] = discri;
+                out[1] = discri;
 				m_outMovingAverage.feed(discri*discri);
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatNFMMono)
+			else if (sampleFormat == UDPSinkSettings::FormatNFMMono)
 			{
 			    Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_gain : 0;
-				udpWriteNormMono(discri);
+				*outputRoom(1) = discri;
 				m_outMovingAverage.feed(discri*discri);
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) // Monaural LSB
+			else if ((sampleFormat == UDPSinkSettings::FormatLSBMono) || (sampleFormat == UDPSinkSettings::FormatUSBMono)) // Monaural SSB
 			{
 			    ci *= agcFactor;
-				int n_out = UDPFilter->runSSB(ci, &sideband, false);
+				int n_out = UDPFilter->runSSB(ci, &sideband, sampleFormat == UDPSinkSettings::FormatUSBMono);
 
 				if (n_out)
 				{
-					for (int i = 0; i < n_out; i++)
-					{
-						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * m_settings.m_gain : 0;
-		                udpWriteMono(l);
-						m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
-					}
-				}
-			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono) // Monaural USB
-			{
-			    ci *= agcFactor;
-				int n_out = UDPFilter->runSSB(ci, &sideband, true);
+				    Real *out = outputRoom(n_out);
 
-				if (n_out)
-				{
 					for (int i = 0; i < n_out; i++)
 					{
 						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * m_settings.m_gain : 0;
-                        udpWriteMono(l);
+						out[i] = l;
 						m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMMono)
+			else if (sampleFormat == UDPSinkSettings::FormatAMMono)
 			{
 			    Real amplitude = m_squelchOpen ? sqrt(inMagSq) * agcFactor * m_settings.m_gain : 0;
-				FixReal demod = (FixReal) amplitude;
-                udpWriteMono(demod);
+			    *outputRoom(1) = amplitude;
 				m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
 			}
-            else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMNoDCMono)
+            else if (sampleFormat == UDPSinkSettings::FormatAMNoDCMono)
             {
                 if (m_squelchOpen)
                 {
                     double demodf = sqrt(inMagSq);
                     m_amMovingAverage.feed(demodf);
                     Real amplitude = (demodf - m_amMovingAverage.average()) * agcFactor * m_settings.m_gain;
-                    FixReal demod = (FixReal) amplitude;
-                    udpWriteMono(demod);
+                    *outputRoom(1) = amplitude;
                     m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
                 }
                 else
                 {
-                    udpWriteMono(0);
+                    *outputRoom(1) = 0;
                     m_outMovingAverage.feed(0);
                 }
             }
-            else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMBPFMono)
+            else if (sampleFormat == UDPSinkSettings::FormatAMBPFMono)
             {
                 if (m_squelchOpen)
                 {
@@ -258,26 +250,29 @@ void UDPSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVe
                     demodf = m_bandpass.filter(demodf);
                     demodf /= 301.0;
                     Real amplitude = demodf * agcFactor * m_settings.m_gain;
-                    FixReal demod = (FixReal) amplitude;
-                    udpWriteMono(demod);
+                    *outputRoom(1) = amplitude;
                     m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
                 }
                 else
                 {
-                    udpWriteMono(0);
+                    *outputRoom(1) = 0;
                     m_outMovingAverage.feed(0);
                 }
             }
 			else // Raw I/Q samples
 			{
+			    Real *out = outputRoom(2);
+
 			    if (m_squelchOpen)
 			    {
-	                udpWrite(ci.real() * m_settings.m_gain, ci.imag() * m_settings.m_gain);
+			        out[0] = ci.real() * m_settings.m_gain;
+			        out[1] = ci.imag() * m_settings.m_gain;
 	                m_outMovingAverage.feed((inMagSq*m_settings.m_gain*m_settings.m_gain) / (SDR_RX_SCALED*SDR_RX_SCALED));
 			    }
 			    else
 			    {
-	                udpWrite(0, 0);
+			        out[0] = 0;
+			        out[1] = 0;
 	                m_outMovingAverage.feed(0);
 			    }
 			}
@@ -286,13 +281,124 @@ void UDPSinkSink::feed(const SampleVector::const_iterator& begin, const SampleVe
 		}
 	}
 
+	writeOutputBlock();
+
 	//qDebug() << "UDPSink::feed: " << m_sampleBuffer.size() * 4;
 
 	if ((m_spectrum != 0) && (m_spectrumEnabled)) {
-		m_spectrum->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), m_spectrumPositiveOnly);
+		m_spectrum->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + nbChannelSamples, m_spectrumPositiveOnly);
 	}
 }
 
+void UDPSinkSink::writeOutputBlock()
+{
+    // Values are in the channel samples scale except NFM that is normalized to 1.0
+    const Real scale16 = SDR_RX_SAMP_SZ == 24 ? 1.0f/256.0f : 1.0f;
+    const Real scale24 = SDR_RX_SAMP_SZ == 16 ? 256.0f : 1.0f;
+    const Real *values = m_outputBuffer.data();
+
+    switch (m_settings.m_sampleFormat)
+    {
+    case UDPSinkSettings::FormatIQ24:
+        writeS24(m_udpBuffer24, values, m_outputIndex/2, scale24);
+        break;
+    case UDPSinkSettings::FormatNFM:
+        writeS16(m_udpBuffer16, values, m_outputIndex/2, 32768.0f);
+        break;
+    case UDPSinkSettings::FormatNFMMono:
+        writeS16(m_udpBufferMono16, values, m_outputIndex, 32768.0f);
+        break;
+    case UDPSinkSettings::FormatLSBMono:
+    case UDPSinkSettings::FormatUSBMono:
+    case UDPSinkSettings::FormatAMMono:
+    case UDPSinkSettings::FormatAMNoDCMono:
+    case UDPSinkSettings::FormatAMBPFMono:
+        writeS16(m_udpBufferMono16, values, m_outputIndex, scale16);
+        break;
+    default: // I/Q and binaural SSB
+        writeS16(m_udpBuffer16, values, m_outputIndex/2, scale16);
+        break;
+    }
+}
+
+template<typename T>
+void UDPSinkSink::writeS16(UDPSinkUtil<T> *udpBuffer, const Real *values, int nbSamples, Real scale)
+{
+    const int nbValuesPerSample = sizeof(T) / sizeof(int16_t);
+    int index = 0;
+
+    while (index < nbSamples)
+    {
+        int room;
+        T *staging = udpBuffer->getStagingBuffer(nbSamples - index, room);
+        convertS16(&values[index*nbValuesPerSample], room*nbValuesPerSample, scale, reinterpret_cast<int16_t*>(staging));
+        udpBuffer->commit(room);
+        index += room;
+    }
+
+    udpBuffer->flush();
+}
+
+template<typename T>
+void UDPSinkSink::writeS24(UDPSinkUtil<T> *udpBuffer, const Real *values, int nbSamples, Real scale)
+{
+    const int nbValuesPerSample = sizeof(T) / sizeof(int32_t);
+    int index = 0;
+
+    while (index < nbSamples)
+    {
+        int room;
+        T *staging = udpBuffer->getStagingBuffer(nbSamples - index, room);
+        convertS24(&values[index*nbValuesPerSample], room*nbValuesPerSample, scale, reinterpret_cast<int32_t*>(staging));
+        udpBuffer->commit(room);
+        index += room;
+    }
+
+    udpBuffer->flush();
+}
+
+void UDPSinkSink::convertS16(const Real *values, int nbValues, Real scale, int16_t *output)
+{
+    int i = 0;
+#if defined(USE_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+
+    for (; i + 8 <= nbValues; i += 8)
+    {
+        __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&values[i]), vscale));
+        __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&values[i+4]), vscale));
+        _mm_storeu_si128((__m128i*) &output[i], _mm_packs_epi32(lo, hi)); // saturates to 16 bits
+    }
+#endif
+    for (; i < nbValues; i++)
+    {
+        Real v = values[i] * scale;
+        output[i] = (int16_t) std::lrint(v < -32768.0f ? -32768.0f : v > 32767.0f ? 32767.0f : v);
+    }
+}
+
+void UDPSinkSink::convertS24(const Real *values, int nbValues, Real scale, int32_t *output)
+{
+    int i = 0;
+#if defined(USE_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 vmin = _mm_set1_ps(-8388608.0f);
+    const __m128 vmax = _mm_set1_ps(8388607.0f);
+
+    for (; i + 4 <= nbValues; i += 4)
+    {
+        __m128 v = _mm_mul_ps(_mm_loadu_ps(&values[i]), vscale);
+        v = _mm_min_ps(_mm_max_ps(v, vmin), vmax);
+        _mm_storeu_si128((__m128i*) &output[i], _mm_cvtps_epi32(v));
+    }
+#endif
+    for (; i < nbValues; i++)
+    {
+        Real v = values[i] * scale;
+        output[i] = (int32_t) std::lrint(v < -8388608.0f ? -8388608.0f : v > 8388607.0f ? 8388607.0f : v);
+    }
+}
+
 void UDPSinkSink::audioReadyRead()
 {
 	while (m_audioSocket->hasPendingDatagrams())
@@ -397,6 +503,8 @@ void UDPSinkSink::applySettings(const UDPSinkSettings& settings, bool force)
             << " m_udpAddressStr: " << settings.m_udpAddress
             << " m_udpPort: " << settings.m_udpPort
             << " m_audioPort: " << settings.m_audioPort
+            << " m_datagramSize: " << settings.m_datagramSize
+            << " m_multicastTTL: " << settings.m_multicastTTL
             << " m_streamIndex: " << settings.m_streamIndex
             << " m_useReverseAPI: " << settings.m_useReverseAPI
             << " m_reverseAPIAddress: " << settings.m_reverseAPIAddress
@@ -485,6 +593,20 @@ void UDPSinkSink::applySettings(const UDPSinkSettings& settings, bool force)
         m_udpBuffer24->setPort(settings.m_udpPort);
     }
 
+    if ((settings.m_datagramSize != m_settings.m_datagramSize) || force)
+    {
+        m_udpBuffer16->setDatagramSize(settings.m_datagramSize);
+        m_udpBufferMono16->setDatagramSize(settings.m_datagramSize);
+        m_udpBuffer24->setDatagramSize(settings.m_datagramSize);
+    }
+
+    if ((settings.m_multicastTTL != m_settings.m_multicastTTL) || force)
+    {
+        m_udpBuffer16->setMulticastTTL(settings.m_multicastTTL);
+        m_udpBufferMono16->setMulticastTTL(settings.m_multicastTTL);
+        m_udpBuffer24->setMulticastTTL(settings.m_multicastTTL);
+    }
+
     if ((settings.m_audioPort != m_settings.m_audioPort) || force)
     {
         disconnect(m_audioSocket, SIGNAL(readyRead()), this, SLOT(audioReadyRead()));
@@ -20,6 +20,8 @@
 
 #include <QObject>
 
+#include <vector>
+
 #include "dsp/channelsamplesink.h"
 #include "dsp/nco.h"
 #include "dsp/fftfilt.h"
@@ -97,7 +99,9 @@ private:
 	Real m_sampleDistanceRemain;
 	fftfilt* UDPFilter;
 
-	SampleVector m_sampleBuffer;
+	SampleVector m_sampleBuffer;          //!< Channel samples of the block for the spectrum
+	std::vector<Real> m_outputBuffer;     //!< Demodulated values of the block before conversion to the wire format
+	int m_outputIndex;
 	UDPSinkUtil<Sample16> *m_udpBuffer16;
 	UDPSinkUtil<int16_t> *m_udpBufferMono16;
     UDPSinkUtil<Sample24> *m_udpBuffer24;
@@ -187,46 +191,23 @@ private:
         }
     }
 
-    void udpWrite(FixReal real, FixReal imag)
-    {
-        if (SDR_RX_SAMP_SZ == 16)
-        {
-            if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ16) {
-                m_udpBuffer16->write(Sample16(real, imag));
-            } else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ24) {
-                m_udpBuffer24->write(Sample24(real<<8, imag<<8));
-            } else {
-                m_udpBuffer16->write(Sample16(real, imag));
-            }
-        }
-        else if (SDR_RX_SAMP_SZ == 24)
-        {
-            if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ16) {
-                m_udpBuffer16->write(Sample16(real>>8, imag>>8));
-            } else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ24) {
-                m_udpBuffer24->write(Sample24(real, imag));
-            } else {
-                m_udpBuffer16->write(Sample16(real>>8, imag>>8));
-            }
-        }
-    }
-
-    void udpWriteMono(FixReal sample)
+    /** Room for nbValues more values in the output block */
+    Real *outputRoom(int nbValues)
     {
-        if (SDR_RX_SAMP_SZ == 16) {
-            m_udpBufferMono16->write(sample);
-        } else if (SDR_RX_SAMP_SZ == 24) {
-            m_udpBufferMono16->write(sample>>8);
+        if (m_outputIndex + nbValues > (int) m_outputBuffer.size()) {
+            m_outputBuffer.resize(2*(m_outputIndex + nbValues));
         }
-    }
 
-    void udpWriteNorm(Real real, Real imag) {
-        m_udpBuffer16->write(Sample16(real*32768.0, imag*32768.0));
+        Real *room = &m_outputBuffer[m_outputIndex];
+        m_outputIndex += nbValues;
+        return room;
     }
 
-    void udpWriteNormMono(Real sample) {
-        m_udpBufferMono16->write(sample*32768.0);
-    }
+    void writeOutputBlock();
+    template<typename T> static void writeS16(UDPSinkUtil<T> *udpBuffer, const Real *values, int nbSamples, Real scale);
+    template<typename T> static void writeS24(UDPSinkUtil<T> *udpBuffer, const Real *values, int nbSamples, Real scale);
+    static void convertS16(const Real *values, int nbValues, Real scale, int16_t *output);
+    static void convertS24(const Real *values, int nbValues, Real scale, int32_t *output);
 };
 
 #endif // INCLUDE_UDPSINKSINK_H
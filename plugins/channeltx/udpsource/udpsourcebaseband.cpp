@@ -22,7 +22,6 @@
 #include "dsp/dspcommands.h"
 
 #include "udpsourcebaseband.h"
-#include "udpsourcemsg.h"
 
 MESSAGE_CLASS_DEFINITION(UDPSourceBaseband::MsgConfigureUDPSourceBaseband, Message)
 MESSAGE_CLASS_DEFINITION(UDPSourceBaseband::MsgConfigureChannelizer, Message)
@@ -45,7 +44,6 @@ UDPSourceBaseband::UDPSourceBaseband() :
     );
 
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
-    m_source.setUDPFeedbackMessageQueue(&m_inputMessageQueue);
 }
 
 UDPSourceBaseband::~UDPSourceBaseband()
@@ -171,17 +169,6 @@ bool UDPSourceBaseband::handleMessage(const Message& cmd)
 
 		return true;
     }
-    else if (UDPSourceMessages::MsgSampleRateCorrection::match(cmd))
-    {
-        QMutexLocker mutexLocker(&m_mutex);
-        UDPSourceMessages::MsgSampleRateCorrection& notif = (UDPSourceMessages::MsgSampleRateCorrection&) cmd;
-        qDebug() << "UDPSourceBaseband::handleMessage: MsgSampleRateCorrection:"
-            << "corr: " << notif.getCorrectionFactor()
-            << "ratio: " << notif.getRawDeltaRatio();
-        m_source.sampleRateCorrection(notif.getRawDeltaRatio(), notif.getCorrectionFactor());
-
-        return true;
-    }
     else
     {
         return false;
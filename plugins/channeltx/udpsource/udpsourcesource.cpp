@@ -22,7 +22,6 @@
 #include "util/db.h"
 
 #include "udpsourcesource.h"
-#include "udpsourcemsg.h"
 
 UDPSourceSource::UDPSourceSource() :
     m_channelSampleRate(48000),
@@ -35,8 +34,8 @@ UDPSourceSource::UDPSourceSource() :
     m_magsq(1e-10),
     m_movingAverage(16, 1e-10),
     m_inMovingAverage(480, 1e-10),
-    m_sampleRateSum(0),
-    m_sampleRateAvgCounter(0),
+    m_inputIndex(0),
+    m_inputCount(0),
     m_levelCalcCount(0),
     m_peakLevel(0.0f),
     m_levelSum(0.0f),
@@ -51,6 +50,7 @@ UDPSourceSource::UDPSourceSource() :
     m_SSBFilter = new fftfilt(m_settings.m_lowCutoff / m_settings.m_inputSampleRate, m_settings.m_rfBandwidth / m_settings.m_inputSampleRate, m_ssbFftLen);
     m_SSBFilterBuffer = new Complex[m_ssbFftLen>>1]; // filter returns data exactly half of its size
     m_magsq = 0.0;
+    m_inputBuffer.resize(m_inputBlockSize);
 
     m_udpHandler.start();
 
@@ -65,11 +65,6 @@ UDPSourceSource::~UDPSourceSource()
     delete[] m_SSBFilterBuffer;
 }
 
-void UDPSourceSource::setUDPFeedbackMessageQueue(MessageQueue *messageQueue)
-{
-    m_udpHandler.setFeedbackMessageQueue(messageQueue);
-}
-
 void UDPSourceSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
 {
     std::for_each(
@@ -93,21 +88,11 @@ void UDPSourceSource::pullOne(Sample& sample)
 
     Complex ci;
 
-    if (m_interpolatorDistance > 1.0f) // decimate
+    // the distance follows the input rate drift and may cross 1 so the generic resampler is used
+    while (!m_interpolator.resample(&m_interpolatorDistanceRemain, m_modSample, &m_interpolatorConsumed, &ci))
     {
         modulateSample();
-
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
-        {
-            modulateSample();
-        }
-    }
-    else
-    {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
-        {
-            modulateSample();
-        }
+        m_interpolatorConsumed = false;
     }
 
     m_interpolatorDistanceRemain += m_interpolatorDistance;
@@ -128,7 +113,7 @@ void UDPSourceSource::modulateSample()
     {
         Sample s;
 
-        m_udpHandler.readSample(s);
+        readInputSample(s);
 
         uint64_t magsq = s.m_real * s.m_real + s.m_imag * s.m_imag;
         m_inMovingAverage.feed(magsq/(SDR_TX_SCALED*SDR_TX_SCALED));
@@ -254,6 +239,13 @@ void UDPSourceSource::modulateSample()
     }
 }
 
+void UDPSourceSource::trackInputRate()
+{
+    if (m_settings.m_autoRWBalance) {
+        m_interpolatorDistance = m_nominalInterpolatorDistance * m_udpHandler.getRateRatio();
+    }
+}
+
 void UDPSourceSource::calculateLevel(Real sample)
 {
     if (m_levelCalcCount < m_levelNbSamples)
@@ -314,11 +306,12 @@ void UDPSourceSource::applyChannelSettings(int channelSampleRate, int channelFre
         m_carrierNco.setFreq(channelFrequencyOffset, channelSampleRate);
     }
 
-    if (((channelSampleRate != m_channelSampleRate) && (!m_settings.m_autoRWBalance)) || force)
+    if ((channelSampleRate != m_channelSampleRate) || force)
     {
         m_interpolatorDistanceRemain = 0;
         m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_settings.m_inputSampleRate / (Real) channelSampleRate;
+        m_nominalInterpolatorDistance = (Real) m_settings.m_inputSampleRate / (Real) channelSampleRate;
+        m_interpolatorDistance = m_nominalInterpolatorDistance;
         m_interpolator.create(48, m_settings.m_inputSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
     }
 
@@ -354,12 +347,9 @@ void UDPSourceSource::applySettings(const UDPSourceSettings& settings, bool forc
     {
         m_interpolatorDistanceRemain = 0;
         m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) m_channelSampleRate;
+        m_nominalInterpolatorDistance = (Real) settings.m_inputSampleRate / (Real) m_channelSampleRate;
+        m_interpolatorDistance = m_nominalInterpolatorDistance;
         m_interpolator.create(48, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-        m_actualInputSampleRate = settings.m_inputSampleRate;
-        m_udpHandler.resetReadIndex();
-        m_sampleRateSum = 0.0;
-        m_sampleRateAvgCounter = 0;
         m_spectrumChunkSize = settings.m_inputSampleRate * 0.05; // 50 ms chunk
         m_spectrumChunkCounter = 0;
         m_levelNbSamples = settings.m_inputSampleRate * 0.01; // every 10 ms
@@ -367,6 +357,8 @@ void UDPSourceSource::applySettings(const UDPSourceSettings& settings, bool forc
         m_peakLevel = 0.0f;
         m_levelSum = 0.0f;
         m_udpHandler.resizeBuffer(settings.m_inputSampleRate);
+        m_inputIndex = 0;
+        m_inputCount = 0;
         m_inMovingAverage.resize(settings.m_inputSampleRate * 0.01, 1e-10); // 10 ms
         m_squelchThreshold = settings.m_inputSampleRate * settings.m_squelchGate;
         initSquelch(m_squelchOpen);
@@ -400,58 +392,15 @@ void UDPSourceSource::applySettings(const UDPSourceSettings& settings, bool forc
     if ((settings.m_autoRWBalance != m_settings.m_autoRWBalance) || force)
     {
         m_udpHandler.setAutoRWBalance(settings.m_autoRWBalance);
+        m_interpolatorDistance = m_nominalInterpolatorDistance;
+    }
 
-        if (!settings.m_autoRWBalance)
-        {
-            m_interpolatorDistanceRemain = 0;
-            m_interpolatorConsumed = false;
-            m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) m_channelSampleRate;
-            m_interpolator.create(48, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-            m_actualInputSampleRate = settings.m_inputSampleRate;
-            m_udpHandler.resetReadIndex();
-        }
+    if ((settings.m_sampleFormat != m_settings.m_sampleFormat) ||
+        (settings.m_stereoInput != m_settings.m_stereoInput) || force)
+    {
+        m_inputIndex = 0; // samples of the previous format are dropped
+        m_inputCount = 0;
     }
 
     m_settings = settings;
 }
-
-void UDPSourceSource::sampleRateCorrection(float rawDeltaRatio, float correctionFactor)
-{
-    float newSampleRate = m_actualInputSampleRate + correctionFactor * m_actualInputSampleRate;
-
-    // exclude values too way out nominal sample rate (20%)
-    if ((newSampleRate < m_settings.m_inputSampleRate * 1.2) && (newSampleRate >  m_settings.m_inputSampleRate * 0.8))
-    {
-        m_actualInputSampleRate = newSampleRate;
-
-        if ((rawDeltaRatio > -0.05) && (rawDeltaRatio < 0.05))
-        {
-            if (m_sampleRateAvgCounter < m_sampleRateAverageItems)
-            {
-                m_sampleRateSum += m_actualInputSampleRate;
-                m_sampleRateAvgCounter++;
-            }
-        }
-        else
-        {
-            m_sampleRateSum = 0.0;
-            m_sampleRateAvgCounter = 0;
-        }
-
-        if (m_sampleRateAvgCounter == m_sampleRateAverageItems)
-        {
-            float avgRate = m_sampleRateSum / m_sampleRateAverageItems;
-            qDebug("UDPSourceSource::sampleRateCorrection: corr: %+.6f new rate: %.0f: avg rate: %.0f",
-                    correctionFactor,
-                    m_actualInputSampleRate,
-                    avgRate);
-            m_actualInputSampleRate = avgRate;
-            m_sampleRateSum = 0.0;
-            m_sampleRateAvgCounter = 0;
-        }
-
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_actualInputSampleRate / (Real) m_channelSampleRate;
-    }
-}
\ No newline at end of file
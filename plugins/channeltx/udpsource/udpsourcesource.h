@@ -21,6 +21,8 @@
 #include <QObject>
 #include <QNetworkRequest>
 
+#include <vector>
+
 #include "dsp/channelsamplesource.h"
 #include "dsp/interpolator.h"
 #include "dsp/movingaverage.h"
@@ -42,7 +44,6 @@ public:
     virtual void pullOne(Sample& sample);
     virtual void prefetch(unsigned int nbSamples) {};
 
-    void setUDPFeedbackMessageQueue(MessageQueue *messageQueue);
     void setSpectrumSink(BasebandSampleSink* spectrumSink) { m_spectrumSink = spectrumSink; }
     double getMagSq() const { return m_magsq; }
     double getInMagSq() const { return m_inMagsq; }
@@ -62,8 +63,6 @@ public:
         numSamples = m_levelNbSamples;
     }
 
-    void sampleRateCorrection(float rawDeltaRatio, float correctionFactor);
-
 private:
     int m_channelSampleRate;
     int m_channelFrequencyOffset;
@@ -84,6 +83,7 @@ private:
     Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
+    Real m_nominalInterpolatorDistance; //!< Interpolator distance without the UDP buffer drift compensation
 
     double m_magsq;
     double m_inMagsq;
@@ -91,9 +91,9 @@ private:
     MovingAverage<double> m_inMovingAverage;
 
     UDPSourceUDPHandler m_udpHandler;
-    Real m_actualInputSampleRate; //!< sample rate with UDP buffer skew compensation
-    double m_sampleRateSum;
-    int m_sampleRateAvgCounter;
+    std::vector<Sample> m_inputBuffer; //!< Block of input samples of any format read from the UDP handler
+    unsigned int m_inputIndex;         //!< Next sample in the input block
+    unsigned int m_inputCount;         //!< Number of samples in the input block
 
     int m_levelCalcCount;
     qreal m_rmsLevel;
@@ -112,10 +112,11 @@ private:
     Complex* m_SSBFilterBuffer;
     int m_SSBFilterBufferIndex;
 
-    static const int m_sampleRateAverageItems = 17;
+    static const unsigned int m_inputBlockSize = 256; //!< Number of input samples read from the UDP handler at once
     static const int m_ssbFftLen = 1024;
 
     void modulateSample();
+    void trackInputRate();
     void calculateLevel(Real sample);
     void calculateLevel(Complex sample);
 
@@ -177,18 +178,35 @@ private:
         }
     }
 
+    template<typename T>
+    inline void readInputSample(T& t)
+    {
+        if (m_inputIndex == m_inputCount)
+        {
+            m_inputCount = m_udpHandler.readSamples(reinterpret_cast<T*>(m_inputBuffer.data()), m_inputBlockSize);
+            m_inputIndex = 0;
+            trackInputRate();
+        }
+
+        if (m_inputCount == 0) { // buffering
+            t = T();
+        } else {
+            t = reinterpret_cast<const T*>(m_inputBuffer.data())[m_inputIndex++];
+        }
+    }
+
     inline void readMonoSample(qint16& t)
     {
 
         if (m_settings.m_stereoInput)
         {
             AudioSample a;
-            m_udpHandler.readSample(a);
+            readInputSample(a);
             t = ((a.l + a.r) * m_settings.m_gainIn) / 2;
         }
         else
         {
-            m_udpHandler.readSample(t);
+            readInputSample(t);
             t *= m_settings.m_gainIn;
         }
     }
@@ -18,11 +18,11 @@
 #include "udpsourceudphandler.h"
 
 #include <QDebug>
+#include <QMutexLocker>
 #include <stdint.h>
+#include <string.h>
 #include <algorithm>
 
-#include "udpsourcemsg.h"
-
 MESSAGE_CLASS_DEFINITION(UDPSourceUDPHandler::MsgUDPAddressAndPort, Message)
 
 UDPSourceUDPHandler::UDPSourceUDPHandler() :
@@ -32,25 +32,22 @@ UDPSourceUDPHandler::UDPSourceUDPHandler() :
     m_dataPort(9999),
     m_remotePort(0),
     m_dataConnected(false),
-    m_udpDumpIndex(0),
-    m_nbUDPFrames(m_minNbUDPFrames),
-    m_nbAllocatedUDPFrames(m_minNbUDPFrames),
-    m_writeFrameIndex(0),
-    m_readFrameIndex(m_minNbUDPFrames/2),
-    m_readIndex(0),
-    m_rwDelta(m_minNbUDPFrames/2),
-    m_d(0),
+    m_capacity(m_minNbUDPFrames*m_udpBlockSize),
+    m_writeCount(0),
+    m_readCount(0),
+    m_primed(false),
+    m_sampleRate(48000),
     m_autoRWBalance(true),
-    m_feedbackMessageQueue(nullptr)
+    m_fill(0.0),
+    m_rateCorrection(0.0),
+    m_rateIntegral(0.0)
 {
-    m_udpBuf = new udpBlk_t[m_minNbUDPFrames];
-    std::fill(m_udpDump, m_udpDump + m_udpBlockSize + 8192, 0);
+    m_buffer.resize(m_capacity);
     connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleMessages()));
 }
 
 UDPSourceUDPHandler::~UDPSourceUDPHandler()
 {
-    delete[] m_udpBuf;
 }
 
 void UDPSourceUDPHandler::start()
@@ -98,132 +95,126 @@ void UDPSourceUDPHandler::stop()
 
 void UDPSourceUDPHandler::dataReadyRead()
 {
+    QMutexLocker mutexLocker(&m_bufferMutex); // contended only by a ring reallocation
+
     while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
     {
-        qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-        qint64 bytesRead = m_dataSocket->readDatagram(&m_udpDump[m_udpDumpIndex], pendingDataSize, &m_remoteAddress, &m_remotePort);
+        qint64 pendingDataSize = std::min(m_dataSocket->pendingDatagramSize(), (qint64) sizeof(m_udpDump));
+        uint64_t writeCount = m_writeCount.load(std::memory_order_relaxed);
+        uint64_t room = m_capacity - (writeCount - m_readCount.load(std::memory_order_acquire));
+        unsigned int writeIndex = writeCount % m_capacity;
+        qint64 bytesRead;
 
-        if (bytesRead < 0)
+        if ((pendingDataSize <= 0) || ((uint64_t) pendingDataSize > room)) // ring is full: datagram is dropped
         {
-            qWarning("UDPSourceUDPHandler::dataReadyRead: UDP read error");
+            m_dataSocket->readDatagram(m_udpDump, 0);
+            continue;
         }
-        else
-        {
-            int udpDumpSize = m_udpDumpIndex + bytesRead;
-            int udpDumpPtr = 0;
 
-            while (udpDumpSize >= m_udpBlockSize)
-            {
-                moveData(&m_udpDump[udpDumpPtr]);
-                udpDumpPtr += m_udpBlockSize;
-                udpDumpSize -= m_udpBlockSize;
-            }
+        if ((uint64_t) pendingDataSize <= m_capacity - writeIndex) // straight into the ring
+        {
+            bytesRead = m_dataSocket->readDatagram((char *) &m_buffer[writeIndex], pendingDataSize, &m_remoteAddress, &m_remotePort);
+        }
+        else // wraps around the end of the ring
+        {
+            bytesRead = m_dataSocket->readDatagram(m_udpDump, pendingDataSize, &m_remoteAddress, &m_remotePort);
 
-            if (udpDumpSize > 0)
+            if (bytesRead > 0)
             {
-                memcpy(m_udpDump, &m_udpDump[udpDumpPtr], udpDumpSize);
+                unsigned int firstPart = std::min((unsigned int) bytesRead, m_capacity - writeIndex);
+                memcpy(&m_buffer[writeIndex], m_udpDump, firstPart);
+                memcpy(&m_buffer[0], &m_udpDump[firstPart], bytesRead - firstPart);
             }
+        }
 
-            m_udpDumpIndex = udpDumpSize;
+        if (bytesRead < 0) {
+            qWarning("UDPSourceUDPHandler::dataReadyRead: UDP read error");
+        } else {
+            m_writeCount.store(writeCount + bytesRead, std::memory_order_release);
         }
     }
 }
 
-void UDPSourceUDPHandler::moveData(char *blk)
+unsigned int UDPSourceUDPHandler::read(uint8_t *data, unsigned int nbBytes, unsigned int sampleSize)
 {
-    memcpy(m_udpBuf[m_writeFrameIndex], blk, m_udpBlockSize);
-
-    if (m_writeFrameIndex < m_nbUDPFrames - 1) {
-        m_writeFrameIndex++;
-    } else {
-        m_writeFrameIndex = 0;
-    }
-}
+    uint64_t writeCount = m_writeCount.load(std::memory_order_acquire);
+    uint64_t readCount = m_readCount.load(std::memory_order_relaxed);
+    uint64_t fill = writeCount - readCount;
+    uint64_t target = ((m_capacity / 2) / sampleSize) * sampleSize;
 
-void UDPSourceUDPHandler::readSample(qint16 &t)
-{
-    if (m_readFrameIndex == m_writeFrameIndex) // block until more writes
+    if (!m_primed.load(std::memory_order_relaxed)) // wait for half a ring and start reading from there
     {
-        t = 0;
-    }
-    else
-    {
-        memcpy(&t, &m_udpBuf[m_readFrameIndex][m_readIndex], sizeof(qint16));
-        advanceReadPointer((int) sizeof(qint16));
-    }
-}
+        if (fill < target) {
+            return 0;
+        }
 
-void UDPSourceUDPHandler::readSample(AudioSample &a)
-{
-    if (m_readFrameIndex == m_writeFrameIndex) // block until more writes
-    {
-        a.l = 0;
-        a.r = 0;
+        readCount = writeCount - target;
+        fill = target;
+        m_fill = target;
+        m_primed.store(true, std::memory_order_relaxed);
     }
-    else
+    else if (fill > m_capacity - m_capacity/10) // overrun: skip to half a ring
     {
-        memcpy(&a, &m_udpBuf[m_readFrameIndex][m_readIndex], sizeof(AudioSample));
-        advanceReadPointer((int) sizeof(AudioSample));
+        qDebug("UDPSourceUDPHandler::read: overrun: skip %llu bytes", (unsigned long long) (fill - target));
+        readCount = writeCount - target;
+        fill = target;
+        m_fill = target;
     }
-}
 
-void UDPSourceUDPHandler::readSample(Sample &s)
-{
-    if (m_readFrameIndex == m_writeFrameIndex) // block until more writes
+    unsigned int length = std::min((uint64_t) nbBytes, fill);
+    length -= length % sampleSize;
+
+    if (length == 0) // underrun: buffer again
     {
-        s.m_real = 0;
-        s.m_imag = 0;
+        qDebug("UDPSourceUDPHandler::read: underrun");
+        m_primed.store(false, std::memory_order_relaxed);
+        return 0;
     }
-    else
-    {
-        memcpy(&s, &m_udpBuf[m_readFrameIndex][m_readIndex], sizeof(Sample));
-        advanceReadPointer((int) sizeof(Sample));
+
+    unsigned int readIndex = readCount % m_capacity;
+    unsigned int firstPart = std::min(length, m_capacity - readIndex);
+    memcpy(data, &m_buffer[readIndex], firstPart);
+    memcpy(&data[firstPart], &m_buffer[0], length - firstPart);
+    m_readCount.store(readCount + length, std::memory_order_release);
+
+    if (m_autoRWBalance) {
+        updateRateCorrection(fill - length, length, sampleSize);
     }
+
+    return length;
 }
 
-void UDPSourceUDPHandler::advanceReadPointer(int nbBytes)
+void UDPSourceUDPHandler::updateRateCorrection(uint64_t fill, unsigned int nbBytes, unsigned int sampleSize)
 {
-    if (m_readIndex < m_udpBlockSize - 2*nbBytes)
-    {
-        m_readIndex += nbBytes;
+    // fill drift is corrected by the read rate with a PI controller on the smoothed fill
+    double bytesPerSecond = m_sampleRate * sampleSize;
+    double dt = nbBytes / bytesPerSecond;
+    m_fill += (dt / (dt + m_fillTimeConstant)) * (fill - m_fill);
+    double error = (m_fill - m_capacity/2) / bytesPerSecond;
+    m_rateIntegral += m_rateKi * error * dt;
+
+    if (m_rateIntegral > m_maxRateIntegral) {
+        m_rateIntegral = m_maxRateIntegral;
+    } else if (m_rateIntegral < -m_maxRateIntegral) {
+        m_rateIntegral = -m_maxRateIntegral;
     }
-    else
-    {
-        m_readIndex = 0;
 
-        if (m_readFrameIndex < m_nbUDPFrames - 1)
-        {
-            m_readFrameIndex++;
-        }
-        else
-        {
-            m_rwDelta = m_writeFrameIndex; // raw R/W delta estimate
-            int nbUDPFrames2 = m_nbUDPFrames/2;
-            float d = (m_rwDelta - nbUDPFrames2)/(float) m_nbUDPFrames;
-            //qDebug("UDPSourceUDPHandler::advanceReadPointer: w: %02d d: %f", m_writeIndex, d);
+    m_rateCorrection = m_rateKp * error + m_rateIntegral;
 
-            if ((d < -0.45) || (d > 0.45))
-            {
-                resetReadIndex();
-            }
-            else
-            {
-                float dd = d - m_d; // derivative
-                float c = (d / 15.0) + (dd / 20.0); // damping and scaling
-                c = c < -0.05 ? -0.05 : c > 0.05 ? 0.05 : c; // limit
-                UDPSourceMessages::MsgSampleRateCorrection *msg = UDPSourceMessages::MsgSampleRateCorrection::create(c, d);
-
-                if (m_autoRWBalance && m_feedbackMessageQueue) {
-                    m_feedbackMessageQueue->push(msg);
-                }
-
-                m_readFrameIndex = 0;
-                m_d = d;
-            }
-        }
+    if (m_rateCorrection > m_maxRateCorrection) {
+        m_rateCorrection = m_maxRateCorrection;
+    } else if (m_rateCorrection < -m_maxRateCorrection) {
+        m_rateCorrection = -m_maxRateCorrection;
     }
 }
 
+void UDPSourceUDPHandler::setAutoRWBalance(bool autoRWBalance)
+{
+    m_autoRWBalance = autoRWBalance;
+    m_rateCorrection = 0.0;
+    m_rateIntegral = 0.0;
+}
+
 void UDPSourceUDPHandler::configureUDPLink(const QString& address, quint16 port)
 {
     Message* msg = MsgUDPAddressAndPort::create(address, port);
@@ -249,27 +240,21 @@ void UDPSourceUDPHandler::applyUDPLink(const QString& address, quint16 port)
 
 void UDPSourceUDPHandler::resetReadIndex()
 {
-    m_readFrameIndex = (m_writeFrameIndex + (m_nbUDPFrames/2)) % m_nbUDPFrames;
-    m_rwDelta = m_nbUDPFrames/2;
-    m_readIndex = 0;
-    m_d = 0.0f;
+    m_primed.store(false);
 }
 
 void UDPSourceUDPHandler::resizeBuffer(float sampleRate)
 {
     int halfNbFrames = std::max((sampleRate / 375.0), (m_minNbUDPFrames / 2.0));
     qDebug("UDPSourceUDPHandler::resizeBuffer: nb_frames: %d", 2*halfNbFrames);
-
-    if (2*halfNbFrames > m_nbAllocatedUDPFrames)
-    {
-        delete[] m_udpBuf;
-        m_udpBuf = new udpBlk_t[2*halfNbFrames];
-        m_nbAllocatedUDPFrames = 2*halfNbFrames;
-    }
-
-    m_nbUDPFrames = 2*halfNbFrames;
-    m_writeFrameIndex = 0;
-
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    m_capacity = 2*halfNbFrames*m_udpBlockSize;
+    m_buffer.resize(m_capacity);
+    m_writeCount.store(0);
+    m_readCount.store(0);
+    m_sampleRate = sampleRate;
+    m_rateCorrection = 0.0;
+    m_rateIntegral = 0.0;
     resetReadIndex();
 }
 
@@ -24,6 +24,9 @@
 #include <QMutex>
 #include <stdint.h>
 
+#include <atomic>
+#include <vector>
+
 #include "dsp/dsptypes.h"
 #include "util/message.h"
 #include "util/messagequeue.h"
@@ -41,25 +44,34 @@ public:
     void resetReadIndex();
     void resizeBuffer(float sampleRate);
 
-    void readSample(qint16 &t);      //!< audio mono
-    void readSample(AudioSample &a); //!< audio stereo
-    void readSample(Sample &s);      //!< I/Q stream
+    /**
+     * Read up to nbSamples samples in a block. Returns the number of samples read. Nothing is read
+     * while the buffer fills up to half its size after a reset or an underrun.
+     */
+    template<typename T>
+    unsigned int readSamples(T *samples, unsigned int nbSamples)
+    {
+        return read(reinterpret_cast<uint8_t*>(samples), nbSamples * sizeof(T), sizeof(T)) / sizeof(T);
+    }
 
-    void setAutoRWBalance(bool autoRWBalance) { m_autoRWBalance = autoRWBalance; }
-    void setFeedbackMessageQueue(MessageQueue *messageQueue) { m_feedbackMessageQueue = messageQueue; }
+    void setAutoRWBalance(bool autoRWBalance);
+    /** Number of input samples to read per nominal input sample so that the buffer stays half full */
+    double getRateRatio() const { return 1.0 + m_rateCorrection; }
 
     /** Get buffer gauge value in % of buffer size ([-50:50])
-     *  [-50:0] : write leads or read lags
-     *  [0:50]  : read leads or write lags
+     *  [-50:0] : less than half the buffer is filled (read catches up with write)
+     *  [0:50]  : more than half the buffer is filled (write catches up with read)
      */
     inline int32_t getBufferGauge() const
     {
-        int32_t val = m_rwDelta - (m_nbUDPFrames/2);
-        return (100*val) / m_nbUDPFrames;
+        int64_t fill = m_writeCount.load() - m_readCount.load();
+        int64_t capacity = m_capacity;
+        int64_t val = (100 * (fill - capacity/2)) / capacity;
+        return val < -50 ? -50 : val > 50 ? 50 : val;
     }
 
-    static const int m_udpBlockSize = 512; // UDP block size in number of bytes
-    static const int m_minNbUDPFrames = 256;  // number of frames of block size in the UDP buffer
+    static const int m_udpBlockSize = 512; // buffer size granularity in number of bytes
+    static const int m_minNbUDPFrames = 256;  // minimum buffer size in number of blocks
 
 public slots:
     void dataReadyRead();
@@ -88,10 +100,8 @@ private:
         { }
     };
 
-    typedef char (udpBlk_t)[m_udpBlockSize];
-
-    void moveData(char *blk);
-    void advanceReadPointer(int nbBytes);
+    unsigned int read(uint8_t *data, unsigned int nbBytes, unsigned int sampleSize);
+    void updateRateCorrection(uint64_t fill, unsigned int nbBytes, unsigned int sampleSize);
     void applyUDPLink(const QString& address, quint16 port);
     bool handleMessage(const Message& message);
 
@@ -101,20 +111,26 @@ private:
     quint16 m_dataPort;
     quint16 m_remotePort;
     bool m_dataConnected;
-    udpBlk_t *m_udpBuf;
-    char m_udpDump[m_udpBlockSize + 8192]; // UDP block size + largest possible block
-    int m_udpDumpIndex;
-    int m_nbUDPFrames;
-    int m_nbAllocatedUDPFrames;
-    int m_writeFrameIndex;
-    int m_readFrameIndex;
-    int m_readIndex;
-    int m_rwDelta;
-    float m_d;
+    std::vector<uint8_t> m_buffer;       //!< Ring of datagram bytes. Single writer (socket) and single reader (modulator)
+    unsigned int m_capacity;             //!< Ring size in bytes
+    std::atomic<uint64_t> m_writeCount;  //!< Bytes written since the last resize. Updated by the socket thread only
+    std::atomic<uint64_t> m_readCount;   //!< Bytes read since the last resize. Updated by the modulator thread only
+    std::atomic<bool> m_primed;          //!< False until half the ring is filled after a reset or an underrun
+    QMutex m_bufferMutex;                //!< Ring reallocation against the writer. Not taken by the reader
+    char m_udpDump[65536];               //!< Datagrams that wrap around the end of the ring
+    float m_sampleRate;
     bool m_autoRWBalance;
-    MessageQueue *m_feedbackMessageQueue;
+    double m_fill;                       //!< Smoothed ring fill in bytes
+    double m_rateCorrection;             //!< Relative read rate correction
+    double m_rateIntegral;               //!< Integral term of the read rate correction
     MessageQueue m_inputMessageQueue;
 
+    static constexpr double m_fillTimeConstant = 0.5;  //!< Smoothing of the ring fill measurements (s)
+    static constexpr double m_rateKp = 0.2;            //!< Proportional gain (relative rate per second of fill error)
+    static constexpr double m_rateKi = 0.01;           //!< Integral gain. Critically damped loop for the smoothed fill
+    static constexpr double m_maxRateCorrection = 0.05;
+    static constexpr double m_maxRateIntegral = 0.04;
+
 private slots:
     void handleMessages();
 };
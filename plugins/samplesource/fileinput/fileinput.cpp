@@ -17,6 +17,7 @@
 
 #include <string.h>
 #include <errno.h>
+#include <cmath>
 
 #include <QDebug>
 #include <QNetworkReply>
@@ -26,6 +27,9 @@
 #include "SWGFileInputSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGDeviceActions.h"
+#include "SWGFileInputActions.h"
+#include "SWGFileInputAnnotation.h"
 
 #include "util/simpleserializer.h"
 #include "dsp/dspcommands.h"
@@ -41,6 +45,7 @@ MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInput, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceName, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInputWork, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceSeek, Message)
+MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileSourceSeekSample, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgConfigureFileInputStreamTiming, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgStartStop, Message)
 MESSAGE_CLASS_DEFINITION(FileInput::MsgPlayPause, Message)
@@ -52,6 +57,11 @@ MESSAGE_CLASS_DEFINITION(FileInput::MsgReportHeaderCRC, Message)
 FileInput::FileInput(DeviceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
 	m_settings(),
+	m_compressed(false),
+	m_mapped(false),
+	m_sigMF(false),
+	m_segmented(false),
+	m_endOfFile(false),
 	m_fileInputWorker(nullptr),
 	m_deviceDescription(),
 	m_fileName("..."),
@@ -93,6 +103,33 @@ void FileInput::openFileStream()
 		m_ifstream.close();
 	}
 
+	m_compressedReader.close();
+	m_mappedReader.close();
+	m_segmentReader.close();
+	m_mapped = false;
+	m_endOfFile = false;
+	m_sigMF = SigMF::isSigMFFile(m_fileName);
+	m_segmented = !m_sigMF && FileRecordRetention::isIndexFile(m_fileName);
+	m_compressed = !m_sigMF && !m_segmented && FileRecordCompressedReader::isCompressedFile(m_fileName);
+
+	if (m_sigMF)
+	{
+		openSigMFFileStream();
+		return;
+	}
+
+	if (m_segmented)
+	{
+		openSegmentedFileStream();
+		return;
+	}
+
+	if (m_compressed)
+	{
+		openCompressedFileStream();
+		return;
+	}
+
 #ifdef Q_OS_WIN
 	m_ifstream.open(m_fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
 #else
@@ -140,6 +177,192 @@ void FileInput::openFileStream()
 			<< " center frequency: " << m_centerFrequency << " Hz"
 			<< " sample size: " << m_sampleSize << " bits";
 
+	reportFileStreamData();
+
+	if (m_recordLength == 0)
+	{
+	    m_ifstream.close();
+	}
+	else if (m_mappedReader.open(m_fileName))
+	{
+		// the stream is kept as a fallback only if the file cannot be mapped
+		m_mapped = true;
+		m_ifstream.close();
+	}
+	else
+	{
+		qWarning("FileInput::openFileStream: cannot map file. Reading from stream");
+	}
+}
+
+void FileInput::openCompressedFileStream()
+{
+	FileRecord::Header header;
+	bool crcOK = false;
+
+	if (m_compressedReader.open(m_fileName, header, crcOK))
+	{
+		m_sampleRate = header.sampleRate;
+		m_centerFrequency = header.centerFrequency;
+		m_startingTimeStamp = header.startTimeStamp;
+		m_sampleSize = header.sampleSize;
+		QString crcHex = QString("%1").arg(header.crc32 , 0, 16);
+
+	    if (crcOK && (m_sampleRate > 0))
+	    {
+	        qDebug("FileInput::openCompressedFileStream: CRC32 OK for header: %s", qPrintable(crcHex));
+	        m_recordLength = m_compressedReader.getNbSamples() / m_sampleRate;
+	    }
+	    else
+	    {
+	        qCritical("FileInput::openCompressedFileStream: bad CRC32 for header: %s", qPrintable(crcHex));
+	        m_recordLength = 0;
+	    }
+
+		if (getMessageQueueToGUI())
+        {
+			MsgReportHeaderCRC *report = MsgReportHeaderCRC::create(crcOK);
+			getMessageQueueToGUI()->push(report);
+		}
+	}
+	else
+	{
+		m_recordLength = 0;
+	}
+
+	qDebug() << "FileInput::openCompressedFileStream: " << m_fileName.toStdString().c_str()
+			<< " samples: " << m_compressedReader.getNbSamples()
+			<< " index: " << (m_compressedReader.hasIndex() ? "found" : "rebuilt")
+			<< " length: " << m_recordLength << " seconds"
+			<< " sample rate: " << m_sampleRate << " S/s"
+			<< " center frequency: " << m_centerFrequency << " Hz"
+			<< " sample size: " << m_sampleSize << " bits";
+
+	reportFileStreamData();
+
+	if (m_recordLength == 0) {
+	    m_compressedReader.close();
+	}
+}
+
+void FileInput::openSigMFFileStream()
+{
+	QString errorMessage;
+	QString dataFileName = SigMF::getDataFileName(m_fileName);
+	bool metaOK = SigMF::readMeta(SigMF::getMetaFileName(m_fileName), m_sigMFMeta, errorMessage);
+	quint64 nbSamples = 0;
+
+	if (!metaOK)
+	{
+		qCritical("FileInput::openSigMFFileStream: %s", qPrintable(errorMessage));
+	}
+	else if (m_mappedReader.open(dataFileName)) // no stream fallback: conversion works on the mapping
+	{
+		m_mapped = true;
+		nbSamples = m_mappedReader.size() / (2 * SigMF::getComponentBytes(m_sigMFMeta.m_dataType));
+	}
+	else
+	{
+		qCritical("FileInput::openSigMFFileStream: cannot map %s", qPrintable(dataFileName));
+	}
+
+	if (metaOK)
+	{
+		qint64 dateTime = SigMF::getDateTime(m_sigMFMeta, 0);
+		m_sampleRate = (int) std::round(m_sigMFMeta.m_sampleRate);
+		m_centerFrequency = m_sigMFMeta.m_captures.size() > 0 ? m_sigMFMeta.m_captures.front().m_frequency : 0;
+		m_startingTimeStamp = dateTime < 0 ? 0 : dateTime / 1000;
+		m_sampleSize = m_sigMFMeta.m_sampleBits;
+		m_recordLength = m_sampleRate > 0 ? nbSamples / m_sampleRate : 0;
+
+		if (m_sigMFMeta.m_captures.size() > 1) {
+			qWarning("FileInput::openSigMFFileStream: %lu captures. Center frequency of the first one is used",
+				(unsigned long) m_sigMFMeta.m_captures.size());
+		}
+	}
+	else
+	{
+		m_recordLength = 0;
+	}
+
+	if (getMessageQueueToGUI())
+	{
+		MsgReportHeaderCRC *report = MsgReportHeaderCRC::create(metaOK); // meta file validity in place of header CRC
+		getMessageQueueToGUI()->push(report);
+	}
+
+	qDebug() << "FileInput::openSigMFFileStream: " << dataFileName.toStdString().c_str()
+			<< " datatype: " << SigMF::getDataTypeString(m_sigMFMeta.m_dataType)
+			<< " samples: " << nbSamples
+			<< " annotations: " << m_sigMFMeta.m_annotations.size()
+			<< " length: " << m_recordLength << " seconds"
+			<< " sample rate: " << m_sampleRate << " S/s"
+			<< " center frequency: " << m_centerFrequency << " Hz"
+			<< " sample size: " << m_sampleSize << " bits";
+
+	reportFileStreamData();
+
+	if (m_recordLength == 0)
+	{
+		m_mappedReader.close();
+		m_mapped = false;
+	}
+}
+
+void FileInput::openSegmentedFileStream()
+{
+	FileRecord::Header header;
+	bool crcOK = false;
+	QString errorMessage;
+
+	if (m_segmentReader.open(m_fileName, header, crcOK, errorMessage))
+	{
+		m_sampleRate = header.sampleRate;
+		m_centerFrequency = header.centerFrequency;
+		m_startingTimeStamp = m_segmentReader.getStartTime() / 1000; // oldest segment still on disk
+		m_sampleSize = header.sampleSize;
+		QString crcHex = QString("%1").arg(header.crc32 , 0, 16);
+
+	    if (crcOK && (m_sampleRate > 0))
+	    {
+	        qDebug("FileInput::openSegmentedFileStream: CRC32 OK for header: %s", qPrintable(crcHex));
+	        m_recordLength = m_segmentReader.getNbSamples() / m_sampleRate;
+	    }
+	    else
+	    {
+	        qCritical("FileInput::openSegmentedFileStream: bad CRC32 for header: %s", qPrintable(crcHex));
+	        m_recordLength = 0;
+	    }
+
+		if (getMessageQueueToGUI())
+        {
+			MsgReportHeaderCRC *report = MsgReportHeaderCRC::create(crcOK);
+			getMessageQueueToGUI()->push(report);
+		}
+	}
+	else
+	{
+		qCritical("FileInput::openSegmentedFileStream: %s", qPrintable(errorMessage));
+		m_recordLength = 0;
+	}
+
+	qDebug() << "FileInput::openSegmentedFileStream: " << m_fileName.toStdString().c_str()
+			<< " segments: " << m_segmentReader.getNbSegments()
+			<< " samples: " << m_segmentReader.getNbSamples()
+			<< " length: " << m_recordLength << " seconds"
+			<< " sample rate: " << m_sampleRate << " S/s"
+			<< " center frequency: " << m_centerFrequency << " Hz"
+			<< " sample size: " << m_sampleSize << " bits";
+
+	reportFileStreamData();
+
+	if (m_recordLength == 0) {
+	    m_segmentReader.close();
+	}
+}
+
+void FileInput::reportFileStreamData()
+{
 	if (getMessageQueueToGUI())
     {
         DSPSignalNotification *notif = new DSPSignalNotification(m_sampleRate, m_centerFrequency);
@@ -151,24 +374,50 @@ void FileInput::openFileStream()
 	            m_recordLength); // file stream data
 	    getMessageQueueToGUI()->push(report);
 	}
-
-	if (m_recordLength == 0) {
-	    m_ifstream.close();
-	}
 }
 
 void FileInput::seekFileStream(int seekMillis)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && m_fileInputWorker && !m_fileInputWorker->isRunning())
+	if (isFileStreamOpen() && m_fileInputWorker && !m_fileInputWorker->isRunning()) {
+		seekFileStreamSample(((m_recordLength * seekMillis) / 1000) * m_sampleRate);
+	}
+}
+
+void FileInput::seekFileStreamSample(quint64 sampleIndex)
+{
+	m_fileInputWorker->setSamplesCount(sampleIndex);
+	m_endOfFile = false;
+
+	if (m_compressed)
 	{
-        quint64 seekPoint = ((m_recordLength * seekMillis) / 1000) * m_sampleRate;
-		m_fileInputWorker->setSamplesCount(seekPoint);
-        seekPoint *= (m_sampleSize == 24 ? 8 : 4); // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		m_compressedReader.seek(sampleIndex); // decodes from the chunk containing the seek point
+		return;
+	}
+
+	if (m_segmented)
+	{
+		m_segmentReader.seek(sampleIndex);
+		return;
+	}
+
+	if (m_sigMF) // headerless
+	{
+		m_mappedReader.seek(sampleIndex * 2 * SigMF::getComponentBytes(m_sigMFMeta.m_dataType));
+		return;
 	}
+
+	quint64 seekPoint = sampleIndex * (m_sampleSize == 24 ? 8 : 4);
+
+	if (m_mapped)
+	{
+		m_mappedReader.seek(seekPoint + sizeof(FileRecord::Header));
+		return;
+	}
+
+	m_ifstream.clear();
+	m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
 }
 
 void FileInput::init()
@@ -179,7 +428,7 @@ void FileInput::init()
 
 bool FileInput::start()
 {
-    if (!m_ifstream.is_open())
+    if (!isFileStreamOpen())
     {
         qWarning("FileInput::start: file not open. not starting");
         return false;
@@ -188,7 +437,19 @@ bool FileInput::start()
 	QMutexLocker mutexLocker(&m_mutex);
 	qDebug() << "FileInput::start";
 
-	if (m_ifstream.tellg() != (std::streampos)0)
+	if (m_compressed)
+	{
+		m_compressedReader.seek(0);
+	}
+	else if (m_segmented)
+	{
+		m_segmentReader.seek(0);
+	}
+	else if (m_mapped)
+	{
+		m_mappedReader.seek(m_sigMF ? 0 : sizeof(FileRecord::Header));
+	}
+	else if (m_ifstream.tellg() != (std::streampos)0)
     {
 		m_ifstream.clear();
 		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
@@ -200,8 +461,17 @@ bool FileInput::start()
 		return false;
 	}
 
-	m_fileInputWorker = new FileInputWorker(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
+	m_fileInputWorker = new FileInputWorker(
+		&m_ifstream,
+		m_compressed ? &m_compressedReader : nullptr,
+		m_mapped ? &m_mappedReader : nullptr,
+		m_segmented ? &m_segmentReader : nullptr,
+		&m_sampleFifo,
+		m_masterTimer,
+		&m_inputMessageQueue);
 	m_fileInputWorker->moveToThread(&m_fileInputWorkerThread);
+	m_fileInputWorker->setUnthrottled(m_settings.m_unthrottled);
+	m_fileInputWorker->setSigMF(m_sigMF ? m_sigMFMeta.m_dataType : SigMF::DataTypeUnknown, m_sigMFMeta.m_sampleBits);
 	m_fileInputWorker->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
 	startWorker();
 
@@ -242,6 +512,7 @@ void FileInput::stop()
 
 void FileInput::startWorker()
 {
+	m_endOfFile = false;
 	m_fileInputWorker->startWork();
 	m_fileInputWorkerThread.start();
 }
@@ -356,6 +627,33 @@ bool FileInput::handleMessage(const Message& message)
 
 		return true;
 	}
+	else if (MsgConfigureFileSourceSeekSample::match(message))
+	{
+		MsgConfigureFileSourceSeekSample& conf = (MsgConfigureFileSourceSeekSample&) message;
+
+		if (m_fileInputWorker && isFileStreamOpen())
+		{
+			bool running = m_fileInputWorker->isRunning();
+
+			if (running) {
+				stopWorker();
+			}
+
+			m_mutex.lock();
+			seekFileStreamSample(conf.getSampleIndex());
+			m_mutex.unlock();
+
+			if (running) {
+				startWorker();
+			}
+		}
+		else
+		{
+			qWarning("FileInput::handleMessage: MsgConfigureFileSourceSeekSample: not started");
+		}
+
+		return true;
+	}
 	else if (MsgConfigureFileInputStreamTiming::match(message))
 	{
 		MsgReportFileInputStreamTiming *report;
@@ -411,6 +709,8 @@ bool FileInput::handleMessage(const Message& message)
         }
         else
         {
+            m_endOfFile = true;
+
             if (getMessageQueueToGUI())
             {
                 MsgPlayPause *report = MsgPlayPause::create(false);
@@ -445,6 +745,26 @@ bool FileInput::applySettings(const FileInputSettings& settings, bool force)
         }
     }
 
+    if ((m_settings.m_unthrottled != settings.m_unthrottled) || force)
+    {
+        reverseAPIKeys.append("unthrottled");
+
+        if (m_fileInputWorker)
+        {
+            bool running = m_fileInputWorker->isRunning();
+
+            if (running) {
+                stopWorker();
+            }
+
+            m_fileInputWorker->setUnthrottled(settings.m_unthrottled);
+
+            if (running) {
+                startWorker();
+            }
+        }
+    }
+
     if ((m_settings.m_loop != settings.m_loop)) {
         reverseAPIKeys.append("loop");
     }
@@ -513,6 +833,9 @@ void FileInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("loop")) {
         settings.m_loop = response.getFileInputSettings()->getLoop() != 0;
     }
+    if (deviceSettingsKeys.contains("unthrottled")) {
+        settings.m_unthrottled = response.getFileInputSettings()->getUnthrottled() != 0;
+    }
     if (deviceSettingsKeys.contains("useReverseAPI")) {
         settings.m_useReverseAPI = response.getFileInputSettings()->getUseReverseApi() != 0;
     }
@@ -566,11 +889,71 @@ int FileInput::webapiReportGet(
     return 200;
 }
 
+int FileInput::webapiActionsPost(
+        const QStringList& deviceActionsKeys,
+        SWGSDRangel::SWGDeviceActions& query,
+        QString& errorMessage)
+{
+    SWGSDRangel::SWGFileInputActions *swgFileInputActions = query.getFileInputActions();
+
+    if (swgFileInputActions)
+    {
+        quint64 sampleIndex;
+
+        if (deviceActionsKeys.contains("seekSample"))
+        {
+            qint64 seekSample = swgFileInputActions->getSeekSample();
+            sampleIndex = seekSample < 0 ? 0 : seekSample;
+        }
+        else if (deviceActionsKeys.contains("seekAnnotation"))
+        {
+            int annotationIndex = swgFileInputActions->getSeekAnnotation();
+
+            if (!m_sigMF || (annotationIndex < 0) || (annotationIndex >= (int) m_sigMFMeta.m_annotations.size()))
+            {
+                errorMessage = QString("No annotation at index %1").arg(annotationIndex);
+                return 400;
+            }
+
+            sampleIndex = m_sigMFMeta.m_annotations[annotationIndex].m_sampleStart;
+        }
+        else if (deviceActionsKeys.contains("seekDateTime"))
+        {
+            qint64 dateTime = swgFileInputActions->getSeekDateTime() ?
+                SigMF::parseDateTime(*swgFileInputActions->getSeekDateTime()) : -1;
+
+            if (!m_sigMF || (dateTime < 0) || (SigMF::getDateTime(m_sigMFMeta, 0) < 0))
+            {
+                errorMessage = "Invalid date and time or recording without timestamps";
+                return 400;
+            }
+
+            sampleIndex = SigMF::getSampleIndex(m_sigMFMeta, dateTime);
+        }
+        else
+        {
+            errorMessage = "No seek action in FileInputActions";
+            return 400;
+        }
+
+        MsgConfigureFileSourceSeekSample *msg = MsgConfigureFileSourceSeekSample::create(sampleIndex);
+        getInputMessageQueue()->push(msg);
+
+        return 202;
+    }
+    else
+    {
+        errorMessage = "Missing FileInputActions in query";
+        return 400;
+    }
+}
+
 void FileInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& response, const FileInputSettings& settings)
 {
     response.getFileInputSettings()->setFileName(new QString(settings.m_fileName));
     response.getFileInputSettings()->setAccelerationFactor(settings.m_accelerationFactor);
     response.getFileInputSettings()->setLoop(settings.m_loop ? 1 : 0);
+    response.getFileInputSettings()->setUnthrottled(settings.m_unthrottled ? 1 : 0);
 
     response.getFileInputSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
 
@@ -605,10 +988,25 @@ void FileInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response)
     t = t.addMSecs(t_msec);
     response.getFileInputReport()->setElapsedTime(new QString(t.toString("HH:mm:ss.zzz")));
 
-    qint64 startingTimeStampMsec = m_startingTimeStamp * 1000LL;
-    QDateTime dt = QDateTime::fromMSecsSinceEpoch(startingTimeStampMsec);
-    dt = dt.addSecs(t_sec);
-    dt = dt.addMSecs(t_msec);
+    response.getFileInputReport()->setSamplesCount(samplesCount);
+    response.getFileInputReport()->setEndOfFile(m_endOfFile ? 1 : 0);
+
+    qint64 sigMFDateTime = m_sigMF ? SigMF::getDateTime(m_sigMFMeta, samplesCount) :
+        m_segmented ? m_segmentReader.getDateTime(samplesCount) : -1;
+    QDateTime dt;
+
+    if (sigMFDateTime < 0)
+    {
+        qint64 startingTimeStampMsec = m_startingTimeStamp * 1000LL;
+        dt = QDateTime::fromMSecsSinceEpoch(startingTimeStampMsec);
+        dt = dt.addSecs(t_sec);
+        dt = dt.addMSecs(t_msec);
+    }
+    else
+    {
+        dt = QDateTime::fromMSecsSinceEpoch(sigMFDateTime); // follows the capture or recording segments
+    }
+
     response.getFileInputReport()->setAbsoluteTime(new QString(dt.toString("yyyy-MM-dd HH:mm:ss.zzz")));
 
     QTime recordLength(0, 0, 0, 0);
@@ -618,6 +1016,22 @@ void FileInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response)
     response.getFileInputReport()->setFileName(new QString(m_fileName));
     response.getFileInputReport()->setSampleRate(m_sampleRate);
     response.getFileInputReport()->setSampleSize(m_sampleSize);
+
+    if (m_sigMF)
+    {
+        QList<SWGSDRangel::SWGFileInputAnnotation *> *annotations = response.getFileInputReport()->getAnnotations();
+
+        for (const auto& annotation : m_sigMFMeta.m_annotations)
+        {
+            qint64 dateTime = SigMF::getDateTime(m_sigMFMeta, annotation.m_sampleStart);
+            annotations->append(new SWGSDRangel::SWGFileInputAnnotation());
+            annotations->back()->setSampleStart(annotation.m_sampleStart);
+            annotations->back()->setSampleCount(annotation.m_sampleCount);
+            annotations->back()->setLabel(new QString(annotation.m_label));
+            annotations->back()->setComment(new QString(annotation.m_comment));
+            annotations->back()->setDateTime(new QString(dateTime < 0 ? "" : SigMF::formatDateTime(dateTime)));
+        }
+    }
 }
 
 void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const FileInputSettings& settings, bool force)
@@ -637,6 +1051,9 @@ void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, co
     if (deviceSettingsKeys.contains("loop") || force) {
         swgFileInputSettings->setLoop(settings.m_loop);
     }
+    if (deviceSettingsKeys.contains("unthrottled") || force) {
+        swgFileInputSettings->setUnthrottled(settings.m_unthrottled ? 1 : 0);
+    }
     if (deviceSettingsKeys.contains("fileName") || force) {
         swgFileInputSettings->setFileName(new QString(settings.m_fileName));
     }
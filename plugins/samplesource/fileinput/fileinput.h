@@ -30,6 +30,10 @@
 #include <QNetworkRequest>
 
 #include "dsp/devicesamplesource.h"
+#include "dsp/filerecordcompressedreader.h"
+#include "dsp/filerecordsegmentreader.h"
+#include "dsp/sigmf.h"
+#include "util/mappedfilereader.h"
 #include "fileinputsettings.h"
 
 class QNetworkAccessManager;
@@ -140,6 +144,26 @@ public:
 		{ }
 	};
 
+	class MsgConfigureFileSourceSeekSample : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		quint64 getSampleIndex() const { return m_sampleIndex; }
+
+		static MsgConfigureFileSourceSeekSample* create(quint64 sampleIndex)
+		{
+			return new MsgConfigureFileSourceSeekSample(sampleIndex);
+		}
+
+	protected:
+		quint64 m_sampleIndex; //!< seek position in samples from the beginning
+
+		MsgConfigureFileSourceSeekSample(quint64 sampleIndex) :
+			Message(),
+			m_sampleIndex(sampleIndex)
+		{ }
+	};
+
 	class MsgReportFileSourceAcquisition : public Message {
 		MESSAGE_CLASS_DECLARATION
 
@@ -321,6 +345,11 @@ public:
             SWGSDRangel::SWGDeviceReport& response,
             QString& errorMessage);
 
+    virtual int webapiActionsPost(
+            const QStringList& deviceActionsKeys,
+            SWGSDRangel::SWGDeviceActions& query,
+            QString& errorMessage);
+
     static void webapiFormatDeviceSettings(
             SWGSDRangel::SWGDeviceSettings& response,
             const FileInputSettings& settings);
@@ -335,6 +364,15 @@ public:
 	QMutex m_mutex;
 	FileInputSettings m_settings;
 	std::ifstream m_ifstream;
+	FileRecordCompressedReader m_compressedReader; //!< for .sdriqz files
+	bool m_compressed;                             //!< file is read with the compressed reader
+	MappedFileReader m_mappedReader;               //!< for .sdriq files when they can be mapped
+	bool m_mapped;                                 //!< file is read with the mapped reader
+	bool m_sigMF;                                  //!< SigMF recording read with the mapped reader
+	FileRecordSegmentReader m_segmentReader;       //!< for the .sdriqseg index of a rolling recording
+	bool m_segmented;                              //!< segments are read with the segment reader
+	bool m_endOfFile;                              //!< playback stopped at end of file (no loop)
+	SigMF::Meta m_sigMFMeta;
 	FileInputWorker* m_fileInputWorker;
 	QThread m_fileInputWorkerThread;
 	QString m_deviceDescription;
@@ -351,7 +389,16 @@ public:
 	void startWorker();
 	void stopWorker();
 	void openFileStream();
+	void openCompressedFileStream();
+	void openSigMFFileStream();
+	void openSegmentedFileStream();
+	void reportFileStreamData();
+	bool isFileStreamOpen() const {
+		return m_compressed ? m_compressedReader.isOpen() : m_segmented ? m_segmentReader.isOpen() :
+			m_mapped ? m_mappedReader.isOpen() : m_ifstream.is_open();
+	}
 	void seekFileStream(int seekMillis);
+	void seekFileStreamSample(quint64 sampleIndex); //!< worker must be stopped and m_mutex held
 	bool applySettings(const FileInputSettings& settings, bool force = false);
     void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
     void webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const FileInputSettings& settings, bool force);
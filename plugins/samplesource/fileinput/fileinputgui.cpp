@@ -242,7 +242,13 @@ void FileInputGUI::displaySettings()
 {
     blockApplySettings(true);
     ui->playLoop->setChecked(m_settings.m_loop);
-    ui->acceleration->setCurrentIndex(FileInputSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+
+    if (m_settings.m_unthrottled) {
+        ui->acceleration->setCurrentIndex(ui->acceleration->count() - 1);
+    } else {
+        ui->acceleration->setCurrentIndex(FileInputSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+    }
+
     blockApplySettings(false);
 }
 
@@ -320,7 +326,7 @@ void FileInputGUI::on_showFileDialog_clicked(bool checked)
 {
     (void) checked;
 	QString fileName = QFileDialog::getOpenFileName(this,
-	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq)"), 0, QFileDialog::DontUseNativeDialog);
+	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq *.sdriqz *.sdriqseg *.sigmf-meta *.sigmf-data)"), 0, QFileDialog::DontUseNativeDialog);
 
 	if (fileName != "")
 	{
@@ -335,7 +341,12 @@ void FileInputGUI::on_acceleration_currentIndexChanged(int index)
 {
     if (m_doApplySettings)
     {
-        m_settings.m_accelerationFactor = FileInputSettings::getAccelerationValue(index);
+        m_settings.m_unthrottled = index == ui->acceleration->count() - 1; // last item is "Max"
+
+        if (!m_settings.m_unthrottled) {
+            m_settings.m_accelerationFactor = FileInputSettings::getAccelerationValue(index);
+        }
+
         FileInput::MsgConfigureFileInput *message = FileInput::MsgConfigureFileInput::create(m_settings, false);
         m_sampleSource->getInputMessageQueue()->push(message);
     }
@@ -427,6 +438,7 @@ void FileInputGUI::setAccelerationCombo()
         ui->acceleration->addItem(s);
     }
 
+    ui->acceleration->addItem(QString("Max")); // unthrottled
     ui->acceleration->blockSignals(false);
 }
 
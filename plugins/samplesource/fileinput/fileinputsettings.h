@@ -25,6 +25,7 @@ struct FileInputSettings {
     QString m_fileName;
     quint32 m_accelerationFactor;
     bool m_loop;
+    bool m_unthrottled; //!< play as fast as downstream processing allows
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -15,12 +15,17 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <stdio.h>
 #include <errno.h>
 #include <assert.h>
 #include <QDebug>
+#include <QThread>
 
 #include "dsp/filerecord.h"
+#include "dsp/filerecordcompressedreader.h"
+#include "dsp/filerecordsegmentreader.h"
+#include "util/mappedfilereader.h"
 #include "fileinputworker.h"
 #include "dsp/samplesinkfifo.h"
 #include "util/messagequeue.h"
@@ -28,6 +33,9 @@
 MESSAGE_CLASS_DEFINITION(FileInputWorker::MsgReportEOF, Message)
 
 FileInputWorker::FileInputWorker(std::ifstream *samplesStream,
+        FileRecordCompressedReader *compressedReader,
+        MappedFileReader *mappedReader,
+        FileRecordSegmentReader *segmentReader,
         SampleSinkFifo* sampleFifo,
         const QTimer& timer,
         MessageQueue *fileInputMessageQueue,
@@ -35,6 +43,9 @@ FileInputWorker::FileInputWorker(std::ifstream *samplesStream,
 	QObject(parent),
 	m_running(false),
 	m_ifstream(samplesStream),
+	m_compressedReader(compressedReader),
+	m_mappedReader(mappedReader),
+	m_segmentReader(segmentReader),
 	m_fileBuf(nullptr),
 	m_convertBuf(nullptr),
 	m_bufsize(0),
@@ -47,7 +58,10 @@ FileInputWorker::FileInputWorker(std::ifstream *samplesStream,
 	m_samplesize(0),
 	m_samplebytes(0),
     m_throttlems(FILESOURCE_THROTTLE_MS),
-    m_throttleToggle(false)
+    m_throttleToggle(false),
+    m_unthrottled(false),
+    m_sigMFDataType(SigMF::DataTypeUnknown),
+    m_sigMFSampleBits(16)
 {
     assert(m_ifstream != nullptr);
 }
@@ -71,12 +85,21 @@ void FileInputWorker::startWork()
 {
 	qDebug() << "FileInputThread::startWork: ";
 
-    if (m_ifstream->is_open())
+    bool open = m_compressedReader ? m_compressedReader->isOpen() :
+        m_segmentReader ? m_segmentReader->isOpen() :
+        m_mappedReader ? m_mappedReader->isOpen() : m_ifstream->is_open();
+
+    if (open)
     {
-        qDebug() << "FileInputThread::startWork: file stream open, starting...";
+        qDebug() << "FileInputThread::startWork: file stream open, starting..." << (m_unthrottled ? "unthrottled" : "");
         m_elapsedTimer.start();
-        connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
 		m_running = true;
+
+        if (m_unthrottled) {
+            QMetaObject::invokeMethod(this, "runUnthrottled", Qt::QueuedConnection); // runs when the thread is started
+        } else {
+            connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+        }
     }
     else
     {
@@ -107,7 +130,16 @@ void FileInputWorker::setSampleRateAndSize(int samplerate, quint32 samplesize)
 
 		m_samplerate = samplerate;
 		m_samplesize = samplesize;
-		m_samplebytes = m_samplesize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+		unsigned int samplebytes = m_sigMFDataType != SigMF::DataTypeUnknown ?
+			SigMF::getComponentBytes(m_sigMFDataType) :
+			m_samplesize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+
+		if (samplebytes != m_samplebytes) // conversion buffer is sized in samples
+		{
+			m_samplebytes = samplebytes;
+			m_bufsize = 0;
+		}
+
         m_chunksize = (m_samplerate * 2 * m_samplebytes * m_throttlems) / 1000;
 
         setBuffers(m_chunksize);
@@ -116,6 +148,16 @@ void FileInputWorker::setSampleRateAndSize(int samplerate, quint32 samplesize)
 	//m_samplerate = samplerate;
 }
 
+void FileInputWorker::setSigMF(SigMF::DataType dataType, unsigned int sampleBits)
+{
+    if ((dataType != m_sigMFDataType) || (sampleBits != m_sigMFSampleBits)) {
+        m_samplerate = 0; // force sample size recalculation at next setSampleRateAndSize
+    }
+
+    m_sigMFDataType = dataType;
+    m_sigMFSampleBits = sampleBits;
+}
+
 void FileInputWorker::setBuffers(std::size_t chunksize)
 {
     if (chunksize > m_bufsize)
@@ -174,25 +216,117 @@ void FileInputWorker::tick()
             setBuffers(m_chunksize);
         }
 
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+        readChunk();
+	}
+}
 
-        if (m_ifstream->eof())
+void FileInputWorker::runUnthrottled()
+{
+    // chunk size is the one set for the acceleration factor and the sample FIFO is sized accordingly
+    unsigned int chunkSamples = m_chunksize / (2 * m_samplebytes);
+    chunkSamples = std::min(chunkSamples, m_sampleFifo->size());
+
+    while (m_running)
+    {
+        // the FIFO reader wakes us up when downstream has consumed samples
+        if (!m_sampleFifo->waitForSpace(chunkSamples, FILESOURCE_BACKPRESSURE_TIMEOUT_MS)) {
+            continue;
+        } else if (!readChunk()) {
+            break; // end of file is handled by FileInput that stops or restarts the worker
+        }
+    }
+}
+
+bool FileInputWorker::readChunk()
+{
+    if (m_compressedReader)
+    {
+        // chunks are decoded as they are reached
+        qint64 nbBytes = m_compressedReader->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+        writeToSampleFifo(m_fileBuf, (qint32) nbBytes);
+
+        if (m_compressedReader->isEOF())
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-        	MsgReportEOF *message = MsgReportEOF::create();
-        	m_fileInputMessageQueue->push(message);
+            MsgReportEOF *message = MsgReportEOF::create();
+            m_fileInputMessageQueue->push(message);
+            return false;
         }
-        else
+
+        m_samplesCount += nbBytes / (2 * m_samplebytes);
+        return true;
+    }
+
+    if (m_segmentReader)
+    {
+        // chunks are cut at segment ends. The next segment is mapped on the following read
+        qint64 nbBytes;
+        const quint8 *buf = reinterpret_cast<const quint8*>(m_segmentReader->next(m_chunksize, nbBytes));
+        writeToSampleFifo(buf, (qint32) nbBytes);
+
+        if (m_segmentReader->isEOF())
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+            MsgReportEOF *message = MsgReportEOF::create();
+            m_fileInputMessageQueue->push(message);
+            return false;
         }
-	}
+
+        m_samplesCount += nbBytes / (2 * m_samplebytes);
+        return true;
+    }
+
+    if (m_mappedReader)
+    {
+        // samples go from the mapping to the sample FIFO without intermediate copy
+        qint64 nbBytes;
+        const quint8 *buf = reinterpret_cast<const quint8*>(m_mappedReader->next(m_chunksize, nbBytes));
+        writeToSampleFifo(buf, (qint32) nbBytes);
+
+        if (m_mappedReader->isEOF())
+        {
+            MsgReportEOF *message = MsgReportEOF::create();
+            m_fileInputMessageQueue->push(message);
+            return false;
+        }
+
+        m_samplesCount += nbBytes / (2 * m_samplebytes);
+        return true;
+    }
+
+    // read samples directly feeding the SampleFifo (no callback)
+    m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+
+    if (m_ifstream->eof())
+    {
+        writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
+        MsgReportEOF *message = MsgReportEOF::create();
+        m_fileInputMessageQueue->push(message);
+        return false;
+    }
+
+    writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
+    m_samplesCount += m_chunksize / (2 * m_samplebytes);
+    return true;
 }
 
 void FileInputWorker::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 {
+	if (m_sigMFDataType != SigMF::DataTypeUnknown)
+	{
+		int nbSamples = nbBytes / (2 * m_samplebytes);
+
+		if (SigMF::isNative(m_sigMFDataType, m_sigMFSampleBits))
+		{
+			m_sampleFifo->write(buf, nbSamples*sizeof(Sample));
+		}
+		else
+		{
+			SigMF::convert(m_sigMFDataType, m_sigMFSampleBits, (const char *) buf, nbSamples, (Sample *) m_convertBuf);
+			m_sampleFifo->write(m_convertBuf, nbSamples*sizeof(Sample));
+		}
+
+		return;
+	}
+
 	if (m_samplesize == 16)
 	{
 		if (SDR_RX_SAMP_SZ == 16)
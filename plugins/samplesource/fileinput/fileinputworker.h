@@ -25,12 +25,17 @@
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
+#include "dsp/sigmf.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_BACKPRESSURE_TIMEOUT_MS 100 //!< longest wait for room in the sample FIFO in unthrottled mode before checking for stop
 
 class SampleSinkFifo;
 class MessageQueue;
+class FileRecordCompressedReader;
+class MappedFileReader;
+class FileRecordSegmentReader;
 
 class FileInputWorker : public QObject {
 	Q_OBJECT
@@ -51,6 +56,9 @@ public:
     };
 
 	FileInputWorker(std::ifstream *samplesStream,
+	        FileRecordCompressedReader *compressedReader,
+	        MappedFileReader *mappedReader,
+	        FileRecordSegmentReader *segmentReader,
 	        SampleSinkFifo* sampleFifo,
 	        const QTimer& timer,
 	        MessageQueue *fileInputMessageQueue,
@@ -64,11 +72,17 @@ public:
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
     void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    void setUnthrottled(bool unthrottled) { m_unthrottled = unthrottled; } //!< effective at next start
+    /** Samples are of this SigMF data type unless DataTypeUnknown. To be called before setSampleRateAndSize */
+    void setSigMF(SigMF::DataType dataType, unsigned int sampleBits);
 
 private:
 	volatile bool m_running;
 
 	std::ifstream* m_ifstream;
+	FileRecordCompressedReader *m_compressedReader; //!< reads instead of the stream when not null
+	MappedFileReader *m_mappedReader;               //!< reads instead of the stream when not null
+	FileRecordSegmentReader *m_segmentReader;       //!< reads instead of the stream when not null
 	quint8  *m_fileBuf;
 	quint8  *m_convertBuf;
 	std::size_t m_bufsize;
@@ -84,12 +98,17 @@ private:
     qint64 m_throttlems;
     QElapsedTimer m_elapsedTimer;
     bool m_throttleToggle;
+    bool m_unthrottled;    //!< paced by room in the sample FIFO instead of the timer
+    SigMF::DataType m_sigMFDataType;
+    unsigned int m_sigMFSampleBits;
 
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
+	bool readChunk(); //!< reads a chunk into the sample FIFO. Returns false at end of file
 
 private slots:
 	void tick();
+	void runUnthrottled();
 };
 
 #endif // INCLUDE_FILEINPUTWORKER_H
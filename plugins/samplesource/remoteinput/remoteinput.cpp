@@ -273,6 +273,29 @@ void RemoteInput::applySettings(const RemoteInputSettings& settings, bool force)
         reverseAPIKeys.append("fileRecordName");
     }
 
+    if ((m_settings.m_fecPipelineDepth != settings.m_fecPipelineDepth) || force)
+    {
+        reverseAPIKeys.append("fecPipelineDepth");
+        m_remoteInputUDPHandler->setFECPipelineDepth(settings.m_fecPipelineDepth);
+    }
+
+    if ((m_settings.m_targetLatencyMs != settings.m_targetLatencyMs) || force)
+    {
+        reverseAPIKeys.append("targetLatencyMs");
+        m_remoteInputUDPHandler->setTargetLatency(settings.m_targetLatencyMs);
+    }
+
+    if ((m_settings.m_sharedMemory != settings.m_sharedMemory) || force) {
+        reverseAPIKeys.append("sharedMemory");
+    }
+    if ((m_settings.m_shmName != settings.m_shmName) || force) {
+        reverseAPIKeys.append("shmName");
+    }
+
+    if ((m_settings.m_sharedMemory != settings.m_sharedMemory) || (m_settings.m_shmName != settings.m_shmName) || force) {
+        m_remoteInputUDPHandler->configureSharedMemory(settings.m_sharedMemory, settings.m_shmName);
+    }
+
     if ((m_settings.m_dcBlock != settings.m_dcBlock) || (m_settings.m_iqCorrection != settings.m_iqCorrection) || force)
     {
         m_deviceAPI->configureCorrections(settings.m_dcBlock, settings.m_iqCorrection);
@@ -425,6 +448,22 @@ void RemoteInput::webapiUpdateDeviceSettings(
     if (deviceSettingsKeys.contains("fileRecordName")) {
         settings.m_fileRecordName = *response.getRemoteInputSettings()->getFileRecordName();
     }
+    if (deviceSettingsKeys.contains("fecPipelineDepth"))
+    {
+        int fecPipelineDepth = response.getRemoteInputSettings()->getFecPipelineDepth();
+        settings.m_fecPipelineDepth = fecPipelineDepth < 1 ? 1 : fecPipelineDepth > 16 ? 16 : fecPipelineDepth;
+    }
+    if (deviceSettingsKeys.contains("targetLatencyMs"))
+    {
+        int targetLatencyMs = response.getRemoteInputSettings()->getTargetLatencyMs();
+        settings.m_targetLatencyMs = targetLatencyMs < 0 ? 0 : targetLatencyMs > 10000 ? 10000 : targetLatencyMs;
+    }
+    if (deviceSettingsKeys.contains("sharedMemory")) {
+        settings.m_sharedMemory = response.getRemoteInputSettings()->getSharedMemory() != 0;
+    }
+    if (deviceSettingsKeys.contains("shmName")) {
+        settings.m_shmName = *response.getRemoteInputSettings()->getShmName();
+    }
     if (deviceSettingsKeys.contains("useReverseAPI")) {
         settings.m_useReverseAPI = response.getRemoteInputSettings()->getUseReverseApi() != 0;
     }
@@ -454,6 +493,16 @@ void RemoteInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& res
         response.getRemoteInputSettings()->setFileRecordName(new QString(settings.m_fileRecordName));
     }
 
+    response.getRemoteInputSettings()->setFecPipelineDepth(settings.m_fecPipelineDepth);
+    response.getRemoteInputSettings()->setTargetLatencyMs(settings.m_targetLatencyMs);
+    response.getRemoteInputSettings()->setSharedMemory(settings.m_sharedMemory ? 1 : 0);
+
+    if (response.getRemoteInputSettings()->getShmName()) {
+        *response.getRemoteInputSettings()->getShmName() = settings.m_shmName;
+    } else {
+        response.getRemoteInputSettings()->setShmName(new QString(settings.m_shmName));
+    }
+
     response.getRemoteInputSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
 
     if (response.getRemoteInputSettings()->getReverseApiAddress()) {
@@ -488,6 +537,14 @@ void RemoteInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respons
 
     response.getRemoteInputReport()->setMinNbBlocks(m_remoteInputUDPHandler->getMinNbBlocks());
     response.getRemoteInputReport()->setMaxNbRecovery(m_remoteInputUDPHandler->getMaxNbRecovery());
+    response.getRemoteInputReport()->setDatagramsCount(m_remoteInputUDPHandler->getNbDatagrams());
+    response.getRemoteInputReport()->setKernelDropsCount(m_remoteInputUDPHandler->getKernelDrops());
+    response.getRemoteInputReport()->setQueueDropsCount(m_remoteInputUDPHandler->getQueueDrops());
+    response.getRemoteInputReport()->setLatencyMs(m_remoteInputUDPHandler->getLatencyMs());
+    response.getRemoteInputReport()->setTargetLatencyMs(m_remoteInputUDPHandler->getTargetLatencyMs());
+    response.getRemoteInputReport()->setJitterMs(m_remoteInputUDPHandler->getJitterMs());
+    response.getRemoteInputReport()->setCorrectionPpm(m_remoteInputUDPHandler->getRateCorrectionPPM());
+    response.getRemoteInputReport()->setShmLostSamples(m_remoteInputUDPHandler->getShmLostSamples());
 }
 
 void RemoteInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, const RemoteInputSettings& settings, bool force)
@@ -522,6 +579,18 @@ void RemoteInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys,
     if (deviceSettingsKeys.contains("fileRecordName") || force) {
         swgRemoteInputSettings->setFileRecordName(new QString(settings.m_fileRecordName));
     }
+    if (deviceSettingsKeys.contains("fecPipelineDepth") || force) {
+        swgRemoteInputSettings->setFecPipelineDepth(settings.m_fecPipelineDepth);
+    }
+    if (deviceSettingsKeys.contains("targetLatencyMs") || force) {
+        swgRemoteInputSettings->setTargetLatencyMs(settings.m_targetLatencyMs);
+    }
+    if (deviceSettingsKeys.contains("sharedMemory") || force) {
+        swgRemoteInputSettings->setSharedMemory(settings.m_sharedMemory ? 1 : 0);
+    }
+    if (deviceSettingsKeys.contains("shmName") || force) {
+        swgRemoteInputSettings->setShmName(new QString(settings.m_shmName));
+    }
 
     QString deviceSettingsURL = QString("http://%1:%2/sdrangel/deviceset/%3/device/settings")
             .arg(settings.m_reverseAPIAddress)
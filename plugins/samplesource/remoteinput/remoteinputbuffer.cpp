@@ -22,13 +22,42 @@
 #include <algorithm>
 #include <boost/crc.hpp>
 #include <boost/cstdint.hpp>
+#include <QRunnable>
+#include <QThread>
+
 #include "remoteinputbuffer.h"
 
+class RemoteInputBuffer::DecodeTask : public QRunnable
+{
+public:
+    DecodeTask(RemoteInputBuffer *buffer, int slotIndex, const CM256::cm256_encoder_params& paramsCM256) :
+        m_buffer(buffer),
+        m_slotIndex(slotIndex),
+        m_paramsCM256(paramsCM256)
+    {}
+
+    virtual void run()
+    {
+        m_buffer->decodeSlot(m_slotIndex, m_paramsCM256);
+        m_buffer->slotDecoded(m_slotIndex);
+    }
+
+private:
+    RemoteInputBuffer *m_buffer;
+    int m_slotIndex;
+    CM256::cm256_encoder_params m_paramsCM256;
+};
+
 
 
 RemoteInputBuffer::RemoteInputBuffer() :
+        m_frameNbBytes(sizeof(BufferFrame)),
+        m_codec(RemoteCodec::CodecRaw),
+        m_codecSampleBytes(2),
+        m_blockNbBytes(RemoteNbBytesPerBlock),
         m_decoderSlots(nullptr),
         m_frames(nullptr),
+        m_sampleFrames(nullptr),
         m_decoderIndexHead(m_nbDecoderSlots/2),
         m_curNbBlocks(0),
         m_minNbBlocks(256),
@@ -44,7 +73,9 @@ RemoteInputBuffer::RemoteInputBuffer() :
         m_nbReads(0),
         m_nbWrites(0),
         m_balCorrection(0),
-	    m_balCorrLimit(0)
+	    m_balCorrLimit(0),
+        m_fecPipelineDepth(1),
+        m_lastArrivalUs(-1)
 {
 	m_currentMeta.init();
     setNbDecoderSlots(16);
@@ -63,10 +94,14 @@ RemoteInputBuffer::RemoteInputBuffer() :
 
     std::fill(m_decoderSlots, m_decoderSlots + m_nbDecoderSlots, DecoderSlot());
     std::fill(m_frames, m_frames + m_nbDecoderSlots, BufferFrame());
+    setFECPipelineDepth(4);
+    m_arrivalTimer.start();
 }
 
 RemoteInputBuffer::~RemoteInputBuffer()
 {
+    m_decoderPool.waitForDone();
+
 	if (m_readBuffer) {
 		delete[] m_readBuffer;
 	}
@@ -76,13 +111,32 @@ RemoteInputBuffer::~RemoteInputBuffer()
     if (m_frames) {
         delete[] m_frames;
     }
+    if (m_sampleFrames) {
+        delete[] m_sampleFrames;
+    }
 }
 
 void RemoteInputBuffer::setNbDecoderSlots(int nbDecoderSlots)
 {
+    // pending frames are lost with the slots
+    m_decoderPool.waitForDone();
+    m_pendingSlots.clear();
+    m_decodedSlots.clear();
+
+    unsigned int sampleBytes = m_currentMeta.getSampleBytes();
+    m_codec = RemoteCodec::CodecRaw;
+
+    if (RemoteCodec::isValid(m_currentMeta.getCodec()) && ((sampleBytes == 2) || (sampleBytes == 4)))
+    {
+        m_codec = (RemoteCodec::Codec) m_currentMeta.getCodec();
+        m_codecSampleBytes = sampleBytes;
+    }
+
     m_nbDecoderSlots = nbDecoderSlots;
-    m_framesSize = m_nbDecoderSlots * (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock;
-  	m_framesNbBytes = m_nbDecoderSlots * sizeof(BufferFrame);
+    m_frameNbBytes = getBufferFrameSize(m_currentMeta);
+    m_blockNbBytes = m_frameNbBytes / (RemoteNbOrginalBlocks - 1);
+    m_framesSize = m_nbDecoderSlots * m_frameNbBytes;
+  	m_framesNbBytes = m_nbDecoderSlots * m_frameNbBytes;
     m_wrDeltaEstimate = m_framesNbBytes / 2;
 
     if (m_decoderSlots) {
@@ -91,16 +145,31 @@ void RemoteInputBuffer::setNbDecoderSlots(int nbDecoderSlots)
     if (m_frames) {
         delete[] m_frames;
     }
+    if (m_sampleFrames) {
+        delete[] m_sampleFrames;
+    }
 
     m_decoderSlots = new DecoderSlot[m_nbDecoderSlots];
     m_frames = new BufferFrame[m_nbDecoderSlots];
+    m_sampleFrames = m_codec == RemoteCodec::CodecRaw ? nullptr : new uint8_t[m_framesNbBytes](); // raw samples are read in the frames
 
     m_frameHead = -1;
 }
 
+int RemoteInputBuffer::getBufferFrameSize(const RemoteMetaDataFEC& metaData)
+{
+    unsigned int sampleBytes = metaData.getSampleBytes();
+
+    if (RemoteCodec::isValid(metaData.getCodec()) && (metaData.getCodec() != RemoteCodec::CodecRaw) && ((sampleBytes == 2) || (sampleBytes == 4))) {
+        return (RemoteNbOrginalBlocks - 1) * RemoteCodec::getNbSamplesPerBlock((RemoteCodec::Codec) metaData.getCodec(), sampleBytes) * 2 * sampleBytes;
+    } else {
+        return sizeof(BufferFrame);
+    }
+}
+
 void RemoteInputBuffer::setBufferLenSec(const RemoteMetaDataFEC& metaData)
 {
-    m_bufferLenSec = (float) m_framesNbBytes / (float) (metaData.m_sampleRate * metaData.m_sampleBytes * 2);
+    m_bufferLenSec = (float) m_framesNbBytes / (float) (metaData.m_sampleRate * metaData.getSampleBytes() * 2);
 }
 
 void RemoteInputBuffer::initDecodeAllSlots()
@@ -155,10 +224,12 @@ void RemoteInputBuffer::initDecodeSlot(int slotIndex)
 
 void RemoteInputBuffer::initReadIndex()
 {
-    m_readIndex = ((m_decoderIndexHead + (m_nbDecoderSlots/2)) % m_nbDecoderSlots) * sizeof(BufferFrame);
+    m_readIndex = ((m_decoderIndexHead + (m_nbDecoderSlots/2)) % m_nbDecoderSlots) * m_frameNbBytes;
     m_wrDeltaEstimate = m_framesNbBytes / 2;
     m_nbReads = 0;
     m_nbWrites = 0;
+    m_lastArrivalUs = -1;
+    m_latencyControl.restart();
 }
 
 void RemoteInputBuffer::rwCorrectionEstimate(int slotIndex)
@@ -166,24 +237,24 @@ void RemoteInputBuffer::rwCorrectionEstimate(int slotIndex)
 	if (m_nbReads >= 40) // check every ~1s as tick is ~50ms
 	{
 		int targetPivotSlot = (slotIndex + (m_nbDecoderSlots/2))  % m_nbDecoderSlots; // slot at half buffer opposite of current write slot
-		int targetPivotIndex = targetPivotSlot * sizeof(BufferFrame);             // buffer index corresponding to start of above slot
-		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + m_nbDecoderSlots * sizeof(BufferFrame) :  m_readIndex)
-				- (targetPivotSlot * sizeof(BufferFrame)); // normalize read index so it is positive and zero at start of pivot slot
+		int targetPivotIndex = targetPivotSlot * m_frameNbBytes;                   // buffer index corresponding to start of above slot
+		int normalizedReadIndex = (m_readIndex < targetPivotIndex ? m_readIndex + m_nbDecoderSlots * m_frameNbBytes :  m_readIndex)
+				- (targetPivotSlot * m_frameNbBytes); // normalize read index so it is positive and zero at start of pivot slot
 		int dBytes;
-        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * sizeof(BufferFrame));
+        int rwDelta = (m_nbReads * m_readNbBytes) - (m_nbWrites * m_frameNbBytes);
 
-		if (normalizedReadIndex < (m_nbDecoderSlots/ 2) * (int) sizeof(BufferFrame)) // read leads
+		if (normalizedReadIndex < (m_nbDecoderSlots/ 2) * m_frameNbBytes) // read leads
 		{
 			dBytes = - normalizedReadIndex - rwDelta;
 		}
 		else // read lags
 		{
-            int bufSize = (m_nbDecoderSlots * sizeof(BufferFrame));
+            int bufSize = (m_nbDecoderSlots * m_frameNbBytes);
 			dBytes = bufSize - normalizedReadIndex - rwDelta;
 		}
 
          // calculate exponential moving average on floating point for better accuracy (was int)
-        double newCorrection = ((double) dBytes) / (((int) m_currentMeta.m_sampleBytes) * 2 * m_nbReads);
+        double newCorrection = ((double) dBytes) / (((int) m_currentMeta.getSampleBytes()) * 2 * m_nbReads);
         m_balCorrection = 0.25*m_balCorrection + 0.75*newCorrection; // exponential average with alpha = 0.75 (original is wrong)
         //m_balCorrection = (m_balCorrection / 4) + (dBytes / (int) (m_currentMeta.m_sampleBytes * 2 * m_nbReads)); // correction is in number of samples. Alpha = 0.25
 
@@ -200,15 +271,15 @@ void RemoteInputBuffer::rwCorrectionEstimate(int slotIndex)
 
 void RemoteInputBuffer::checkSlotData(int slotIndex)
 {
-    int pseudoWriteIndex = slotIndex * sizeof(BufferFrame);
+    int pseudoWriteIndex = slotIndex * m_frameNbBytes;
     m_wrDeltaEstimate = pseudoWriteIndex - m_readIndex;
-    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : sizeof(BufferFrame) * m_nbDecoderSlots + m_wrDeltaEstimate);
+    int rwDelayBytes = (m_wrDeltaEstimate > 0 ? m_wrDeltaEstimate : m_frameNbBytes * m_nbDecoderSlots + m_wrDeltaEstimate);
     int sampleRate = m_currentMeta.m_sampleRate;
 
     if (sampleRate > 0)
     {
         int64_t ts = m_currentMeta.m_tv_sec * 1000000LL + m_currentMeta.m_tv_usec;
-        ts -= (rwDelayBytes * 1000000LL) / (sampleRate * 2 * m_currentMeta.m_sampleBytes);
+        ts -= (rwDelayBytes * 1000000LL) / (sampleRate * 2 * m_currentMeta.getSampleBytes());
         m_tvOut_sec = ts / 1000000LL;
         m_tvOut_usec = ts - (m_tvOut_sec * 1000000LL);
     }
@@ -228,10 +299,13 @@ void RemoteInputBuffer::writeData(char *array)
     int frameIndex = superBlock->m_header.m_frameIndex;
     int decoderIndex = frameIndex % m_nbDecoderSlots;
 
+    processDecodedSlots(m_fecPipelineDepth);
+
     // frame break
 
     if (m_frameHead == -1) // initial state
     {
+        processDecodedSlots(0);
         m_decoderIndexHead = decoderIndex; // new decoder slot head
         m_frameHead = frameIndex;
         initReadIndex(); // reset read index
@@ -239,6 +313,10 @@ void RemoteInputBuffer::writeData(char *array)
     }
     else if (m_frameHead != frameIndex) // frame break => new frame starts
     {
+        if (std::find(m_pendingSlots.begin(), m_pendingSlots.end(), decoderIndex) != m_pendingSlots.end()) {
+            processDecodedSlots(0); // the slot is still being decoded
+        }
+
         m_decoderIndexHead = decoderIndex; // new decoder slot head
         m_frameHead = frameIndex;          // new frame head
         checkSlotData(decoderIndex);       // check slot before re-init
@@ -291,79 +369,198 @@ void RemoteInputBuffer::writeData(char *array)
                 m_paramsCM256.RecoveryCount = m_decoderSlots[decoderIndex].m_recoveryCount;
             }
 
-            if (m_cm256.cm256_decode(m_paramsCM256, m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks)) // CM256 decode
+            if (m_fecPipelineDepth > 1) // decode in the pool. Meta data is processed when the frame comes out
             {
-                qDebug() << "RemoteInputBuffer::writeData: decode CM256 error:"
-                        << " decoderIndex: " << decoderIndex
-                        << " m_blockCount: " << m_decoderSlots[decoderIndex].m_blockCount
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
+                processDecodedSlots(m_fecPipelineDepth - 1);
+                m_pendingSlots.push_back(decoderIndex);
+                m_decoderPool.start(new DecodeTask(this, decoderIndex, m_paramsCM256));
+                return;
             }
-            else
-            {
-                qDebug() << "RemoteInputBuffer::writeData: decode CM256 success:"
-                        << " decoderIndex: " << decoderIndex
-                        << " m_blockCount: " << m_decoderSlots[decoderIndex].m_blockCount
-                        << " m_originalCount: " << m_decoderSlots[decoderIndex].m_originalCount
-                        << " m_recoveryCount: " << m_decoderSlots[decoderIndex].m_recoveryCount;
 
-                for (int ir = 0; ir < m_decoderSlots[decoderIndex].m_recoveryCount; ir++) // restore missing blocks
-                {
-                    int recoveryIndex = RemoteNbOrginalBlocks - m_decoderSlots[decoderIndex].m_recoveryCount + ir;
-                    int blockIndex = m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
-                    RemoteProtectedBlock *recoveredBlock = (RemoteProtectedBlock *) m_decoderSlots[decoderIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
-
-                    if (blockIndex == 0) // first block with meta
-                    {
-                        RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) recoveredBlock;
-
-                        boost::crc_32_type crc32;
-                        crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
-
-                        if (crc32.checksum() == metaData->m_crc32)
-                        {
-                            m_decoderSlots[decoderIndex].m_metaRetrieved = true;
-                            printMeta("RemoteInputBuffer::writeData: recovered meta", metaData);
-                        }
-                        else
-                        {
-                            qDebug() << "RemoteInputBuffer::writeData: recovered meta: invalid CRC32";
-                        }
-                    }
-
-                    storeOriginalBlock(decoderIndex, blockIndex, *recoveredBlock);
-
-                    qDebug() << "RemoteInputBuffer::writeData: recovered block #" << blockIndex;
-                } // restore missing blocks
-            } // CM256 decode
+            decodeSlot(decoderIndex, m_paramsCM256);
         } // recovery
 
-        if (m_decoderSlots[decoderIndex].m_metaRetrieved) // block zero with its meta data has been received
+        if (m_pendingSlots.empty())
         {
-            RemoteMetaDataFEC *metaData = getMetaData(decoderIndex);
+            processMeta(decoderIndex);
+        }
+        else // keep the order of frames
+        {
+            m_pendingSlots.push_back(decoderIndex);
+            slotDecoded(decoderIndex);
+        }
+    } // decode
+}
+
+void RemoteInputBuffer::decodeSlot(int slotIndex, const CM256::cm256_encoder_params& paramsCM256)
+{
+    if (m_cm256.cm256_decode(paramsCM256, m_decoderSlots[slotIndex].m_cm256DescriptorBlocks)) // CM256 decode
+    {
+        qDebug() << "RemoteInputBuffer::decodeSlot: decode CM256 error:"
+                << " slotIndex: " << slotIndex
+                << " m_originalCount: " << m_decoderSlots[slotIndex].m_originalCount
+                << " m_recoveryCount: " << m_decoderSlots[slotIndex].m_recoveryCount;
+    }
+    else
+    {
+        qDebug() << "RemoteInputBuffer::decodeSlot: decode CM256 success:"
+                << " slotIndex: " << slotIndex
+                << " m_originalCount: " << m_decoderSlots[slotIndex].m_originalCount
+                << " m_recoveryCount: " << m_decoderSlots[slotIndex].m_recoveryCount;
 
-            if (!(*metaData == m_currentMeta))
+        for (int ir = 0; ir < m_decoderSlots[slotIndex].m_recoveryCount; ir++) // restore missing blocks
+        {
+            int recoveryIndex = RemoteNbOrginalBlocks - m_decoderSlots[slotIndex].m_recoveryCount + ir;
+            int blockIndex = m_decoderSlots[slotIndex].m_cm256DescriptorBlocks[recoveryIndex].Index;
+            RemoteProtectedBlock *recoveredBlock = (RemoteProtectedBlock *) m_decoderSlots[slotIndex].m_cm256DescriptorBlocks[recoveryIndex].Block;
+
+            if (blockIndex == 0) // first block with meta
             {
-                uint32_t sampleRate =  metaData->m_sampleRate;
+                RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) recoveredBlock;
+
+                boost::crc_32_type crc32;
+                crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
 
-                if (sampleRate != 0)
+                if (crc32.checksum() == metaData->m_crc32)
                 {
-                    setBufferLenSec(*metaData);
-                    m_balCorrLimit = sampleRate / 400; // +/- 5% correction max per read
-                    m_readNbBytes = (sampleRate * metaData->m_sampleBytes * 2) / 20;
+                    m_decoderSlots[slotIndex].m_metaRetrieved = true;
+                    printMeta("RemoteInputBuffer::decodeSlot: recovered meta", metaData);
                 }
+                else
+                {
+                    qDebug() << "RemoteInputBuffer::decodeSlot: recovered meta: invalid CRC32";
+                }
+            }
+
+            storeOriginalBlock(slotIndex, blockIndex, *recoveredBlock);
+
+            qDebug() << "RemoteInputBuffer::decodeSlot: recovered block #" << blockIndex;
+        } // restore missing blocks
+    } // CM256 decode
+}
+
+void RemoteInputBuffer::processMeta(int slotIndex)
+{
+    if (m_decoderSlots[slotIndex].m_metaRetrieved) // block zero with its meta data has been received
+    {
+        RemoteMetaDataFEC *metaData = getMetaData(slotIndex);
 
-                printMeta("RemoteInputBuffer::writeData: new meta", metaData); // print for change other than timestamp
+        if (!(*metaData == m_currentMeta))
+        {
+            uint32_t sampleRate =  metaData->m_sampleRate;
+
+            if (sampleRate != 0)
+            {
+                setBufferLenSec(*metaData);
+                m_balCorrLimit = sampleRate / 400; // +/- 5% correction max per read
+                m_readNbBytes = (sampleRate * metaData->getSampleBytes() * 2) / 20;
             }
 
-            m_currentMeta = *metaData; // renew current meta
-        } // check block 0
-    } // decode
+            printMeta("RemoteInputBuffer::processMeta: new meta", metaData); // print for change other than timestamp
+        }
+
+        m_currentMeta = *metaData; // renew current meta
+    } // check block 0
+
+    updateLatency(slotIndex);
+}
+
+void RemoteInputBuffer::updateLatency(int slotIndex)
+{
+    int bytesPerSecond = m_currentMeta.m_sampleRate * m_currentMeta.getSampleBytes() * 2;
+
+    if (bytesPerSecond == 0) {
+        return;
+    }
+
+    qint64 arrivalUs = m_arrivalTimer.nsecsElapsed() / 1000;
+    double dt = m_lastArrivalUs < 0 ? 0.0 : (arrivalUs - m_lastArrivalUs) * 1e-6;
+    m_lastArrivalUs = arrivalUs;
+
+    // jitter: variation of the transit time from the sender timestamps so that clocks need not be synchronized
+    if (m_decoderSlots[slotIndex].m_metaRetrieved)
+    {
+        RemoteMetaDataFEC *metaData = getMetaData(slotIndex);
+        m_latencyControl.updateJitter(arrivalUs - (metaData->m_tv_sec * 1000000LL + metaData->m_tv_usec));
+    }
+
+    // latency: samples buffered after this frame. Read index beyond the frame is an underrun
+    int writeIndex = ((slotIndex + 1) % m_nbDecoderSlots) * m_frameNbBytes;
+    int fillBytes = writeIndex - m_readIndex;
+
+    if (fillBytes < 0) {
+        fillBytes += m_framesNbBytes;
+    }
+
+    if (fillBytes > (3 * m_framesNbBytes) / 4) {
+        fillBytes -= m_framesNbBytes;
+    }
+
+    float latencyMs = (fillBytes * 1000.0f) / bytesPerSecond;
+    float frameMs = (m_frameNbBytes * 1000.0f) / bytesPerSecond;
+
+    if (m_latencyControl.update(dt, latencyMs, frameMs))
+    {
+        int sampleSize = m_currentMeta.getSampleBytes() * 2;
+        int targetBytes = ((int) ((m_latencyControl.getEffectiveTargetMs() * bytesPerSecond) / (1000.0f * sampleSize))) * sampleSize;
+        targetBytes = std::min(targetBytes, m_framesNbBytes - m_frameNbBytes);
+        m_readIndex = writeIndex - targetBytes;
+
+        if (m_readIndex < 0) {
+            m_readIndex += m_framesNbBytes;
+        }
+
+        m_latencyControl.resynced((targetBytes * 1000.0f) / bytesPerSecond);
+    }
+}
+
+void RemoteInputBuffer::slotDecoded(int slotIndex)
+{
+    QMutexLocker mutexLocker(&m_decoderMutex);
+    m_decodedSlots.insert(slotIndex);
+    m_decoderCondition.wakeAll();
+}
+
+void RemoteInputBuffer::processDecodedSlots(unsigned int maxPending)
+{
+    // meta data is processed in the order the frames were completed whatever the order of decoding
+    while (!m_pendingSlots.empty())
+    {
+        int slotIndex = m_pendingSlots.front();
+
+        {
+            QMutexLocker mutexLocker(&m_decoderMutex);
+
+            if (m_pendingSlots.size() > maxPending)
+            {
+                while (m_decodedSlots.count(slotIndex) == 0) {
+                    m_decoderCondition.wait(&m_decoderMutex);
+                }
+            }
+            else if (m_decodedSlots.count(slotIndex) == 0)
+            {
+                break;
+            }
+
+            m_decodedSlots.erase(slotIndex);
+        }
+
+        m_pendingSlots.pop_front();
+        processMeta(slotIndex);
+    }
+}
+
+void RemoteInputBuffer::setFECPipelineDepth(unsigned int depth)
+{
+    processDecodedSlots(0);
+    m_fecPipelineDepth = depth < 1 ? 1 : depth;
+    m_decoderPool.setMaxThreadCount(std::max(1, std::min((int) m_fecPipelineDepth, QThread::idealThreadCount())));
+    qDebug("RemoteInputBuffer::setFECPipelineDepth: %u frames with %d threads", m_fecPipelineDepth, m_decoderPool.maxThreadCount());
 }
 
 uint8_t *RemoteInputBuffer::readData(int32_t length)
 {
-    uint8_t *buffer = (uint8_t *) m_frames;
+    uint8_t *buffer = m_sampleFrames ? m_sampleFrames : (uint8_t *) m_frames;
     uint32_t readIndex = m_readIndex;
 
     m_nbReads++;
@@ -408,7 +605,8 @@ void RemoteInputBuffer::printMeta(const QString& header, RemoteMetaDataFEC *meta
 	qDebug() << header << ": "
             << "|" << metaData->m_centerFrequency
             << ":" << metaData->m_sampleRate
-            << ":" << (int) (metaData->m_sampleBytes & 0xF)
+            << ":" << (int) metaData->getSampleBytes()
+            << ":" << (int) metaData->getCodec()
             << ":" << (int) metaData->m_sampleBits
             << ":" << (int) metaData->m_nbOriginalBlocks
             << ":" << (int) metaData->m_nbFECBlocks
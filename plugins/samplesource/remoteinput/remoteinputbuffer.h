@@ -21,8 +21,16 @@
 #include <channel/remotedatablock.h>
 #include <QString>
 #include <QDebug>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QElapsedTimer>
 #include <cstdlib>
+#include <deque>
+#include <set>
 #include "cm256cc/cm256.h"
+#include "channel/remotecodec.h"
+#include "channel/remotelatencycontrol.h"
 #include "util/movingaverage.h"
 
 
@@ -36,9 +44,11 @@ public:
 	~RemoteInputBuffer();
 
     // Sizing
-    void setNbDecoderSlots(int nbDecoderSlots);
-    static int getBufferFrameSize() { return sizeof(BufferFrame); }
+    void setNbDecoderSlots(int nbDecoderSlots); //!< Also sets the samples buffer for the sample size and codec of the current meta data
+    static int getBufferFrameSize(const RemoteMetaDataFEC& metaData); //!< Size in bytes of the samples of a frame
     void setBufferLenSec(const RemoteMetaDataFEC& metaData);
+    /** Maximum number of frames FEC decoded in parallel by the pool threads. With 1 frames are decoded by the writer */
+    void setFECPipelineDepth(unsigned int depth);
 
 	// R/W operations
 	void writeData(char *array); //!< Write data into buffer.
@@ -92,6 +102,16 @@ public:
     float getBufferLengthInSecs() const { return m_bufferLenSec; }
     int32_t getRWBalanceCorrection() const { return m_balCorrection; }
 
+    // latency targeting
+    /** Latency to hold in ms by correcting the read rate. 0 to read half a buffer behind the writes */
+    void setTargetLatency(unsigned int targetLatencyMs) { m_latencyControl.setTargetLatency(targetLatencyMs); }
+    unsigned int getTargetLatency() const { return m_latencyControl.getTargetLatency(); }
+    float getEffectiveTargetLatencyMs() const { return m_latencyControl.getEffectiveTargetMs(); } //!< Target raised to what the frame size and jitter peak allow
+    float getLatencyMs() const { return m_latencyControl.getLatencyMs(); }   //!< (stats) Smoothed buffered duration at frame completion
+    float getJitterMs() const { return m_latencyControl.getJitterMs(); }     //!< (stats) Frames arrival jitter
+    float getRateCorrectionPPM() const { return m_latencyControl.getRateCorrection() * 1e6; }
+    double getRateRatio() const { return 1.0 + m_latencyControl.getRateCorrection(); } //!< Number of samples to read per nominal output sample
+
     /** Get buffer gauge value in % of buffer size ([-50:50])
      *  [-50:0] : write leads or read lags
      *  [0:50]  : read leads or write lags
@@ -111,8 +131,14 @@ public:
     }
 
 private:
+    class DecodeTask;
+
     int m_nbDecoderSlots;
     int m_framesSize;
+    int m_frameNbBytes;                          //!< Number of bytes of samples per frame
+    RemoteCodec::Codec m_codec;                  //!< Codec of the samples buffer
+    unsigned int m_codecSampleBytes;             //!< Bytes per I or Q sample of the samples buffer
+    int m_blockNbBytes;                          //!< Number of bytes of samples per data block
 
 #pragma pack(push, 1)
     struct BufferFrame
@@ -138,7 +164,8 @@ private:
     RemoteMetaDataFEC m_currentMeta;             //!< Stored current meta data
     CM256::cm256_encoder_params m_paramsCM256;   //!< CM256 decoder parameters block
     DecoderSlot          *m_decoderSlots;        //!< CM256 decoding control/buffer slots
-    BufferFrame          *m_frames;              //!< Samples buffer
+    BufferFrame          *m_frames;              //!< Samples buffer if not compressed else data blocks for FEC decoding
+    uint8_t              *m_sampleFrames;        //!< Samples buffer with data blocks decoded if compressed else nullptr
     int                  m_framesNbBytes;        //!< Number of bytes in samples buffer
     int                  m_decoderIndexHead;     //!< index of the current head frame slot in decoding slots
     int                  m_frameHead;            //!< index of the current head frame sent
@@ -167,9 +194,20 @@ private:
     int      m_nbWrites;      //!< Number of buffer writes since start of auto R/W balance correction period
     int      m_balCorrection; //!< R/W balance correction in number of samples
     int      m_balCorrLimit;  //!< Correction absolute value limit in number of samples
-    CM256    m_cm256;         //!< CM256 library
+    CM256    m_cm256;         //!< CM256 library. Shared by the pool threads as decoding only reads its tables
     bool     m_cm256_OK;      //!< CM256 library initialized OK
 
+    unsigned int    m_fecPipelineDepth;  //!< Maximum number of frames decoded in parallel
+    QThreadPool     m_decoderPool;
+    std::deque<int> m_pendingSlots;      //!< Slots of the completed frames waiting for their meta data to be processed in order (writer)
+    QMutex          m_decoderMutex;      //!< Protects the set below
+    QWaitCondition  m_decoderCondition;
+    std::set<int>   m_decodedSlots;      //!< Slots decoded by the pool threads
+
+    RemoteLatencyControl m_latencyControl; //!< Read rate correction when targeting latency
+    QElapsedTimer   m_arrivalTimer;
+    qint64          m_lastArrivalUs;     //!< Arrival time of the last frame completed. -1 if none
+
     inline RemoteProtectedBlock* storeOriginalBlock(int slotIndex, int blockIndex, const RemoteProtectedBlock& protectedBlock)
     {
         if (blockIndex == 0) {
@@ -181,6 +219,11 @@ private:
             // m_decoderSlots[slotIndex].m_originalBlocks[blockIndex] = protectedBlock;
             // return &m_decoderSlots[slotIndex].m_originalBlocks[blockIndex];
             m_frames[slotIndex].m_blocks[blockIndex - 1] = protectedBlock;
+
+            if (m_sampleFrames) {
+                decodeSamples(slotIndex, blockIndex, protectedBlock);
+            }
+
             return &m_frames[slotIndex].m_blocks[blockIndex - 1];
         }
     }
@@ -207,6 +250,19 @@ private:
         // memset((void *) m_decoderSlots[slotIndex].m_originalBlocks, 0, m_nbOriginalBlocks * sizeof(ProtectedBlock));
         memset((void *) &m_decoderSlots[slotIndex].m_blockZero, 0, sizeof(RemoteProtectedBlock));
         memset((void *) m_frames[slotIndex].m_blocks, 0, (RemoteNbOrginalBlocks - 1) * sizeof(RemoteProtectedBlock));
+
+        if (m_sampleFrames) {
+            memset((void *) &m_sampleFrames[slotIndex * m_frameNbBytes], 0, m_frameNbBytes);
+        }
+    }
+
+    inline void decodeSamples(int slotIndex, int blockIndex, const RemoteProtectedBlock& protectedBlock)
+    {
+        uint8_t *samples = &m_sampleFrames[slotIndex * m_frameNbBytes + (blockIndex - 1) * m_blockNbBytes];
+
+        if (!RemoteCodec::decode(m_codec, protectedBlock, m_codecSampleBytes, samples)) {
+            memset((void *) samples, 0, m_blockNbBytes); // block of another codec or corrupted
+        }
     }
 
     void initDecodeAllSlots();
@@ -214,6 +270,11 @@ private:
     void rwCorrectionEstimate(int slotIndex);
     void checkSlotData(int slotIndex);
     void initDecodeSlot(int slotIndex);
+    void decodeSlot(int slotIndex, const CM256::cm256_encoder_params& paramsCM256); //!< FEC decode and restore the missing blocks
+    void processMeta(int slotIndex);
+    void updateLatency(int slotIndex);                 //!< Latency, jitter and rate correction update on frame completion
+    void slotDecoded(int slotIndex);                   //!< Called from the pool threads
+    void processDecodedSlots(unsigned int maxPending); //!< Process the frames decoded in order. Wait until at most maxPending frames are left
 
     static void printMeta(const QString& header, RemoteMetaDataFEC *metaData);
 };
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "remoteinputresampler.h"
+
+RemoteInputResampler::RemoteInputResampler() :
+    m_ratio(1.0),
+    m_position(0.0),
+    m_sampleBytes(0),
+    m_samples(2*m_nbPastSamples, 0.0f)
+{}
+
+void RemoteInputResampler::reset()
+{
+    m_position = 0.0;
+    std::fill(m_samples.begin(), m_samples.begin() + 2*m_nbPastSamples, 0.0f);
+}
+
+void RemoteInputResampler::resample(const uint8_t *input, unsigned int nbOutputSamples, unsigned int sampleBytes, uint8_t *output)
+{
+    unsigned int nbInputSamples = getNbInputSamples(nbOutputSamples);
+
+    if (sampleBytes != m_sampleBytes) // past samples are in another scale
+    {
+        reset();
+        m_sampleBytes = sampleBytes;
+    }
+
+    if (sampleBytes == sizeof(int16_t)) {
+        resample((const int16_t*) input, nbInputSamples, nbOutputSamples, (int16_t*) output);
+    } else {
+        resample((const int32_t*) input, nbInputSamples, nbOutputSamples, (int32_t*) output);
+    }
+}
+
+template<typename T>
+void RemoteInputResampler::resample(const T *input, unsigned int nbInputSamples, unsigned int nbOutputSamples, T *output)
+{
+    const float vmin = std::numeric_limits<T>::min();
+    const float vmax = std::numeric_limits<T>::max();
+    m_samples.resize(2*(m_nbPastSamples + nbInputSamples));
+    std::copy(input, input + 2*nbInputSamples, m_samples.begin() + 2*m_nbPastSamples);
+    const float *s = m_samples.data();
+
+    // output sample k is between samples i and i + 1 with i = floor(1 + position + k * ratio)
+    // the four past samples ensure that samples i - 1 to i + 2 are available for any ratio up to 2
+    for (unsigned int k = 0; k < nbOutputSamples; k++)
+    {
+        double p = 1.0 + m_position + k * m_ratio;
+        unsigned int i = (unsigned int) p;
+        float t = p - i;
+
+        for (unsigned int c = 0; c < 2; c++)
+        {
+            float y0 = s[2*(i-1) + c];
+            float y1 = s[2*i + c];
+            float y2 = s[2*(i+1) + c];
+            float y3 = s[2*(i+2) + c];
+            float y = y1 + 0.5f*t*(y2 - y0 + t*(2.0f*y0 - 5.0f*y1 + 4.0f*y2 - y3 + t*(3.0f*(y1 - y2) + y3 - y0)));
+            output[2*k + c] = (T) std::round(std::min(std::max(y, vmin), vmax));
+        }
+    }
+
+    // the last four input samples become the past samples of the next call
+    double position = m_position + nbOutputSamples * m_ratio;
+    m_position = position - nbInputSamples;
+    std::copy(m_samples.begin() + 2*nbInputSamples, m_samples.begin() + 2*(nbInputSamples + m_nbPastSamples), m_samples.begin());
+}
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Fractional resampler of the jitter buffer                                     //
+//                                                                               //
+// Reads input samples at a rate slightly different from the output rate to     //
+// track the sender clock without dropping or repeating samples. Output samples  //
+// are interpolated with a 4 point cubic (Catmull-Rom) polynomial. The position  //
+// and the last input samples are kept between calls so that the output is       //
+// continuous.                                                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTRESAMPLER_H_
+#define PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTRESAMPLER_H_
+
+#include <stdint.h>
+#include <vector>
+
+class RemoteInputResampler
+{
+public:
+    RemoteInputResampler();
+
+    void reset(); //!< Clear the past samples
+    void setRatio(double ratio) { m_ratio = ratio; } //!< Number of input samples per output sample. Close to 1
+    double getRatio() const { return m_ratio; }
+    /** Number of input samples consumed to produce nbOutputSamples samples */
+    unsigned int getNbInputSamples(unsigned int nbOutputSamples) const { return (unsigned int) (m_position + nbOutputSamples * m_ratio); }
+    /**
+     * Produce nbOutputSamples I/Q samples from the getNbInputSamples(nbOutputSamples) next input samples.
+     * Samples are interleaved I and Q components of sampleBytes bytes (2 or 4).
+     */
+    void resample(const uint8_t *input, unsigned int nbOutputSamples, unsigned int sampleBytes, uint8_t *output);
+
+private:
+    static const unsigned int m_nbPastSamples = 4;
+
+    double m_ratio;
+    double m_position;              //!< Fractional position of the next output sample from the second past sample
+    unsigned int m_sampleBytes;     //!< Sample size of the past samples
+    std::vector<float> m_samples;   //!< Past samples followed by the input samples of the current call (I, Q)
+
+    template<typename T>
+    void resample(const T *input, unsigned int nbInputSamples, unsigned int nbOutputSamples, T *output);
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTRESAMPLER_H_ */
@@ -32,6 +32,10 @@ void RemoteInputSettings::resetToDefaults()
     m_dcBlock = false;
     m_iqCorrection = false;
     m_fileRecordName = "";
+    m_fecPipelineDepth = 4;
+    m_targetLatencyMs = 0;
+    m_sharedMemory = false;
+    m_shmName = "sdrangel_remote";
     m_useReverseAPI = false;
     m_reverseAPIAddress = "127.0.0.1";
     m_reverseAPIPort = 8888;
@@ -52,6 +56,10 @@ QByteArray RemoteInputSettings::serialize() const
     s.writeString(12, m_reverseAPIAddress);
     s.writeU32(13, m_reverseAPIPort);
     s.writeU32(14, m_reverseAPIDeviceIndex);
+    s.writeU32(15, m_fecPipelineDepth);
+    s.writeU32(16, m_targetLatencyMs);
+    s.writeBool(17, m_sharedMemory);
+    s.writeString(18, m_shmName);
 
     return s.final();
 }
@@ -90,6 +98,12 @@ bool RemoteInputSettings::deserialize(const QByteArray& data)
 
         d.readU32(14, &uintval, 0);
         m_reverseAPIDeviceIndex = uintval > 99 ? 99 : uintval;
+        d.readU32(15, &uintval, 4);
+        m_fecPipelineDepth = uintval < 1 ? 1 : uintval > 16 ? 16 : uintval;
+        d.readU32(16, &uintval, 0);
+        m_targetLatencyMs = uintval > 10000 ? 10000 : uintval;
+        d.readBool(17, &m_sharedMemory, false);
+        d.readString(18, &m_shmName, "sdrangel_remote");
         return true;
     }
     else
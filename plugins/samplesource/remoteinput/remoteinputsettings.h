@@ -29,6 +29,10 @@ struct RemoteInputSettings {
     bool    m_dcBlock;
     bool    m_iqCorrection;
     QString m_fileRecordName;
+    uint32_t m_fecPipelineDepth; //!< Maximum number of frames FEC decoded in parallel
+    uint32_t m_targetLatencyMs;  //!< Latency held by correcting the read rate. 0: read half a buffer behind
+    bool     m_sharedMemory;     //!< Read the samples from a Remote Sink shared memory ring of the same host instead of UDP
+    QString  m_shmName;          //!< Shared memory ring name
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "dsp/samplesinkfifo.h"
+
+#include "remoteinputshmreader.h"
+
+RemoteInputShmReader::RemoteInputShmReader(SampleSinkFifo *sampleFifo) :
+    m_sampleFifo(sampleFifo),
+    m_stopRequested(false),
+    m_lostSamples(0),
+    m_writeTimeUs(0)
+{
+    m_meta.init();
+}
+
+RemoteInputShmReader::~RemoteInputShmReader()
+{
+    stopReader();
+}
+
+void RemoteInputShmReader::startReader(const QString& name)
+{
+    stopReader();
+    m_name = name;
+    m_stopRequested = false;
+    m_lostSamples = 0;
+    m_writeTimeUs = 0;
+    start();
+    qDebug("RemoteInputShmReader::startReader: %s", m_name.toStdString().c_str());
+}
+
+void RemoteInputShmReader::stopReader()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    m_stopRequested = true;
+    wait();
+    qDebug("RemoteInputShmReader::stopReader: %s: %llu samples lost", m_name.toStdString().c_str(), m_lostSamples.load());
+}
+
+void RemoteInputShmReader::getMeta(RemoteMetaDataFEC& metaData)
+{
+    QMutexLocker mutexLocker(&m_metaMutex);
+    metaData = m_meta;
+}
+
+void RemoteInputShmReader::run()
+{
+    uint64_t readCount = 0;
+    uint32_t metaSeq = 0;
+    RemoteMetaDataFEC metaData;
+
+    while (!m_stopRequested.load())
+    {
+        if (!m_ring.isOpen())
+        {
+            if (!m_ring.attach(m_name))
+            {
+                msleep(m_waitTimeoutMs); // writer not there yet
+                continue;
+            }
+
+            readCount = m_ring.getWriteCount(); // start with the new samples
+            metaSeq = m_ring.getMeta(metaData) + 1; // force meta data update
+        }
+
+        if (m_ring.isClosed()) // writer has left. A new segment may be created with the same name
+        {
+            m_ring.close();
+            continue;
+        }
+
+        if (!m_ring.wait(readCount, m_waitTimeoutMs)) {
+            continue;
+        }
+
+        uint32_t seq = m_ring.getMeta(metaData);
+
+        if (seq != metaSeq)
+        {
+            metaSeq = seq;
+
+            {
+                QMutexLocker mutexLocker(&m_metaMutex);
+                m_meta = metaData;
+            }
+
+            emit metaChanged();
+        }
+
+        unsigned int sampleSize = metaData.getSampleBytes() * 2;
+        unsigned int length;
+        uint64_t lost;
+        const uint8_t *data = m_ring.read(readCount, m_maxReadBytes, length, lost);
+
+        if (sampleSize == 0) // no meta data yet
+        {
+            readCount += length;
+            continue;
+        }
+
+        if (lost != 0) {
+            m_lostSamples += lost / sampleSize;
+        }
+
+        // samples are only pushed once the copy is known not to have been overwritten by the writer
+        unsigned int nbBytes = copySamples(data, length, metaData);
+
+        if (!m_ring.isValid(readCount)) { // overwritten while being copied. The next read skips to valid data
+            m_lostSamples += length / sampleSize;
+        } else if (nbBytes > 0) {
+            m_sampleFifo->write(reinterpret_cast<quint8*>(m_converterBuffer.data()), nbBytes);
+        }
+
+        readCount += length;
+        m_writeTimeUs = m_ring.getWriteTimeUs();
+    }
+
+    m_ring.close();
+}
+
+unsigned int RemoteInputShmReader::copySamples(const uint8_t *data, unsigned int length, const RemoteMetaDataFEC& metaData)
+{
+    unsigned int nbSamples = length / (metaData.getSampleBytes() * 2);
+
+    if ((metaData.m_sampleBits == 16) && (SDR_RX_SAMP_SZ == 24)) // 16 -> 24 bits
+    {
+        m_converterBuffer.resize(nbSamples*2);
+        const int16_t *samples = (const int16_t *) data;
+
+        for (unsigned int is = 0; is < nbSamples; is++)
+        {
+            m_converterBuffer[2*is] = samples[2*is] << 8;     // I
+            m_converterBuffer[2*is+1] = samples[2*is+1] << 8; // Q
+        }
+
+        return nbSamples*sizeof(Sample);
+    }
+    else if ((metaData.m_sampleBits == 24) && (SDR_RX_SAMP_SZ == 16)) // 24 -> 16 bits
+    {
+        m_converterBuffer.resize(nbSamples);
+        const int32_t *samples = (const int32_t *) data;
+
+        for (unsigned int is = 0; is < nbSamples; is++)
+        {
+            m_converterBuffer[is] = samples[2*is+1]>>8; // Q -> MSB
+            m_converterBuffer[is] <<= 16;
+            m_converterBuffer[is] += (samples[2*is]>>8) & 0xFFFF; // I -> LSB
+        }
+
+        return nbSamples*sizeof(Sample);
+    }
+    else if ((metaData.m_sampleBits == 16) || (metaData.m_sampleBits == 24)) // same sample size: plain copy
+    {
+        unsigned int nbBytes = nbSamples * metaData.getSampleBytes() * 2;
+        m_converterBuffer.resize((nbBytes + sizeof(int32_t) - 1) / sizeof(int32_t));
+        std::memcpy(m_converterBuffer.data(), data, nbBytes);
+        return nbBytes;
+    }
+    else
+    {
+        return 0;
+    }
+}
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Remote input shared memory reader thread                                      //
+//                                                                               //
+// Attaches to the shared memory ring of a Remote Sink of the same host and      //
+// pushes the samples to the sample FIFO as soon as the writer wakes it up.      //
+// There are no frames, FEC nor jitter buffer: the ring is the buffer. If the    //
+// segment is not there yet or is closed by the writer attachment is retried.    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTSHMREADER_H_
+#define PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTSHMREADER_H_
+
+#include <atomic>
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QString>
+
+#include "channel/remotedatablock.h"
+#include "channel/remoteshmring.h"
+
+class SampleSinkFifo;
+
+class RemoteInputShmReader : public QThread
+{
+    Q_OBJECT
+public:
+    RemoteInputShmReader(SampleSinkFifo *sampleFifo);
+    virtual ~RemoteInputShmReader();
+
+    void startReader(const QString& name);
+    void stopReader();
+
+    void getMeta(RemoteMetaDataFEC& metaData);   //!< Meta data of the samples being read
+    uint64_t getWriteTimeUs() const { return m_writeTimeUs.load(); }
+    quint64 getLostSamples() const { return m_lostSamples.load(); }
+
+signals:
+    void metaChanged(); //!< Emitted when the writer publishes new meta data
+
+private:
+    SampleSinkFifo *m_sampleFifo;
+    QString m_name;
+    RemoteShmRing m_ring;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<quint64> m_lostSamples;
+    std::atomic<uint64_t> m_writeTimeUs;
+    QMutex m_metaMutex;
+    RemoteMetaDataFEC m_meta;
+    std::vector<int32_t> m_converterBuffer; //!< samples copied out of the ring before they are validated
+
+    static const int m_waitTimeoutMs = 100;           //!< stop request and writer presence polling period
+    static const unsigned int m_maxReadBytes = 1<<20; //!< maximum number of bytes pushed to the FIFO at once
+
+    virtual void run();
+    unsigned int copySamples(const uint8_t *data, unsigned int length, const RemoteMetaDataFEC& metaData); //!< returns bytes copied
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTSHMREADER_H_ */
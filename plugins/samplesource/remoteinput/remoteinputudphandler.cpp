@@ -19,6 +19,8 @@
 #include <QDebug>
 #include <QTimer>
 
+#include <algorithm>
+
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
 #include "device/deviceapi.h"
@@ -35,14 +37,17 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_running(false),
     m_rateDivider(1000/REMOTEINPUT_THROTTLE_MS),
 	m_dataSocket(0),
+    m_dataReceiver(nullptr),
 	m_dataAddress(QHostAddress::LocalHost),
 	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
 	m_dataConnected(false),
 	m_udpBuf(0),
 	m_udpReadBytes(0),
+    m_nbDatagrams(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
+	m_sampleBytes(0),
 	m_centerFrequency(0),
 	m_tv_msec(0),
 	m_messageQueueToGUI(0),
@@ -55,7 +60,11 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_converterBuffer(0),
     m_converterBufferNbSamples(0),
     m_throttleToggle(false),
-	m_autoCorrBuffer(true)
+	m_autoCorrBuffer(true),
+    m_readLengthRemainder(0.0),
+    m_sharedMemory(false),
+    m_shmName("sdrangel_remote"),
+    m_shmReader(sampleFifo)
 {
     m_udpBuf = new char[RemoteUdpSize];
 
@@ -68,11 +77,13 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_throttlems = m_masterTimer.interval();
 #endif
     m_rateDivider = 1000 / m_throttlems;
+    connect(&m_shmReader, SIGNAL(metaChanged()), this, SLOT(shmMetaChanged()), Qt::QueuedConnection);
 }
 
 RemoteInputUDPHandler::~RemoteInputUDPHandler()
 {
 	stop();
+    delete m_dataReceiver;
 	delete[] m_udpBuf;
 	if (m_converterBuffer) { delete[] m_converterBuffer; }
 #ifdef USE_INTERNAL_TIMER
@@ -90,6 +101,34 @@ void RemoteInputUDPHandler::start()
 	    return;
 	}
 
+    if (m_sharedMemory)
+    {
+        m_shmReader.startReader(m_shmName);
+        m_running = true;
+        return;
+    }
+
+#if defined(__linux__)
+    if (!m_dataReceiver)
+    {
+        m_dataReceiver = new RemoteInputUDPReceiver();
+        connect(m_dataReceiver, SIGNAL(dataReady()), this, SLOT(dataReadyRead()), Qt::QueuedConnection);
+    }
+
+    if (!m_dataConnected)
+    {
+        if (m_dataReceiver->startReceiver(m_dataAddress, m_dataPort))
+        {
+            qDebug("RemoteInputUDPHandler::start: receive thread bound to %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
+            m_dataConnected = true;
+        }
+        else
+        {
+            qWarning("RemoteInputUDPHandler::start: cannot bind data port %d", m_dataPort);
+            m_dataConnected = false;
+        }
+    }
+#else
 	if (!m_dataSocket)
 	{
 		m_dataSocket = new QUdpSocket(this);
@@ -111,7 +150,9 @@ void RemoteInputUDPHandler::start()
 			m_dataConnected = false;
 		}
 	}
+#endif
 
+    m_nbDatagrams = 0;
     m_elapsedTimer.start();
     m_running = true;
 }
@@ -125,11 +166,16 @@ void RemoteInputUDPHandler::stop()
 	}
 
 	disconnectTimer();
+    m_shmReader.stopReader();
 
     if (m_dataConnected)
     {
 		m_dataConnected = false;
+#if defined(__linux__)
+        m_dataReceiver->stopReceiver();
+#else
 	    disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
+#endif
 	}
 
 	if (m_dataSocket)
@@ -140,6 +186,7 @@ void RemoteInputUDPHandler::stop()
 
 	m_centerFrequency = 0;
 	m_samplerate = 0;
+	m_sampleBytes = 0;
 	m_running = false;
 }
 
@@ -159,8 +206,72 @@ void RemoteInputUDPHandler::configureUDPLink(const QString& address, quint16 por
 	start();
 }
 
+void RemoteInputUDPHandler::configureSharedMemory(bool sharedMemory, const QString& name)
+{
+    qDebug("RemoteInputUDPHandler::configureSharedMemory: %s %s", sharedMemory ? "on" : "off", name.toStdString().c_str());
+    bool wasRunning = m_running;
+    stop();
+    m_sharedMemory = sharedMemory;
+    m_shmName = name;
+
+    if (wasRunning) {
+        start();
+    }
+}
+
+void RemoteInputUDPHandler::shmMetaChanged()
+{
+    if (!m_sharedMemory || !m_running) {
+        return;
+    }
+
+    RemoteMetaDataFEC metaData;
+    m_shmReader.getMeta(metaData);
+    bool change = false;
+
+    if (m_centerFrequency != metaData.m_centerFrequency)
+    {
+        m_centerFrequency = metaData.m_centerFrequency;
+        change = true;
+    }
+
+    if (m_samplerate != metaData.m_sampleRate)
+    {
+        if (m_messageQueueToInput)
+        {
+            MsgReportSampleRateChange *msg = MsgReportSampleRateChange::create(metaData.m_sampleRate);
+            m_messageQueueToInput->push(msg);
+        }
+
+        m_samplerate = metaData.m_sampleRate;
+        change = true;
+    }
+
+    m_sampleBytes = metaData.m_sampleBytes;
+
+    if (change && (m_samplerate != 0)) {
+        reportStreamChange();
+    }
+}
+
 void RemoteInputUDPHandler::dataReadyRead()
 {
+#if defined(__linux__)
+    if (!m_dataConnected) {
+        return;
+    }
+
+    m_dataReceiver->acknowledge();
+    RemoteSuperBlock *superBlock;
+
+    while ((superBlock = m_dataReceiver->frontBlock()) != nullptr)
+    {
+        processData((char *) superBlock);
+        m_dataReceiver->popBlock();
+    }
+
+    m_dataReceiver->getRemoteAddress(m_remoteAddress);
+#else
     m_udpReadBytes = 0;
 
 	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
@@ -169,15 +280,17 @@ void RemoteInputUDPHandler::dataReadyRead()
 		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
 
 		if (m_udpReadBytes == RemoteUdpSize) {
-		    processData();
+		    processData(m_udpBuf);
 		    m_udpReadBytes = 0;
+		    m_nbDatagrams++;
 		}
 	}
+#endif
 }
 
-void RemoteInputUDPHandler::processData()
+void RemoteInputUDPHandler::processData(char *data)
 {
-    m_remoteInputBuffer.writeData(m_udpBuf);
+    m_remoteInputBuffer.writeData(data);
     const RemoteMetaDataFEC& metaData =  m_remoteInputBuffer.getCurrentMeta();
     bool change = false;
 
@@ -203,38 +316,69 @@ void RemoteInputUDPHandler::processData()
         m_samplerate = metaData.m_sampleRate;
         change = true;
     }
+    else if (m_sampleBytes != metaData.m_sampleBytes) // sample size or codec change
+    {
+        disconnectTimer();
+        adjustNbDecoderSlots(metaData);
+        change = true;
+    }
+
+    m_sampleBytes = metaData.m_sampleBytes;
 
     if (change && (m_samplerate != 0))
     {
-        qDebug("RemoteInputUDPHandler::processData: m_samplerate: %u S/s m_centerFrequency: %lu Hz", m_samplerate, m_centerFrequency);
+        reportStreamChange();
+        connectTimer();
+    }
+}
 
-        DSPSignalNotification *notif = new DSPSignalNotification(m_samplerate, m_centerFrequency); // Frequency in Hz for the DSP engine
-        m_deviceAPI->getDeviceEngineInputMessageQueue()->push(notif);
+void RemoteInputUDPHandler::reportStreamChange()
+{
+    qDebug("RemoteInputUDPHandler::reportStreamChange: m_samplerate: %u S/s m_centerFrequency: %lu Hz", m_samplerate, m_centerFrequency);
 
-        if (m_messageQueueToGUI)
-        {
-            RemoteInput::MsgReportRemoteInputStreamData *report = RemoteInput::MsgReportRemoteInputStreamData::create(
-                m_samplerate,
-                m_centerFrequency, // Frequency in Hz for the GUI
-                m_tv_msec);
+    DSPSignalNotification *notif = new DSPSignalNotification(m_samplerate, m_centerFrequency); // Frequency in Hz for the DSP engine
+    m_deviceAPI->getDeviceEngineInputMessageQueue()->push(notif);
 
-            m_messageQueueToGUI->push(report);
-        }
+    if (m_messageQueueToGUI)
+    {
+        RemoteInput::MsgReportRemoteInputStreamData *report = RemoteInput::MsgReportRemoteInputStreamData::create(
+            m_samplerate,
+            m_centerFrequency, // Frequency in Hz for the GUI
+            getTVmSec());
 
-        connectTimer();
+        m_messageQueueToGUI->push(report);
     }
 }
 
 void RemoteInputUDPHandler::adjustNbDecoderSlots(const RemoteMetaDataFEC& metaData)
 {
     int sampleRate = metaData.m_sampleRate;
-    int sampleBytes = metaData.m_sampleBytes;
-    int bufferFrameSize = RemoteInputBuffer::getBufferFrameSize();
-    float fNbDecoderSlots = (float) (4 * sampleBytes * sampleRate) / (float) bufferFrameSize;
+    int sampleBytes = metaData.getSampleBytes();
+    int bufferFrameSize = RemoteInputBuffer::getBufferFrameSize(metaData);
+    float bufferSec = std::max(2.0f, (3.0f * m_remoteInputBuffer.getTargetLatency()) / 1000.0f); // room for the latency target and its resyncs
+    float fNbDecoderSlots = (float) (2 * sampleBytes * sampleRate * bufferSec) / (float) bufferFrameSize;
     int rawNbDecoderSlots = ((((int) ceil(fNbDecoderSlots)) / 2) * 2) + 2; // next multiple of 2
     qDebug("RemoteInputUDPHandler::adjustNbDecoderSlots: rawNbDecoderSlots: %d", rawNbDecoderSlots);
     m_remoteInputBuffer.setNbDecoderSlots(rawNbDecoderSlots < 4 ? 4 : rawNbDecoderSlots);
     m_remoteInputBuffer.setBufferLenSec(metaData);
+    m_resampler.reset();
+    m_readLengthRemainder = 0.0;
+}
+
+void RemoteInputUDPHandler::setTargetLatency(unsigned int targetLatencyMs)
+{
+    if (targetLatencyMs == m_remoteInputBuffer.getTargetLatency()) {
+        return;
+    }
+
+    bool resize = std::max(2000u, 3*targetLatencyMs) != std::max(2000u, 3*m_remoteInputBuffer.getTargetLatency());
+    m_remoteInputBuffer.setTargetLatency(targetLatencyMs);
+    m_resampler.reset();
+    m_readLengthRemainder = 0.0;
+
+    if (resize && (m_samplerate != 0)) { // frames in the buffer are lost
+        adjustNbDecoderSlots(m_remoteInputBuffer.getCurrentMeta());
+    }
 }
 
 void RemoteInputUDPHandler::connectTimer()
@@ -269,27 +413,58 @@ void RemoteInputUDPHandler::disconnectTimer()
 
 void RemoteInputUDPHandler::tick()
 {
-    // auto throttling
-    int throttlems = m_elapsedTimer.restart();
+    const RemoteMetaDataFEC& metaData =  m_remoteInputBuffer.getCurrentMeta();
+    uint8_t *buf;
 
-    if (throttlems != m_throttlems)
+    if (m_remoteInputBuffer.getTargetLatency() != 0) // latency targeting: nominal rate output resampled from the buffer read rate
     {
-        m_throttlems = throttlems;
-        m_readLengthSamples = (m_remoteInputBuffer.getCurrentMeta().m_sampleRate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000;
-        m_throttleToggle = !m_throttleToggle;
-    }
+        double nbSamples = metaData.m_sampleRate * (m_elapsedTimer.nsecsElapsed() * 1e-9) + m_readLengthRemainder;
+        m_elapsedTimer.restart();
+        m_readLengthSamples = (int32_t) nbSamples;
+        m_readLengthRemainder = nbSamples - m_readLengthSamples;
 
-    if (m_autoCorrBuffer)
-    {
-        m_readLengthSamples += m_remoteInputBuffer.getRWBalanceCorrection();
-        // Eliminate negative or excessively high values
-        m_readLengthSamples = m_readLengthSamples < 0 ?
-            0 : m_readLengthSamples > (int) m_remoteInputBuffer.getCurrentMeta().m_sampleRate/5 ?
-                m_remoteInputBuffer.getCurrentMeta().m_sampleRate/5 : m_readLengthSamples;
+        if (m_readLengthSamples > (int) metaData.m_sampleRate/5) // Eliminate excessively high values (stalls)
+        {
+            m_readLengthSamples = metaData.m_sampleRate/5;
+            m_readLengthRemainder = 0.0;
+        }
+
+        int sampleSize = metaData.getSampleBytes() * 2;
+        m_readLength = m_readLengthSamples * sampleSize;
+
+        if (m_readLength > m_resamplerBuffer.size()) {
+            m_resamplerBuffer.resize(m_readLength);
+        }
+
+        m_resampler.setRatio(m_remoteInputBuffer.getRateRatio());
+        const uint8_t *inBuf = m_remoteInputBuffer.readData(m_resampler.getNbInputSamples(m_readLengthSamples) * sampleSize);
+        m_resampler.resample(inBuf, m_readLengthSamples, metaData.getSampleBytes(), m_resamplerBuffer.data());
+        buf = m_resamplerBuffer.data();
     }
+    else
+    {
+        // auto throttling
+        int throttlems = m_elapsedTimer.restart();
 
-    const RemoteMetaDataFEC& metaData =  m_remoteInputBuffer.getCurrentMeta();
-    m_readLength = m_readLengthSamples * (metaData.m_sampleBytes & 0xF) * 2;
+        if (throttlems != m_throttlems)
+        {
+            m_throttlems = throttlems;
+            m_readLengthSamples = (metaData.m_sampleRate * (m_throttlems+(m_throttleToggle ? 1 : 0))) / 1000;
+            m_throttleToggle = !m_throttleToggle;
+        }
+
+        if (m_autoCorrBuffer)
+        {
+            m_readLengthSamples += m_remoteInputBuffer.getRWBalanceCorrection();
+            // Eliminate negative or excessively high values
+            m_readLengthSamples = m_readLengthSamples < 0 ?
+                0 : m_readLengthSamples > (int) metaData.m_sampleRate/5 ?
+                    metaData.m_sampleRate/5 : m_readLengthSamples;
+        }
+
+        m_readLength = m_readLengthSamples * metaData.getSampleBytes() * 2;
+        buf = m_remoteInputBuffer.readData(m_readLength);
+    }
 
     if ((metaData.m_sampleBits == 16) && (SDR_RX_SAMP_SZ == 24)) // 16 -> 24 bits
     {
@@ -299,8 +474,6 @@ void RemoteInputUDPHandler::tick()
             m_converterBuffer = new int32_t[m_readLengthSamples*2];
         }
 
-        uint8_t *buf = m_remoteInputBuffer.readData(m_readLength);
-
         for (int is = 0; is < m_readLengthSamples; is++)
         {
             m_converterBuffer[2*is] = ((int16_t*)buf)[2*is]; // I
@@ -319,8 +492,6 @@ void RemoteInputUDPHandler::tick()
             m_converterBuffer = new int32_t[m_readLengthSamples];
         }
 
-        uint8_t *buf = m_remoteInputBuffer.readData(m_readLength);
-
         for (int is = 0; is < m_readLengthSamples; is++)
         {
             m_converterBuffer[is] =  ((int32_t *)buf)[2*is+1]>>8; // Q -> MSB
@@ -333,7 +504,7 @@ void RemoteInputUDPHandler::tick()
     else if ((metaData.m_sampleBits == 16) || (metaData.m_sampleBits == 24)) // same sample size and valid size
     {
         // read samples directly feeding the SampleFifo (no callback)
-        m_sampleFifo->write(reinterpret_cast<quint8*>(m_remoteInputBuffer.readData(m_readLength)), m_readLength);
+        m_sampleFifo->write(reinterpret_cast<quint8*>(buf), m_readLength);
         m_samplesCount += m_readLengthSamples;
     }
     else // invalid size
@@ -357,7 +528,7 @@ void RemoteInputUDPHandler::tick()
 	        int nbOriginalBlocks = m_remoteInputBuffer.getCurrentMeta().m_nbOriginalBlocks;
 	        int nbFECblocks = m_remoteInputBuffer.getCurrentMeta().m_nbFECBlocks;
 	        int sampleBits = m_remoteInputBuffer.getCurrentMeta().m_sampleBits;
-	        int sampleBytes = m_remoteInputBuffer.getCurrentMeta().m_sampleBytes;
+	        int sampleBytes = m_remoteInputBuffer.getCurrentMeta().getSampleBytes();
 
 	        //framesDecodingStatus = (minNbOriginalBlocks == nbOriginalBlocks ? 2 : (minNbOriginalBlocks < nbOriginalBlocks - nbFECblocks ? 0 : 1));
 	        if (minNbBlocks < nbOriginalBlocks) {
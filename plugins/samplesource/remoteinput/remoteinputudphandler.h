@@ -24,7 +24,12 @@
 #include <QMutex>
 #include <QElapsedTimer>
 
+#include <vector>
+
 #include "remoteinputbuffer.h"
+#include "remoteinputresampler.h"
+#include "remoteinputudpreceiver.h"
+#include "remoteinputshmreader.h"
 
 #define REMOTEINPUT_THROTTLE_MS 50
 
@@ -64,17 +69,29 @@ public:
     void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
+    void configureSharedMemory(bool sharedMemory, const QString& name); //!< Read from a shared memory ring instead of UDP (Linux only)
+    void setFECPipelineDepth(unsigned int depth) { m_remoteInputBuffer.setFECPipelineDepth(depth); }
+    void setTargetLatency(unsigned int targetLatencyMs); //!< 0 to disable latency targeting
 	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
     int getNbOriginalBlocks() const { return RemoteNbOrginalBlocks; }
-    bool isStreaming() const { return m_masterTimerConnected; }
+    bool isStreaming() const { return m_sharedMemory ? m_samplerate != 0 : m_masterTimerConnected; }
     int getSampleRate() const { return m_samplerate; }
     int getCenterFrequency() const { return m_centerFrequency; }
     int getBufferGauge() const { return m_remoteInputBuffer.getBufferGauge(); }
-    uint64_t getTVmSec() const { return m_tv_msec; }
+    uint64_t getTVmSec() const { return m_sharedMemory ? m_shmReader.getWriteTimeUs() / 1000 : m_tv_msec; }
     int getMinNbBlocks() { return m_remoteInputBuffer.getMinNbBlocks(); }
     int getMaxNbRecovery() { return m_remoteInputBuffer.getMaxNbRecovery(); }
+    quint64 getNbDatagrams() const { return m_dataReceiver ? m_dataReceiver->getNbDatagrams() : m_nbDatagrams; }
+    quint64 getKernelDrops() const { return m_dataReceiver ? m_dataReceiver->getKernelDrops() : 0; }
+    quint64 getQueueDrops() const { return m_dataReceiver ? m_dataReceiver->getQueueDrops() : 0; }
+    float getLatencyMs() const { return m_remoteInputBuffer.getLatencyMs(); }
+    float getTargetLatencyMs() const { return m_remoteInputBuffer.getEffectiveTargetLatencyMs(); }
+    float getJitterMs() const { return m_remoteInputBuffer.getJitterMs(); }
+    float getRateCorrectionPPM() const { return m_remoteInputBuffer.getRateCorrectionPPM(); }
+    quint64 getShmLostSamples() const { return m_shmReader.getLostSamples(); }
 public slots:
 	void dataReadyRead();
+    void shmMetaChanged();
 
 private:
 	DeviceAPI *m_deviceAPI;
@@ -84,14 +101,17 @@ private:
     uint32_t m_rateDivider;
 	RemoteInputBuffer m_remoteInputBuffer;
 	QUdpSocket *m_dataSocket;
+    RemoteInputUDPReceiver *m_dataReceiver; //!< receive thread (Linux only)
 	QHostAddress m_dataAddress;
 	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
 	char *m_udpBuf;
 	qint64 m_udpReadBytes;
+    quint64 m_nbDatagrams;
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
+	uint8_t m_sampleBytes;  //!< sample bytes and codec of the stream as in the meta data
 	uint64_t m_centerFrequency;
 	uint64_t m_tv_msec;
     MessageQueue *m_messageQueueToInput;
@@ -108,11 +128,18 @@ private:
     uint32_t m_converterBufferNbSamples;
     bool m_throttleToggle;
     bool m_autoCorrBuffer;
+    RemoteInputResampler m_resampler;      //!< Read rate correction when targeting latency
+    std::vector<uint8_t> m_resamplerBuffer;
+    double m_readLengthRemainder;          //!< Fractional part of the number of samples to output at the nominal rate
+    bool m_sharedMemory;
+    QString m_shmName;
+    RemoteInputShmReader m_shmReader;      //!< Shared memory transport reader thread
 
 	void connectTimer();
     void disconnectTimer();
-	void processData();
+	void processData(char *data);
     void adjustNbDecoderSlots(const RemoteMetaDataFEC& metaData);
+    void reportStreamChange();
 
 private slots:
 	void tick();
@@ -0,0 +1,293 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#ifndef SO_RXQ_OVFL
+#define SO_RXQ_OVFL 40 // Linux 2.6.33+
+#endif
+#endif
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "remoteinputudpreceiver.h"
+
+RemoteInputUDPReceiver::RemoteInputUDPReceiver(unsigned int nbSlots) :
+    m_fd(-1),
+    m_nbSlots(nbSlots),
+    m_written(0),
+    m_read(0),
+    m_notified(false),
+    m_stopRequested(false),
+    m_nbDatagrams(0),
+    m_kernelDrops(0),
+    m_queueDrops(0)
+{
+    m_slab = new RemoteSuperBlock[m_nbSlots];
+    m_scratch = new RemoteSuperBlock[m_batchSize];
+}
+
+RemoteInputUDPReceiver::~RemoteInputUDPReceiver()
+{
+    stopReceiver();
+    delete[] m_scratch;
+    delete[] m_slab;
+}
+
+bool RemoteInputUDPReceiver::startReceiver(const QHostAddress& address, quint16 port)
+{
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        return true;
+    }
+
+    struct sockaddr_storage name;
+    socklen_t nameLen;
+    memset(&name, 0, sizeof(name));
+
+    if (address.protocol() == QAbstractSocket::IPv6Protocol)
+    {
+        struct sockaddr_in6 *name6 = reinterpret_cast<struct sockaddr_in6*>(&name);
+        Q_IPV6ADDR ipv6Address = address.toIPv6Address();
+        name6->sin6_family = AF_INET6;
+        name6->sin6_port = htons(port);
+        memcpy(name6->sin6_addr.s6_addr, &ipv6Address, 16);
+        nameLen = sizeof(struct sockaddr_in6);
+    }
+    else
+    {
+        struct sockaddr_in *name4 = reinterpret_cast<struct sockaddr_in*>(&name);
+        name4->sin_family = AF_INET;
+        name4->sin_port = htons(port);
+        name4->sin_addr.s_addr = htonl(address.toIPv4Address());
+        nameLen = sizeof(struct sockaddr_in);
+    }
+
+    int fd = ::socket(name.ss_family, SOCK_DGRAM, 0);
+
+    if (fd < 0)
+    {
+        qWarning("RemoteInputUDPReceiver::startReceiver: cannot create socket: %s", strerror(errno));
+        return false;
+    }
+
+    int enable = 1;
+    int bufferSize = m_socketBufferSize;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize)); // capped by net.core.rmem_max
+
+    if (setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) < 0) {
+        qWarning("RemoteInputUDPReceiver::startReceiver: kernel drops not available: %s", strerror(errno));
+    }
+
+    if (::bind(fd, reinterpret_cast<struct sockaddr*>(&name), nameLen) < 0)
+    {
+        qWarning("RemoteInputUDPReceiver::startReceiver: cannot bind %s:%d: %s",
+            address.toString().toStdString().c_str(), port, strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_written = 0;
+    m_read = 0;
+    m_notified = false;
+    m_stopRequested = false;
+    m_nbDatagrams = 0;
+    m_kernelDrops = 0;
+    m_queueDrops = 0;
+    start();
+    qDebug("RemoteInputUDPReceiver::startReceiver: bound to %s:%d", address.toString().toStdString().c_str(), port);
+    return true;
+#else
+    (void) address;
+    (void) port;
+    return false;
+#endif
+}
+
+void RemoteInputUDPReceiver::stopReceiver()
+{
+#if defined(__linux__)
+    if (m_fd < 0) {
+        return;
+    }
+
+    m_stopRequested = true;
+    wait();
+    ::close(m_fd);
+    m_fd = -1;
+    qDebug("RemoteInputUDPReceiver::stopReceiver: %llu datagrams %llu kernel drops %llu queue drops",
+        m_nbDatagrams.load(), m_kernelDrops.load(), m_queueDrops.load());
+#endif
+}
+
+RemoteSuperBlock *RemoteInputUDPReceiver::frontBlock()
+{
+    quint64 read = m_read.load(std::memory_order_relaxed);
+
+    if (read == m_written.load()) {
+        return nullptr;
+    }
+
+    return &m_slab[read % m_nbSlots];
+}
+
+void RemoteInputUDPReceiver::popBlock()
+{
+    m_read.store(m_read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void RemoteInputUDPReceiver::getRemoteAddress(QHostAddress& address)
+{
+    QMutexLocker mutexLocker(&m_remoteAddressMutex);
+    address = m_remoteAddress;
+}
+
+void RemoteInputUDPReceiver::run()
+{
+#if defined(__linux__)
+    const std::size_t controlSize = CMSG_SPACE(sizeof(uint32_t));
+    std::vector<struct mmsghdr> messages(m_batchSize);
+    std::vector<struct iovec> iovecs(m_batchSize);
+    std::vector<struct sockaddr_storage> names(m_batchSize);
+    std::vector<char> controls(m_batchSize * controlSize);
+    struct sockaddr_storage lastName;
+    uint32_t lastOverflow = 0;
+    memset(&lastName, 0, sizeof(lastName));
+
+    struct pollfd pfd;
+    pfd.fd = m_fd;
+    pfd.events = POLLIN;
+
+    while (!m_stopRequested.load())
+    {
+        int ret = poll(&pfd, 1, m_pollTimeoutMs);
+
+        if (ret == 0) {
+            continue;
+        }
+
+        if (ret < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            qWarning("RemoteInputUDPReceiver::run: poll: %s", strerror(errno));
+            break;
+        }
+
+        // receive in the free contiguous slots of the ring or discard in the scratch blocks if it is full
+        quint64 written = m_written.load(std::memory_order_relaxed);
+        quint64 used = written - m_read.load(std::memory_order_acquire);
+        unsigned int slot = written % m_nbSlots;
+        unsigned int nbFree = std::min(m_nbSlots - (unsigned int) used, m_nbSlots - slot);
+        RemoteSuperBlock *blocks = nbFree == 0 ? m_scratch : &m_slab[slot];
+        unsigned int batchSize = (nbFree == 0) || (nbFree > m_batchSize) ? m_batchSize : nbFree;
+
+        for (unsigned int i = 0; i < batchSize; i++)
+        {
+            iovecs[i].iov_base = &blocks[i];
+            iovecs[i].iov_len = sizeof(RemoteSuperBlock);
+            messages[i].msg_hdr.msg_name = &names[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_control = &controls[i * controlSize];
+            messages[i].msg_hdr.msg_controllen = controlSize;
+            messages[i].msg_hdr.msg_flags = 0;
+            messages[i].msg_len = 0;
+        }
+
+        int nbMessages = recvmmsg(m_fd, messages.data(), batchSize, MSG_DONTWAIT, nullptr);
+
+        if (nbMessages < 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+                qWarning("RemoteInputUDPReceiver::run: recvmmsg: %s", strerror(errno));
+            }
+
+            continue;
+        }
+
+        unsigned int nbBlocks = 0;
+
+        for (int i = 0; i < nbMessages; i++)
+        {
+            struct msghdr *hdr = &messages[i].msg_hdr;
+
+            for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg; cmsg = CMSG_NXTHDR(hdr, cmsg))
+            {
+                if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_RXQ_OVFL))
+                {
+                    uint32_t overflow;
+                    memcpy(&overflow, CMSG_DATA(cmsg), sizeof(overflow));
+                    m_kernelDrops += overflow - lastOverflow; // counter of the socket may wrap
+                    lastOverflow = overflow;
+                }
+            }
+
+            // blocks are kept contiguous if a datagram of unexpected size is skipped
+            if ((messages[i].msg_len != sizeof(RemoteSuperBlock)) || (hdr->msg_flags & MSG_TRUNC)) {
+                continue;
+            }
+
+            if ((int) nbBlocks != i) {
+                memcpy(&blocks[nbBlocks], &blocks[i], sizeof(RemoteSuperBlock));
+            }
+
+            nbBlocks++;
+        }
+
+        if (nbBlocks == 0) {
+            continue;
+        }
+
+        m_nbDatagrams += nbBlocks;
+        const struct sockaddr_storage& name = names[nbMessages - 1];
+
+        if (memcmp(&name, &lastName, sizeof(name)) != 0)
+        {
+            lastName = name;
+            QMutexLocker mutexLocker(&m_remoteAddressMutex);
+            m_remoteAddress.setAddress(reinterpret_cast<const struct sockaddr*>(&name));
+        }
+
+        if (nbFree == 0)
+        {
+            m_queueDrops += nbBlocks;
+            continue;
+        }
+
+        m_written.store(written + nbBlocks);
+
+        if (!m_notified.exchange(true)) {
+            emit dataReady();
+        }
+    }
+#endif
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Remote input datagrams receive thread                                         //
+//                                                                               //
+// A dedicated thread reads datagrams in batches with recvmmsg directly into a   //
+// preallocated ring of super blocks. The ring is a single producer single       //
+// consumer queue so that the decoder running in the handler thread picks the    //
+// blocks without locking. Kernel drops are obtained with SO_RXQ_OVFL.           //
+// Linux only: startReceiver returns false on other systems.                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPRECEIVER_H_
+#define PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPRECEIVER_H_
+
+#include <atomic>
+
+#include <QThread>
+#include <QMutex>
+#include <QHostAddress>
+
+#include "channel/remotedatablock.h"
+
+class RemoteInputUDPReceiver : public QThread
+{
+    Q_OBJECT
+public:
+    RemoteInputUDPReceiver(unsigned int nbSlots = 8192);
+    virtual ~RemoteInputUDPReceiver();
+
+    bool startReceiver(const QHostAddress& address, quint16 port); //!< Bind the socket and start the thread. Returns false if not possible
+    void stopReceiver();
+    bool isReceiving() const { return m_fd >= 0; }
+
+    /** Oldest block in the queue or nullptr if empty. Consumer side */
+    RemoteSuperBlock *frontBlock();
+    /** Release the block returned by frontBlock. Consumer side */
+    void popBlock();
+    /** Must be called before draining the queue for the dataReady signal to be emitted again */
+    void acknowledge() { m_notified.store(false); }
+
+    void getRemoteAddress(QHostAddress& address);       //!< sender of the last datagrams
+    quint64 getNbDatagrams() const { return m_nbDatagrams.load(); }
+    quint64 getKernelDrops() const { return m_kernelDrops.load(); }
+    quint64 getQueueDrops() const { return m_queueDrops.load(); }
+
+signals:
+    void dataReady(); //!< Emitted when blocks are queued after an acknowledge
+
+private:
+    int m_fd;
+    RemoteSuperBlock *m_slab;           //!< ring of received blocks
+    RemoteSuperBlock *m_scratch;        //!< receives the batches that do not fit in the ring
+    unsigned int m_nbSlots;
+    std::atomic<quint64> m_written;     //!< number of blocks queued (receive thread)
+    std::atomic<quint64> m_read;        //!< number of blocks released (consumer)
+    std::atomic<bool> m_notified;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<quint64> m_nbDatagrams;
+    std::atomic<quint64> m_kernelDrops;
+    std::atomic<quint64> m_queueDrops;
+    QHostAddress m_remoteAddress;
+    QMutex m_remoteAddressMutex;
+
+    static const unsigned int m_batchSize = 64;     //!< maximum number of datagrams per system call
+    static const int m_pollTimeoutMs = 100;         //!< stop request polling period
+    static const int m_socketBufferSize = 8*1024*1024;
+
+    virtual void run();
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPRECEIVER_H_ */
@@ -90,6 +90,7 @@ AudioDeviceManager::AudioDeviceManager()
 
     m_defaultInputStarted = false;
     m_defaultOutputStarted = false;
+    m_fileOutput = false;
 }
 
 AudioDeviceManager::~AudioDeviceManager()
@@ -187,6 +188,8 @@ QByteArray AudioDeviceManager::serialize() const
     s.writeBlob(1, data);
     serializeOutputMap(data);
     s.writeBlob(2, data);
+    serializeOutputStreamMap(data);
+    s.writeBlob(3, data);
 
     return s.final();
 }
@@ -224,6 +227,8 @@ bool AudioDeviceManager::deserialize(const QByteArray& data)
         deserializeInputMap(data);
         d.readBlob(2, &data);
         deserializeOutputMap(data);
+        d.readBlob(3, &data);
+        deserializeOutputStreamMap(data);
 
         debugAudioInputInfos();
         debugAudioOutputInfos();
@@ -249,10 +254,51 @@ void AudioDeviceManager::deserializeOutputMap(QByteArray& data)
     readStream >> m_audioOutputInfos;
 }
 
+void AudioDeviceManager::serializeOutputStreamMap(QByteArray& data) const
+{
+    QMap<QString, QList<int> > streamMap; // multicast TTL, frames per datagram
+
+    for (QMap<QString, OutputDeviceInfo>::const_iterator it = m_audioOutputInfos.begin(); it != m_audioOutputInfos.end(); ++it) {
+        streamMap[it.key()] = QList<int>() << it.value().udpMulticastTTL << it.value().udpFramesPerDatagram;
+    }
+
+    QDataStream *stream = new QDataStream(&data, QIODevice::WriteOnly);
+    *stream << streamMap;
+    delete stream;
+}
+
+void AudioDeviceManager::deserializeOutputStreamMap(QByteArray& data)
+{
+    QMap<QString, QList<int> > streamMap;
+    QDataStream readStream(&data, QIODevice::ReadOnly);
+    readStream >> streamMap;
+
+    for (QMap<QString, QList<int> >::const_iterator it = streamMap.begin(); it != streamMap.end(); ++it)
+    {
+        if ((it.value().size() >= 2) && m_audioOutputInfos.contains(it.key()))
+        {
+            m_audioOutputInfos[it.key()].udpMulticastTTL = it.value().at(0);
+            m_audioOutputInfos[it.key()].udpFramesPerDatagram = it.value().at(1);
+        }
+    }
+}
+
 void AudioDeviceManager::addAudioSink(AudioFifo* audioFifo, MessageQueue *sampleSinkMessageQueue, int outputDeviceIndex)
 {
     qDebug("AudioDeviceManager::addAudioSink: %d: %p", outputDeviceIndex, audioFifo);
 
+    if (isFileOutput())
+    {
+        if (m_audioSinkFifos.find(audioFifo) == m_audioSinkFifos.end()) // new FIFO
+        {
+            m_wavWriter.addFifo(audioFifo, getOutputSampleRate(outputDeviceIndex));
+            m_audioFifoToSinkMessageQueues[audioFifo] = sampleSinkMessageQueue;
+        }
+
+        m_audioSinkFifos[audioFifo] = outputDeviceIndex;
+        return;
+    }
+
     if (m_audioOutputs.find(outputDeviceIndex) == m_audioOutputs.end()) {
         m_audioOutputs[outputDeviceIndex] = new AudioOutput();
     }
@@ -295,6 +341,14 @@ void AudioDeviceManager::removeAudioSink(AudioFifo* audioFifo)
         return;
     }
 
+    if (isFileOutput())
+    {
+        m_wavWriter.removeFifo(audioFifo);
+        m_audioSinkFifos.remove(audioFifo);
+        m_audioFifoToSinkMessageQueues.remove(audioFifo);
+        return;
+    }
+
     int audioOutputDeviceIndex = m_audioSinkFifos[audioFifo];
     m_audioOutputs[audioOutputDeviceIndex]->removeFifo(audioFifo);
 
@@ -307,6 +361,13 @@ void AudioDeviceManager::removeAudioSink(AudioFifo* audioFifo)
     m_audioFifoToSinkMessageQueues.remove(audioFifo);
 }
 
+void AudioDeviceManager::setFileOutput(const QString& directory)
+{
+    qDebug("AudioDeviceManager::setFileOutput: %s", qPrintable(directory));
+    m_fileOutput = true;
+    m_wavWriter.open(directory);
+}
+
 void AudioDeviceManager::addAudioSource(AudioFifo* audioFifo, MessageQueue *sampleSourceMessageQueue, int inputDeviceIndex)
 {
     qDebug("AudioDeviceManager::addAudioSource: %d: %p", inputDeviceIndex, audioFifo);
@@ -641,6 +702,8 @@ void AudioDeviceManager::setOutputDeviceInfo(int outputDeviceIndex, const Output
     audioOutput->setUdpChannelMode(deviceInfo.udpChannelMode);
     audioOutput->setUdpChannelFormat(deviceInfo.udpChannelCodec, deviceInfo.udpChannelMode == AudioOutput::UDPChannelStereo, deviceInfo.sampleRate);
     audioOutput->setUdpDecimation(deviceInfo.udpDecimationFactor);
+    audioOutput->setUdpMulticastTTL(deviceInfo.udpMulticastTTL);
+    audioOutput->setUdpFramesPerDatagram(deviceInfo.udpFramesPerDatagram);
 
     qDebug("AudioDeviceManager::setOutputDeviceInfo: index: %d device: %s updated",
             outputDeviceIndex, qPrintable(deviceName));
@@ -810,6 +873,8 @@ void AudioDeviceManager::debugAudioOutputInfos() const
                 << " udpUseRTP: " << it.value().udpUseRTP
                 << " udpChannelMode: " << (int) it.value().udpChannelMode
                 << " udpChannelCodec: " << (int) it.value().udpChannelCodec
-                << " decimationFactor: " << it.value().udpDecimationFactor;
+                << " decimationFactor: " << it.value().udpDecimationFactor
+                << " multicastTTL: " << it.value().udpMulticastTTL
+                << " framesPerDatagram: " << it.value().udpFramesPerDatagram;
     }
 }
@@ -26,6 +26,7 @@
 
 #include "audio/audioinput.h"
 #include "audio/audiooutput.h"
+#include "audio/audiowavwriter.h"
 #include "export.h"
 
 class QDataStream;
@@ -62,7 +63,9 @@ public:
             udpUseRTP(false),
             udpChannelMode(AudioOutput::UDPChannelLeft),
             udpChannelCodec(AudioOutput::UDPCodecL16),
-            udpDecimationFactor(1)
+            udpDecimationFactor(1),
+            udpMulticastTTL(1),
+            udpFramesPerDatagram(1)
         {}
         void resetToDefaults() {
             sampleRate = m_defaultAudioSampleRate;
@@ -73,6 +76,8 @@ public:
             udpChannelMode = AudioOutput::UDPChannelLeft;
             udpChannelCodec = AudioOutput::UDPCodecL16;
             udpDecimationFactor = 1;
+            udpMulticastTTL = 1;
+            udpFramesPerDatagram = 1;
         }
         int sampleRate;
         QString udpAddress;
@@ -82,6 +87,8 @@ public:
         AudioOutput::UDPChannelMode udpChannelMode;
         AudioOutput::UDPChannelCodec udpChannelCodec;
         uint32_t udpDecimationFactor;
+        int udpMulticastTTL;      //!< Time to live of datagrams sent to a multicast address
+        int udpFramesPerDatagram; //!< Number of Opus frames per UDP datagram
         friend QDataStream& operator<<(QDataStream& ds, const OutputDeviceInfo& info);
         friend QDataStream& operator>>(QDataStream& ds, OutputDeviceInfo& info);
     };
@@ -113,6 +120,10 @@ public:
     void unsetOutputDeviceInfo(int outputDeviceIndex);
     void inputInfosCleanup();  //!< Remove input info from map for input devices not present
     void outputInfosCleanup(); //!< Remove output info from map for output devices not present
+    /** Audio sinks added from now on are written to WAV files in this directory with blocking FIFOs instead of audio devices (offline processing) */
+    void setFileOutput(const QString& directory);
+    bool isFileOutput() const { return m_fileOutput; }
+    AudioWavWriter& getWavWriter() { return m_wavWriter; }
 
     static const int m_defaultAudioSampleRate = 48000;
     static const float m_defaultAudioInputVolume;
@@ -138,6 +149,8 @@ private:
 
     bool m_defaultOutputStarted; //!< True if the default audio output (-1) has already been started
     bool m_defaultInputStarted;  //!< True if the default audio input (-1) has already been started
+    bool m_fileOutput;           //!< True if audio sinks go to WAV files
+    AudioWavWriter m_wavWriter;
 
     void resetToDefaults();
     QByteArray serialize() const;
@@ -154,6 +167,8 @@ private:
 
     void serializeOutputMap(QByteArray& data) const;
     void deserializeOutputMap(QByteArray& data);
+    void serializeOutputStreamMap(QByteArray& data) const;   //!< network streaming fields added after the output map format was set
+    void deserializeOutputStreamMap(QByteArray& data);
     void debugAudioOutputInfos() const;
 
 	friend class MainSettings;
@@ -18,6 +18,7 @@
 
 #include <string.h>
 #include <QTime>
+#include <QSemaphore>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
 #include "audio/audionetsink.h"
@@ -25,6 +26,8 @@
 #define MIN(x, y) ((x) < (y) ? (x) : (y))
 
 AudioFifo::AudioFifo() :
+	m_blocking(false),
+	m_dataAvailable(nullptr),
 	m_fifo(0),
 	m_sampleSize(sizeof(AudioSample))
 {
@@ -35,6 +38,8 @@ AudioFifo::AudioFifo() :
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
+	m_blocking(false),
+	m_dataAvailable(nullptr),
 	m_fifo(0),
     m_sampleSize(sizeof(AudioSample))
 {
@@ -56,6 +61,14 @@ AudioFifo::~AudioFifo()
 	m_size = 0;
 }
 
+void AudioFifo::setBlocking(bool blocking, QSemaphore *dataAvailable)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	m_blocking = blocking;
+	m_dataAvailable = blocking ? dataAvailable : nullptr;
+	m_roomAvailable.wakeAll(); // a blocked writer goes on in the new mode
+}
+
 bool AudioFifo::setSize(uint32_t numSamples)
 {
 	QMutexLocker mutexLocker(&m_mutex);
@@ -73,6 +86,10 @@ uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 		return 0;
 	}
 
+	if (m_blocking) {
+		return writeBlocking(data, numSamples);
+	}
+
 	m_mutex.lock();
 
 	total = MIN(numSamples, m_size - m_fill);
@@ -100,6 +117,48 @@ uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 	return total;
 }
 
+uint32_t AudioFifo::writeBlocking(const quint8* data, uint32_t numSamples)
+{
+	uint32_t remaining = numSamples;
+	uint32_t copyLen;
+	QMutexLocker mutexLocker(&m_mutex);
+
+	while (remaining != 0)
+	{
+		if (isFull())
+		{
+			if (!m_blocking) {
+				break; // no longer blocking: the reader may be gone
+			}
+
+			if (m_dataAvailable) {
+				m_dataAvailable->release(); // make sure the reader is awake
+			}
+
+			if (!m_roomAvailable.wait(&m_mutex, m_blockingTimeoutMs)) {
+				break; // reader is gone
+			}
+
+			continue;
+		}
+
+		copyLen = MIN(remaining, m_size - m_fill);
+		copyLen = MIN(copyLen, m_size - m_tail);
+		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
+		m_tail += copyLen;
+		m_tail %= m_size;
+		m_fill += copyLen;
+		data += copyLen * m_sampleSize;
+		remaining -= copyLen;
+	}
+
+	if (m_dataAvailable && (remaining != numSamples)) {
+		m_dataAvailable->release();
+	}
+
+	return numSamples - remaining;
+}
+
 uint AudioFifo::read(quint8* data, uint32_t numSamples)
 {
 	uint32_t total;
@@ -134,6 +193,10 @@ uint AudioFifo::read(quint8* data, uint32_t numSamples)
 		remaining -= copyLen;
 	}
 
+	if (m_blocking) {
+		m_roomAvailable.wakeAll();
+	}
+
 	m_mutex.unlock();
 	return total;
 }
@@ -150,6 +213,10 @@ uint AudioFifo::drain(uint32_t numSamples)
 	m_head = (m_head + numSamples) % m_size;
 	m_fill -= numSamples;
 
+	if (m_blocking) {
+		m_roomAvailable.wakeAll();
+	}
+
 	return numSamples;
 }
 
@@ -160,6 +227,10 @@ void AudioFifo::clear()
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+
+	if (m_blocking) {
+		m_roomAvailable.wakeAll(); // room for a blocked writer
+	}
 }
 
 bool AudioFifo::create(uint32_t numSamples)
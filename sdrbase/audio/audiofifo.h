@@ -19,6 +19,8 @@
 #ifndef INCLUDE_AUDIOFIFO_H
 #define INCLUDE_AUDIOFIFO_H
 
+#include <atomic>
+
 #include <QObject>
 #include <QMutex>
 #include <QWaitCondition>
@@ -26,6 +28,8 @@
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+class QSemaphore;
+
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -46,9 +50,19 @@ public:
 	inline bool isEmpty() const { return m_fill == 0; }
 	inline bool isFull() const { return m_fill == m_size; }
 	inline uint32_t size() const { return m_size; }
+	/**
+	 * Blocking writes wait for room in the FIFO instead of dropping samples (offline processing).
+	 * The reader is woken up by a release of dataAvailable after each write and before waiting for room.
+	 */
+	void setBlocking(bool blocking, QSemaphore *dataAvailable = nullptr);
+	bool isBlocking() const { return m_blocking.load(); }
 
 private:
 	QMutex m_mutex;
+	QWaitCondition m_roomAvailable;
+	std::atomic<bool> m_blocking;
+	QSemaphore *m_dataAvailable; //!< m_mutex held
+	static const unsigned long m_blockingTimeoutMs = 1000; //!< samples are dropped if the reader does not make room in this time
 
 	qint8* m_fifo;
 
@@ -60,6 +74,7 @@ private:
 	uint32_t m_tail;
 
 	bool create(uint32_t numSamples);
+	uint32_t writeBlocking(const quint8* data, uint32_t numSamples);
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
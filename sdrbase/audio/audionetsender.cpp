@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QUdpSocket>
+#include <QMutexLocker>
+
+#include "util/udpbatchsender.h"
+#include "audionetsender.h"
+
+AudioNetSender::AudioNetSender(bool rtp, int sampleRate, bool stereo) :
+    m_rtpSink(nullptr),
+    m_droppedItems(0),
+    m_sendScheduled(false)
+{
+    m_socket = new QUdpSocket(this); // moves with this object
+
+    if (rtp) {
+        m_rtpSink = new RTPSink(m_socket, sampleRate, stereo);
+    }
+}
+
+AudioNetSender::~AudioNetSender()
+{
+    delete m_rtpSink; // before the socket that it uses
+}
+
+void AudioNetSender::setRTPPayloadInformation(RTPSink::PayloadType payloadType, int sampleRate)
+{
+    if (!m_rtpSink) {
+        return;
+    }
+
+    QMutexLocker rtpLocker(&m_rtpMutex);
+    QMutexLocker queueLocker(&m_queueMutex);
+
+    // payloads of the previous format would be read with the new sample size
+    m_queue.erase(
+        std::remove_if(m_queue.begin(), m_queue.end(), [](const Item& item) { return item.m_nbSamples != 0; }),
+        m_queue.end()
+    );
+    m_rtpSink->setPayloadInformation(payloadType, sampleRate);
+}
+
+void AudioNetSender::setRTPDestination(const QString& address, uint16_t port)
+{
+    if (m_rtpSink)
+    {
+        QMutexLocker rtpLocker(&m_rtpMutex);
+        m_rtpSink->setDestination(address, port);
+    }
+}
+
+void AudioNetSender::addRTPDestination(const QString& address, uint16_t port)
+{
+    if (m_rtpSink)
+    {
+        QMutexLocker rtpLocker(&m_rtpMutex);
+        m_rtpSink->addDestination(address, port);
+    }
+}
+
+void AudioNetSender::deleteRTPDestination(const QString& address, uint16_t port)
+{
+    if (m_rtpSink)
+    {
+        QMutexLocker rtpLocker(&m_rtpMutex);
+        m_rtpSink->deleteDestination(address, port);
+    }
+}
+
+void AudioNetSender::setMulticastTTL(int ttl)
+{
+    QMetaObject::invokeMethod(this, "applyMulticastTTL", Qt::QueuedConnection, Q_ARG(int, ttl));
+}
+
+void AudioNetSender::applyMulticastTTL(int ttl)
+{
+    UDPBatchSender::setMulticastTTL(m_socket, ttl);
+}
+
+void AudioNetSender::queueDatagram(const char *data, int size, const QHostAddress& address, quint16 port)
+{
+    queue(Item{QByteArray(data, size), 0, address, port});
+}
+
+void AudioNetSender::queueRTP(const uint8_t *data, int size, int nbSamples)
+{
+    queue(Item{QByteArray((const char *) data, size), nbSamples, QHostAddress(), 0});
+}
+
+void AudioNetSender::queue(Item&& item)
+{
+    m_queueMutex.lock();
+
+    if (m_queue.size() < (unsigned int) m_maxQueued) {
+        m_queue.push_back(std::move(item));
+    } else {
+        m_droppedItems++;
+    }
+
+    m_queueMutex.unlock();
+
+    if (!m_sendScheduled.exchange(true)) {
+        QMetaObject::invokeMethod(this, "send", Qt::QueuedConnection);
+    }
+}
+
+void AudioNetSender::send()
+{
+    std::vector<Item> items;
+    m_sendScheduled.store(false); // items queued from now on schedule another call
+    QMutexLocker rtpLocker(&m_rtpMutex);
+    m_queueMutex.lock();
+    items.swap(m_queue);
+    quint64 droppedItems = m_droppedItems;
+    m_droppedItems = 0;
+    m_queueMutex.unlock();
+
+    if (droppedItems != 0) {
+        qDebug("AudioNetSender::send: %llu datagrams or RTP payloads dropped", droppedItems);
+    }
+
+    for (const auto& item : items)
+    {
+        if (item.m_nbSamples == 0) {
+            m_socket->writeDatagram(item.m_data, item.m_address, item.m_port);
+        } else if (m_rtpSink) {
+            m_rtpSink->write((const uint8_t *) item.m_data.constData(), item.m_nbSamples);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIONETSENDER_H_
+#define SDRBASE_AUDIO_AUDIONETSENDER_H_
+
+#include <atomic>
+#include <vector>
+
+#include <QObject>
+#include <QMutex>
+#include <QByteArray>
+#include <QHostAddress>
+
+#include "util/rtpsink.h"
+#include "export.h"
+
+class QUdpSocket;
+
+/**
+ * Qt socket and RTP transmissions of an AudioNetSink. The object lives in a thread of its own
+ * that owns the socket so that the socket and the RTP sink are never used from the encoding
+ * pool threads. The encoding tasks queue the datagrams and RTP payloads that are sent in order
+ * from this thread.
+ */
+class SDRBASE_API AudioNetSender : public QObject
+{
+    Q_OBJECT
+public:
+    AudioNetSender(bool rtp, int sampleRate, bool stereo); //!< rtp: with an RTP sink
+    ~AudioNetSender();
+
+    // may be called from any thread
+
+    bool isRTPCapable() const { return m_rtpSink && m_rtpSink->isValid(); }
+    void setRTPPayloadInformation(RTPSink::PayloadType payloadType, int sampleRate); //!< RTP payloads not sent yet are dropped
+    void setRTPDestination(const QString& address, uint16_t port);
+    void addRTPDestination(const QString& address, uint16_t port);
+    void deleteRTPDestination(const QString& address, uint16_t port);
+    void setMulticastTTL(int ttl);
+    void queueDatagram(const char *data, int size, const QHostAddress& address, quint16 port);
+    void queueRTP(const uint8_t *data, int size, int nbSamples); //!< size in bytes
+
+    static const int m_maxQueued = 256; //!< Datagrams or RTP payloads waiting to be sent
+
+private slots:
+    void send();
+    void applyMulticastTTL(int ttl);
+
+private:
+    struct Item
+    {
+        QByteArray m_data;
+        int m_nbSamples;        //!< RTP payload samples. 0 for a datagram
+        QHostAddress m_address; //!< Datagram destination
+        quint16 m_port;
+    };
+
+    QUdpSocket *m_socket;
+    RTPSink *m_rtpSink;
+    QMutex m_queueMutex;
+    std::vector<Item> m_queue;
+    quint64 m_droppedItems;              //!< Under m_queueMutex
+    std::atomic<bool> m_sendScheduled;
+    QMutex m_rtpMutex;                   //!< RTP writes against payload changes
+
+    void queue(Item&& item);
+};
+
+#endif // SDRBASE_AUDIO_AUDIONETSENDER_H_
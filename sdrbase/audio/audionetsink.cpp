@@ -19,68 +19,131 @@
 #include <algorithm>
 
 #include "audionetsink.h"
-#include "util/rtpsink.h"
+#include "audionetsender.h"
 
 #include <QDebug>
-#include <QUdpSocket>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutexLocker>
 
 const int AudioNetSink::m_udpBlockSize = 512;
 
-AudioNetSink::AudioNetSink(QObject *parent) :
+class AudioNetSink::EncodeTask : public QRunnable
+{
+public:
+    EncodeTask(AudioNetSink *sink) :
+        m_sink(sink)
+    {}
+
+    virtual void run()
+    {
+        m_sink->encode();
+        m_sink->m_encodeScheduled.store(false);
+
+        // samples written while the flag was set did not schedule a task
+        if (m_sink->m_writeCount.load() - m_sink->m_readCount.load() >= (uint64_t) m_sink->m_blockSize.load()) {
+            m_sink->scheduleEncoding();
+        }
+
+        QMutexLocker mutexLocker(&m_sink->m_tasksMutex); // last access to the sink
+        m_sink->m_nbTasks--;
+        m_sink->m_tasksDone.wakeAll();
+    }
+
+private:
+    AudioNetSink *m_sink;
+};
+
+AudioNetSink::AudioNetSink() :
     m_type(SinkUDP),
     m_codec(CodecL16),
-    m_rtpBufferAudio(0),
+    m_batchSender("AudioNetSink"),
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
     m_decimationCount(0),
     m_codecInputSize(960),
-    m_codecInputIndex(0),
-    m_bufferIndex(0),
-    m_port(9998)
+    m_framesPerDatagram(1),
+    m_writeCount(0),
+    m_readCount(0),
+    m_blockSize(m_udpBlockSize/2),
+    m_encodeScheduled(false),
+    m_nbTasks(0),
+    m_closing(false),
+    m_droppedSamples(0),
+    m_nbDatagrams(0)
 {
-    std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
+    init(false, 48000, false);
 }
 
-AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
+AudioNetSink::AudioNetSink(int sampleRate, bool stereo) :
     m_type(SinkUDP),
     m_codec(CodecL16),
-    m_rtpBufferAudio(0),
+    m_batchSender("AudioNetSink"),
     m_sampleRate(48000),
     m_stereo(false),
     m_decimation(1),
     m_decimationCount(0),
     m_codecInputSize(960),
-    m_codecInputIndex(0),
-    m_bufferIndex(0),
-    m_port(9998)
+    m_framesPerDatagram(1),
+    m_writeCount(0),
+    m_readCount(0),
+    m_blockSize(m_udpBlockSize/2),
+    m_encodeScheduled(false),
+    m_nbTasks(0),
+    m_closing(false),
+    m_droppedSamples(0),
+    m_nbDatagrams(0)
 {
-    std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
-    m_udpSocket = new QUdpSocket(parent);
-    m_rtpBufferAudio = new RTPSink(m_udpSocket, sampleRate, stereo);
+    init(true, sampleRate, stereo);
 }
 
 AudioNetSink::~AudioNetSink()
 {
-    if (m_rtpBufferAudio) {
-        delete m_rtpBufferAudio;
+    m_tasksMutex.lock();
+    m_closing = true;
+
+    while (m_nbTasks > 0) { // encoding tasks still refer to this sink
+        m_tasksDone.wait(&m_tasksMutex);
     }
 
-    m_udpSocket->deleteLater(); // this thread is not the owner thread (was moved)
+    m_tasksMutex.unlock();
+
+    // the sender is deleted with the socket in its thread when the thread finishes
+    m_senderThread->quit();
+    m_senderThread->wait();
+    delete m_senderThread;
+}
+
+void AudioNetSink::init(bool rtp, int sampleRate, bool stereo)
+{
+    std::fill(m_data, m_data+m_dataBlockSize, 0);
+    m_ring.resize(m_ringSize);
+    m_destinations.push_back(Destination{QHostAddress(QHostAddress::LocalHost), 9998});
+    m_senderThread = new QThread();
+    m_sender = new AudioNetSender(rtp, sampleRate, stereo);
+    m_sender->moveToThread(m_senderThread);
+    QObject::connect(m_senderThread, &QThread::finished, m_sender, &QObject::deleteLater);
+    m_senderThread->start();
+    setBlockSize();
+}
+
+QThreadPool *AudioNetSink::getEncoderPool()
+{
+    static QThreadPool encoderPool;
+    return &encoderPool;
 }
 
 bool AudioNetSink::isRTPCapable() const
 {
-    return m_rtpBufferAudio && m_rtpBufferAudio->isValid();
+    return m_sender->isRTPCapable();
 }
 
 bool AudioNetSink::selectType(SinkType type)
 {
+    QMutexLocker mutexLocker(&m_encoderMutex);
+
     if (type == SinkUDP)
     {
         m_type = SinkUDP;
@@ -90,31 +153,61 @@ bool AudioNetSink::selectType(SinkType type)
         m_type = SinkRTP;
     }
 
+    setBlockSize();
+    resetRing();
+
     return true;
 }
 
 void AudioNetSink::setDestination(const QString& address, uint16_t port)
 {
-    m_address.setAddress(const_cast<QString&>(address));
-    m_port = port;
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    m_destinations[0].m_address.setAddress(address);
+    m_destinations[0].m_port = port;
 
-    if (m_rtpBufferAudio) {
-        m_rtpBufferAudio->setDestination(address, port);
-    }
+    m_sender->setRTPDestination(address, port);
 }
 
 void AudioNetSink::addDestination(const QString& address, uint16_t port)
 {
-    if (m_rtpBufferAudio) {
-        m_rtpBufferAudio->addDestination(address, port);
-    }
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    m_destinations.push_back(Destination{QHostAddress(address), port});
+
+    m_sender->addRTPDestination(address, port);
 }
 
 void AudioNetSink::deleteDestination(const QString& address, uint16_t port)
 {
-    if (m_rtpBufferAudio) {
-        m_rtpBufferAudio->deleteDestination(address, port);
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    QHostAddress hostAddress(address);
+
+    for (unsigned int i = 1; i < m_destinations.size(); i++) // first destination is kept
+    {
+        if ((m_destinations[i].m_address == hostAddress) && (m_destinations[i].m_port == port))
+        {
+            m_destinations.erase(m_destinations.begin() + i);
+            break;
+        }
     }
+
+    m_sender->deleteRTPDestination(address, port);
+}
+
+void AudioNetSink::setMulticastTTL(int ttl)
+{
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    qDebug("AudioNetSink::setMulticastTTL: %d", ttl);
+    m_batchSender.setMulticastTTL(ttl);
+    m_sender->setMulticastTTL(ttl);
+}
+
+void AudioNetSink::setFramesPerDatagram(int nbFrames)
+{
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    m_framesPerDatagram = nbFrames < 1 ? 1 : nbFrames > AudioOpus::m_maxFramesPerPacket ? AudioOpus::m_maxFramesPerPacket : nbFrames;
+    qDebug("AudioNetSink::setFramesPerDatagram: %d from %d", m_framesPerDatagram, nbFrames);
+    setBlockSize();
+    resetRing();
 }
 
 void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
@@ -124,36 +217,37 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
             << " stereo: " << stereo
             << " sampleRate: " << sampleRate;
 
+    QMutexLocker mutexLocker(&m_encoderMutex);
     m_codec = codec;
     m_stereo = stereo;
     m_sampleRate = sampleRate;
 
     setNewCodecData();
 
-    if (m_rtpBufferAudio)
+    if (m_sender->isRTPCapable())
     {
         switch (m_codec)
         {
         case CodecPCMA:
             m_audioCompressor.fillALaw();
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadPCMA8, sampleRate);
+            m_sender->setRTPPayloadInformation(RTPSink::PayloadPCMA8, sampleRate);
             break;
         case CodecPCMU:
             m_audioCompressor.fillULaw();
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadPCMU8, sampleRate);
+            m_sender->setRTPPayloadInformation(RTPSink::PayloadPCMU8, sampleRate);
             break;
         case CodecL8:
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadL8, sampleRate);
+            m_sender->setRTPPayloadInformation(RTPSink::PayloadL8, sampleRate);
             break;
         case CodecG722:
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadG722, sampleRate/2);
+            m_sender->setRTPPayloadInformation(RTPSink::PayloadG722, sampleRate/2);
             break;
         case CodecOpus:
-            m_rtpBufferAudio->setPayloadInformation(RTPSink::PayloadOpus, sampleRate);
+            m_sender->setRTPPayloadInformation(RTPSink::PayloadOpus, sampleRate);
             break;
         case CodecL16: // actually no codec
         default:
-            m_rtpBufferAudio->setPayloadInformation(stereo ? RTPSink::PayloadL16Stereo : RTPSink::PayloadL16Mono, sampleRate);
+            m_sender->setRTPPayloadInformation(stereo ? RTPSink::PayloadL16Stereo : RTPSink::PayloadL16Mono, sampleRate);
             break;
         }
     }
@@ -161,6 +255,7 @@ void AudioNetSink::setParameters(Codec codec, bool stereo, int sampleRate)
 
 void AudioNetSink::setDecimation(uint32_t decimation)
 {
+    QMutexLocker mutexLocker(&m_encoderMutex);
     m_decimation = decimation < 1 ? 1 : decimation > 6 ? 6 : decimation;
     qDebug() << "AudioNetSink::setDecimation: " << m_decimation << " from: " << decimation;
     setNewCodecData();
@@ -173,20 +268,51 @@ void AudioNetSink::setNewCodecData()
     {
         m_codecInputSize = m_sampleRate / (m_decimation * 50); // 20ms = 1/50s - size is per channel
         m_codecInputSize = m_codecInputSize > 960 ? 960 : m_codecInputSize; // hard limit of 48 kS/s
-        m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
         qDebug() << "AudioNetSink::setNewCodecData: CodecOpus:"
             << " m_codecInputSize: " << m_codecInputSize
-            << " m_codecRatio: " << m_codecRatio
             << " Fs: " << m_sampleRate/m_decimation
             << " stereo: " << m_stereo;
         m_opus.setEncoder(m_sampleRate/m_decimation, m_stereo ? 2 : 1);
-        m_codecInputIndex = 0;
-        m_bufferIndex = 0;
     }
 
+    setBlockSize();
+    resetRing();
     setDecimationFilters();
 }
 
+void AudioNetSink::setBlockSize()
+{
+    int blockSize;
+
+    switch (m_codec)
+    {
+    case CodecOpus: // frames of 20ms
+        blockSize = m_codecInputSize * (m_stereo ? 2 : 1) * (m_type == SinkUDP ? m_framesPerDatagram : 1);
+        break;
+    case CodecG722: // 2 samples per byte
+        blockSize = 2*m_udpBlockSize;
+        break;
+    case CodecPCMA:
+    case CodecPCMU:
+    case CodecL8:
+        blockSize = m_udpBlockSize;
+        break;
+    case CodecL16:
+    default:
+        blockSize = m_udpBlockSize/2;
+        break;
+    }
+
+    m_block.resize(blockSize);
+    m_blockSize.store(blockSize);
+}
+
+void AudioNetSink::resetRing()
+{
+    m_readCount.store(m_writeCount.load());
+    m_nbDatagrams = 0;
+}
+
 void AudioNetSink::setDecimationFilters()
 {
     int decimatedSampleRate = m_sampleRate / m_decimation;
@@ -229,259 +355,223 @@ void AudioNetSink::write(qint16 isample)
         }
     }
 
-    if (m_type == SinkUDP)
+    push(&sample, 1);
+}
+
+void AudioNetSink::write(qint16 ilSample, qint16 irSample)
+{
+    if ((m_codec == CodecPCMA) || (m_codec == CodecPCMU) || (m_codec == CodecG722)) { // mono modes - do nothing
+        return;
+    }
+
+    qint16 samples[2] = {ilSample, irSample};
+
+    if (m_decimation > 1)
     {
-        if (m_codec == CodecG722)
+        float lpLSample = m_audioFilter.runLP(samples[0] / 32768.0f);
+        float lpRSample = m_audioFilter.runLP(samples[1] / 32768.0f);
+
+        if (m_decimationCount >= m_decimation - 1)
         {
-            if (m_bufferIndex >= 2*m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
+            samples[0] = lpLSample * 32768.0f;
+            samples[1] = lpRSample * 32768.0f;
+            m_decimationCount = 0;
         }
         else
         {
-            if (m_bufferIndex >= m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
+            m_decimationCount++;
+            return;
         }
+    }
+
+    push(samples, 2);
+}
+
+void AudioNetSink::push(const qint16 *samples, int nbSamples)
+{
+    uint64_t writeCount = m_writeCount.load(std::memory_order_relaxed);
+
+    if (writeCount + nbSamples - m_readCount.load(std::memory_order_acquire) > (uint64_t) m_ringSize) // encoder lags
+    {
+        m_droppedSamples += nbSamples;
+        return;
+    }
+
+    for (int i = 0; i < nbSamples; i++) {
+        m_ring[(writeCount + i) & (m_ringSize - 1)] = samples[i];
+    }
+
+    m_writeCount.store(writeCount + nbSamples, std::memory_order_release);
+
+    if (writeCount + nbSamples - m_readCount.load(std::memory_order_relaxed) >= (uint64_t) m_blockSize.load(std::memory_order_relaxed)) {
+        scheduleEncoding();
+    }
+}
+
+void AudioNetSink::scheduleEncoding()
+{
+    if (m_encodeScheduled.exchange(true)) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_tasksMutex);
+
+    if (m_closing)
+    {
+        m_encodeScheduled.store(false);
+        return;
+    }
+
+    m_nbTasks++;
+    getEncoderPool()->start(new EncodeTask(this));
+}
+
+void AudioNetSink::encode()
+{
+    QMutexLocker mutexLocker(&m_encoderMutex);
+    quint64 droppedSamples = m_droppedSamples.exchange(0);
+
+    if (droppedSamples != 0) {
+        qDebug("AudioNetSink::encode: %llu samples dropped", droppedSamples);
+    }
+
+    int blockSize = m_blockSize.load();
+    uint64_t readCount = m_readCount.load(std::memory_order_relaxed);
+
+    while (m_writeCount.load(std::memory_order_acquire) - readCount >= (uint64_t) blockSize)
+    {
+        unsigned int readIndex = readCount & (m_ringSize - 1);
+        unsigned int firstPart = std::min(blockSize, m_ringSize - (int) readIndex);
+        std::copy(&m_ring[readIndex], &m_ring[readIndex] + firstPart, m_block.begin());
+        std::copy(m_ring.begin(), m_ring.begin() + (blockSize - firstPart), m_block.begin() + firstPart);
+        readCount += blockSize;
+        m_readCount.store(readCount, std::memory_order_release);
+        encodeBlock(m_block.data());
+    }
+
+    sendDatagrams();
+}
+
+void AudioNetSink::encodeBlock(const int16_t *samples)
+{
+    int blockSize = m_block.size();
+
+    if (m_type == SinkUDP)
+    {
+        char *datagram = getDatagram();
 
         switch(m_codec)
         {
         case CodecPCMA:
         case CodecPCMU:
-        {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = m_audioCompressor.compress8(sample);
-            m_bufferIndex += sizeof(qint8);
-        }
+            for (int i = 0; i < blockSize; i++) {
+                datagram[i] = m_audioCompressor.compress8(samples[i]);
+            }
+            commitDatagram(blockSize);
             break;
         case CodecL8:
-        {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = sample / 256;
-            m_bufferIndex += sizeof(qint8);
-        }
+            for (int i = 0; i < blockSize; i++) {
+                datagram[i] = samples[i] / 256;
+            }
+            commitDatagram(blockSize);
             break;
         case CodecG722:
-        {
-            qint16 *p = (qint16*) &m_data[m_udpBlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
-
-            if (m_bufferIndex == 2*m_udpBlockSize) {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_udpBlockSize], 2*m_udpBlockSize);
-            }
-        }
+            commitDatagram(m_g722.encode((uint8_t *) datagram, samples, blockSize));
             break;
         case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
-            }
-
-            m_opusIn[m_codecInputIndex++] = sample;
-        }
+            commitDatagram(m_opus.encode(m_codecInputSize, m_framesPerDatagram, (int16_t *) samples, (uint8_t *) datagram, m_maxDatagramSize));
             break;
         case CodecL16:
         default:
-        {
-            qint16 *p = (qint16*) &m_data[m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += sizeof(qint16);
-        }
+            std::copy(samples, samples + blockSize, (int16_t *) datagram);
+            commitDatagram(blockSize * sizeof(int16_t));
             break;
         }
     }
-    else if (m_type == SinkRTP)
+    else if ((m_type == SinkRTP) && m_sender->isRTPCapable())
     {
         switch(m_codec)
         {
         case CodecPCMA:
         case CodecPCMU:
-        {
-            qint8 p = m_audioCompressor.compress8(sample);
-            m_rtpBufferAudio->write((uint8_t *) &p);
-        }
+            for (int i = 0; i < blockSize; i++) {
+                m_data[i] = m_audioCompressor.compress8(samples[i]);
+            }
+            m_sender->queueRTP((uint8_t *) m_data, blockSize, blockSize);
             break;
         case CodecL8:
-        {
-            qint8 p = sample / 256;
-            m_rtpBufferAudio->write((uint8_t *) &p);
-        }
+            for (int i = 0; i < blockSize; i++) {
+                m_data[i] = samples[i] / 256;
+            }
+            m_sender->queueRTP((uint8_t *) m_data, blockSize, blockSize);
             break;
         case CodecG722:
         {
-
-            if (m_bufferIndex >= 2*m_g722BlockSize)
-            {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_g722BlockSize], 2*m_g722BlockSize);
-                m_bufferIndex = 0;
-            }
-
-            if (m_bufferIndex % 2 == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex/2]);
-            }
-
-            qint16 *p = (qint16*) &m_data[m_g722BlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
+            int nbBytes = m_g722.encode((uint8_t *) m_data, samples, blockSize);
+            m_sender->queueRTP((uint8_t *) m_data, nbBytes, nbBytes);
         }
             break;
         case CodecOpus:
         {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
-                }
-                m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
+            int nbBytes = m_opus.encode(m_codecInputSize, (int16_t *) samples, (uint8_t *) m_data);
 
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
+            if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
+                qWarning("AudioNetSink::encodeBlock: CodecOpus: unexpected output frame size: %d bytes", nbBytes);
             }
 
-            m_opusIn[m_codecInputIndex++] = sample;
+            m_sender->queueRTP((uint8_t *) m_data, nbBytes, nbBytes);
         }
             break;
         case CodecL16:
         default:
-            m_rtpBufferAudio->write((uint8_t *) &sample);
+            m_sender->queueRTP((uint8_t *) samples, blockSize * sizeof(int16_t), m_stereo ? blockSize/2 : blockSize);
             break;
         }
     }
 }
 
-void AudioNetSink::write(qint16 ilSample, qint16 irSample)
+char *AudioNetSink::getDatagram()
 {
-    qint16& lSample = ilSample;
-    qint16& rSample = irSample;
+    if (m_nbDatagrams == m_maxBatch) {
+        sendDatagrams();
+    }
 
-    if (m_decimation > 1)
+    return m_datagrams[m_nbDatagrams];
+}
+
+void AudioNetSink::commitDatagram(int size)
+{
+    if (size > 0)
     {
-        float lpLSample = m_audioFilter.runLP(lSample / 32768.0f);
-        float lpRSample = m_audioFilter.runLP(rSample / 32768.0f);
+        m_datagramSizes[m_nbDatagrams] = size;
+        m_nbDatagrams++;
+    }
+}
 
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            lSample = lpLSample * 32768.0f;
-            rSample = lpRSample * 32768.0f;
-            m_decimationCount = 0;
-        }
-        else
-        {
-            m_decimationCount++;
-            return;
-        }
+void AudioNetSink::sendDatagrams()
+{
+    if (m_nbDatagrams == 0) {
+        return;
     }
 
-    if (m_type == SinkUDP)
+    for (const auto& destination : m_destinations)
     {
-        if (m_bufferIndex >= m_udpBlockSize)
+        if (m_batchSender.canSend(destination.m_address))
         {
-            m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-            m_bufferIndex = 0;
-        }
+            UDPBatchSender::Message messages[m_maxBatch];
 
-        switch(m_codec)
-        {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
+            for (int i = 0; i < m_nbDatagrams; i++) {
+                messages[i] = UDPBatchSender::Message{m_datagrams[i], (unsigned int) m_datagramSizes[i]};
             }
 
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
-        }
-            break;
-        case CodecL8:
-        {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = lSample / 256;
-            m_bufferIndex += sizeof(qint8);
-            p = (qint8*) &m_data[m_bufferIndex];
-            *p = rSample / 256;
-            m_bufferIndex += sizeof(qint8);
-        }
-            break;
-        case CodecL16:
-        default:
-        {
-            qint16 *p = (qint16*) &m_data[m_bufferIndex];
-            *p = lSample;
-            m_bufferIndex += sizeof(qint16);
-            p = (qint16*) &m_data[m_bufferIndex];
-            *p = rSample;
-            m_bufferIndex += sizeof(qint16);
-        }
-            break;
+            m_batchSender.send(messages, m_nbDatagrams, destination.m_address, destination.m_port);
+            continue;
         }
-    }
-    else if (m_type == SinkRTP)
-    {
-        switch(m_codec)
-        {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
-                }
-                m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
-
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
-            }
 
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
-        }
-            break;
-        case CodecL8:
-        {
-            qint8 pl = lSample / 256;
-            qint8 pr = rSample / 256;
-            m_rtpBufferAudio->write((uint8_t *) &pl, (uint8_t *) &pr);
-        }
-            break;
-        case CodecL16:
-        default:
-            m_rtpBufferAudio->write((uint8_t *) &lSample, (uint8_t *) &rSample);
-            break;
+        for (int i = 0; i < m_nbDatagrams; i++) {
+            m_sender->queueDatagram(m_datagrams[i], m_datagramSizes[i], destination.m_address, destination.m_port);
         }
     }
-}
 
-void AudioNetSink::moveToThread(QThread *thread)
-{
-    m_udpSocket->moveToThread(thread);
+    m_nbDatagrams = 0;
 }
-
@@ -24,16 +24,31 @@
 #include "audiocompressor.h"
 #include "audiog722.h"
 #include "audioopus.h"
+#include "util/udpbatchsender.h"
 #include "export.h"
 
 #include <QObject>
 #include <QHostAddress>
+#include <QMutex>
+#include <QWaitCondition>
 #include <stdint.h>
 
-class QUdpSocket;
-class RTPSink;
+#include <atomic>
+#include <vector>
+
+class AudioNetSender;
 class QThread;
+class QThreadPool;
 
+/**
+ * Samples written by the audio thread are only decimated and stored in a lock-free ring.
+ * Encoding runs in a worker pool shared by all sinks so that the writer never waits on the
+ * codec nor the socket. A sink has at most one encoding task at a time that processes all
+ * complete blocks of the ring in order. In UDP mode the datagrams of a task are sent to all
+ * destinations at once with the native socket (Linux IPv4). The datagrams to the other
+ * destinations and the RTP payloads are sent by the AudioNetSender thread of the sink that
+ * owns the Qt socket. Destinations can be multicast addresses.
+ */
 class SDRBASE_API AudioNetSink {
 public:
     typedef enum
@@ -52,8 +67,8 @@ public:
         CodecOpus  //!< Opus compressed 8 bit samples at 64kbits/s (8kS/s out). Various input sample rates
     } Codec;
 
-    AudioNetSink(QObject *parent); //!< without RTP
-    AudioNetSink(QObject *parent, int sampleRate, bool stereo); //!< with RTP
+    AudioNetSink(); //!< without RTP
+    AudioNetSink(int sampleRate, bool stereo); //!< with RTP
     ~AudioNetSink();
 
     void setDestination(const QString& address, uint16_t port);
@@ -61,6 +76,8 @@ public:
     void deleteDestination(const QString& address, uint16_t port);
     void setParameters(Codec codec, bool stereo, int sampleRate);
     void setDecimation(uint32_t decimation);
+    void setMulticastTTL(int ttl);           //!< Time to live of the datagrams sent to multicast destinations
+    void setFramesPerDatagram(int nbFrames); //!< Number of Opus frames gathered in a UDP datagram (1 to 6)
 
     void write(qint16 sample);
     void write(qint16 lSample, qint16 rSample);
@@ -68,22 +85,42 @@ public:
     bool isRTPCapable() const;
     bool selectType(SinkType type);
 
-    void moveToThread(QThread *thread);
+    static QThreadPool *getEncoderPool(); //!< Workers shared by all sinks
 
     static const int m_udpBlockSize;
-    static const int m_dataBlockSize = 65536; // room for G722 conversion (64000 = 12800*5 largest to date)
-    static const int m_g722BlockSize = 12800; // number of resulting G722 bytes (80*20ms frames)
-    static const int m_opusBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
+    static const int m_dataBlockSize = 65536; // room for codec output of a block
     static const int m_opusOutputSize = 160;  // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
+    static const int m_ringSize = 1<<16;      // samples ring size (about 0.7s of 48 kS/s stereo)
+    static const int m_maxBatch = 16;         // maximum number of datagrams sent at once
+    static const int m_maxDatagramSize = 4096;
 
 protected:
+    class EncodeTask;
+
+    struct Destination
+    {
+        QHostAddress m_address;
+        quint16 m_port;
+    };
+
+    void init(bool rtp, int sampleRate, bool stereo);
     void setNewCodecData();       // actions to take when changes affecting codec dependent data occurs
     void setDecimationFilters();  // set decimation filters limits depending on effective sample rate and codec
+    void setBlockSize();          // number of ring samples encoded at once depending on codec and sink type
+    void resetRing();             // drop samples not encoded yet
+    void push(const qint16 *samples, int nbSamples);
+    void scheduleEncoding();
+    void encode();                // encode all complete blocks of the ring (encoding task)
+    void encodeBlock(const int16_t *samples);
+    char *getDatagram();          // next datagram of the batch
+    void commitDatagram(int size);
+    void sendDatagrams();
 
     SinkType m_type;
     Codec m_codec;
-    QUdpSocket *m_udpSocket;
-    RTPSink *m_rtpBufferAudio;
+    UDPBatchSender m_batchSender; //!< Native socket for batched transmissions
+    QThread *m_senderThread;
+    AudioNetSender *m_sender;     //!< Qt socket and RTP transmissions in m_senderThread
     AudioCompressor m_audioCompressor;
     AudioG722 m_g722;
     AudioOpus m_opus;
@@ -93,13 +130,24 @@ protected:
     uint32_t m_decimation;
     uint32_t m_decimationCount;
     char m_data[m_dataBlockSize];
-    int16_t m_opusIn[m_opusBlockSize];
     int m_codecInputSize;  // codec input block size - for codecs with actual encoding (Opus only for now)
-    int m_codecInputIndex; // codec input block fill index
-    int m_codecRatio;      // codec compression ratio
-    unsigned int m_bufferIndex;
-    QHostAddress m_address;
-    unsigned int m_port;
+    int m_framesPerDatagram;
+    std::vector<Destination> m_destinations; //!< first is set with setDestination
+    QMutex m_encoderMutex;                   //!< encoding task against parameter changes
+    std::vector<int16_t> m_ring;
+    std::atomic<uint64_t> m_writeCount;      //!< samples written to the ring. Updated by the writer only
+    std::atomic<uint64_t> m_readCount;       //!< samples read from the ring. Updated by the encoder only
+    std::atomic<int> m_blockSize;            //!< samples (all channels) encoded at once
+    std::atomic<bool> m_encodeScheduled;     //!< an encoding task is scheduled or running
+    QMutex m_tasksMutex;
+    QWaitCondition m_tasksDone;
+    int m_nbTasks;                           //!< encoding tasks alive. Under m_tasksMutex
+    bool m_closing;                          //!< no more encoding task. Under m_tasksMutex
+    std::atomic<quint64> m_droppedSamples;   //!< samples dropped by the writer because the ring was full
+    std::vector<int16_t> m_block;            //!< block of samples being encoded
+    char m_datagrams[m_maxBatch][m_maxDatagramSize];
+    int m_datagramSizes[m_maxBatch];
+    int m_nbDatagrams;
 };
 
 #endif /* SDRBASE_AUDIO_AUDIONETSINK_H_ */
@@ -28,8 +28,10 @@
 AudioOpus::AudioOpus() :
     m_encoderState(0),
     m_encoderOK(false),
+    m_nbChannels(1),
     m_mutex(QMutex::Recursive)
 {
+    m_repacketizer = opus_repacketizer_create();
     qDebug("AudioOpus::AudioOpus: libopus version %s", opus_get_version_string());
 }
 
@@ -38,6 +40,8 @@ AudioOpus::~AudioOpus()
     if (m_encoderState) {
         opus_encoder_destroy(m_encoderState);
     }
+
+    opus_repacketizer_destroy(m_repacketizer);
 }
 
 void AudioOpus::setEncoder(int32_t fs, int nChannels)
@@ -62,6 +66,7 @@ void AudioOpus::setEncoder(int32_t fs, int nChannels)
     {
         qDebug("AudioOpus::setEncoder: fs: %d, nChannels: %d", fs, nChannels);
         m_encoderOK = true;
+        m_nbChannels = nChannels;
     }
 
     error = opus_encoder_ctl(m_encoderState, OPUS_SET_BITRATE(m_bitrate));
@@ -105,3 +110,42 @@ int AudioOpus::encode(int frameSize, int16_t *in, uint8_t *out)
         return nbBytes;
     }
 }
+
+int AudioOpus::encode(int frameSize, int nbFrames, int16_t *in, uint8_t *out, int maxSize)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (nbFrames <= 1) {
+        return encode(frameSize, in, out);
+    }
+
+    nbFrames = nbFrames > m_maxFramesPerPacket ? m_maxFramesPerPacket : nbFrames;
+    opus_repacketizer_init(m_repacketizer);
+
+    for (int i = 0; i < nbFrames; i++)
+    {
+        int nbBytes = encode(frameSize, &in[i*frameSize*m_nbChannels], m_frames[i]);
+
+        if (nbBytes == 0) {
+            return 0;
+        }
+
+        int error = opus_repacketizer_cat(m_repacketizer, m_frames[i], nbBytes);
+
+        if (error != OPUS_OK)
+        {
+            qWarning("AudioOpus::encode: cannot gather frame %d: %s", i, opus_strerror(error));
+            return 0;
+        }
+    }
+
+    int nbBytes = opus_repacketizer_out(m_repacketizer, out, maxSize);
+
+    if (nbBytes < 0)
+    {
+        qWarning("AudioOpus::encode: cannot make packet of %d frames: %s", nbFrames, opus_strerror(nbBytes));
+        return 0;
+    }
+
+    return nbBytes;
+}
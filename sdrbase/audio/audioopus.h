@@ -24,6 +24,7 @@
 #include "export.h"
 
 class OpusEncoder;
+class OpusRepacketizer;
 
 class SDRBASE_API AudioOpus
 {
@@ -33,13 +34,19 @@ public:
 
     void setEncoder(int32_t fs, int nChannels);
     int encode(int frameSize, int16_t *in, uint8_t *out);
+    /** Encode nbFrames consecutive frames of frameSize samples per channel in a single packet of at most maxSize bytes */
+    int encode(int frameSize, int nbFrames, int16_t *in, uint8_t *out, int maxSize);
 
     static const int m_bitrate = 64000; //!< Fixed 64kb/s bitrate (8kB/s)
     static const int m_maxPacketSize = 3*1276;
+    static const int m_maxFramesPerPacket = 6; //!< 120 ms of 20 ms frames
 
 private:
     OpusEncoder *m_encoderState;
+    OpusRepacketizer *m_repacketizer;
     bool m_encoderOK;
+    int m_nbChannels;
+    uint8_t m_frames[m_maxFramesPerPacket][m_maxPacketSize]; //!< frames to gather in a packet
     QMutex m_mutex;
 };
 
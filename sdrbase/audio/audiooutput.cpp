@@ -113,7 +113,7 @@ bool AudioOutput::start(int device, int rate)
         }
 
         m_audioOutput = new QAudioOutput(devInfo, m_audioFormat);
-        m_audioNetSink = new AudioNetSink(0, m_audioFormat.sampleRate(), false);
+        m_audioNetSink = new AudioNetSink(m_audioFormat.sampleRate(), false);
 
         QIODevice::open(QIODevice::ReadOnly);
 
@@ -218,6 +218,20 @@ void AudioOutput::setUdpDecimation(uint32_t decimation)
 	}
 }
 
+void AudioOutput::setUdpMulticastTTL(int ttl)
+{
+    if (m_audioNetSink) {
+        m_audioNetSink->setMulticastTTL(ttl);
+    }
+}
+
+void AudioOutput::setUdpFramesPerDatagram(int nbFrames)
+{
+    if (m_audioNetSink) {
+        m_audioNetSink->setFramesPerDatagram(nbFrames);
+    }
+}
+
 qint64 AudioOutput::readData(char* data, qint64 maxLen)
 {
     //qDebug("AudioOutput::readData: %lld", maxLen);
@@ -71,6 +71,8 @@ public:
 	void setUdpChannelMode(UDPChannelMode udpChannelMode);
 	void setUdpChannelFormat(UDPChannelCodec udpChannelCodec, bool stereo, int sampleRate);
 	void setUdpDecimation(uint32_t decimation);
+	void setUdpMulticastTTL(int ttl);
+	void setUdpFramesPerDatagram(int nbFrames);
 
 private:
 	QMutex m_mutex;
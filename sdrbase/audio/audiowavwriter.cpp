@@ -0,0 +1,235 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QDataStream>
+#include <QDebug>
+
+#include "audio/audiofifo.h"
+#include "audiowavwriter.h"
+
+AudioWavWriter::AudioWavWriter() :
+    m_open(false),
+    m_stopRequested(false),
+    m_prefixCount(0),
+    m_totalSamples(0)
+{
+    m_buffer.resize(4096);
+}
+
+AudioWavWriter::~AudioWavWriter()
+{
+    close();
+}
+
+void AudioWavWriter::open(const QString& directory)
+{
+    if (m_open) {
+        return;
+    }
+
+    m_directory = directory;
+    m_closedFiles.clear();
+    m_totalSamples = 0;
+    m_stopRequested = false;
+    m_open = true;
+    start();
+}
+
+void AudioWavWriter::close()
+{
+    if (!m_open) {
+        return;
+    }
+
+    m_stopRequested = true;
+    m_dataAvailable.release(); // wake up the thread
+    wait();
+
+    QMutexLocker fileLocker(&m_fileMutex);
+    std::vector<FifoFile*> fifoFiles;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        fifoFiles.swap(m_fifoFiles);
+    }
+
+    for (auto fifoFile : fifoFiles)
+    {
+        fifoFile->m_audioFifo->setBlocking(false);
+        drain(*fifoFile);
+        closeFile(*fifoFile);
+        delete fifoFile;
+    }
+
+    m_dataAvailable.acquire(m_dataAvailable.available());
+    m_open = false;
+}
+
+void AudioWavWriter::setFilePrefix(const QString& prefix)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_prefix = prefix;
+    m_prefixCount = 0;
+}
+
+bool AudioWavWriter::addFifo(AudioFifo *audioFifo, unsigned int sampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    FifoFile *fifoFile = new FifoFile();
+    fifoFile->m_audioFifo = audioFifo;
+    fifoFile->m_stats.m_fileName = QString("%1/%2audio%3.wav").arg(m_directory).arg(m_prefix).arg(m_prefixCount);
+    fifoFile->m_stats.m_sampleRate = sampleRate;
+    fifoFile->m_stats.m_nbSamples = 0;
+    fifoFile->m_file = new QFile(fifoFile->m_stats.m_fileName);
+
+    if (!fifoFile->m_file->open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("AudioWavWriter::addFifo: cannot create %s: %s",
+            qPrintable(fifoFile->m_stats.m_fileName), qPrintable(fifoFile->m_file->errorString()));
+        delete fifoFile->m_file;
+        delete fifoFile;
+        return false;
+    }
+
+    writeHeader(*fifoFile->m_file, sampleRate, 0); // completed when the file is closed. The thread does not know the file yet
+    m_fifoFiles.push_back(fifoFile);
+    m_prefixCount++;
+    audioFifo->setBlocking(true, &m_dataAvailable); // the channel waits for the writer instead of dropping samples
+    qDebug("AudioWavWriter::addFifo: %p: %s at %u S/s", audioFifo, qPrintable(fifoFile->m_stats.m_fileName), sampleRate);
+    return true;
+}
+
+void AudioWavWriter::removeFifo(AudioFifo *audioFifo)
+{
+    QMutexLocker fileLocker(&m_fileMutex);
+    FifoFile *fifoFile = nullptr;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+
+        for (auto it = m_fifoFiles.begin(); it != m_fifoFiles.end(); ++it)
+        {
+            if ((*it)->m_audioFifo == audioFifo)
+            {
+                fifoFile = *it;
+                m_fifoFiles.erase(it);
+                break;
+            }
+        }
+    }
+
+    if (fifoFile)
+    {
+        audioFifo->setBlocking(false);
+        drain(*fifoFile);
+        closeFile(*fifoFile);
+        delete fifoFile;
+    }
+}
+
+void AudioWavWriter::getStats(std::vector<FileStats>& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stats = m_closedFiles;
+
+    for (const auto fifoFile : m_fifoFiles) {
+        stats.push_back(fifoFile->m_stats);
+    }
+}
+
+void AudioWavWriter::run()
+{
+    std::vector<FifoFile*> fifoFiles;
+
+    while (true)
+    {
+        // sleep until a FIFO has been written to. All FIFOs are drained in one pass.
+        m_dataAvailable.acquire();
+        m_dataAvailable.tryAcquire(m_dataAvailable.available());
+
+        if (m_stopRequested) {
+            break;
+        }
+
+        QMutexLocker fileLocker(&m_fileMutex);
+
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+            fifoFiles = m_fifoFiles;
+        }
+
+        for (auto fifoFile : fifoFiles) {
+            drain(*fifoFile);
+        }
+    }
+}
+
+bool AudioWavWriter::drain(FifoFile& fifoFile)
+{
+    bool written = false;
+    uint32_t nbSamples;
+
+    // the FIFO is read in its own lock and the file written without holding the list lock
+    while ((nbSamples = fifoFile.m_audioFifo->read((quint8*) m_buffer.data(), m_buffer.size())) > 0)
+    {
+        fifoFile.m_file->write((const char*) m_buffer.data(), nbSamples * sizeof(AudioSample));
+        m_mutex.lock();
+        fifoFile.m_stats.m_nbSamples += nbSamples;
+        m_mutex.unlock();
+        m_totalSamples += nbSamples;
+        written = true;
+    }
+
+    return written;
+}
+
+void AudioWavWriter::closeFile(FifoFile& fifoFile)
+{
+    fifoFile.m_file->seek(0);
+    writeHeader(*fifoFile.m_file, fifoFile.m_stats.m_sampleRate, fifoFile.m_stats.m_nbSamples);
+    fifoFile.m_file->close();
+    delete fifoFile.m_file;
+    fifoFile.m_file = nullptr;
+    m_mutex.lock();
+    m_closedFiles.push_back(fifoFile.m_stats);
+    m_mutex.unlock();
+    qDebug("AudioWavWriter::closeFile: %s: %llu samples",
+        qPrintable(fifoFile.m_stats.m_fileName), fifoFile.m_stats.m_nbSamples);
+}
+
+void AudioWavWriter::writeHeader(QFile& file, unsigned int sampleRate, quint64 nbSamples)
+{
+    // 16 bit stereo PCM like the audio FIFO samples. Sizes are saturated above 4 GB
+    quint32 dataSize = (quint32) std::min(nbSamples * sizeof(AudioSample), (quint64) 0xFFFFFFFF - 36);
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.writeRawData("RIFF", 4);
+    stream << (quint32) (36 + dataSize);
+    stream.writeRawData("WAVE", 4);
+    stream.writeRawData("fmt ", 4);
+    stream << (quint32) 16;                               // fmt chunk size
+    stream << (quint16) 1;                                // PCM
+    stream << (quint16) 2;                                // channels
+    stream << (quint32) sampleRate;
+    stream << (quint32) (sampleRate * sizeof(AudioSample)); // byte rate
+    stream << (quint16) sizeof(AudioSample);              // block align
+    stream << (quint16) 16;                               // bits per sample
+    stream.writeRawData("data", 4);
+    stream << dataSize;
+}
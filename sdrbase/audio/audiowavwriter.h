@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Writes the audio FIFOs of the channels to WAV files in place of the audio     //
+// outputs. Used for offline (batch) processing where FIFOs are drained as fast  //
+// as they are filled.                                                           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_AUDIOWAVWRITER_H
+#define INCLUDE_AUDIOWAVWRITER_H
+
+#include <atomic>
+#include <vector>
+
+#include <QFile>
+#include <QMutex>
+#include <QSemaphore>
+#include <QString>
+#include <QThread>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class AudioFifo;
+
+class SDRBASE_API AudioWavWriter : public QThread
+{
+    Q_OBJECT
+public:
+    struct FileStats
+    {
+        QString m_fileName;
+        unsigned int m_sampleRate;
+        quint64 m_nbSamples;
+    };
+
+    AudioWavWriter();
+    virtual ~AudioWavWriter();
+
+    void open(const QString& directory); //!< Starts the thread
+    void close();                        //!< Drains the FIFOs, completes the files and stops the thread
+    bool isOpen() const { return m_open; }
+    void setFilePrefix(const QString& prefix); //!< Prefix of the names of the files of the FIFOs added from now on
+
+    bool addFifo(AudioFifo *audioFifo, unsigned int sampleRate); //!< Creates <prefix>audio<n>.wav for this FIFO and makes it blocking
+    void removeFifo(AudioFifo *audioFifo);                       //!< Drains the FIFO, completes its file and makes it non blocking
+
+    quint64 getTotalSamples() const { return m_totalSamples.load(); } //!< Samples written to all files
+    void getStats(std::vector<FileStats>& stats);                     //!< Stats of all files written since open
+
+private:
+    struct FifoFile
+    {
+        AudioFifo *m_audioFifo;
+        QFile *m_file;
+        FileStats m_stats;
+    };
+
+    bool m_open;
+    std::atomic<bool> m_stopRequested;
+    QString m_directory;
+    QString m_prefix;
+    unsigned int m_prefixCount;         //!< files created with the current prefix
+    std::vector<FifoFile*> m_fifoFiles;
+    std::vector<FileStats> m_closedFiles;
+    std::vector<AudioSample> m_buffer;  //!< m_fileMutex held
+    std::atomic<quint64> m_totalSamples;
+    QMutex m_mutex;                     //!< FIFO list, prefix and stats. Not held during file writes
+    QMutex m_fileMutex;                 //!< file writes. Taken before m_mutex
+    QSemaphore m_dataAvailable;         //!< released by the FIFOs after each write
+
+    virtual void run();
+    bool drain(FifoFile& fifoFile);     //!< true if samples were written. m_fileMutex held
+    void closeFile(FifoFile& fifoFile); //!< m_fileMutex held
+    static void writeHeader(QFile& file, unsigned int sampleRate, quint64 nbSamples);
+};
+
+#endif // INCLUDE_AUDIOWAVWRITER_H
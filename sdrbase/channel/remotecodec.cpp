@@ -0,0 +1,477 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <limits>
+
+#include "remotecodec.h"
+
+// The sample loops have no dependency between iterations so that the compiler can vectorize
+// them. Only the Rice bit stream is processed serially.
+
+namespace {
+
+class RiceBitWriter
+{
+public:
+    RiceBitWriter(uint8_t *buf) : m_buf(buf), m_acc(0), m_nbBits(0) {}
+
+    void put(uint64_t value, unsigned int nbBits) //!< at most 56 bits
+    {
+        m_acc = (m_acc << nbBits) | value;
+        m_nbBits += nbBits;
+
+        while (m_nbBits >= 8)
+        {
+            m_nbBits -= 8;
+            *m_buf++ = (uint8_t) (m_acc >> m_nbBits);
+        }
+    }
+
+    void flush()
+    {
+        if (m_nbBits > 0) {
+            *m_buf++ = (uint8_t) (m_acc << (8 - m_nbBits));
+        }
+
+        m_nbBits = 0;
+    }
+
+    uint8_t *end() const { return m_buf; }
+
+private:
+    uint8_t *m_buf;
+    uint64_t m_acc;
+    unsigned int m_nbBits;
+};
+
+class RiceBitReader
+{
+public:
+    RiceBitReader(const uint8_t *buf, const uint8_t *end) : m_buf(buf), m_end(end), m_acc(0), m_nbBits(0), m_overrun(false) {}
+
+    uint32_t get(unsigned int nbBits) //!< at most 32 bits
+    {
+        while (m_nbBits < nbBits)
+        {
+            if (m_buf < m_end) {
+                m_acc = (m_acc << 8) | *m_buf++;
+            } else {
+                m_acc <<= 8;
+                m_overrun = true;
+            }
+
+            m_nbBits += 8;
+        }
+
+        m_nbBits -= nbBits;
+        return (uint32_t) ((m_acc >> m_nbBits) & ((1ULL << nbBits) - 1));
+    }
+
+    bool overrun() const { return m_overrun; }
+
+private:
+    const uint8_t *m_buf;
+    const uint8_t *m_end;
+    uint64_t m_acc;
+    unsigned int m_nbBits;
+    bool m_overrun;
+};
+
+template<typename T>
+inline T clampSample(int64_t value)
+{
+    return (T) std::min<int64_t>(std::max<int64_t>(value, std::numeric_limits<T>::min()), std::numeric_limits<T>::max());
+}
+
+} // namespace
+
+unsigned int RemoteCodec::getNbSamplesPerBlock(Codec codec, unsigned int sampleBytes)
+{
+    switch (codec)
+    {
+    case CodecBFP8:
+    case CodecBFP10:
+    case CodecBFP12:
+        // 2 bytes header. With 10 bits mantissas are packed by groups of 4 components (5 bytes) and this gives an even number of samples
+        return ((RemoteNbBytesPerBlock - 2) * 8) / (2 * getBFPBits(codec));
+    case CodecNearLosslessRice:
+        return sampleBytes == 2 ? 168 : 126;
+    default:
+        return RemoteNbBytesPerBlock / (2 * sampleBytes);
+    }
+}
+
+unsigned int RemoteCodec::encode(Codec codec, const void *samples, unsigned int sampleBytes, RemoteProtectedBlock& block)
+{
+    unsigned int nbSamples = getNbSamplesPerBlock(codec, sampleBytes);
+
+    switch (codec)
+    {
+    case CodecBFP8:
+    case CodecBFP10:
+    case CodecBFP12:
+        block.buf[0] = codec;
+
+        if (sampleBytes == 2) {
+            encodeBFP((const int16_t *) samples, nbSamples, getBFPBits(codec), block.buf);
+        } else {
+            encodeBFP((const int32_t *) samples, nbSamples, getBFPBits(codec), block.buf);
+        }
+        return 0;
+    case CodecNearLosslessRice:
+        block.buf[0] = codec;
+
+        if (sampleBytes == 2) {
+            return encodeRice((const int16_t *) samples, nbSamples, block.buf);
+        } else {
+            return encodeRice((const int32_t *) samples, nbSamples, block.buf);
+        }
+    default:
+        std::copy((const uint8_t *) samples, (const uint8_t *) samples + nbSamples * 2 * sampleBytes, block.buf);
+        return 0;
+    }
+}
+
+bool RemoteCodec::decode(Codec codec, const RemoteProtectedBlock& block, unsigned int sampleBytes, void *samples)
+{
+    unsigned int nbSamples = getNbSamplesPerBlock(codec, sampleBytes);
+
+    if ((codec != CodecRaw) && (block.buf[0] != codec)) {
+        return false;
+    }
+
+    switch (codec)
+    {
+    case CodecBFP8:
+    case CodecBFP10:
+    case CodecBFP12:
+        if (sampleBytes == 2) {
+            decodeBFP(block.buf, nbSamples, getBFPBits(codec), (int16_t *) samples);
+        } else {
+            decodeBFP(block.buf, nbSamples, getBFPBits(codec), (int32_t *) samples);
+        }
+        return true;
+    case CodecNearLosslessRice:
+        if (sampleBytes == 2) {
+            return decodeRice(block.buf, nbSamples, (int16_t *) samples);
+        } else {
+            return decodeRice(block.buf, nbSamples, (int32_t *) samples);
+        }
+    case CodecRaw:
+        std::copy(block.buf, block.buf + nbSamples * 2 * sampleBytes, (uint8_t *) samples);
+        return true;
+    default:
+        return false;
+    }
+}
+
+template<typename T>
+void RemoteCodec::encodeBFP(const T *samples, unsigned int nbSamples, unsigned int bits, uint8_t *buf)
+{
+    const unsigned int nbComponents = 2 * nbSamples;
+    const int32_t maxMantissa = (1 << (bits - 1)) - 1;
+    const int32_t minMantissa = -maxMantissa - 1;
+    int32_t magnitude = 0;
+    uint32_t mantissas[2*m_maxNbSamplesPerBlock];
+
+    for (unsigned int i = 0; i < nbComponents; i++)
+    {
+        int32_t x = samples[i];
+        magnitude = std::max(magnitude, x ^ (x >> 31)); // x or -x-1
+    }
+
+    unsigned int exponent = 0;
+
+    while ((magnitude >> exponent) > maxMantissa) {
+        exponent++;
+    }
+
+    const int32_t half = exponent == 0 ? 0 : 1 << (exponent - 1);
+
+    for (unsigned int i = 0; i < nbComponents; i++)
+    {
+        int32_t mantissa = ((int32_t) samples[i] + half) >> exponent; // rounding
+        mantissas[i] = (uint32_t) std::min(std::max(mantissa, minMantissa), maxMantissa);
+    }
+
+    buf[1] = exponent;
+    uint8_t *p = &buf[2];
+
+    if (bits == 8)
+    {
+        for (unsigned int i = 0; i < nbComponents; i++) {
+            p[i] = (uint8_t) mantissas[i];
+        }
+
+        p += nbComponents;
+    }
+    else if (bits == 10)
+    {
+        for (unsigned int i = 0; i < nbComponents; i += 4, p += 5)
+        {
+            uint64_t v = (uint64_t) (mantissas[i] & 0x3FF)
+                | ((uint64_t) (mantissas[i+1] & 0x3FF) << 10)
+                | ((uint64_t) (mantissas[i+2] & 0x3FF) << 20)
+                | ((uint64_t) (mantissas[i+3] & 0x3FF) << 30);
+            p[0] = (uint8_t) v;
+            p[1] = (uint8_t) (v >> 8);
+            p[2] = (uint8_t) (v >> 16);
+            p[3] = (uint8_t) (v >> 24);
+            p[4] = (uint8_t) (v >> 32);
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < nbComponents; i += 2, p += 3)
+        {
+            uint32_t v = (mantissas[i] & 0xFFF) | ((mantissas[i+1] & 0xFFF) << 12);
+            p[0] = (uint8_t) v;
+            p[1] = (uint8_t) (v >> 8);
+            p[2] = (uint8_t) (v >> 16);
+        }
+    }
+
+    std::fill(p, buf + RemoteNbBytesPerBlock, 0);
+}
+
+template<typename T>
+void RemoteCodec::decodeBFP(const uint8_t *buf, unsigned int nbSamples, unsigned int bits, T *samples)
+{
+    const unsigned int nbComponents = 2 * nbSamples;
+    const unsigned int signShift = 32 - bits;
+    const int64_t scale = 1LL << std::min((unsigned int) buf[1], 32U);
+    uint32_t mantissas[2*m_maxNbSamplesPerBlock];
+    const uint8_t *p = &buf[2];
+
+    if (bits == 8)
+    {
+        for (unsigned int i = 0; i < nbComponents; i++) {
+            mantissas[i] = p[i];
+        }
+    }
+    else if (bits == 10)
+    {
+        for (unsigned int i = 0; i < nbComponents; i += 4, p += 5)
+        {
+            uint64_t v = (uint64_t) p[0]
+                | ((uint64_t) p[1] << 8)
+                | ((uint64_t) p[2] << 16)
+                | ((uint64_t) p[3] << 24)
+                | ((uint64_t) p[4] << 32);
+            mantissas[i] = v & 0x3FF;
+            mantissas[i+1] = (v >> 10) & 0x3FF;
+            mantissas[i+2] = (v >> 20) & 0x3FF;
+            mantissas[i+3] = (v >> 30) & 0x3FF;
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < nbComponents; i += 2, p += 3)
+        {
+            uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+            mantissas[i] = v & 0xFFF;
+            mantissas[i+1] = v >> 12;
+        }
+    }
+
+    for (unsigned int i = 0; i < nbComponents; i++)
+    {
+        int32_t mantissa = ((int32_t) (mantissas[i] << signShift)) >> signShift; // sign extension
+        samples[i] = clampSample<T>(mantissa * scale);
+    }
+}
+
+template<typename T>
+unsigned int RemoteCodec::encodeRice(const T *samples, unsigned int nbSamples, uint8_t *buf)
+{
+    const uint64_t budget = (RemoteNbBytesPerBlock - m_riceHeaderSize) * 8;
+    int32_t components[2][m_maxNbSamplesPerBlock];
+    int32_t values[m_maxNbSamplesPerBlock + 2]; // with two leading zeros for the predictors
+    uint32_t residuals[2][m_maxNbSamplesPerBlock];
+    unsigned int riceParameters[2];
+    unsigned int orders[2];
+    uint32_t bitsOr = 0;
+
+    for (unsigned int n = 0; n < nbSamples; n++)
+    {
+        components[0][n] = samples[2*n];
+        components[1][n] = samples[2*n+1];
+        bitsOr |= (uint32_t) components[0][n] | (uint32_t) components[1][n];
+    }
+
+    unsigned int shift = 0; // start with the trailing zero bits common to all samples (lossless)
+
+    while ((bitsOr != 0) && (((bitsOr >> shift) & 1) == 0)) {
+        shift++;
+    }
+
+    const unsigned int losslessShift = shift;
+    values[0] = 0;
+    values[1] = 0;
+
+    for (;; shift++) // drop more bits until the block fits
+    {
+        const int32_t half = shift == 0 ? 0 : 1 << (shift - 1);
+        uint64_t nbBits = 0;
+
+        for (unsigned int c = 0; c < 2; c++)
+        {
+            for (unsigned int n = 0; n < nbSamples; n++) {
+                values[n+2] = (components[c][n] + half) >> shift; // exact when shift is not more than trailing zeros
+            }
+
+            // choose the predictor: 0: none, 1: previous sample, 2: linear extrapolation of the two previous samples
+
+            int64_t sums[3] = {0, 0, 0};
+
+            for (unsigned int n = 0; n < nbSamples; n++)
+            {
+                int32_t x = values[n+2];
+                int32_t r1 = x - values[n+1];
+                int32_t r2 = x - 2*values[n+1] + values[n];
+                sums[0] += x < 0 ? -x : x;
+                sums[1] += r1 < 0 ? -r1 : r1;
+                sums[2] += r2 < 0 ? -r2 : r2;
+            }
+
+            unsigned int order = sums[1] < sums[0] ? 1 : 0;
+            order = sums[2] < sums[order] ? 2 : order;
+            orders[c] = order;
+            uint32_t *u = residuals[c];
+            uint64_t sum = 0;
+
+            for (unsigned int n = 0; n < nbSamples; n++)
+            {
+                int32_t x = values[n+2];
+                int32_t r = order == 0 ? x : order == 1 ? x - values[n+1] : x - 2*values[n+1] + values[n];
+                u[n] = ((uint32_t) r << 1) ^ (uint32_t) (r >> 31); // zigzag
+                sum += u[n];
+            }
+
+            // Rice parameter around log2 of the mean value with the exact cost
+
+            uint64_t mean = sum / nbSamples;
+            unsigned int k0 = 0;
+
+            while ((mean >> (k0 + 1)) != 0) {
+                k0++;
+            }
+
+            uint64_t bestCost = std::numeric_limits<uint64_t>::max();
+
+            for (unsigned int k = k0 == 0 ? 0 : k0 - 1; k <= std::min(k0 + 1, 30U); k++)
+            {
+                uint64_t cost = 0;
+
+                for (unsigned int n = 0; n < nbSamples; n++)
+                {
+                    uint32_t q = u[n] >> k;
+                    cost += q < m_riceEscape ? q + 1 + k : m_riceEscape + 32;
+                }
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    riceParameters[c] = k;
+                }
+            }
+
+            nbBits += bestCost;
+        }
+
+        if (nbBits <= budget) {
+            break;
+        }
+
+        shift += (nbBits - budget - 1) / (2 * nbSamples); // each dropped bit saves about one bit per component
+    }
+
+    buf[1] = shift;
+    buf[2] = riceParameters[0];
+    buf[3] = riceParameters[1];
+    buf[4] = orders[0] | (orders[1] << 4);
+    buf[5] = 0;
+    RiceBitWriter writer(&buf[m_riceHeaderSize]);
+
+    for (unsigned int c = 0; c < 2; c++)
+    {
+        const unsigned int k = riceParameters[c];
+
+        for (unsigned int n = 0; n < nbSamples; n++)
+        {
+            uint32_t u = residuals[c][n];
+            uint32_t q = u >> k;
+
+            if (q < m_riceEscape)
+            {
+                writer.put((((1ULL << q) - 1) << (k + 1)) | (u & ((1ULL << k) - 1)), q + 1 + k);
+            }
+            else
+            {
+                writer.put((1ULL << m_riceEscape) - 1, m_riceEscape);
+                writer.put(u, 32);
+            }
+        }
+    }
+
+    writer.flush();
+    std::fill(writer.end(), buf + RemoteNbBytesPerBlock, 0);
+
+    return shift - losslessShift;
+}
+
+template<typename T>
+bool RemoteCodec::decodeRice(const uint8_t *buf, unsigned int nbSamples, T *samples)
+{
+    const unsigned int shift = buf[1];
+    const unsigned int riceParameters[2] = {buf[2], buf[3]};
+    const unsigned int orders[2] = {(unsigned int) buf[4] & 0xF, (unsigned int) buf[4] >> 4};
+
+    if ((shift > 31) || (riceParameters[0] > 30) || (riceParameters[1] > 30) || (orders[0] > 2) || (orders[1] > 2)) {
+        return false;
+    }
+
+    const int64_t scale = 1LL << shift;
+    RiceBitReader reader(&buf[m_riceHeaderSize], buf + RemoteNbBytesPerBlock);
+
+    for (unsigned int c = 0; c < 2; c++)
+    {
+        const unsigned int k = riceParameters[c];
+        const unsigned int order = orders[c];
+        uint32_t previous1 = 0; // modulo arithmetic so that corrupted data cannot overflow
+        uint32_t previous2 = 0;
+
+        for (unsigned int n = 0; n < nbSamples; n++)
+        {
+            unsigned int q = 0;
+
+            while ((q < m_riceEscape) && reader.get(1)) {
+                q++;
+            }
+
+            uint32_t u = q < m_riceEscape ? (q << k) | reader.get(k) : reader.get(32);
+            uint32_t r = (u >> 1) ^ (0 - (u & 1));
+            uint32_t x = order == 0 ? r : order == 1 ? r + previous1 : r + 2*previous1 - previous2;
+            previous2 = previous1;
+            previous1 = x;
+            samples[2*n + c] = clampSample<T>((int32_t) x * scale);
+        }
+    }
+
+    return !reader.overrun();
+}
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Sample codecs of the remote sink / remote input protocol                      //
+//                                                                               //
+// Each data block is coded on its own with a fixed number of I/Q samples per    //
+// block for a given codec so that a block restored by FEC or lost altogether    //
+// does not affect its neighbours. The codec of the stream is given in the 4 MSB //
+// of the sample bytes field of the meta data and in the header of each block.   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHANNEL_REMOTECODEC_H_
+#define CHANNEL_REMOTECODEC_H_
+
+#include <stdint.h>
+
+#include "channel/remotedatablock.h"
+#include "export.h"
+
+/**
+ * Block layouts (RemoteProtectedBlock payload):
+ *   - CodecRaw: samples as produced by the device with 2 or 4 bytes per I or Q component
+ *   - CodecBFPn: codec, exponent then the n bits two's complement mantissas packed little endian.
+ *     Samples are restored as mantissa << exponent
+ *   - CodecNearLosslessRice: codec, shift, Rice parameter of I, of Q, predictor orders (4 LSB: I,
+ *     4 MSB: Q), 0 then the Rice coded residuals of all I then all Q components (MSB first).
+ *     Samples are restored as value << shift. The number of samples per block is fixed so the
+ *     coding is near lossless: the shift starts at the number of trailing zero bits common to all
+ *     samples of the block and when the block does not fit least significant bits are dropped
+ *     until it fits. encode returns the number of bits dropped.
+ */
+class SDRBASE_API RemoteCodec
+{
+public:
+    enum Codec
+    {
+        CodecRaw,   //!< no compression
+        CodecBFP8,  //!< block floating point with 8 bits mantissas (251 samples per block)
+        CodecBFP10, //!< block floating point with 10 bits mantissas (200 samples per block)
+        CodecBFP12, //!< block floating point with 12 bits mantissas (167 samples per block)
+        CodecNearLosslessRice, //!< prediction and Rice coding (168 or 126 samples per block for 2 or 4 bytes samples)
+        CodecEnd
+    };
+
+    static const unsigned int m_maxNbSamplesPerBlock = 251;
+
+    /** Number of I/Q samples per data block. sampleBytes is the size of I or Q components (2 or 4) */
+    static unsigned int getNbSamplesPerBlock(Codec codec, unsigned int sampleBytes);
+    static bool isValid(unsigned int codec) { return codec < CodecEnd; }
+
+    /**
+     * Code getNbSamplesPerBlock(codec, sampleBytes) I/Q samples of interleaved I and Q components into the block.
+     * Returns the number of least significant bits dropped by CodecNearLosslessRice to fit the block (0 for the other codecs)
+     */
+    static unsigned int encode(Codec codec, const void *samples, unsigned int sampleBytes, RemoteProtectedBlock& block);
+
+    /** Decode the samples of a block. Returns false if the block was not coded with this codec or is corrupted */
+    static bool decode(Codec codec, const RemoteProtectedBlock& block, unsigned int sampleBytes, void *samples);
+
+private:
+    static const unsigned int m_riceHeaderSize = 6;
+    static const unsigned int m_riceEscape = 24; //!< Rice quotient from which the value is written in 32 bits
+
+    static unsigned int getBFPBits(Codec codec) { return codec == CodecBFP8 ? 8 : codec == CodecBFP10 ? 10 : 12; }
+
+    template<typename T>
+    static void encodeBFP(const T *samples, unsigned int nbSamples, unsigned int bits, uint8_t *buf);
+    template<typename T>
+    static void decodeBFP(const uint8_t *buf, unsigned int nbSamples, unsigned int bits, T *samples);
+    template<typename T>
+    static unsigned int encodeRice(const T *samples, unsigned int nbSamples, uint8_t *buf);
+    template<typename T>
+    static bool decodeRice(const uint8_t *buf, unsigned int nbSamples, T *samples);
+};
+
+#endif /* CHANNEL_REMOTECODEC_H_ */
@@ -40,7 +40,7 @@ struct RemoteMetaDataFEC
 {
     uint64_t m_centerFrequency;   //!<  8 center frequency in kHz
     uint32_t m_sampleRate;        //!< 12 sample rate in Hz
-    uint8_t  m_sampleBytes;       //!< 13 4 LSB: number of bytes per sample (2 or 4)
+    uint8_t  m_sampleBytes;       //!< 13 4 LSB: number of bytes per sample (2 or 4) 4 MSB: sample codec (RemoteCodec::Codec)
     uint8_t  m_sampleBits;        //!< 14 number of effective bits per sample (deprecated)
     uint8_t  m_nbOriginalBlocks;  //!< 15 number of blocks with original (protected) data
     uint8_t  m_nbFECBlocks;       //!< 16 number of blocks carrying FEC
@@ -72,6 +72,9 @@ struct RemoteMetaDataFEC
         m_tv_usec = 0;
         m_crc32 = 0;
     }
+
+    uint8_t getSampleBytes() const { return m_sampleBytes & 0xF; }
+    uint8_t getCodec() const { return m_sampleBytes >> 4; }
 };
 
 struct RemoteHeader
@@ -80,7 +83,7 @@ struct RemoteHeader
     uint8_t  m_blockIndex;
     uint8_t  m_sampleBytes; //!<  number of bytes per sample (2 or 4) for this block
     uint8_t  m_sampleBits;  //!<  number of bits per sample
-    uint8_t  m_filler;
+    uint8_t  m_codec;       //!<  sample codec (RemoteCodec::Codec) for this block
     uint16_t m_filler2;
 
     void init()
@@ -89,7 +92,7 @@ struct RemoteHeader
         m_blockIndex = 0;
         m_sampleBytes = 2;
         m_sampleBits = 16;
-        m_filler = 0;
+        m_codec = 0;
         m_filler2 = 0;
     }
 };
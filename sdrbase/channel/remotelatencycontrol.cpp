@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#include <QDebug>
+
+#include "remotelatencycontrol.h"
+
+RemoteLatencyControl::RemoteLatencyControl() :
+    m_targetLatencyMs(0),
+    m_effectiveTargetMs(0.0f),
+    m_latencyMs(0.0f),
+    m_jitterUs(0.0f),
+    m_jitterPeakUs(0.0f),
+    m_rateCorrection(0.0),
+    m_rateIntegral(0.0),
+    m_resync(false),
+    m_lastTransitUs(0),
+    m_lastTransitValid(false)
+{}
+
+void RemoteLatencyControl::setTargetLatency(unsigned int targetLatencyMs)
+{
+    m_targetLatencyMs = targetLatencyMs;
+    m_rateCorrection = 0.0;
+    m_rateIntegral = 0.0;
+    m_resync = targetLatencyMs != 0;
+}
+
+void RemoteLatencyControl::restart()
+{
+    m_rateCorrection = 0.0;
+    m_rateIntegral = 0.0;
+    m_lastTransitValid = false;
+    m_resync = m_targetLatencyMs != 0; // read position is set when the first frame is complete
+}
+
+void RemoteLatencyControl::updateJitter(int64_t transitUs)
+{
+    if (m_lastTransitValid) {
+        m_jitterUs += (std::abs((float) (transitUs - m_lastTransitUs)) - m_jitterUs) / 16.0f;
+    }
+
+    m_lastTransitUs = transitUs;
+    m_lastTransitValid = true;
+}
+
+bool RemoteLatencyControl::update(double dt, float latencyMs, float frameMs)
+{
+    if (m_jitterUs > m_jitterPeakUs) {
+        m_jitterPeakUs = m_jitterUs;
+    } else {
+        m_jitterPeakUs += (float) ((dt / (dt + m_jitterPeakTimeConstant)) * (m_jitterUs - m_jitterPeakUs));
+    }
+
+    m_effectiveTargetMs = std::max((float) m_targetLatencyMs, frameMs + m_readPeriodMs + m_jitterMargin * (m_jitterPeakUs / 1000.0f));
+
+    if (m_targetLatencyMs == 0)
+    {
+        m_latencyMs = latencyMs;
+        return false;
+    }
+
+    // underrun or drift too far from the target, for example after a network outage
+    if (m_resync || (latencyMs < 0.0f) || (latencyMs > 2.0f * m_effectiveTargetMs + frameMs))
+    {
+        if (!m_resync) {
+            qDebug("RemoteLatencyControl::update: resync: latency %.1f ms target %.1f ms", latencyMs, m_effectiveTargetMs);
+        }
+
+        return true;
+    }
+
+    // latency drift is corrected by the read rate with a PI controller on the smoothed latency
+    m_latencyMs += (float) ((dt / (dt + m_latencyTimeConstant)) * (latencyMs - m_latencyMs));
+    double error = (m_latencyMs - m_effectiveTargetMs) / 1000.0;
+    m_rateIntegral += m_rateKi * error * dt;
+
+    if (m_rateIntegral > m_maxRateIntegral) {
+        m_rateIntegral = m_maxRateIntegral;
+    } else if (m_rateIntegral < -m_maxRateIntegral) {
+        m_rateIntegral = -m_maxRateIntegral;
+    }
+
+    m_rateCorrection = m_rateKp * error + m_rateIntegral;
+
+    if (m_rateCorrection > m_maxRateCorrection) {
+        m_rateCorrection = m_maxRateCorrection;
+    } else if (m_rateCorrection < -m_maxRateCorrection) {
+        m_rateCorrection = -m_maxRateCorrection;
+    }
+
+    return false;
+}
+
+void RemoteLatencyControl::resynced(float latencyMs)
+{
+    m_latencyMs = latencyMs;
+    m_resync = false;
+}
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Remote input latency control                                                  //
+//                                                                               //
+// The duration of the samples buffered when a frame is complete is held at a    //
+// target by correcting the read rate with a PI controller. The target is raised //
+// to the frame duration plus the read period plus a margin of jitter peaks. The //
+// frames arrival jitter is estimated from the sender timestamps as in RFC 3550  //
+// so that the clocks need not be synchronized.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHANNEL_REMOTELATENCYCONTROL_H_
+#define CHANNEL_REMOTELATENCYCONTROL_H_
+
+#include <stdint.h>
+
+#include "export.h"
+
+class SDRBASE_API RemoteLatencyControl
+{
+public:
+    RemoteLatencyControl();
+
+    void setTargetLatency(unsigned int targetLatencyMs); //!< 0 to disable latency targeting. Resets the controller
+    unsigned int getTargetLatency() const { return m_targetLatencyMs; }
+    void restart();                       //!< New stream: resets the controller and the jitter reference
+    void updateJitter(int64_t transitUs); //!< Arrival time minus sender timestamp of a frame with meta data
+
+    /**
+     * Update on frame completion dt seconds after the previous one with the latency measured and the frame duration.
+     * Returns true if the read position is to be set at the effective target. The resulting latency is then given
+     * back with resynced().
+     */
+    bool update(double dt, float latencyMs, float frameMs);
+    void resynced(float latencyMs);
+
+    float getEffectiveTargetMs() const { return m_effectiveTargetMs; } //!< Target raised to what the frame size and jitter peak allow
+    float getLatencyMs() const { return m_latencyMs; }                 //!< Smoothed latency
+    float getJitterMs() const { return m_jitterUs / 1000.0f; }
+    double getRateCorrection() const { return m_rateCorrection; }      //!< Relative read rate correction
+
+    static const int m_readPeriodMs = 50;              //!< Approximate period of the reads
+    static constexpr double m_maxRateCorrection = 2e-3;
+
+private:
+    unsigned int m_targetLatencyMs; //!< 0 if not targeting latency
+    float m_effectiveTargetMs;
+    float m_latencyMs;
+    float m_jitterUs;               //!< Interarrival jitter estimate (RFC 3550)
+    float m_jitterPeakUs;           //!< Jitter peak with slow decay for the latency margin
+    double m_rateCorrection;
+    double m_rateIntegral;          //!< Integral term of the read rate correction
+    bool m_resync;                  //!< Place the read position at the target on next update
+    int64_t m_lastTransitUs;
+    bool m_lastTransitValid;
+
+    static constexpr double m_latencyTimeConstant = 1.0;     //!< Smoothing of the latency measurements (s)
+    static constexpr double m_jitterPeakTimeConstant = 30.0; //!< Decay of the jitter peak (s)
+    static constexpr float m_jitterMargin = 6.0f;            //!< Latency margin in number of jitter peaks
+    static constexpr double m_rateKp = 0.02;                 //!< Proportional gain (relative rate per second of latency error)
+    static constexpr double m_rateKi = 0.0001;               //!< Integral gain. Critically damped loop for the smoothed latency
+    static constexpr double m_maxRateIntegral = 1.5e-3;
+};
+
+#endif // CHANNEL_REMOTELATENCYCONTROL_H_
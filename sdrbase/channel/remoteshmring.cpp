@@ -0,0 +1,372 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <algorithm>
+#include <new>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include <QDebug>
+
+#include "util/timeutil.h"
+#include "remoteshmring.h"
+
+#if defined(__linux__)
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "32 bit atomics must be lock free to be shared between processes");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64 bit atomics must be lock free to be shared between processes");
+#endif
+
+struct RemoteShmRing::Header
+{
+    static const uint32_t m_magicValue = 0x52534453; // "SDSR"
+    static const uint32_t m_versionValue = 1;
+
+    std::atomic<uint32_t> m_magic;          //!< Set last when the segment is initialized
+    uint32_t m_version;
+    uint32_t m_capacity;
+    uint32_t m_headerSize;
+    std::atomic<uint32_t> m_closed;         //!< Writer has left
+    std::atomic<uint32_t> m_metaSeq;        //!< Meta data sequence number. Odd while it is being written
+    RemoteMetaDataFEC m_meta;
+    alignas(64) std::atomic<uint64_t> m_writeCount;   //!< Bytes written and readable
+    std::atomic<uint64_t> m_writeReserve;   //!< Bytes written or being written. Data older than this minus capacity is lost
+    std::atomic<uint64_t> m_writeTimeUs;
+    alignas(64) std::atomic<uint32_t> m_wakeSeq;      //!< Futex word incremented on each write
+    std::atomic<uint32_t> m_nbWaiters;      //!< Readers sleeping on the futex
+};
+
+RemoteShmRing::RemoteShmRing() :
+    m_writer(false),
+    m_fd(-1),
+    m_header(nullptr),
+    m_data(nullptr),
+    m_mapSize(0),
+    m_capacity(0)
+{}
+
+RemoteShmRing::~RemoteShmRing()
+{
+    close();
+}
+
+bool RemoteShmRing::create(const QString& name, unsigned int capacity)
+{
+#if defined(__linux__)
+    close();
+
+    if (name.isEmpty() || name.contains('/'))
+    {
+        qWarning("RemoteShmRing::create: invalid name %s", name.toStdString().c_str());
+        return false;
+    }
+
+    std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    capacity = ((capacity + pageSize - 1) / pageSize) * pageSize;
+    std::string shmName = "/" + name.toStdString();
+    shm_unlink(shmName.c_str()); // readers of a previous segment keep it until they detach
+    m_fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+
+    if (m_fd < 0)
+    {
+        qWarning("RemoteShmRing::create: cannot create %s: %s", shmName.c_str(), strerror(errno));
+        return false;
+    }
+
+    if ((ftruncate(m_fd, pageSize + capacity) < 0) || !map(capacity, true))
+    {
+        qWarning("RemoteShmRing::create: cannot size or map %s: %s", shmName.c_str(), strerror(errno));
+        ::close(m_fd);
+        m_fd = -1;
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    new (m_header) Header();
+    m_header->m_version = Header::m_versionValue;
+    m_header->m_capacity = capacity;
+    m_header->m_headerSize = pageSize;
+    m_header->m_closed = 0;
+    m_header->m_metaSeq = 0;
+    m_header->m_meta.init();
+    m_header->m_writeCount = 0;
+    m_header->m_writeReserve = 0;
+    m_header->m_writeTimeUs = 0;
+    m_header->m_wakeSeq = 0;
+    m_header->m_nbWaiters = 0;
+    m_header->m_magic.store(Header::m_magicValue);
+    m_name = name;
+    m_writer = true;
+    qDebug("RemoteShmRing::create: %s with %u bytes", shmName.c_str(), capacity);
+    return true;
+#else
+    (void) name;
+    (void) capacity;
+    return false;
+#endif
+}
+
+bool RemoteShmRing::attach(const QString& name)
+{
+#if defined(__linux__)
+    close();
+
+    if (name.isEmpty() || name.contains('/')) {
+        return false;
+    }
+
+    std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    std::string shmName = "/" + name.toStdString();
+    m_fd = shm_open(shmName.c_str(), O_RDWR, 0); // the header is written to register the waiting readers
+    struct stat st;
+
+    if (m_fd < 0) {
+        return false;
+    }
+
+    if ((fstat(m_fd, &st) < 0) || (st.st_size <= (off_t) pageSize) || !map(st.st_size - pageSize, false))
+    {
+        ::close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    if ((m_header->m_magic.load() != Header::m_magicValue)
+     || (m_header->m_version != Header::m_versionValue)
+     || (m_header->m_capacity != m_capacity))
+    {
+        qWarning("RemoteShmRing::attach: %s is not a samples ring or is not initialized", shmName.c_str());
+        close();
+        return false;
+    }
+
+    m_name = name;
+    m_writer = false;
+    qDebug("RemoteShmRing::attach: %s with %u bytes", shmName.c_str(), m_capacity);
+    return true;
+#else
+    (void) name;
+    return false;
+#endif
+}
+
+bool RemoteShmRing::map(unsigned int capacity, bool writable)
+{
+#if defined(__linux__)
+    std::size_t pageSize = sysconf(_SC_PAGESIZE);
+    std::size_t mapSize = pageSize + 2*(std::size_t) capacity;
+    int dataProt = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+
+    // reserve the address range then map the header and the ring twice in it
+    uint8_t *base = (uint8_t *) mmap(nullptr, mapSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (base == MAP_FAILED) {
+        return false;
+    }
+
+    if ((mmap(base, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, m_fd, 0) == MAP_FAILED)
+     || (mmap(base + pageSize, capacity, dataProt, MAP_SHARED | MAP_FIXED, m_fd, pageSize) == MAP_FAILED)
+     || (mmap(base + pageSize + capacity, capacity, dataProt, MAP_SHARED | MAP_FIXED, m_fd, pageSize) == MAP_FAILED))
+    {
+        munmap(base, mapSize);
+        return false;
+    }
+
+    m_header = (Header *) base;
+    m_data = base + pageSize;
+    m_mapSize = mapSize;
+    m_capacity = capacity;
+    return true;
+#else
+    (void) capacity;
+    (void) writable;
+    return false;
+#endif
+}
+
+void RemoteShmRing::close()
+{
+#if defined(__linux__)
+    if (!m_header) {
+        return;
+    }
+
+    if (m_writer)
+    {
+        m_header->m_closed.store(1);
+        m_header->m_wakeSeq.fetch_add(1);
+        syscall(SYS_futex, (uint32_t *) &m_header->m_wakeSeq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        shm_unlink(("/" + m_name.toStdString()).c_str());
+    }
+
+    munmap((void *) m_header, m_mapSize);
+    ::close(m_fd);
+    m_fd = -1;
+    m_header = nullptr;
+    m_data = nullptr;
+    m_writer = false;
+#endif
+}
+
+void RemoteShmRing::setMeta(const RemoteMetaDataFEC& metaData)
+{
+    uint32_t seq = m_header->m_metaSeq.load(std::memory_order_relaxed);
+    m_header->m_metaSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy((void *) &m_header->m_meta, (const void *) &metaData, sizeof(RemoteMetaDataFEC));
+    m_header->m_metaSeq.store(seq + 2, std::memory_order_release);
+}
+
+void RemoteShmRing::write(const void *data, unsigned int length)
+{
+#if defined(__linux__)
+    length = std::min(length, m_capacity);
+    uint64_t writeCount = m_header->m_writeCount.load(std::memory_order_relaxed);
+
+    // readers detect the data overwritten from here
+    m_header->m_writeReserve.store(writeCount + length, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&m_data[writeCount % m_capacity], data, length);
+    m_header->m_writeTimeUs.store(TimeUtil::nowus(), std::memory_order_relaxed);
+    m_header->m_writeCount.store(writeCount + length);
+    m_header->m_wakeSeq.fetch_add(1);
+
+    if (m_header->m_nbWaiters.load() != 0) { // avoid the system call when nobody sleeps
+        syscall(SYS_futex, (uint32_t *) &m_header->m_wakeSeq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+#else
+    (void) data;
+    (void) length;
+#endif
+}
+
+bool RemoteShmRing::isClosed() const
+{
+    return m_header->m_closed.load() != 0;
+}
+
+uint64_t RemoteShmRing::getWriteCount() const
+{
+    return m_header->m_writeCount.load();
+}
+
+uint64_t RemoteShmRing::getWriteTimeUs() const
+{
+    return m_header->m_writeTimeUs.load(std::memory_order_relaxed);
+}
+
+bool RemoteShmRing::wait(uint64_t readCount, int timeoutMs)
+{
+#if defined(__linux__)
+    struct timespec now, deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (true)
+    {
+        // the sequence is read before the data count so that a write in between makes the futex wait return at once
+        uint32_t seq = m_header->m_wakeSeq.load();
+
+        if ((m_header->m_writeCount.load() != readCount) || isClosed()) {
+            return true;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        struct timespec timeout;
+        timeout.tv_sec = deadline.tv_sec - now.tv_sec;
+        timeout.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+
+        if (timeout.tv_nsec < 0)
+        {
+            timeout.tv_sec--;
+            timeout.tv_nsec += 1000000000L;
+        }
+
+        if (timeout.tv_sec < 0) {
+            return false;
+        }
+
+        // spurious returns (sequence moved by a write already read, signals) loop until the deadline
+        m_header->m_nbWaiters.fetch_add(1);
+        syscall(SYS_futex, (uint32_t *) &m_header->m_wakeSeq, FUTEX_WAIT, seq, &timeout, nullptr, 0);
+        m_header->m_nbWaiters.fetch_sub(1);
+    }
+#else
+    (void) readCount;
+    (void) timeoutMs;
+    return false;
+#endif
+}
+
+const uint8_t *RemoteShmRing::read(uint64_t& readCount, unsigned int maxLength, unsigned int& length, uint64_t& lost)
+{
+    uint64_t writeCount = m_header->m_writeCount.load(std::memory_order_acquire);
+    uint64_t writeReserve = m_header->m_writeReserve.load(std::memory_order_acquire);
+    uint64_t oldest = writeReserve > m_capacity ? writeReserve - m_capacity : 0;
+    lost = 0;
+
+    if (readCount > writeCount) { // segment was created again
+        readCount = writeCount;
+    }
+
+    if (readCount < oldest)
+    {
+        lost = oldest - readCount;
+        readCount = oldest;
+    }
+
+    length = (unsigned int) std::min(writeCount - readCount, (uint64_t) maxLength);
+    return &m_data[readCount % m_capacity];
+}
+
+bool RemoteShmRing::isValid(uint64_t readCount) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return m_header->m_writeReserve.load(std::memory_order_relaxed) <= readCount + m_capacity;
+}
+
+uint32_t RemoteShmRing::getMeta(RemoteMetaDataFEC& metaData) const
+{
+    uint32_t seq1, seq2;
+
+    do
+    {
+        seq1 = m_header->m_metaSeq.load(std::memory_order_acquire);
+        std::memcpy((void *) &metaData, (const void *) &m_header->m_meta, sizeof(RemoteMetaDataFEC));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = m_header->m_metaSeq.load(std::memory_order_relaxed);
+    } while ((seq1 & 1) || (seq1 != seq2));
+
+    return seq1;
+}
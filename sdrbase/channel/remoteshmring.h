@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Shared memory samples ring between SDRangel instances of the same host        //
+//                                                                               //
+// A POSIX shared memory segment holds a header with the meta data of the        //
+// stream and a ring of I/Q samples. There is a single writer (Remote Sink) and  //
+// any number of readers (Remote Input) that attach to the segment by name.      //
+// Readers do not register: each one keeps its own read position and gets the   //
+// samples in place. The ring is mapped twice contiguously so that any span of   //
+// up to the ring size is contiguous. The writer never waits for the readers: a  //
+// reader that falls behind by more than the ring size loses samples and is      //
+// told so. Readers sleep on a futex that the writer wakes only when readers are //
+// waiting. Linux only: create and attach return false on other systems.         //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHANNEL_REMOTESHMRING_H_
+#define CHANNEL_REMOTESHMRING_H_
+
+#include <stdint.h>
+#include <atomic>
+
+#include <QString>
+
+#include "channel/remotedatablock.h"
+#include "export.h"
+
+class SDRBASE_API RemoteShmRing
+{
+public:
+    static const unsigned int m_defaultCapacity = 64*1024*1024; //!< Ring size in bytes
+
+    RemoteShmRing();
+    ~RemoteShmRing();
+
+    /** Writer: create the segment replacing any segment of the same name. Capacity is rounded up to pages */
+    bool create(const QString& name, unsigned int capacity = m_defaultCapacity);
+    /** Reader: attach to the segment created by a writer */
+    bool attach(const QString& name);
+    /** Detach. The writer marks the segment closed for the readers and removes its name */
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    bool isWriter() const { return m_writer; }
+    unsigned int getCapacity() const { return m_capacity; }
+
+    // writer
+
+    /** Publish the meta data of the samples written next. Readers see it with getMeta */
+    void setMeta(const RemoteMetaDataFEC& metaData);
+    /** Append length bytes (at most the capacity) to the ring and wake up the waiting readers */
+    void write(const void *data, unsigned int length);
+
+    // reader
+
+    /** True if the writer closed the segment. The reader should close and attach again */
+    bool isClosed() const;
+    /** Number of bytes written since the segment was created. Start reading from there to get only new samples */
+    uint64_t getWriteCount() const;
+    /** Wait until data is written beyond readCount or timeoutMs elapse. Returns true if data is available */
+    bool wait(uint64_t readCount, int timeoutMs);
+    /**
+     * Samples from readCount in place. Returns the number of contiguous bytes available from the returned
+     * pointer (at most maxLength). If the writer overtook the reader, readCount is moved forward to the oldest
+     * valid data and the number of bytes skipped is returned in lost.
+     */
+    const uint8_t *read(uint64_t& readCount, unsigned int maxLength, unsigned int& length, uint64_t& lost);
+    /** True if the bytes from readCount returned by read were not overwritten while being used */
+    bool isValid(uint64_t readCount) const;
+    /** Latest meta data. Returns its sequence number that changes each time it is published */
+    uint32_t getMeta(RemoteMetaDataFEC& metaData) const;
+    uint64_t getWriteTimeUs() const; //!< Time of the last write in microseconds since epoch
+
+private:
+    struct Header;
+
+    QString m_name;
+    bool m_writer;
+    int m_fd;
+    Header *m_header;
+    uint8_t *m_data;          //!< Ring mapped twice
+    std::size_t m_mapSize;    //!< Size of the whole mapping
+    unsigned int m_capacity;
+
+    bool map(unsigned int capacity, bool writable);
+};
+
+#endif /* CHANNEL_REMOTESHMRING_H_ */
@@ -15,6 +15,11 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
+#include "SWGDeviceRecord.h"
+#include "SWGFileRecordReport.h"
+
 #include "plugin/plugininstancegui.h"
 #include "plugin/plugininterface.h"
 #include "dsp/dspdevicesourceengine.h"
@@ -24,6 +29,7 @@
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/devicesamplemimo.h"
+#include "dsp/filerecord.h"
 #include "settings/preset.h"
 #include "channel/channelapi.h"
 
@@ -50,7 +56,8 @@ DeviceAPI::DeviceAPI(
     m_isBuddyLeader(false),
     m_deviceSourceEngine(deviceSourceEngine),
     m_deviceSinkEngine(deviceSinkEngine),
-    m_deviceMIMOEngine(deviceMIMOEngine)
+    m_deviceMIMOEngine(deviceMIMOEngine),
+    m_fileRecordSigMF(false)
 {
 }
 
@@ -67,6 +74,18 @@ void DeviceAPI::addAncillarySink(BasebandSampleSink *sink, unsigned int index)
     } else if (m_deviceMIMOEngine) {
         m_deviceMIMOEngine->addAncillarySink(sink, index);
     }
+
+    FileRecord *fileRecord = dynamic_cast<FileRecord*>(sink);
+
+    if (fileRecord)
+    {
+        fileRecord->setWriterSettings(m_fileRecordWriterSettings);
+        fileRecord->setCompressorSettings(m_fileRecordCompressorSettings);
+        fileRecord->setSigMF(m_fileRecordSigMF);
+        fileRecord->setTriggerSettings(m_fileRecordTriggerSettings);
+        fileRecord->setSegmentSettings(m_fileRecordSegmentSettings);
+        m_fileRecords.push_back(std::pair<FileRecord*, unsigned int>(fileRecord, index));
+    }
 }
 
 void DeviceAPI::removeAncillarySink(BasebandSampleSink* sink, unsigned int index)
@@ -78,6 +97,155 @@ void DeviceAPI::removeAncillarySink(BasebandSampleSink* sink, unsigned int index
     } else if (m_deviceMIMOEngine) {
         m_deviceMIMOEngine->removeAncillarySink(sink, index);
     }
+
+    m_fileRecords.erase(
+        std::remove_if(m_fileRecords.begin(), m_fileRecords.end(), [sink](const std::pair<FileRecord*, unsigned int>& p) {
+            return (BasebandSampleSink*) p.first == sink;
+        }),
+        m_fileRecords.end()
+    );
+}
+
+int DeviceAPI::webapiRecordGet(SWGSDRangel::SWGDeviceRecord& response, QString& errorMessage) const
+{
+    (void) errorMessage;
+    const FileRecordWriter::Settings& settings = m_fileRecordWriterSettings;
+    response.setBufferSizeMb(settings.m_bufferSizeMB);
+    response.setBlockSizeKb(settings.m_blockSizeKB);
+    response.setDirectIo(settings.m_directIO ? 1 : 0);
+    response.setPreallocateMb(settings.m_preallocateMB);
+    response.setCompression(m_fileRecordCompressorSettings.m_enable ? 1 : 0);
+    response.setCompressionThreads(m_fileRecordCompressorSettings.m_nbThreads);
+    response.setChunkSamples(m_fileRecordCompressorSettings.m_chunkSamples);
+    response.setSigMf(m_fileRecordSigMF ? 1 : 0);
+    response.setTriggered(m_fileRecordTriggerSettings.m_enable ? 1 : 0);
+    response.setPreTriggerTime(m_fileRecordTriggerSettings.m_preTriggerTime);
+    response.setHangTime(m_fileRecordTriggerSettings.m_hangTime);
+    response.setLevelTrigger(m_fileRecordTriggerSettings.m_levelTrigger ? 1 : 0);
+    response.setTriggerLevel(m_fileRecordTriggerSettings.m_levelDB);
+    response.setSegmentTime(m_fileRecordSegmentSettings.m_segmentTime);
+    response.setSegmentSizeMb(m_fileRecordSegmentSettings.m_segmentSizeMB);
+    response.setQuotaMb(m_fileRecordSegmentSettings.m_quotaMB);
+
+    if (!response.getRecorders()) {
+        response.setRecorders(new QList<SWGSDRangel::SWGFileRecordReport*>());
+    }
+
+    for (const auto& fileRecord : m_fileRecords)
+    {
+        response.getRecorders()->append(new SWGSDRangel::SWGFileRecordReport);
+        response.getRecorders()->back()->init();
+        fileRecord.first->webapiFormatReport(*response.getRecorders()->back());
+        response.getRecorders()->back()->setStreamIndex(fileRecord.second);
+    }
+
+    return 200;
+}
+
+int DeviceAPI::webapiRecordPut(SWGSDRangel::SWGDeviceRecord& response, QString& errorMessage)
+{
+    FileRecordWriter::Settings settings;
+    settings.m_bufferSizeMB = response.getBufferSizeMb() > 0 ? response.getBufferSizeMb() : settings.m_bufferSizeMB;
+    settings.m_blockSizeKB = response.getBlockSizeKb() > 0 ? response.getBlockSizeKb() : settings.m_blockSizeKB;
+    settings.m_directIO = response.getDirectIo() != 0;
+    settings.m_preallocateMB = response.getPreallocateMb() > 0 ? response.getPreallocateMb() : 0;
+    FileRecordCompressor::Settings compressorSettings;
+    compressorSettings.m_enable = response.getCompression() != 0;
+    compressorSettings.m_nbThreads = response.getCompressionThreads() > 0 ? response.getCompressionThreads() : compressorSettings.m_nbThreads;
+    compressorSettings.m_chunkSamples = response.getChunkSamples() > 0 ? response.getChunkSamples() : compressorSettings.m_chunkSamples;
+
+    FileRecord::TriggerSettings triggerSettings;
+    triggerSettings.m_enable = response.getTriggered() != 0;
+    triggerSettings.m_preTriggerTime = response.getPreTriggerTime();
+    triggerSettings.m_hangTime = response.getHangTime();
+    triggerSettings.m_levelTrigger = response.getLevelTrigger() != 0;
+    triggerSettings.m_levelDB = response.getTriggerLevel();
+
+    FileRecord::SegmentSettings segmentSettings;
+    segmentSettings.m_segmentTime = response.getSegmentTime() > 0 ? response.getSegmentTime() : 0;
+    segmentSettings.m_segmentSizeMB = response.getSegmentSizeMb() > 0 ? response.getSegmentSizeMb() : 0;
+    segmentSettings.m_quotaMB = response.getQuotaMb() > 0 ? response.getQuotaMb() : 0;
+
+    if ((settings.m_blockSizeKB * 2 > settings.m_bufferSizeMB * 1024) || (settings.m_bufferSizeMB > 4096))
+    {
+        errorMessage = QString("Buffer must hold at least two blocks and be at most 4096 MB");
+        return 400;
+    }
+
+    if ((compressorSettings.m_nbThreads > 64) || (compressorSettings.m_chunkSamples < 1024) || (compressorSettings.m_chunkSamples > (1U<<22)))
+    {
+        errorMessage = QString("Compression threads must be at most 64 and chunk samples between 1024 and 4194304");
+        return 400;
+    }
+
+    if (triggerSettings.m_enable
+     && ((triggerSettings.m_preTriggerTime < 0.0f) || (triggerSettings.m_preTriggerTime > 60.0f) || (triggerSettings.m_hangTime < 0.0f)))
+    {
+        errorMessage = QString("Pre-trigger time must be between 0 and 60 s and hang time positive");
+        return 400;
+    }
+
+    if (segmentSettings.isEnabled() && (segmentSettings.m_quotaMB > 0)
+     && (segmentSettings.m_segmentSizeMB > 0) && (segmentSettings.m_quotaMB < segmentSettings.m_segmentSizeMB))
+    {
+        errorMessage = QString("Quota must be at least the size of a segment");
+        return 400;
+    }
+
+    if (segmentSettings.isEnabled() && ((response.getSigMf() != 0) || compressorSettings.m_enable || triggerSettings.m_enable))
+    {
+        errorMessage = QString("Rolling recording applies to plain .sdriq recordings only (not compressed, SigMF nor triggered)");
+        return 400;
+    }
+
+    // settings are only changed once they are all valid
+    m_fileRecordWriterSettings = settings;
+    m_fileRecordCompressorSettings = compressorSettings;
+    m_fileRecordSigMF = response.getSigMf() != 0;
+    m_fileRecordTriggerSettings = triggerSettings;
+    m_fileRecordSegmentSettings = segmentSettings;
+
+    for (const auto& fileRecord : m_fileRecords)
+    {
+        fileRecord.first->setWriterSettings(settings);
+        fileRecord.first->setCompressorSettings(compressorSettings);
+        fileRecord.first->setSigMF(m_fileRecordSigMF);
+        fileRecord.first->setTriggerSettings(triggerSettings);
+        fileRecord.first->setSegmentSettings(segmentSettings);
+    }
+
+    if (response.getRecorders())
+    {
+        for (auto report : *response.getRecorders()) {
+            delete report;
+        }
+
+        response.getRecorders()->clear(); // read only
+    }
+
+    return webapiRecordGet(response, errorMessage);
+}
+
+int DeviceAPI::webapiRecordPost(QString& errorMessage)
+{
+    int nbArmed = 0;
+
+    for (const auto& fileRecord : m_fileRecords)
+    {
+        if (fileRecord.first->isArmed())
+        {
+            fileRecord.first->trigger();
+            nbArmed++;
+        }
+    }
+
+    if (nbArmed == 0)
+    {
+        errorMessage = QString("No recorder is armed in triggered mode");
+        return 400;
+    }
+
+    return 202;
 }
 
 void DeviceAPI::setSpectrumSinkInput(bool sourceElseSink, unsigned int index)
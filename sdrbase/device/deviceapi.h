@@ -18,13 +18,19 @@
 #ifndef SDRBASE_DEVICE_DEVICEAPI_H_
 #define SDRBASE_DEVICE_DEVICEAPI_H_
 
+#include <vector>
+
 #include <QObject>
 #include <QString>
 #include <QTimer>
 
+#include "dsp/filerecord.h"
+#include "dsp/filerecordcompressor.h"
+#include "dsp/filerecordwriter.h"
 #include "export.h"
 
 class BasebandSampleSink;
+class FileRecord;
 class BasebandSampleSource;
 class MIMOChannel;
 class ChannelAPI;
@@ -39,6 +45,11 @@ class DSPDeviceSinkEngine;
 class DSPDeviceMIMOEngine;
 class Preset;
 
+namespace SWGSDRangel
+{
+    class SWGDeviceRecord;
+}
+
 class SDRBASE_API DeviceAPI : public QObject {
     Q_OBJECT
 public:
@@ -69,6 +80,10 @@ public:
     void addAncillarySink(BasebandSampleSink* sink, unsigned int index = 0);       //!< Adds a sink to receive full baseband and that is not a channel (e.g. spectrum)
     void removeAncillarySink(BasebandSampleSink* sink, unsigned int index = 0);    //!< Removes it
     void setSpectrumSinkInput(bool sourceElseSink = true, unsigned int index = 0); //!< Used in the MIMO case to select which stream is used as input to main spectrum
+    const std::vector<std::pair<FileRecord*, unsigned int>>& getFileRecords() const { return m_fileRecords; } //!< I/Q recorders among ancillary sinks with their stream index
+    int webapiRecordGet(SWGSDRangel::SWGDeviceRecord& response, QString& errorMessage) const;
+    int webapiRecordPut(SWGSDRangel::SWGDeviceRecord& response, QString& errorMessage);
+    int webapiRecordPost(QString& errorMessage); //!< triggers the armed recorders
 
     void addChannelSink(BasebandSampleSink* sink, int streamIndex = 0);                //!< Add a channel sink (Rx)
     void removeChannelSink(BasebandSampleSink* sink, int streamIndex = 0);             //!< Remove a channel sink (Rx)
@@ -214,6 +229,13 @@ protected:
     QList<ChannelAPI*> m_mimoChannelAPIs;
 
 private:
+    std::vector<std::pair<FileRecord*, unsigned int>> m_fileRecords;
+    FileRecordWriter::Settings m_fileRecordWriterSettings;         //!< applied to recorders as they are added
+    FileRecordCompressor::Settings m_fileRecordCompressorSettings; //!< applied to recorders as they are added
+    bool m_fileRecordSigMF;                                        //!< applied to recorders as they are added
+    FileRecord::TriggerSettings m_fileRecordTriggerSettings;       //!< applied to recorders as they are added
+    FileRecord::SegmentSettings m_fileRecordSegmentSettings;       //!< applied to recorders as they are added
+
     void renumerateChannels();
 };
 #endif // SDRBASE_DEVICE_DEVICEAPI_H_
\ No newline at end of file
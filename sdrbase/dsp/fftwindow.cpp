@@ -36,6 +36,21 @@ void FFTWindow::setKaiserBeta(Real beta)
 	m_kaiserI0Alpha = zeroethOrderBessel(m_kaiserAlpha);
 }
 
+Real FFTWindow::getPower() const
+{
+	if (m_window.size() == 0) {
+		return 1.0;
+	}
+
+	double sum = 0.0;
+
+	for (size_t i = 0; i < m_window.size(); i++) {
+		sum += m_window[i] * m_window[i];
+	}
+
+	return sum / m_window.size();
+}
+
 void FFTWindow::create(Function function, int n)
 {
 	Real (*wFunc)(Real n, Real i);
@@ -50,6 +50,7 @@ public:
     void apply(Complex* in);
 	void setKaiserAlpha(Real alpha); //!< set the Kaiser window alpha factor (default 2.15)
 	void setKaiserBeta(Real beta);   //!< set the Kaiser window beta factor = pi * alpha
+	Real getPower() const;           //!< mean of squared window samples (for noise power correction)
 
 private:
 	std::vector<float> m_window;
@@ -20,6 +20,12 @@
 
 #include <QDebug>
 #include <QDateTime>
+#include <QFileInfo>
+#include <QThread>
+
+#include <cmath>
+
+#include "SWGFileRecordReport.h"
 
 #include "dsp/dspcommands.h"
 #include "util/simpleserializer.h"
@@ -27,6 +33,9 @@
 
 #include "filerecord.h"
 
+MESSAGE_CLASS_DEFINITION(FileRecord::MsgStartEvent, Message)
+MESSAGE_CLASS_DEFINITION(FileRecord::MsgStopEvent, Message)
+
 FileRecord::FileRecord() :
 	BasebandSampleSink(),
     m_fileName("test.sdriq"),
@@ -34,7 +43,35 @@ FileRecord::FileRecord() :
     m_centerFrequency(0),
 	m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_feeding(false),
+    m_controlRequest(false),
+    m_compressor(m_writer),
+    m_compress(false),
+    m_sigMFEnable(false),
+    m_sigMF(false),
+    m_sigMFStartTime(0),
+    m_samplesFed(0),
+    m_samplesWritten(0),
+    m_sigMFGap(false),
+    m_startTime(-1),
+    m_armed(false),
+    m_preTriggerHead(0),
+    m_preTriggerFill(0),
+    m_triggerRequest(false),
+    m_levelThreshold(1e-5),
+    m_eventActive(false),
+    m_eventIndex(0),
+    m_recordEventIndex(0),
+    m_eventFlush(false),
+    m_hangSamples(0),
+    m_samplesSinceTrigger(0),
+    m_nbEvents(0),
+    m_segmented(false),
+    m_segmentMaxSamples(1),
+    m_segmentStartSample(0),
+    m_segmentSamples(0),
+    m_anchorTime(0),
+    m_anchorSample(0)
 {
 	setObjectName("FileSink");
 }
@@ -46,7 +83,35 @@ FileRecord::FileRecord(const QString& filename) :
     m_centerFrequency(0),
     m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_feeding(false),
+    m_controlRequest(false),
+    m_compressor(m_writer),
+    m_compress(false),
+    m_sigMFEnable(false),
+    m_sigMF(false),
+    m_sigMFStartTime(0),
+    m_samplesFed(0),
+    m_samplesWritten(0),
+    m_sigMFGap(false),
+    m_startTime(-1),
+    m_armed(false),
+    m_preTriggerHead(0),
+    m_preTriggerFill(0),
+    m_triggerRequest(false),
+    m_levelThreshold(1e-5),
+    m_eventActive(false),
+    m_eventIndex(0),
+    m_recordEventIndex(0),
+    m_eventFlush(false),
+    m_hangSamples(0),
+    m_samplesSinceTrigger(0),
+    m_nbEvents(0),
+    m_segmented(false),
+    m_segmentMaxSamples(1),
+    m_segmentStartSample(0),
+    m_segmentSamples(0),
+    m_anchorTime(0),
+    m_anchorSample(0)
 {
     setObjectName("FileRecord");
 }
@@ -66,10 +131,12 @@ void FileRecord::setFileName(const QString& filename)
 
 void FileRecord::genUniqueFileName(uint deviceUID, int istream)
 {
+    QString extension = m_sigMFEnable ? SigMF::m_dataExtension : m_compressor.getSettings().m_enable ? "sdriqz" : "sdriq";
+
     if (istream < 0) {
-        setFileName(QString("rec%1_%2.sdriq").arg(deviceUID).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")));
+        setFileName(QString("rec%1_%2.%3").arg(deviceUID).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")).arg(extension));
     } else {
-        setFileName(QString("rec%1_%2_%3.sdriq").arg(deviceUID).arg(istream).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")));
+        setFileName(QString("rec%1_%2_%3.%4").arg(deviceUID).arg(istream).arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz")).arg(extension));
     }
 }
 
@@ -77,10 +144,36 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
 {
     (void) positiveOnly;
     // if no recording is active, send the samples to /dev/null
-    if(!m_recordOn)
+    if(!m_recordOn && !m_armed)
+        return;
+
+    // The DSP thread does not take a lock unless a control operation is in progress.
+    // Samples go to the writer lock free ring.
+    m_feeding.store(true);
+
+    if (m_controlRequest.load())
+    {
+        m_feeding.store(false);
+        QMutexLocker mutexLocker(&m_mutex); // wait for the control operation to complete
+        feedRecording(begin, end);
         return;
+    }
+
+    feedRecording(begin, end);
+    m_feeding.store(false);
+}
+
+void FileRecord::feedRecording(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (begin >= end) {
+        return;
+    }
 
-    if (begin < end) // if there is something to put out
+    if (m_armed)
+    {
+        feedTriggered(begin, end);
+    }
+    else if (m_recordOn) // if there is something to put out
     {
         if (m_recordStart)
         {
@@ -88,11 +181,260 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
-        m_byteCount += end - begin;
+        if (m_segmented) {
+            writeSegmented(begin, end);
+        } else {
+            writeSamples(begin, end);
+        }
     }
 }
 
+void FileRecord::writeSamples(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    // only copies to the compressor or writer. Samples are dropped if they cannot keep up.
+    if (m_compress)
+    {
+        m_compressor.feed(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+    }
+    else if (m_sigMF)
+    {
+        // SigMF data is the sample vector as is. Drops are recorded as capture segments.
+        if (m_writer.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample)))
+        {
+            if (m_sigMFGap)
+            {
+                addSigMFCapture();
+                m_sigMFGap = false;
+            }
+
+            m_samplesWritten += end - begin;
+        }
+        else
+        {
+            m_sigMFGap = true;
+        }
+
+        m_samplesFed += end - begin;
+    }
+    else
+    {
+        m_writer.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+    }
+}
+
+void FileRecord::writeSegmented(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    SampleVector::const_iterator it = begin;
+
+    // blocks are split so that segments end exactly at their limit
+    while (it < end)
+    {
+        quint64 n = std::min((quint64) (end - it), m_segmentMaxSamples - m_segmentSamples);
+        writeSamples(it, it + n);
+        m_segmentSamples += n;
+        it += n;
+
+        if (m_segmentSamples >= m_segmentMaxSamples) {
+            nextSegment();
+        }
+    }
+}
+
+void FileRecord::nextSegment()
+{
+    FileRecordRetention::Segment segment;
+    segment.m_fileName = m_fileName;
+    segment.m_startSample = m_segmentStartSample;
+    segment.m_nbSamples = m_segmentSamples;
+    segment.m_startTime = m_startTime;
+    m_retention.addSegment(segment);
+
+    // start time is counted in samples so that segments follow each other exactly
+    m_segmentStartSample += m_segmentSamples;
+    m_segmentSamples = 0;
+    m_startTime = m_anchorTime + (m_sampleRate == 0 ? 0 : (qint64) (((m_segmentStartSample - m_anchorSample) * 1000) / m_sampleRate));
+    m_fileName = getSegmentFileName(m_startTime);
+    m_writer.switchFile(m_fileName);
+    writeHeader();
+}
+
+void FileRecord::updateSegmentMaxSamples()
+{
+    quint64 maxSamples = 0;
+
+    if (m_segmentSettings.m_segmentTime > 0) {
+        maxSamples = (quint64) m_segmentSettings.m_segmentTime * m_sampleRate;
+    }
+
+    if (m_segmentSettings.m_segmentSizeMB > 0)
+    {
+        quint64 sizeSamples = ((quint64) m_segmentSettings.m_segmentSizeMB * 1024 * 1024 - sizeof(Header)) / sizeof(Sample);
+        maxSamples = maxSamples == 0 ? sizeSamples : std::min(maxSamples, sizeSamples);
+    }
+
+    m_segmentMaxSamples = std::max(maxSamples, (quint64) 1);
+}
+
+QString FileRecord::getSegmentFileName(qint64 startTime) const
+{
+    QFileInfo fileInfo(m_segmentBaseFileName);
+    return QString("%1/%2_%3.sdriq")
+        .arg(fileInfo.path())
+        .arg(fileInfo.completeBaseName())
+        .arg(QDateTime::fromMSecsSinceEpoch(startTime, Qt::UTC).toString("yyyy-MM-ddTHH_mm_ss_zzz"));
+}
+
+void FileRecord::feedTriggered(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    std::size_t nbSamples = end - begin;
+    bool trigger = m_triggerRequest.exchange(false);
+
+    if (!trigger && m_triggerSettings.m_levelTrigger)
+    {
+        double magsqSum = 0.0;
+
+        for (SampleVector::const_iterator it = begin; it != end; ++it)
+        {
+            double re = it->m_real / SDR_RX_SCALED;
+            double im = it->m_imag / SDR_RX_SCALED;
+            magsqSum += re*re + im*im;
+        }
+
+        trigger = magsqSum > m_levelThreshold * nbSamples;
+    }
+
+    if (trigger)
+    {
+        if (!m_eventActive)
+        {
+            // the file is opened in the thread of the recorder meanwhile samples keep going to the ring
+            m_eventActive = true;
+            m_eventIndex++;
+            m_samplesSinceTrigger = 0;
+            QFileInfo fileInfo(m_eventBaseFileName);
+            QString fileName = QString("%1/%2_%3.%4")
+                .arg(fileInfo.path())
+                .arg(fileInfo.completeBaseName())
+                .arg(QDateTime::currentDateTimeUtc().toString("yyyy-MM-ddTHH_mm_ss_zzz"))
+                .arg(fileInfo.suffix());
+            m_inputMessageQueue.push(MsgStartEvent::create(m_eventIndex, fileName));
+        }
+
+        m_hangSamples = (quint64) (m_triggerSettings.m_hangTime * m_sampleRate);
+    }
+    else if (m_eventActive)
+    {
+        if (m_hangSamples > nbSamples)
+        {
+            m_hangSamples -= nbSamples;
+        }
+        else
+        {
+            m_eventActive = false;
+            m_inputMessageQueue.push(MsgStopEvent::create(m_eventIndex));
+        }
+    }
+
+    if (m_recordOn && m_eventActive && (m_recordEventIndex == m_eventIndex))
+    {
+        if (m_eventFlush)
+        {
+            // ring is written first. Time of first sample is estimated from its length
+            m_startTime = QDateTime::currentMSecsSinceEpoch() - (m_sampleRate == 0 ? 0 : (qint64) ((m_preTriggerFill * 1000) / m_sampleRate));
+
+            if (m_recordStart)
+            {
+                writeHeader();
+                m_recordStart = false;
+            }
+
+            if (m_sigMF)
+            {
+                quint64 triggerSample = m_preTriggerFill > m_samplesSinceTrigger ? m_preTriggerFill - m_samplesSinceTrigger : 0;
+                m_sigMFStartTime = m_startTime;
+                m_sigMFMeta.m_captures.front().m_dateTime = m_startTime;
+                SigMF::Annotation annotation;
+                annotation.m_sampleStart = triggerSample;
+                annotation.m_label = "trigger";
+                annotation.m_comment = QString("event %1").arg(m_recordEventIndex);
+                m_sigMFMeta.m_annotations.push_back(annotation);
+            }
+
+            flushPreTrigger();
+            m_eventFlush = false;
+        }
+
+        writeSamples(begin, end);
+    }
+    else
+    {
+        pushPreTrigger(begin, end);
+    }
+
+    m_samplesSinceTrigger += nbSamples;
+}
+
+void FileRecord::pushPreTrigger(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    std::size_t size = m_preTriggerBuffer.size();
+
+    if (size == 0) {
+        return;
+    }
+
+    SampleVector::const_iterator it = begin;
+
+    if ((std::size_t) (end - begin) > size) { // only the last samples fit
+        it = end - size;
+    }
+
+    while (it < end)
+    {
+        std::size_t n = std::min((std::size_t) (end - it), size - m_preTriggerHead);
+        std::copy(it, it + n, m_preTriggerBuffer.begin() + m_preTriggerHead);
+        it += n;
+        m_preTriggerHead = (m_preTriggerHead + n) % size;
+        m_preTriggerFill = std::min(m_preTriggerFill + n, size);
+    }
+}
+
+void FileRecord::flushPreTrigger()
+{
+    std::size_t size = m_preTriggerBuffer.size();
+
+    if (m_preTriggerFill > 0)
+    {
+        std::size_t tail = (m_preTriggerHead + size - m_preTriggerFill) % size; // oldest sample
+
+        if (tail + m_preTriggerFill <= size)
+        {
+            writeSamples(m_preTriggerBuffer.begin() + tail, m_preTriggerBuffer.begin() + tail + m_preTriggerFill);
+        }
+        else
+        {
+            writeSamples(m_preTriggerBuffer.begin() + tail, m_preTriggerBuffer.end());
+            writeSamples(m_preTriggerBuffer.begin(), m_preTriggerBuffer.begin() + m_preTriggerHead);
+        }
+    }
+
+    m_preTriggerHead = 0;
+    m_preTriggerFill = 0;
+}
+
+void FileRecord::resizePreTriggerBuffer()
+{
+    std::size_t size = m_armed ? (std::size_t) (m_triggerSettings.m_preTriggerTime * m_sampleRate) : 0;
+
+    if (size != m_preTriggerBuffer.size())
+    {
+        m_preTriggerBuffer.resize(size);
+        m_preTriggerBuffer.shrink_to_fit();
+    }
+
+    m_preTriggerHead = 0;
+    m_preTriggerFill = 0;
+}
+
 void FileRecord::start()
 {
 }
@@ -104,38 +446,319 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    ControlLocker controlLocker(this);
+
+    if (m_armed || m_writer.isOpen()) {
+        return;
+    }
+
+    if (m_triggerSettings.m_enable)
+    {
+        if (m_segmentSettings.isEnabled()) {
+            qWarning("FileRecord::startRecording: rolling recording does not apply to triggered recordings");
+        }
+
+        qDebug() << "FileRecord::startRecording: armed";
+        m_eventBaseFileName = m_fileName;
+        m_levelThreshold = std::pow(10.0, m_triggerSettings.m_levelDB / 10.0);
+        m_eventActive = false;
+        m_hangSamples = 0;
+        m_nbEvents = 0;
+        m_triggerRequest = false;
+        m_armed = true;
+        resizePreTriggerBuffer();
+        return;
+    }
+
+    m_startTime = -1;
+    m_segmented = m_segmentSettings.isEnabled() && !m_sigMFEnable && !m_compressor.getSettings().m_enable;
+
+    if (m_segmentSettings.isEnabled() && !m_segmented) {
+        qWarning("FileRecord::startRecording: rolling recording does not apply to compressed or SigMF recordings");
+    }
+
+    if (m_segmented)
     {
-    	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
+        m_segmentBaseFileName = m_fileName;
+        m_startTime = QDateTime::currentMSecsSinceEpoch();
+        m_anchorTime = m_startTime;
+        m_anchorSample = 0;
+        m_segmentStartSample = 0;
+        m_segmentSamples = 0;
+        updateSegmentMaxSamples();
+        m_fileName = getSegmentFileName(m_startTime);
+
+        if (openRecording())
+        {
+            m_retention.open(
+                FileRecordRetention::getIndexFileName(m_segmentBaseFileName),
+                m_sampleRate,
+                m_centerFrequency,
+                (quint64) m_segmentSettings.m_quotaMB * 1024 * 1024
+            );
+        }
+
+        return;
+    }
+
+    openRecording();
+}
+
+bool FileRecord::openRecording()
+{
+    if (!m_writer.isOpen())
+    {
+    	qDebug() << "FileRecord::openRecording";
+        m_sigMF = m_sigMFEnable;
+
+        if (m_sigMF && (QFileInfo(m_fileName).suffix() != SigMF::m_dataExtension)) {
+            m_fileName = SigMF::getDataFileName(m_fileName);
+        }
+
+        if (!m_writer.open(m_fileName))
+        {
+            qWarning() << "FileRecord::openRecording: cannot open" << m_fileName;
+            return false;
+        }
+
+        m_compress = m_compressor.getSettings().m_enable && !m_sigMF;
         m_recordOn = true;
         m_recordStart = true;
-        m_byteCount = 0;
+
+        if (m_sigMF)
+        {
+            // provisional meta so that the data remains usable if the recording is interrupted
+            writeHeader();
+            SigMF::writeMeta(SigMF::getMetaFileName(m_fileName), m_sigMFMeta);
+            m_recordStart = false;
+        }
+
+        return true;
     }
+
+    return false;
 }
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    lockControl();
+
+    if (m_armed)
+    {
+        qDebug() << "FileRecord::stopRecording: disarmed after" << m_nbEvents << "events";
+        m_armed = false;
+        m_eventActive = false;
+        resizePreTriggerBuffer(); // frees the ring
+    }
+
+    unlockControl();
+    closeRecording();
+}
+
+void FileRecord::closeRecording()
+{
+    lockControl();
+
+    if (!m_writer.isOpen())
     {
-    	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
-        m_recordOn = false;
-        m_recordStart = false;
+        unlockControl();
+        return;
+    }
+
+    qDebug() << "FileRecord::closeRecording";
+    m_recordOn = false;
+    m_recordStart = false;
+    unlockControl();
+
+    if (m_compress) {
+        m_compressor.stop(); // pending chunks and index
+    }
+
+    m_writer.close(); // flushing the ring may take a while but feed does not write anymore
+
+    if (m_segmented)
+    {
+        if (m_segmentSamples > 0)
+        {
+            FileRecordRetention::Segment segment;
+            segment.m_fileName = m_fileName;
+            segment.m_startSample = m_segmentStartSample;
+            segment.m_nbSamples = m_segmentSamples;
+            segment.m_startTime = m_startTime;
+            m_retention.addSegment(segment);
+        }
+
+        m_retention.close(); // final index
+        m_segmented = false;
+    }
+
+    if (m_sigMF)
+    {
+        if (m_sigMFMeta.m_annotations.size() > 0 && (m_sigMFMeta.m_annotations.front().m_label == "trigger")) {
+            m_sigMFMeta.m_annotations.front().m_sampleCount = m_samplesWritten - m_sigMFMeta.m_annotations.front().m_sampleStart;
+        }
+
+        if (!SigMF::writeMeta(SigMF::getMetaFileName(m_fileName), m_sigMFMeta)) {
+            qWarning() << "FileRecord::closeRecording: cannot write" << SigMF::getMetaFileName(m_fileName);
+        }
+    }
+}
+
+void FileRecord::lockControl()
+{
+    m_mutex.lock();
+    m_controlRequest.store(true);
+
+    // a feed call that started before the request completes lock free. It only copies samples.
+    while (m_feeding.load()) {
+        QThread::yieldCurrentThread();
     }
 }
 
+void FileRecord::unlockControl()
+{
+    m_controlRequest.store(false);
+    m_mutex.unlock();
+}
+
+void FileRecord::setWriterSettings(const FileRecordWriter::Settings& settings)
+{
+    ControlLocker controlLocker(this);
+    m_writer.setSettings(settings);
+}
+
+void FileRecord::setSigMF(bool sigMF)
+{
+    ControlLocker controlLocker(this);
+    m_sigMFEnable = sigMF;
+}
+
+void FileRecord::setTriggerSettings(const TriggerSettings& settings)
+{
+    ControlLocker controlLocker(this);
+    m_triggerSettings = settings;
+}
+
+void FileRecord::setSegmentSettings(const SegmentSettings& settings)
+{
+    ControlLocker controlLocker(this);
+    m_segmentSettings = settings;
+}
+
+void FileRecord::setCompressorSettings(const FileRecordCompressor::Settings& settings)
+{
+    ControlLocker controlLocker(this);
+    m_compressor.setSettings(settings);
+}
+
+void FileRecord::webapiFormatReport(SWGSDRangel::SWGFileRecordReport& report) const
+{
+    report.setFileName(new QString(m_fileName));
+    report.setRecording(m_recordOn ? 1 : 0);
+    report.setBytesWritten(m_writer.getBytesWritten());
+    report.setBytesDropped(m_writer.getBytesDropped());
+    report.setWritesDropped(m_writer.getWritesDropped());
+    report.setBandwidth(m_writer.getBandwidth() / (1024.0f * 1024.0f));
+    report.setQueueFill(m_writer.getQueueFill());
+    report.setMaxQueueFill(m_writer.getNbBlocks() == 0 ? 0.0f : m_writer.getMaxBlocksQueued() / (float) m_writer.getNbBlocks());
+    report.setWriteError(m_writer.hasWriteError() ? 1 : 0);
+    report.setCompressionRatio(m_compressor.getCompressedBytes() == 0 ? 1.0f : m_compressor.getRawBytes() / (float) m_compressor.getCompressedBytes());
+    report.setChunksDropped(m_compressor.getChunksDropped());
+    report.setArmed(m_armed ? 1 : 0);
+    report.setEvents(m_nbEvents);
+    report.setSegments(m_retention.getNbSegments());
+    report.setSegmentsDeleted(m_retention.getNbDeleted());
+}
+
 bool FileRecord::handleMessage(const Message& message)
 {
 	if (DSPSignalNotification::match(message))
 	{
 		DSPSignalNotification& notif = (DSPSignalNotification&) message;
+		ControlLocker controlLocker(this);
+
+		if (m_recordOn && m_sigMF)
+		{
+			if ((quint32) notif.getSampleRate() != m_sampleRate)
+			{
+				// a SigMF recording has a single sample rate
+				qWarning("FileRecord::handleMessage: sample rate change from %u to %d S/s in SigMF recording",
+					m_sampleRate, notif.getSampleRate());
+				SigMF::Annotation annotation;
+				annotation.m_sampleStart = m_samplesWritten;
+				annotation.m_label = "sample rate change";
+				annotation.m_comment = QString("%1 S/s").arg(notif.getSampleRate());
+				m_sigMFMeta.m_annotations.push_back(annotation);
+			}
+
+			if ((quint64) notif.getCenterFrequency() != m_centerFrequency)
+			{
+				m_centerFrequency = notif.getCenterFrequency();
+				addSigMFCapture();
+			}
+		}
+
+		bool sampleRateChange = (quint32) notif.getSampleRate() != m_sampleRate;
+
+		if (m_recordOn && m_segmented && sampleRateChange && (m_sampleRate != 0))
+		{
+			// times of next segments are counted from here at the new rate
+			quint64 sample = m_segmentStartSample + m_segmentSamples;
+			m_anchorTime += (qint64) (((sample - m_anchorSample) * 1000) / m_sampleRate);
+			m_anchorSample = sample;
+		}
+
 		m_sampleRate = notif.getSampleRate();
+
+		if (m_segmented) {
+			updateSegmentMaxSamples();
+		}
+
 		m_centerFrequency = notif.getCenterFrequency();
+
+		if (m_armed && sampleRateChange) {
+			resizePreTriggerBuffer();
+		}
+
 		qDebug() << "FileRecord::handleMessage: DSPSignalNotification: m_inputSampleRate: " << m_sampleRate
 				<< " m_centerFrequency: " << m_centerFrequency;
 		return true;
 	}
+    else if (MsgStartEvent::match(message))
+    {
+        MsgStartEvent& cmd = (MsgStartEvent&) message;
+        ControlLocker controlLocker(this);
+
+        // the event may have ended or recording been stopped in between
+        if (m_armed && m_eventActive && (cmd.getEventIndex() == m_eventIndex) && !m_writer.isOpen())
+        {
+            m_fileName = cmd.getFileName();
+            m_startTime = -1; // provisional until the ring is written
+
+            if (openRecording())
+            {
+                m_recordEventIndex = cmd.getEventIndex();
+                m_eventFlush = true;
+                m_nbEvents++;
+                qDebug() << "FileRecord::handleMessage: MsgStartEvent:" << m_recordEventIndex << m_fileName;
+            }
+        }
+
+        return true;
+    }
+    else if (MsgStopEvent::match(message))
+    {
+        MsgStopEvent& cmd = (MsgStopEvent&) message;
+        lockControl();
+        bool current = m_writer.isOpen() && (cmd.getEventIndex() == m_recordEventIndex);
+        unlockControl();
+
+        if (current) {
+            closeRecording();
+        }
+
+        return true;
+    }
     else
     {
         return false;
@@ -154,15 +777,53 @@ void FileRecord::handleConfigure(const QString& fileName)
 
 void FileRecord::writeHeader()
 {
+    if (m_sigMF)
+    {
+        // data file has no header
+        m_sigMFStartTime = m_startTime < 0 ? QDateTime::currentMSecsSinceEpoch() : m_startTime;
+        m_samplesFed = 0;
+        m_samplesWritten = 0;
+        m_sigMFGap = false;
+        m_sigMFMeta = SigMF::Meta();
+        m_sigMFMeta.m_dataType = SDR_RX_SAMP_SZ == 16 ? SigMF::DataTypeCI16 : SigMF::DataTypeCI32;
+        m_sigMFMeta.m_sampleBits = SDR_RX_SAMP_SZ;
+        m_sigMFMeta.m_sampleRate = m_sampleRate;
+        m_sigMFMeta.m_recorder = "SDRangel";
+        addSigMFCapture();
+        return;
+    }
+
     Header header;
     header.sampleRate = m_sampleRate;
     header.centerFrequency = m_centerFrequency;
     std::time_t ts = time(0);
-    header.startTimeStamp = ts;
+    header.startTimeStamp = m_startTime < 0 ? ts : m_startTime / 1000;
     header.sampleSize = SDR_RX_SAMP_SZ;
     header.filler = 0;
 
-    writeHeader(m_sampleFile, header);
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, 28);
+    header.crc32 = crc32.checksum();
+
+    if (m_compress) {
+        m_compressor.start((const char *) &header, sizeof(Header), sizeof(FixReal));
+    } else {
+        m_writer.write((const char *) &header, sizeof(Header));
+    }
+}
+
+void FileRecord::addSigMFCapture()
+{
+    SigMF::Capture capture;
+    capture.m_sampleStart = m_samplesWritten;
+    capture.m_frequency = m_centerFrequency;
+    capture.m_dateTime = m_sigMFStartTime + (m_sampleRate == 0 ? 0 : (qint64) ((m_samplesFed * 1000) / m_sampleRate));
+
+    if (!m_sigMFMeta.m_captures.empty() && (m_sigMFMeta.m_captures.back().m_sampleStart == capture.m_sampleStart)) {
+        m_sigMFMeta.m_captures.back() = capture; // no sample in the previous segment
+    } else {
+        m_sigMFMeta.m_captures.push_back(capture);
+    }
 }
 
 bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -23,10 +23,21 @@
 #include <iostream>
 #include <fstream>
 
+#include <atomic>
 #include <ctime>
+#include <QMutex>
+
+#include "dsp/filerecordcompressor.h"
+#include "dsp/filerecordretention.h"
+#include "dsp/filerecordwriter.h"
+#include "dsp/sigmf.h"
+#include "util/message.h"
 #include "export.h"
 
-class Message;
+namespace SWGSDRangel
+{
+    class SWGFileRecordReport;
+}
 
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
@@ -43,11 +54,100 @@ public:
     };
 #pragma pack(pop)
 
+    /** Event recording: samples are kept in memory and written to a new file each time a trigger fires */
+    struct TriggerSettings
+    {
+        bool m_enable;          //!< record events only
+        float m_preTriggerTime; //!< seconds of samples before the trigger written to the event file
+        float m_hangTime;       //!< seconds of recording after the trigger condition ends
+        bool m_levelTrigger;    //!< trigger on the average power of the samples
+        float m_levelDB;        //!< power threshold in dB relative to full scale
+
+        TriggerSettings() :
+            m_enable(false),
+            m_preTriggerTime(1.0f),
+            m_hangTime(2.0f),
+            m_levelTrigger(false),
+            m_levelDB(-50.0f)
+        {}
+    };
+
+    /** Rolling recording: a new .sdriq segment is started when the current one reaches one of the limits */
+    struct SegmentSettings
+    {
+        unsigned int m_segmentTime;   //!< seconds per segment (0 for no limit)
+        unsigned int m_segmentSizeMB; //!< MB per segment (0 for no limit)
+        unsigned int m_quotaMB;       //!< oldest segments are deleted above this total size (0 for no limit)
+
+        SegmentSettings() :
+            m_segmentTime(0),
+            m_segmentSizeMB(0),
+            m_quotaMB(0)
+        {}
+
+        bool isEnabled() const { return (m_segmentTime > 0) || (m_segmentSizeMB > 0); }
+    };
+
+    class MsgStartEvent : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        unsigned int getEventIndex() const { return m_eventIndex; }
+        const QString& getFileName() const { return m_fileName; }
+
+        static MsgStartEvent* create(unsigned int eventIndex, const QString& fileName) {
+            return new MsgStartEvent(eventIndex, fileName);
+        }
+
+    private:
+        unsigned int m_eventIndex;
+        QString m_fileName;
+
+        MsgStartEvent(unsigned int eventIndex, const QString& fileName) :
+            Message(),
+            m_eventIndex(eventIndex),
+            m_fileName(fileName)
+        { }
+    };
+
+    class MsgStopEvent : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        unsigned int getEventIndex() const { return m_eventIndex; }
+
+        static MsgStopEvent* create(unsigned int eventIndex) {
+            return new MsgStopEvent(eventIndex);
+        }
+
+    private:
+        unsigned int m_eventIndex;
+
+        MsgStopEvent(unsigned int eventIndex) :
+            Message(),
+            m_eventIndex(eventIndex)
+        { }
+    };
+
 	FileRecord();
     FileRecord(const QString& filename);
 	virtual ~FileRecord();
 
-    quint64 getByteCount() const { return m_byteCount; }
+    quint64 getByteCount() const { return m_writer.getBytesQueued(); }
+    const QString& getFileName() const { return m_fileName; }
+    void setWriterSettings(const FileRecordWriter::Settings& settings); //!< Effective at next recording start
+    const FileRecordWriter::Settings& getWriterSettings() const { return m_writer.getSettings(); }
+    void setCompressorSettings(const FileRecordCompressor::Settings& settings); //!< Effective at next recording start
+    const FileRecordCompressor::Settings& getCompressorSettings() const { return m_compressor.getSettings(); }
+    void setSigMF(bool sigMF); //!< Record SigMF data and meta files. Effective at next recording start
+    bool getSigMF() const { return m_sigMFEnable; }
+    void setTriggerSettings(const TriggerSettings& settings); //!< Effective at next recording start
+    const TriggerSettings& getTriggerSettings() const { return m_triggerSettings; }
+    void trigger() { m_triggerRequest = true; } //!< Starts or extends an event when armed. Thread safe
+    bool isArmed() const { return m_armed; }
+    void setSegmentSettings(const SegmentSettings& settings); //!< Effective at next recording start
+    const SegmentSettings& getSegmentSettings() const { return m_segmentSettings; }
+    void webapiFormatReport(SWGSDRangel::SWGFileRecordReport& report) const;
 
     void setFileName(const QString& filename);
     void genUniqueFileName(uint deviceUID, int istream = -1);
@@ -56,9 +156,9 @@ public:
 	virtual void start();
 	virtual void stop();
 	virtual bool handleMessage(const Message& message);
-    void startRecording();
+    void startRecording(); //!< Arms the trigger in event recording mode
     void stopRecording();
-    bool isRecording() const { return m_recordOn; }
+    bool isRecording() const { return m_recordOn || m_armed; }
     static bool readHeader(std::ifstream& samplefile, Header& header); //!< returns true if CRC checksum is correct else false
     static void writeHeader(std::ofstream& samplefile, Header& header);
 
@@ -66,13 +166,74 @@ private:
 	QString m_fileName;
 	quint32 m_sampleRate;
 	quint64 m_centerFrequency;
-	bool m_recordOn;
+	std::atomic<bool> m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
-    quint64 m_byteCount;
+    std::atomic<bool> m_feeding;        //!< feed is running without the lock
+    std::atomic<bool> m_controlRequest; //!< a control operation holds the lock: feed has to take it
+    FileRecordWriter m_writer;         //!< disk writes are done in the writer thread
+    FileRecordCompressor m_compressor; //!< .sdriqz files are compressed in a thread pool before the writer
+    bool m_compress;                   //!< current recording is compressed
+    bool m_sigMFEnable;
+    bool m_sigMF;                      //!< current recording is SigMF
+    SigMF::Meta m_sigMFMeta;
+    qint64 m_sigMFStartTime;           //!< UTC ms since epoch of the first sample
+    quint64 m_samplesFed;              //!< samples received since the start of the recording
+    quint64 m_samplesWritten;          //!< samples in the data file
+    bool m_sigMFGap;                   //!< samples were dropped: next samples start a new capture segment
+    qint64 m_startTime;                //!< UTC ms since epoch of the first sample (-1 for now)
+    TriggerSettings m_triggerSettings;
+    std::atomic<bool> m_armed;         //!< event recording mode is active
+    QString m_eventBaseFileName;       //!< event file names are derived from the file name set when armed
+    SampleVector m_preTriggerBuffer;   //!< ring of the last samples before an event file is open
+    std::size_t m_preTriggerHead;      //!< next write index in the ring
+    std::size_t m_preTriggerFill;
+    std::atomic<bool> m_triggerRequest;
+    double m_levelThreshold;           //!< linear power threshold
+    bool m_eventActive;                //!< trigger fired and hang time not elapsed
+    unsigned int m_eventIndex;         //!< last event triggered
+    unsigned int m_recordEventIndex;   //!< event of the open file
+    bool m_eventFlush;                 //!< ring is to be written at the start of the event file
+    quint64 m_hangSamples;             //!< samples left before the event ends
+    quint64 m_samplesSinceTrigger;
+    unsigned int m_nbEvents;           //!< event files opened since armed
+    SegmentSettings m_segmentSettings;
+    bool m_segmented;                  //!< current recording is split in segments
+    QString m_segmentBaseFileName;     //!< segment and index file names are derived from the file name set at start
+    quint64 m_segmentMaxSamples;
+    quint64 m_segmentStartSample;      //!< first sample of the current segment since the start of the recording
+    quint64 m_segmentSamples;          //!< samples in the current segment
+    qint64 m_anchorTime;               //!< segment start times are counted in samples from this time...
+    quint64 m_anchorSample;            //!< ...and sample (moved on sample rate changes)
+    FileRecordRetention m_retention;   //!< index and quota of the segments
+    QMutex m_mutex;                    //!< control operations (start, stop, settings, notifications)
+
+    class ControlLocker //!< scoped lockControl
+    {
+    public:
+        ControlLocker(FileRecord *fileRecord) : m_fileRecord(fileRecord) { m_fileRecord->lockControl(); }
+        ~ControlLocker() { m_fileRecord->unlockControl(); }
+    private:
+        FileRecord *m_fileRecord;
+    };
+
+    void lockControl();   //!< excludes feed without making it take a lock in the normal case
+    void unlockControl();
 
 	void handleConfigure(const QString& fileName);
+    bool openRecording();  //!< m_mutex must be held
+    void closeRecording();
+    void feedRecording(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void writeSamples(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void writeSegmented(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void nextSegment();
+    void updateSegmentMaxSamples();
+    QString getSegmentFileName(qint64 startTime) const;
+    void feedTriggered(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void pushPreTrigger(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+    void flushPreTrigger();
+    void resizePreTriggerBuffer();
     void writeHeader();
+    void addSigMFCapture(); //!< new capture segment at current sample
 };
 
 #endif // INCLUDE_FILERECORD_H
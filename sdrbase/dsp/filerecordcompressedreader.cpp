@@ -0,0 +1,260 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/crc.hpp>
+
+#include <QDebug>
+
+#include "filerecordcompressedreader.h"
+
+FileRecordCompressedReader::FileRecordCompressedReader() :
+    m_sampleBytes(2),
+    m_nbSamples(0),
+    m_position(0),
+    m_indexFound(false),
+    m_chunkIndex(-1)
+{}
+
+FileRecordCompressedReader::~FileRecordCompressedReader()
+{
+    close();
+}
+
+bool FileRecordCompressedReader::isCompressedFile(const QString& fileName)
+{
+    IQCompression::FileHeader fileHeader;
+#ifdef Q_OS_WIN
+    std::ifstream stream(fileName.toStdWString().c_str(), std::ios::binary);
+#else
+    std::ifstream stream(fileName.toStdString().c_str(), std::ios::binary);
+#endif
+    stream.read((char *) &fileHeader, sizeof(fileHeader));
+    return stream.good() && IQCompression::isCompressedFile(fileHeader.m_magic);
+}
+
+bool FileRecordCompressedReader::open(const QString& fileName, FileRecord::Header& header, bool& crcOK)
+{
+    close();
+#ifdef Q_OS_WIN
+    m_stream.open(fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
+#else
+    m_stream.open(fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
+#endif
+    quint64 fileSize = m_stream.tellg();
+    quint64 dataOffset = sizeof(IQCompression::FileHeader) + sizeof(FileRecord::Header);
+
+    if (!m_stream.is_open() || (fileSize < dataOffset))
+    {
+        close();
+        return false;
+    }
+
+    IQCompression::FileHeader fileHeader;
+    m_stream.seekg(0, std::ios::beg);
+    m_stream.read((char *) &fileHeader, sizeof(fileHeader));
+
+    if (!IQCompression::isCompressedFile(fileHeader.m_magic))
+    {
+        close();
+        return false;
+    }
+
+    crcOK = FileRecord::readHeader(m_stream, header);
+    m_sampleBytes = header.sampleSize > 16 ? sizeof(int32_t) : sizeof(int16_t);
+    m_nbSamples = 0;
+    m_indexFound = loadIndex(fileSize);
+
+    if (!m_indexFound)
+    {
+        qWarning("FileRecordCompressedReader::open: %s: no index. Scanning chunks", qPrintable(fileName));
+        scanChunks(dataOffset, fileSize);
+    }
+
+    if (m_index.size() > 0) { // samples dropped at the end are only known from the trailer
+        m_nbSamples = std::max(m_nbSamples, m_index.back().m_firstSample + m_index.back().m_nbSamples);
+    }
+
+    m_position = 0;
+    m_chunkIndex = -1;
+
+    qDebug("FileRecordCompressedReader::open: %s: %lu chunks %llu samples",
+        qPrintable(fileName), (unsigned long) m_index.size(), m_nbSamples);
+    return true;
+}
+
+void FileRecordCompressedReader::close()
+{
+    if (m_stream.is_open()) {
+        m_stream.close();
+    }
+
+    m_index.clear();
+    m_nbSamples = 0;
+    m_position = 0;
+    m_chunkIndex = -1;
+}
+
+void FileRecordCompressedReader::seek(quint64 sampleIndex)
+{
+    m_position = std::min(sampleIndex, m_nbSamples);
+}
+
+qint64 FileRecordCompressedReader::read(char *data, qint64 size)
+{
+    const unsigned int sampleSize = 2 * m_sampleBytes;
+    quint64 nbSamples = size / sampleSize;
+    quint64 done = 0;
+
+    while ((done < nbSamples) && (m_position < m_nbSamples))
+    {
+        if ((m_chunkIndex < 0)
+         || (m_position < m_index[m_chunkIndex].m_firstSample)
+         || (m_position >= m_index[m_chunkIndex].m_firstSample + m_index[m_chunkIndex].m_nbSamples))
+        {
+            int chunkIndex = findChunk(m_position);
+
+            if ((chunkIndex < 0) || (m_position >= m_index[chunkIndex].m_firstSample + m_index[chunkIndex].m_nbSamples))
+            {
+                // samples dropped while recording
+                quint64 gapEnd = chunkIndex + 1 < (int) m_index.size() ? m_index[chunkIndex + 1].m_firstSample : m_nbSamples;
+                quint64 n = std::min(gapEnd - m_position, nbSamples - done);
+                std::memset(data + done * sampleSize, 0, n * sampleSize);
+                done += n;
+                m_position += n;
+                continue;
+            }
+
+            decodeChunk(chunkIndex);
+        }
+
+        const IQCompression::IndexEntry& entry = m_index[m_chunkIndex];
+        quint64 offset = m_position - entry.m_firstSample;
+        quint64 n = std::min(entry.m_nbSamples - offset, nbSamples - done);
+        std::memcpy(data + done * sampleSize, m_samples.constData() + offset * sampleSize, n * sampleSize);
+        done += n;
+        m_position += n;
+    }
+
+    return done * sampleSize;
+}
+
+bool FileRecordCompressedReader::loadIndex(quint64 fileSize)
+{
+    IQCompression::Trailer trailer;
+
+    if (fileSize < sizeof(IQCompression::FileHeader) + sizeof(FileRecord::Header) + sizeof(trailer)) {
+        return false;
+    }
+
+    m_stream.seekg(fileSize - sizeof(trailer), std::ios::beg);
+    m_stream.read((char *) &trailer, sizeof(trailer));
+
+    if (!m_stream.good()
+     || (memcmp(trailer.m_magic, IQCompression::m_trailerMagic, sizeof(trailer.m_magic)) != 0)
+     || (trailer.m_indexOffset + trailer.m_nbEntries * sizeof(IQCompression::IndexEntry) + sizeof(trailer) != fileSize))
+    {
+        m_stream.clear();
+        return false;
+    }
+
+    m_index.resize(trailer.m_nbEntries);
+    m_stream.seekg(trailer.m_indexOffset, std::ios::beg);
+    m_stream.read((char *) m_index.data(), m_index.size() * sizeof(IQCompression::IndexEntry));
+    boost::crc_32_type crc32;
+    crc32.process_bytes(m_index.data(), m_index.size() * sizeof(IQCompression::IndexEntry));
+
+    if (!m_stream.good() || (crc32.checksum() != trailer.m_crc32))
+    {
+        m_stream.clear();
+        m_index.clear();
+        return false;
+    }
+
+    m_nbSamples = trailer.m_nbSamples;
+    return true;
+}
+
+void FileRecordCompressedReader::scanChunks(quint64 dataOffset, quint64 endOffset)
+{
+    quint64 offset = dataOffset;
+    IQCompression::ChunkHeader header;
+
+    // stops at the first incomplete chunk which is the end of an interrupted recording
+    while (offset + sizeof(header) <= endOffset)
+    {
+        m_stream.seekg(offset, std::ios::beg);
+        m_stream.read((char *) &header, sizeof(header));
+
+        if (!m_stream.good() || (header.m_magic != IQCompression::m_chunkMagic) || (offset + sizeof(header) + header.m_size > endOffset)) {
+            break;
+        }
+
+        IQCompression::IndexEntry entry;
+        entry.m_firstSample = header.m_firstSample;
+        entry.m_offset = offset;
+        entry.m_nbSamples = header.m_nbSamples;
+        entry.m_size = sizeof(header) + header.m_size;
+        m_index.push_back(entry);
+        offset += entry.m_size;
+    }
+
+    m_stream.clear();
+}
+
+bool FileRecordCompressedReader::decodeChunk(int chunkIndex)
+{
+    const IQCompression::IndexEntry& entry = m_index[chunkIndex];
+    m_chunkIndex = chunkIndex;
+    m_samples.resize(entry.m_nbSamples * 2 * m_sampleBytes);
+    m_payload.resize(entry.m_size);
+    m_stream.seekg(entry.m_offset, std::ios::beg);
+    m_stream.read(m_payload.data(), entry.m_size);
+    const IQCompression::ChunkHeader *header = (const IQCompression::ChunkHeader *) m_payload.constData();
+
+    if (!m_stream.good()
+     || (header->m_magic != IQCompression::m_chunkMagic)
+     || (header->m_nbSamples != entry.m_nbSamples)
+     || !IQCompression::decode(
+            header->m_codec,
+            m_payload.constData() + sizeof(IQCompression::ChunkHeader),
+            entry.m_size - sizeof(IQCompression::ChunkHeader),
+            entry.m_nbSamples,
+            m_sampleBytes,
+            m_samples.data()))
+    {
+        qWarning("FileRecordCompressedReader::decodeChunk: chunk %d is corrupted", chunkIndex);
+        m_stream.clear();
+        m_samples.fill(0); // keep timing
+        return false;
+    }
+
+    return true;
+}
+
+int FileRecordCompressedReader::findChunk(quint64 sampleIndex) const
+{
+    auto it = std::upper_bound(m_index.begin(), m_index.end(), sampleIndex,
+        [](quint64 s, const IQCompression::IndexEntry& entry) {
+            return s < entry.m_firstSample;
+        }
+    );
+
+    return (int) (it - m_index.begin()) - 1;
+}
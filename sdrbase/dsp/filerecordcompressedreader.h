@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Reader of compressed I/Q recordings (.sdriqz)                                 //
+//                                                                               //
+// Delivers the samples in the same layout as .sdriq files. Seeking uses the     //
+// chunk index. Samples dropped while recording are replaced by zeros so that    //
+// timing is preserved.                                                          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDCOMPRESSEDREADER_H_
+#define SDRBASE_DSP_FILERECORDCOMPRESSEDREADER_H_
+
+#include <fstream>
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+
+#include "dsp/filerecord.h"
+#include "dsp/iqcompression.h"
+#include "export.h"
+
+class SDRBASE_API FileRecordCompressedReader
+{
+public:
+    FileRecordCompressedReader();
+    ~FileRecordCompressedReader();
+
+    static bool isCompressedFile(const QString& fileName); //!< checks the magic at start of file
+
+    /** Opens the file, reads the header and loads or rebuilds the index. Returns false if not a .sdriqz file */
+    bool open(const QString& fileName, FileRecord::Header& header, bool& crcOK);
+    void close();
+    bool isOpen() const { return m_stream.is_open(); }
+    quint64 getNbSamples() const { return m_nbSamples; } //!< including samples dropped while recording
+    unsigned int getSampleBytes() const { return m_sampleBytes; }
+
+    void seek(quint64 sampleIndex);
+    quint64 getPosition() const { return m_position; }
+    /** Reads up to size bytes of samples. Returns the number of bytes read (less than size at end of file) */
+    qint64 read(char *data, qint64 size);
+    bool isEOF() const { return m_position >= m_nbSamples; }
+    bool hasIndex() const { return m_indexFound; } //!< false when the index was rebuilt
+
+private:
+    std::ifstream m_stream;
+    unsigned int m_sampleBytes;  //!< bytes per I or Q
+    quint64 m_nbSamples;
+    quint64 m_position;          //!< index of the next sample read
+    std::vector<IQCompression::IndexEntry> m_index;
+    bool m_indexFound;
+    int m_chunkIndex;            //!< index entry of the decoded chunk (-1 for none)
+    QByteArray m_payload;
+    QByteArray m_samples;        //!< decoded chunk
+
+    bool loadIndex(quint64 fileSize);
+    void scanChunks(quint64 dataOffset, quint64 endOffset);
+    bool decodeChunk(int chunkIndex);
+    int findChunk(quint64 sampleIndex) const; //!< last chunk starting at or before sample index (-1 for none)
+};
+
+#endif // SDRBASE_DSP_FILERECORDCOMPRESSEDREADER_H_
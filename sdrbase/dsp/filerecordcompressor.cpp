@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/crc.hpp>
+
+#include <QDebug>
+#include <QRunnable>
+#include <QThread>
+
+#include "dsp/filerecordwriter.h"
+#include "filerecordcompressor.h"
+
+class FileRecordCompressor::CompressTask : public QRunnable
+{
+public:
+    CompressTask(FileRecordCompressor *compressor, quint64 sequence, quint64 firstSample, unsigned int sampleBytes, const QByteArray& samples) :
+        m_compressor(compressor),
+        m_sequence(sequence),
+        m_firstSample(firstSample),
+        m_sampleBytes(sampleBytes),
+        m_samples(samples)
+    {}
+
+    virtual void run()
+    {
+        QByteArray payload;
+        IQCompression::ChunkHeader header;
+        header.m_magic = IQCompression::m_chunkMagic;
+        header.m_nbSamples = m_samples.size() / (2 * m_sampleBytes);
+        header.m_codec = IQCompression::encode(m_samples.constData(), header.m_nbSamples, m_sampleBytes, payload);
+        header.m_size = payload.size();
+        header.m_firstSample = m_firstSample;
+        QByteArray chunk((const char *) &header, sizeof(header));
+        chunk.append(payload);
+        m_compressor->compressed(m_sequence, m_samples.size(), chunk);
+    }
+
+private:
+    FileRecordCompressor *m_compressor;
+    quint64 m_sequence;
+    quint64 m_firstSample;
+    unsigned int m_sampleBytes;
+    QByteArray m_samples;
+};
+
+FileRecordCompressor::FileRecordCompressor(FileRecordWriter& writer) :
+    m_writer(writer),
+    m_running(false),
+    m_sampleBytes(2),
+    m_chunkBytes(0),
+    m_chunkFirstSample(0),
+    m_nextSample(0),
+    m_nextSubmit(0),
+    m_maxPending(0),
+    m_pending(0),
+    m_nextWrite(0),
+    m_fileOffset(0),
+    m_rawBytes(0),
+    m_compressedBytes(0),
+    m_chunksDropped(0)
+{}
+
+FileRecordCompressor::~FileRecordCompressor()
+{
+    stop();
+}
+
+void FileRecordCompressor::start(const char *header, unsigned int headerSize, unsigned int sampleBytes)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_sampleBytes = sampleBytes;
+    m_chunkBytes = std::max(1024U, m_settings.m_chunkSamples) * 2 * m_sampleBytes;
+    m_chunk.clear();
+    m_chunk.reserve(m_chunkBytes);
+    m_chunkFirstSample = 0;
+    m_nextSample = 0;
+    m_nextSubmit = 0;
+    m_nextWrite = 0;
+    m_threadPool.setMaxThreadCount(std::max(1U, m_settings.m_nbThreads));
+    m_maxPending = 2 * m_threadPool.maxThreadCount() + 2; // bounds the memory held by pending chunks
+    m_pending = 0;
+    m_compressed.clear();
+    m_index.clear();
+    m_rawBytes = 0;
+    m_compressedBytes = 0;
+    m_chunksDropped = 0;
+
+    IQCompression::FileHeader fileHeader;
+    memcpy(fileHeader.m_magic, IQCompression::m_fileMagic, sizeof(fileHeader.m_magic));
+    m_writer.write((const char *) &fileHeader, sizeof(fileHeader));
+    m_writer.write(header, headerSize);
+    m_fileOffset = sizeof(fileHeader) + headerSize;
+    m_running = true;
+}
+
+void FileRecordCompressor::feed(const char *samples, std::size_t size)
+{
+    while (size > 0)
+    {
+        std::size_t toCopy = std::min(size, (std::size_t) (m_chunkBytes - m_chunk.size()));
+        m_chunk.append(samples, toCopy);
+        samples += toCopy;
+        size -= toCopy;
+        m_nextSample += toCopy / (2 * m_sampleBytes);
+
+        if ((unsigned int) m_chunk.size() == m_chunkBytes) {
+            submitChunk();
+        }
+    }
+}
+
+void FileRecordCompressor::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    if (m_chunk.size() > 0) {
+        submitChunk();
+    }
+
+    m_threadPool.waitForDone();
+    writeIndex();
+    m_running = false;
+
+    qDebug("FileRecordCompressor::stop: %llu bytes compressed to %llu bytes in %lu chunks. %llu chunks dropped",
+        m_rawBytes.load(), m_compressedBytes.load(), (unsigned long) m_index.size(), m_chunksDropped.load());
+}
+
+void FileRecordCompressor::submitChunk()
+{
+    if (m_pending.load() >= m_maxPending)
+    {
+        // the gap is seen from the first sample of the next chunk
+        m_chunksDropped++;
+    }
+    else
+    {
+        m_pending++;
+        m_threadPool.start(new CompressTask(this, m_nextSubmit++, m_chunkFirstSample, m_sampleBytes, m_chunk));
+    }
+
+    m_chunk.clear(); // detaches from the copy given to the task
+    m_chunk.reserve(m_chunkBytes);
+    m_chunkFirstSample = m_nextSample;
+}
+
+void FileRecordCompressor::compressed(quint64 sequence, quint64 rawBytes, const QByteArray& chunk)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_compressed[sequence] = std::pair<quint64, QByteArray>(rawBytes, chunk);
+
+    // chunks are written in the order they were fed whatever the order of completion
+    while (!m_compressed.empty() && (m_compressed.begin()->first == m_nextWrite))
+    {
+        const QByteArray& next = m_compressed.begin()->second.second;
+
+        if (m_writer.write(next.constData(), next.size()))
+        {
+            IQCompression::IndexEntry entry;
+            const IQCompression::ChunkHeader *header = (const IQCompression::ChunkHeader *) next.constData();
+            entry.m_firstSample = header->m_firstSample;
+            entry.m_offset = m_fileOffset;
+            entry.m_nbSamples = header->m_nbSamples;
+            entry.m_size = next.size();
+            m_index.push_back(entry);
+            m_fileOffset += next.size();
+            m_rawBytes += m_compressed.begin()->second.first;
+            m_compressedBytes += next.size() - sizeof(IQCompression::ChunkHeader);
+        }
+        else
+        {
+            m_chunksDropped++;
+        }
+
+        m_compressed.erase(m_compressed.begin());
+        m_nextWrite++;
+        m_pending--;
+    }
+}
+
+void FileRecordCompressor::writeIndex()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    IQCompression::Trailer trailer;
+    trailer.m_indexOffset = m_fileOffset;
+    trailer.m_nbSamples = m_nextSample;
+    trailer.m_nbEntries = m_index.size();
+    boost::crc_32_type crc32;
+    crc32.process_bytes(m_index.data(), m_index.size() * sizeof(IQCompression::IndexEntry));
+    trailer.m_crc32 = crc32.checksum();
+    memcpy(trailer.m_magic, IQCompression::m_trailerMagic, sizeof(trailer.m_magic));
+
+    QByteArray index((const char *) m_index.data(), m_index.size() * sizeof(IQCompression::IndexEntry));
+    index.append((const char *) &trailer, sizeof(trailer));
+
+    // not in the DSP thread anymore so it is fine to wait for the writer to make room
+    for (int attempt = 0; attempt < 100; attempt++)
+    {
+        if (m_writer.write(index.constData(), index.size())) {
+            return;
+        }
+
+        QThread::msleep(10);
+    }
+
+    qWarning("FileRecordCompressor::writeIndex: cannot write index. It will be rebuilt at playback");
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Compression of I/Q recordings in a thread pool                                //
+//                                                                               //
+// Samples fed by FileRecord are cut in chunks that are compressed concurrently  //
+// in a thread pool. Compressed chunks are handed over in order to the file      //
+// writer and their position is kept for the index written at the end.          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDCOMPRESSOR_H_
+#define SDRBASE_DSP_FILERECORDCOMPRESSOR_H_
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QThreadPool>
+
+#include "dsp/iqcompression.h"
+#include "export.h"
+
+class FileRecordWriter;
+
+class SDRBASE_API FileRecordCompressor
+{
+public:
+    struct Settings
+    {
+        bool m_enable;               //!< write .sdriqz compressed files instead of .sdriq
+        unsigned int m_nbThreads;    //!< compression threads
+        unsigned int m_chunkSamples; //!< I/Q samples per chunk (seek granularity)
+
+        Settings() :
+            m_enable(false),
+            m_nbThreads(2),
+            m_chunkSamples(1<<16)
+        {}
+    };
+
+    FileRecordCompressor(FileRecordWriter& writer);
+    ~FileRecordCompressor();
+
+    void setSettings(const Settings& settings) { m_settings = settings; } //!< Effective at next start
+    const Settings& getSettings() const { return m_settings; }
+
+    /** Writes the file header. Header is the .sdriq header with its CRC */
+    void start(const char *header, unsigned int headerSize, unsigned int sampleBytes);
+    /** Called from the DSP thread. Never blocks: a whole chunk is dropped if too many chunks are pending */
+    void feed(const char *samples, std::size_t size);
+    /** Compresses the last partial chunk, waits for pending chunks and writes the index */
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    quint64 getRawBytes() const { return m_rawBytes.load(); }               //!< sample bytes of chunks written
+    quint64 getCompressedBytes() const { return m_compressedBytes.load(); } //!< payload bytes of chunks written
+    quint64 getChunksDropped() const { return m_chunksDropped.load(); }     //!< by the compressor or by the writer
+
+private:
+    class CompressTask;
+
+    Settings m_settings;
+    FileRecordWriter& m_writer;
+    QThreadPool m_threadPool;
+    bool m_running;
+    unsigned int m_sampleBytes;   //!< bytes per I or Q
+    unsigned int m_chunkBytes;
+    QByteArray m_chunk;           //!< chunk being filled by feed
+    quint64 m_chunkFirstSample;
+    quint64 m_nextSample;         //!< index of the next sample fed
+    quint64 m_nextSubmit;         //!< sequence number of the next chunk submitted
+    unsigned int m_maxPending;
+    std::atomic<unsigned int> m_pending;
+
+    QMutex m_mutex;               //!< everything below and writer access
+    quint64 m_nextWrite;          //!< sequence number of the next chunk to write
+    std::map<quint64, std::pair<quint64, QByteArray>> m_compressed; //!< sequence number to (raw bytes, chunk) waiting for their turn
+    std::vector<IQCompression::IndexEntry> m_index;
+    quint64 m_fileOffset;
+    std::atomic<quint64> m_rawBytes;
+    std::atomic<quint64> m_compressedBytes;
+    std::atomic<quint64> m_chunksDropped;
+
+    void submitChunk();
+    void compressed(quint64 sequence, quint64 rawBytes, const QByteArray& chunk); //!< called from pool threads
+    void writeIndex();
+};
+
+#endif // SDRBASE_DSP_FILERECORDCOMPRESSOR_H_
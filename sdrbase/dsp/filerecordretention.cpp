@@ -0,0 +1,238 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include "filerecordretention.h"
+
+const char *FileRecordRetention::m_indexExtension = "sdriqseg";
+
+FileRecordRetention::FileRecordRetention() :
+    m_open(false),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_quotaBytes(0),
+    m_nbSegments(0),
+    m_nbDeleted(0),
+    m_stopRequested(false)
+{}
+
+FileRecordRetention::~FileRecordRetention()
+{
+    close();
+}
+
+void FileRecordRetention::open(const QString& indexFileName, quint32 sampleRate, quint64 centerFrequency, quint64 quotaBytes)
+{
+    if (m_open) {
+        return;
+    }
+
+    m_indexFileName = indexFileName;
+    m_sampleRate = sampleRate;
+    m_centerFrequency = centerFrequency;
+    m_quotaBytes = quotaBytes;
+    m_pending.clear();
+    m_segments.clear();
+    m_nbSegments = 0;
+    m_nbDeleted = 0;
+    m_stopRequested = false;
+    m_open = true;
+    start(QThread::LowPriority);
+}
+
+void FileRecordRetention::close()
+{
+    if (!m_open) {
+        return;
+    }
+
+    m_mutex.lock();
+    m_stopRequested = true;
+    m_segmentAdded.wakeOne();
+    m_mutex.unlock();
+    wait();
+    m_open = false;
+
+    qDebug("FileRecordRetention::close: %s: %u segments %u deleted",
+        qPrintable(m_indexFileName), m_nbSegments.load(), m_nbDeleted.load());
+}
+
+void FileRecordRetention::addSegment(const Segment& segment)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_pending.push_back(segment);
+    m_segmentAdded.wakeOne();
+}
+
+void FileRecordRetention::run()
+{
+    m_mutex.lock();
+
+    while (true)
+    {
+        if (m_pending.empty())
+        {
+            if (m_stopRequested) {
+                break;
+            }
+
+            m_segmentAdded.wait(&m_mutex);
+            continue;
+        }
+
+        while (!m_pending.empty())
+        {
+            m_segments.push_back(m_pending.front());
+            m_pending.pop_front();
+        }
+
+        m_mutex.unlock();
+
+        applyQuota();
+
+        if (!writeIndex(m_indexFileName, m_segments, m_sampleRate, m_centerFrequency)) {
+            qWarning("FileRecordRetention::run: cannot write %s", qPrintable(m_indexFileName));
+        }
+
+        m_nbSegments = m_segments.size();
+        m_mutex.lock();
+    }
+
+    m_mutex.unlock();
+}
+
+void FileRecordRetention::applyQuota()
+{
+    if (m_quotaBytes == 0) {
+        return;
+    }
+
+    quint64 totalBytes = 0;
+
+    for (const auto& segment : m_segments) {
+        totalBytes += QFileInfo(segment.m_fileName).size();
+    }
+
+    // the last segment is kept whatever its size
+    while ((totalBytes > m_quotaBytes) && (m_segments.size() > 1))
+    {
+        const Segment& oldest = m_segments.front();
+        quint64 size = QFileInfo(oldest.m_fileName).size();
+
+        if (!QFile::remove(oldest.m_fileName) && QFile::exists(oldest.m_fileName))
+        {
+            qWarning("FileRecordRetention::applyQuota: cannot delete %s", qPrintable(oldest.m_fileName));
+            break; // retried at next segment
+        }
+
+        qDebug("FileRecordRetention::applyQuota: deleted %s", qPrintable(oldest.m_fileName));
+        totalBytes -= size;
+        m_segments.erase(m_segments.begin());
+        m_nbDeleted++;
+    }
+}
+
+QString FileRecordRetention::getIndexFileName(const QString& fileName)
+{
+    QFileInfo fileInfo(fileName);
+    return fileInfo.path() + "/" + fileInfo.completeBaseName() + "." + m_indexExtension;
+}
+
+bool FileRecordRetention::isIndexFile(const QString& fileName)
+{
+    return QFileInfo(fileName).suffix() == m_indexExtension;
+}
+
+bool FileRecordRetention::readIndex(const QString& indexFileName, std::vector<Segment>& segments, QString& errorMessage)
+{
+    QFile file(indexFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        errorMessage = QString("Cannot open %1: %2").arg(indexFileName).arg(file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+
+    if (!doc.isObject())
+    {
+        errorMessage = QString("Invalid JSON in %1: %2").arg(indexFileName).arg(parseError.errorString());
+        return false;
+    }
+
+    QString path = QFileInfo(indexFileName).path();
+    QJsonArray segmentsArray = doc.object()["segments"].toArray();
+    segments.clear();
+
+    for (const auto& value : segmentsArray)
+    {
+        QJsonObject segmentObject = value.toObject();
+        Segment segment;
+        segment.m_fileName = path + "/" + segmentObject["fileName"].toString();
+        segment.m_startSample = (quint64) segmentObject["startSample"].toDouble();
+        segment.m_nbSamples = (quint64) segmentObject["samples"].toDouble();
+        segment.m_startTime = (qint64) segmentObject["startTime"].toDouble();
+        segments.push_back(segment);
+    }
+
+    if (segments.size() == 0)
+    {
+        errorMessage = QString("No segment in %1").arg(indexFileName);
+        return false;
+    }
+
+    return true;
+}
+
+bool FileRecordRetention::writeIndex(const QString& indexFileName, const std::vector<Segment>& segments, quint32 sampleRate, quint64 centerFrequency)
+{
+    QJsonArray segmentsArray;
+
+    for (const auto& segment : segments)
+    {
+        QJsonObject segmentObject;
+        segmentObject["fileName"] = QFileInfo(segment.m_fileName).fileName(); // segments stay next to the index
+        segmentObject["startSample"] = (double) segment.m_startSample;
+        segmentObject["samples"] = (double) segment.m_nbSamples;
+        segmentObject["startTime"] = (double) segment.m_startTime;
+        segmentsArray.append(segmentObject);
+    }
+
+    QJsonObject root;
+    root["sampleRate"] = (int) sampleRate;
+    root["centerFrequency"] = (double) centerFrequency;
+    root["segments"] = segmentsArray;
+
+    // readers never see a partially written index
+    QSaveFile file(indexFileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return file.commit();
+}
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Segments of a rolling I/Q recording                                           //
+//                                                                               //
+// Keeps the index of the segments of a recording up to date and deletes the     //
+// oldest segments to keep their total size under a quota. The index lists the   //
+// segments with their first sample and start time so that they can be played   //
+// back as a single recording. Disk operations are done in a background thread.  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDRETENTION_H_
+#define SDRBASE_DSP_FILERECORDRETENTION_H_
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "export.h"
+
+class SDRBASE_API FileRecordRetention : public QThread
+{
+    Q_OBJECT
+public:
+    struct Segment
+    {
+        QString m_fileName;    //!< absolute path when recording. File name only in the index
+        quint64 m_startSample; //!< index of the first sample since the start of the recording
+        quint64 m_nbSamples;
+        qint64 m_startTime;    //!< UTC ms since epoch of the first sample
+
+        Segment() : m_startSample(0), m_nbSamples(0), m_startTime(0) {}
+    };
+
+    static const char *m_indexExtension; //!< sdriqseg
+
+    FileRecordRetention();
+    virtual ~FileRecordRetention();
+
+    /** Starts the thread. No quota if quotaBytes is 0 */
+    void open(const QString& indexFileName, quint32 sampleRate, quint64 centerFrequency, quint64 quotaBytes);
+    void close(); //!< Writes the final index and stops the thread
+    bool isOpen() const { return m_open; }
+    void addSegment(const Segment& segment); //!< Completed segment. Thread safe
+
+    unsigned int getNbSegments() const { return m_nbSegments.load(); } //!< segments in the index
+    unsigned int getNbDeleted() const { return m_nbDeleted.load(); }   //!< segments deleted to stay under quota
+
+    static QString getIndexFileName(const QString& fileName); //!< index of the recording of this file name
+    static bool isIndexFile(const QString& fileName);
+    static bool readIndex(const QString& indexFileName, std::vector<Segment>& segments, QString& errorMessage); //!< file names are made absolute
+    static bool writeIndex(const QString& indexFileName, const std::vector<Segment>& segments, quint32 sampleRate, quint64 centerFrequency);
+
+private:
+    bool m_open;
+    QString m_indexFileName;
+    quint32 m_sampleRate;
+    quint64 m_centerFrequency;
+    quint64 m_quotaBytes;
+    std::deque<Segment> m_pending;   //!< segments added and not yet processed by the thread
+    std::vector<Segment> m_segments; //!< segments in the index (thread)
+    std::atomic<unsigned int> m_nbSegments;
+    std::atomic<unsigned int> m_nbDeleted;
+    bool m_stopRequested;
+    QMutex m_mutex;
+    QWaitCondition m_segmentAdded;
+
+    virtual void run();
+    void applyQuota();
+};
+
+#endif // SDRBASE_DSP_FILERECORDRETENTION_H_
@@ -0,0 +1,161 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+
+#include <QDebug>
+
+#include "filerecordsegmentreader.h"
+
+FileRecordSegmentReader::FileRecordSegmentReader() :
+    m_nbSamples(0),
+    m_sampleBytes(4),
+    m_sampleRate(0),
+    m_current(-1)
+{}
+
+FileRecordSegmentReader::~FileRecordSegmentReader()
+{
+    close();
+}
+
+bool FileRecordSegmentReader::open(const QString& indexFileName, FileRecord::Header& header, bool& crcOK, QString& errorMessage)
+{
+    close();
+
+    if (!FileRecordRetention::readIndex(indexFileName, m_segments, errorMessage)) {
+        return false;
+    }
+
+    const QString& firstFileName = m_segments.front().m_fileName;
+#ifdef Q_OS_WIN
+    std::ifstream stream(firstFileName.toStdWString().c_str(), std::ios::binary);
+#else
+    std::ifstream stream(firstFileName.toStdString().c_str(), std::ios::binary);
+#endif
+
+    if (!stream.is_open())
+    {
+        errorMessage = QString("Cannot open first segment %1").arg(firstFileName);
+        m_segments.clear();
+        return false;
+    }
+
+    crcOK = FileRecord::readHeader(stream, header);
+    m_sampleBytes = header.sampleSize > 16 ? 2 * sizeof(int32_t) : 2 * sizeof(int16_t);
+    m_sampleRate = header.sampleRate;
+
+    // segments deleted by the retention policy before the first one are not counted
+    quint64 firstSample = m_segments.front().m_startSample;
+
+    for (auto& segment : m_segments) {
+        segment.m_startSample -= firstSample;
+    }
+
+    m_nbSamples = m_segments.back().m_startSample + m_segments.back().m_nbSamples;
+    m_current = -1;
+
+    qDebug("FileRecordSegmentReader::open: %s: %lu segments %llu samples",
+        qPrintable(indexFileName), (unsigned long) m_segments.size(), m_nbSamples);
+    return true;
+}
+
+void FileRecordSegmentReader::close()
+{
+    m_reader.close();
+    m_segments.clear();
+    m_nbSamples = 0;
+    m_current = -1;
+}
+
+qint64 FileRecordSegmentReader::getDateTime(quint64 sampleIndex) const
+{
+    int index = findSegment(sampleIndex);
+
+    if ((index < 0) || (m_sampleRate == 0)) {
+        return getStartTime();
+    }
+
+    const FileRecordRetention::Segment& segment = m_segments[index];
+    return segment.m_startTime + (qint64) (((sampleIndex - segment.m_startSample) * 1000) / m_sampleRate);
+}
+
+void FileRecordSegmentReader::seek(quint64 sampleIndex)
+{
+    int index = findSegment(sampleIndex);
+
+    if (index < 0) {
+        return;
+    }
+
+    if ((index != m_current) && !openSegment(index)) {
+        return;
+    }
+
+    quint64 offset = (sampleIndex - m_segments[index].m_startSample) * m_sampleBytes;
+    m_reader.seek(sizeof(FileRecord::Header) + offset);
+}
+
+bool FileRecordSegmentReader::isEOF() const
+{
+    return (m_current < 0) || ((m_current == (int) m_segments.size() - 1) && m_reader.isEOF());
+}
+
+const char *FileRecordSegmentReader::next(qint64 size, qint64& nbBytes)
+{
+    // next segment as soon as the current one is read
+    // a segment that cannot be mapped is skipped
+    while ((m_current >= 0) && m_reader.isEOF() && (m_current + 1 < (int) m_segments.size())) {
+        openSegment(m_current + 1);
+    }
+
+    if (!m_reader.isOpen())
+    {
+        nbBytes = 0;
+        return nullptr;
+    }
+
+    // whole samples only
+    return m_reader.next(size - (size % m_sampleBytes), nbBytes);
+}
+
+bool FileRecordSegmentReader::openSegment(int index)
+{
+    m_reader.close();
+    m_current = index;
+
+    if (!m_reader.open(m_segments[index].m_fileName))
+    {
+        qWarning("FileRecordSegmentReader::openSegment: cannot map %s", qPrintable(m_segments[index].m_fileName));
+        return false;
+    }
+
+    m_reader.seek(sizeof(FileRecord::Header));
+    return true;
+}
+
+int FileRecordSegmentReader::findSegment(quint64 sampleIndex) const
+{
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), sampleIndex,
+        [](quint64 s, const FileRecordRetention::Segment& segment) {
+            return s < segment.m_startSample;
+        }
+    );
+
+    return (int) (it - m_segments.begin()) - 1;
+}
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Reader of the .sdriq segments of a rolling recording as one recording         //
+//                                                                               //
+// Segments are taken from the index written while recording and are memory     //
+// mapped one at a time. Sample indexes are counted from the first segment       //
+// still listed in the index.                                                    //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDSEGMENTREADER_H_
+#define SDRBASE_DSP_FILERECORDSEGMENTREADER_H_
+
+#include <vector>
+
+#include <QString>
+
+#include "dsp/filerecord.h"
+#include "dsp/filerecordretention.h"
+#include "util/mappedfilereader.h"
+#include "export.h"
+
+class SDRBASE_API FileRecordSegmentReader
+{
+public:
+    FileRecordSegmentReader();
+    ~FileRecordSegmentReader();
+
+    /** Reads the index and the header of the first segment. crcOK is the header CRC check */
+    bool open(const QString& indexFileName, FileRecord::Header& header, bool& crcOK, QString& errorMessage);
+    void close();
+    bool isOpen() const { return m_segments.size() > 0; }
+    quint64 getNbSamples() const { return m_nbSamples; }
+    qint64 getStartTime() const { return m_segments.size() > 0 ? m_segments.front().m_startTime : 0; } //!< UTC ms since epoch
+    unsigned int getNbSegments() const { return m_segments.size(); }
+    qint64 getDateTime(quint64 sampleIndex) const; //!< UTC ms since epoch of this sample
+
+    void seek(quint64 sampleIndex);
+    bool isEOF() const;
+    /** Returns a pointer to at most size bytes at the read position and moves past them. Reads stop at segment ends */
+    const char *next(qint64 size, qint64& nbBytes);
+
+private:
+    std::vector<FileRecordRetention::Segment> m_segments; //!< start samples relative to the first segment
+    quint64 m_nbSamples;
+    unsigned int m_sampleBytes; //!< bytes of an I/Q sample
+    quint32 m_sampleRate;
+    int m_current;              //!< index of the mapped segment
+    MappedFileReader m_reader;
+
+    bool openSegment(int index); //!< maps the segment and skips its header
+    int findSegment(quint64 sampleIndex) const;
+};
+
+#endif // SDRBASE_DSP_FILERECORDSEGMENTREADER_H_
@@ -0,0 +1,396 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "filerecordwriter.h"
+
+#define FILERECORDWRITER_ALIGNMENT 4096 // direct I/O alignment of buffers, sizes and offsets
+
+FileRecordWriter::FileRecordWriter() :
+    m_open(false),
+    m_directIO(false),
+    m_fd(-1),
+    m_buffer(nullptr),
+    m_blockSize(0),
+    m_nbBlocks(0),
+    m_fillOffset(0),
+    m_committed(0),
+    m_released(0),
+    m_bytesQueued(0),
+    m_bytesWritten(0),
+    m_bytesDropped(0),
+    m_writesDropped(0),
+    m_bandwidth(0.0f),
+    m_maxBlocksQueued(0),
+    m_writeError(false),
+    m_writerWaiting(false),
+    m_stopRequested(false),
+    m_fileBytes(0)
+{}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    close();
+}
+
+bool FileRecordWriter::open(const QString& fileName)
+{
+    if (m_open) {
+        return false;
+    }
+
+    // file format and write options do not change while recording
+    m_activeSettings = m_settings;
+    m_blockSize = ((m_activeSettings.m_blockSizeKB * 1024 + FILERECORDWRITER_ALIGNMENT - 1) / FILERECORDWRITER_ALIGNMENT) * FILERECORDWRITER_ALIGNMENT;
+    m_blockSize = std::max(m_blockSize, (std::size_t) FILERECORDWRITER_ALIGNMENT);
+    m_nbBlocks = std::max(2U, (unsigned int) (((quint64) m_activeSettings.m_bufferSizeMB * 1024 * 1024) / m_blockSize));
+
+    if (!openFile(fileName)) {
+        return false;
+    }
+
+    m_buffer = (char *) qMallocAligned(m_blockSize * m_nbBlocks, FILERECORDWRITER_ALIGNMENT);
+
+    if (!m_buffer)
+    {
+        qWarning("FileRecordWriter::open: cannot allocate %u blocks of %lu bytes", m_nbBlocks, (unsigned long) m_blockSize);
+        closeFile(0);
+        return false;
+    }
+
+    std::memset(m_buffer, 0, m_blockSize * m_nbBlocks); // fault pages in now rather than in the DSP thread
+    m_blockFill.assign(m_nbBlocks, 0);
+    m_fillOffset = 0;
+    m_committed = 0;
+    m_released = 0;
+    m_bytesQueued = 0;
+    m_bytesWritten = 0;
+    m_bytesDropped = 0;
+    m_writesDropped = 0;
+    m_bandwidth = 0.0f;
+    m_maxBlocksQueued = 0;
+    m_writeError = false;
+    m_writerWaiting = false;
+    m_stopRequested = false;
+    m_fileSwitches.clear();
+    m_fileBytes = 0;
+    m_open = true;
+    start();
+
+    qDebug("FileRecordWriter::open: %s %u blocks of %lu bytes%s",
+        qPrintable(fileName), m_nbBlocks, (unsigned long) m_blockSize, m_directIO ? " direct I/O" : "");
+    return true;
+}
+
+void FileRecordWriter::close()
+{
+    if (!m_open) {
+        return;
+    }
+
+    if (m_fillOffset > 0) {
+        commit();
+    }
+
+    m_mutex.lock();
+    m_stopRequested = true;
+    m_blockAvailable.wakeOne();
+    m_mutex.unlock();
+    wait();
+
+    closeFile(m_fileBytes);
+    qFreeAligned(m_buffer);
+    m_buffer = nullptr;
+    m_open = false;
+
+    qDebug("FileRecordWriter::close: %llu bytes written %llu bytes dropped max queue %u/%u blocks",
+        m_bytesWritten.load(), m_bytesDropped.load(), m_maxBlocksQueued.load(), m_nbBlocks);
+}
+
+bool FileRecordWriter::write(const char *data, std::size_t size)
+{
+    if (!m_open) {
+        return false;
+    }
+
+    if (m_writeError.load(std::memory_order_relaxed)) // recording is stopped
+    {
+        m_bytesDropped += size;
+        m_writesDropped++;
+        return false;
+    }
+
+    // blocks from released to committed - 1 are owned by the writer thread
+    quint64 queued = m_committed.load(std::memory_order_relaxed) - m_released.load(std::memory_order_acquire);
+    std::size_t free = (m_nbBlocks - queued) * m_blockSize - m_fillOffset;
+
+    if (size > free)
+    {
+        m_bytesDropped += size;
+        m_writesDropped++;
+        return false;
+    }
+
+    m_bytesQueued.fetch_add(size, std::memory_order_relaxed);
+
+    while (size > 0)
+    {
+        std::size_t chunk = std::min(size, m_blockSize - m_fillOffset);
+        char *block = m_buffer + (m_committed.load(std::memory_order_relaxed) % m_nbBlocks) * m_blockSize;
+        std::memcpy(block + m_fillOffset, data, chunk);
+        m_fillOffset += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_fillOffset == m_blockSize) {
+            commit();
+        }
+    }
+
+    return true;
+}
+
+bool FileRecordWriter::switchFile(const QString& fileName)
+{
+    if (!m_open) {
+        return false;
+    }
+
+    if (m_fillOffset > 0) { // last block of the current file may be partial
+        commit();
+    }
+
+    m_mutex.lock();
+    m_fileSwitches.push_back(std::pair<quint64, QString>(m_committed.load(std::memory_order_relaxed), fileName));
+    m_mutex.unlock();
+    return true;
+}
+
+float FileRecordWriter::getQueueFill() const
+{
+    if (m_nbBlocks == 0) {
+        return 0.0f;
+    }
+
+    quint64 queued = m_committed.load() - m_released.load();
+    return queued / (float) m_nbBlocks;
+}
+
+void FileRecordWriter::commit()
+{
+    quint64 committed = m_committed.load(std::memory_order_relaxed);
+    m_blockFill[committed % m_nbBlocks] = m_fillOffset;
+    m_fillOffset = 0;
+    m_committed.store(committed + 1); // sequentially consistent with m_writerWaiting
+
+    unsigned int queued = (unsigned int) (committed + 1 - m_released.load(std::memory_order_acquire));
+
+    if (queued > m_maxBlocksQueued.load(std::memory_order_relaxed)) {
+        m_maxBlocksQueued.store(queued, std::memory_order_relaxed);
+    }
+
+    // the mutex is only taken when the writer waits. Waking under the lock guarantees it does not miss the block
+    if (m_writerWaiting.load())
+    {
+        m_mutex.lock();
+        m_blockAvailable.wakeOne();
+        m_mutex.unlock();
+    }
+}
+
+void FileRecordWriter::run()
+{
+    QElapsedTimer timer;
+    quint64 bytesAtLastMeasure = 0;
+    timer.start();
+    m_mutex.lock();
+
+    while (true)
+    {
+        quint64 released = m_released.load(std::memory_order_relaxed);
+
+        if (released == m_committed.load(std::memory_order_acquire))
+        {
+            if (m_stopRequested) {
+                break;
+            }
+
+            // announce the wait then check again so that a block committed meanwhile is not missed
+            m_writerWaiting.store(true);
+
+            if (released == m_committed.load()) {
+                m_blockAvailable.wait(&m_mutex);
+            }
+
+            m_writerWaiting.store(false);
+            continue;
+        }
+
+        if (!m_fileSwitches.empty() && (m_fileSwitches.front().first == released))
+        {
+            QString fileName = m_fileSwitches.front().second;
+            m_fileSwitches.pop_front();
+            m_mutex.unlock();
+            closeFile(m_fileBytes);
+            m_fileBytes = 0;
+
+            if (!openFile(fileName)) {
+                m_writeError = true;
+            }
+        }
+        else
+        {
+            m_mutex.unlock();
+        }
+
+        unsigned int index = released % m_nbBlocks;
+        std::size_t size = m_blockFill[index];
+        std::size_t written = 0;
+
+        if (!m_writeError.load(std::memory_order_relaxed) && !writeBlock(m_buffer + index * m_blockSize, size, written))
+        {
+            qWarning("FileRecordWriter::run: write error after %llu bytes. Recording stopped", m_bytesWritten.load() + written);
+            m_writeError = true; // following blocks are discarded
+        }
+
+        // only what actually reached the file is counted as written
+        m_bytesWritten.fetch_add(written, std::memory_order_relaxed);
+        m_bytesDropped.fetch_add(size - written, std::memory_order_relaxed);
+        m_fileBytes += written;
+        m_released.store(released + 1, std::memory_order_release);
+
+        if (timer.elapsed() >= 1000)
+        {
+            quint64 bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+            m_bandwidth = (bytesWritten - bytesAtLastMeasure) * 1000.0f / timer.restart();
+            bytesAtLastMeasure = bytesWritten;
+        }
+
+        m_mutex.lock();
+    }
+
+    m_mutex.unlock();
+}
+
+bool FileRecordWriter::openFile(const QString& fileName)
+{
+#if defined(__linux__)
+    m_directIO = m_activeSettings.m_directIO;
+    m_fd = ::open(fileName.toStdString().c_str(), O_WRONLY | O_CREAT | O_TRUNC | (m_directIO ? O_DIRECT : 0), 0644);
+
+    if ((m_fd < 0) && m_directIO)
+    {
+        qWarning("FileRecordWriter::openFile: %s: direct I/O not supported. Using buffered I/O", qPrintable(fileName));
+        m_directIO = false;
+        m_fd = ::open(fileName.toStdString().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+
+    if (m_fd < 0)
+    {
+        qWarning("FileRecordWriter::openFile: cannot open %s: %s", qPrintable(fileName), strerror(errno));
+        return false;
+    }
+
+    if (m_activeSettings.m_preallocateMB > 0)
+    {
+        int res = posix_fallocate(m_fd, 0, (off_t) m_activeSettings.m_preallocateMB * 1024 * 1024);
+
+        if (res != 0) {
+            qWarning("FileRecordWriter::openFile: %s: cannot preallocate: %s", qPrintable(fileName), strerror(res));
+        }
+    }
+
+    return true;
+#else
+    m_directIO = false;
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning("FileRecordWriter::openFile: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    return true;
+#endif
+}
+
+bool FileRecordWriter::writeBlock(const char *data, std::size_t size, std::size_t& written)
+{
+    written = 0;
+#if defined(__linux__)
+    // with direct I/O only the last block may be partial. It is padded and the file is truncated at close.
+    std::size_t toWrite = m_directIO ?
+        ((size + FILERECORDWRITER_ALIGNMENT - 1) / FILERECORDWRITER_ALIGNMENT) * FILERECORDWRITER_ALIGNMENT : size;
+    std::size_t done = 0;
+
+    while (done < toWrite)
+    {
+        ssize_t res = ::write(m_fd, data + done, toWrite - done);
+
+        if (res < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            qWarning("FileRecordWriter::writeBlock: %s", strerror(errno));
+            written = std::min(done, size); // padding is not data
+            return false;
+        }
+
+        done += res;
+    }
+
+    written = size;
+    return true;
+#else
+    qint64 res = m_file.write(data, size);
+    written = res > 0 ? (std::size_t) res : 0;
+    return res == (qint64) size;
+#endif
+}
+
+void FileRecordWriter::closeFile(quint64 fileSize)
+{
+#if defined(__linux__)
+    if (m_fd < 0) {
+        return;
+    }
+
+    if ((m_directIO || (m_activeSettings.m_preallocateMB > 0)) && (ftruncate(m_fd, (off_t) fileSize) != 0)) {
+        qWarning("FileRecordWriter::closeFile: cannot truncate: %s", strerror(errno));
+    }
+
+    ::close(m_fd);
+    m_fd = -1;
+#else
+    (void) fileSize;
+    m_file.close();
+#endif
+}
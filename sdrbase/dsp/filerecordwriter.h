@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Asynchronous file writer for recorders                                        //
+//                                                                               //
+// The producer copies data into a ring of preallocated aligned blocks and a     //
+// dedicated thread writes full blocks to disk so that disk latency never        //
+// stalls the DSP thread. If the ring is full incoming data is dropped.          //
+// Optionally uses direct I/O and preallocates the file (Linux only).            //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "export.h"
+
+class SDRBASE_API FileRecordWriter : public QThread
+{
+    Q_OBJECT
+public:
+    struct Settings
+    {
+        unsigned int m_bufferSizeMB;  //!< size of the ring of blocks in MB
+        unsigned int m_blockSizeKB;   //!< size of one block in kB (multiple of 4)
+        bool m_directIO;              //!< bypass the page cache (Linux only)
+        unsigned int m_preallocateMB; //!< preallocate the file on disk (Linux only). File is truncated to its actual size at close
+
+        Settings() :
+            m_bufferSizeMB(64),
+            m_blockSizeKB(1024),
+            m_directIO(false),
+            m_preallocateMB(0)
+        {}
+    };
+
+    FileRecordWriter();
+    virtual ~FileRecordWriter();
+
+    void setSettings(const Settings& settings) { m_settings = settings; } //!< Effective at next open. Settings are latched by open
+    const Settings& getSettings() const { return m_settings; }
+    bool open(const QString& fileName);
+    void close();             //!< Flush the ring, stop the thread and close the file
+    bool isOpen() const { return m_open; }
+    /**
+     * Data written after this call goes to a new file. The switch is done by the writer thread
+     * when it reaches this point in the ring. Called from the producer thread.
+     */
+    bool switchFile(const QString& fileName);
+
+    /**
+     * Copy data to the ring. Called from a single producer thread. All data is dropped if it
+     * cannot fit in the free blocks or after a write error. Returns false if data was dropped.
+     */
+    bool write(const char *data, std::size_t size);
+
+    quint64 getBytesWritten() const { return m_bytesWritten.load(); }    //!< bytes actually written to disk
+    quint64 getBytesQueued() const { return m_bytesQueued.load(); }      //!< bytes accepted by write
+    quint64 getBytesDropped() const { return m_bytesDropped.load(); }
+    quint64 getWritesDropped() const { return m_writesDropped.load(); }  //!< number of write calls dropped
+    float getBandwidth() const { return m_bandwidth.load(); }            //!< disk write bandwidth in bytes per second
+    float getQueueFill() const;                                          //!< fraction of blocks waiting for disk
+    unsigned int getMaxBlocksQueued() const { return m_maxBlocksQueued.load(); }
+    unsigned int getNbBlocks() const { return m_nbBlocks; }
+    bool hasWriteError() const { return m_writeError.load(); }
+
+private:
+    Settings m_settings;
+    Settings m_activeSettings; //!< settings of the open recording
+    bool m_open;
+    bool m_directIO;
+    int m_fd;           //!< POSIX file descriptor when available
+    QFile m_file;       //!< fallback
+    char *m_buffer;
+    std::size_t m_blockSize;
+    unsigned int m_nbBlocks;
+    std::vector<std::size_t> m_blockFill;   //!< bytes in each block
+    std::size_t m_fillOffset;               //!< bytes in the block being filled (producer side)
+    std::atomic<quint64> m_committed;       //!< number of blocks handed over to the writer thread
+    std::atomic<quint64> m_released;        //!< number of blocks written
+    std::atomic<quint64> m_bytesQueued;
+    std::atomic<quint64> m_bytesWritten;
+    std::atomic<quint64> m_bytesDropped;
+    std::atomic<quint64> m_writesDropped;
+    std::atomic<float> m_bandwidth;
+    std::atomic<unsigned int> m_maxBlocksQueued;
+    std::atomic<bool> m_writeError;
+    QMutex m_mutex;
+    QWaitCondition m_blockAvailable;
+    std::atomic<bool> m_writerWaiting;  //!< writer thread is about to wait for a block
+    bool m_stopRequested;
+    std::deque<std::pair<quint64, QString>> m_fileSwitches; //!< first block and name of the next files
+    quint64 m_fileBytes;                //!< bytes written to the current file (writer thread)
+
+    virtual void run();
+    void commit();
+    bool openFile(const QString& fileName);
+    bool writeBlock(const char *data, std::size_t size, std::size_t& written);
+    void closeFile(quint64 fileSize);
+};
+
+#endif // SDRBASE_DSP_FILERECORDWRITER_H_
@@ -47,6 +47,8 @@ void GLSpectrumSettings::resetToDefaults()
 	m_averagingMode = AvgModeNone;
 	m_averagingIndex = 0;
 	m_linear = false;
+	m_zoomFrequencyOffset = 0;
+	m_zoomLog2Decim = 0;
 }
 
 QByteArray GLSpectrumSettings::serialize() const
@@ -74,6 +76,8 @@ QByteArray GLSpectrumSettings::serialize() const
 	s.writeS32(19, (int) m_averagingMode);
 	s.writeS32(20, (qint32) getAveragingValue(m_averagingIndex, m_averagingMode));
 	s.writeBool(21, m_linear);
+	s.writeS64(22, m_zoomFrequencyOffset);
+	s.writeS32(23, m_zoomLog2Decim);
 
 	return s.final();
 }
@@ -111,11 +115,13 @@ bool GLSpectrumSettings::deserialize(const QByteArray& data)
 		d.readS32(17, &m_displayTraceIntensity, 50);
 		d.readReal(18, &m_waterfallShare, 0.66);
 		d.readS32(19, &tmp, 0);
-		m_averagingMode = tmp < 0 ? AvgModeNone : tmp > 3 ? AvgModeMax : (AveragingMode) tmp;
+		m_averagingMode = tmp < 0 ? AvgModeNone : tmp > 4 ? AvgModeWelch : (AveragingMode) tmp;
 		d.readS32(20, &tmp, 0);
 		m_averagingIndex = getAveragingIndex(tmp, m_averagingMode);
 	    m_averagingNb = getAveragingValue(m_averagingIndex, m_averagingMode);
 	    d.readBool(21, &m_linear, false);
+		d.readS64(22, &m_zoomFrequencyOffset, 0);
+		d.readS32(23, &m_zoomLog2Decim, 0);
 
 		return true;
 	}
@@ -186,4 +192,13 @@ int GLSpectrumSettings::getAveragingIndex(int averagingValue, AveragingMode aver
     }
 
     return 3*getAveragingMaxScale(averagingMode) + 3;
-}
\ No newline at end of file
+}
+
+qint64 GLSpectrumSettings::getZoomMaxFrequencyOffset(int sampleRate, int zoomLog2Decim)
+{
+    if ((sampleRate <= 0) || (zoomLog2Decim <= 0)) {
+        return 0;
+    }
+
+    return (sampleRate - (sampleRate >> zoomLog2Decim)) / 2;
+}
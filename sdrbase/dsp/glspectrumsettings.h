@@ -33,7 +33,8 @@ public:
         AvgModeNone,
         AvgModeMoving,
         AvgModeFixed,
-        AvgModeMax
+        AvgModeMax,
+        AvgModeWelch
     };
 
 	int m_fftSize;
@@ -58,6 +59,10 @@ public:
 	int m_averagingIndex;
 	unsigned int m_averagingNb;
 	bool m_linear; //!< linear else logarithmic scale
+	qint64 m_zoomFrequencyOffset; //!< zoomed sub-band center offset from device center frequency (Hz)
+	int m_zoomLog2Decim; //!< zoomed sub-band span as log2 of decimation of device sample rate (0: no zoom)
+
+    static const int m_zoomMaxLog2Decim = 6; //!< maximum zoom decimation is 64
 
     GLSpectrumSettings();
 	virtual ~GLSpectrumSettings();
@@ -69,6 +74,7 @@ public:
     static int getAveragingMaxScale(AveragingMode averagingMode);
     static int getAveragingValue(int averagingIndex, AveragingMode averagingMode);
     static int getAveragingIndex(int averagingValue, AveragingMode averagingMode);
+    static qint64 getZoomMaxFrequencyOffset(int sampleRate, int zoomLog2Decim); //!< zoomed sub-band must stay within device band
 };
 
 #endif // SDRBASE_DSP_GLSPECTRUMSETTNGS_H
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "iqcompression.h"
+
+#define IQCOMPRESSION_DEFLATE_LEVEL 1 // fastest: most of the gain is in the byte planes
+
+const quint32 IQCompression::m_chunkMagic = 0x435a5149; // "IQZC"
+const char IQCompression::m_fileMagic[8] = {'S', 'D', 'R', 'I', 'Q', 'Z', 1, 0};
+const char IQCompression::m_trailerMagic[8] = {'S', 'D', 'R', 'I', 'Q', 'Z', 'I', 'X'};
+
+template<typename T, typename U>
+void IQCompression::toPlanes(const T *samples, unsigned int nbSamples, quint8 *planes)
+{
+    const unsigned int nbPlanes = sizeof(T);
+    const unsigned int signShift = 8*sizeof(T) - 1;
+
+    for (unsigned int c = 0; c < 2; c++) // I then Q
+    {
+        U previous = 0;
+        quint8 *componentPlanes = planes + c * nbPlanes * nbSamples;
+
+        for (unsigned int n = 0; n < nbSamples; n++)
+        {
+            U x = (U) samples[2*n + c];
+            U delta = x - previous; // modulo arithmetic keeps it lossless
+            previous = x;
+            U zigzag = (U) (delta << 1) ^ (U) (((T) delta) >> signShift);
+
+            for (unsigned int p = 0; p < nbPlanes; p++) {
+                componentPlanes[p*nbSamples + n] = (quint8) (zigzag >> (8*p));
+            }
+        }
+    }
+}
+
+template<typename T, typename U>
+void IQCompression::fromPlanes(const quint8 *planes, unsigned int nbSamples, T *samples)
+{
+    const unsigned int nbPlanes = sizeof(T);
+
+    for (unsigned int c = 0; c < 2; c++)
+    {
+        U previous = 0;
+        const quint8 *componentPlanes = planes + c * nbPlanes * nbSamples;
+
+        for (unsigned int n = 0; n < nbSamples; n++)
+        {
+            U zigzag = 0;
+
+            for (unsigned int p = 0; p < nbPlanes; p++) {
+                zigzag |= ((U) componentPlanes[p*nbSamples + n]) << (8*p);
+            }
+
+            U delta = (U) (zigzag >> 1) ^ (U) (0 - (zigzag & 1));
+            previous += delta;
+            samples[2*n + c] = (T) previous;
+        }
+    }
+}
+
+IQCompression::Codec IQCompression::encode(const char *samples, unsigned int nbSamples, unsigned int sampleBytes, QByteArray& payload)
+{
+    unsigned int rawSize = nbSamples * 2 * sampleBytes;
+    std::vector<quint8> planes(rawSize);
+
+    if (sampleBytes == 2) {
+        toPlanes<qint16, quint16>((const qint16 *) samples, nbSamples, planes.data());
+    } else {
+        toPlanes<qint32, quint32>((const qint32 *) samples, nbSamples, planes.data());
+    }
+
+    payload = qCompress(planes.data(), rawSize, IQCOMPRESSION_DEFLATE_LEVEL);
+
+    if ((unsigned int) payload.size() < rawSize) {
+        return CodecDeltaPlanes;
+    }
+
+    payload = QByteArray(samples, rawSize);
+    return CodecRaw;
+}
+
+bool IQCompression::decode(quint32 codec, const char *payload, unsigned int size, unsigned int nbSamples, unsigned int sampleBytes, char *samples)
+{
+    unsigned int rawSize = nbSamples * 2 * sampleBytes;
+
+    if (codec == CodecRaw)
+    {
+        if (size != rawSize) {
+            return false;
+        }
+
+        memcpy(samples, payload, rawSize);
+        return true;
+    }
+    else if (codec == CodecDeltaPlanes)
+    {
+        QByteArray planes = qUncompress((const uchar *) payload, size);
+
+        if ((unsigned int) planes.size() != rawSize) {
+            return false;
+        }
+
+        if (sampleBytes == 2) {
+            fromPlanes<qint16, quint16>((const quint8 *) planes.constData(), nbSamples, (qint16 *) samples);
+        } else {
+            fromPlanes<qint32, quint32>((const quint8 *) planes.constData(), nbSamples, (qint32 *) samples);
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Lossless compression of I/Q recordings                                        //
+//                                                                               //
+// Samples are cut in chunks. In each chunk I and Q are delta coded separately,  //
+// zigzag mapped to unsigned values and split in byte planes before deflate.     //
+// Noise-like signals of low level leave the upper byte planes almost constant   //
+// which is where most of the gain comes from.                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_IQCOMPRESSION_H_
+#define SDRBASE_DSP_IQCOMPRESSION_H_
+
+#include <cstring>
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Compressed I/Q file (.sdriqz) layout:
+ *   - FileHeader followed by the 32 bytes .sdriq header (FileRecord::Header)
+ *   - chunks: ChunkHeader followed by m_size bytes of payload
+ *   - index: IndexEntry for each chunk followed by the Trailer
+ * The index is written when recording stops. If it is missing (interrupted recording) it is
+ * rebuilt by scanning the chunk headers. Samples missing between chunks (dropped when compression
+ * could not keep up) are found with the first sample index of each chunk.
+ */
+class SDRBASE_API IQCompression
+{
+public:
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        char m_magic[8];         //!< "SDRIQZ" followed by version byte and 0
+    };
+
+    struct ChunkHeader
+    {
+        quint32 m_magic;         //!< m_chunkMagic
+        quint32 m_codec;         //!< Codec
+        quint32 m_nbSamples;     //!< number of I/Q samples
+        quint32 m_size;          //!< payload size in bytes
+        quint64 m_firstSample;   //!< index of the first sample since start of recording
+    };
+
+    struct IndexEntry
+    {
+        quint64 m_firstSample;
+        quint64 m_offset;        //!< offset of the chunk header in the file
+        quint32 m_nbSamples;
+        quint32 m_size;          //!< chunk size including header
+    };
+
+    struct Trailer
+    {
+        quint64 m_indexOffset;   //!< offset of the first index entry in the file
+        quint64 m_nbSamples;     //!< total number of samples fed including dropped ones
+        quint32 m_nbEntries;
+        quint32 m_crc32;         //!< of the index entries
+        char m_magic[8];         //!< "SDRIQZIX"
+    };
+#pragma pack(pop)
+
+    enum Codec
+    {
+        CodecRaw,        //!< samples as in .sdriq files (used when compression does not gain)
+        CodecDeltaPlanes //!< delta, zigzag and byte planes then deflate
+    };
+
+    static const quint32 m_chunkMagic;
+    static const char m_fileMagic[8];
+    static const char m_trailerMagic[8];
+
+    /**
+     * Compress nbSamples I/Q samples of sampleBytes bytes per component (2 or 4).
+     * Payload is replaced. Returns the codec used.
+     */
+    static Codec encode(const char *samples, unsigned int nbSamples, unsigned int sampleBytes, QByteArray& payload);
+
+    /**
+     * Decompress a chunk payload to nbSamples I/Q samples in samples.
+     * Returns false if the payload is corrupted.
+     */
+    static bool decode(quint32 codec, const char *payload, unsigned int size, unsigned int nbSamples, unsigned int sampleBytes, char *samples);
+
+    static bool isCompressedFile(const char *magic) { return memcmp(magic, m_fileMagic, 6) == 0; }
+
+private:
+    template<typename T, typename U>
+    static void toPlanes(const T *samples, unsigned int nbSamples, quint8 *planes);
+    template<typename T, typename U>
+    static void fromPlanes(const quint8 *planes, unsigned int nbSamples, T *samples);
+};
+
+#endif // SDRBASE_DSP_IQCOMPRESSION_H_
@@ -18,6 +18,11 @@
 
 #define _USE_MATH_DEFINES
 #include <math.h>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 #include "projector.h"
 
 Projector::Projector(ProjectionType projectionType) :
@@ -34,188 +39,268 @@ Projector::~Projector()
 
 Real Projector::run(const Sample& s)
 {
-    Real v;
-
     if ((m_cache) && !m_cacheMaster) {
         return m_cache[(int) m_projectionType];
     }
     else
     {
-        switch (m_projectionType)
-        {
-        case ProjectionImag:
-            v = s.m_imag / SDR_RX_SCALEF;
-            break;
-        case ProjectionMagLin:
-        {
-            Real re = s.m_real / SDR_RX_SCALEF;
-            Real im = s.m_imag / SDR_RX_SCALEF;
-            Real magsq = re*re + im*im;
-            v = std::sqrt(magsq);
-        }
-            break;
-        case ProjectionMagSq:
-        {
-            Real re = s.m_real / SDR_RX_SCALEF;
-            Real im = s.m_imag / SDR_RX_SCALEF;
-            v = re*re + im*im;
+        Real v = project(s);
+
+        if (m_cache) {
+            m_cache[(int) m_projectionType] = v;
         }
-            break;
-        case ProjectionMagDB:
-        {
-            Real re = s.m_real / SDR_RX_SCALEF;
-            Real im = s.m_imag / SDR_RX_SCALEF;
-            Real magsq = re*re + im*im;
-            v = log10f(magsq) * 10.0f;
+
+        return v;
+    }
+}
+
+Real Projector::project(const Sample& s)
+{
+    Real v;
+
+    switch (m_projectionType)
+    {
+    case ProjectionImag:
+        v = s.m_imag / SDR_RX_SCALEF;
+        break;
+    case ProjectionMagLin:
+    {
+        Real re = s.m_real / SDR_RX_SCALEF;
+        Real im = s.m_imag / SDR_RX_SCALEF;
+        Real magsq = re*re + im*im;
+        v = std::sqrt(magsq);
+    }
+        break;
+    case ProjectionMagSq:
+    {
+        Real re = s.m_real / SDR_RX_SCALEF;
+        Real im = s.m_imag / SDR_RX_SCALEF;
+        v = re*re + im*im;
+    }
+        break;
+    case ProjectionMagDB:
+    {
+        Real re = s.m_real / SDR_RX_SCALEF;
+        Real im = s.m_imag / SDR_RX_SCALEF;
+        Real magsq = re*re + im*im;
+        v = log10f(magsq) * 10.0f;
+    }
+        break;
+    case ProjectionPhase:
+        v = std::atan2((float) s.m_imag, (float) s.m_real) / M_PI; // normalize
+        break;
+    case ProjectionDOAP:
+    {
+        // calculate phase. Assume phase difference between two sources at half wavelength distance with sources axis as reference (positive side)
+        // cos(theta) = phi / 2*pi*k
+        Real p = std::atan2((float) s.m_imag, (float) s.m_real); // do not mormalize phi (phi in -pi..+pi)
+        v = acos(p/M_PI) / M_PI; // normalize theta
+    }
+        break;
+    case ProjectionDOAN:
+    {
+        // calculate phase. Assume phase difference between two sources at half wavelength distance with sources axis as reference (negative source)
+        Real p = std::atan2((float) s.m_imag, (float) s.m_real); // do not mormalize phi (phi in -pi..+pi)
+        v = -acos(p/M_PI) / M_PI; // normalize theta
+    }
+        break;
+    case ProjectionDPhase:
+    {
+        Real curArg = std::atan2((float) s.m_imag, (float) s.m_real);
+        Real dPhi = (curArg - m_prevArg) / M_PI;
+        m_prevArg = curArg;
+
+        if (dPhi < -1.0f) {
+            dPhi += 2.0f;
+        } else if (dPhi > 1.0f) {
+            dPhi -= 2.0f;
         }
-            break;
-        case ProjectionPhase:
-            v = std::atan2((float) s.m_imag, (float) s.m_real) / M_PI; // normalize
-            break;
-        case ProjectionDOAP:
-        {
-            // calculate phase. Assume phase difference between two sources at half wavelength distance with sources axis as reference (positive side)
-            // cos(theta) = phi / 2*pi*k
-            Real p = std::atan2((float) s.m_imag, (float) s.m_real); // do not mormalize phi (phi in -pi..+pi)
-            v = acos(p/M_PI) / M_PI; // normalize theta
+
+        v = dPhi;
+    }
+        break;
+    case ProjectionBPSK:
+    {
+        Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
+        v = normalizeAngle(2*arg) / (2.0*M_PI); // generic estimation around 0
+        // mapping on 2 symbols
+        if (arg < -M_PI/2) {
+            v -= 1.0/2;
+        } else if (arg < M_PI/2) {
+            v += 1.0/2;
+        } else if (arg < M_PI) {
+            v -= 1.0/2;
         }
-            break;
-        case ProjectionDOAN:
-        {
-            // calculate phase. Assume phase difference between two sources at half wavelength distance with sources axis as reference (negative source)
-            Real p = std::atan2((float) s.m_imag, (float) s.m_real); // do not mormalize phi (phi in -pi..+pi)
-            v = -acos(p/M_PI) / M_PI; // normalize theta
+    }
+        break;
+    case ProjectionQPSK:
+    {
+        Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
+        v = normalizeAngle(4*arg) / (4.0*M_PI); // generic estimation around 0
+        // mapping on 4 symbols
+        if (arg < -3*M_PI/4) {
+            v -= 3.0/4;
+        } else if (arg < -M_PI/4) {
+            v -= 1.0/4;
+        } else if (arg < M_PI/4) {
+            v += 1.0/4;
+        } else if (arg < 3*M_PI/4) {
+            v += 3.0/4;
+        } else if (arg < M_PI) {
+            v -= 3.0/4;
         }
-            break;
-        case ProjectionDPhase:
-        {
-            Real curArg = std::atan2((float) s.m_imag, (float) s.m_real);
-            Real dPhi = (curArg - m_prevArg) / M_PI;
-            m_prevArg = curArg;
-
-            if (dPhi < -1.0f) {
-                dPhi += 2.0f;
-            } else if (dPhi > 1.0f) {
-                dPhi -= 2.0f;
-            }
-
-            v = dPhi;
+    }
+        break;
+    case Projection8PSK:
+    {
+        Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
+        v = normalizeAngle(8*arg) / (8.0*M_PI); // generic estimation around 0
+        // mapping on 8 symbols
+        if (arg < -7*M_PI/8) {
+           v -= 7.0/8;
+        } else if (arg < -5*M_PI/8) {
+            v -= 5.0/8;
+        } else if (arg < -3*M_PI/8) {
+            v -= 3.0/8;
+        } else if (arg < -M_PI/8) {
+            v -= 1.0/8;
+        } else if (arg < M_PI/8) {
+            v += 1.0/8;
+        } else if (arg < 3*M_PI/8) {
+            v += 3.0/8;
+        } else if (arg < 5*M_PI/8) {
+            v += 5.0/8;
+        } else if (arg < 7*M_PI/8) {
+            v += 7.0/8;
+        } else if (arg < M_PI) {
+            v -= 7.0/8;
         }
-            break;
-        case ProjectionBPSK:
-        {
-            Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
-            v = normalizeAngle(2*arg) / (2.0*M_PI); // generic estimation around 0
-            // mapping on 2 symbols
-            if (arg < -M_PI/2) {
-                v -= 1.0/2;
-            } else if (arg < M_PI/2) {
-                v += 1.0/2;
-            } else if (arg < M_PI) {
-                v -= 1.0/2;
-            }
+    }
+        break;
+    case Projection16PSK:
+    {
+        Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
+        v = normalizeAngle(16*arg) / (16.0*M_PI); // generic estimation around 0
+        // mapping on 16 symbols
+        if (arg < -15*M_PI/16) {
+           v -= 15.0/16;
+        } else if (arg < -13*M_PI/16) {
+            v -= 13.0/6;
+        } else if (arg < -11*M_PI/16) {
+            v -= 11.0/16;
+        } else if (arg < -9*M_PI/16) {
+            v -= 9.0/16;
+        } else if (arg < -7*M_PI/16) {
+            v -= 7.0/16;
+        } else if (arg < -5*M_PI/16) {
+            v -= 5.0/16;
+        } else if (arg < -3*M_PI/16) {
+            v -= 3.0/16;
+        } else if (arg < -M_PI/16) {
+            v -= 1.0/16;
+        } else if (arg < M_PI/16) {
+            v += 1.0/16;
+        } else if (arg < 3.0*M_PI/16) {
+            v += 3.0/16;
+        } else if (arg < 5.0*M_PI/16) {
+            v += 5.0/16;
+        } else if (arg < 7.0*M_PI/16) {
+            v += 7.0/16;
+        } else if (arg < 9.0*M_PI/16) {
+            v += 9.0/16;
+        } else if (arg < 11.0*M_PI/16) {
+            v += 11.0/16;
+        } else if (arg < 13.0*M_PI/16) {
+            v += 13.0/16;
+        } else if (arg < 15.0*M_PI/16) {
+            v += 15.0/16;
+        } else if (arg < M_PI) {
+            v -= 15.0/16;
         }
-            break;
-        case ProjectionQPSK:
+    }
+        break;
+    case ProjectionReal:
+    default:
+        v = s.m_real / SDR_RX_SCALEF;
+        break;
+    }
+
+    return v;
+}
+
+void Projector::runBlock(const Sample *samples, int count, Real *projected)
+{
+    int i = 0;
+
+    switch (m_projectionType)
+    {
+    case ProjectionReal:
+    case ProjectionImag:
+    case ProjectionMagLin:
+    case ProjectionMagSq:
+    case ProjectionMagDB:
+    {
+#if defined(USE_SSE2)
+        const __m128 scale = _mm_set1_ps(1.0f / SDR_RX_SCALEF); // exact as the scale is a power of two
+
+        for (; i + 4 <= count; i += 4)
         {
-            Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
-            v = normalizeAngle(4*arg) / (4.0*M_PI); // generic estimation around 0
-            // mapping on 4 symbols
-            if (arg < -3*M_PI/4) {
-                v -= 3.0/4;
-            } else if (arg < -M_PI/4) {
-                v -= 1.0/4;
-            } else if (arg < M_PI/4) {
-                v += 1.0/4;
-            } else if (arg < 3*M_PI/4) {
-                v += 3.0/4;
-            } else if (arg < M_PI) {
-                v -= 3.0/4;
+#if SDR_RX_SAMP_SZ == 16
+            __m128i iq = _mm_loadu_si128((const __m128i*) &samples[i]);
+            // sign extend I/Q pairs to 32 bits
+            __m128 iq01 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(iq, iq), 16));
+            __m128 iq23 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(iq, iq), 16));
+#else
+            __m128 iq01 = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &samples[i]));
+            __m128 iq23 = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &samples[i+2]));
+#endif
+            __m128 re = _mm_mul_ps(_mm_shuffle_ps(iq01, iq23, _MM_SHUFFLE(2,0,2,0)), scale);
+            __m128 im = _mm_mul_ps(_mm_shuffle_ps(iq01, iq23, _MM_SHUFFLE(3,1,3,1)), scale);
+            __m128 v;
+
+            if (m_projectionType == ProjectionReal) {
+                v = re;
+            } else if (m_projectionType == ProjectionImag) {
+                v = im;
+            } else if (m_projectionType == ProjectionMagLin) {
+                v = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im)));
+            } else { // squared magnitude. dB is taken below
+                v = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
             }
+
+            _mm_storeu_ps(&projected[i], v);
         }
-            break;
-        case Projection8PSK:
+
+        if (m_projectionType == ProjectionMagDB)
         {
-            Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
-            v = normalizeAngle(8*arg) / (8.0*M_PI); // generic estimation around 0
-            // mapping on 8 symbols
-            if (arg < -7*M_PI/8) {
-               v -= 7.0/8;
-            } else if (arg < -5*M_PI/8) {
-                v -= 5.0/8;
-            } else if (arg < -3*M_PI/8) {
-                v -= 3.0/8;
-            } else if (arg < -M_PI/8) {
-                v -= 1.0/8;
-            } else if (arg < M_PI/8) {
-                v += 1.0/8;
-            } else if (arg < 3*M_PI/8) {
-                v += 3.0/8;
-            } else if (arg < 5*M_PI/8) {
-                v += 5.0/8;
-            } else if (arg < 7*M_PI/8) {
-                v += 7.0/8;
-            } else if (arg < M_PI) {
-                v -= 7.0/8;
+            for (int j = 0; j < i; j++) {
+                projected[j] = log10f(projected[j]) * 10.0f;
             }
         }
-            break;
-        case Projection16PSK:
-        {
-            Real arg = std::atan2((float) s.m_imag, (float) s.m_real);
-            v = normalizeAngle(16*arg) / (16.0*M_PI); // generic estimation around 0
-            // mapping on 16 symbols
-            if (arg < -15*M_PI/16) {
-               v -= 15.0/16;
-            } else if (arg < -13*M_PI/16) {
-                v -= 13.0/6;
-            } else if (arg < -11*M_PI/16) {
-                v -= 11.0/16;
-            } else if (arg < -9*M_PI/16) {
-                v -= 9.0/16;
-            } else if (arg < -7*M_PI/16) {
-                v -= 7.0/16;
-            } else if (arg < -5*M_PI/16) {
-                v -= 5.0/16;
-            } else if (arg < -3*M_PI/16) {
-                v -= 3.0/16;
-            } else if (arg < -M_PI/16) {
-                v -= 1.0/16;
-            } else if (arg < M_PI/16) {
-                v += 1.0/16;
-            } else if (arg < 3.0*M_PI/16) {
-                v += 3.0/16;
-            } else if (arg < 5.0*M_PI/16) {
-                v += 5.0/16;
-            } else if (arg < 7.0*M_PI/16) {
-                v += 7.0/16;
-            } else if (arg < 9.0*M_PI/16) {
-                v += 9.0/16;
-            } else if (arg < 11.0*M_PI/16) {
-                v += 11.0/16;
-            } else if (arg < 13.0*M_PI/16) {
-                v += 13.0/16;
-            } else if (arg < 15.0*M_PI/16) {
-                v += 15.0/16;
-            } else if (arg < M_PI) {
-                v -= 15.0/16;
-            }
+#endif
+        for (; i < count; i++) {
+            projected[i] = project(samples[i]);
         }
-            break;
-        case ProjectionReal:
-        default:
-            v = s.m_real / SDR_RX_SCALEF;
-            break;
+    }
+        break;
+    case ProjectionPhase:
+        for (; i < count; i++) {
+            projected[i] = std::atan2((float) samples[i].m_imag, (float) samples[i].m_real) / M_PI;
         }
-
-        if (m_cache) {
-            m_cache[(int) m_projectionType] = v;
+        break;
+    default: // other phase based projections
+        for (; i < count; i++) {
+            projected[i] = project(samples[i]);
         }
-
-        return v;
+        break;
     }
 }
 
+void Projector::setPreviousSample(const Sample& s)
+{
+    m_prevArg = std::atan2((float) s.m_imag, (float) s.m_real);
+}
+
 Real Projector::normalizeAngle(Real angle)
 {
     while (angle <= -M_PI) {
@@ -49,9 +49,14 @@ public:
     void setCacheMaster(bool cacheMaster) { m_cacheMaster = cacheMaster; }
 
     Real run(const Sample& s);
+    /** Projects a block of samples. Does not use the cache */
+    void runBlock(const Sample *samples, int count, Real *projected);
+    /** Sets the state of projections depending on the previous sample (phase derivative) as if s was the last sample projected */
+    void setPreviousSample(const Sample& s);
 
 private:
     static Real normalizeAngle(Real angle);
+    Real project(const Sample& s);
     ProjectionType m_projectionType;
     Real m_prevArg;
     Real *m_cache;
@@ -216,6 +216,10 @@ unsigned int SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::it
 		remaining -= len;
 	}
 
+	if (total > 0) {
+		m_spaceAvailable.wakeAll();
+	}
+
 	return total;
 }
 
@@ -280,9 +284,31 @@ unsigned int SampleSinkFifo::readCommit(unsigned int count)
     m_head = (m_head + count) % m_size;
 	m_fill -= count;
 
+	if (count > 0) {
+		m_spaceAvailable.wakeAll();
+	}
+
 	return count;
 }
 
+bool SampleSinkFifo::waitForSpace(unsigned int count, unsigned long timeoutMs)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+	QElapsedTimer timer;
+	timer.start();
+
+	while (m_size - m_fill < count)
+	{
+		qint64 elapsed = timer.elapsed();
+
+		if ((elapsed >= (qint64) timeoutMs) || !m_spaceAvailable.wait(&m_mutex, timeoutMs - elapsed)) {
+			return m_size - m_fill >= count;
+		}
+	}
+
+	return true;
+}
+
 unsigned int SampleSinkFifo::getSizePolicy(unsigned int sampleRate)
 {
     return (sampleRate/100)*64; // .64s
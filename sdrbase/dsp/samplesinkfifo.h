@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QWaitCondition>
 #include <QElapsedTimer>
 #include "dsp/dsptypes.h"
 #include "export.h"
@@ -30,6 +31,7 @@ class SDRBASE_API SampleSinkFifo : public QObject {
 
 private:
 	QMutex m_mutex;
+	QWaitCondition m_spaceAvailable; //!< signalled by the reader
 	QElapsedTimer m_msgRateTimer;
 	int m_suppressed;
 
@@ -62,6 +64,7 @@ public:
 		SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
 	unsigned int readCommit(unsigned int count);
+	bool waitForSpace(unsigned int count, unsigned long timeoutMs); //!< Block the writer until count samples can be written. Returns false on timeout
     static unsigned int getSizePolicy(unsigned int sampleRate);
 
 signals:
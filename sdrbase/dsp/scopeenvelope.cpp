@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <string.h>
+
+#include "util/simpleserializer.h"
+#include "scopeenvelope.h"
+
+ScopeEnvelope::ScopeEnvelope() :
+    m_traceSize(0),
+    m_binSize(1),
+    m_count(0),
+    m_nbFilledBins(0),
+    m_completed(false),
+    m_min(0.0f),
+    m_max(0.0f)
+{}
+
+uint32_t ScopeEnvelope::getBinSize(uint32_t traceSize)
+{
+    return traceSize <= m_maxBins ? 1 : (traceSize + m_maxBins - 1) / m_maxBins;
+}
+
+uint32_t ScopeEnvelope::getNbBins(uint32_t traceSize)
+{
+    uint32_t binSize = getBinSize(traceSize);
+    return (traceSize + binSize - 1) / binSize;
+}
+
+void ScopeEnvelope::resize(uint32_t traceSize)
+{
+    m_traceSize = traceSize;
+    m_binSize = getBinSize(traceSize);
+    m_levels.clear();
+
+    if (m_binSize > 1) // not decimated traces do not use the envelope
+    {
+        uint32_t nbBins = getNbBins(traceSize);
+        m_levels.push_back(std::vector<float>(2*nbBins));
+
+        while (nbBins > m_minBins)
+        {
+            nbBins = (nbBins + 1) / 2;
+            m_levels.push_back(std::vector<float>(2*nbBins));
+        }
+    }
+
+    reset();
+}
+
+void ScopeEnvelope::reset()
+{
+    m_count = 0;
+    m_nbFilledBins = 0;
+    m_completed = false;
+}
+
+void ScopeEnvelope::closeBin()
+{
+    m_count = 0; // next sample starts a bin even if the trace is not decimated
+
+    if (m_levels.size() == 0) {
+        return;
+    }
+
+    uint32_t bin = m_nbFilledBins++;
+    m_levels[0][2*bin] = m_min;
+    m_levels[0][2*bin + 1] = m_max;
+
+    // a bin of the next level is complete when its second (odd) bin is
+    for (unsigned int level = 1; (level < m_levels.size()) && (bin & 1); level++)
+    {
+        bin >>= 1;
+        merge(level, bin, true);
+    }
+}
+
+void ScopeEnvelope::merge(int level, uint32_t bin, bool pair)
+{
+    const std::vector<float>& below = m_levels[level - 1];
+    std::vector<float>& above = m_levels[level];
+    uint32_t left = 2*bin;
+    uint32_t right = left + 1;
+
+    if (pair)
+    {
+        above[2*bin] = std::min(below[2*left], below[2*right]);
+        above[2*bin + 1] = std::max(below[2*left + 1], below[2*right + 1]);
+    }
+    else // last bin of an odd number of bins
+    {
+        above[2*bin] = below[2*left];
+        above[2*bin + 1] = below[2*left + 1];
+    }
+}
+
+void ScopeEnvelope::complete()
+{
+    if (m_completed || (m_levels.size() == 0)) {
+        return;
+    }
+
+    if (m_count > 0) {
+        closeBin();
+    }
+
+    // the last bin of each level may come from a lone bin or a bin completed here just below
+    uint32_t nbBins = m_nbFilledBins;
+
+    for (unsigned int level = 1; (level < m_levels.size()) && (nbBins > 0); level++)
+    {
+        merge(level, (nbBins - 1) / 2, (nbBins & 1) == 0);
+        nbBins = (nbBins + 1) / 2;
+    }
+
+    m_completed = true;
+}
+
+uint32_t ScopeEnvelope::getLevelNbFilledBins(int level) const
+{
+    uint32_t nbBins = m_nbFilledBins;
+
+    for (int i = 0; i < level; i++) {
+        nbBins = m_completed ? (nbBins + 1) / 2 : nbBins / 2;
+    }
+
+    return nbBins;
+}
+
+int ScopeEnvelope::getLevelForSamplesPerPixel(float samplesPerPixel) const
+{
+    int level = 0;
+
+    while ((level + 1 < (int) m_levels.size()) && (getLevelBinSize(level + 1) <= samplesPerPixel)) {
+        level++;
+    }
+
+    return level;
+}
+
+QByteArray ScopeEnvelope::serialize() const
+{
+    SimpleSerializer s(1);
+
+    s.writeU32(1, m_traceSize);
+    s.writeU32(2, m_nbFilledBins);
+    s.writeBool(3, m_completed);
+
+    if (m_levels.size() > 0)
+    {
+        // upper levels are rebuilt from the base level
+        QByteArray buf(reinterpret_cast<const char*>(m_levels[0].data()), 2*m_nbFilledBins*sizeof(float));
+        s.writeBlob(4, buf);
+    }
+
+    return s.final();
+}
+
+bool ScopeEnvelope::deserialize(const QByteArray& data)
+{
+    SimpleDeserializer d(data);
+
+    if (!d.isValid()) {
+        return false;
+    }
+
+    if (d.getVersion() == 1)
+    {
+        uint32_t traceSize, nbFilledBins;
+        bool completed;
+        QByteArray buf;
+
+        d.readU32(1, &traceSize, 0);
+        d.readU32(2, &nbFilledBins, 0);
+        d.readBool(3, &completed, false);
+        resize(traceSize);
+
+        if (m_levels.size() == 0) {
+            return true;
+        }
+
+        d.readBlob(4, &buf);
+        m_nbFilledBins = std::min(nbFilledBins, (uint32_t) (std::min((size_t) buf.size(), m_levels[0].size()*sizeof(float)) / (2*sizeof(float))));
+        memcpy(m_levels[0].data(), buf.data(), 2*m_nbFilledBins*sizeof(float));
+        m_completed = completed;
+
+        for (unsigned int level = 1; level < m_levels.size(); level++)
+        {
+            uint32_t nbBins = getLevelNbFilledBins(level);
+            uint32_t nbBinsBelow = getLevelNbFilledBins(level - 1);
+
+            for (uint32_t bin = 0; bin < nbBins; bin++) {
+                merge(level, bin, 2*bin + 1 < nbBinsBelow);
+            }
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
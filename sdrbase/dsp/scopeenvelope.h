@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Min/max envelope of a scope trace                                             //
+//                                                                               //
+// Long traces are not stored sample by sample but as min/max pairs of bins of   //
+// consecutive samples. The base level has at most m_maxBins bins that is enough  //
+// for a few display widths. Each next level merges pairs of bins of the level   //
+// below so that the display can pick the level closest to its pixel columns     //
+// whatever the zoom without re-acquisition.                                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SCOPEENVELOPE_H_
+#define SDRBASE_DSP_SCOPEENVELOPE_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include <QByteArray>
+
+#include "export.h"
+
+class SDRBASE_API ScopeEnvelope
+{
+public:
+    static const uint32_t m_maxBins = 1<<15; //!< Maximum number of bins of the base level. Traces up to this size are not decimated
+    static const uint32_t m_minBins = 64;    //!< The top level has at most this number of bins
+
+    ScopeEnvelope();
+
+    static uint32_t getBinSize(uint32_t traceSize);  //!< Number of samples per bin of the base level. 1 if the trace is not decimated
+    static uint32_t getNbBins(uint32_t traceSize);   //!< Number of bins of the base level
+
+    void resize(uint32_t traceSize);
+    void reset();                                    //!< Empties all levels for a new trace
+
+    /** Adds the next sample of the trace. Returns true if the sample starts a new bin of the base level */
+    bool feed(float v)
+    {
+        bool binStart = m_count == 0;
+
+        if (binStart)
+        {
+            m_min = v;
+            m_max = v;
+        }
+        else if (v < m_min)
+        {
+            m_min = v;
+        }
+        else if (v > m_max)
+        {
+            m_max = v;
+        }
+
+        if (++m_count == m_binSize) {
+            closeBin();
+        }
+
+        return binStart;
+    }
+
+    void complete();                                 //!< Closes the last partial bins at the end of the trace
+
+    uint32_t getTraceSize() const { return m_traceSize; }
+    uint32_t getNbFilledBins() const { return m_nbFilledBins; } //!< Filled bins of the base level
+    int getNbLevels() const { return m_levels.size(); }
+    uint32_t getLevelBinSize(int level) const { return m_binSize << level; }
+    uint32_t getLevelNbFilledBins(int level) const;
+    const float *getLevel(int level) const { return m_levels[level].data(); } //!< min and max interleaved
+    int getLevelForSamplesPerPixel(float samplesPerPixel) const; //!< Coarsest level with at least one bin per pixel
+
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& data);
+
+private:
+    uint32_t m_traceSize;
+    uint32_t m_binSize;         //!< Samples per bin of the base level
+    uint32_t m_count;           //!< Samples in the current bin of the base level
+    uint32_t m_nbFilledBins;    //!< Completed bins of the base level
+    bool m_completed;           //!< Last partial bins have been closed
+    float m_min;
+    float m_max;
+    std::vector<std::vector<float>> m_levels; //!< Pyramid of min/max pairs. Level 0 is the finest
+
+    void closeBin();
+    void merge(int level, uint32_t bin, bool pair); //!< Updates the bin of level from the bins below. pair is false for a lone last bin
+};
+
+#endif // SDRBASE_DSP_SCOPEENVELOPE_H_
@@ -0,0 +1,520 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegExp>
+
+#include "sigmf.h"
+
+const char *SigMF::m_dataExtension = "sigmf-data";
+const char *SigMF::m_metaExtension = "sigmf-meta";
+
+bool SigMF::isSigMFFile(const QString& fileName)
+{
+    QString suffix = QFileInfo(fileName).suffix();
+    return (suffix == m_dataExtension) || (suffix == m_metaExtension);
+}
+
+QString SigMF::getDataFileName(const QString& fileName)
+{
+    QFileInfo fileInfo(fileName);
+    return fileInfo.path() + "/" + fileInfo.completeBaseName() + "." + m_dataExtension;
+}
+
+QString SigMF::getMetaFileName(const QString& fileName)
+{
+    QFileInfo fileInfo(fileName);
+    return fileInfo.path() + "/" + fileInfo.completeBaseName() + "." + m_metaExtension;
+}
+
+bool SigMF::readMeta(const QString& metaFileName, Meta& meta, QString& errorMessage)
+{
+    QFile file(metaFileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        errorMessage = QString("Cannot open %1: %2").arg(metaFileName).arg(file.errorString());
+        return false;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+
+    if (!doc.isObject())
+    {
+        errorMessage = QString("Invalid JSON in %1: %2").arg(metaFileName).arg(parseError.errorString());
+        return false;
+    }
+
+    QJsonObject global = doc.object()["global"].toObject();
+    QString dataTypeStr = global["core:datatype"].toString();
+    meta.m_dataType = getDataType(dataTypeStr);
+
+    if (meta.m_dataType == DataTypeUnknown)
+    {
+        errorMessage = QString("Unsupported datatype \"%1\"").arg(dataTypeStr);
+        return false;
+    }
+
+    meta.m_sampleRate = global["core:sample_rate"].toDouble();
+    meta.m_sampleBits = global.contains("sdrangel:sample_size") ?
+        global["sdrangel:sample_size"].toInt() :
+        8 * getComponentBytes(meta.m_dataType);
+    meta.m_description = global["core:description"].toString();
+    meta.m_recorder = global["core:recorder"].toString();
+    meta.m_hw = global["core:hw"].toString();
+
+    meta.m_captures.clear();
+    QJsonArray captures = doc.object()["captures"].toArray();
+
+    for (const auto& value : captures)
+    {
+        QJsonObject captureObject = value.toObject();
+        Capture capture;
+        capture.m_sampleStart = (quint64) captureObject["core:sample_start"].toDouble();
+        capture.m_frequency = std::llround(captureObject["core:frequency"].toDouble());
+        capture.m_dateTime = captureObject.contains("core:datetime") ? parseDateTime(captureObject["core:datetime"].toString()) : -1;
+        meta.m_captures.push_back(capture);
+    }
+
+    meta.m_annotations.clear();
+    QJsonArray annotations = doc.object()["annotations"].toArray();
+
+    for (const auto& value : annotations)
+    {
+        QJsonObject annotationObject = value.toObject();
+        Annotation annotation;
+        annotation.m_sampleStart = (quint64) annotationObject["core:sample_start"].toDouble();
+        annotation.m_sampleCount = (quint64) annotationObject["core:sample_count"].toDouble();
+        annotation.m_label = annotationObject["core:label"].toString();
+        annotation.m_comment = annotationObject["core:comment"].toString();
+        meta.m_annotations.push_back(annotation);
+    }
+
+    // the specification requires ordered lists but some tools do not care
+    std::stable_sort(meta.m_captures.begin(), meta.m_captures.end(), [](const Capture& a, const Capture& b) {
+        return a.m_sampleStart < b.m_sampleStart;
+    });
+    std::stable_sort(meta.m_annotations.begin(), meta.m_annotations.end(), [](const Annotation& a, const Annotation& b) {
+        return a.m_sampleStart < b.m_sampleStart;
+    });
+
+    return true;
+}
+
+QByteArray SigMF::formatMeta(const Meta& meta)
+{
+    QJsonObject global;
+    global["core:datatype"] = getDataTypeString(meta.m_dataType);
+    global["core:sample_rate"] = meta.m_sampleRate;
+    global["core:version"] = "1.0.0";
+
+    if (!meta.m_description.isEmpty()) {
+        global["core:description"] = meta.m_description;
+    }
+    if (!meta.m_recorder.isEmpty()) {
+        global["core:recorder"] = meta.m_recorder;
+    }
+    if (!meta.m_hw.isEmpty()) {
+        global["core:hw"] = meta.m_hw;
+    }
+
+    if (meta.m_sampleBits != 8 * getComponentBytes(meta.m_dataType))
+    {
+        // ex: 24 bit samples stored in 32 bit integers
+        QJsonObject extension;
+        extension["name"] = "sdrangel";
+        extension["version"] = "1.0.0";
+        extension["optional"] = true;
+        global["core:extensions"] = QJsonArray{extension};
+        global["sdrangel:sample_size"] = (int) meta.m_sampleBits;
+    }
+
+    QJsonArray captures;
+
+    for (const auto& capture : meta.m_captures)
+    {
+        QJsonObject captureObject;
+        captureObject["core:sample_start"] = (double) capture.m_sampleStart;
+        captureObject["core:frequency"] = (double) capture.m_frequency;
+
+        if (capture.m_dateTime >= 0) {
+            captureObject["core:datetime"] = formatDateTime(capture.m_dateTime);
+        }
+
+        captures.append(captureObject);
+    }
+
+    QJsonArray annotations;
+
+    for (const auto& annotation : meta.m_annotations)
+    {
+        QJsonObject annotationObject;
+        annotationObject["core:sample_start"] = (double) annotation.m_sampleStart;
+        annotationObject["core:sample_count"] = (double) annotation.m_sampleCount;
+
+        if (!annotation.m_label.isEmpty()) {
+            annotationObject["core:label"] = annotation.m_label;
+        }
+        if (!annotation.m_comment.isEmpty()) {
+            annotationObject["core:comment"] = annotation.m_comment;
+        }
+
+        annotations.append(annotationObject);
+    }
+
+    QJsonObject root;
+    root["global"] = global;
+    root["captures"] = captures;
+    root["annotations"] = annotations;
+
+    return QJsonDocument(root).toJson();
+}
+
+bool SigMF::writeMeta(const QString& metaFileName, const Meta& meta)
+{
+    QFile file(metaFileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QByteArray json = formatMeta(meta);
+    return file.write(json) == json.size();
+}
+
+SigMF::DataType SigMF::getDataType(const QString& dataTypeStr)
+{
+    if (dataTypeStr == "ci8") {
+        return DataTypeCI8;
+    } else if (dataTypeStr == "cu8") {
+        return DataTypeCU8;
+    } else if (dataTypeStr == "ci16_le") {
+        return DataTypeCI16;
+    } else if (dataTypeStr == "ci32_le") {
+        return DataTypeCI32;
+    } else if (dataTypeStr == "cf32_le") {
+        return DataTypeCF32;
+    } else {
+        return DataTypeUnknown;
+    }
+}
+
+QString SigMF::getDataTypeString(DataType dataType)
+{
+    switch (dataType)
+    {
+    case DataTypeCI8:
+        return "ci8";
+    case DataTypeCU8:
+        return "cu8";
+    case DataTypeCI16:
+        return "ci16_le";
+    case DataTypeCI32:
+        return "ci32_le";
+    case DataTypeCF32:
+        return "cf32_le";
+    default:
+        return "";
+    }
+}
+
+unsigned int SigMF::getComponentBytes(DataType dataType)
+{
+    switch (dataType)
+    {
+    case DataTypeCI8:
+    case DataTypeCU8:
+        return 1;
+    case DataTypeCI16:
+        return 2;
+    case DataTypeCI32:
+    case DataTypeCF32:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+bool SigMF::isNative(DataType dataType, unsigned int sampleBits)
+{
+    if (SDR_RX_SAMP_SZ == 16) {
+        return (dataType == DataTypeCI16) && (sampleBits == 16);
+    } else {
+        return (dataType == DataTypeCI32) && (sampleBits == 24);
+    }
+}
+
+void SigMF::convert(DataType dataType, unsigned int sampleBits, const char *in, unsigned int nbSamples, Sample *out)
+{
+    if (isNative(dataType, sampleBits))
+    {
+        std::memcpy(out, in, nbSamples * sizeof(Sample));
+        return;
+    }
+
+    switch (dataType)
+    {
+    case DataTypeCI8:
+        convertCI8((const qint8 *) in, nbSamples, out, 0);
+        break;
+    case DataTypeCU8:
+        convertCI8((const qint8 *) in, nbSamples, out, 0x80); // offset binary to two's complement
+        break;
+    case DataTypeCI16:
+        convertCI16((const qint16 *) in, nbSamples, out);
+        break;
+    case DataTypeCI32:
+        convertCI32((const qint32 *) in, nbSamples, out, sampleBits);
+        break;
+    case DataTypeCF32:
+        convertCF32((const float *) in, nbSamples, out);
+        break;
+    default:
+        std::fill(out, out + nbSamples, Sample{0, 0});
+        break;
+    }
+}
+
+void SigMF::convertCI8(const qint8 *in, unsigned int nbSamples, Sample *out, quint8 offset)
+{
+    FixReal *o = (FixReal *) out;
+    unsigned int n = 2 * nbSamples;
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    const __m128i voffset = _mm_set1_epi8((char) offset);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (in + i)), voffset);
+        // interleaving with zeros below gives x << 8 in 16 bits
+        __m128i lo = _mm_unpacklo_epi8(zero, v);
+        __m128i hi = _mm_unpackhi_epi8(zero, v);
+
+        if (SDR_RX_SAMP_SZ == 16)
+        {
+            _mm_storeu_si128((__m128i *) (o + i), lo);
+            _mm_storeu_si128((__m128i *) (o + i + 8), hi);
+        }
+        else
+        {
+            // x << 24 in 32 bits then arithmetic shift back to x << 16
+            _mm_storeu_si128((__m128i *) (o + i),      _mm_srai_epi32(_mm_unpacklo_epi16(zero, lo), 8));
+            _mm_storeu_si128((__m128i *) (o + i + 4),  _mm_srai_epi32(_mm_unpackhi_epi16(zero, lo), 8));
+            _mm_storeu_si128((__m128i *) (o + i + 8),  _mm_srai_epi32(_mm_unpacklo_epi16(zero, hi), 8));
+            _mm_storeu_si128((__m128i *) (o + i + 12), _mm_srai_epi32(_mm_unpackhi_epi16(zero, hi), 8));
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        o[i] = ((FixReal) (qint8) (in[i] ^ offset)) << (SDR_RX_SAMP_SZ - 8);
+    }
+}
+
+void SigMF::convertCI16(const qint16 *in, unsigned int nbSamples, Sample *out)
+{
+    FixReal *o = (FixReal *) out;
+    unsigned int n = 2 * nbSamples;
+    unsigned int i = 0;
+
+    if (SDR_RX_SAMP_SZ == 16)
+    {
+        std::memcpy(o, in, n * sizeof(qint16));
+        return;
+    }
+
+#if defined(USE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i *) (in + i));
+        _mm_storeu_si128((__m128i *) (o + i),     _mm_srai_epi32(_mm_unpacklo_epi16(zero, v), 8));
+        _mm_storeu_si128((__m128i *) (o + i + 4), _mm_srai_epi32(_mm_unpackhi_epi16(zero, v), 8));
+    }
+#endif
+
+    for (; i < n; i++) {
+        o[i] = ((FixReal) in[i]) << (SDR_RX_SAMP_SZ - 16);
+    }
+}
+
+void SigMF::convertCI32(const qint32 *in, unsigned int nbSamples, Sample *out, unsigned int sampleBits)
+{
+    FixReal *o = (FixReal *) out;
+    unsigned int n = 2 * nbSamples;
+    unsigned int i = 0;
+    int shift = (int) std::min(sampleBits, 32U) - SDR_RX_SAMP_SZ;
+
+    if (shift < 0) // less significant bits than the internal sample size
+    {
+        for (; i < n; i++) {
+            o[i] = (FixReal) (in[i] << (-shift));
+        }
+
+        return;
+    }
+
+#if defined(USE_SSE2)
+    const __m128i vshift = _mm_cvtsi32_si128(shift);
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i v0 = _mm_sra_epi32(_mm_loadu_si128((const __m128i *) (in + i)), vshift);
+        __m128i v1 = _mm_sra_epi32(_mm_loadu_si128((const __m128i *) (in + i + 4)), vshift);
+
+        if (SDR_RX_SAMP_SZ == 16)
+        {
+            _mm_storeu_si128((__m128i *) (o + i), _mm_packs_epi32(v0, v1));
+        }
+        else
+        {
+            _mm_storeu_si128((__m128i *) (o + i), v0);
+            _mm_storeu_si128((__m128i *) (o + i + 4), v1);
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        o[i] = (FixReal) (in[i] >> shift);
+    }
+}
+
+void SigMF::convertCF32(const float *in, unsigned int nbSamples, Sample *out)
+{
+    FixReal *o = (FixReal *) out;
+    unsigned int n = 2 * nbSamples;
+    unsigned int i = 0;
+    const float scale = SDR_RX_SCALEF;
+    const float vmax = SDR_RX_SCALEF - 1.0f;
+
+#if defined(USE_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 vhi = _mm_set1_ps(vmax);
+    const __m128 vlo = _mm_set1_ps(-scale);
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i v0 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i), vscale), vlo), vhi));
+        __m128i v1 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(in + i + 4), vscale), vlo), vhi));
+
+        if (SDR_RX_SAMP_SZ == 16)
+        {
+            _mm_storeu_si128((__m128i *) (o + i), _mm_packs_epi32(v0, v1));
+        }
+        else
+        {
+            _mm_storeu_si128((__m128i *) (o + i), v0);
+            _mm_storeu_si128((__m128i *) (o + i + 4), v1);
+        }
+    }
+#endif
+
+    for (; i < n; i++)
+    {
+        float v = in[i] * scale;
+        v = !(v >= -scale) ? -scale : v > vmax ? vmax : v; // NaN to min like _mm_max_ps above
+        o[i] = (FixReal) std::lrint(v);
+    }
+}
+
+const SigMF::Capture *SigMF::getCapture(const Meta& meta, quint64 sampleIndex)
+{
+    auto it = std::upper_bound(meta.m_captures.begin(), meta.m_captures.end(), sampleIndex,
+        [](quint64 s, const Capture& capture) {
+            return s < capture.m_sampleStart;
+        }
+    );
+
+    return it == meta.m_captures.begin() ? nullptr : &*(it - 1);
+}
+
+qint64 SigMF::getDateTime(const Meta& meta, quint64 sampleIndex)
+{
+    const Capture *capture = getCapture(meta, sampleIndex);
+
+    if (!capture || (capture->m_dateTime < 0) || (meta.m_sampleRate <= 0.0)) {
+        return -1;
+    }
+
+    return capture->m_dateTime + std::llround(((sampleIndex - capture->m_sampleStart) * 1000.0) / meta.m_sampleRate);
+}
+
+quint64 SigMF::getSampleIndex(const Meta& meta, qint64 dateTime)
+{
+    if (meta.m_sampleRate <= 0.0) {
+        return 0;
+    }
+
+    // last segment starting at or before this time
+    const Capture *found = nullptr;
+
+    for (const auto& capture : meta.m_captures)
+    {
+        if ((capture.m_dateTime >= 0) && (capture.m_dateTime <= dateTime)) {
+            found = &capture;
+        }
+    }
+
+    if (!found) {
+        return 0;
+    }
+
+    quint64 sampleIndex = found->m_sampleStart + (quint64) std::ceil(((dateTime - found->m_dateTime) * meta.m_sampleRate) / 1000.0);
+
+    // the time may fall in a gap between segments
+    if ((found + 1 < meta.m_captures.data() + meta.m_captures.size()) && (sampleIndex > (found + 1)->m_sampleStart)) {
+        sampleIndex = (found + 1)->m_sampleStart;
+    }
+
+    return sampleIndex;
+}
+
+QString SigMF::formatDateTime(qint64 dateTime)
+{
+    return QDateTime::fromMSecsSinceEpoch(dateTime, Qt::UTC).toString("yyyy-MM-ddTHH:mm:ss.zzzZ");
+}
+
+qint64 SigMF::parseDateTime(const QString& dateTimeStr)
+{
+    // Qt parses milliseconds only: truncate sub millisecond digits
+    QString s = dateTimeStr;
+    s.replace(QRegExp("(\\.\\d{3})\\d+"), "\\1");
+    QDateTime dateTime = QDateTime::fromString(s, Qt::ISODate);
+
+    if (!dateTime.isValid()) {
+        return -1;
+    }
+
+    return dateTime.toMSecsSinceEpoch();
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// SigMF (Signal Metadata Format) support                                        //
+//                                                                               //
+// A SigMF recording is a pair of files: the raw samples (.sigmf-data) and a     //
+// JSON description of them (.sigmf-meta). Only complex little endian datasets   //
+// are supported. See https://github.com/gnuradio/SigMF                          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SIGMF_H_
+#define SDRBASE_DSP_SIGMF_H_
+
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class SDRBASE_API SigMF
+{
+public:
+    enum DataType
+    {
+        DataTypeUnknown,
+        DataTypeCI8,  //!< ci8
+        DataTypeCU8,  //!< cu8
+        DataTypeCI16, //!< ci16_le
+        DataTypeCI32, //!< ci32_le
+        DataTypeCF32  //!< cf32_le
+    };
+
+    struct Capture
+    {
+        quint64 m_sampleStart;
+        qint64 m_frequency;
+        qint64 m_dateTime; //!< UTC ms since epoch of the first sample of the segment (-1 if unknown)
+
+        Capture() : m_sampleStart(0), m_frequency(0), m_dateTime(-1) {}
+    };
+
+    struct Annotation
+    {
+        quint64 m_sampleStart;
+        quint64 m_sampleCount;
+        QString m_label;
+        QString m_comment;
+
+        Annotation() : m_sampleStart(0), m_sampleCount(0) {}
+    };
+
+    struct Meta
+    {
+        DataType m_dataType;
+        unsigned int m_sampleBits; //!< significant bits of integer components. From the sdrangel:sample_size extension else type size
+        double m_sampleRate;
+        QString m_description;
+        QString m_recorder;
+        QString m_hw;
+        std::vector<Capture> m_captures;       //!< in increasing sample start order
+        std::vector<Annotation> m_annotations; //!< in increasing sample start order
+
+        Meta() : m_dataType(DataTypeUnknown), m_sampleBits(0), m_sampleRate(0.0) {}
+    };
+
+    static const char *m_dataExtension; //!< sigmf-data
+    static const char *m_metaExtension; //!< sigmf-meta
+
+    static bool isSigMFFile(const QString& fileName); //!< data or meta file of a SigMF recording
+    static QString getDataFileName(const QString& fileName);
+    static QString getMetaFileName(const QString& fileName);
+
+    static bool readMeta(const QString& metaFileName, Meta& meta, QString& errorMessage);
+    static bool writeMeta(const QString& metaFileName, const Meta& meta);
+    static QByteArray formatMeta(const Meta& meta);
+
+    static DataType getDataType(const QString& dataTypeStr); //!< DataTypeUnknown for unsupported types
+    static QString getDataTypeString(DataType dataType);
+    static unsigned int getComponentBytes(DataType dataType); //!< bytes per I or Q
+    /** True if the samples of this type can go to the sample FIFO as they are */
+    static bool isNative(DataType dataType, unsigned int sampleBits);
+    /** Converts I/Q samples of the given type to SDR_RX_SAMP_SZ bits samples */
+    static void convert(DataType dataType, unsigned int sampleBits, const char *in, unsigned int nbSamples, Sample *out);
+
+    static qint64 getDateTime(const Meta& meta, quint64 sampleIndex); //!< UTC ms since epoch (-1 if unknown)
+    static quint64 getSampleIndex(const Meta& meta, qint64 dateTime); //!< first sample at or after this UTC ms since epoch
+    static const Capture *getCapture(const Meta& meta, quint64 sampleIndex); //!< capture segment of this sample (nullptr if none)
+
+    static QString formatDateTime(qint64 dateTime); //!< ISO 8601 UTC with ms
+    static qint64 parseDateTime(const QString& dateTimeStr); //!< -1 if invalid
+
+private:
+    static void convertCI8(const qint8 *in, unsigned int nbSamples, Sample *out, quint8 offset);
+    static void convertCI16(const qint16 *in, unsigned int nbSamples, Sample *out);
+    static void convertCI32(const qint32 *in, unsigned int nbSamples, Sample *out, unsigned int sampleBits);
+    static void convertCF32(const float *in, unsigned int nbSamples, Sample *out);
+};
+
+#endif // SDRBASE_DSP_SIGMF_H_
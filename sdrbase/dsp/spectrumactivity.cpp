@@ -0,0 +1,365 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <QDateTime>
+
+#include "SWGSpectrumActivity.h"
+#include "SWGSpectrumActivitySignal.h"
+
+#include "spectrumactivity.h"
+
+#define SPECTRUMACTIVITY_FLOOR_UPDATE_FRAMES 4 // noise floor moves slowly
+#define SPECTRUMACTIVITY_MAX_SIGNALS 1024
+#define SPECTRUMACTIVITY_MAX_REGIONS 1024
+
+SpectrumActivity::SpectrumActivity() :
+    m_enable(false),
+    m_centerFrequency(0),
+    m_noiseFloorDb(0.0f),
+    m_nextId(0),
+    m_updateCount(0),
+    m_frameIndex(0),
+    m_floorFFTSize(0)
+{}
+
+SpectrumActivity::~SpectrumActivity()
+{}
+
+void SpectrumActivity::applySettings(const Settings& settings)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!settings.m_enable) {
+        m_signals.clear();
+    }
+
+    if ((settings.m_nbRegions != m_settings.m_nbRegions) || (settings.m_percentile != m_settings.m_percentile)) {
+        m_floorFFTSize = 0; // force floor estimation
+    }
+
+    m_settings = settings;
+    m_enable.store(settings.m_enable);
+    m_updateCount++;
+}
+
+SpectrumActivity::Settings SpectrumActivity::getSettings() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_settings;
+}
+
+void SpectrumActivity::newFrame(
+    const std::vector<Real>& spectrum,
+    int fftSize,
+    qint64 centerFrequency,
+    int sampleRate,
+    bool linear)
+{
+    if (!m_enable.load() || (fftSize <= 0) || (sampleRate <= 0)) {
+        return;
+    }
+
+    Settings settings = getSettings();
+    const float *power;
+
+    if (linear || (sizeof(Real) != sizeof(float)))
+    {
+        m_powerDb.resize(fftSize);
+
+        for (int i = 0; i < fftSize; i++) {
+            m_powerDb[i] = linear ? 10.0f * log10f(spectrum[i] > 1e-20f ? spectrum[i] : 1e-20f) : spectrum[i];
+        }
+
+        power = m_powerDb.data();
+    }
+    else
+    {
+        power = (const float *) spectrum.data();
+    }
+
+    if ((fftSize != m_floorFFTSize) || (m_frameIndex % SPECTRUMACTIVITY_FLOOR_UPDATE_FRAMES == 0)) {
+        estimateFloor(power, fftSize, settings);
+    }
+
+    int minBins = (int) (((qint64) settings.m_minBandwidth * fftSize + sampleRate - 1) / sampleRate);
+    detectRegions(power, fftSize, minBins < 1 ? 1 : minBins, settings);
+    trackSignals(power, fftSize, centerFrequency, sampleRate, settings);
+    m_frameIndex++;
+}
+
+void SpectrumActivity::estimateFloor(const float *power, int fftSize, const Settings& settings)
+{
+    int nbRegions = std::min(std::max(settings.m_nbRegions, 1), fftSize);
+    m_floorPoints.resize(nbRegions);
+    m_floor.resize(fftSize);
+    float floorSum = 0.0f;
+
+    // percentile of each region in O(n) with a partial sort of a copy
+    for (int r = 0; r < nbRegions; r++)
+    {
+        int start = (int) (((qint64) r * fftSize) / nbRegions);
+        int end = (int) (((qint64) (r + 1) * fftSize) / nbRegions);
+        m_scratch.assign(power + start, power + end);
+        std::vector<float>::iterator nth = m_scratch.begin() + (int) (settings.m_percentile * (end - start - 1));
+        std::nth_element(m_scratch.begin(), nth, m_scratch.end());
+        m_floorPoints[r] = *nth;
+        floorSum += *nth;
+    }
+
+    // linear interpolation between region centers and flat beyond the outer centers
+    for (int r = 0; r <= nbRegions; r++)
+    {
+        int start = r == 0 ? 0 : (int) (((qint64) (2*r - 1) * fftSize) / (2*nbRegions));
+        int end = r == nbRegions ? fftSize : (int) (((qint64) (2*r + 1) * fftSize) / (2*nbRegions));
+
+        if ((r == 0) || (r == nbRegions))
+        {
+            std::fill(m_floor.begin() + start, m_floor.begin() + end, m_floorPoints[r == 0 ? 0 : nbRegions - 1]);
+            continue;
+        }
+
+        float slope = (m_floorPoints[r] - m_floorPoints[r-1]) / (end - start);
+
+        for (int i = start; i < end; i++) {
+            m_floor[i] = m_floorPoints[r-1] + slope * (i - start);
+        }
+    }
+
+    m_floorFFTSize = fftSize;
+    QMutexLocker mutexLocker(&m_mutex);
+    m_noiseFloorDb = floorSum / nbRegions;
+}
+
+void SpectrumActivity::detectRegions(const float *power, int fftSize, int minBins, const Settings& settings)
+{
+    const float *floor = m_floor.data();
+    float onThreshold = settings.m_thresholdDb;
+    float offThreshold = settings.m_thresholdDb - settings.m_hysteresisDb;
+    int start = -1;
+    int peakBin = 0;
+    m_regions.clear();
+
+    for (int i = 0; i < fftSize; i++)
+    {
+        float level = power[i] - floor[i];
+
+        if (start < 0)
+        {
+            if (level > onThreshold)
+            {
+                start = i;
+                peakBin = i;
+            }
+        }
+        else if (level > offThreshold)
+        {
+            peakBin = power[i] > power[peakBin] ? i : peakBin;
+        }
+        else
+        {
+            if (i - start >= minBins) {
+                m_regions.push_back(Region{start, i, peakBin});
+            }
+
+            start = -1;
+
+            if (m_regions.size() >= SPECTRUMACTIVITY_MAX_REGIONS) {
+                return;
+            }
+        }
+    }
+
+    if ((start >= 0) && (fftSize - start >= minBins)) {
+        m_regions.push_back(Region{start, fftSize, peakBin});
+    }
+}
+
+void SpectrumActivity::trackSignals(const float *power, int fftSize, qint64 centerFrequency, int sampleRate, const Settings& settings)
+{
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    qint64 startFrequency = centerFrequency - sampleRate / 2;
+    m_newSignals.clear();
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_settings.m_enable) { // disabled while processing
+        return;
+    }
+
+    // regions and signals are both sorted by frequency so matching is a single merge pass
+    std::size_t j = 0;
+
+    for (const Region& region : m_regions)
+    {
+        qint64 regionStart = startFrequency + ((qint64) region.m_startBin * sampleRate) / fftSize;
+        qint64 regionStop = startFrequency + ((qint64) region.m_endBin * sampleRate) / fftSize;
+        float powerDb = power[region.m_peakBin];
+        float snrDb = powerDb - m_floor[region.m_peakBin];
+
+        while ((j < m_signals.size()) && (m_signals[j].m_stopFrequency < regionStart)) {
+            j++;
+        }
+
+        if ((j < m_signals.size()) && (m_signals[j].m_startFrequency <= regionStop))
+        {
+            Signal& signal = m_signals[j];
+
+            if (signal.m_lastFrame == m_frameIndex) // several regions of the same signal in this frame
+            {
+                signal.m_startFrequency = std::min(signal.m_startFrequency, regionStart);
+                signal.m_stopFrequency = std::max(signal.m_stopFrequency, regionStop);
+
+                if (powerDb > signal.m_powerDb)
+                {
+                    signal.m_powerDb = powerDb;
+                    signal.m_snrDb = snrDb;
+                }
+            }
+            else
+            {
+                signal.m_startFrequency = regionStart;
+                signal.m_stopFrequency = regionStop;
+                signal.m_powerDb = powerDb;
+                signal.m_snrDb = snrDb;
+                signal.m_lastSeenMs = nowMs;
+                signal.m_lastFrame = m_frameIndex;
+            }
+        }
+        else if (m_signals.size() + m_newSignals.size() < SPECTRUMACTIVITY_MAX_SIGNALS)
+        {
+            m_newSignals.push_back(Signal{m_nextId++, regionStart, regionStop, powerDb, snrDb, nowMs, nowMs, m_frameIndex});
+        }
+    }
+
+    qint64 expiryMs = nowMs - settings.m_holdMs;
+    m_signals.erase(
+        std::remove_if(m_signals.begin(), m_signals.end(), [expiryMs](const Signal& s) { return s.m_lastSeenMs < expiryMs; }),
+        m_signals.end()
+    );
+
+    if (m_newSignals.size() > 0)
+    {
+        m_signals.insert(m_signals.end(), m_newSignals.begin(), m_newSignals.end());
+        std::sort(m_signals.begin(), m_signals.end(), [](const Signal& a, const Signal& b) {
+            return a.m_startFrequency < b.m_startFrequency;
+        });
+    }
+
+    m_centerFrequency = centerFrequency;
+    m_updateCount++;
+}
+
+qint64 SpectrumActivity::getSignals(std::vector<Signal>& activeSignals) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    activeSignals = m_signals;
+    return m_centerFrequency;
+}
+
+int SpectrumActivity::webapiSettingsGet(
+        SWGSDRangel::SWGSpectrumActivity& response,
+        QString& errorMessage) const
+{
+    (void) errorMessage;
+    QMutexLocker mutexLocker(&m_mutex);
+    response.setEnable(m_settings.m_enable ? 1 : 0);
+    response.setThresholdDb(m_settings.m_thresholdDb);
+    response.setHysteresisDb(m_settings.m_hysteresisDb);
+    response.setPercentile(m_settings.m_percentile);
+    response.setNbRegions(m_settings.m_nbRegions);
+    response.setMinBandwidth(m_settings.m_minBandwidth);
+    response.setHoldMs(m_settings.m_holdMs);
+    response.setCenterFrequency(m_centerFrequency);
+    response.setNoiseFloorDb(m_noiseFloorDb);
+
+    if (!response.getActiveSignals()) {
+        response.setActiveSignals(new QList<SWGSDRangel::SWGSpectrumActivitySignal*>());
+    }
+
+    for (const Signal& signal : m_signals)
+    {
+        response.getActiveSignals()->append(new SWGSDRangel::SWGSpectrumActivitySignal);
+        SWGSDRangel::SWGSpectrumActivitySignal *swgSignal = response.getActiveSignals()->back();
+        swgSignal->setId(signal.m_id);
+        swgSignal->setCenterFrequency(signal.getCenterFrequency());
+        swgSignal->setBandwidth(signal.getBandwidth());
+        swgSignal->setPowerDb(signal.m_powerDb);
+        swgSignal->setSnrDb(signal.m_snrDb);
+        swgSignal->setFirstSeenMs(signal.m_firstSeenMs);
+        swgSignal->setLastSeenMs(signal.m_lastSeenMs);
+    }
+
+    return 200;
+}
+
+int SpectrumActivity::webapiSettingsPut(
+        const QStringList& settingsKeys,
+        SWGSDRangel::SWGSpectrumActivity& response,
+        QString& errorMessage)
+{
+    // only the fields present in the request change the current settings
+    Settings settings = getSettings();
+
+    if (settingsKeys.contains("enable")) {
+        settings.m_enable = response.getEnable() != 0;
+    }
+    if (settingsKeys.contains("thresholdDb")) {
+        settings.m_thresholdDb = response.getThresholdDb();
+    }
+    if (settingsKeys.contains("hysteresisDb")) {
+        settings.m_hysteresisDb = response.getHysteresisDb();
+    }
+    if (settingsKeys.contains("percentile")) {
+        settings.m_percentile = response.getPercentile();
+    }
+    if (settingsKeys.contains("nbRegions")) {
+        settings.m_nbRegions = response.getNbRegions();
+    }
+    if (settingsKeys.contains("minBandwidth")) {
+        settings.m_minBandwidth = response.getMinBandwidth();
+    }
+    if (settingsKeys.contains("holdMs")) {
+        settings.m_holdMs = response.getHoldMs();
+    }
+
+    if ((settings.m_thresholdDb < 0.0f)
+     || (settings.m_hysteresisDb < 0.0f) || (settings.m_hysteresisDb > settings.m_thresholdDb)
+     || (settings.m_percentile <= 0.0f) || (settings.m_percentile > 1.0f)
+     || (settings.m_nbRegions < 1) || (settings.m_nbRegions > 1024)
+     || (settings.m_minBandwidth < 0) || (settings.m_holdMs < 0))
+    {
+        errorMessage = QString("Invalid settings: threshold must be positive, hysteresis in [0, threshold], percentile in ]0, 1], "
+            "regions in [1, 1024], minimum bandwidth and hold time positive or zero");
+        return 400;
+    }
+
+    applySettings(settings);
+
+    if (response.getActiveSignals())
+    {
+        for (auto swgSignal : *response.getActiveSignals()) {
+            delete swgSignal;
+        }
+
+        response.getActiveSignals()->clear(); // read only
+    }
+
+    return webapiSettingsGet(response, errorMessage);
+}
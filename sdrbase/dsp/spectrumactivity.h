@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Signal activity detector                                                      //
+//                                                                               //
+// The noise floor is estimated with a percentile of the power in regions of     //
+// the spectrum interpolated between region centers. Contiguous bins above the   //
+// floor by a threshold with hysteresis are detected as signals that are         //
+// tracked across frames with their first and last seen times.                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMACTIVITY_H_
+#define SDRBASE_DSP_SPECTRUMACTIVITY_H_
+
+#include <atomic>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include "dsp/spectrumframesink.h"
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGSpectrumActivity;
+}
+
+class SDRBASE_API SpectrumActivity : public SpectrumFrameSink
+{
+public:
+    struct Settings
+    {
+        bool m_enable;
+        float m_thresholdDb;   //!< level above noise floor to start a signal
+        float m_hysteresisDb;  //!< a signal extends while above the threshold minus hysteresis
+        float m_percentile;    //!< percentile of power in each region taken as noise floor (0.5: median)
+        int m_nbRegions;       //!< number of regions the spectrum is divided into for noise floor estimation
+        int m_minBandwidth;    //!< minimum bandwidth of a signal in Hz (0: one bin)
+        int m_holdMs;          //!< a signal is removed when not seen for this time
+
+        Settings() :
+            m_enable(false),
+            m_thresholdDb(10.0f),
+            m_hysteresisDb(3.0f),
+            m_percentile(0.5f),
+            m_nbRegions(32),
+            m_minBandwidth(0),
+            m_holdMs(2000)
+        {}
+    };
+
+    struct Signal
+    {
+        unsigned int m_id;
+        qint64 m_startFrequency; //!< lower edge in Hz
+        qint64 m_stopFrequency;  //!< upper edge in Hz
+        float m_powerDb;         //!< peak power
+        float m_snrDb;           //!< peak power above noise floor
+        qint64 m_firstSeenMs;
+        qint64 m_lastSeenMs;
+        quint64 m_lastFrame;     //!< index of the last frame the signal was detected in
+
+        qint64 getCenterFrequency() const { return (m_startFrequency + m_stopFrequency) / 2; }
+        int getBandwidth() const { return (int) (m_stopFrequency - m_startFrequency); }
+    };
+
+    SpectrumActivity();
+    virtual ~SpectrumActivity();
+
+    void applySettings(const Settings& settings);
+    Settings getSettings() const;
+
+    virtual void newFrame(
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        qint64 centerFrequency,
+        int sampleRate,
+        bool linear
+    );
+
+    virtual bool isActive() const { return m_enable.load(); }
+
+    /** Copy of active signals sorted by frequency. Returns the center frequency of the last frame */
+    qint64 getSignals(std::vector<Signal>& activeSignals) const;
+    unsigned int getUpdateCount() const { return m_updateCount.load(); } //!< changes every time the signal list changes
+
+    int webapiSettingsGet(
+            SWGSDRangel::SWGSpectrumActivity& response,
+            QString& errorMessage) const;
+
+    int webapiSettingsPut(
+            const QStringList& settingsKeys,
+            SWGSDRangel::SWGSpectrumActivity& response,
+            QString& errorMessage);
+
+private:
+    struct Region
+    {
+        int m_startBin;
+        int m_endBin; //!< excluded
+        int m_peakBin;
+    };
+
+    mutable QMutex m_mutex; //!< settings and signal list
+    Settings m_settings;
+    std::atomic<bool> m_enable; //!< copy of m_settings.m_enable for the DSP thread
+    std::vector<Signal> m_signals;
+    qint64 m_centerFrequency;
+    float m_noiseFloorDb;
+    unsigned int m_nextId;
+    std::atomic<unsigned int> m_updateCount;
+
+    // DSP thread working data
+    quint64 m_frameIndex;
+    std::vector<float> m_powerDb;    //!< frame converted to dB when linear
+    std::vector<float> m_floor;      //!< noise floor per bin
+    std::vector<float> m_floorPoints; //!< noise floor at region centers
+    std::vector<float> m_scratch;
+    std::vector<Region> m_regions;
+    std::vector<Signal> m_newSignals;
+    int m_floorFFTSize;
+
+    void estimateFloor(const float *power, int fftSize, const Settings& settings);
+    void detectRegions(const float *power, int fftSize, int minBins, const Settings& settings);
+    void trackSignals(const float *power, int fftSize, qint64 centerFrequency, int sampleRate, const Settings& settings);
+};
+
+#endif // SDRBASE_DSP_SPECTRUMACTIVITY_H_
@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMFRAMESINK_H_
+#define SDRBASE_DSP_SPECTRUMFRAMESINK_H_
+
+#include <vector>
+#include <QtGlobal>
+
+#include "dsptypes.h"
+
+/**
+ * Consumer of the power spectrum frames produced by SpectrumVis besides the GUI and web socket.
+ * newFrame is called from the DSP thread with the SpectrumVis lock held so it has to return quickly.
+ */
+class SpectrumFrameSink
+{
+public:
+    SpectrumFrameSink() {}
+    virtual ~SpectrumFrameSink() {}
+    virtual bool isActive() const { return true; } //!< SpectrumVis runs the FFT for this sink only when active
+    virtual void newFrame(
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        qint64 centerFrequency,
+        int sampleRate,
+        bool linear
+    ) = 0;
+};
+
+#endif // SDRBASE_DSP_SPECTRUMFRAMESINK_H_
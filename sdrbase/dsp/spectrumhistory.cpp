@@ -0,0 +1,662 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include <QDateTime>
+#include <QDebug>
+
+#include "SWGSpectrumHistory.h"
+
+#include "spectrumhistory.h"
+
+#define SPECTRUMHISTORY_VERSION 1
+#define SPECTRUMHISTORY_DEFAULT_NBBINS 1024
+#define SPECTRUMHISTORY_DEFAULT_CAPACITY 86400 // one day at the default interval
+#define SPECTRUMHISTORY_DEFAULT_INTERVAL_MS 1000
+#define SPECTRUMHISTORY_MAX_BINS 65536
+#define SPECTRUMHISTORY_QUERY_BLOCK_SIZE (1<<16)
+
+const float SpectrumHistory::m_floorDb = -140.0f;
+const float SpectrumHistory::m_stepDb = 0.6f;
+
+static const char spectrumHistoryFileMagic[8] = {'S', 'D', 'R', 'S', 'P', 'H', 'S', '\0'};
+static const char spectrumHistoryQueryMagic[4] = {'S', 'D', 'R', 'H'};
+
+static_assert(sizeof(SpectrumHistory::RecordHeader) == 24, "SpectrumHistory::RecordHeader is expected to be 24 bytes");
+static_assert(sizeof(SpectrumHistory::QueryHeader) == 56, "SpectrumHistory::QueryHeader is expected to be 56 bytes");
+
+SpectrumHistory::SpectrumHistory() :
+    m_open(false),
+    m_map(nullptr),
+    m_header(nullptr),
+    m_nbBins(0),
+    m_capacity(0),
+    m_recordSize(0),
+    m_frameIntervalMs(SPECTRUMHISTORY_DEFAULT_INTERVAL_MS),
+    m_accumulated(0),
+    m_accumulationStartMs(0),
+    m_accumulationCenterFrequency(0),
+    m_accumulationSampleRate(0),
+    m_accumulationFFTSize(0),
+    m_accumulationLinear(false),
+    m_lastTimestampMs(0)
+{}
+
+SpectrumHistory::~SpectrumHistory()
+{
+    close();
+}
+
+bool SpectrumHistory::open(const QString& fileName, unsigned int nbBins, unsigned int capacity)
+{
+    QWriteLocker writeLocker(&m_lock);
+    QMutexLocker writerLocker(&m_writerMutex);
+    closeFile();
+
+    if ((nbBins == 0) || (nbBins > SPECTRUMHISTORY_MAX_BINS) || (capacity < 2))
+    {
+        qWarning("SpectrumHistory::open: invalid geometry: %u bins x %u frames", nbBins, capacity);
+        return false;
+    }
+
+    qint64 size = sizeof(FileHeader) + (qint64) capacity * recordSize(nbBins);
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::ReadWrite))
+    {
+        qWarning("SpectrumHistory::open: cannot open %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        return false;
+    }
+
+    bool sameSize = m_file.size() == size;
+
+    if (!sameSize && !m_file.resize(size))
+    {
+        qWarning("SpectrumHistory::open: cannot size %s to %lld bytes", qPrintable(fileName), size);
+        m_file.close();
+        return false;
+    }
+
+    m_map = m_file.map(0, size);
+
+    if (!m_map)
+    {
+        qWarning("SpectrumHistory::open: cannot map %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        m_file.close();
+        return false;
+    }
+
+    FileHeader *header = (FileHeader*) m_map;
+    bool compatible = sameSize
+        && (std::memcmp(header->m_magic, spectrumHistoryFileMagic, sizeof(spectrumHistoryFileMagic)) == 0)
+        && (header->m_version == SPECTRUMHISTORY_VERSION)
+        && (header->m_nbBins == nbBins)
+        && (header->m_capacity == capacity)
+        && (header->m_recordSize == recordSize(nbBins))
+        && (header->m_floorDb == m_floorDb)
+        && (header->m_stepDb == m_stepDb);
+
+    if (!compatible) // start a new history
+    {
+        std::memset(m_map, 0, size);
+        std::memcpy(header->m_magic, spectrumHistoryFileMagic, sizeof(spectrumHistoryFileMagic));
+        header->m_version = SPECTRUMHISTORY_VERSION;
+        header->m_nbBins = nbBins;
+        header->m_capacity = capacity;
+        header->m_recordSize = recordSize(nbBins);
+        header->m_floorDb = m_floorDb;
+        header->m_stepDb = m_stepDb;
+        new (&header->m_writeCount) std::atomic<quint64>(0);
+    }
+
+    m_header = header;
+    m_nbBins = nbBins;
+    m_capacity = capacity;
+    m_recordSize = recordSize(nbBins);
+    m_accumulator.resize(nbBins);
+    m_accumulated = 0;
+    quint64 writeCount = m_header->m_writeCount.load(std::memory_order_acquire);
+    m_lastTimestampMs = writeCount == 0 ? 0 : getRecord(writeCount - 1)->m_timestampMs;
+    m_open.store(true);
+
+    qDebug("SpectrumHistory::open: %s: %u bins x %u frames %s (%llu frames written)",
+        qPrintable(fileName), nbBins, capacity, compatible ? "resumed" : "created", writeCount);
+
+    return true;
+}
+
+void SpectrumHistory::close()
+{
+    QWriteLocker writeLocker(&m_lock);
+    QMutexLocker writerLocker(&m_writerMutex);
+    closeFile();
+}
+
+void SpectrumHistory::closeFile()
+{
+    m_open.store(false);
+
+    if (m_map)
+    {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    m_header = nullptr;
+    m_accumulated = 0;
+}
+
+void SpectrumHistory::newFrame(
+    const std::vector<Real>& spectrum,
+    int fftSize,
+    qint64 centerFrequency,
+    int sampleRate,
+    bool linear)
+{
+    if (!m_lock.tryLockForRead()) { // store is being reconfigured
+        return;
+    }
+
+    if (!m_header || (fftSize <= 0))
+    {
+        m_lock.unlock();
+        return;
+    }
+
+    // queries share the read lock: the writer state has its own lock
+    m_writerMutex.lock();
+
+    qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+
+    if ((m_accumulated > 0) &&
+        ((centerFrequency != m_accumulationCenterFrequency)
+      || (sampleRate != m_accumulationSampleRate)
+      || (fftSize != m_accumulationFFTSize)
+      || (linear != m_accumulationLinear)))
+    {
+        writeRecord(); // parameters changed: close the frame being accumulated
+    }
+
+    if (m_accumulated == 0)
+    {
+        m_accumulationStartMs = nowMs;
+        m_accumulationCenterFrequency = centerFrequency;
+        m_accumulationSampleRate = sampleRate;
+        m_accumulationFFTSize = fftSize;
+        m_accumulationLinear = linear;
+        std::fill(m_accumulator.begin(), m_accumulator.end(), std::numeric_limits<Real>::lowest());
+    }
+
+    // max hold over time and over the FFT bins falling into each stored bin
+    if ((unsigned int) fftSize == m_nbBins)
+    {
+        for (unsigned int b = 0; b < m_nbBins; b++) {
+            m_accumulator[b] = std::max(m_accumulator[b], spectrum[b]);
+        }
+    }
+    else
+    {
+        for (unsigned int b = 0; b < m_nbBins; b++)
+        {
+            unsigned int k0 = ((quint64) b * fftSize) / m_nbBins;
+            unsigned int k1 = ((quint64) (b + 1) * fftSize) / m_nbBins;
+            k1 = k1 > k0 ? k1 : k0 + 1;
+            Real v = m_accumulator[b];
+
+            for (unsigned int k = k0; k < k1; k++) {
+                v = std::max(v, spectrum[k]);
+            }
+
+            m_accumulator[b] = v;
+        }
+    }
+
+    m_accumulated++;
+
+    if (nowMs - m_accumulationStartMs >= m_frameIntervalMs.load()) {
+        writeRecord();
+    }
+
+    m_writerMutex.unlock();
+    m_lock.unlock();
+}
+
+void SpectrumHistory::writeRecord()
+{
+    quint64 index = m_header->m_writeCount.load(std::memory_order_relaxed);
+    RecordHeader *record = getRecord(index);
+    uchar *bins = (uchar*) record + sizeof(RecordHeader);
+
+    // readers skip the record while its sequence does not match its index
+    record->m_sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_lastTimestampMs = std::max(m_accumulationStartMs, m_lastTimestampMs); // keep time index monotonic
+    record->m_timestampMs = m_lastTimestampMs;
+    record->m_centerFrequency = m_accumulationCenterFrequency;
+    record->m_sampleRate = m_accumulationSampleRate;
+    const float invStep = 1.0f / m_stepDb;
+
+    for (unsigned int b = 0; b < m_nbBins; b++)
+    {
+        Real v = m_accumulator[b];
+        float db = m_accumulationLinear ? (v > 0 ? 10.0f * log10f(v) : m_floorDb) : v;
+        float q = (db - m_floorDb) * invStep + 0.5f;
+        bins[b] = q < 1.0f ? 0 : q > 255.0f ? 255 : (uchar) q;
+    }
+
+    record->m_sequence.store(sequence(index), std::memory_order_release);
+    m_header->m_writeCount.store(index + 1, std::memory_order_release);
+    m_accumulated = 0;
+}
+
+void SpectrumHistory::getValidRange(quint64& first, quint64& end) const
+{
+    // The oldest records are left aside as a guard zone so that they are not
+    // overwritten by the writer while being read.
+    unsigned int guard = m_capacity > 8 ? m_capacity / 8 : 1;
+    unsigned int usable = m_capacity - guard;
+    end = m_header->m_writeCount.load(std::memory_order_acquire);
+    first = end > usable ? end - usable : 0;
+}
+
+quint64 SpectrumHistory::lowerBound(quint64 first, quint64 end, qint64 timestampMs) const
+{
+    quint64 count = end - first;
+
+    while (count > 0)
+    {
+        quint64 step = count / 2;
+        quint64 index = first + step;
+
+        if (getRecord(index)->m_timestampMs < timestampMs)
+        {
+            first = index + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+int SpectrumHistory::query(const Query& query, const QueryOutput& output, QString& errorMessage) const
+{
+    QReadLocker readLocker(&m_lock);
+
+    if (!m_header)
+    {
+        errorMessage = QString("Spectrum history is not enabled");
+        return 404;
+    }
+
+    quint64 first, end;
+    getValidRange(first, end);
+
+    if (first == end)
+    {
+        errorMessage = QString("Spectrum history is empty");
+        return 404;
+    }
+
+    bool fullSpan = (query.m_startFrequency == 0) && (query.m_stopFrequency == 0);
+
+    if (!fullSpan && (query.m_stopFrequency <= query.m_startFrequency))
+    {
+        errorMessage = QString("Invalid frequency window: %1 to %2 Hz").arg(query.m_startFrequency).arg(query.m_stopFrequency);
+        return 400;
+    }
+
+    if ((query.m_timeBins > SPECTRUMHISTORY_MAX_BINS) || (query.m_frequencyBins > SPECTRUMHISTORY_MAX_BINS))
+    {
+        errorMessage = QString("Requested resolution is limited to %1 bins").arg(SPECTRUMHISTORY_MAX_BINS);
+        return 400;
+    }
+
+    qint64 fromMs = query.m_fromMs != 0 ? query.m_fromMs : getRecord(first)->m_timestampMs;
+    qint64 toMs = query.m_toMs != 0 ? query.m_toMs : getRecord(end - 1)->m_timestampMs + 1;
+
+    if (toMs <= fromMs)
+    {
+        errorMessage = QString("Invalid time window: %1 to %2 ms").arg(fromMs).arg(toMs);
+        return 400;
+    }
+
+    quint64 begin = lowerBound(first, end, fromMs);
+    quint64 last = lowerBound(begin, end, toMs);
+    unsigned int columns = query.m_frequencyBins != 0 ? query.m_frequencyBins : m_nbBins;
+    unsigned int rows = query.m_timeBins != 0 ? query.m_timeBins : last - begin;
+    unsigned int rowSize = recordSize(columns);
+
+    QueryHeader queryHeader;
+    std::memcpy(queryHeader.m_magic, spectrumHistoryQueryMagic, sizeof(spectrumHistoryQueryMagic));
+    queryHeader.m_version = SPECTRUMHISTORY_VERSION;
+    queryHeader.m_rows = rows;
+    queryHeader.m_columns = columns;
+    queryHeader.m_floorDb = m_floorDb;
+    queryHeader.m_stepDb = m_stepDb;
+    queryHeader.m_startFrequency = query.m_startFrequency;
+    queryHeader.m_stopFrequency = query.m_stopFrequency;
+    queryHeader.m_fromMs = fromMs;
+    queryHeader.m_toMs = toMs;
+    output(QByteArray((const char*) &queryHeader, sizeof(QueryHeader)));
+
+    if (fullSpan && (columns == m_nbBins) && (query.m_timeBins == 0))
+    {
+        // Native resolution: stream runs of contiguous records straight from the mapping
+        const char *run = nullptr;
+        int runSize = 0;
+        QByteArray emptyRow(rowSize, 0);
+
+        for (quint64 index = begin; index < last; index++)
+        {
+            const RecordHeader *record = getRecord(index);
+
+            if ((run != nullptr) && (((const char*) record != run + runSize) || (runSize >= SPECTRUMHISTORY_QUERY_BLOCK_SIZE)))
+            {
+                output(QByteArray::fromRawData(run, runSize));
+                run = nullptr;
+                runSize = 0;
+            }
+
+            if (record->m_sequence.load(std::memory_order_acquire) == sequence(index))
+            {
+                run = run ? run : (const char*) record;
+                runSize += m_recordSize;
+            }
+            else // overwritten: keep the row count
+            {
+                if (run)
+                {
+                    output(QByteArray::fromRawData(run, runSize));
+                    run = nullptr;
+                    runSize = 0;
+                }
+
+                output(emptyRow);
+            }
+        }
+
+        if (run) {
+            output(QByteArray::fromRawData(run, runSize));
+        }
+
+        return 200;
+    }
+
+    // Decimation: each output cell is the max (or mean) of the stored bins and frames it covers
+    QByteArray block;
+    block.reserve(SPECTRUMHISTORY_QUERY_BLOCK_SIZE + rowSize);
+    std::vector<quint32> sums(columns);
+    std::vector<quint32> counts(columns);
+    std::vector<int> binStart(columns);
+    std::vector<int> binEnd(columns);
+    qint64 mapCenterFrequency = 0;
+    qint32 mapSampleRate = 0;
+    qint64 rowCenterFrequency = (query.m_startFrequency + query.m_stopFrequency) / 2;
+    qint64 rowSampleRate = query.m_stopFrequency - query.m_startFrequency;
+    quint32 rowFrames = 0;
+    qint64 rowTimestampMs = fromMs;
+    unsigned int row = 0;
+
+    auto flushRow = [&]() {
+        char *r = block.data() + block.size();
+        block.resize(block.size() + rowSize);
+        std::memset(r, 0, rowSize);
+        std::memcpy(r, &rowTimestampMs, sizeof(qint64));
+        std::memcpy(r + 8, &rowCenterFrequency, sizeof(qint64));
+        qint32 rowSpan = (qint32) std::min(rowSampleRate, (qint64) std::numeric_limits<qint32>::max()); // window span may exceed the record field
+        std::memcpy(r + 16, &rowSpan, sizeof(qint32));
+        std::memcpy(r + 20, &rowFrames, sizeof(quint32));
+        uchar *cells = (uchar*) r + sizeof(RecordHeader);
+
+        for (unsigned int j = 0; j < columns; j++) {
+            cells[j] = counts[j] == 0 ? 0 : (uchar) (query.m_mode == DecimationMax ? sums[j] : (sums[j] + counts[j]/2) / counts[j]);
+        }
+
+        std::fill(sums.begin(), sums.end(), 0);
+        std::fill(counts.begin(), counts.end(), 0);
+        rowFrames = 0;
+        row++;
+
+        if (block.size() >= SPECTRUMHISTORY_QUERY_BLOCK_SIZE)
+        {
+            output(block);
+            block.resize(0);
+        }
+    };
+
+    auto padRow = [&]() { // empty row in place of an overwritten record as in the native resolution case
+        block.append(QByteArray(rowSize, 0));
+        row++;
+
+        if (block.size() >= SPECTRUMHISTORY_QUERY_BLOCK_SIZE)
+        {
+            output(block);
+            block.resize(0);
+        }
+    };
+
+    for (quint64 index = begin; index < last; index++)
+    {
+        const RecordHeader *record = getRecord(index);
+
+        if (record->m_sequence.load(std::memory_order_acquire) != sequence(index)) // overwritten
+        {
+            if (query.m_timeBins == 0) { // one row per record: keep rows in time order
+                padRow();
+            }
+
+            continue;
+        }
+
+        qint64 timestampMs = record->m_timestampMs;
+        qint64 centerFrequency = record->m_centerFrequency;
+        qint32 sampleRate = record->m_sampleRate;
+
+        if (query.m_timeBins != 0)
+        {
+            unsigned int frameRow = ((timestampMs - fromMs) * (qint64) rows) / (toMs - fromMs);
+
+            while (row < frameRow) // close current row and any empty rows before this frame
+            {
+                rowTimestampMs = fromMs + ((toMs - fromMs) * (qint64) row) / rows;
+                flushRow();
+            }
+        }
+        else
+        {
+            rowTimestampMs = timestampMs;
+        }
+
+        if (fullSpan)
+        {
+            rowCenterFrequency = centerFrequency;
+            rowSampleRate = sampleRate;
+        }
+
+        if ((centerFrequency != mapCenterFrequency) || (sampleRate != mapSampleRate))
+        {
+            // map output columns to the record bins for this record frequency span
+            double frameStart = centerFrequency - sampleRate / 2.0;
+            double windowStart = fullSpan ? frameStart : query.m_startFrequency;
+            double windowSpan = fullSpan ? sampleRate : (double) (query.m_stopFrequency - query.m_startFrequency);
+            double binsPerHz = sampleRate > 0 ? m_nbBins / (double) sampleRate : 0.0;
+
+            for (unsigned int j = 0; j < columns; j++)
+            {
+                double f0 = windowStart + (windowSpan * j) / columns;
+                double f1 = windowStart + (windowSpan * (j + 1)) / columns;
+                int k0 = (int) std::floor((f0 - frameStart) * binsPerHz);
+                int k1 = (int) std::ceil((f1 - frameStart) * binsPerHz);
+
+                if ((k0 >= (int) m_nbBins) || (k1 <= 0) || (binsPerHz == 0.0))
+                {
+                    binStart[j] = 0;
+                    binEnd[j] = 0; // not covered by this record
+                }
+                else
+                {
+                    k0 = std::max(k0, 0);
+                    k1 = std::min(std::max(k1, k0 + 1), (int) m_nbBins);
+                    binStart[j] = k0;
+                    binEnd[j] = k1;
+                }
+            }
+
+            mapCenterFrequency = centerFrequency;
+            mapSampleRate = sampleRate;
+        }
+
+        const uchar *bins = (const uchar*) record + sizeof(RecordHeader);
+
+        for (unsigned int j = 0; j < columns; j++)
+        {
+            if (query.m_mode == DecimationMax)
+            {
+                quint32 v = sums[j];
+
+                for (int k = binStart[j]; k < binEnd[j]; k++) {
+                    v = std::max(v, (quint32) bins[k]);
+                }
+
+                sums[j] = v;
+            }
+            else
+            {
+                for (int k = binStart[j]; k < binEnd[j]; k++) {
+                    sums[j] += bins[k];
+                }
+            }
+
+            counts[j] += binEnd[j] - binStart[j];
+        }
+
+        rowFrames++;
+
+        if (query.m_timeBins == 0) {
+            flushRow();
+        }
+    }
+
+    // remaining empty rows up to the requested count
+    while (row < rows)
+    {
+        if (query.m_timeBins != 0) {
+            rowTimestampMs = fromMs + ((toMs - fromMs) * (qint64) row) / rows;
+        }
+
+        flushRow();
+    }
+
+    if (block.size() > 0) {
+        output(block);
+    }
+
+    return 200;
+}
+
+int SpectrumHistory::webapiSettingsGet(
+        SWGSDRangel::SWGSpectrumHistory& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    QReadLocker readLocker(&m_lock);
+    response.setEnable(m_header ? 1 : 0);
+    response.setFrameIntervalMs(m_frameIntervalMs.load());
+    response.setFloorDb(m_floorDb);
+    response.setStepDb(m_stepDb);
+
+    if (m_header)
+    {
+        quint64 first, end;
+        getValidRange(first, end);
+
+        if (response.getFileName()) {
+            *response.getFileName() = m_file.fileName();
+        } else {
+            response.setFileName(new QString(m_file.fileName()));
+        }
+
+        response.setNbBins(m_nbBins);
+        response.setCapacity(m_capacity);
+        response.setNbFrames(end - first);
+        response.setOldestTimestampMs(first == end ? 0 : getRecord(first)->m_timestampMs);
+        response.setNewestTimestampMs(first == end ? 0 : getRecord(end - 1)->m_timestampMs);
+    }
+    else
+    {
+        response.setNbFrames(0);
+        response.setOldestTimestampMs(0);
+        response.setNewestTimestampMs(0);
+    }
+
+    return 200;
+}
+
+int SpectrumHistory::webapiSettingsPut(
+        SWGSDRangel::SWGSpectrumHistory& response,
+        QString& errorMessage)
+{
+    int frameIntervalMs = response.getFrameIntervalMs() > 0 ? response.getFrameIntervalMs() : SPECTRUMHISTORY_DEFAULT_INTERVAL_MS;
+    setFrameInterval(frameIntervalMs);
+
+    if (response.getEnable() != 0)
+    {
+        QString fileName = response.getFileName() ? *response.getFileName() : QString();
+        unsigned int nbBins = response.getNbBins() > 0 ? response.getNbBins() : SPECTRUMHISTORY_DEFAULT_NBBINS;
+        unsigned int capacity = response.getCapacity() > 0 ? response.getCapacity() : SPECTRUMHISTORY_DEFAULT_CAPACITY;
+
+        if (fileName.isEmpty())
+        {
+            errorMessage = QString("fileName is required to enable spectrum history");
+            return 400;
+        }
+
+        bool unchanged;
+
+        {
+            QReadLocker readLocker(&m_lock);
+            unchanged = m_header && (fileName == m_file.fileName()) && (nbBins == m_nbBins) && (capacity == m_capacity);
+        }
+
+        if (!unchanged && !open(fileName, nbBins, capacity))
+        {
+            errorMessage = QString("Cannot open spectrum history file %1 for %2 bins x %3 frames")
+                .arg(fileName).arg(nbBins).arg(capacity);
+            return 500;
+        }
+    }
+    else
+    {
+        close();
+    }
+
+    return webapiSettingsGet(response, errorMessage);
+}
@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Persistent spectrum history store                                             //
+//                                                                               //
+// Power spectrum frames are quantized to 8 bits and appended to a circular file //
+// mapped in memory. The file survives restarts and can be queried over a time   //
+// and frequency window with decimation to the requested resolution.             //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMHISTORY_H_
+#define SDRBASE_DSP_SPECTRUMHISTORY_H_
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QString>
+
+#include "dsp/spectrumframesink.h"
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGSpectrumHistory;
+}
+
+class SDRBASE_API SpectrumHistory : public SpectrumFrameSink
+{
+public:
+    enum DecimationMode
+    {
+        DecimationMax,  //!< keep the maximum of the cell (does not hide short or narrow signals)
+        DecimationMean  //!< mean of the cell in dB
+    };
+
+    struct Query
+    {
+        qint64 m_fromMs;              //!< start of time window in ms since epoch (0: oldest frame)
+        qint64 m_toMs;                //!< end of time window in ms since epoch (0: newest frame)
+        qint64 m_startFrequency;      //!< start of frequency window in Hz (start = stop = 0: span of each frame)
+        qint64 m_stopFrequency;       //!< end of frequency window in Hz
+        unsigned int m_timeBins;      //!< number of output rows (0: one row per stored frame)
+        unsigned int m_frequencyBins; //!< number of output columns (0: number of stored bins)
+        DecimationMode m_mode;
+
+        Query() :
+            m_fromMs(0),
+            m_toMs(0),
+            m_startFrequency(0),
+            m_stopFrequency(0),
+            m_timeBins(0),
+            m_frequencyBins(0),
+            m_mode(DecimationMax)
+        {}
+    };
+
+    /**
+     * Query result header. It is followed by rows of RecordHeader + columns bytes padded to 8 bytes.
+     * Byte values are power in dB: floorDb + value * stepDb (0 means at or below floor or no data)
+     */
+    struct QueryHeader
+    {
+        char m_magic[4];         //!< "SDRH"
+        quint32 m_version;
+        quint32 m_rows;
+        quint32 m_columns;
+        float m_floorDb;
+        float m_stepDb;
+        qint64 m_startFrequency; //!< 0 with stop frequency 0 when rows are native frames
+        qint64 m_stopFrequency;
+        qint64 m_fromMs;
+        qint64 m_toMs;
+    };
+
+    struct RecordHeader
+    {
+        qint64 m_timestampMs;            //!< start of the frame (or row) in ms since epoch
+        qint64 m_centerFrequency;        //!< center frequency of the frame (or window) in Hz
+        qint32 m_sampleRate;             //!< span of the frame (or window) in Hz
+        std::atomic<quint32> m_sequence; //!< frame index + 1 modulo 2^32 (0 while being written). Number of frames aggregated in decimated rows
+    };
+
+    typedef std::function<void(const QByteArray&)> QueryOutput;
+
+    SpectrumHistory();
+    virtual ~SpectrumHistory();
+
+    bool open(const QString& fileName, unsigned int nbBins, unsigned int capacity); //!< Open existing store if compatible else create it
+    void close();
+    bool isOpen() const { return m_open.load(); }
+    void setFrameInterval(int frameIntervalMs) { m_frameIntervalMs.store(frameIntervalMs < 0 ? 0 : frameIntervalMs); }
+    int getFrameInterval() const { return m_frameIntervalMs.load(); }
+
+    virtual bool isActive() const { return m_open.load(); }
+
+    virtual void newFrame(
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        qint64 centerFrequency,
+        int sampleRate,
+        bool linear
+    );
+
+    /**
+     * Stream a time x frequency window of the history to output. Runs in the caller's thread
+     * and reads the mapped file directly without ever blocking the writer.
+     * Returns Http status code. Nothing is output if an error is returned.
+     */
+    int query(const Query& query, const QueryOutput& output, QString& errorMessage) const;
+
+    int webapiSettingsGet(
+            SWGSDRangel::SWGSpectrumHistory& response,
+            QString& errorMessage);
+
+    int webapiSettingsPut(
+            SWGSDRangel::SWGSpectrumHistory& response,
+            QString& errorMessage);
+
+    static const float m_floorDb;
+    static const float m_stepDb;
+
+private:
+    struct FileHeader
+    {
+        char m_magic[8];                   //!< "SDRSPHS"
+        quint32 m_version;
+        quint32 m_nbBins;
+        quint32 m_capacity;                //!< number of frame records
+        quint32 m_recordSize;              //!< bytes per frame record
+        float m_floorDb;
+        float m_stepDb;
+        std::atomic<quint64> m_writeCount; //!< number of frames written since creation
+    };
+
+    mutable QReadWriteLock m_lock; //!< open/close vs frame writes and queries
+    QMutex m_writerMutex;          //!< writer state below. Taken after m_lock
+    std::atomic<bool> m_open;
+    QFile m_file;
+    uchar *m_map;
+    FileHeader *m_header;
+    unsigned int m_nbBins;
+    unsigned int m_capacity;
+    unsigned int m_recordSize;
+    std::atomic<int> m_frameIntervalMs;
+    // frame accumulation between records
+    std::vector<Real> m_accumulator;
+    unsigned int m_accumulated;
+    qint64 m_accumulationStartMs;
+    qint64 m_accumulationCenterFrequency;
+    int m_accumulationSampleRate;
+    int m_accumulationFFTSize;
+    bool m_accumulationLinear;
+    qint64 m_lastTimestampMs;
+
+    RecordHeader *getRecord(quint64 index) const {
+        return (RecordHeader*) (m_map + sizeof(FileHeader) + (index % m_capacity) * m_recordSize);
+    }
+    static quint32 sequence(quint64 index) { return (quint32) (index + 1); }
+    static unsigned int recordSize(unsigned int nbBins) { return (sizeof(RecordHeader) + nbBins + 7) & ~7U; }
+    void writeRecord();
+    void getValidRange(quint64& first, quint64& end) const;
+    quint64 lowerBound(quint64 first, quint64 end, qint64 timestampMs) const;
+    void closeFile();
+};
+
+#endif // SDRBASE_DSP_SPECTRUMHISTORY_H_
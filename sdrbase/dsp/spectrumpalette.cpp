@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////////
-// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
 //                                                                               //
 // This program is free software; you can redistribute it and/or modify          //
 // it under the terms of the GNU General Public License as published by          //
@@ -15,7 +15,15 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include "udpsourcemsg.h"
+#include "spectrumpalette.h"
 
-MESSAGE_CLASS_DEFINITION(UDPSourceMessages::MsgSampleRateCorrection, Message)
+QColor SpectrumPalette::getWaterfallColor(int index)
+{
+    if (index >= m_waterfallPaletteSize - 1) {
+        return QColor(255, 255, 255, 255);
+    }
 
+    QColor c;
+    c.setHsv(239 - (index < 0 ? 0 : index), 255, 15 + (index < 0 ? 0 : index));
+    return c;
+}
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////////
-// Copyright (C) 2017 Edouard Griffiths, F4EXB                                   //
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
 //                                                                               //
 // This program is free software; you can redistribute it and/or modify          //
 // it under the terms of the GNU General Public License as published by          //
@@ -15,40 +15,32 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#ifndef PLUGINS_CHANNELTX_UDPSINK_UDPSOURCEMSG_H_
-#define PLUGINS_CHANNELTX_UDPSINK_UDPSOURCEMSG_H_
+#ifndef SDRBASE_DSP_SPECTRUMPALETTE_H_
+#define SDRBASE_DSP_SPECTRUMPALETTE_H_
 
-#include "util/message.h"
+#include <QColor>
+
+#include "export.h"
 
 /**
- * Message(s) used to communicate back from UDPSinkUDPHandler to UDPSource
+ * Waterfall colour palette shared by the OpenGL spectrum display and the headless renderers
  */
-class UDPSourceMessages
+class SDRBASE_API SpectrumPalette
 {
 public:
-    class MsgSampleRateCorrection : public Message {
-        MESSAGE_CLASS_DECLARATION
-
-    public:
-        float getCorrectionFactor() const { return m_correctionFactor; }
-        float getRawDeltaRatio() const { return m_rawDeltaRatio; }
-
-        static MsgSampleRateCorrection* create(float correctionFactor, float rawDeltaRatio)
-        {
-            return new MsgSampleRateCorrection(correctionFactor, rawDeltaRatio);
-        }
-
-    private:
-        float m_correctionFactor;
-        float m_rawDeltaRatio;
-
-        MsgSampleRateCorrection(float correctionFactor, float rawDeltaRatio) :
-            Message(),
-            m_correctionFactor(correctionFactor),
-            m_rawDeltaRatio(rawDeltaRatio)
-        { }
-    };
+    static const int m_waterfallPaletteSize = 240;
+
+    static QColor getWaterfallColor(int index); //!< index in [0, m_waterfallPaletteSize - 1]. Top index is white.
+
+    /**
+     * Waterfall power to palette index with GLSpectrum scaling: the reference level is at the top
+     * of the palette and the power range spans the palette. Results are clamped to the palette.
+     */
+    static int getWaterfallIndex(float power, float referenceLevel, float powerRange)
+    {
+        int v = (int) ((power - referenceLevel) * 2.4f * 100.0f / powerRange + 240.0f);
+        return v < 0 ? 0 : v > 239 ? 239 : v;
+    }
 };
 
-
-#endif /* PLUGINS_CHANNELTX_UDPSINK_UDPSOURCEMSG_H_ */
+#endif // SDRBASE_DSP_SPECTRUMPALETTE_H_
@@ -18,7 +18,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "glspectruminterface.h"
+#include "spectrumframesink.h"
 #include "dspcommands.h"
 #include "dspengine.h"
 #include "fftfactory.h"
@@ -27,6 +30,9 @@
 #include "spectrumvis.h"
 
 #define MAX_FFT_SIZE 4096
+#define WELCH_BATCH_SIZE 4 // Welch input batch size in number of FFT lengths
+#define WELCH_MAX_OVERLAP 75
+#define ZOOM_BUFFER_SIZE 4096 // multiple of the maximum zoom decimation (64)
 
 #ifndef LINUX
 inline double log2f(double n)
@@ -54,8 +60,19 @@ SpectrumVis::SpectrumVis(Real scalef) :
 	m_needMoreSamples(false),
 	m_scalef(scalef),
 	m_glSpectrum(nullptr),
+    m_welchBuffer(WELCH_BATCH_SIZE*MAX_FFT_SIZE),
+    m_welchBufferFill(0),
+    m_welchSum(MAX_FFT_SIZE),
+    m_welchCount(0),
+    m_welchNb(1),
+    m_windowPower(1.0),
+    m_zoomBuffer(2*ZOOM_BUFFER_SIZE),
+    m_zoomBufferFill(0),
+    m_zoomDecimated(ZOOM_BUFFER_SIZE),
     m_centerFrequency(0),
     m_sampleRate(48000),
+    m_deviceCenterFrequency(0),
+    m_deviceSampleRate(48000),
 	m_ofs(0),
     m_powFFTDiv(1.0),
 	m_mutex(QMutex::Recursive)
@@ -143,14 +160,16 @@ void SpectrumVis::feedTriggered(const SampleVector::const_iterator& triggerPoint
 
 void SpectrumVis::feed(const Complex *begin, unsigned int length)
 {
-	if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
-		return;
-	}
-
     if (!m_mutex.tryLock(0)) { // prevent conflicts with configuration process
         return;
     }
 
+    if (!hasConsumers())
+    {
+        m_mutex.unlock();
+        return;
+    }
+
     Complex c;
     Real v;
 
@@ -169,24 +188,7 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
             m_powerSpectrum[i] = v;
         }
 
-        // send new data to visualisation
-        if (m_glSpectrum) {
-            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-        }
-
-        // web socket spectrum connections
-        if (m_wsSpectrum.socketOpened())
-        {
-            m_wsSpectrum.newSpectrum(
-                m_powerSpectrum,
-                m_settings.m_fftSize,
-                m_settings.m_refLevel,
-                m_settings.m_powerRange,
-                m_centerFrequency,
-                m_sampleRate,
-                m_settings.m_linear
-            );
-        }
+        sendSpectrum();
     }
     else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMoving)
     {
@@ -204,28 +206,12 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
             m_powerSpectrum[i] = v;
         }
 
-        // send new data to visualisation
-        if (m_glSpectrum) {
-            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-        }
-
-        // web socket spectrum connections
-        if (m_wsSpectrum.socketOpened())
-        {
-            m_wsSpectrum.newSpectrum(
-                m_powerSpectrum,
-                m_settings.m_fftSize,
-                m_settings.m_refLevel,
-                m_settings.m_powerRange,
-                m_centerFrequency,
-                m_sampleRate,
-                m_settings.m_linear
-            );
-        }
+        sendSpectrum();
 
         m_movingAverage.nextAverage();
     }
-    else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
+    else if ((m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
+          || (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeWelch)) // no segments to overlap on direct feed
     {
         double avg;
 
@@ -250,24 +236,7 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
         // result available
         if (m_fixedAverage.nextAverage())
         {
-            // send new data to visualisation
-            if (m_glSpectrum) {
-                m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-            }
-
-            // web socket spectrum connections
-            if (m_wsSpectrum.socketOpened())
-            {
-                m_wsSpectrum.newSpectrum(
-                    m_powerSpectrum,
-                    m_settings.m_fftSize,
-                    m_settings.m_refLevel,
-                    m_settings.m_powerRange,
-                    m_centerFrequency,
-                    m_sampleRate,
-                    m_settings.m_linear
-                );
-            }
+            sendSpectrum();
         }
     }
     else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
@@ -295,24 +264,7 @@ void SpectrumVis::feed(const Complex *begin, unsigned int length)
         // result available
         if (m_max.nextMax())
         {
-            // send new data to visualisation
-            if (m_glSpectrum) {
-                m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-            }
-
-            // web socket spectrum connections
-            if (m_wsSpectrum.socketOpened())
-            {
-                m_wsSpectrum.newSpectrum(
-                    m_powerSpectrum,
-                    m_settings.m_fftSize,
-                    m_settings.m_refLevel,
-                    m_settings.m_powerRange,
-                    m_centerFrequency,
-                    m_sampleRate,
-                    m_settings.m_linear
-                );
-            }
+            sendSpectrum();
         }
     }
 
@@ -325,16 +277,89 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
         return;
     }
 
-	// if no visualisation is set, send the samples to /dev/null
-	if (!m_glSpectrum && !m_wsSpectrum.socketOpened()) {
-		return;
-	}
-
     if (!m_mutex.tryLock(0)) { // prevent conflicts with configuration process
         return;
     }
 
-	SampleVector::const_iterator begin(cbegin);
+	// if no visualisation is set, send the samples to /dev/null
+    if (!hasConsumers())
+    {
+        m_mutex.unlock();
+        return;
+    }
+
+    if (m_settings.m_zoomLog2Decim > 0) {
+        feedZoom(cbegin, end);
+    } else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeWelch) {
+        feedWelch(cbegin, end, positiveOnly);
+    } else {
+        feedFrames(cbegin, end, positiveOnly);
+    }
+
+    m_mutex.unlock();
+}
+
+void SpectrumVis::feedZoom(const SampleVector::const_iterator& cbegin, const SampleVector::const_iterator& end)
+{
+    // shift zoomed sub-band to baseband and decimate with the half band filters chain.
+    // The buffer length is a multiple of the largest decimation so that decimators consume it entirely.
+    SampleVector::const_iterator begin(cbegin);
+    Complex c;
+
+    while (begin < end)
+    {
+        for (; (begin < end) && (m_zoomBufferFill < ZOOM_BUFFER_SIZE); ++begin, m_zoomBufferFill++)
+        {
+            c = Complex(begin->real(), begin->imag()) * m_zoomNCO.nextIQ();
+            m_zoomBuffer[2*m_zoomBufferFill] = c.real();
+            m_zoomBuffer[2*m_zoomBufferFill + 1] = c.imag();
+        }
+
+        if (m_zoomBufferFill < ZOOM_BUFFER_SIZE) {
+            break;
+        }
+
+        FSampleVector::iterator it = m_zoomDecimated.begin();
+
+        switch (m_settings.m_zoomLog2Decim)
+        {
+        case 1:
+            m_zoomDecimators.decimate2_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        case 2:
+            m_zoomDecimators.decimate4_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        case 3:
+            m_zoomDecimators.decimate8_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        case 4:
+            m_zoomDecimators.decimate16_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        case 5:
+            m_zoomDecimators.decimate32_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        case 6:
+        default:
+            m_zoomDecimators.decimate64_cen(&it, m_zoomBuffer.data(), 2*ZOOM_BUFFER_SIZE);
+            break;
+        }
+
+        m_zoomBufferFill = 0;
+        FSampleVector::const_iterator dbegin = m_zoomDecimated.begin();
+        FSampleVector::const_iterator dend = it;
+
+        if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeWelch) {
+            feedWelch(dbegin, dend, false);
+        } else {
+            feedFrames(dbegin, dend, false);
+        }
+    }
+}
+
+template<typename SampleIt>
+void SpectrumVis::feedFrames(const SampleIt& cbegin, const SampleIt& end, bool positiveOnly)
+{
+	SampleIt begin(cbegin);
 
 	while (begin < end)
 	{
@@ -392,24 +417,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
                     }
                 }
 
-                // send new data to visualisation
-                if (m_glSpectrum) {
-                    m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                }
-
-                // web socket spectrum connections
-                if (m_wsSpectrum.socketOpened())
-                {
-                    m_wsSpectrum.newSpectrum(
-                        m_powerSpectrum,
-                        m_settings.m_fftSize,
-                        m_settings.m_refLevel,
-                        m_settings.m_powerRange,
-                        m_centerFrequency,
-                        m_sampleRate,
-                        m_settings.m_linear
-                    );
-                }
+                sendSpectrum();
 			}
 			else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMoving)
 			{
@@ -443,24 +451,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 	                }
 	            }
 
-	            // send new data to visualisation
-                if (m_glSpectrum) {
-    	            m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                }
-
-                // web socket spectrum connections
-                if (m_wsSpectrum.socketOpened())
-                {
-                    m_wsSpectrum.newSpectrum(
-                        m_powerSpectrum,
-                        m_settings.m_fftSize,
-                        m_settings.m_refLevel,
-                        m_settings.m_powerRange,
-                        m_centerFrequency,
-                        m_sampleRate,
-                        m_settings.m_linear
-                    );
-                }
+	            sendSpectrum();
 
 	            m_movingAverage.nextAverage();
 			}
@@ -512,24 +503,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
                 // result available
                 if (m_fixedAverage.nextAverage())
                 {
-                    // send new data to visualisation
-                    if (m_glSpectrum) {
-                        m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                    }
-
-                    // web socket spectrum connections
-                    if (m_wsSpectrum.socketOpened())
-                    {
-                        m_wsSpectrum.newSpectrum(
-                            m_powerSpectrum,
-                            m_settings.m_fftSize,
-                            m_settings.m_refLevel,
-                            m_settings.m_powerRange,
-                            m_centerFrequency,
-                            m_sampleRate,
-                            m_settings.m_linear
-                        );
-                    }
+                    sendSpectrum();
                 }
 			}
 			else if (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
@@ -580,24 +554,7 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
                 // result available
                 if (m_max.nextMax())
                 {
-                    // send new data to visualisation
-                    if (m_glSpectrum) {
-                        m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
-                    }
-
-                    // web socket spectrum connections
-                    if (m_wsSpectrum.socketOpened())
-                    {
-                        m_wsSpectrum.newSpectrum(
-                            m_powerSpectrum,
-                            m_settings.m_fftSize,
-                            m_settings.m_refLevel,
-                            m_settings.m_powerRange,
-                            m_centerFrequency,
-                            m_sampleRate,
-                            m_settings.m_linear
-                        );
-                    }
+                    sendSpectrum();
                 }
 			}
 
@@ -620,8 +577,165 @@ void SpectrumVis::feed(const SampleVector::const_iterator& cbegin, const SampleV
 			m_needMoreSamples = true;
 		}
 	}
+}
+
+template<typename SampleIt>
+void SpectrumVis::feedWelch(const SampleIt& cbegin, const SampleIt& end, bool positiveOnly)
+{
+    // Welch's method: power spectra of overlapping windowed segments are averaged over
+    // m_welchNb segments and one frame is produced per m_welchNb segments.
+    // Input is batched over several FFT lengths so that all complete segments in the batch
+    // are transformed in one pass before the remainder is moved to the front of the buffer.
+    SampleIt begin(cbegin);
+    std::size_t fftSize = m_settings.m_fftSize;
+    std::size_t halfSize = fftSize / 2;
+    std::size_t bufferSize = WELCH_BATCH_SIZE * fftSize;
+
+    while (begin < end)
+    {
+        std::size_t todo = std::min((std::size_t) (end - begin), bufferSize - m_welchBufferFill);
+        std::vector<Complex>::iterator it = m_welchBuffer.begin() + m_welchBufferFill;
+
+        for (std::size_t i = 0; i < todo; ++i, ++begin) {
+            *it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
+        }
 
-	 m_mutex.unlock();
+        m_welchBufferFill += todo;
+        std::size_t segmentStart = 0;
+
+        for (; segmentStart + fftSize <= m_welchBufferFill; segmentStart += m_refillSize)
+        {
+            m_window.apply(&m_welchBuffer[segmentStart], m_fft->in());
+            m_fft->transform();
+            const Complex* fftOut = m_fft->out();
+
+            if (positiveOnly)
+            {
+                for (std::size_t i = 0; i < halfSize; i++) {
+                    m_welchSum[i] += fftOut[i].real() * fftOut[i].real() + fftOut[i].imag() * fftOut[i].imag();
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < halfSize; i++)
+                {
+                    const Complex& cn = fftOut[i + halfSize];
+                    const Complex& cp = fftOut[i];
+                    m_welchSum[i] += cn.real() * cn.real() + cn.imag() * cn.imag();
+                    m_welchSum[i + halfSize] += cp.real() * cp.real() + cp.imag() * cp.imag();
+                }
+            }
+
+            if (++m_welchCount < m_welchNb) {
+                continue;
+            }
+
+            // window power corrected average
+            double norm = 1.0 / (m_welchNb * m_windowPower);
+            Real v;
+
+            if (positiveOnly)
+            {
+                for (std::size_t i = 0; i < halfSize; i++)
+                {
+                    v = m_welchSum[i] * norm;
+                    v = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+                    m_powerSpectrum[i * 2] = v;
+                    m_powerSpectrum[i * 2 + 1] = v;
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < fftSize; i++)
+                {
+                    v = m_welchSum[i] * norm;
+                    m_powerSpectrum[i] = m_settings.m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+                }
+            }
+
+            std::fill(m_welchSum.begin(), m_welchSum.begin() + fftSize, 0.0);
+            m_welchCount = 0;
+
+            sendSpectrum();
+        }
+
+        // keep the samples of the next (incomplete) segment
+        std::copy(m_welchBuffer.begin() + segmentStart, m_welchBuffer.begin() + m_welchBufferFill, m_welchBuffer.begin());
+        m_welchBufferFill -= segmentStart;
+    }
+}
+
+void SpectrumVis::addFrameSink(SpectrumFrameSink *frameSink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (std::find(m_frameSinks.begin(), m_frameSinks.end(), frameSink) == m_frameSinks.end()) {
+        m_frameSinks.push_back(frameSink);
+    }
+}
+
+void SpectrumVis::removeFrameSink(SpectrumFrameSink *frameSink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    std::vector<SpectrumFrameSink*>::iterator it = std::find(m_frameSinks.begin(), m_frameSinks.end(), frameSink);
+
+    if (it != m_frameSinks.end()) {
+        m_frameSinks.erase(it);
+    }
+}
+
+bool SpectrumVis::hasConsumers()
+{
+    if (m_glSpectrum || m_wsSpectrum.socketOpened()) {
+        return true;
+    }
+
+    for (std::vector<SpectrumFrameSink*>::const_iterator it = m_frameSinks.begin(); it != m_frameSinks.end(); ++it)
+    {
+        if ((*it)->isActive()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SpectrumVis::sendSpectrum()
+{
+    // send new data to visualisation
+    if (m_glSpectrum) {
+        m_glSpectrum->newSpectrum(m_powerSpectrum, m_settings.m_fftSize);
+    }
+
+    // web socket spectrum connections
+    if (m_wsSpectrum.socketOpened())
+    {
+        m_wsSpectrum.newSpectrum(
+            m_powerSpectrum,
+            m_settings.m_fftSize,
+            m_settings.m_refLevel,
+            m_settings.m_powerRange,
+            m_centerFrequency,
+            m_sampleRate,
+            m_settings.m_linear
+        );
+    }
+
+    // other consumers (history, detection...)
+    for (std::vector<SpectrumFrameSink*>::iterator it = m_frameSinks.begin(); it != m_frameSinks.end(); ++it)
+    {
+        if (!(*it)->isActive()) {
+            continue;
+        }
+
+        (*it)->newFrame(
+            m_powerSpectrum,
+            m_settings.m_fftSize,
+            m_centerFrequency,
+            m_sampleRate,
+            m_settings.m_linear
+        );
+    }
 }
 
 void SpectrumVis::start()
@@ -705,12 +819,19 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
             64 :
             settings.m_fftSize;
 
-    int overlapPercent = settings.m_fftOverlap > 100 ?
-        100 :
+    int maxOverlap = settings.m_averagingMode == GLSpectrumSettings::AvgModeWelch ? WELCH_MAX_OVERLAP : 100;
+    int overlapPercent = settings.m_fftOverlap > maxOverlap ?
+        maxOverlap :
         settings.m_fftOverlap < 0 ?
             0 :
             settings.m_fftOverlap;
 
+    int zoomLog2Decim = settings.m_zoomLog2Decim > GLSpectrumSettings::m_zoomMaxLog2Decim ?
+        GLSpectrumSettings::m_zoomMaxLog2Decim :
+        settings.m_zoomLog2Decim < 0 ?
+            0 :
+            settings.m_zoomLog2Decim;
+
     qDebug() << "SpectrumVis::applySettings:"
         << " m_fftSize: " << fftSize
         << " m_fftWindow: " << settings.m_fftWindow
@@ -720,6 +841,8 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
         << " m_refLevel: " << settings.m_refLevel
         << " m_powerRange: " << settings.m_powerRange
         << " m_linear: " << settings.m_linear
+        << " m_zoomFrequencyOffset: " << settings.m_zoomFrequencyOffset
+        << " m_zoomLog2Decim: " << zoomLog2Decim
         << " force: " << force;
 
     if ((fftSize != m_settings.m_fftSize) || force)
@@ -740,6 +863,7 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
      || (settings.m_fftWindow != m_settings.m_fftWindow) || force)
     {
         m_window.create(settings.m_fftWindow, fftSize);
+        m_windowPower = m_window.getPower();
     }
 
     if ((fftSize != m_settings.m_fftSize)
@@ -758,18 +882,61 @@ void SpectrumVis::applySettings(const GLSpectrumSettings& settings, bool force)
         m_movingAverage.resize(fftSize, averagingValue > 1000 ? 1000 : averagingValue); // Capping to avoid out of memory condition
         m_fixedAverage.resize(fftSize, averagingValue);
         m_max.resize(fftSize, averagingValue);
+        m_welchNb = averagingValue;
+    }
+
+    if ((fftSize != m_settings.m_fftSize)
+     || (overlapPercent != m_settings.m_fftOverlap)
+     || (settings.m_averagingIndex != m_settings.m_averagingIndex)
+     || (settings.m_averagingMode != m_settings.m_averagingMode) || force)
+    {
+        std::fill(m_welchSum.begin(), m_welchSum.end(), 0.0);
+        m_welchCount = 0;
+        m_welchBufferFill = 0;
+    }
+
+    if ((zoomLog2Decim != m_settings.m_zoomLog2Decim)
+     || (settings.m_zoomFrequencyOffset != m_settings.m_zoomFrequencyOffset) || force)
+    {
+        m_zoomDecimators = DecimatorsFF<true>(); // reset filters history
+        m_zoomBufferFill = 0;
+        m_fftBufferFill = m_overlapSize;
+        m_welchBufferFill = 0;
     }
 
     m_settings = settings;
     m_settings.m_fftSize = fftSize;
     m_settings.m_fftOverlap = overlapPercent;
+    m_settings.m_zoomLog2Decim = zoomLog2Decim;
+    applyZoom();
 }
 
 void SpectrumVis::handleConfigureDSP(uint64_t centerFrequency, int sampleRate)
 {
     QMutexLocker mutexLocker(&m_mutex);
-    m_centerFrequency = centerFrequency;
-    m_sampleRate = sampleRate;
+    m_deviceCenterFrequency = centerFrequency;
+    m_deviceSampleRate = sampleRate;
+    applyZoom();
+}
+
+void SpectrumVis::applyZoom()
+{
+    // reported center frequency and sample rate are those of the displayed sub-band
+    if (m_settings.m_zoomLog2Decim > 0)
+    {
+        // the requested offset is kept in the settings and only the applied one is clamped
+        // as the device sample rate may not be known yet or may change later
+        qint64 zoomMaxOffset = GLSpectrumSettings::getZoomMaxFrequencyOffset(m_deviceSampleRate, m_settings.m_zoomLog2Decim);
+        qint64 zoomFrequencyOffset = qBound(-zoomMaxOffset, m_settings.m_zoomFrequencyOffset, zoomMaxOffset);
+        m_centerFrequency = m_deviceCenterFrequency + zoomFrequencyOffset;
+        m_sampleRate = m_deviceSampleRate >> m_settings.m_zoomLog2Decim;
+        m_zoomNCO.setFreq(-zoomFrequencyOffset, m_deviceSampleRate);
+    }
+    else
+    {
+        m_centerFrequency = m_deviceCenterFrequency;
+        m_sampleRate = m_deviceSampleRate;
+    }
 }
 
 void SpectrumVis::handleScalef(Real scalef)
@@ -24,9 +24,11 @@
 #include <QMutex>
 
 #include "dsp/basebandsamplesink.h"
+#include "dsp/decimatorsff.h"
 #include "dsp/fftengine.h"
 #include "dsp/fftwindow.h"
 #include "dsp/glspectrumsettings.h"
+#include "dsp/ncof.h"
 #include "export.h"
 #include "util/message.h"
 #include "util/movingaverage2d.h"
@@ -35,6 +37,7 @@
 #include "websockets/wsspectrum.h"
 
 class GLSpectrumInterface;
+class SpectrumFrameSink;
 class MessageQueue;
 
 class SDRBASE_API SpectrumVis : public BasebandSampleSink {
@@ -87,13 +90,16 @@ public:
         AvgModeNone,
         AvgModeMovingAvg,
         AvgModeFixedAvg,
-        AvgModeMax
+        AvgModeMax,
+        AvgModeWelch
     };
 
 	SpectrumVis(Real scalef);
 	virtual ~SpectrumVis();
 
     void setGLSpectrum(GLSpectrumInterface* glSpectrum) { m_glSpectrum = glSpectrum; }
+    void addFrameSink(SpectrumFrameSink *frameSink);    //!< Add a consumer of the power spectrum frames
+    void removeFrameSink(SpectrumFrameSink *frameSink); //!< Remove a consumer of the power spectrum frames
     void openWSSpectrum();
     void closeWSSpectrum();
 
@@ -186,12 +192,28 @@ private:
 	Real m_scalef;
 	GLSpectrumInterface* m_glSpectrum;
     WSSpectrum m_wsSpectrum;
+    std::vector<SpectrumFrameSink*> m_frameSinks;
 	MovingAverage2D<double> m_movingAverage;
 	FixedAverage2D<double> m_fixedAverage;
 	Max2D<double> m_max;
 
-    uint64_t m_centerFrequency;
-    int m_sampleRate;
+    std::vector<Complex> m_welchBuffer; //!< overlapped segments input batch
+    std::size_t m_welchBufferFill;
+    std::vector<double> m_welchSum;     //!< accumulated power per bin
+    unsigned int m_welchCount;          //!< number of segments accumulated so far
+    unsigned int m_welchNb;             //!< number of segments per output frame
+    Real m_windowPower;                 //!< window mean power for noise power correction
+
+    NCOF m_zoomNCO;                     //!< shifts zoomed sub-band to baseband
+    DecimatorsFF<true> m_zoomDecimators;
+    std::vector<float> m_zoomBuffer;    //!< shifted samples as interleaved I/Q
+    std::size_t m_zoomBufferFill;       //!< number of complex samples in zoom buffer
+    FSampleVector m_zoomDecimated;
+
+    uint64_t m_centerFrequency;         //!< displayed center frequency
+    int m_sampleRate;                   //!< displayed sample rate
+    uint64_t m_deviceCenterFrequency;
+    int m_deviceSampleRate;
 
 	Real m_ofs;
 	Real m_powFFTDiv;
@@ -200,8 +222,16 @@ private:
 	QMutex m_mutex;
 
     void setRunning(bool running) { m_running = running; }
+    template<typename SampleIt>
+    void feedFrames(const SampleIt& begin, const SampleIt& end, bool positiveOnly);
+    template<typename SampleIt>
+    void feedWelch(const SampleIt& begin, const SampleIt& end, bool positiveOnly);
+    void feedZoom(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
     void applySettings(const GLSpectrumSettings& settings, bool force = false);
     void handleConfigureDSP(uint64_t centerFrequency, int sampleRate);
+    void applyZoom();
+    bool hasConsumers();
+    void sendSpectrum();
     void handleScalef(Real scalef);
     void handleWSOpenClose(bool openClose);
     void handleConfigureWSSpectrum(const QString& address, uint16_t port);
@@ -0,0 +1,464 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDebug>
+#include <QImage>
+
+#include "SWGSpectrumWaterfall.h"
+
+#include "dsp/spectrumpalette.h"
+#include "spectrumwaterfall.h"
+
+#define SPECTRUMWATERFALL_MAX_WIDTH 16384
+#define SPECTRUMWATERFALL_MAX_HEIGHT 8192
+
+SpectrumWaterfall::SpectrumWaterfall() :
+    m_pendingWrite(0),
+    m_pendingRead(0),
+    m_framesDropped(0),
+    m_running(false),
+    m_rowCount(0),
+    m_boundariesFFTSize(0)
+{
+    for (int i = 0; i < SpectrumPalette::m_waterfallPaletteSize; i++) {
+        m_colorTable.push_back(SpectrumPalette::getWaterfallColor(i).rgba());
+    }
+}
+
+SpectrumWaterfall::~SpectrumWaterfall()
+{
+    stopRendering();
+}
+
+void SpectrumWaterfall::startRendering()
+{
+    if (m_running) {
+        return;
+    }
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        resetRows();
+    }
+
+    m_pendingWrite = 0;
+    m_pendingRead = 0;
+    m_framesDropped = 0;
+    m_running = true;
+    start();
+}
+
+void SpectrumWaterfall::stopRendering()
+{
+    if (!m_running) {
+        return;
+    }
+
+    m_pendingMutex.lock();
+    m_running = false;
+    m_frameAvailable.wakeAll();
+    m_pendingMutex.unlock();
+    wait();
+
+    QMutexLocker mutexLocker(&m_mutex);
+    std::vector<quint8>().swap(m_rows); // release memory
+    std::vector<RowInfo>().swap(m_rowInfos);
+    m_rowCount = 0;
+}
+
+void SpectrumWaterfall::applySettings(const Settings& settings)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    bool reset = (settings.m_width != m_settings.m_width) || (settings.m_height != m_settings.m_height);
+    m_settings = settings;
+
+    if (reset && m_running) {
+        resetRows();
+    }
+}
+
+SpectrumWaterfall::Settings SpectrumWaterfall::getSettings() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_settings;
+}
+
+void SpectrumWaterfall::resetRows()
+{
+    m_rows.assign(m_settings.m_width * m_settings.m_height, 0);
+    m_rowInfos.assign(m_settings.m_height, RowInfo{0, 0, 0});
+    m_rowCount = 0;
+}
+
+void SpectrumWaterfall::newFrame(
+    const std::vector<Real>& spectrum,
+    int fftSize,
+    qint64 centerFrequency,
+    int sampleRate,
+    bool linear)
+{
+    if (!m_running || (fftSize <= 0)) {
+        return;
+    }
+
+    // only one frame copy is done in the DSP thread. If the rendering thread lags the frame is dropped.
+    m_pendingMutex.lock();
+
+    if (m_pendingWrite - m_pendingRead >= m_nbPendingFrames)
+    {
+        m_framesDropped++;
+        m_pendingMutex.unlock();
+        return;
+    }
+
+    PendingFrame& frame = m_pendingFrames[m_pendingWrite % m_nbPendingFrames];
+    m_pendingMutex.unlock();
+
+    if (frame.m_spectrum.size() < (unsigned int) fftSize) {
+        frame.m_spectrum.resize(fftSize);
+    }
+
+    if (linear)
+    {
+        // palette levels are in dB so a linear spectrum is converted as in SpectrumActivity
+        for (int i = 0; i < fftSize; i++) {
+            frame.m_spectrum[i] = 10.0f * log10f(spectrum[i] > 1e-20f ? spectrum[i] : 1e-20f);
+        }
+    }
+    else
+    {
+        std::copy(spectrum.begin(), spectrum.begin() + fftSize, frame.m_spectrum.begin());
+    }
+
+    frame.m_fftSize = fftSize;
+    frame.m_centerFrequency = centerFrequency;
+    frame.m_sampleRate = sampleRate;
+    frame.m_timestampMs = QDateTime::currentMSecsSinceEpoch();
+
+    m_pendingMutex.lock();
+    m_pendingWrite++;
+    m_frameAvailable.wakeOne();
+    m_pendingMutex.unlock();
+}
+
+void SpectrumWaterfall::run()
+{
+    qDebug("SpectrumWaterfall::run: start");
+    m_pendingMutex.lock();
+
+    while (m_running)
+    {
+        if (m_pendingRead == m_pendingWrite)
+        {
+            m_frameAvailable.wait(&m_pendingMutex);
+            continue;
+        }
+
+        const PendingFrame& frame = m_pendingFrames[m_pendingRead % m_nbPendingFrames];
+        m_pendingMutex.unlock();
+        renderFrame(frame);
+        m_pendingMutex.lock();
+        m_pendingRead++;
+    }
+
+    m_pendingMutex.unlock();
+    qDebug("SpectrumWaterfall::run: end");
+}
+
+void SpectrumWaterfall::renderFrame(const PendingFrame& frame)
+{
+    Settings settings = getSettings();
+    unsigned int width = settings.m_width;
+    unsigned int fftSize = frame.m_fftSize;
+
+    if ((m_binBoundaries.size() != width + 1) || (m_boundariesFFTSize != frame.m_fftSize))
+    {
+        m_binBoundaries.resize(width + 1);
+
+        for (unsigned int c = 0; c <= width; c++) {
+            m_binBoundaries[c] = (unsigned int) (((quint64) c * fftSize) / width);
+        }
+
+        m_boundariesFFTSize = frame.m_fftSize;
+        m_columns.resize(width);
+        m_indexes.resize(width);
+    }
+
+    // each column gets the maximum of the bins it covers (nearest bin when the FFT is narrower)
+    const Real *spectrum = frame.m_spectrum.data();
+
+    for (unsigned int c = 0; c < width; c++)
+    {
+        unsigned int bin = m_binBoundaries[c];
+        unsigned int end = std::min(std::max(m_binBoundaries[c+1], bin + 1), fftSize);
+        Real max = spectrum[bin];
+
+        for (bin++; bin < end; bin++) {
+            max = spectrum[bin] > max ? spectrum[bin] : max;
+        }
+
+        m_columns[c] = max;
+    }
+
+    mapToPalette(m_columns.data(), m_indexes.data(), width, settings.m_refLevel, settings.m_powerRange);
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((m_settings.m_width != width) || (m_rows.size() != (std::size_t) width * m_settings.m_height)) {
+        return; // geometry changed while rendering
+    }
+
+    unsigned int row = m_rowCount % m_settings.m_height;
+    std::copy(m_indexes.begin(), m_indexes.end(), m_rows.begin() + (std::size_t) row * width);
+    m_rowInfos[row].m_timestampMs = frame.m_timestampMs;
+    m_rowInfos[row].m_centerFrequency = frame.m_centerFrequency;
+    m_rowInfos[row].m_sampleRate = frame.m_sampleRate;
+    m_rowCount++;
+}
+
+void SpectrumWaterfall::mapToPalette(
+    const Real *power,
+    quint8 *indexes,
+    unsigned int size,
+    float referenceLevel,
+    float powerRange)
+{
+    // index = (power - referenceLevel) * 240 / powerRange + 240 = power * k + o
+    float k = 2.4f * 100.0f / powerRange;
+    float o = 240.0f - referenceLevel * k;
+    unsigned int i = 0;
+
+#if defined(USE_SSE2)
+    if (sizeof(Real) == sizeof(float))
+    {
+        const float *p = (const float *) power;
+        const __m128 vk = _mm_set1_ps(k);
+        const __m128 vo = _mm_set1_ps(o);
+        const __m128 vmin = _mm_setzero_ps();
+        const __m128 vmax = _mm_set1_ps(239.0f);
+
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i i0 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p + i), vk), vo), vmin), vmax));
+            __m128i i1 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p + i + 4), vk), vo), vmin), vmax));
+            __m128i i2 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p + i + 8), vk), vo), vmin), vmax));
+            __m128i i3 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(p + i + 12), vk), vo), vmin), vmax));
+            _mm_storeu_si128((__m128i*) (indexes + i), _mm_packus_epi16(_mm_packs_epi32(i0, i1), _mm_packs_epi32(i2, i3)));
+        }
+    }
+#endif
+
+    for (; i < size; i++)
+    {
+        float v = power[i] * k + o;
+        indexes[i] = v < 0.0f ? 0 : v > 239.0f ? 239 : (quint8) v;
+    }
+}
+
+int SpectrumWaterfall::getTile(const TileQuery& query, Tile& tile, QString& errorMessage) const
+{
+    QImage image;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+
+        if (!m_running)
+        {
+            errorMessage = QString("Spectrum waterfall is not enabled");
+            return 404;
+        }
+
+        unsigned int width = m_settings.m_width;
+        unsigned int height = m_settings.m_height;
+        unsigned int available = m_rowCount < height ? (unsigned int) m_rowCount : height;
+
+        if (available == 0)
+        {
+            errorMessage = QString("No spectrum frame rendered yet");
+            return 404;
+        }
+
+        unsigned int columns = query.m_columns == 0 ? width - std::min(query.m_startColumn, width) : query.m_columns;
+
+        if ((query.m_startColumn >= width) || (columns == 0) || (query.m_startColumn + columns > width))
+        {
+            errorMessage = QString("Columns %1 to %2 are outside of the %3 rendered columns")
+                .arg(query.m_startColumn).arg(query.m_startColumn + columns).arg(width);
+            return 400;
+        }
+
+        if (query.m_rowOffset >= available)
+        {
+            errorMessage = QString("Row offset %1 is beyond the %2 rendered rows").arg(query.m_rowOffset).arg(available);
+            return 400;
+        }
+
+        unsigned int rows = available - query.m_rowOffset;
+        rows = (query.m_rows == 0) || (query.m_rows > rows) ? rows : query.m_rows;
+        unsigned int outWidth = query.m_width == 0 ? columns : query.m_width;
+
+        if (outWidth > columns)
+        {
+            errorMessage = QString("Tile width %1 is larger than the %2 columns covered").arg(outWidth).arg(columns);
+            return 400;
+        }
+
+        image = QImage(outWidth, rows, QImage::Format_Indexed8);
+        image.setColorTable(m_colorTable);
+        std::vector<unsigned int> boundaries(outWidth + 1);
+
+        for (unsigned int j = 0; j <= outWidth; j++) {
+            boundaries[j] = query.m_startColumn + (unsigned int) (((quint64) j * columns) / outWidth);
+        }
+
+        // newest row on top. Indexes grow with power so the maximum index is the maximum power.
+        for (unsigned int r = 0; r < rows; r++)
+        {
+            unsigned int row = (m_rowCount - 1 - query.m_rowOffset - r) % height;
+            const quint8 *src = m_rows.data() + (std::size_t) row * width;
+            uchar *dst = image.scanLine(r);
+
+            if (outWidth == columns)
+            {
+                std::memcpy(dst, src + query.m_startColumn, columns);
+                continue;
+            }
+
+            for (unsigned int j = 0; j < outWidth; j++) {
+                dst[j] = *std::max_element(src + boundaries[j], src + boundaries[j+1]);
+            }
+        }
+
+        const RowInfo& newest = m_rowInfos[(m_rowCount - 1 - query.m_rowOffset) % height];
+        const RowInfo& oldest = m_rowInfos[(m_rowCount - query.m_rowOffset - rows) % height];
+        qint64 startFrequency = newest.m_centerFrequency - newest.m_sampleRate / 2;
+        tile.m_startFrequency = startFrequency + ((qint64) newest.m_sampleRate * query.m_startColumn) / width;
+        tile.m_stopFrequency = startFrequency + ((qint64) newest.m_sampleRate * (query.m_startColumn + columns)) / width;
+        tile.m_toMs = newest.m_timestampMs;
+        tile.m_fromMs = oldest.m_timestampMs;
+        tile.m_width = outWidth;
+        tile.m_height = rows;
+    }
+
+    // encoding is done without holding the lock
+    if (query.m_format == TileFormatPNG)
+    {
+        tile.m_data.clear();
+        QBuffer buffer(&tile.m_data);
+        buffer.open(QIODevice::WriteOnly);
+
+        if (!image.save(&buffer, "PNG"))
+        {
+            errorMessage = QString("Cannot encode PNG tile");
+            return 500;
+        }
+    }
+    else
+    {
+        tile.m_data.resize(tile.m_width * tile.m_height * 4);
+        quint8 *dst = (quint8 *) tile.m_data.data();
+
+        for (unsigned int r = 0; r < tile.m_height; r++)
+        {
+            const uchar *src = image.constScanLine(r);
+
+            for (unsigned int j = 0; j < tile.m_width; j++, dst += 4)
+            {
+                QRgb rgb = m_colorTable[src[j]];
+                dst[0] = qRed(rgb);
+                dst[1] = qGreen(rgb);
+                dst[2] = qBlue(rgb);
+                dst[3] = qAlpha(rgb);
+            }
+        }
+    }
+
+    return 200;
+}
+
+int SpectrumWaterfall::webapiSettingsGet(
+        SWGSDRangel::SWGSpectrumWaterfall& response,
+        QString& errorMessage) const
+{
+    (void) errorMessage;
+    m_pendingMutex.lock();
+    response.setFramesDropped(m_framesDropped);
+    m_pendingMutex.unlock();
+
+    QMutexLocker mutexLocker(&m_mutex);
+    response.setEnable(m_running ? 1 : 0);
+    response.setWidth(m_settings.m_width);
+    response.setHeight(m_settings.m_height);
+    response.setRefLevel(m_settings.m_refLevel);
+    response.setPowerRange(m_settings.m_powerRange);
+
+    if (m_running && (m_rowCount > 0))
+    {
+        const RowInfo& newest = m_rowInfos[(m_rowCount - 1) % m_settings.m_height];
+        response.setRows(m_rowCount < m_settings.m_height ? m_rowCount : m_settings.m_height);
+        response.setCenterFrequency(newest.m_centerFrequency);
+        response.setSampleRate(newest.m_sampleRate);
+        response.setNewestTimestampMs(newest.m_timestampMs);
+    }
+    else
+    {
+        response.setRows(0);
+        response.setCenterFrequency(0);
+        response.setSampleRate(0);
+        response.setNewestTimestampMs(0);
+    }
+
+    return 200;
+}
+
+int SpectrumWaterfall::webapiSettingsPut(
+        SWGSDRangel::SWGSpectrumWaterfall& response,
+        QString& errorMessage)
+{
+    Settings settings;
+    settings.m_width = response.getWidth() > 0 ? response.getWidth() : settings.m_width;
+    settings.m_height = response.getHeight() > 0 ? response.getHeight() : settings.m_height;
+    settings.m_refLevel = response.getRefLevel();
+    settings.m_powerRange = response.getPowerRange() > 0.0f ? response.getPowerRange() : settings.m_powerRange;
+
+    if ((settings.m_width > SPECTRUMWATERFALL_MAX_WIDTH) || (settings.m_height > SPECTRUMWATERFALL_MAX_HEIGHT))
+    {
+        errorMessage = QString("Waterfall size is limited to %1 x %2")
+            .arg(SPECTRUMWATERFALL_MAX_WIDTH).arg(SPECTRUMWATERFALL_MAX_HEIGHT);
+        return 400;
+    }
+
+    applySettings(settings);
+
+    if (response.getEnable() != 0) {
+        startRendering();
+    } else {
+        stopRendering();
+    }
+
+    return webapiSettingsGet(response, errorMessage);
+}
@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Headless spectrogram (waterfall) renderer                                     //
+//                                                                               //
+// Spectrum frames are handed over to a rendering thread that maps them to       //
+// GLSpectrum waterfall palette indexes in a ring of rows. Tiles are cropped     //
+// and decimated from the ring on request and served as PNG or raw RGBA images.  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMWATERFALL_H_
+#define SDRBASE_DSP_SPECTRUMWATERFALL_H_
+
+#include <atomic>
+#include <vector>
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <QRgb>
+
+#include "dsp/spectrumframesink.h"
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGSpectrumWaterfall;
+}
+
+class SDRBASE_API SpectrumWaterfall : public QThread, public SpectrumFrameSink
+{
+    Q_OBJECT
+public:
+    enum TileFormat
+    {
+        TileFormatPNG, //!< 8 bit indexed PNG with the waterfall palette
+        TileFormatRaw  //!< RGBA 8 bits per component, rows top (newest) to bottom
+    };
+
+    struct Settings
+    {
+        unsigned int m_width;  //!< number of columns spanning the spectrum
+        unsigned int m_height; //!< number of rows kept (one per spectrum frame)
+        float m_refLevel;      //!< power at the top of the palette (dB)
+        float m_powerRange;    //!< power range spanned by the palette (dB)
+
+        Settings() :
+            m_width(1024),
+            m_height(512),
+            m_refLevel(0.0f),
+            m_powerRange(100.0f)
+        {}
+    };
+
+    struct TileQuery
+    {
+        unsigned int m_startColumn; //!< first column of the tile
+        unsigned int m_columns;     //!< number of columns covered by the tile (0: up to the last column)
+        unsigned int m_rowOffset;   //!< number of newest rows skipped
+        unsigned int m_rows;        //!< number of rows in the tile (0: all available rows)
+        unsigned int m_width;       //!< output width in pixels, columns are decimated by max (0: one pixel per column)
+        TileFormat m_format;
+
+        TileQuery() :
+            m_startColumn(0),
+            m_columns(0),
+            m_rowOffset(0),
+            m_rows(0),
+            m_width(0),
+            m_format(TileFormatPNG)
+        {}
+    };
+
+    struct Tile
+    {
+        QByteArray m_data;
+        unsigned int m_width;
+        unsigned int m_height;
+        qint64 m_startFrequency; //!< frequency at the left of the tile for the newest row in Hz
+        qint64 m_stopFrequency;  //!< frequency at the right of the tile for the newest row in Hz
+        qint64 m_fromMs;         //!< timestamp of the bottom (oldest) row in ms since epoch
+        qint64 m_toMs;           //!< timestamp of the top (newest) row in ms since epoch
+    };
+
+    SpectrumWaterfall();
+    virtual ~SpectrumWaterfall();
+
+    void startRendering();
+    void stopRendering();
+    bool isRendering() const { return m_running.load(); }
+    void applySettings(const Settings& settings);
+    Settings getSettings() const;
+
+    virtual void newFrame(
+        const std::vector<Real>& spectrum,
+        int fftSize,
+        qint64 centerFrequency,
+        int sampleRate,
+        bool linear
+    );
+
+    virtual bool isActive() const { return m_running.load(); }
+
+    /**
+     * Crop and encode a tile from the rendered rows. Runs in the caller's thread and holds the
+     * rows lock only while copying palette indexes. Returns Http status code.
+     */
+    int getTile(const TileQuery& query, Tile& tile, QString& errorMessage) const;
+
+    int webapiSettingsGet(
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            QString& errorMessage) const;
+
+    int webapiSettingsPut(
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            QString& errorMessage);
+
+    /** Map power values to palette indexes (SIMD when available) */
+    static void mapToPalette(
+        const Real *power,
+        quint8 *indexes,
+        unsigned int size,
+        float referenceLevel,
+        float powerRange
+    );
+
+private:
+    static const unsigned int m_nbPendingFrames = 4;
+
+    struct PendingFrame
+    {
+        std::vector<Real> m_spectrum;
+        int m_fftSize;
+        qint64 m_centerFrequency;
+        int m_sampleRate;
+        qint64 m_timestampMs;
+    };
+
+    struct RowInfo
+    {
+        qint64 m_timestampMs;
+        qint64 m_centerFrequency;
+        int m_sampleRate;
+    };
+
+    // frame hand over from the DSP thread (single producer, single consumer)
+    mutable QMutex m_pendingMutex;
+    QWaitCondition m_frameAvailable;
+    PendingFrame m_pendingFrames[m_nbPendingFrames];
+    quint64 m_pendingWrite;
+    quint64 m_pendingRead;
+    quint64 m_framesDropped;
+    std::atomic<bool> m_running;
+
+    // rendered rows
+    mutable QMutex m_mutex;
+    Settings m_settings;
+    std::vector<quint8> m_rows;      //!< palette indexes: m_settings.m_height rows of m_settings.m_width columns
+    std::vector<RowInfo> m_rowInfos;
+    quint64 m_rowCount;              //!< rows rendered since last reset
+    QVector<QRgb> m_colorTable;
+
+    // rendering thread working buffers
+    std::vector<Real> m_columns;
+    std::vector<quint8> m_indexes;
+    std::vector<unsigned int> m_binBoundaries;
+    int m_boundariesFFTSize;
+
+    virtual void run();
+    void renderFrame(const PendingFrame& frame);
+    void resetRows();
+};
+
+#endif // SDRBASE_DSP_SPECTRUMWATERFALL_H_
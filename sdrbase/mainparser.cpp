@@ -34,7 +34,17 @@ MainParser::MainParser() :
     m_fftwfWisdomOption(QStringList() << "w" << "fftwf-wisdom",
         "FFTW Wisdom file.",
         "file",
-        "")
+        ""),
+    m_batchPresetOption(QStringList() << "batch-preset",
+        "Batch mode (server only): process the input file with this preset as \"group/description\" or \"description\". Repeat for several presets.",
+        "preset"),
+    m_batchInputOption(QStringList() << "batch-input",
+        "Batch mode: I/Q recording to process.",
+        "file"),
+    m_batchOutputOption(QStringList() << "batch-output",
+        "Batch mode: directory of the audio WAV files.",
+        "directory",
+        ".")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
@@ -48,6 +58,9 @@ MainParser::MainParser() :
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
     m_parser.addOption(m_fftwfWisdomOption);
+    m_parser.addOption(m_batchPresetOption);
+    m_parser.addOption(m_batchInputOption);
+    m_parser.addOption(m_batchOutputOption);
 }
 
 MainParser::~MainParser()
@@ -92,6 +105,18 @@ void MainParser::parse(const QCoreApplication& app)
 
     m_fftwfWindowFileName = m_parser.value(m_fftwfWisdomOption);
 
+    // batch mode
+
+    m_batchPresets = m_parser.values(m_batchPresetOption);
+    m_batchInput = m_parser.value(m_batchInputOption);
+    m_batchOutput = m_parser.value(m_batchOutputOption);
+
+    if ((m_batchPresets.size() > 0) && m_batchInput.isEmpty())
+    {
+        qWarning() << "MainParser::parse: batch mode needs an input file. Batch mode disabled";
+        m_batchPresets.clear();
+    }
+
     // MIMO - from version
 
     QStringList versionParts = app.applicationVersion().split(".");
@@ -36,17 +36,27 @@ public:
     uint16_t getServerPort() const { return m_serverPort; }
     bool getMIMOSupport() const { return m_mimoSupport; }
     const QString& getFFTWFWisdomFileName() const { return m_fftwfWindowFileName; }
+    bool isBatch() const { return m_batchPresets.size() > 0; }
+    const QStringList& getBatchPresets() const { return m_batchPresets; }
+    const QString& getBatchInput() const { return m_batchInput; }
+    const QString& getBatchOutput() const { return m_batchOutput; }
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
     QString  m_fftwfWindowFileName;
     bool m_mimoSupport; //!< obtained from major version
+    QStringList m_batchPresets; //!< one device set per preset in batch mode
+    QString m_batchInput;
+    QString m_batchOutput;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
     QCommandLineOption m_fftwfWisdomOption;
+    QCommandLineOption m_batchPresetOption;
+    QCommandLineOption m_batchInputOption;
+    QCommandLineOption m_batchOutputOption;
 };
 
 
@@ -90,6 +90,14 @@ public:
 		}
 	}
 
+	void release() //!< Frees the memory. Needs a resize before use
+	{
+	    m_size = 0;
+	    std::vector<T>().swap(m_data);
+	    m_current = m_data.begin();
+	}
+
+	int size() const { return m_size; }
 	typename std::vector<T>::iterator getCurrent() const { return m_current + m_size; }
 	typename std::vector<T>::const_iterator begin() const { return m_data.begin(); }
     typename std::vector<T>::iterator begin() { return m_data.begin(); }
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <QDebug>
+
+#include "mappedfilereader.h"
+
+MappedFileReader::MappedFileReader() :
+    m_data(nullptr),
+    m_size(0),
+    m_position(0),
+    m_readAhead(32*1024*1024),
+    m_advisedEnd(0)
+{}
+
+MappedFileReader::~MappedFileReader()
+{
+    close();
+}
+
+bool MappedFileReader::open(const QString& fileName)
+{
+    close();
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qWarning("MappedFileReader::open: cannot open %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        return false;
+    }
+
+    m_size = m_file.size();
+
+    if ((m_size == 0) || ((quint64) (size_t) m_size != m_size)) // zero size cannot be mapped
+    {
+        m_file.close();
+        m_size = 0;
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+
+    if (!m_data)
+    {
+        qWarning("MappedFileReader::open: cannot map %s: %s", qPrintable(fileName), qPrintable(m_file.errorString()));
+        m_file.close();
+        m_size = 0;
+        return false;
+    }
+
+#if defined(__linux__)
+    madvise(m_data, m_size, MADV_SEQUENTIAL); // aggressive read-ahead and early release of pages read
+#endif
+    seek(0);
+    return true;
+}
+
+void MappedFileReader::close()
+{
+    if (m_data)
+    {
+        m_file.unmap(m_data);
+        m_data = nullptr;
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+
+    m_size = 0;
+    m_position = 0;
+    m_advisedEnd = 0;
+}
+
+void MappedFileReader::seek(quint64 offset)
+{
+    m_position = std::min(offset, m_size);
+    m_advisedEnd = m_position; // next read advises the window from the new position
+}
+
+const char *MappedFileReader::next(qint64 size, qint64& nbBytes)
+{
+    const char *p = (const char *) m_data + m_position;
+    nbBytes = std::min((quint64) std::max(size, (qint64) 0), m_size - m_position);
+    m_position += nbBytes;
+
+    // advise the next window when half of the current one has been read
+    if (m_position + m_readAhead / 2 > m_advisedEnd) {
+        adviseReadAhead();
+    }
+
+    return p;
+}
+
+qint64 MappedFileReader::read(char *data, qint64 size)
+{
+    qint64 nbBytes;
+    const char *p = next(size, nbBytes);
+    std::memcpy(data, p, nbBytes);
+    return nbBytes;
+}
+
+void MappedFileReader::adviseReadAhead()
+{
+    if (m_advisedEnd >= m_size) {
+        return;
+    }
+
+    quint64 start = std::max(m_advisedEnd, m_position);
+    quint64 end = std::min(start + m_readAhead, m_size);
+#if defined(__linux__)
+    static const quint64 pageSize = sysconf(_SC_PAGESIZE);
+    quint64 alignedStart = start - (start % pageSize); // madvise needs a page aligned address
+    madvise(m_data + alignedStart, end - alignedStart, MADV_WILLNEED);
+#endif
+    m_advisedEnd = end;
+}
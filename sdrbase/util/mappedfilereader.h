@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Sequential reader of a memory mapped file                                     //
+//                                                                               //
+// Data is handed over by pointer into the mapping so it can be copied or        //
+// converted straight into its destination. The kernel is advised of sequential //
+// access and of the next window to read ahead (Linux only).                     //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_MAPPEDFILEREADER_H_
+#define SDRBASE_UTIL_MAPPEDFILEREADER_H_
+
+#include <QFile>
+#include <QString>
+
+#include "export.h"
+
+class SDRBASE_API MappedFileReader
+{
+public:
+    MappedFileReader();
+    ~MappedFileReader();
+
+    /** Maps the whole file read only. Returns false if the file cannot be opened or mapped (ex: too large for a 32 bit address space) */
+    bool open(const QString& fileName);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    quint64 size() const { return m_size; }
+
+    void setReadAhead(quint64 readAheadBytes) { m_readAhead = readAheadBytes; } //!< size of the window advised ahead of the read position
+    void seek(quint64 offset);
+    quint64 getPosition() const { return m_position; }
+    bool isEOF() const { return m_position >= m_size; }
+
+    /** Returns a pointer to at most size bytes at the read position and moves past them. nbBytes is the actual number of bytes (less than size at end of file) */
+    const char *next(qint64 size, qint64& nbBytes);
+    /** Copies at most size bytes. Returns the number of bytes copied */
+    qint64 read(char *data, qint64 size);
+    const char *data() const { return (const char *) m_data; } //!< start of file
+
+private:
+    QFile m_file;
+    uchar *m_data;
+    quint64 m_size;
+    quint64 m_position;
+    quint64 m_readAhead;
+    quint64 m_advisedEnd; //!< end of the window last advised
+
+    void adviseReadAhead();
+};
+
+#endif // SDRBASE_UTIL_MAPPEDFILEREADER_H_
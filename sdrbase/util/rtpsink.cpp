@@ -286,37 +286,29 @@ void RTPSink::write(const uint8_t *samples, int nbSamples)
     int samplesIndex = 0;
     QMutexLocker locker(&m_mutex);
 
-    // fill remainder of buffer and send it
-    if (m_sampleBufferIndex + nbSamples > m_packetSamples)
+    while (nbSamples > 0)
     {
+        if (m_sampleBufferIndex == m_packetSamples) // buffer is sent when the next sample comes in like single samples
+        {
+            int status = m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
+
+            if (status < 0) {
+                qCritical("RTPSink::write: cannot write packet: %s", qrtplib::RTPGetErrorString(status).c_str());
+            }
+
+            m_sampleBufferIndex = 0;
+        }
+
+        int nbBufferSamples = std::min(nbSamples, m_packetSamples - m_sampleBufferIndex);
         writeNetBuf(&m_byteBuffer[m_sampleBufferIndex*m_sampleBytes],
                 &samples[samplesIndex*m_sampleBytes],
                 elemLength(m_payloadType),
-                (m_packetSamples - m_sampleBufferIndex)*m_sampleBytes,
+                nbBufferSamples*m_sampleBytes,
                 m_endianReverse);
-        m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
-        nbSamples -= (m_packetSamples - m_sampleBufferIndex);
-        m_sampleBufferIndex = 0;
+        m_sampleBufferIndex += nbBufferSamples;
+        samplesIndex += nbBufferSamples;
+        nbSamples -= nbBufferSamples;
     }
-
-    // send complete packets
-    while (nbSamples > m_packetSamples)
-    {
-        writeNetBuf(m_byteBuffer,
-                samples,
-                elemLength(m_payloadType),
-                m_bufferSize,
-                m_endianReverse);
-        m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
-        samplesIndex += m_packetSamples;
-        nbSamples -= m_packetSamples;
-    }
-
-    // copy remainder of input to buffer
-    writeNetBuf(&m_byteBuffer[m_sampleBufferIndex*m_sampleBytes],
-            &samples[samplesIndex*m_sampleBytes],
-            elemLength(m_payloadType),
-            nbSamples*m_sampleBytes,m_endianReverse);
 }
 
 void RTPSink::writeNetBuf(uint8_t *dest, const uint8_t *src, unsigned int elemLen, unsigned int bytesLen, bool endianReverse)
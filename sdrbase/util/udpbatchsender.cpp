@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // Linux 4.18+
+#endif
+#endif
+
+#include <QUdpSocket>
+
+#include "udpbatchsender.h"
+
+UDPBatchSender::UDPBatchSender(const QString& owner) :
+    m_owner(owner),
+    m_fd(-1)
+{
+#if defined(__linux__)
+    m_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (m_fd < 0) {
+        qWarning("%s: cannot create socket: %s", qPrintable(m_owner), strerror(errno));
+    }
+#endif
+}
+
+UDPBatchSender::~UDPBatchSender()
+{
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+}
+
+bool UDPBatchSender::canSend(const QHostAddress& address) const
+{
+    bool ipv4;
+    address.toIPv4Address(&ipv4);
+    return isOpen() && ipv4;
+}
+
+bool UDPBatchSender::probeGSO(unsigned int segmentSize)
+{
+#if defined(__linux__)
+    if (m_fd < 0) {
+        return false;
+    }
+
+    // the segment size is given with each message. Setting it on the socket only probes the kernel support
+    int size = segmentSize;
+
+    if (setsockopt(m_fd, SOL_UDP, UDP_SEGMENT, &size, sizeof(size)) != 0) {
+        return false;
+    }
+
+    size = 0;
+    setsockopt(m_fd, SOL_UDP, UDP_SEGMENT, &size, sizeof(size));
+    return true;
+#else
+    (void) segmentSize;
+    return false;
+#endif
+}
+
+void UDPBatchSender::setMulticastTTL(int ttl)
+{
+#if defined(__linux__)
+    if ((m_fd >= 0) && (setsockopt(m_fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)) {
+        qWarning("%s: setMulticastTTL: %s", qPrintable(m_owner), strerror(errno));
+    }
+#else
+    (void) ttl;
+#endif
+}
+
+void UDPBatchSender::setMulticastTTL(QUdpSocket *socket, int ttl)
+{
+    if (socket->state() != QAbstractSocket::BoundState) { // options apply to an open socket only
+        socket->bind(QHostAddress(QHostAddress::AnyIPv4), 0);
+    }
+
+    socket->setSocketOption(QAbstractSocket::MulticastTtlOption, ttl);
+}
+
+int UDPBatchSender::send(
+    const Message *messages,
+    int nbMessages,
+    const QHostAddress& address,
+    quint16 port,
+    unsigned int segmentSize,
+    int *nbSyscalls)
+{
+#if defined(__linux__)
+    struct sockaddr_in sockAddress;
+    memset(&sockAddress, 0, sizeof(sockAddress));
+    sockAddress.sin_family = AF_INET;
+    sockAddress.sin_port = htons(port);
+    sockAddress.sin_addr.s_addr = htonl(address.toIPv4Address());
+    struct mmsghdr headers[m_maxMessages];
+    struct iovec iovecs[m_maxMessages];
+    char controls[m_maxMessages][CMSG_SPACE(sizeof(uint16_t))];
+    int nbSent = 0;
+
+    while (nbSent < nbMessages)
+    {
+        int nbBatch = std::min(nbMessages - nbSent, m_maxMessages);
+        memset(headers, 0, nbBatch*sizeof(struct mmsghdr));
+
+        for (int i = 0; i < nbBatch; i++)
+        {
+            const Message& message = messages[nbSent + i];
+            struct msghdr& header = headers[i].msg_hdr;
+            iovecs[i].iov_base = (void *) message.m_data;
+            iovecs[i].iov_len = message.m_size;
+            header.msg_name = &sockAddress;
+            header.msg_namelen = sizeof(sockAddress);
+            header.msg_iov = &iovecs[i];
+            header.msg_iovlen = 1;
+
+            if ((segmentSize != 0) && (message.m_size > segmentSize))
+            {
+                header.msg_control = controls[i];
+                header.msg_controllen = sizeof(controls[i]);
+                struct cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                *((uint16_t *) CMSG_DATA(cmsg)) = segmentSize;
+            }
+        }
+
+        int batchSent = 0;
+
+        while (batchSent < nbBatch)
+        {
+            int res = sendmmsg(m_fd, &headers[batchSent], nbBatch - batchSent, 0);
+
+            if (nbSyscalls) {
+                (*nbSyscalls)++;
+            }
+
+            if (res > 0)
+            {
+                batchSent += res;
+                continue;
+            }
+
+            if ((res < 0) && (errno == EINTR)) {
+                continue;
+            }
+
+            if ((segmentSize != 0) && (nbSent + batchSent == 0) && (res < 0)
+                && ((errno == EIO) || (errno == EINVAL) || (errno == EOPNOTSUPP))) {
+                return -1; // offload not supported on the route
+            }
+
+            qDebug("%s: %d messages dropped: %s", qPrintable(m_owner), nbMessages - nbSent - batchSent, res < 0 ? strerror(errno) : "nothing sent");
+            return nbSent + batchSent;
+        }
+
+        nbSent += nbBatch;
+    }
+
+    return nbSent;
+#else
+    (void) messages;
+    (void) address;
+    (void) port;
+    (void) segmentSize;
+    (void) nbSyscalls;
+    qWarning("%s: batched transmission is not available. %d messages dropped", qPrintable(m_owner), nbMessages);
+    return 0;
+#endif
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_UDPBATCHSENDER_H_
+#define SDRBASE_UTIL_UDPBATCHSENDER_H_
+
+#include <QString>
+#include <QHostAddress>
+
+#include "export.h"
+
+class QUdpSocket;
+
+/**
+ * Native IPv4 UDP socket sending batches of datagrams with one sendmmsg system call (Linux).
+ * Interrupted system calls are retried and the datagrams that cannot be sent are dropped and
+ * logged. With UDP segmentation offload (GSO) a message made of consecutive datagrams of the
+ * segment size is split in datagrams by the kernel. On other systems the socket is not open
+ * and the datagrams are sent with a Qt socket by the caller. The socket can be used from any
+ * thread.
+ */
+class SDRBASE_API UDPBatchSender
+{
+public:
+    struct Message
+    {
+        const void *m_data;
+        unsigned int m_size; //!< Size of the datagram or with GSO of the consecutive datagrams
+    };
+
+    static const int m_maxMessages = 256; //!< Messages per system call
+
+    UDPBatchSender(const QString& owner); //!< owner is the prefix of the log messages
+    ~UDPBatchSender();
+
+    bool isOpen() const { return m_fd >= 0; }
+    /** The datagrams to this address can be sent with the native socket */
+    bool canSend(const QHostAddress& address) const;
+    /** The kernel supports UDP GSO. Does not tell if the route does */
+    bool probeGSO(unsigned int segmentSize);
+    /** Time to live of the datagrams sent to a multicast address */
+    void setMulticastTTL(int ttl);
+    /** Same for a Qt socket. To be called from the thread of the socket */
+    static void setMulticastTTL(QUdpSocket *socket, int ttl);
+
+    /**
+     * Send the messages to address:port. With a segmentSize different from 0 the messages longer
+     * than segmentSize are split by the kernel (GSO). Returns the number of messages sent or -1
+     * if GSO failed on the first system call (nothing was sent). In this case GSO is not supported
+     * on the route and the messages should be sent again without GSO. If nbSyscalls is given it is
+     * incremented by the number of system calls.
+     */
+    int send(
+        const Message *messages,
+        int nbMessages,
+        const QHostAddress& address,
+        quint16 port,
+        unsigned int segmentSize = 0,
+        int *nbSyscalls = nullptr
+    );
+
+private:
+    QString m_owner;
+    int m_fd; //!< -1 if not available
+};
+
+#endif // SDRBASE_UTIL_UDPBATCHSENDER_H_
@@ -25,50 +25,50 @@
 #include <QHostAddress>
 
 #include <cassert>
-
+#include <vector>
+#include <algorithm>
+
+#include "util/udpbatchsender.h"
+
+/**
+ * Samples are staged in a buffer of up to m_maxBatch datagrams. Complete datagrams are sent
+ * together when the staging buffer is full or flushed. In Linux IPv4 datagrams of a batch are
+ * sent with a single sendmmsg system call else with one Qt write per datagram. A datagram is
+ * filled either sample by sample with write(T) or in place with getStagingBuffer and commit
+ * but not both.
+ */
 template<typename T>
 class UDPSinkUtil
 {
 public:
+    static const int m_maxBatch = 64; //!< Maximum number of datagrams in the staging buffer
+
 	UDPSinkUtil(QObject *parent, unsigned int udpSize) :
-		m_udpSize(udpSize),
-		m_udpSamples(udpSize/sizeof(T)),
 		m_address(QHostAddress::LocalHost),
 		m_port(9999),
-		m_sampleBufferIndex(0)
+		m_batchSender("UDPSinkUtil")
 	{
-        assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+		init(parent, udpSize);
 	}
 
     UDPSinkUtil(QObject *parent, unsigned int udpSize, unsigned int port) :
-        m_udpSize(udpSize),
-        m_udpSamples(udpSize/sizeof(T)),
         m_address(QHostAddress::LocalHost),
         m_port(port),
-        m_sampleBufferIndex(0)
+        m_batchSender("UDPSinkUtil")
     {
-        assert(m_udpSamples > 0);
-        m_sampleBuffer = new T[m_udpSamples];
-        m_socket = new QUdpSocket(parent);
+        init(parent, udpSize);
     }
 
 	UDPSinkUtil (QObject *parent, unsigned int udpSize, QHostAddress& address, unsigned int port) :
-		m_udpSize(udpSize),
-        m_udpSamples(udpSize/sizeof(T)),
 		m_address(address),
 		m_port(port),
-		m_sampleBufferIndex(0)
+		m_batchSender("UDPSinkUtil")
 	{
-		assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+		init(parent, udpSize);
 	}
 
 	~UDPSinkUtil()
 	{
-		delete[] m_sampleBuffer;
 		delete m_socket;
 	}
 
@@ -86,58 +86,141 @@ public:
 	    m_port = port;
 	}
 
+    /**
+     * Set the datagram size in bytes. It is rounded down to a whole number of samples.
+     * Samples staged and not sent yet are dropped.
+     */
+    void setDatagramSize(unsigned int udpSize)
+    {
+        m_udpSamples = udpSize/sizeof(T);
+        assert(m_udpSamples > 0);
+        m_udpSize = m_udpSamples*sizeof(T);
+        m_sampleBuffer.resize(m_maxBatch*m_udpSamples);
+        m_sampleBufferIndex = 0;
+        m_filling = FillNone;
+    }
+
+    /** Time to live of the datagrams sent to a multicast address */
+    void setMulticastTTL(int ttl)
+    {
+        m_batchSender.setMulticastTTL(ttl);
+        UDPBatchSender::setMulticastTTL(m_socket, ttl);
+    }
+
 	/**
 	 * Write one sample
 	 */
 	void write(T sample)
 	{
-		if (m_sampleBufferIndex < m_udpSamples)
-		{
-			m_sampleBuffer[m_sampleBufferIndex] = sample;
-			m_sampleBufferIndex++;
-		}
-		else
-		{
-			m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port);
-			m_sampleBuffer[0] = sample;
-			m_sampleBufferIndex = 1;
+		if (m_sampleBufferIndex >= m_udpSamples) {
+		    flush();
 		}
+
+		assert(m_filling != FillCommit); // the datagram is being filled in place
+		m_sampleBuffer[m_sampleBufferIndex] = sample;
+		m_sampleBufferIndex++;
+		m_filling = m_sampleBufferIndex % m_udpSamples == 0 ? FillNone : FillWrite;
 	}
 
 	/**
-	 * Write a bunch of samples
+	 * Write a bunch of samples. The complete datagrams are sent before returning
 	 */
-	void write(T *samples, int nbSamples)
+	void write(const T *samples, int nbSamples)
 	{
-	    int samplesIndex = 0;
-
-	    if (m_sampleBufferIndex + nbSamples > m_udpSamples) // fill remainder of buffer and send it
-	    {
-	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], (m_udpSamples - m_sampleBufferIndex)*sizeof(T)); // fill remainder of buffer
-	        m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port); // send buffer
-            samplesIndex += (m_udpSamples - m_sampleBufferIndex);
-            nbSamples -= (m_udpSamples - m_sampleBufferIndex);
-	        m_sampleBufferIndex = 0;
-	    }
-
-	    while (nbSamples > m_udpSamples) // send directly from input without buffering
+	    while (nbSamples > 0)
 	    {
-	        m_socket->writeDatagram((const char*)&samples[samplesIndex], (qint64 ) m_udpSize, m_address, m_port);
-	        samplesIndex += m_udpSamples;
-	        nbSamples -= m_udpSamples;
+	        int room;
+	        T *staging = getStagingBuffer(nbSamples, room);
+	        std::copy(samples, samples + room, staging);
+	        commit(room);
+	        samples += room;
+	        nbSamples -= room;
 	    }
 
-	    memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], nbSamples*sizeof(T)); // copy remainder of input to buffer
+	    flush();
 	}
 
+    /**
+     * Room in the staging buffer to write up to nbSamples samples in place. Returns where
+     * to write and the number of samples that can be written (at least 1) in room.
+     */
+    T *getStagingBuffer(int nbSamples, int& room)
+    {
+        room = std::min(nbSamples, (int) m_sampleBuffer.size() - m_sampleBufferIndex);
+        return &m_sampleBuffer[m_sampleBufferIndex];
+    }
+
+    /** Validate nbSamples samples written in the staging buffer. It is sent if full */
+    void commit(int nbSamples)
+    {
+        assert((m_filling != FillWrite) || (nbSamples == 0)); // the datagram is being filled sample by sample
+        m_sampleBufferIndex += nbSamples;
+        m_filling = m_sampleBufferIndex % m_udpSamples == 0 ? FillNone : FillCommit;
+
+        if (m_sampleBufferIndex == (int) m_sampleBuffer.size())
+        {
+            sendDatagrams(m_sampleBuffer.data(), m_maxBatch);
+            m_sampleBufferIndex = 0;
+        }
+    }
+
+    /** Send the complete datagrams of the staging buffer. The incomplete one waits for more samples */
+    void flush()
+    {
+        int nbDatagrams = m_sampleBufferIndex / m_udpSamples;
+
+        if (nbDatagrams == 0) {
+            return;
+        }
+
+        sendDatagrams(m_sampleBuffer.data(), nbDatagrams);
+        int sent = nbDatagrams * m_udpSamples;
+        std::copy(m_sampleBuffer.begin() + sent, m_sampleBuffer.begin() + m_sampleBufferIndex, m_sampleBuffer.begin());
+        m_sampleBufferIndex -= sent;
+    }
+
 private:
+    enum Filling //!< How the incomplete datagram of the staging buffer is filled
+    {
+        FillNone,
+        FillWrite,
+        FillCommit
+    };
+
 	int m_udpSize;
     int m_udpSamples;
 	QHostAddress m_address;
 	unsigned int m_port;
 	QUdpSocket *m_socket;
-	T *m_sampleBuffer;;
+    UDPBatchSender m_batchSender;
+	std::vector<T> m_sampleBuffer; //!< Staging buffer of m_maxBatch datagrams
 	int m_sampleBufferIndex;
+    Filling m_filling;
+
+    void init(QObject *parent, unsigned int udpSize)
+    {
+        m_socket = new QUdpSocket(parent);
+        setDatagramSize(udpSize);
+    }
+
+    void sendDatagrams(const T *samples, int nbDatagrams)
+    {
+        if (m_batchSender.canSend(m_address))
+        {
+            UDPBatchSender::Message messages[m_maxBatch];
+
+            for (int i = 0; i < nbDatagrams; i++) {
+                messages[i] = UDPBatchSender::Message{&samples[i*m_udpSamples], (unsigned int) m_udpSize};
+            }
+
+            m_batchSender.send(messages, nbDatagrams, m_address, m_port);
+            return;
+        }
+
+        for (int i = 0; i < nbDatagrams; i++) {
+            m_socket->writeDatagram((const char*)&samples[i*m_udpSamples], (qint64 ) m_udpSize, m_address, m_port);
+        }
+    }
 };
 
 
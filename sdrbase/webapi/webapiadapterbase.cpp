@@ -130,6 +130,8 @@ void WebAPIAdapterBase::webapiFormatPreset(
         swgSpectrumConfig->setAveragingMode((int) m_spectrumSettings.m_averagingMode);
         swgSpectrumConfig->setAveragingValue(GLSpectrumSettings::getAveragingValue(m_spectrumSettings.m_averagingIndex, m_spectrumSettings.m_averagingMode));
         swgSpectrumConfig->setLinear(m_spectrumSettings.m_linear ? 1 : 0);
+        swgSpectrumConfig->setZoomFrequencyOffset(m_spectrumSettings.m_zoomFrequencyOffset);
+        swgSpectrumConfig->setZoomLog2Decim(m_spectrumSettings.m_zoomLog2Decim);
     }
 
     int nbChannels = preset.getChannelCount();
@@ -282,6 +284,15 @@ void WebAPIAdapterBase::webapiUpdatePreset(
         if (spectrumIt->contains("waterfallShare")) {
             spectrumSettings.m_waterfallShare = apiPreset->getSpectrumConfig()->getWaterfallShare();
         }
+        if (spectrumIt->contains("zoomFrequencyOffset")) {
+            spectrumSettings.m_zoomFrequencyOffset = apiPreset->getSpectrumConfig()->getZoomFrequencyOffset();
+        }
+        if (spectrumIt->contains("zoomLog2Decim")) {
+            spectrumSettings.m_zoomLog2Decim = qBound(0, apiPreset->getSpectrumConfig()->getZoomLog2Decim(), (int) GLSpectrumSettings::m_zoomMaxLog2Decim);
+        }
+        if (spectrumSettings.m_zoomLog2Decim == 0) { // offset is clamped against the device sample rate when the preset is applied
+            spectrumSettings.m_zoomFrequencyOffset = 0;
+        }
     }
 
     preset->setSpectrumConfig(spectrumSettings.serialize());
@@ -50,7 +50,13 @@ std::regex WebAPIAdapterInterface::devicesetDeviceRunURLRe("^/sdrangel/deviceset
 std::regex WebAPIAdapterInterface::devicesetDeviceSubsystemRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/subdevice/([0-9]{1,2})/run$");
 std::regex WebAPIAdapterInterface::devicesetDeviceReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/report$");
 std::regex WebAPIAdapterInterface::devicesetDeviceActionsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/actions$");
+std::regex WebAPIAdapterInterface::devicesetDeviceRecordURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/record$");
 std::regex WebAPIAdapterInterface::devicesetChannelsReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/report$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumActivityURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/activity$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumHistoryURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/history$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumHistoryDataURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/history/data$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumWaterfallURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/waterfall$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumWaterfallTileURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/waterfall/tile$");
 std::regex WebAPIAdapterInterface::devicesetChannelURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel$");
 std::regex WebAPIAdapterInterface::devicesetChannelIndexURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})$");
 std::regex WebAPIAdapterInterface::devicesetChannelSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/settings$");
@@ -26,6 +26,8 @@
 
 #include "SWGErrorResponse.h"
 
+#include "dsp/spectrumhistory.h"
+#include "dsp/spectrumwaterfall.h"
 #include "export.h"
 
 namespace SWGSDRangel
@@ -57,10 +59,14 @@ namespace SWGSDRangel
     class SWGDeviceState;
     class SWGDeviceReport;
     class SWGDeviceActions;
+    class SWGDeviceRecord;
     class SWGChannelsDetail;
     class SWGChannelSettings;
     class SWGChannelReport;
     class SWGChannelActions;
+    class SWGSpectrumActivity;
+    class SWGSpectrumHistory;
+    class SWGSpectrumWaterfall;
     class SWGSuccessResponse;
 }
 
@@ -878,6 +884,141 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/activity (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumActivityGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumActivity& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/activity (PUT)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumActivityPut(
+            int deviceSetIndex,
+            const QStringList& spectrumActivityKeys,
+            SWGSDRangel::SWGSpectrumActivity& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) spectrumActivityKeys;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/history (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumHistoryGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumHistory& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/history (PUT)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumHistoryPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumHistory& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/history/data (GET)
+     * streams the binary result to output only on success
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumHistoryDataGet(
+            int deviceSetIndex,
+            const SpectrumHistory::Query& query,
+            const SpectrumHistory::QueryOutput& output,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) query;
+        (void) output;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumWaterfallGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall (PUT)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumWaterfallPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum/waterfall/tile (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumWaterfallTileGet(
+            int deviceSetIndex,
+            const SpectrumWaterfall::TileQuery& query,
+            SpectrumWaterfall::Tile& tile,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) query;
+        (void) tile;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/actions (POST)
      * post action(s) on device
@@ -899,6 +1040,54 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/record (GET)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/record (PUT)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceRecordPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/deviceset/{deviceSetIndex}/device/record (POST)
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetDeviceRecordPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) deviceSetIndex;
+        (void) response;
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{deviceSetIndex}/channel (POST) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -1047,12 +1236,18 @@ public:
     static std::regex devicesetDeviceSubsystemRunURLRe;
     static std::regex devicesetDeviceReportURLRe;
     static std::regex devicesetDeviceActionsURLRe;
+    static std::regex devicesetDeviceRecordURLRe;
     static std::regex devicesetChannelURLRe;
     static std::regex devicesetChannelIndexURLRe;
     static std::regex devicesetChannelSettingsURLRe;
     static std::regex devicesetChannelReportURLRe;
     static std::regex devicesetChannelActionsURLRe;
     static std::regex devicesetChannelsReportURLRe;
+    static std::regex devicesetSpectrumActivityURLRe;
+    static std::regex devicesetSpectrumHistoryURLRe;
+    static std::regex devicesetSpectrumHistoryDataURLRe;
+    static std::regex devicesetSpectrumWaterfallURLRe;
+    static std::regex devicesetSpectrumWaterfallTileURLRe;
 };
 
 
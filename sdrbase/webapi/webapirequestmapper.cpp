@@ -45,10 +45,14 @@
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceActions.h"
+#include "SWGDeviceRecord.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGSpectrumActivity.h"
+#include "SWGSpectrumHistory.h"
+#include "SWGSpectrumWaterfall.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 
@@ -185,6 +189,7 @@ const QMap<QString, QString> WebAPIRequestMapper::m_sourceDeviceHwIdToActionsKey
     {"BladeRF1", "bladeRF1InputActions"},
     {"FCDPro", "fcdProActions"},
     {"FCDPro+", "fcdProPlusActions"},
+    {"FileInput", "fileInputActions"},
     {"HackRF", "hackRFInputActions"},
     {"KiwiSDR", "kiwiSDRActions"},
     {"LimeSDR", "limeSdrInputActions"},
@@ -337,8 +342,20 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 devicesetDeviceReportService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceActionsURLRe)) {
                 devicesetDeviceActionsService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRecordURLRe)) {
+                devicesetDeviceRecordService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
                 devicesetChannelsReportService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumActivityURLRe)) {
+                devicesetSpectrumActivityService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumHistoryURLRe)) {
+                devicesetSpectrumHistoryService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumHistoryDataURLRe)) {
+                devicesetSpectrumHistoryDataService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumWaterfallURLRe)) {
+                devicesetSpectrumWaterfallService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumWaterfallTileURLRe)) {
+                devicesetSpectrumWaterfallTileService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
                 devicesetChannelService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
@@ -2025,6 +2042,85 @@ void WebAPIRequestMapper::devicesetDeviceActionsService(const std::string& index
     }
 }
 
+void WebAPIRequestMapper::devicesetDeviceRecordService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            SWGSDRangel::SWGDeviceRecord normalResponse;
+            normalResponse.init();
+            int status = m_adapter->devicesetDeviceRecordGet(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            SWGSDRangel::SWGDeviceRecord normalResponse;
+            QString jsonStr = request.getBody();
+            QJsonObject jsonObject;
+
+            if (parseJsonBody(jsonStr, jsonObject, response))
+            {
+                normalResponse.init();
+                normalResponse.fromJson(jsonStr);
+                int status = m_adapter->devicesetDeviceRecordPut(deviceSetIndex, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON format");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON format";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "POST")
+        {
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            int status = m_adapter->devicesetDeviceRecordPost(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -2063,6 +2159,385 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
     }
 }
 
+void WebAPIRequestMapper::devicesetSpectrumActivityService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            SWGSDRangel::SWGSpectrumActivity normalResponse;
+            normalResponse.init();
+            int status = m_adapter->devicesetSpectrumActivityGet(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            SWGSDRangel::SWGSpectrumActivity normalResponse;
+            QString jsonStr = request.getBody();
+            QJsonObject jsonObject;
+
+            if (parseJsonBody(jsonStr, jsonObject, response))
+            {
+                QStringList spectrumActivityKeys = jsonObject.keys();
+                normalResponse.init();
+                normalResponse.fromJson(jsonStr);
+                int status = m_adapter->devicesetSpectrumActivityPut(deviceSetIndex, spectrumActivityKeys, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON format");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON format";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumHistoryService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            SWGSDRangel::SWGSpectrumHistory normalResponse;
+            normalResponse.init();
+            int status = m_adapter->devicesetSpectrumHistoryGet(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            SWGSDRangel::SWGSpectrumHistory normalResponse;
+            QString jsonStr = request.getBody();
+            QJsonObject jsonObject;
+
+            if (parseJsonBody(jsonStr, jsonObject, response))
+            {
+                normalResponse.init();
+                normalResponse.fromJson(jsonStr);
+                int status = m_adapter->devicesetSpectrumHistoryPut(deviceSetIndex, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON format");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON format";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumHistoryDataService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() != "GET")
+    {
+        response.setHeader("Content-Type", "application/json");
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    int deviceSetIndex;
+    SpectrumHistory::Query query;
+
+    try
+    {
+        deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QByteArray param;
+
+        if (!(param = request.getParameter("fromMs")).isEmpty()) {
+            query.m_fromMs = boost::lexical_cast<qint64>(param.toStdString());
+        }
+        if (!(param = request.getParameter("toMs")).isEmpty()) {
+            query.m_toMs = boost::lexical_cast<qint64>(param.toStdString());
+        }
+        if (!(param = request.getParameter("startFrequency")).isEmpty()) {
+            query.m_startFrequency = boost::lexical_cast<qint64>(param.toStdString());
+        }
+        if (!(param = request.getParameter("stopFrequency")).isEmpty()) {
+            query.m_stopFrequency = boost::lexical_cast<qint64>(param.toStdString());
+        }
+        if (!(param = request.getParameter("timeBins")).isEmpty()) {
+            query.m_timeBins = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+        if (!(param = request.getParameter("frequencyBins")).isEmpty()) {
+            query.m_frequencyBins = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        response.setHeader("Content-Type", "application/json");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or query parameter";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    QByteArray modeStr = request.getParameter("mode");
+
+    if (modeStr == "mean") {
+        query.m_mode = SpectrumHistory::DecimationMean;
+    } else if (modeStr.isEmpty() || (modeStr == "max")) {
+        query.m_mode = SpectrumHistory::DecimationMax;
+    }
+    else
+    {
+        response.setHeader("Content-Type", "application/json");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid decimation mode (max or mean)";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    // headers are sent with the first chunk so the result can still turn into an error until then
+    response.setHeader("Content-Type", "application/octet-stream");
+    int status = m_adapter->devicesetSpectrumHistoryDataGet(
+        deviceSetIndex,
+        query,
+        [&response](const QByteArray& chunk) { response.write(chunk); },
+        errorResponse
+    );
+
+    if (status/100 == 2)
+    {
+        response.write(QByteArray(), true);
+    }
+    else
+    {
+        response.setHeader("Content-Type", "application/json");
+        response.setStatus(status);
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumWaterfallService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    try
+    {
+        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+
+        if (request.getMethod() == "GET")
+        {
+            SWGSDRangel::SWGSpectrumWaterfall normalResponse;
+            normalResponse.init();
+            int status = m_adapter->devicesetSpectrumWaterfallGet(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else if (request.getMethod() == "PUT")
+        {
+            SWGSDRangel::SWGSpectrumWaterfall normalResponse;
+            QString jsonStr = request.getBody();
+            QJsonObject jsonObject;
+
+            if (parseJsonBody(jsonStr, jsonObject, response))
+            {
+                normalResponse.init();
+                normalResponse.fromJson(jsonStr);
+                int status = m_adapter->devicesetSpectrumWaterfallPut(deviceSetIndex, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    response.write(normalResponse.asJson().toUtf8());
+                } else {
+                    response.write(errorResponse.asJson().toUtf8());
+                }
+            }
+            else
+            {
+                response.setStatus(400,"Invalid JSON format");
+                errorResponse.init();
+                *errorResponse.getMessage() = "Invalid JSON format";
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(405,"Invalid HTTP method");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid HTTP method";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumWaterfallTileService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Access-Control-Allow-Origin", "*");
+    response.setHeader("Content-Type", "application/json");
+
+    if (request.getMethod() != "GET")
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    int deviceSetIndex;
+    SpectrumWaterfall::TileQuery query;
+
+    try
+    {
+        deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QByteArray param;
+
+        if (!(param = request.getParameter("startColumn")).isEmpty()) {
+            query.m_startColumn = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+        if (!(param = request.getParameter("columns")).isEmpty()) {
+            query.m_columns = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+        if (!(param = request.getParameter("rowOffset")).isEmpty()) {
+            query.m_rowOffset = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+        if (!(param = request.getParameter("rows")).isEmpty()) {
+            query.m_rows = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+        if (!(param = request.getParameter("width")).isEmpty()) {
+            query.m_width = boost::lexical_cast<unsigned int>(param.toStdString());
+        }
+    }
+    catch (const boost::bad_lexical_cast &e)
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Wrong integer conversion on device set index or query parameter";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    QByteArray formatStr = request.getParameter("format");
+
+    if (formatStr.isEmpty() || (formatStr == "png")) {
+        query.m_format = SpectrumWaterfall::TileFormatPNG;
+    } else if (formatStr == "raw") {
+        query.m_format = SpectrumWaterfall::TileFormatRaw;
+    }
+    else
+    {
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid tile format (png or raw)";
+        response.setStatus(400,"Invalid data");
+        response.write(errorResponse.asJson().toUtf8());
+        return;
+    }
+
+    SpectrumWaterfall::Tile tile;
+    int status = m_adapter->devicesetSpectrumWaterfallTileGet(deviceSetIndex, query, tile, errorResponse);
+    response.setStatus(status);
+
+    if (status/100 == 2)
+    {
+        response.setHeader("Content-Type", query.m_format == SpectrumWaterfall::TileFormatPNG ? "image/png" : "application/octet-stream");
+        response.setHeader("Cache-Control", "no-cache");
+        response.setHeader("Access-Control-Expose-Headers", "X-Tile-Width, X-Tile-Height, X-Start-Frequency, X-Stop-Frequency, X-From-Ms, X-To-Ms");
+        response.setHeader("X-Tile-Width", tile.m_width);
+        response.setHeader("X-Tile-Height", tile.m_height);
+        response.setHeader("X-Start-Frequency", QByteArray::number(tile.m_startFrequency));
+        response.setHeader("X-Stop-Frequency", QByteArray::number(tile.m_stopFrequency));
+        response.setHeader("X-From-Ms", QByteArray::number(tile.m_fromMs));
+        response.setHeader("X-To-Ms", QByteArray::number(tile.m_toMs));
+        response.write(tile.m_data, true);
+    }
+    else
+    {
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetChannelService(
         const std::string& deviceSetIndexStr,
         qtwebapp::HttpRequest& request,
@@ -2731,6 +3206,16 @@ bool WebAPIRequestMapper::validateAudioOutputDevice(
         audioOutputDevice.setUdpDecimationFactor(jsonObject["udpDecimationFactor"].toInt());
         audioOutputDeviceKeys.append("udpDecimationFactor");
     }
+    if (jsonObject.contains("udpMulticastTTL"))
+    {
+        audioOutputDevice.setUdpMulticastTtl(jsonObject["udpMulticastTTL"].toInt());
+        audioOutputDeviceKeys.append("udpMulticastTTL");
+    }
+    if (jsonObject.contains("udpFramesPerDatagram"))
+    {
+        audioOutputDevice.setUdpFramesPerDatagram(jsonObject["udpFramesPerDatagram"].toInt());
+        audioOutputDeviceKeys.append("udpFramesPerDatagram");
+    }
     if (jsonObject.contains("udpAddress"))
     {
         audioOutputDevice.setUdpAddress(new QString(jsonObject["udpAddress"].toString()));
@@ -3502,6 +3987,11 @@ bool WebAPIRequestMapper::getDeviceActions(
             deviceActions->setFcdProPlusActions(new SWGSDRangel::SWGFCDProPlusActions());
             deviceActions->getFcdProPlusActions()->fromJsonObject(actionsJsonObject);
         }
+        else if (deviceActionsKey == "fileInputActions")
+        {
+            deviceActions->setFileInputActions(new SWGSDRangel::SWGFileInputActions());
+            deviceActions->getFileInputActions()->fromJsonObject(actionsJsonObject);
+        }
         else if (deviceActionsKey == "hackRFInputActions")
         {
             deviceActions->setHackRfInputActions(new SWGSDRangel::SWGHackRFInputActions());
@@ -3666,6 +4156,7 @@ void WebAPIRequestMapper::resetDeviceActions(SWGSDRangel::SWGDeviceActions& devi
     deviceActions.setBladeRf1InputActions(nullptr);
     deviceActions.setFcdProActions(nullptr);
     deviceActions.setFcdProPlusActions(nullptr);
+    deviceActions.setFileInputActions(nullptr);
     deviceActions.setHackRfInputActions(nullptr);
     deviceActions.setKiwiSdrActions(nullptr);
     deviceActions.setLimeSdrInputActions(nullptr);
@@ -3712,6 +4203,7 @@ void WebAPIRequestMapper::resetChannelReport(SWGSDRangel::SWGChannelReport& chan
     channelReport.setDsdDemodReport(nullptr);
     channelReport.setNfmDemodReport(nullptr);
     channelReport.setNfmModReport(nullptr);
+    channelReport.setRemoteSinkReport(nullptr);
     channelReport.setRemoteSourceReport(nullptr);
     channelReport.setSsbDemodReport(nullptr);
     channelReport.setSsbModReport(nullptr);
@@ -0,0 +1,544 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QtWebSockets>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "audio/audioopus.h"
+
+#include "wschannelstream.h"
+
+WSChannelStream::WSChannelStream(QObject *parent) :
+    QObject(parent),
+    m_listeningAddress(QHostAddress::LocalHost),
+    m_port(8890),
+    m_webSocketServer(nullptr),
+    m_nextGroupId(0),
+    m_audioSampleRate(48000),
+    m_audioStereo(false),
+    m_iqSampleRate(48000),
+    m_nbAudioSubscribers(0),
+    m_nbIQSubscribers(0)
+{
+    connect(this, &WSChannelStream::blockReady, this, &WSChannelStream::sendBlock, Qt::QueuedConnection);
+}
+
+WSChannelStream::~WSChannelStream()
+{
+    closeSocket();
+}
+
+void WSChannelStream::openSocket()
+{
+    m_webSocketServer = new QWebSocketServer(
+        QStringLiteral("Channel Stream Server"),
+        QWebSocketServer::NonSecureMode,
+        this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSChannelStream::openSocket: channel stream server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSChannelStream::onNewConnection);
+    }
+    else
+    {
+        qInfo("WSChannelStream::openSocket: cannot start channel stream server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+    }
+}
+
+void WSChannelStream::closeSocket()
+{
+    for (QMap<QWebSocket*, Client>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        QWebSocket *socket = it.key();
+        disconnect(socket, nullptr, this, nullptr);
+        socket->close();
+        socket->deleteLater();
+    }
+
+    m_clients.clear();
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+
+        for (Group *group : m_groups)
+        {
+            delete group->m_opus;
+            delete group;
+        }
+
+        m_groups.clear();
+        m_nbAudioSubscribers = 0;
+        m_nbIQSubscribers = 0;
+    }
+
+    if (m_webSocketServer)
+    {
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+    }
+}
+
+bool WSChannelStream::socketOpened()
+{
+    return m_webSocketServer && m_webSocketServer->isListening();
+}
+
+QString WSChannelStream::getWebSocketIdentifier(QWebSocket *peer)
+{
+    return QStringLiteral("%1:%2").arg(peer->peerAddress().toString(), QString::number(peer->peerPort()));
+}
+
+bool WSChannelStream::isOpusSampleRate(int sampleRate)
+{
+    return (sampleRate == 8000) || (sampleRate == 12000) || (sampleRate == 16000) || (sampleRate == 24000) || (sampleRate == 48000);
+}
+
+unsigned int WSChannelStream::getOpusFrameSize(unsigned int blockSize)
+{
+    static const unsigned int frameSizes[] = {2880, 1920, 960, 480, 240, 120}; // 60 to 2.5 ms at 48 kS/s
+
+    for (unsigned int frameSize : frameSizes)
+    {
+        if (blockSize >= frameSize) {
+            return frameSize;
+        }
+    }
+
+    return 120;
+}
+
+int WSChannelStream::getNbChannels(const Group *group) const
+{
+    return ((group->m_kind == StreamIQ) || m_audioStereo) ? 2 : 1;
+}
+
+void WSChannelStream::onNewConnection()
+{
+    auto pSocket = m_webSocketServer->nextPendingConnection();
+    qDebug() << "WSChannelStream::onNewConnection: " << getWebSocketIdentifier(pSocket) << " connected";
+    pSocket->setParent(this);
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSChannelStream::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSChannelStream::socketDisconnected);
+    connect(pSocket, &QWebSocket::bytesWritten, this, &WSChannelStream::socketBytesWritten);
+
+    Client client;
+    client.m_groupId = -1;
+    client.m_pendingBytes = 0;
+    client.m_skippedBlocks = 0;
+    m_clients.insert(pSocket, client);
+}
+
+void WSChannelStream::processClientMessage(const QString &message)
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (!pClient || !m_clients.contains(pClient)) {
+        return;
+    }
+
+    qDebug() << "WSChannelStream::processClientMessage: " << getWebSocketIdentifier(pClient) << ": " << message;
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(message.toUtf8(), &parseError);
+
+    if (!document.isObject())
+    {
+        replyToClient(pClient, QString("Invalid JSON: %1").arg(parseError.errorString()));
+        return;
+    }
+
+    QJsonObject request = document.object();
+    QString stream = request.value("stream").toString();
+    QString format = request.value("format").toString("pcm");
+    int blockSize = request.value("blockSize").toInt(1024);
+    StreamKind kind;
+    StreamFormat streamFormat;
+
+    if (stream == "audio") {
+        kind = StreamAudio;
+    } else if (stream == "iq") {
+        kind = StreamIQ;
+    } else if (stream == "none") {
+        kind = StreamAudio; // unsubscribe only
+    } else {
+        replyToClient(pClient, QString("Unknown stream %1. Use audio, iq or none").arg(stream));
+        return;
+    }
+
+    if (format == "pcm") {
+        streamFormat = FormatPCM;
+    } else if ((format == "opus") && (kind == StreamAudio)) {
+        streamFormat = FormatOpus;
+    } else {
+        replyToClient(pClient, QString("Unsupported format %1 for %2 stream").arg(format, stream));
+        return;
+    }
+
+    blockSize = std::max((int) m_minBlockSize, std::min((int) m_maxBlockSize, blockSize));
+    Client& client = m_clients[pClient];
+    QMutexLocker mutexLocker(&m_mutex);
+    unsubscribe(client.m_groupId);
+    client.m_groupId = -1;
+    client.m_skippedBlocks = 0;
+
+    if (stream == "none")
+    {
+        mutexLocker.unlock();
+        replyToClient(pClient, "");
+        return;
+    }
+
+    if ((streamFormat == FormatOpus) && !isOpusSampleRate(m_audioSampleRate))
+    {
+        mutexLocker.unlock();
+        replyToClient(pClient, QString("Opus needs an audio sample rate of 8, 12, 16, 24 or 48 kS/s not %1 S/s").arg(m_audioSampleRate));
+        return;
+    }
+
+    if (streamFormat == FormatOpus) { // block size is given at the audio sample rate: make it an Opus frame size at 48 kS/s
+        blockSize = getOpusFrameSize((blockSize * 48000LL) / m_audioSampleRate);
+    }
+
+    Group *group = subscribe(kind, streamFormat, blockSize);
+    client.m_groupId = group->m_id;
+    replyToClient(pClient, "", group);
+}
+
+void WSChannelStream::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << "WSChannelStream::socketDisconnected: " << getWebSocketIdentifier(pClient) << " disconnected";
+
+        if (m_clients.contains(pClient))
+        {
+            const Client& client = m_clients[pClient];
+
+            if (client.m_skippedBlocks != 0) {
+                qDebug("WSChannelStream::socketDisconnected: %llu blocks skipped", client.m_skippedBlocks);
+            }
+
+            QMutexLocker mutexLocker(&m_mutex);
+            unsubscribe(client.m_groupId);
+            mutexLocker.unlock();
+            m_clients.remove(pClient);
+        }
+
+        pClient->deleteLater();
+    }
+}
+
+void WSChannelStream::socketBytesWritten(qint64 bytes)
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient && m_clients.contains(pClient))
+    {
+        Client& client = m_clients[pClient];
+        client.m_pendingBytes = std::max((qint64) 0, client.m_pendingBytes - bytes); // written bytes include the frame headers
+    }
+}
+
+void WSChannelStream::sendBlock(int groupId, QByteArray block)
+{
+    for (QMap<QWebSocket*, Client>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        if (it->m_groupId != groupId) {
+            continue;
+        }
+
+        if (it->m_pendingBytes > m_maxPendingBlocks * block.size()) // slow client: skip the whole block
+        {
+            it->m_skippedBlocks++;
+            continue;
+        }
+
+        it->m_pendingBytes += it.key()->sendBinaryMessage(block); // same payload shared by all clients
+    }
+}
+
+void WSChannelStream::replyToClient(QWebSocket *socket, const QString& error, const Group *group)
+{
+    QJsonObject reply;
+
+    if (!error.isEmpty())
+    {
+        reply.insert("error", error);
+    }
+    else if (group) // m_mutex is locked
+    {
+        reply.insert("stream", group->m_kind == StreamAudio ? "audio" : "iq");
+        reply.insert("format", group->m_format == FormatOpus ? "opus" : "pcm");
+        reply.insert("blockSize", (int) group->m_nbSamples);
+        reply.insert("sampleRate", group->m_kind == StreamAudio ? m_audioSampleRate : m_iqSampleRate);
+        reply.insert("channels", getNbChannels(group));
+    }
+    else
+    {
+        reply.insert("stream", "none");
+    }
+
+    socket->sendTextMessage(QString(QJsonDocument(reply).toJson(QJsonDocument::Compact)));
+}
+
+WSChannelStream::Group *WSChannelStream::subscribe(StreamKind kind, StreamFormat format, unsigned int blockSize)
+{
+    Group *group = nullptr;
+
+    for (Group *g : m_groups)
+    {
+        if ((g->m_kind == kind) && (g->m_format == format) && (g->m_blockSize == blockSize))
+        {
+            group = g;
+            break;
+        }
+    }
+
+    if (!group)
+    {
+        group = new Group();
+        group->m_id = m_nextGroupId++;
+        group->m_kind = kind;
+        group->m_format = format;
+        group->m_blockSize = blockSize;
+        group->m_sequence = 0;
+        group->m_opus = format == FormatOpus ? new AudioOpus() : nullptr;
+        group->m_nbSubscribers = 0;
+        resizeGroup(group);
+        m_groups.push_back(group);
+    }
+
+    group->m_nbSubscribers++;
+
+    if (kind == StreamAudio) {
+        m_nbAudioSubscribers++;
+    } else {
+        m_nbIQSubscribers++;
+    }
+
+    return group;
+}
+
+void WSChannelStream::unsubscribe(int groupId)
+{
+    std::vector<Group*>::iterator it = std::find_if(m_groups.begin(), m_groups.end(), [groupId](const Group *g) {
+        return g->m_id == groupId;
+    });
+
+    if (it == m_groups.end()) {
+        return;
+    }
+
+    Group *group = *it;
+    group->m_nbSubscribers--;
+
+    if (group->m_kind == StreamAudio) {
+        m_nbAudioSubscribers--;
+    } else {
+        m_nbIQSubscribers--;
+    }
+
+    if (group->m_nbSubscribers == 0)
+    {
+        m_groups.erase(it);
+        delete group->m_opus;
+        delete group;
+    }
+}
+
+void WSChannelStream::resizeGroup(Group *group)
+{
+    int nbChannels = getNbChannels(group);
+
+    if (group->m_format == FormatOpus)
+    {
+        if (isOpusSampleRate(m_audioSampleRate))
+        {
+            group->m_nbSamples = (group->m_blockSize * m_audioSampleRate) / 48000;
+            group->m_opus->setEncoder(m_audioSampleRate, nbChannels);
+        }
+        else
+        {
+            qWarning("WSChannelStream::resizeGroup: Opus stream stopped at audio sample rate %d", m_audioSampleRate);
+            group->m_nbSamples = 0;
+        }
+    }
+    else
+    {
+        group->m_nbSamples = group->m_blockSize;
+    }
+
+    group->m_buffer.resize(group->m_nbSamples * nbChannels);
+    group->m_fill = 0;
+}
+
+void WSChannelStream::setAudioFormat(int sampleRate, bool stereo)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if ((sampleRate == m_audioSampleRate) && (stereo == m_audioStereo)) {
+        return;
+    }
+
+    m_audioSampleRate = sampleRate;
+    m_audioStereo = stereo;
+
+    for (Group *group : m_groups)
+    {
+        if (group->m_kind == StreamAudio) {
+            resizeGroup(group);
+        }
+    }
+}
+
+void WSChannelStream::setIQSampleRate(int sampleRate)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (sampleRate == m_iqSampleRate) {
+        return;
+    }
+
+    m_iqSampleRate = sampleRate;
+
+    for (Group *group : m_groups)
+    {
+        if (group->m_kind == StreamIQ) {
+            group->m_fill = 0; // do not mix sample rates in a block
+        }
+    }
+}
+
+void WSChannelStream::writeAudio(const AudioSample *samples, unsigned int nbSamples)
+{
+    if (m_nbAudioSubscribers.load() == 0) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    unsigned int nbChannels = m_audioStereo ? 2 : 1;
+
+    for (Group *group : m_groups)
+    {
+        if ((group->m_kind != StreamAudio) || (group->m_nbSamples == 0)) {
+            continue;
+        }
+
+        for (unsigned int i = 0; i < nbSamples;)
+        {
+            unsigned int count = std::min(nbSamples - i, (unsigned int) (group->m_buffer.size() - group->m_fill) / nbChannels);
+            int16_t *dst = &group->m_buffer[group->m_fill];
+
+            if (m_audioStereo)
+            {
+                const int16_t *src = (const int16_t *) &samples[i]; // left and right are interleaved in AudioSample
+                std::copy(src, src + 2*count, dst);
+            }
+            else
+            {
+                for (unsigned int j = 0; j < count; j++) {
+                    dst[j] = samples[i+j].l;
+                }
+            }
+
+            group->m_fill += count * nbChannels;
+            i += count;
+
+            if (group->m_fill == group->m_buffer.size()) {
+                flushGroup(group);
+            }
+        }
+    }
+}
+
+void WSChannelStream::writeIQ(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (m_nbIQSubscribers.load() == 0) {
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (Group *group : m_groups)
+    {
+        if (group->m_kind != StreamIQ) {
+            continue;
+        }
+
+        for (SampleVector::const_iterator it = begin; it != end;)
+        {
+            unsigned int count = std::min((unsigned int) (end - it), (unsigned int) (group->m_buffer.size() - group->m_fill) / 2);
+            int16_t *dst = &group->m_buffer[group->m_fill];
+
+            for (unsigned int j = 0; j < count; j++, ++it)
+            {
+                dst[2*j] = it->real() >> (SDR_RX_SAMP_SZ - 16);
+                dst[2*j+1] = it->imag() >> (SDR_RX_SAMP_SZ - 16);
+            }
+
+            group->m_fill += 2*count;
+
+            if (group->m_fill == group->m_buffer.size()) {
+                flushGroup(group);
+            }
+        }
+    }
+}
+
+void WSChannelStream::flushGroup(Group *group)
+{
+    quint32 sampleRate = group->m_kind == StreamAudio ? m_audioSampleRate : m_iqSampleRate;
+    quint16 nbChannels = getNbChannels(group);
+    quint16 format = (quint16) group->m_format;
+    quint32 nbSamples = group->m_nbSamples;
+    QByteArray block;
+    block.reserve(16 + group->m_fill*sizeof(int16_t));
+    block.append((const char*) &group->m_sequence, sizeof(quint32));
+    block.append((const char*) &sampleRate, sizeof(quint32));
+    block.append((const char*) &nbChannels, sizeof(quint16));
+    block.append((const char*) &format, sizeof(quint16));
+    block.append((const char*) &nbSamples, sizeof(quint32));
+    group->m_fill = 0;
+
+    if (group->m_format == FormatOpus)
+    {
+        uint8_t packet[AudioOpus::m_maxPacketSize];
+        int nbBytes = group->m_opus->encode(group->m_nbSamples, group->m_buffer.data(), packet);
+
+        if (nbBytes <= 0) {
+            return;
+        }
+
+        block.append((const char*) packet, nbBytes);
+    }
+    else
+    {
+        block.append((const char*) group->m_buffer.data(), group->m_buffer.size()*sizeof(int16_t));
+    }
+
+    group->m_sequence++;
+    emit blockReady(group->m_id, block);
+}
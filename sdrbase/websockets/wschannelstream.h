@@ -0,0 +1,143 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Channel audio and I/Q streaming WebSocket server                              //
+//                                                                               //
+// Clients subscribe with a text message giving the stream (audio or I/Q), the   //
+// format (PCM or Opus for audio) and the block size. Blocks are sent in binary  //
+// messages. Clients asking for the same stream, format and block size share a   //
+// group: each block is encoded once and the same payload is sent to all its     //
+// subscribers. A client with too many bytes waiting to be sent skips whole      //
+// blocks. Samples are written from the channel DSP thread and sent from the     //
+// thread of this object.                                                        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSCHANNELSTREAM_H_
+#define SDRBASE_WEBSOCKETS_WSCHANNELSTREAM_H_
+
+#include <atomic>
+#include <vector>
+
+#include <QObject>
+#include <QMap>
+#include <QMutex>
+#include <QByteArray>
+#include <QHostAddress>
+
+#include "dsp/dsptypes.h"
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class AudioOpus;
+
+class SDRBASE_API WSChannelStream : public QObject
+{
+    Q_OBJECT
+public:
+    enum StreamKind
+    {
+        StreamAudio,
+        StreamIQ
+    };
+
+    enum StreamFormat
+    {
+        FormatPCM,  //!< 16 bit signed integers interleaved
+        FormatOpus  //!< One Opus packet per block. Audio only
+    };
+
+    explicit WSChannelStream(QObject *parent = nullptr);
+    ~WSChannelStream() override;
+
+    void openSocket();
+    void closeSocket();
+    bool socketOpened();
+    void setListeningAddress(const QString& address) { m_listeningAddress.setAddress(address); }
+    void setPort(quint16 port) { m_port = port; }
+
+    // writer side. May be called from any thread
+
+    void setAudioFormat(int sampleRate, bool stereo);
+    void setIQSampleRate(int sampleRate);
+    bool hasAudioSubscribers() const { return m_nbAudioSubscribers.load() > 0; }
+    bool hasIQSubscribers() const { return m_nbIQSubscribers.load() > 0; }
+    void writeAudio(const AudioSample *samples, unsigned int nbSamples);
+    void writeIQ(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+
+    static const unsigned int m_minBlockSize = 64;    //!< samples per channel
+    static const unsigned int m_maxBlockSize = 16384; //!< samples per channel
+    static const int m_maxPendingBlocks = 4;          //!< blocks waiting to be sent to a client before it skips blocks
+
+signals:
+    void blockReady(int groupId, QByteArray block);
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+    void socketBytesWritten(qint64 bytes);
+    void sendBlock(int groupId, QByteArray block);
+
+private:
+    struct Group //!< Subscribers to the same stream, format and block size. Writer side under m_mutex
+    {
+        int m_id;
+        StreamKind m_kind;
+        StreamFormat m_format;
+        unsigned int m_blockSize;       //!< Requested block size. For Opus the frame size at 48 kS/s
+        unsigned int m_nbSamples;       //!< Samples per channel in a block at the current sample rate
+        std::vector<int16_t> m_buffer;  //!< Block being filled
+        unsigned int m_fill;            //!< Number of values in m_buffer
+        quint32 m_sequence;             //!< Block sequence number. Gaps show skipped blocks to clients
+        AudioOpus *m_opus;
+        int m_nbSubscribers;
+    };
+
+    struct Client //!< Server thread only
+    {
+        int m_groupId;           //!< -1 until the client has subscribed
+        qint64 m_pendingBytes;   //!< Bytes queued in the socket and not written yet
+        quint64 m_skippedBlocks;
+    };
+
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    QWebSocketServer* m_webSocketServer;
+    QMap<QWebSocket*, Client> m_clients;
+
+    QMutex m_mutex;
+    std::vector<Group*> m_groups;
+    int m_nextGroupId;
+    int m_audioSampleRate;
+    bool m_audioStereo;
+    int m_iqSampleRate;
+    std::atomic<int> m_nbAudioSubscribers;
+    std::atomic<int> m_nbIQSubscribers;
+
+    static QString getWebSocketIdentifier(QWebSocket *peer);
+    static bool isOpusSampleRate(int sampleRate);
+    static unsigned int getOpusFrameSize(unsigned int blockSize);
+    int getNbChannels(const Group *group) const;
+    void resizeGroup(Group *group);
+    Group *subscribe(StreamKind kind, StreamFormat format, unsigned int blockSize);
+    void unsubscribe(int groupId);
+    void flushGroup(Group *group);
+    void replyToClient(QWebSocket *socket, const QString& error, const Group *group = nullptr);
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSCHANNELSTREAM_H_
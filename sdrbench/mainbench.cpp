@@ -30,6 +30,7 @@ MainBench::MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser
     QObject(parent),
     m_logger(logger),
     m_parser(parser),
+    m_nbFailures(0),
     m_uniform_distribution_f(-1.0, 1.0),
     m_uniform_distribution_s16(-2048, 2047)
 {
@@ -64,6 +65,22 @@ void MainBench::run()
         testDecimateFF();
     } else if (m_parser.getTestType() == ParserBench::TestAMBE) {
         testAMBE();
+    } else if (m_parser.getTestType() == ParserBench::TestSpectrumHistory) {
+        testSpectrumHistory();
+    } else if (m_parser.getTestType() == ParserBench::TestSigMF) {
+        testSigMF();
+    } else if (m_parser.getTestType() == ParserBench::TestFileRecordSegments) {
+        testFileRecordSegments();
+    } else if (m_parser.getTestType() == ParserBench::TestAudioFifo) {
+        testAudioFifo();
+    } else if (m_parser.getTestType() == ParserBench::TestScopeEnvelope) {
+        testScopeEnvelope();
+    } else if (m_parser.getTestType() == ParserBench::TestRemoteCodec) {
+        testRemoteCodec();
+    } else if (m_parser.getTestType() == ParserBench::TestRemoteLatency) {
+        testRemoteLatency();
+    } else if (m_parser.getTestType() == ParserBench::TestSpectrumActivity) {
+        testSpectrumActivity();
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -406,3 +423,14 @@ void MainBench::printResults(const QString& prefix, qint64 nsecs)
     info.noquote();
     info << tr("%1: ran test in %L2 ns - sample rate: %3 kS/s").arg(prefix).arg(nsecs).arg(ratekSs);
 }
+
+bool MainBench::check(bool condition, const QString& description)
+{
+    if (!condition)
+    {
+        qCritical("MainBench: check failed: %s", qPrintable(description));
+        m_nbFailures++;
+    }
+
+    return condition;
+}
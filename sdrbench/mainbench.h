@@ -23,6 +23,7 @@
 #include <QObject>
 #include <random>
 #include <functional>
+#include <vector>
 
 #include "dsp/decimators.h"
 #include "dsp/decimatorsif.h"
@@ -34,6 +35,8 @@ namespace qtwebapp {
     class LoggerWithFile;
 }
 
+class ScopeEnvelope;
+
 class MainBench: public QObject {
     Q_OBJECT
 
@@ -41,6 +44,8 @@ public:
     explicit MainBench(qtwebapp::LoggerWithFile *logger, const ParserBench& parser, QObject *parent = 0);
     ~MainBench();
 
+    int getNbFailures() const { return m_nbFailures; } //!< Failed checks of the tests run
+
 public slots:
     void run();
 
@@ -53,6 +58,17 @@ private:
     void testDecimateFI();
     void testDecimateFF();
     void testAMBE();
+    void testSpectrumHistory();
+    void testSigMF();
+    void testFileRecordSegments();
+    void testAudioFifo();
+    void testScopeEnvelope();
+    bool checkScopeEnvelopeLevels(const ScopeEnvelope& envelope, const std::vector<float>& trace, uint32_t nbSamples, const QString& name);
+    void testRemoteCodec();
+    template<typename T>
+    void testRemoteCodecBlocks(unsigned int amplitudeBits, const QString& signal);
+    void testRemoteLatency();
+    void testSpectrumActivity();
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -60,10 +76,12 @@ private:
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
     void printResults(const QString& prefix, qint64 nsecs);
+    bool check(bool condition, const QString& description); //!< Logs and counts a failed check
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
     const ParserBench& m_parser;
+    int m_nbFailures;
     std::mt19937 m_generator;
     std::uniform_real_distribution<float> m_uniform_distribution_f;
     std::uniform_int_distribution<qint16> m_uniform_distribution_s16;
@@ -24,7 +24,7 @@
 
 ParserBench::ParserBench() :
     m_testOption(QStringList() << "t" << "test",
-        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe",
+        "Test type: decimateii, decimatefi, decimateff, decimateif, decimateinfii, decimatesupii, ambe, spectrumhistory, sigmf, filerecordsegments, audiofifo, scopeenvelope, remotecodec, remotelatency, spectrumactivity",
         "test",
         "decimateii"),
     m_nbSamplesOption(QStringList() << "n" << "nb-samples",
@@ -127,6 +127,22 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsSupII;
     } else if (m_testStr == "ambe") {
         return TestAMBE;
+    } else if (m_testStr == "spectrumhistory") {
+        return TestSpectrumHistory;
+    } else if (m_testStr == "sigmf") {
+        return TestSigMF;
+    } else if (m_testStr == "filerecordsegments") {
+        return TestFileRecordSegments;
+    } else if (m_testStr == "audiofifo") {
+        return TestAudioFifo;
+    } else if (m_testStr == "scopeenvelope") {
+        return TestScopeEnvelope;
+    } else if (m_testStr == "remotecodec") {
+        return TestRemoteCodec;
+    } else if (m_testStr == "remotelatency") {
+        return TestRemoteLatency;
+    } else if (m_testStr == "spectrumactivity") {
+        return TestSpectrumActivity;
     } else {
         return TestDecimatorsII;
     }
@@ -33,7 +33,15 @@ public:
         TestDecimatorsFF,
         TestDecimatorsInfII,
         TestDecimatorsSupII,
-        TestAMBE
+        TestAMBE,
+        TestSpectrumHistory,
+        TestSigMF,
+        TestFileRecordSegments,
+        TestAudioFifo,
+        TestScopeEnvelope,
+        TestRemoteCodec,
+        TestRemoteLatency,
+        TestSpectrumActivity
     } TestType;
 
     ParserBench();
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QThread>
+
+#include "audio/audiofifo.h"
+
+#include "mainbench.h"
+
+namespace {
+
+// samples are their index since the start of the stream
+void fillAudioSamples(std::vector<AudioSample>& samples, uint32_t firstSample)
+{
+    for (uint32_t i = 0; i < samples.size(); i++)
+    {
+        samples[i].l = (qint16) (firstSample + i);
+        samples[i].r = (qint16) ~(firstSample + i);
+    }
+}
+
+bool checkAudioSamples(const AudioSample *samples, uint32_t nbSamples, uint32_t firstSample)
+{
+    for (uint32_t i = 0; i < nbSamples; i++)
+    {
+        if ((samples[i].l != (qint16) (firstSample + i)) || (samples[i].r != (qint16) ~(firstSample + i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// channel side writing a stream of samples by chunks
+class AudioFifoWriter : public QThread
+{
+public:
+    AudioFifoWriter(AudioFifo& fifo, uint32_t nbSamples, uint32_t chunkSize) :
+        m_fifo(fifo),
+        m_nbSamples(nbSamples),
+        m_chunkSize(chunkSize),
+        m_nbWritten(0),
+        m_elapsedMs(0)
+    {}
+
+    uint32_t getNbWritten() const { return m_nbWritten.load(); }
+    qint64 getElapsedMs() const { return m_elapsedMs; }
+
+protected:
+    virtual void run()
+    {
+        std::vector<AudioSample> chunk(m_chunkSize);
+        QElapsedTimer timer;
+        timer.start();
+
+        while (m_nbWritten < m_nbSamples)
+        {
+            uint32_t nbSamples = std::min(m_chunkSize, m_nbSamples - m_nbWritten);
+            chunk.resize(nbSamples);
+            fillAudioSamples(chunk, m_nbWritten);
+            uint32_t nbWritten = m_fifo.write((const quint8*) chunk.data(), nbSamples);
+            m_nbWritten += nbWritten;
+
+            if (nbWritten != nbSamples) {
+                break; // samples dropped
+            }
+        }
+
+        m_elapsedMs = timer.elapsed();
+    }
+
+private:
+    AudioFifo& m_fifo;
+    uint32_t m_nbSamples;
+    uint32_t m_chunkSize;
+    std::atomic<uint32_t> m_nbWritten; //!< read while running
+    qint64 m_elapsedMs;
+};
+
+} // namespace
+
+void MainBench::testAudioFifo()
+{
+    const uint32_t fifoSize = 256;
+    AudioFifo fifo(fifoSize);
+    std::vector<AudioSample> samples(2 * fifoSize);
+    fillAudioSamples(samples, 0);
+
+    qDebug() << "MainBench::testAudioFifo: non blocking";
+
+    check(!fifo.isBlocking(), "AudioFifo: not blocking by default");
+    check(fifo.write((const quint8*) samples.data(), 2 * fifoSize) == fifoSize, "AudioFifo: samples dropped when full");
+    check(fifo.isFull(), "AudioFifo: full");
+    fifo.clear();
+
+    qDebug() << "MainBench::testAudioFifo: blocking stream";
+
+    // reader woken up by the FIFO only
+    const uint32_t nbSamples = m_parser.getNbSamples() * m_parser.getRepetition();
+    QSemaphore dataAvailable;
+    fifo.setBlocking(true, &dataAvailable);
+    check(fifo.isBlocking(), "AudioFifo: blocking");
+    AudioFifoWriter writer(fifo, nbSamples, fifoSize + 44);
+    QElapsedTimer timer;
+    timer.start();
+    writer.start();
+    uint32_t nbRead = 0;
+    bool ok = true;
+
+    while ((nbRead < nbSamples) && dataAvailable.tryAcquire(1, 2000))
+    {
+        uint32_t n = fifo.read((quint8*) samples.data(), 100); // smaller than the writes
+        ok = ok && checkAudioSamples(samples.data(), n, nbRead);
+        nbRead += n;
+
+        if (!fifo.isEmpty()) {
+            dataAvailable.release(); // more to read
+        }
+    }
+
+    writer.wait();
+    check(ok, "AudioFifo: samples read in order");
+    check((writer.getNbWritten() == nbSamples) && (nbRead == nbSamples),
+        QString("AudioFifo: %1 samples written %2 read of %3").arg(writer.getNbWritten()).arg(nbRead).arg(nbSamples));
+    qint64 nsecs = timer.nsecsElapsed();
+    printResults("MainBench::testAudioFifo", nsecs);
+
+    qDebug() << "MainBench::testAudioFifo: blocked writer";
+
+    // a writer blocked on a full FIFO goes on when it is cleared then when blocking is released
+    fifo.clear();
+    AudioFifoWriter blockedWriter(fifo, 3 * fifoSize, fifoSize);
+    blockedWriter.start();
+
+    while (fifo.fill() < fifoSize) {
+        QThread::msleep(1);
+    }
+
+    QThread::msleep(20); // writer waiting for room
+    fifo.clear();
+
+    while ((blockedWriter.getNbWritten() < 2 * fifoSize) && !blockedWriter.isFinished()) {
+        QThread::msleep(1);
+    }
+
+    QThread::msleep(20);
+    fifo.setBlocking(false);
+    blockedWriter.wait();
+    check(blockedWriter.getNbWritten() == 2 * fifoSize, QString("AudioFifo: %1 samples written by the blocked writer").arg(blockedWriter.getNbWritten()));
+    check(blockedWriter.getElapsedMs() < 500, QString("AudioFifo: blocked writer released in %1 ms").arg(blockedWriter.getElapsedMs()));
+    check(!fifo.isBlocking(), "AudioFifo: blocking released");
+
+    qDebug() << "MainBench::testAudioFifo: reader gone";
+
+    // samples are dropped after the timeout if nobody reads
+    fifo.clear();
+    fifo.setBlocking(true);
+    timer.start();
+    check(fifo.write((const quint8*) samples.data(), 2 * fifoSize) == fifoSize, "AudioFifo: samples dropped without reader");
+    check(timer.elapsed() >= 900, QString("AudioFifo: writer waited %1 ms for the reader").arg(timer.elapsed()));
+    fifo.setBlocking(false);
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testAudioFifo: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
@@ -0,0 +1,214 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <fstream>
+
+#include <QDebug>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "dsp/filerecord.h"
+#include "dsp/filerecordretention.h"
+#include "dsp/filerecordsegmentreader.h"
+
+#include "mainbench.h"
+
+namespace {
+
+const quint32 segmentSampleRate = 1000; // 1 ms per sample
+const quint64 segmentCenterFrequency = 100000000;
+const quint64 segmentSamples = 1000;
+const qint64 segmentStartTime = 1600000000000LL;
+
+// 16 bit segment whose samples are their index since the start of the recording
+bool writeSegmentFile(const FileRecordRetention::Segment& segment)
+{
+    std::ofstream stream(segment.m_fileName.toStdString().c_str(), std::ios::binary);
+
+    if (!stream.is_open()) {
+        return false;
+    }
+
+    FileRecord::Header header;
+    header.sampleRate = segmentSampleRate;
+    header.centerFrequency = segmentCenterFrequency;
+    header.startTimeStamp = segment.m_startTime / 1000;
+    header.sampleSize = 16;
+    header.filler = 0;
+    FileRecord::writeHeader(stream, header);
+
+    for (quint64 i = 0; i < segment.m_nbSamples; i++)
+    {
+        qint16 iq[2] = {(qint16) (segment.m_startSample + i), (qint16) -(qint64) (segment.m_startSample + i)};
+        stream.write((const char *) iq, sizeof(iq));
+    }
+
+    return stream.good();
+}
+
+// samples read are the expected sequence
+bool checkSegmentSamples(const char *data, qint64 nbBytes, quint64 firstSample)
+{
+    const qint16 *iq = (const qint16 *) data;
+
+    for (qint64 i = 0; i < nbBytes / 4; i++)
+    {
+        if ((iq[2*i] != (qint16) (firstSample + i)) || (iq[2*i+1] != (qint16) -(qint64) (firstSample + i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+void MainBench::testFileRecordSegments()
+{
+    QTemporaryDir dir;
+
+    if (!check(dir.isValid(), "FileRecordSegments: temporary directory")) {
+        return;
+    }
+
+    qDebug() << "MainBench::testFileRecordSegments: index";
+
+    QString indexFileName = FileRecordRetention::getIndexFileName(dir.filePath("rec.sdriq"));
+    check(indexFileName == dir.filePath("rec.sdriqseg"), "FileRecordSegments: index file name");
+    check(FileRecordRetention::isIndexFile(indexFileName), "FileRecordSegments: index file recognized");
+    check(!FileRecordRetention::isIndexFile(dir.filePath("rec.sdriq")), "FileRecordSegments: recording is not an index");
+
+    // the last segment starts 7 ms late as after a clock adjustment
+    std::vector<FileRecordRetention::Segment> segments(4);
+
+    for (unsigned int i = 0; i < segments.size(); i++)
+    {
+        segments[i].m_fileName = dir.filePath(QString("rec_%1.sdriq").arg(i));
+        segments[i].m_startSample = i * segmentSamples;
+        segments[i].m_nbSamples = segmentSamples;
+        segments[i].m_startTime = segmentStartTime + i * 1000 + (i == 3 ? 7 : 0);
+        check(writeSegmentFile(segments[i]), QString("FileRecordSegments: write %1").arg(segments[i].m_fileName));
+    }
+
+    std::vector<FileRecordRetention::Segment> readSegments;
+    QString errorMessage;
+    check(FileRecordRetention::writeIndex(indexFileName, segments, segmentSampleRate, segmentCenterFrequency), "FileRecordSegments: write index");
+    bool read = FileRecordRetention::readIndex(indexFileName, readSegments, errorMessage);
+
+    if (check(read && (readSegments.size() == segments.size()), "FileRecordSegments: read index"))
+    {
+        bool ok = true;
+
+        for (unsigned int i = 0; i < segments.size(); i++)
+        {
+            ok = ok && (readSegments[i].m_fileName == segments[i].m_fileName);
+            ok = ok && (readSegments[i].m_startSample == segments[i].m_startSample);
+            ok = ok && (readSegments[i].m_nbSamples == segments[i].m_nbSamples);
+            ok = ok && (readSegments[i].m_startTime == segments[i].m_startTime);
+        }
+
+        check(ok, "FileRecordSegments: index round trip");
+    }
+
+    read = FileRecordRetention::readIndex(dir.filePath("missing.sdriqseg"), readSegments, errorMessage);
+    check(!read, "FileRecordSegments: missing index rejected");
+    check(FileRecordRetention::writeIndex(dir.filePath("empty.sdriqseg"), {}, segmentSampleRate, segmentCenterFrequency), "FileRecordSegments: write empty index");
+    read = FileRecordRetention::readIndex(dir.filePath("empty.sdriqseg"), readSegments, errorMessage);
+    check(!read, "FileRecordSegments: index without segments rejected");
+
+    qDebug() << "MainBench::testFileRecordSegments: retention";
+
+    // room for two segments and a half: the two oldest are deleted
+    quint64 segmentBytes = sizeof(FileRecord::Header) + segmentSamples * 2 * sizeof(qint16);
+    FileRecordRetention retention;
+    retention.open(indexFileName, segmentSampleRate, segmentCenterFrequency, 2 * segmentBytes + segmentBytes / 2);
+    check(retention.isOpen(), "FileRecordSegments: retention open");
+
+    for (const auto& segment : segments) {
+        retention.addSegment(segment);
+    }
+
+    retention.close();
+    check(!retention.isOpen(), "FileRecordSegments: retention closed");
+    check(retention.getNbDeleted() == 2, QString("FileRecordSegments: %1 segments deleted").arg(retention.getNbDeleted()));
+    check(retention.getNbSegments() == 2, QString("FileRecordSegments: %1 segments left").arg(retention.getNbSegments()));
+    check(!QFile::exists(segments[0].m_fileName) && !QFile::exists(segments[1].m_fileName), "FileRecordSegments: oldest segment files deleted");
+    check(QFile::exists(segments[2].m_fileName) && QFile::exists(segments[3].m_fileName), "FileRecordSegments: newest segment files kept");
+    read = FileRecordRetention::readIndex(indexFileName, readSegments, errorMessage);
+    check(read && (readSegments.size() == 2) && (readSegments[0].m_fileName == segments[2].m_fileName), "FileRecordSegments: index lists the segments kept");
+
+    qDebug() << "MainBench::testFileRecordSegments: reader";
+
+    FileRecordSegmentReader reader;
+    FileRecord::Header header;
+    bool crcOK = false;
+
+    if (!check(reader.open(indexFileName, header, crcOK, errorMessage), QString("FileRecordSegments: open reader: %1").arg(errorMessage))) {
+        return;
+    }
+
+    check(crcOK && (header.sampleRate == segmentSampleRate) && (header.centerFrequency == segmentCenterFrequency), "FileRecordSegments: header of the first segment");
+    check(reader.getNbSegments() == 2, "FileRecordSegments: reader segments");
+    // sample indexes start at the first segment kept
+    check(reader.getNbSamples() == 2 * segmentSamples, QString("FileRecordSegments: %1 samples").arg(reader.getNbSamples()));
+    check(reader.getStartTime() == segments[2].m_startTime, "FileRecordSegments: start time");
+    check(reader.getDateTime(500) == segments[2].m_startTime + 500, "FileRecordSegments: date time in the first segment");
+    check(reader.getDateTime(segmentSamples + 250) == segments[3].m_startTime + 250, "FileRecordSegments: date time from the segment start time");
+
+    // reads of whole samples that stop at the segment end
+    reader.seek(0);
+    quint64 sampleIndex = 0;
+    std::vector<qint64> readSizes;
+    bool ok = true;
+
+    while (!reader.isEOF() && (readSizes.size() < 10))
+    {
+        qint64 nbBytes;
+        const char *data = reader.next(3001, nbBytes);
+
+        if (!data || (nbBytes == 0)) {
+            break;
+        }
+
+        ok = ok && checkSegmentSamples(data, nbBytes, segments[2].m_startSample + sampleIndex);
+        sampleIndex += nbBytes / 4;
+        readSizes.push_back(nbBytes);
+    }
+
+    check(ok, "FileRecordSegments: samples read across segments");
+    check(sampleIndex == 2 * segmentSamples, QString("FileRecordSegments: %1 samples read").arg(sampleIndex));
+    check((readSizes.size() == 4) && (readSizes[0] == 3000) && (readSizes[1] == 1000), "FileRecordSegments: reads stop at segment end");
+    check(reader.isEOF(), "FileRecordSegments: end of the last segment");
+
+    reader.seek(segmentSamples + 600);
+    qint64 nbBytes;
+    const char *data = reader.next(400, nbBytes);
+    check(!reader.isEOF() && data && (nbBytes == 400) && checkSegmentSamples(data, nbBytes, segments[3].m_startSample + 600), "FileRecordSegments: seek in the second segment");
+    reader.seek(100);
+    data = reader.next(4, nbBytes);
+    check(data && (nbBytes == 4) && checkSegmentSamples(data, nbBytes, segments[2].m_startSample + 100), "FileRecordSegments: seek back to the first segment");
+    reader.close();
+    check(!reader.isOpen(), "FileRecordSegments: reader closed");
+
+    QFile::remove(segments[2].m_fileName);
+    check(!reader.open(indexFileName, header, crcOK, errorMessage), "FileRecordSegments: missing first segment rejected");
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testFileRecordSegments: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "channel/remotecodec.h"
+
+#include "mainbench.h"
+
+namespace {
+
+const char *codecName(RemoteCodec::Codec codec)
+{
+    switch (codec)
+    {
+    case RemoteCodec::CodecBFP8:
+        return "BFP8";
+    case RemoteCodec::CodecBFP10:
+        return "BFP10";
+    case RemoteCodec::CodecBFP12:
+        return "BFP12";
+    case RemoteCodec::CodecNearLosslessRice:
+        return "Rice";
+    default:
+        return "Raw";
+    }
+}
+
+// largest error of a component restored by block floating point
+template<typename T>
+int64_t bfpMaxError(const std::vector<T>& samples, unsigned int bits)
+{
+    const int32_t maxMantissa = (1 << (bits - 1)) - 1;
+    int32_t magnitude = 0;
+
+    for (auto x : samples) {
+        magnitude = std::max(magnitude, (int32_t) x ^ ((int32_t) x >> 31));
+    }
+
+    unsigned int exponent = 0;
+
+    while ((magnitude >> exponent) > maxMantissa) {
+        exponent++;
+    }
+
+    return 1LL << exponent;
+}
+
+} // namespace
+
+template<typename T>
+void MainBench::testRemoteCodecBlocks(unsigned int amplitudeBits, const QString& signal)
+{
+    const unsigned int sampleBytes = sizeof(T);
+    const int32_t maxValue = (1 << (amplitudeBits - 1)) - 1;
+    const double amplitude = 1 << (amplitudeBits - 2);
+    std::uniform_int_distribution<int32_t> noise(-(1 << (amplitudeBits - 5)), 1 << (amplitudeBits - 5));
+    std::vector<T> samples(2*RemoteCodec::m_maxNbSamplesPerBlock);
+    std::vector<T> decoded(2*RemoteCodec::m_maxNbSamplesPerBlock);
+    RemoteProtectedBlock block;
+
+    auto component = [&](double x) {
+        return (T) std::max<int32_t>(std::min<int32_t>(std::lround(x) + noise(m_generator), maxValue), -maxValue - 1);
+    };
+
+    for (int codecIndex = 0; codecIndex < RemoteCodec::CodecEnd; codecIndex++)
+    {
+        RemoteCodec::Codec codec = (RemoteCodec::Codec) codecIndex;
+        unsigned int nbSamples = RemoteCodec::getNbSamplesPerBlock(codec, sampleBytes);
+        QString name = QString("%1 %2 bytes %3").arg(codecName(codec)).arg(sampleBytes).arg(signal);
+        unsigned int nbLossyBlocks = 0;
+
+        if (!check(nbSamples <= RemoteCodec::m_maxNbSamplesPerBlock, name + ": samples per block")) {
+            continue;
+        }
+
+        for (int b = 0; b < 64; b++)
+        {
+            // a slow carrier plus noise so that the predictors have something to predict
+            for (unsigned int n = 0; n < nbSamples; n++)
+            {
+                double phase = (b * nbSamples + n) * 0.01;
+                samples[2*n] = component(amplitude * cos(phase));
+                samples[2*n+1] = component(amplitude * sin(phase));
+            }
+
+            std::vector<T> blockSamples(samples.begin(), samples.begin() + 2*nbSamples);
+            block.init();
+            unsigned int droppedLSBs = RemoteCodec::encode(codec, samples.data(), sampleBytes, block);
+
+            if (!check(RemoteCodec::decode(codec, block, sampleBytes, decoded.data()), name + ": decode")) {
+                continue;
+            }
+
+            int64_t maxError;
+
+            switch (codec)
+            {
+            case RemoteCodec::CodecBFP8:
+                maxError = bfpMaxError(blockSamples, 8);
+                break;
+            case RemoteCodec::CodecBFP10:
+                maxError = bfpMaxError(blockSamples, 10);
+                break;
+            case RemoteCodec::CodecBFP12:
+                maxError = bfpMaxError(blockSamples, 12);
+                break;
+            case RemoteCodec::CodecNearLosslessRice:
+                maxError = droppedLSBs == 0 ? 0 : 1LL << block.buf[1]; // buf[1] is the shift
+                nbLossyBlocks += droppedLSBs == 0 ? 0 : 1;
+                break;
+            default:
+                maxError = 0;
+                break;
+            }
+
+            if (codec != RemoteCodec::CodecNearLosslessRice) {
+                check(droppedLSBs == 0, name + ": dropped bits reported");
+            }
+
+            int64_t error = 0;
+
+            for (unsigned int i = 0; i < 2*nbSamples; i++) {
+                error = std::max(error, (int64_t) std::abs((int64_t) decoded[i] - (int64_t) samples[i]));
+            }
+
+            check(error <= maxError, QString("%1: block %2 error %3 above %4").arg(name).arg(b).arg(error).arg(maxError));
+
+            if (codec != RemoteCodec::CodecRaw)
+            {
+                RemoteCodec::Codec otherCodec = codec == RemoteCodec::CodecBFP8 ? RemoteCodec::CodecBFP12 : RemoteCodec::CodecBFP8;
+                check(!RemoteCodec::decode(otherCodec, block, sampleBytes, decoded.data()), name + ": block of another codec rejected");
+            }
+        }
+
+        if (codec == RemoteCodec::CodecNearLosslessRice)
+        {
+            // 12 bits signals fit in the block. Full scale noise does not
+            if (amplitudeBits <= 12) {
+                check(nbLossyBlocks == 0, name + ": lossless for small signals");
+            } else {
+                check(nbLossyBlocks != 0, name + ": bits dropped for large signals");
+            }
+        }
+    }
+}
+
+void MainBench::testRemoteCodec()
+{
+    qDebug() << "MainBench::testRemoteCodec: round trips";
+
+    testRemoteCodecBlocks<int16_t>(12, "12 bits");
+    testRemoteCodecBlocks<int16_t>(16, "16 bits");
+    testRemoteCodecBlocks<int32_t>(12, "12 bits");
+    testRemoteCodecBlocks<int32_t>(24, "24 bits");
+
+    qDebug() << "MainBench::testRemoteCodec: run timing";
+
+    const unsigned int sampleBytes = SDR_RX_SAMP_SZ <= 16 ? 2 : 4;
+    std::vector<Sample> samples(RemoteCodec::m_maxNbSamplesPerBlock);
+    std::vector<Sample> decoded(RemoteCodec::m_maxNbSamplesPerBlock);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+    RemoteProtectedBlock block;
+
+    for (auto& sample : samples)
+    {
+        sample.m_real = my_rand();
+        sample.m_imag = my_rand();
+    }
+
+    for (int codecIndex = 1; codecIndex < RemoteCodec::CodecEnd; codecIndex++)
+    {
+        RemoteCodec::Codec codec = (RemoteCodec::Codec) codecIndex;
+        unsigned int nbSamples = RemoteCodec::getNbSamplesPerBlock(codec, sampleBytes);
+        uint32_t nbBlocks = m_parser.getNbSamples() / nbSamples;
+        QElapsedTimer timer;
+        qint64 encodeNsecs = 0;
+        qint64 decodeNsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+
+            for (uint32_t b = 0; b < nbBlocks; b++) {
+                RemoteCodec::encode(codec, samples.data(), sampleBytes, block);
+            }
+
+            encodeNsecs += timer.nsecsElapsed();
+            timer.start();
+
+            for (uint32_t b = 0; b < nbBlocks; b++) {
+                RemoteCodec::decode(codec, block, sampleBytes, decoded.data());
+            }
+
+            decodeNsecs += timer.nsecsElapsed();
+        }
+
+        qint64 nbProcessed = (qint64) nbBlocks * nbSamples * m_parser.getRepetition();
+        QDebug info = qInfo();
+        info.noquote();
+        info << tr("MainBench::testRemoteCodec: %1: %L2 samples - encode %3 MS/s - decode %4 MS/s")
+            .arg(codecName(codec))
+            .arg(nbProcessed)
+            .arg(encodeNsecs == 0 ? 0.0 : (nbProcessed * 1000.0) / encodeNsecs)
+            .arg(decodeNsecs == 0 ? 0.0 : (nbProcessed * 1000.0) / decodeNsecs);
+    }
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testRemoteCodec: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
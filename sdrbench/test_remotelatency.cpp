@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include <QDebug>
+
+#include "channel/remotelatencycontrol.h"
+
+#include "mainbench.h"
+
+namespace {
+
+const double frameInterval = 0.05; // s
+const float frameMs = 50.0f;
+
+struct LatencySimulation
+{
+    double m_latencyMs;    //!< buffered duration
+    double m_maxErrorMs;   //!< largest distance to the target in the last quarter of the run
+    double m_maxCorrection;
+    int m_nbResyncs;
+};
+
+// frames from a sender whose clock runs clockOffset slower than the reader's
+LatencySimulation simulateLatency(RemoteLatencyControl& control, double clockOffset, double seconds)
+{
+    LatencySimulation simulation{0.0, 0.0, 0.0, 0};
+    int nbFrames = seconds / frameInterval;
+
+    for (int i = 0; i < nbFrames; i++)
+    {
+        if (control.update(frameInterval, simulation.m_latencyMs, frameMs))
+        {
+            simulation.m_latencyMs = control.getEffectiveTargetMs();
+            control.resynced(simulation.m_latencyMs);
+            simulation.m_nbResyncs++;
+        }
+
+        double readRate = (1.0 + clockOffset) * (1.0 + control.getRateCorrection());
+        simulation.m_latencyMs += 1000.0 * frameInterval * (1.0 - readRate);
+        simulation.m_maxCorrection = std::max(simulation.m_maxCorrection, std::abs(control.getRateCorrection()));
+
+        if (i > (3 * nbFrames) / 4) {
+            simulation.m_maxErrorMs = std::max(simulation.m_maxErrorMs, std::abs(simulation.m_latencyMs - control.getEffectiveTargetMs()));
+        }
+    }
+
+    return simulation;
+}
+
+} // namespace
+
+void MainBench::testRemoteLatency()
+{
+    qDebug() << "MainBench::testRemoteLatency: no target";
+
+    RemoteLatencyControl control;
+    check(!control.update(frameInterval, 123.0f, frameMs), "RemoteLatency: no resync without target");
+    check(control.getLatencyMs() == 123.0f, "RemoteLatency: latency reported as measured without target");
+    check(control.getRateCorrection() == 0.0, "RemoteLatency: no correction without target");
+
+    qDebug() << "MainBench::testRemoteLatency: clock offsets";
+
+    const double offsets[] = {0.0, 500e-6, -500e-6, 1200e-6};
+
+    for (double offset : offsets)
+    {
+        control.setTargetLatency(200);
+        LatencySimulation simulation = simulateLatency(control, offset, 2000.0);
+        QString name = QString("RemoteLatency: %1 ppm").arg(offset * 1e6);
+        check(simulation.m_nbResyncs == 1, QString("%1: %2 resyncs").arg(name).arg(simulation.m_nbResyncs));
+        check(control.getEffectiveTargetMs() == 200.0f, name + ": effective target");
+        check(simulation.m_maxErrorMs < 1.0, QString("%1: latency error %2 ms").arg(name).arg(simulation.m_maxErrorMs));
+        // the corrected read rate matches the sender clock
+        check(std::abs((1.0 + offset) * (1.0 + control.getRateCorrection()) - 1.0) < 1e-6,
+            QString("%1: correction %2 ppm").arg(name).arg(control.getRateCorrection() * 1e6));
+    }
+
+    // beyond the correction range the buffer runs dry and is resynced
+    control.setTargetLatency(200);
+    LatencySimulation simulation = simulateLatency(control, 5000e-6, 300.0);
+    check(simulation.m_maxCorrection <= RemoteLatencyControl::m_maxRateCorrection, "RemoteLatency: correction limit");
+    check(simulation.m_nbResyncs > 1, "RemoteLatency: resync on underrun");
+
+    control.setTargetLatency(200);
+    check(control.update(frameInterval, 0.0f, frameMs), "RemoteLatency: resync on target change");
+    control.resynced(200.0f);
+    check(!control.update(frameInterval, 440.0f, frameMs), "RemoteLatency: no resync within twice the target");
+    check(control.update(frameInterval, 460.0f, frameMs), "RemoteLatency: resync far above the target");
+    check(control.update(frameInterval, -1.0f, frameMs), "RemoteLatency: resync on underrun");
+    control.resynced(200.0f);
+    control.restart();
+    check(control.getRateCorrection() == 0.0, "RemoteLatency: correction reset on restart");
+    check(control.update(frameInterval, 200.0f, frameMs), "RemoteLatency: resync on restart");
+
+    qDebug() << "MainBench::testRemoteLatency: jitter";
+
+    control.setTargetLatency(20); // below what the frame size allows
+    control.update(frameInterval, 0.0f, frameMs);
+    check(control.getEffectiveTargetMs() == frameMs + RemoteLatencyControl::m_readPeriodMs, "RemoteLatency: target raised to frame and read period");
+
+    for (int i = 0; i < 400; i++) // transit alternating by 2 ms
+    {
+        control.updateJitter(1000000 + ((i % 2) == 0 ? 1000 : -1000));
+        control.update(frameInterval, 100.0f, frameMs);
+    }
+
+    check(std::abs(control.getJitterMs() - 2.0f) < 0.01f, QString("RemoteLatency: jitter %1 ms").arg(control.getJitterMs()));
+    float jitterTarget = frameMs + RemoteLatencyControl::m_readPeriodMs + 6.0f * 2.0f;
+    check(std::abs(control.getEffectiveTargetMs() - jitterTarget) < 0.1f, QString("RemoteLatency: target %1 ms with jitter").arg(control.getEffectiveTargetMs()));
+
+    for (int i = 0; i < 30; i++) // steady transit: jitter falls quickly, its peak slowly
+    {
+        control.updateJitter(1000000);
+        control.update(frameInterval, 100.0f, frameMs);
+    }
+
+    check(control.getJitterMs() < 0.5f, "RemoteLatency: jitter decay");
+    check(control.getEffectiveTargetMs() > jitterTarget - 1.0f, "RemoteLatency: jitter peak held");
+
+    for (int i = 0; i < 6000; i++)
+    {
+        control.updateJitter(1000000);
+        control.update(frameInterval, 100.0f, frameMs);
+    }
+
+    check(control.getEffectiveTargetMs() < frameMs + RemoteLatencyControl::m_readPeriodMs + 0.5f, "RemoteLatency: jitter peak decay");
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testRemoteLatency: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
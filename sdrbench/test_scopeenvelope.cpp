@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "dsp/scopeenvelope.h"
+
+#include "mainbench.h"
+
+bool MainBench::checkScopeEnvelopeLevels(const ScopeEnvelope& envelope, const std::vector<float>& trace, uint32_t nbSamples, const QString& name)
+{
+    bool ok = true;
+
+    for (int level = 0; ok && (level < envelope.getNbLevels()); level++)
+    {
+        uint32_t binSize = envelope.getLevelBinSize(level);
+        uint32_t nbBins = envelope.getLevelNbFilledBins(level);
+        const float *bins = envelope.getLevel(level);
+        ok = ok && check(nbBins * binSize <= nbSamples + binSize - 1, QString("%1: level %2 has %3 bins").arg(name).arg(level).arg(nbBins));
+
+        for (uint32_t bin = 0; ok && (bin < nbBins); bin++)
+        {
+            auto first = trace.begin() + bin * binSize;
+            auto last = trace.begin() + std::min(nbSamples, (bin + 1) * binSize);
+            auto minMax = std::minmax_element(first, last);
+            ok = check((bins[2*bin] == *minMax.first) && (bins[2*bin+1] == *minMax.second),
+                QString("%1: level %2 bin %3 min max").arg(name).arg(level).arg(bin));
+        }
+    }
+
+    return ok;
+}
+
+void MainBench::testScopeEnvelope()
+{
+    qDebug() << "MainBench::testScopeEnvelope: short trace";
+
+    ScopeEnvelope envelope;
+    uint32_t traceSize = ScopeEnvelope::m_maxBins;
+    envelope.resize(traceSize);
+    check(ScopeEnvelope::getBinSize(traceSize) == 1, "ScopeEnvelope: short trace not decimated");
+    check(envelope.getNbLevels() == 0, "ScopeEnvelope: short trace has no levels");
+    check(envelope.feed(1.0f) && envelope.feed(2.0f), "ScopeEnvelope: every sample starts a bin of a short trace");
+
+    qDebug() << "MainBench::testScopeEnvelope: long trace";
+
+    // odd bin counts at several levels and a partial last bin
+    traceSize = 3 * ScopeEnvelope::m_maxBins + 12345;
+    std::vector<float> trace(traceSize);
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (auto& v : trace) {
+        v = my_rand();
+    }
+
+    envelope.resize(traceSize);
+    uint32_t binSize = ScopeEnvelope::getBinSize(traceSize);
+    uint32_t nbBins = ScopeEnvelope::getNbBins(traceSize);
+    check(binSize == 4, QString("ScopeEnvelope: %1 samples per bin").arg(binSize));
+    check(nbBins <= ScopeEnvelope::m_maxBins, QString("ScopeEnvelope: %1 bins").arg(nbBins));
+    check(envelope.getNbLevels() > 1, "ScopeEnvelope: levels");
+    check(envelope.getLevelNbFilledBins(envelope.getNbLevels() - 1) <= ScopeEnvelope::m_minBins, "ScopeEnvelope: top level size");
+
+    uint32_t nbBinStarts = 0;
+    uint32_t half = traceSize / 2 + 3; // inside a bin
+
+    for (uint32_t i = 0; i < half; i++) {
+        nbBinStarts += envelope.feed(trace[i]) ? 1 : 0;
+    }
+
+    check(envelope.getNbFilledBins() == half / binSize, "ScopeEnvelope: filled bins while feeding");
+    checkScopeEnvelopeLevels(envelope, trace, (half / binSize) * binSize, "ScopeEnvelope: partial trace");
+
+    for (uint32_t i = half; i < traceSize; i++) {
+        nbBinStarts += envelope.feed(trace[i]) ? 1 : 0;
+    }
+
+    envelope.complete();
+    envelope.complete(); // no effect
+    check(nbBinStarts == nbBins, "ScopeEnvelope: samples starting a bin");
+    check(envelope.getNbFilledBins() == nbBins, "ScopeEnvelope: all bins filled");
+    checkScopeEnvelopeLevels(envelope, trace, traceSize, "ScopeEnvelope: complete trace");
+
+    for (int level = 0; level < envelope.getNbLevels(); level++)
+    {
+        float samplesPerPixel = envelope.getLevelBinSize(level) + 0.5f;
+        check(envelope.getLevelForSamplesPerPixel(samplesPerPixel) == level, QString("ScopeEnvelope: level for %1 samples per pixel").arg(samplesPerPixel));
+    }
+
+    check(envelope.getLevelForSamplesPerPixel(0.5f) == 0, "ScopeEnvelope: level when zoomed in");
+
+    qDebug() << "MainBench::testScopeEnvelope: serialization";
+
+    ScopeEnvelope restored;
+    check(restored.deserialize(envelope.serialize()), "ScopeEnvelope: deserialize");
+    check((restored.getTraceSize() == traceSize) && (restored.getNbLevels() == envelope.getNbLevels()), "ScopeEnvelope: restored geometry");
+    check(restored.getNbFilledBins() == nbBins, "ScopeEnvelope: restored bins");
+    checkScopeEnvelopeLevels(restored, trace, traceSize, "ScopeEnvelope: restored trace");
+    check(!restored.deserialize(QByteArray("garbage")), "ScopeEnvelope: invalid data rejected");
+
+    qDebug() << "MainBench::testScopeEnvelope: run timing";
+
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    uint32_t nbSamples = m_parser.getNbSamples() < traceSize ? m_parser.getNbSamples() : traceSize;
+    envelope.resize(nbSamples);
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        envelope.reset();
+        timer.start();
+
+        for (uint32_t s = 0; s < nbSamples; s++) {
+            envelope.feed(trace[s]);
+        }
+
+        envelope.complete();
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testScopeEnvelope", nsecs);
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testScopeEnvelope: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
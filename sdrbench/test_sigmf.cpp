@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include <QDebug>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "dsp/sigmf.h"
+
+#include "mainbench.h"
+
+void MainBench::testSigMF()
+{
+    QTemporaryDir dir;
+
+    if (!check(dir.isValid(), "SigMF: temporary directory")) {
+        return;
+    }
+
+    qDebug() << "MainBench::testSigMF: meta round trip";
+
+    SigMF::Meta meta;
+    meta.m_dataType = SigMF::DataTypeCI32;
+    meta.m_sampleBits = 24;
+    meta.m_sampleRate = 48000.0;
+    meta.m_description = "bench";
+    meta.m_recorder = "SDRangel";
+    meta.m_hw = "TestSource";
+    meta.m_captures.resize(2);
+    meta.m_captures[0].m_sampleStart = 0;
+    meta.m_captures[0].m_frequency = 433920000LL;
+    meta.m_captures[0].m_dateTime = 1600000000000LL;
+    meta.m_captures[1].m_sampleStart = 48000;
+    meta.m_captures[1].m_frequency = 5800000000LL; // above 32 bits
+    meta.m_captures[1].m_dateTime = 1600000010000LL; // 9 s gap after the first segment
+    meta.m_annotations.resize(1);
+    meta.m_annotations[0].m_sampleStart = 1000;
+    meta.m_annotations[0].m_sampleCount = 500;
+    meta.m_annotations[0].m_label = "burst";
+
+    QString metaFileName = dir.filePath("roundtrip.sigmf-meta");
+    SigMF::Meta readBack;
+    QString errorMessage;
+    check(SigMF::writeMeta(metaFileName, meta), "SigMF: write meta");
+
+    bool read = SigMF::readMeta(metaFileName, readBack, errorMessage);
+
+    if (check(read, "SigMF: read meta: " + errorMessage))
+    {
+        check(readBack.m_dataType == meta.m_dataType, "SigMF: datatype");
+        check(readBack.m_sampleBits == meta.m_sampleBits, "SigMF: sample size extension");
+        check(readBack.m_sampleRate == meta.m_sampleRate, "SigMF: sample rate");
+        check(readBack.m_description == meta.m_description, "SigMF: description");
+        check(readBack.m_recorder == meta.m_recorder, "SigMF: recorder");
+        check(readBack.m_hw == meta.m_hw, "SigMF: hw");
+        check(readBack.m_captures.size() == meta.m_captures.size(), "SigMF: captures");
+        check(readBack.m_annotations.size() == meta.m_annotations.size(), "SigMF: annotations");
+
+        for (unsigned int i = 0; i < std::min(readBack.m_captures.size(), meta.m_captures.size()); i++)
+        {
+            check(readBack.m_captures[i].m_sampleStart == meta.m_captures[i].m_sampleStart, QString("SigMF: capture %1 sample start").arg(i));
+            check(readBack.m_captures[i].m_frequency == meta.m_captures[i].m_frequency, QString("SigMF: capture %1 frequency").arg(i));
+            check(readBack.m_captures[i].m_dateTime == meta.m_captures[i].m_dateTime, QString("SigMF: capture %1 datetime").arg(i));
+        }
+
+        if (!readBack.m_annotations.empty())
+        {
+            check(readBack.m_annotations[0].m_sampleStart == 1000, "SigMF: annotation sample start");
+            check(readBack.m_annotations[0].m_sampleCount == 500, "SigMF: annotation sample count");
+            check(readBack.m_annotations[0].m_label == "burst", "SigMF: annotation label");
+        }
+    }
+
+    qDebug() << "MainBench::testSigMF: foreign meta";
+
+    // as written by other tools: unordered captures, sub millisecond time, no extension
+    QFile foreignFile(dir.filePath("foreign.sigmf-meta"));
+    foreignFile.open(QIODevice::WriteOnly);
+    foreignFile.write(
+        "{\"global\": {\"core:datatype\": \"cu8\", \"core:sample_rate\": 2048000, \"core:version\": \"1.0.0\"},"
+        " \"captures\": ["
+        "  {\"core:sample_start\": 2048000, \"core:frequency\": 100000000, \"core:datetime\": \"2020-09-13T12:26:41.123456Z\"},"
+        "  {\"core:sample_start\": 0, \"core:frequency\": 100000000, \"core:datetime\": \"2020-09-13T12:26:40.000Z\"}"
+        " ],"
+        " \"annotations\": []}"
+    );
+    foreignFile.close();
+
+    read = SigMF::readMeta(foreignFile.fileName(), readBack, errorMessage);
+
+    if (check(read, "SigMF: read foreign meta: " + errorMessage))
+    {
+        check(readBack.m_dataType == SigMF::DataTypeCU8, "SigMF: foreign datatype");
+        check(readBack.m_sampleBits == 8, "SigMF: foreign sample size from the type");
+        check((readBack.m_captures.size() == 2) && (readBack.m_captures[0].m_sampleStart == 0), "SigMF: captures sorted");
+        check((readBack.m_captures.size() == 2) && (readBack.m_captures[1].m_dateTime == 1600000001123LL), "SigMF: sub millisecond time truncated");
+    }
+
+    QFile badFile(dir.filePath("bad.sigmf-meta"));
+    badFile.open(QIODevice::WriteOnly);
+    badFile.write("{\"global\": {\"core:datatype\": \"ri16_le\", \"core:sample_rate\": 1000}}");
+    badFile.close();
+    check(!SigMF::readMeta(badFile.fileName(), readBack, errorMessage), "SigMF: real datatype rejected");
+    badFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    badFile.write("{\"global\": ");
+    badFile.close();
+    check(!SigMF::readMeta(badFile.fileName(), readBack, errorMessage), "SigMF: truncated JSON rejected");
+    check(!SigMF::readMeta(dir.filePath("missing.sigmf-meta"), readBack, errorMessage), "SigMF: missing file rejected");
+
+    qDebug() << "MainBench::testSigMF: time and sample index";
+
+    check(SigMF::getCapture(meta, 47999) == &meta.m_captures[0], "SigMF: capture of the last sample of a segment");
+    check(SigMF::getCapture(meta, 48000) == &meta.m_captures[1], "SigMF: capture of the first sample of a segment");
+    check(SigMF::getDateTime(meta, 24000) == 1600000000500LL, "SigMF: time in the first segment");
+    check(SigMF::getDateTime(meta, 48000 + 4800) == 1600000010100LL, "SigMF: time in the second segment");
+    check(SigMF::getSampleIndex(meta, 1600000000500LL) == 24000, "SigMF: sample index in the first segment");
+    check(SigMF::getSampleIndex(meta, 1600000005000LL) == 48000, "SigMF: sample index in a gap");
+    check(SigMF::getSampleIndex(meta, 1599999999000LL) == 0, "SigMF: sample index before the recording");
+    check(SigMF::parseDateTime(SigMF::formatDateTime(1600000000123LL)) == 1600000000123LL, "SigMF: datetime format round trip");
+    check(SigMF::parseDateTime("not a date") == -1, "SigMF: invalid datetime");
+
+    qDebug() << "MainBench::testSigMF: sample conversion";
+
+    // long enough for the vectorized loops and their scalar tails
+    const unsigned int nbSamples = 37;
+    std::vector<qint8> ci8(2*nbSamples);
+    std::vector<qint16> ci16(2*nbSamples);
+    std::vector<qint32> ci32(2*nbSamples);
+    std::vector<float> cf32(2*nbSamples);
+    std::vector<Sample> out(nbSamples);
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++)
+    {
+        ci8[i] = (qint8) (i * 7 - 128);
+        ci16[i] = (qint16) (i * 887 - 32768);
+        ci32[i] = (qint32) (i * 226700) - (1 << 23); // 24 bits
+        cf32[i] = (i * 0.03f) - 1.1f; // overflows on both sides
+    }
+
+    cf32[3] = NAN; // vectorized
+    cf32[2*nbSamples-1] = NAN; // scalar
+
+    auto component = [&](unsigned int i) -> qint64 {
+        return (i % 2) == 0 ? out[i/2].m_real : out[i/2].m_imag;
+    };
+
+    bool ok = true;
+    SigMF::convert(SigMF::DataTypeCI8, 8, (const char *) ci8.data(), nbSamples, out.data());
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++) {
+        ok = ok && (component(i) == ((qint64) ci8[i] << (SDR_RX_SAMP_SZ - 8)));
+    }
+
+    check(ok, "SigMF: ci8 conversion");
+    ok = true;
+    SigMF::convert(SigMF::DataTypeCU8, 8, (const char *) ci8.data(), nbSamples, out.data());
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++) {
+        ok = ok && (component(i) == ((qint64) ((quint8) ci8[i]) - 128) << (SDR_RX_SAMP_SZ - 8));
+    }
+
+    check(ok, "SigMF: cu8 conversion");
+    ok = true;
+    SigMF::convert(SigMF::DataTypeCI16, 16, (const char *) ci16.data(), nbSamples, out.data());
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++) {
+        ok = ok && (component(i) == ((qint64) ci16[i] << (SDR_RX_SAMP_SZ - 16)));
+    }
+
+    check(ok, "SigMF: ci16 conversion");
+    ok = true;
+    SigMF::convert(SigMF::DataTypeCI32, 24, (const char *) ci32.data(), nbSamples, out.data());
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++) {
+        ok = ok && (component(i) == ((qint64) ci32[i] >> (24 - SDR_RX_SAMP_SZ)));
+    }
+
+    check(ok, "SigMF: ci32 conversion");
+    ok = true;
+    SigMF::convert(SigMF::DataTypeCF32, 32, (const char *) cf32.data(), nbSamples, out.data());
+
+    for (unsigned int i = 0; i < 2*nbSamples; i++)
+    {
+        float v = cf32[i] * SDR_RX_SCALEF;
+        v = std::isnan(v) || (v < -SDR_RX_SCALEF) ? -SDR_RX_SCALEF : v > SDR_RX_SCALEF - 1.0f ? SDR_RX_SCALEF - 1.0f : v;
+        ok = ok && (component(i) == std::lrint(v));
+    }
+
+    check(ok, "SigMF: cf32 conversion with clipping");
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testSigMF: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include "dsp/spectrumactivity.h"
+
+#include "mainbench.h"
+
+void MainBench::testSpectrumActivity()
+{
+    // largest spectrum produced by SpectrumVis
+    const int fftSize = 4096;
+    const int sampleRate = 2048000;
+    const qint64 centerFrequency = 433920000;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    qDebug() << "MainBench::testSpectrumActivity: create test data";
+
+    // noise floor around -100 dB with a few carriers of various widths
+    std::vector<Real> spectrum(fftSize);
+    auto my_rand = std::bind(m_uniform_distribution_f, m_generator);
+
+    for (int i = 0; i < fftSize; i++) {
+        spectrum[i] = -100.0f + 3.0f * my_rand();
+    }
+
+    for (int s = 0; s < 32; s++)
+    {
+        int start = (s * fftSize) / 32 + 16;
+        int width = 1 + (s % 8) * 4;
+
+        for (int i = start; i < start + width; i++) {
+            spectrum[i] = -60.0f + 3.0f * my_rand();
+        }
+    }
+
+    SpectrumActivity spectrumActivity;
+    SpectrumActivity::Settings settings;
+    settings.m_enable = true;
+    spectrumActivity.applySettings(settings);
+    uint32_t nbFrames = m_parser.getNbSamples() / fftSize;
+
+    qDebug() << "MainBench::testSpectrumActivity: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (uint32_t f = 0; f < nbFrames; f++) {
+            spectrumActivity.newFrame(spectrum, fftSize, centerFrequency, sampleRate, false);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    std::vector<SpectrumActivity::Signal> activeSignals;
+    spectrumActivity.getSignals(activeSignals);
+    qint64 nbProcessed = (qint64) nbFrames * m_parser.getRepetition();
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testSpectrumActivity: %L1 frames of %2 bins in %L3 ns - %4 us per frame - %5 signals")
+        .arg(nbProcessed)
+        .arg(fftSize)
+        .arg(nsecs)
+        .arg(nbProcessed == 0 ? 0.0 : nsecs / (nbProcessed * 1000.0))
+        .arg(activeSignals.size());
+}
@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#include <QDebug>
+#include <QTemporaryDir>
+
+#include "dsp/spectrumhistory.h"
+
+#include "mainbench.h"
+
+namespace {
+
+// stored byte of a power in dB
+uchar historyByte(float db)
+{
+    float q = (db - SpectrumHistory::m_floorDb) / SpectrumHistory::m_stepDb + 0.5f;
+    return q < 1.0f ? 0 : q > 255.0f ? 255 : (uchar) q;
+}
+
+// power in dB of bin b of frame f
+float historyPower(unsigned int f, unsigned int b)
+{
+    return -120.0f + ((b * 7 + f) % 64);
+}
+
+struct HistoryResult
+{
+    int m_status;
+    QByteArray m_data;
+    SpectrumHistory::QueryHeader m_header;
+
+    unsigned int rowSize() const { return (sizeof(SpectrumHistory::RecordHeader) + m_header.m_columns + 7) & ~7U; }
+
+    const uchar *row(unsigned int r) const {
+        return (const uchar *) m_data.constData() + sizeof(SpectrumHistory::QueryHeader) + r * rowSize();
+    }
+
+    qint64 timestamp(unsigned int r) const
+    {
+        qint64 timestampMs;
+        std::memcpy(&timestampMs, row(r), sizeof(qint64));
+        return timestampMs;
+    }
+
+    quint32 sequence(unsigned int r) const // frame index + 1 or number of frames of a decimated row
+    {
+        quint32 sequence;
+        std::memcpy(&sequence, row(r) + 20, sizeof(quint32));
+        return sequence;
+    }
+
+    const uchar *cells(unsigned int r) const { return row(r) + sizeof(SpectrumHistory::RecordHeader); }
+};
+
+HistoryResult queryHistory(const SpectrumHistory& history, const SpectrumHistory::Query& query)
+{
+    HistoryResult result;
+    QString errorMessage;
+    result.m_status = history.query(query, [&](const QByteArray& data) { result.m_data.append(data); }, errorMessage);
+    std::memset(&result.m_header, 0, sizeof(result.m_header));
+
+    if (result.m_data.size() >= (int) sizeof(SpectrumHistory::QueryHeader)) {
+        std::memcpy(&result.m_header, result.m_data.constData(), sizeof(SpectrumHistory::QueryHeader));
+    }
+
+    return result;
+}
+
+} // namespace
+
+void MainBench::testSpectrumHistory()
+{
+    const unsigned int nbBins = 64;
+    const unsigned int capacity = 32;
+    const unsigned int usable = capacity - capacity / 8; // guard zone
+    const unsigned int nbFrames = 40; // wraps around
+    const qint64 centerFrequency = 100000000;
+    const int sampleRate = 65536; // 1024 Hz per bin: exact bin boundaries
+    QTemporaryDir dir;
+
+    if (!check(dir.isValid(), "SpectrumHistory: temporary directory")) {
+        return;
+    }
+
+    QString fileName = dir.filePath("history.bin");
+    SpectrumHistory history;
+    SpectrumHistory::Query query;
+
+    check(queryHistory(history, query).m_status == 404, "SpectrumHistory: query when disabled");
+    check(!history.open(fileName, 0, capacity), "SpectrumHistory: no bins rejected");
+
+    if (!check(history.open(fileName, nbBins, capacity), "SpectrumHistory: open")) {
+        return;
+    }
+
+    check(queryHistory(history, query).m_status == 404, "SpectrumHistory: query when empty");
+
+    qDebug() << "MainBench::testSpectrumHistory: one record per frame";
+
+    std::vector<Real> spectrum(nbBins);
+    history.setFrameInterval(0);
+
+    for (unsigned int f = 0; f < nbFrames; f++)
+    {
+        for (unsigned int b = 0; b < nbBins; b++) {
+            spectrum[b] = historyPower(f, b);
+        }
+
+        history.newFrame(spectrum, nbBins, centerFrequency, sampleRate, false);
+    }
+
+    HistoryResult native = queryHistory(history, query);
+
+    if (check(native.m_status == 200, "SpectrumHistory: native query"))
+    {
+        check(std::memcmp(native.m_header.m_magic, "SDRH", 4) == 0, "SpectrumHistory: magic");
+        check(native.m_header.m_rows == usable, QString("SpectrumHistory: %1 rows in the valid range").arg(native.m_header.m_rows));
+        check(native.m_header.m_columns == nbBins, "SpectrumHistory: native columns");
+        check(native.m_data.size() == (int) (sizeof(SpectrumHistory::QueryHeader) + native.m_header.m_rows * native.rowSize()), "SpectrumHistory: native size");
+        bool ok = native.m_data.size() == (int) (sizeof(SpectrumHistory::QueryHeader) + usable * native.rowSize());
+
+        for (unsigned int r = 0; ok && (r < usable); r++)
+        {
+            unsigned int f = nbFrames - usable + r;
+            ok = ok && (native.sequence(r) == f + 1);
+            ok = ok && ((r == 0) || (native.timestamp(r) >= native.timestamp(r - 1)));
+
+            for (unsigned int b = 0; b < nbBins; b++) {
+                ok = ok && (native.cells(r)[b] == historyByte(historyPower(f, b)));
+            }
+        }
+
+        check(ok, "SpectrumHistory: native rows are the newest frames in order");
+    }
+
+    qDebug() << "MainBench::testSpectrumHistory: decimation";
+
+    query.m_frequencyBins = nbBins / 4;
+    HistoryResult decimated = queryHistory(history, query);
+    query.m_mode = SpectrumHistory::DecimationMean;
+    HistoryResult mean = queryHistory(history, query);
+
+    if (check((decimated.m_status == 200) && (mean.m_status == 200), "SpectrumHistory: decimated query"))
+    {
+        bool ok = (decimated.m_header.m_rows == usable) && (decimated.m_header.m_columns == nbBins / 4);
+        bool meanOk = ok;
+
+        for (unsigned int r = 0; ok && (r < usable); r++)
+        {
+            unsigned int f = nbFrames - usable + r;
+            ok = ok && (decimated.sequence(r) == 1);
+
+            for (unsigned int j = 0; j < nbBins / 4; j++)
+            {
+                unsigned int max = 0, sum = 0;
+
+                for (unsigned int b = 4*j; b < 4*j + 4; b++)
+                {
+                    max = std::max(max, (unsigned int) historyByte(historyPower(f, b)));
+                    sum += historyByte(historyPower(f, b));
+                }
+
+                ok = ok && (decimated.cells(r)[j] == max);
+                meanOk = meanOk && (mean.cells(r)[j] == (sum + 2) / 4);
+            }
+        }
+
+        check(ok, "SpectrumHistory: max decimation over frequency");
+        check(meanOk, "SpectrumHistory: mean decimation over frequency");
+    }
+
+    query = SpectrumHistory::Query();
+    query.m_timeBins = 4;
+    HistoryResult timeDecimated = queryHistory(history, query);
+
+    if (check(timeDecimated.m_status == 200, "SpectrumHistory: time decimated query"))
+    {
+        quint32 nbAggregated = 0;
+        bool ok = timeDecimated.m_header.m_rows == 4;
+
+        for (unsigned int r = 0; ok && (r < 4); r++) {
+            nbAggregated += timeDecimated.sequence(r);
+        }
+
+        check(ok && (nbAggregated == usable), QString("SpectrumHistory: %1 frames aggregated in time rows").arg(nbAggregated));
+    }
+
+    // lower half of the span at native resolution then outside of the span
+    query = SpectrumHistory::Query();
+    query.m_startFrequency = centerFrequency - sampleRate / 2;
+    query.m_stopFrequency = centerFrequency;
+    query.m_frequencyBins = nbBins / 2;
+    HistoryResult window = queryHistory(history, query);
+    query.m_startFrequency = centerFrequency + sampleRate;
+    query.m_stopFrequency = centerFrequency + 2 * sampleRate;
+    HistoryResult outside = queryHistory(history, query);
+
+    if (check((window.m_status == 200) && (outside.m_status == 200), "SpectrumHistory: frequency window query"))
+    {
+        bool ok = window.m_header.m_rows == usable;
+        bool outsideOk = outside.m_header.m_rows == usable;
+
+        for (unsigned int r = 0; ok && outsideOk && (r < usable); r++)
+        {
+            unsigned int f = nbFrames - usable + r;
+
+            for (unsigned int j = 0; j < nbBins / 2; j++)
+            {
+                ok = ok && (window.cells(r)[j] == historyByte(historyPower(f, j)));
+                outsideOk = outsideOk && (outside.cells(r)[j] == 0);
+            }
+        }
+
+        check(ok, "SpectrumHistory: frequency window");
+        check(outsideOk, "SpectrumHistory: window outside of the frames is empty");
+    }
+
+    query = SpectrumHistory::Query();
+    query.m_startFrequency = centerFrequency;
+    query.m_stopFrequency = centerFrequency;
+    check(queryHistory(history, query).m_status == 400, "SpectrumHistory: empty frequency window rejected");
+    query = SpectrumHistory::Query();
+    query.m_fromMs = native.m_status == 200 ? native.timestamp(0) + 1 : 2;
+    query.m_toMs = query.m_fromMs - 1;
+    check(queryHistory(history, query).m_status == 400, "SpectrumHistory: reversed time window rejected");
+    query = SpectrumHistory::Query();
+    query.m_timeBins = 1 << 20;
+    check(queryHistory(history, query).m_status == 400, "SpectrumHistory: resolution limit");
+
+    qDebug() << "MainBench::testSpectrumHistory: accumulation";
+
+    // FFT twice the stored bins: max hold over time and over bin pairs until the center frequency changes
+    std::vector<Real> largeSpectrum(2 * nbBins);
+    std::vector<uchar> expected(nbBins, 0);
+    history.setFrameInterval(1000000);
+
+    for (unsigned int k = 0; k < 3; k++)
+    {
+        for (unsigned int i = 0; i < 2 * nbBins; i++)
+        {
+            largeSpectrum[i] = -130.0f + ((i + 5 * k) % 50);
+            expected[i / 2] = std::max(expected[i / 2], historyByte(largeSpectrum[i]));
+        }
+
+        history.newFrame(largeSpectrum, 2 * nbBins, centerFrequency, sampleRate, false);
+    }
+
+    history.newFrame(largeSpectrum, 2 * nbBins, centerFrequency + sampleRate, sampleRate, false);
+    query = SpectrumHistory::Query();
+    HistoryResult accumulated = queryHistory(history, query);
+
+    if (check(accumulated.m_status == 200, "SpectrumHistory: query after accumulation"))
+    {
+        unsigned int last = accumulated.m_header.m_rows - 1;
+        bool ok = (accumulated.m_header.m_rows == usable) && (accumulated.sequence(last) == nbFrames + 1);
+        ok = ok && (std::memcmp(accumulated.cells(last), expected.data(), nbBins) == 0);
+        check(ok, "SpectrumHistory: frames accumulated in one record");
+    }
+
+    qDebug() << "MainBench::testSpectrumHistory: reopen";
+
+    history.close();
+    check(!history.isOpen(), "SpectrumHistory: inactive when closed");
+    check(history.open(fileName, nbBins, capacity), "SpectrumHistory: reopen");
+    HistoryResult resumed = queryHistory(history, query);
+    check((resumed.m_status == 200) && (resumed.m_data == accumulated.m_data), "SpectrumHistory: history resumed");
+    check(history.open(fileName, nbBins / 2, capacity), "SpectrumHistory: reopen with other geometry");
+    check(queryHistory(history, query).m_status == 404, "SpectrumHistory: history restarted with other geometry");
+    history.close();
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("MainBench::testSpectrumHistory: %1").arg(getNbFailures() == 0 ? "passed" : "failed");
+}
@@ -21,7 +21,10 @@
 
 #include "gui/glspectrum.h"
 #include "dsp/spectrumvis.h"
+#include "dsp/spectrumactivity.h"
+#include "dsp/spectrumhistory.h"
 #include "gui/glspectrumgui.h"
+#include "gui/spectrumactivitymarkers.h"
 #include "gui/channelwindow.h"
 #include "gui/samplingdevicecontrol.h"
 #include "dsp/dspdevicesourceengine.h"
@@ -49,6 +52,12 @@ DeviceUISet::DeviceUISet(int tabIndex, int deviceType, QTimer& timer)
         m_spectrumVis->setGLSpectrum(m_spectrum);
     }
 
+    m_spectrumActivity = new SpectrumActivity(); // enabled from the web API
+    m_spectrumVis->addFrameSink(m_spectrumActivity);
+    m_spectrumActivityMarkers = new SpectrumActivityMarkers(m_spectrumActivity, m_spectrum, timer);
+    m_spectrumHistory = new SpectrumHistory(); // enabled from the web API
+    m_spectrumVis->addFrameSink(m_spectrumHistory);
+
     m_spectrum->connectTimer(timer);
     m_spectrumGUI = new GLSpectrumGUI;
     m_spectrumGUI->setBuddies(m_spectrumVis, m_spectrum);
@@ -75,7 +84,10 @@ DeviceUISet::~DeviceUISet()
     delete m_samplingDeviceControl;
     delete m_channelWindow;
     delete m_spectrumGUI;
+    delete m_spectrumActivityMarkers;
     delete m_spectrumVis;
+    delete m_spectrumActivity;
+    delete m_spectrumHistory;
     delete m_spectrum;
 }
 
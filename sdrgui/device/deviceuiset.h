@@ -24,6 +24,9 @@
 #include "export.h"
 
 class SpectrumVis;
+class SpectrumActivity;
+class SpectrumActivityMarkers;
+class SpectrumHistory;
 class GLSpectrum;
 class GLSpectrumGUI;
 class ChannelWindow;
@@ -41,6 +44,9 @@ class SDRGUI_API DeviceUISet
 {
 public:
     SpectrumVis *m_spectrumVis;
+    SpectrumActivity *m_spectrumActivity;
+    SpectrumActivityMarkers *m_spectrumActivityMarkers;
+    SpectrumHistory *m_spectrumHistory;
     GLSpectrum *m_spectrum;
     GLSpectrumGUI *m_spectrumGUI;
     ChannelWindow *m_channelWindow;
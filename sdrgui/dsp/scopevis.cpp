@@ -19,6 +19,10 @@
 #include <QDebug>
 #include <QMutexLocker>
 
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
 #include "scopevis.h"
 #include "dsp/dspcommands.h"
 #include "gui/glscope.h"
@@ -38,6 +42,62 @@ MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGOneShot, Message)
 MESSAGE_CLASS_DEFINITION(ScopeVis::MsgScopeVisNGMemoryTrace, Message)
 
 const uint ScopeVis::m_traceChunkDefaultSize = 4800;
+const int ScopeVis::m_projectionBlockSize = 1024;
+
+/** Index of the first value from start which comparison to level is not condition or count if there is none */
+static int findConditionChange(const Real *values, int start, int count, Real level, bool condition)
+{
+    int i = start;
+#if defined(USE_SSE2)
+    const __m128 levels = _mm_set1_ps(level);
+    const int steadyMask = condition ? 0xF : 0;
+
+    for (; i + 4 <= count; i += 4)
+    {
+        if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(&values[i]), levels)) != steadyMask) {
+            break; // the change is in these 4 values
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        if ((values[i] > level) != condition) {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/** Displayable values a*projected + b clamped to [-1, 1] */
+static void scaleBlock(const Real *projected, int count, float a, float b, float *values)
+{
+    int i = 0;
+#if defined(USE_SSE2)
+    const __m128 va = _mm_set1_ps(a);
+    const __m128 vb = _mm_set1_ps(b);
+    const __m128 vmin = _mm_set1_ps(-1.0f);
+    const __m128 vmax = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&projected[i]), va), vb);
+        _mm_storeu_ps(&values[i], _mm_min_ps(_mm_max_ps(v, vmin), vmax));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float v = projected[i]*a + b;
+
+        if (v > 1.0f) {
+            v = 1.0f;
+        } else if (v < -1.0f) {
+            v = -1.0f;
+        }
+
+        values[i] = v;
+    }
+}
 
 
 ScopeVis::ScopeVis(GLScope* glScope) :
@@ -67,10 +127,8 @@ ScopeVis::ScopeVis(GLScope* glScope) :
 {
     setObjectName("ScopeVis");
     m_traceDiscreteMemory.resize(m_traceChunkDefaultSize); // arbitrary
-    m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0]);
-    for (int i = 0; i < (int) Projector::nbProjectionTypes; i++) {
-        m_projectorCache[i] = 0.0;
-    }
+    m_glScope->setTraces(&m_traces.m_tracesData, &m_traces.m_traces[0], &m_traces.m_envelopes[0]);
+    m_traceValues.resize(m_projectionBlockSize);
 }
 
 ScopeVis::~ScopeVis()
@@ -280,6 +338,18 @@ void ScopeVis::processMemoryTrace()
             traceMemoryIndex += m_nbTraceMemories;
         }
 
+        if (m_traces.m_traceDecimation > 1) // decimated traces are stored as envelopes
+        {
+            m_traces.recallEnvelopes(m_traceDiscreteMemory.at(traceMemoryIndex));
+            m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes, m_traces.m_envelopes, m_traces.getNbFilledPoints(), m_traces.m_serial);
+
+            if (m_glScope->getProcessingTraceIndex().load() != (((int) m_traces.currentBufferIndex() + 1) % 2)) {
+                m_traces.switchBuffer();
+            }
+
+            return;
+        }
+
         SampleVector::const_iterator mend = m_traceDiscreteMemory.at(traceMemoryIndex).m_endPoint;
         SampleVector::const_iterator mbegin = mend - m_traceSize;
         SampleVector::const_iterator mbegin_tb = mbegin - m_maxTraceDelay;
@@ -350,30 +420,34 @@ void ScopeVis::processTrace(const SampleVector::const_iterator& cbegin, const Sa
                 }
             }
 
-            if (m_triggerComparator.triggered(*begin, *triggerCondition)) // matched the current trigger
+            begin += m_triggerComparator.triggered(&(*begin), end - begin, *triggerCondition);
+
+            if (begin == end) { // no trigger in the rest of the buffer
+                break;
+            }
+
+            // matched the current trigger
+            if (triggerCondition->m_triggerData.m_triggerDelay > 0)
             {
-                if (triggerCondition->m_triggerData.m_triggerDelay > 0)
-                {
-                    triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
-                    m_triggerState = TriggerDelay;
-                    ++begin;
-                    continue;
-                }
+                triggerCondition->m_triggerDelayCount = triggerCondition->m_triggerData.m_triggerDelay; // initialize delayed samples counter
+                m_triggerState = TriggerDelay;
+                ++begin;
+                continue;
+            }
 
-                if (nextTrigger()) // move to next trigger and keep going
-                {
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerUntriggered;
-                }
-                else // this was the last trigger then start trace
-                {
-                    m_traceStart = true; // start of trace processing
-                    m_nbSamples = m_traceSize + m_maxTraceDelay;
-                    m_triggerComparator.reset();
-                    m_triggerState = TriggerTriggered;
-                    triggerPointToEnd = end - begin;
-                    break;
-                }
+            if (nextTrigger()) // move to next trigger and keep going
+            {
+                m_triggerComparator.reset();
+                m_triggerState = TriggerUntriggered;
+            }
+            else // this was the last trigger then start trace
+            {
+                m_traceStart = true; // start of trace processing
+                m_nbSamples = m_traceSize + m_maxTraceDelay;
+                m_triggerComparator.reset();
+                m_triggerState = TriggerTriggered;
+                triggerPointToEnd = end - begin;
+                break;
             }
 
             ++begin;
@@ -483,154 +557,314 @@ bool ScopeVis::nextTrigger()
 
 int ScopeVis::processTraces(const SampleVector::const_iterator& cbegin, const SampleVector::const_iterator& end, bool traceBack)
 {
-    SampleVector::const_iterator begin(cbegin);
     uint32_t shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
     uint32_t length = m_traceSize / m_timeBase;
+    int nbSamples = end - cbegin;
+    int count = m_nbSamples > 0 ? std::min(nbSamples, m_nbSamples) : 0; // samples to process in the range
 
-    while ((begin < end) && (m_nbSamples > 0))
+    for (int blockStart = 0; blockStart < count; blockStart += m_projectionBlockSize)
     {
-        std::vector<TraceControl*>::iterator itCtl = m_traces.m_tracesControl.begin();
-        std::vector<TraceData>::iterator itData = m_traces.m_tracesData.begin();
-        std::vector<float *>::iterator itTrace = m_traces.m_traces[m_traces.currentBufferIndex()].begin();
+        int blockCount = std::min(count - blockStart, m_projectionBlockSize);
+        processTracesBlock(&(*(cbegin + blockStart)), blockCount, nbSamples - blockStart, traceBack, shift, length);
+        m_nbSamples -= blockCount;
+    }
+
+    SampleVector::const_iterator begin = cbegin + count;
+
+    float traceTime = ((float) m_traceSize) / m_sampleRate;
 
-        for (; itCtl != m_traces.m_tracesControl.end(); ++itCtl, ++itData, ++itTrace)
+    if (traceTime >= 1.0f) { // display continuously if trace time is 1 second or more
+        m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes, m_traces.m_envelopes, m_traces.getNbFilledPoints(), m_traces.m_serial);
+    }
+
+    if (m_nbSamples == 0) // finished
+    {
+        if (m_traces.m_traceDecimation > 1)
         {
-            if (traceBack && ((end - begin) > itData->m_traceDelay)) { // before start of trace
-                continue;
+            std::vector<ScopeEnvelope>& envelopes = m_traces.m_envelopes[m_traces.currentBufferIndex()];
+
+            for (std::vector<ScopeEnvelope>::iterator it = envelopes.begin(); it != envelopes.end(); ++it) {
+                it->complete();
             }
 
-            Projector::ProjectionType projectionType = itData->m_projectionType;
+            if (m_currentTraceMemoryIndex == 0) { // live trace is memorized as envelopes
+                m_traces.storeEnvelopes(m_traceDiscreteMemory.current());
+            }
+        }
 
-            if ((*itCtl)->m_traceCount[m_traces.currentBufferIndex()] < m_traceSize)
-            {
-                uint32_t& traceCount = (*itCtl)->m_traceCount[m_traces.currentBufferIndex()]; // reference for code clarity
-                float v;
+        // display only at trace end if trace time is less than 1 second
+        if (traceTime < 1.0f)
+        {
+            if (m_glScope->getProcessingTraceIndex().load() < 0) {
+                m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes, m_traces.m_envelopes, m_traces.getNbFilledPoints(), m_traces.m_serial);
+            }
+        }
 
-                if (projectionType == Projector::ProjectionMagLin)
-                {
-                    v = ((*itCtl)->m_projector.run(*begin) - itData->m_ofs)*itData->m_amp - 1.0f;
-                }
-                else if (projectionType == Projector::ProjectionMagSq)
-                {
-                    Real magsq = (*itCtl)->m_projector.run(*begin);
-                    v = (magsq - itData->m_ofs)*itData->m_amp - 1.0f;
+        // switch to next buffer only if it is not being processed by the scope
+        if (m_glScope->getProcessingTraceIndex().load() != (((int) m_traces.currentBufferIndex() + 1) % 2)) {
+            m_traces.switchBuffer();
+        }
 
-                    if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
-                    {
-                        if (traceCount == shift)
-                        {
-                            (*itCtl)->m_maxPow = 0.0f;
-                            (*itCtl)->m_sumPow = 0.0f;
-                            (*itCtl)->m_nbPow = 1;
-                        }
-
-                        if (magsq > 0.0f)
-                        {
-                            if (magsq > (*itCtl)->m_maxPow)
-                            {
-                                (*itCtl)->m_maxPow = magsq;
-                            }
-
-                            (*itCtl)->m_sumPow += magsq;
-                            (*itCtl)->m_nbPow++;
-                        }
-                    }
+        return end - begin; // return remainder count
+    }
+    else
+    {
+        return -1; // mark not finished
+    }
+}
 
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
-                    {
-                        double avgPow = (*itCtl)->m_sumPow / (*itCtl)->m_nbPow;
-                        itData->m_textOverlay = QString("%1  %2").arg((*itCtl)->m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
-                        (*itCtl)->m_nbPow = 0;
-                    }
-                }
-                else if (projectionType == Projector::ProjectionMagDB)
-                {
-                    Real re = begin->m_real / SDR_RX_SCALEF;
-                    Real im = begin->m_imag / SDR_RX_SCALEF;
-                    double magsq = re*re + im*im;
-                    float pdB = log10f(magsq) * 10.0f;
-                    float p = pdB - (100.0f * itData->m_ofs);
-                    v = ((p/50.0f) + 2.0f)*itData->m_amp - 1.0f;
-
-                    if ((traceCount >= shift) && (traceCount < shift+length)) // power display overlay values construction
-                    {
-                        if (traceCount == shift)
-                        {
-                            (*itCtl)->m_maxPow = 0.0f;
-                            (*itCtl)->m_sumPow = 0.0f;
-                            (*itCtl)->m_nbPow = 1;
-                        }
-
-                        if (magsq > 0.0f)
-                        {
-                            if (magsq > (*itCtl)->m_maxPow)
-                            {
-                                (*itCtl)->m_maxPow = magsq;
-                            }
-
-                            (*itCtl)->m_sumPow += magsq;
-                            (*itCtl)->m_nbPow++;
-                        }
-                    }
+void ScopeVis::processTracesBlock(const Sample *samples, int count, int toEnd, bool traceBack, uint32_t shift, uint32_t length)
+{
+    uint32_t bufferIndex = m_traces.currentBufferIndex();
+    std::vector<TraceControl*>::iterator itCtl = m_traces.m_tracesControl.begin();
+    std::vector<TraceData>::iterator itData = m_traces.m_tracesData.begin();
+    std::vector<float *>::iterator itTrace = m_traces.m_traces[bufferIndex].begin();
+    std::vector<ScopeEnvelope>::iterator itEnvelope = m_traces.m_envelopes[bufferIndex].begin();
 
-                    if ((m_nbSamples == 1) && ((*itCtl)->m_nbPow > 0)) // on last sample create power display overlay
-                    {
-                        double avgPow = log10f((*itCtl)->m_sumPow / (*itCtl)->m_nbPow)*10.0;
-                        double peakPow = log10f((*itCtl)->m_maxPow)*10.0;
-                        double peakToAvgPow = peakPow - avgPow;
-                        itData->m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
-                        (*itCtl)->m_nbPow = 0;
-                    }
-                }
-                else
-                {
-                    v = ((*itCtl)->m_projector.run(*begin) - itData->m_ofs) * itData->m_amp;
-                }
+    for (int i = 0; i < (int) Projector::nbProjectionTypes; i++) { // no projection done yet for this block
+        m_projectionBlocks[i].m_start = 0;
+        m_projectionBlocks[i].m_stop = 0;
+    }
 
-                if(v > 1.0f) {
-                    v = 1.0f;
-                } else if (v < -1.0f) {
-                    v = -1.0f;
-                }
+    for (; itCtl != m_traces.m_tracesControl.end(); ++itCtl, ++itData, ++itTrace, ++itEnvelope)
+    {
+        uint32_t& traceCount = (*itCtl)->m_traceCount[bufferIndex]; // reference for code clarity
+
+        if (traceCount >= m_traceSize) {
+            continue;
+        }
+
+        int start = traceBack ? std::max(0, toEnd - itData->m_traceDelay) : 0; // skip samples before start of trace
+        int stop = std::min((uint32_t) count, start + (m_traceSize - traceCount));
+
+        if (start >= stop) {
+            continue;
+        }
+
+        Projector::ProjectionType projectionType = itData->m_projectionType;
+        const Real *projected = projectBlock(**itCtl, projectionType, samples, start, stop);
+        int n = stop - start;
+        float a, b;
+
+        if ((projectionType == Projector::ProjectionMagLin) || (projectionType == Projector::ProjectionMagSq))
+        {
+            a = itData->m_amp;
+            b = -itData->m_ofs*itData->m_amp - 1.0f;
+        }
+        else if (projectionType == Projector::ProjectionMagDB)
+        {
+            a = itData->m_amp / 50.0f;
+            b = (2.0f - 2.0f*itData->m_ofs)*itData->m_amp - 1.0f; // dB offset is 100 times the offset
+        }
+        else
+        {
+            a = itData->m_amp;
+            b = -itData->m_ofs*itData->m_amp;
+        }
 
-                (*itTrace)[2*traceCount]
-                           = traceCount - shift;   // display x
-                (*itTrace)[2*traceCount + 1] = v;  // display y
-                traceCount++;
+        float *trace = *itTrace;
+
+        if (m_traces.m_traceDecimation == 1)
+        {
+            scaleBlock(projected, n, a, b, &trace[traceCount]); // display y directly
+        }
+        else
+        {
+            scaleBlock(projected, n, a, b, m_traceValues.data());
+
+            for (int k = 0; k < n; k++)
+            {
+                if (itEnvelope->feed(m_traceValues[k])) { // first sample of a bin is the point of the decimated trace
+                    trace[itEnvelope->getNbFilledBins()] = m_traceValues[k]; // display y
+                }
             }
         }
 
-        ++begin;
-        m_nbSamples--;
+        if ((projectionType == Projector::ProjectionMagSq) || (projectionType == Projector::ProjectionMagDB)) {
+            updatePowerOverlay(**itCtl, *itData, samples, projected, start, stop, shift, length);
+        }
+
+        traceCount += n;
     }
+}
 
-    float traceTime = ((float) m_traceSize) / m_sampleRate;
+const Real *ScopeVis::projectBlock(TraceControl& traceControl, Projector::ProjectionType projectionType, const Sample *samples, int start, int stop)
+{
+    ProjectionBlock& projectionBlock = m_projectionBlocks[(int) projectionType];
 
-    if (traceTime >= 1.0f) { // display continuously if trace time is 1 second or more
-        m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes);
+    if ((projectionBlock.m_start != start) || (projectionBlock.m_stop != stop)) // not projected yet by a trace with the same projection type
+    {
+        traceControl.m_projector.runBlock(&samples[start], stop - start, &projectionBlock.m_values[start]);
+        projectionBlock.m_start = start;
+        projectionBlock.m_stop = stop;
     }
 
-    if (m_nbSamples == 0) // finished
+    return &projectionBlock.m_values[start];
+}
+
+void ScopeVis::updatePowerOverlay(TraceControl& traceControl, TraceData& traceData, const Sample *samples, const Real *projected, int start, int stop, uint32_t shift, uint32_t length)
+{
+    uint32_t traceCount = traceControl.m_traceCount[m_traces.currentBufferIndex()]; // at start
+    // power display overlay values construction in the displayed part of the trace
+    int overlayStart = std::max(start, (int) (start + shift - traceCount));
+    int overlayStop = std::min(stop, (int) (start + shift + length - traceCount));
+
+    if ((overlayStart < overlayStop) && (traceCount + (overlayStart - start) == shift))
     {
-        // display only at trace end if trace time is less than 1 second
-        if (traceTime < 1.0f)
+        traceControl.m_maxPow = 0.0f;
+        traceControl.m_sumPow = 0.0f;
+        traceControl.m_nbPow = 1;
+    }
+
+    for (int k = overlayStart; k < overlayStop; k++)
+    {
+        double magsq;
+
+        if (traceData.m_projectionType == Projector::ProjectionMagSq)
         {
-            if (m_glScope->getProcessingTraceIndex().load() < 0) {
-                m_glScope->newTraces(m_traces.m_traces, m_traces.currentBufferIndex(), &m_traces.m_projectionTypes);
+            magsq = projected[k - start];
+        }
+        else
+        {
+            Real re = samples[k].m_real / SDR_RX_SCALEF;
+            Real im = samples[k].m_imag / SDR_RX_SCALEF;
+            magsq = re*re + im*im;
+        }
+
+        if (magsq > 0.0f)
+        {
+            if (magsq > traceControl.m_maxPow) {
+                traceControl.m_maxPow = magsq;
             }
+
+            traceControl.m_sumPow += magsq;
+            traceControl.m_nbPow++;
         }
+    }
 
-        // switch to next buffer only if it is not being processed by the scope
-        if (m_glScope->getProcessingTraceIndex().load() != (((int) m_traces.currentBufferIndex() + 1) % 2)) {
-            m_traces.switchBuffer();
+    int last = m_nbSamples - 1; // last sample of the trace in the block if any
+
+    if ((last >= start) && (last < stop) && (traceControl.m_nbPow > 0)) // on last sample create power display overlay
+    {
+        if (traceData.m_projectionType == Projector::ProjectionMagSq)
+        {
+            double avgPow = traceControl.m_sumPow / traceControl.m_nbPow;
+            traceData.m_textOverlay = QString("%1  %2").arg(traceControl.m_maxPow, 0, 'e', 2).arg(avgPow, 0, 'e', 2);
+        }
+        else
+        {
+            double avgPow = log10f(traceControl.m_sumPow / traceControl.m_nbPow)*10.0;
+            double peakPow = log10f(traceControl.m_maxPow)*10.0;
+            double peakToAvgPow = peakPow - avgPow;
+            traceData.m_textOverlay = QString("%1  %2  %3").arg(peakPow, 0, 'f', 1).arg(avgPow, 0, 'f', 1).arg(peakToAvgPow, 4, 'f', 1, ' ');
         }
 
-        return end - begin; // return remainder count
+        traceControl.m_nbPow = 0;
     }
-    else
+}
+
+int ScopeVis::TriggerComparator::triggered(const Sample *samples, int count, TriggerCondition& triggerCondition)
+{
+    if (triggerCondition.m_triggerData.m_triggerLevel != m_level)
     {
-        return -1; // mark not finished
+        m_level = triggerCondition.m_triggerData.m_triggerLevel;
+        computeLevels();
     }
+
+    Real level;
+
+    if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagDB) {
+        level = m_levelPowerDB;
+    } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagLin) {
+        level = m_levelPowerLin;
+    } else {
+        level = m_level;
+    }
+
+    uint32_t holdoff = triggerCondition.m_triggerData.m_triggerHoldoff;
+
+    for (int blockStart = 0; blockStart < count; blockStart += m_projectionBlockSize)
+    {
+        int blockCount = std::min(count - blockStart, m_projectionBlockSize);
+        triggerCondition.m_projector.runBlock(&samples[blockStart], blockCount, m_projected.data());
+        int i = 0;
+
+        while (i < blockCount)
+        {
+            // When the condition is steady past the holdoff only a change of the level comparison
+            // can fire the trigger so the values are scanned quickly up to this change
+            if (!m_reset && (triggerCondition.m_prevCondition ? triggerCondition.m_trues : triggerCondition.m_falses) >= holdoff)
+            {
+                int change = findConditionChange(m_projected.data(), i, blockCount, level, triggerCondition.m_prevCondition);
+
+                if (change > i)
+                {
+                    if (triggerCondition.m_prevCondition) {
+                        triggerCondition.m_falses = 0;
+                    } else {
+                        triggerCondition.m_trues = 0;
+                    }
+
+                    i = change;
+
+                    if (i == blockCount) {
+                        break;
+                    }
+                }
+            }
+
+            bool condition = m_projected[i] > level;
+            bool trigger;
+
+            if (condition)
+            {
+                if (triggerCondition.m_trues < holdoff) {
+                    condition = false;
+                    triggerCondition.m_trues++;
+                } else {
+                    triggerCondition.m_falses = 0;
+                }
+            }
+            else
+            {
+                if (triggerCondition.m_falses < holdoff) {
+                    condition = true;
+                    triggerCondition.m_falses++;
+                } else {
+                    triggerCondition.m_trues = 0;
+                }
+            }
+
+            if (m_reset)
+            {
+                triggerCondition.m_prevCondition = condition;
+                m_reset = false;
+                i++;
+                continue;
+            }
+
+            if (triggerCondition.m_triggerData.m_triggerBothEdges) {
+                trigger = triggerCondition.m_prevCondition ? !condition : condition; // This is a XOR between bools
+            } else if (triggerCondition.m_triggerData.m_triggerPositiveEdge) {
+                trigger = !triggerCondition.m_prevCondition && condition;
+            } else {
+                trigger = triggerCondition.m_prevCondition && !condition;
+            }
+
+            triggerCondition.m_prevCondition = condition;
+
+            if (trigger)
+            {
+                // samples past the trigger were projected but are processed again
+                triggerCondition.m_projector.setPreviousSample(samples[blockStart + i]);
+                return blockStart + i;
+            }
+
+            i++;
+        }
+    }
+
+    return count;
 }
 
 void ScopeVis::start()
@@ -906,13 +1140,9 @@ bool ScopeVis::handleMessage(const Message& message)
 void ScopeVis::updateMaxTraceDelay()
 {
     int maxTraceDelay = 0;
-    bool allocateCache = false;
-    uint32_t projectorCounts[(int) Projector::nbProjectionTypes];
-    memset(projectorCounts, 0, ((int) Projector::nbProjectionTypes)*sizeof(uint32_t));
     std::vector<TraceData>::iterator itData = m_traces.m_tracesData.begin();
-    std::vector<TraceControl*>::iterator itCtrl = m_traces.m_tracesControl.begin();
 
-    for (; itData != m_traces.m_tracesData.end(); ++itData, ++itCtrl)
+    for (; itData != m_traces.m_tracesData.end(); ++itData)
     {
         if (itData->m_traceDelay > maxTraceDelay)
         {
@@ -922,29 +1152,6 @@ void ScopeVis::updateMaxTraceDelay()
         if (itData->m_projectionType < 0) {
             itData->m_projectionType = Projector::ProjectionReal;
         }
-
-        if (projectorCounts[(int) itData->m_projectionType] > 0)
-        {
-            allocateCache = true;
-            (*itCtrl)->m_projector.setCacheMaster(false);
-        }
-        else
-        {
-            (*itCtrl)->m_projector.setCacheMaster(true);
-        }
-
-        projectorCounts[(int) itData->m_projectionType]++;
-    }
-
-    itCtrl = m_traces.m_tracesControl.begin();
-
-    for (; itCtrl != m_traces.m_tracesControl.end(); ++itCtrl)
-    {
-        if (allocateCache) {
-            (*itCtrl)->m_projector.setCache(m_projectorCache);
-        } else {
-            (*itCtrl)->m_projector.setCache(0);
-        }
     }
 
     m_maxTraceDelay = maxTraceDelay;
@@ -952,19 +1159,21 @@ void ScopeVis::updateMaxTraceDelay()
 
 void ScopeVis::initTraceBuffers()
 {
-    int shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
-
     std::vector<float *>::iterator it0 = m_traces.m_traces[0].begin();
     std::vector<float *>::iterator it1 = m_traces.m_traces[1].begin();
 
     for (; it0 != m_traces.m_traces[0].end(); ++it0, ++it1)
     {
-        for (unsigned int i = 0; i < m_traceSize; i++)
-        {
-            (*it0)[2*i] = (i - shift); // display x
-            (*it0)[2*i + 1] = 0.0f;    // display y
-            (*it1)[2*i] = (i - shift); // display x
-            (*it1)[2*i + 1] = 0.0f;    // display y
+        std::fill_n(*it0, m_traces.m_nbPoints, 0.0f); // display y
+        std::fill_n(*it1, m_traces.m_nbPoints, 0.0f);
+    }
+
+    m_traces.m_serial++;
+
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        for (std::vector<ScopeEnvelope>::iterator it = m_traces.m_envelopes[i].begin(); it != m_traces.m_envelopes[i].end(); ++it) {
+            it->reset();
         }
     }
 }
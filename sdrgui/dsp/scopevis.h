@@ -33,6 +33,7 @@
 #include "dsp/dsptypes.h"
 #include "dsp/basebandsamplesink.h"
 #include "dsp/projector.h"
+#include "dsp/scopeenvelope.h"
 #include "export.h"
 #include "util/message.h"
 #include "util/doublebuffer.h"
@@ -148,6 +149,7 @@ public:
     };
 
     static const uint32_t m_traceChunkDefaultSize;
+    static const int m_projectionBlockSize;          //!< Samples are projected by blocks of at most this size
     static const uint32_t m_maxNbTriggers = 10;
     static const uint32_t m_maxNbTraces = 10;
     static const uint32_t m_nbTraceMemories = 50;
@@ -636,6 +638,8 @@ private:
     {
     	TraceBuffer m_traceBuffer;
     	SampleVector::iterator m_endPoint;
+        std::vector<ScopeEnvelope> m_envelopes; //!< Envelopes of the displayed traces when traces are decimated
+        std::vector<float> m_points;            //!< Decimated points of the displayed traces when traces are decimated
 
     	TraceBackBuffer()
     	{
@@ -652,6 +656,14 @@ private:
     	    m_traceBuffer.reset();
     	}
 
+        void release() //!< Only the envelopes are kept
+        {
+            m_traceBuffer.release();
+            m_endPoint = m_traceBuffer.getCurrent();
+        }
+
+        bool isReleased() const { return m_traceBuffer.size() == 0; }
+
     	void write(const SampleVector::const_iterator begin, const SampleVector::const_iterator end)
     	{
     		m_traceBuffer.write(begin, end);
@@ -668,9 +680,17 @@ private:
             SimpleSerializer s(1);
 
             QByteArray buffer = m_traceBuffer.serialize();
-            unsigned int endDelta = m_endPoint - m_traceBuffer.begin();
+            unsigned int endDelta = isReleased() ? 0 : m_endPoint - m_traceBuffer.begin();
             s.writeU32(1, endDelta);
             s.writeBlob(2, buffer);
+            s.writeU32(3, m_envelopes.size());
+
+            for (unsigned int i = 0; i < m_envelopes.size(); i++) {
+                s.writeBlob(10+i, m_envelopes[i].serialize());
+            }
+
+            QByteArray points(reinterpret_cast<const char*>(m_points.data()), m_points.size()*sizeof(float));
+            s.writeBlob(4, points);
 
             return s.final();
         }
@@ -692,6 +712,18 @@ private:
                 d.readBlob(2, &buf);
                 m_traceBuffer.deserialize(buf);
                 m_endPoint = m_traceBuffer.begin() + tmpUInt;
+                d.readU32(3, &tmpUInt, 0);
+                m_envelopes.resize(tmpUInt < m_maxNbTraces ? tmpUInt : m_maxNbTraces);
+
+                for (unsigned int i = 0; i < m_envelopes.size(); i++)
+                {
+                    d.readBlob(10+i, &buf);
+                    m_envelopes[i].deserialize(buf);
+                }
+
+                d.readBlob(4, &buf);
+                m_points.resize(buf.size() / sizeof(float));
+                std::copy(reinterpret_cast<const float*>(buf.data()), reinterpret_cast<const float*>(buf.data()) + m_points.size(), m_points.begin());
 
                 return true;
             }
@@ -708,11 +740,12 @@ private:
     	uint32_t m_memSize;
     	uint32_t m_currentMemIndex;
     	uint32_t m_traceSize;
+        bool m_envelopeMode; //!< Traces are decimated: only the current trace keeps its samples the others keep their envelopes
 
     	/**
     	 * Give memory size in number of traces
     	 */
-    	TraceBackDiscreteMemory(uint32_t size) : m_memSize(size), m_currentMemIndex(0), m_traceSize(0)
+    	TraceBackDiscreteMemory(uint32_t size) : m_memSize(size), m_currentMemIndex(0), m_traceSize(0), m_envelopeMode(false)
     	{
     		m_traceBackBuffers.resize(m_memSize);
     	}
@@ -723,10 +756,19 @@ private:
     	void resize(uint32_t size)
     	{
     	    m_traceSize = size;
+            m_envelopeMode = ScopeEnvelope::getBinSize(m_traceSize) > 1;
 
-    		for (std::vector<TraceBackBuffer>::iterator it = m_traceBackBuffers.begin(); it != m_traceBackBuffers.end(); ++it)
+    		for (unsigned int i = 0; i < m_traceBackBuffers.size(); i++)
     		{
-                it->resize(2*m_traceSize); // was multiplied by 4
+                TraceBackBuffer& traceBackBuffer = m_traceBackBuffers[i];
+                traceBackBuffer.m_envelopes.clear();
+                traceBackBuffer.m_points.clear();
+
+                if (m_envelopeMode && (i != m_currentMemIndex)) {
+                    traceBackBuffer.release();
+                } else {
+                    traceBackBuffer.resize(2*m_traceSize); // was multiplied by 4
+                }
     		}
     	}
 
@@ -738,10 +780,25 @@ private:
         TraceBackBuffer &store(int samplesToReport)
     	{
     	    uint32_t nextMemIndex = m_currentMemIndex < (m_memSize-1) ? m_currentMemIndex+1 : 0;
+
+            if (m_traceBackBuffers[nextMemIndex].isReleased()) {
+                m_traceBackBuffers[nextMemIndex].resize(2*m_traceSize);
+            }
+
             m_traceBackBuffers[nextMemIndex].reset();
             m_traceBackBuffers[nextMemIndex].write(m_traceBackBuffers[m_currentMemIndex].m_endPoint - samplesToReport,
                     m_traceBackBuffers[m_currentMemIndex].m_endPoint);
+
     	    m_currentMemIndex = nextMemIndex;
+
+            if (m_envelopeMode) // traces are kept as envelopes. Samples of the previous trace may still be processed
+            {
+                uint32_t releaseIndex = (m_currentMemIndex + m_memSize - 2) % m_memSize;
+
+                if (releaseIndex != m_currentMemIndex) {
+                    m_traceBackBuffers[releaseIndex].release();
+                }
+            }
     		return m_traceBackBuffers[m_currentMemIndex]; // new trace
     	}
 
@@ -877,15 +934,22 @@ private:
     {
         std::vector<TraceControl*> m_tracesControl;   //!< Corresponding traces control data
         std::vector<TraceData> m_tracesData;          //!< Corresponding traces data
-        std::vector<float *> m_traces[2];             //!< Double buffer of traces processed by glScope
+        std::vector<float *> m_traces[2];             //!< Double buffer of traces processed by glScope. One value per point the display computes the coordinates
+        std::vector<ScopeEnvelope> m_envelopes[2];    //!< Double buffer of envelopes of decimated traces processed by glScope
         std::vector<Projector::ProjectionType> m_projectionTypes;
-        int m_traceSize;                              //!< Current size of a trace in buffer
+        int m_traceSize;                              //!< Current size of a trace in number of samples
         int m_maxTraceSize;                           //!< Maximum Size of a trace in buffer
+        uint32_t m_traceDecimation;                   //!< Number of samples per point in buffer. Traces are displayed as envelopes if more than 1
+        uint32_t m_nbPoints;                          //!< Current size of a trace in buffer
+        uint32_t m_serial;                            //!< Changes when the buffers are rewritten from start so that the display uploads them again
         bool evenOddIndex;                            //!< Even (true) or odd (false) index
 
         Traces() :
             m_traceSize(0),
             m_maxTraceSize(0),
+            m_traceDecimation(1),
+            m_nbPoints(0),
+            m_serial(0),
             evenOddIndex(true),
             m_x0(0),
             m_x1(0)
@@ -924,6 +988,8 @@ private:
                 qDebug("ScopeVis::addTrace");
                 m_traces[0].push_back(0);
                 m_traces[1].push_back(0);
+                m_envelopes[0].push_back(ScopeEnvelope());
+                m_envelopes[1].push_back(ScopeEnvelope());
                 m_tracesData.push_back(traceData);
                 m_projectionTypes.push_back(traceData.m_projectionType);
                 m_tracesControl.push_back(new TraceControl());
@@ -952,6 +1018,8 @@ private:
                 qDebug("ScopeVis::removeTrace");
                 m_traces[0].erase(m_traces[0].begin() + traceIndex);
                 m_traces[1].erase(m_traces[1].begin() + traceIndex);
+                m_envelopes[0].erase(m_envelopes[0].begin() + traceIndex);
+                m_envelopes[1].erase(m_envelopes[1].begin() + traceIndex);
                 m_projectionTypes.erase(m_projectionTypes.begin() + traceIndex);
                 TraceControl *traceControl = m_tracesControl[traceIndex];
                 traceControl->releaseProjector();
@@ -1000,25 +1068,91 @@ private:
         void resize(int traceSize)
         {
             m_traceSize = traceSize;
+            m_traceDecimation = ScopeEnvelope::getBinSize(m_traceSize);
+            m_nbPoints = ScopeEnvelope::getNbBins(m_traceSize);
 
-            if (m_traceSize > m_maxTraceSize)
+            if ((int) m_nbPoints > m_maxTraceSize)
             {
                 delete[] m_x0;
                 delete[] m_x1;
-                m_x0 = new float[2*m_traceSize*m_maxNbTraces];
-                m_x1 = new float[2*m_traceSize*m_maxNbTraces];
+                m_x0 = new float[m_nbPoints*m_maxNbTraces];
+                m_x1 = new float[m_nbPoints*m_maxNbTraces];
 
-                m_maxTraceSize = m_traceSize;
+                m_maxTraceSize = m_nbPoints;
             }
 
-            std::fill_n(m_x0, 2*m_traceSize*m_traces[0].size(), 0.0f);
-            std::fill_n(m_x1, 2*m_traceSize*m_traces[0].size(), 0.0f);
+            std::fill_n(m_x0, m_nbPoints*m_traces[0].size(), 0.0f);
+            std::fill_n(m_x1, m_nbPoints*m_traces[0].size(), 0.0f);
+            m_serial++;
 
             for (unsigned int i = 0; i < m_traces[0].size(); i++)
             {
-                (m_traces[0])[i] = &m_x0[2*m_traceSize*i];
-                (m_traces[1])[i] = &m_x1[2*m_traceSize*i];
+                (m_traces[0])[i] = &m_x0[m_nbPoints*i];
+                (m_traces[1])[i] = &m_x1[m_nbPoints*i];
+                (m_envelopes[0])[i].resize(m_traceSize);
+                (m_envelopes[1])[i].resize(m_traceSize);
+            }
+        }
+
+        /**
+         * Keep the envelopes and decimated points of the current buffer in a trace memory slot
+         */
+        void storeEnvelopes(TraceBackBuffer& traceBackBuffer)
+        {
+            std::vector<ScopeEnvelope>& envelopes = m_envelopes[currentBufferIndex()];
+            std::vector<float *>& traces = m_traces[currentBufferIndex()];
+            traceBackBuffer.m_envelopes = envelopes;
+            traceBackBuffer.m_points.resize(m_nbPoints*traces.size());
+
+            for (unsigned int i = 0; i < traces.size(); i++) {
+                std::copy(traces[i], traces[i] + m_nbPoints, traceBackBuffer.m_points.begin() + m_nbPoints*i);
+            }
+        }
+
+        /**
+         * Restore the envelopes and decimated points from a trace memory slot in the current buffer
+         * Traces that are not in memory are left empty
+         */
+        void recallEnvelopes(const TraceBackBuffer& traceBackBuffer)
+        {
+            std::vector<ScopeEnvelope>& envelopes = m_envelopes[currentBufferIndex()];
+            std::vector<float *>& traces = m_traces[currentBufferIndex()];
+
+            for (unsigned int i = 0; i < envelopes.size(); i++)
+            {
+                if ((i < traceBackBuffer.m_envelopes.size())
+                 && (traceBackBuffer.m_envelopes[i].getTraceSize() == (uint32_t) m_traceSize)
+                 && (traceBackBuffer.m_points.size() >= m_nbPoints*(i+1)))
+                {
+                    envelopes[i] = traceBackBuffer.m_envelopes[i];
+                    std::copy(traceBackBuffer.m_points.begin() + m_nbPoints*i,
+                        traceBackBuffer.m_points.begin() + m_nbPoints*(i+1),
+                        traces[i]);
+                }
+                else
+                {
+                    envelopes[i].reset();
+                }
             }
+
+            m_serial++;
+        }
+
+        /**
+         * Number of points from start that are filled in all traces of the current buffer
+         */
+        uint32_t getNbFilledPoints() const
+        {
+            uint32_t nbFilledPoints = m_nbPoints;
+
+            for (std::vector<TraceControl*>::const_iterator it = m_tracesControl.begin(); it != m_tracesControl.end(); ++it)
+            {
+                // the point of a decimated trace is written at the first sample of its bin
+                uint32_t nbPoints = ((*it)->m_traceCount[currentBufferIndex()] + m_traceDecimation - 1) / m_traceDecimation;
+                nbFilledPoints = std::min(nbFilledPoints, nbPoints);
+            }
+
+            return nbFilledPoints;
         }
 
         uint32_t currentBufferIndex() const { return evenOddIndex? 0 : 1; }
@@ -1027,11 +1161,17 @@ private:
         void switchBuffer()
         {
             evenOddIndex = !evenOddIndex;
+            m_serial++;
 
             for (std::vector<TraceControl*>::iterator it = m_tracesControl.begin(); it != m_tracesControl.end(); ++it)
             {
                 (*it)->m_traceCount[currentBufferIndex()] = 0;
             }
+
+            for (std::vector<ScopeEnvelope>::iterator it = m_envelopes[currentBufferIndex()].begin(); it != m_envelopes[currentBufferIndex()].end(); ++it)
+            {
+                it->reset();
+            }
         }
 
     private:
@@ -1042,74 +1182,16 @@ private:
     class TriggerComparator
     {
     public:
-        TriggerComparator() : m_level(0), m_reset(true)
+        TriggerComparator() : m_level(0), m_reset(true), m_projected(m_projectionBlockSize)
         {
             computeLevels();
         }
 
-        bool triggered(const Sample& s, TriggerCondition& triggerCondition)
-        {
-            if (triggerCondition.m_triggerData.m_triggerLevel != m_level)
-            {
-                m_level = triggerCondition.m_triggerData.m_triggerLevel;
-                computeLevels();
-            }
-
-            bool condition, trigger;
-
-            if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagDB) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerDB;
-            } else if (triggerCondition.m_projector.getProjectionType() == Projector::ProjectionMagLin) {
-                condition = triggerCondition.m_projector.run(s) > m_levelPowerLin;
-            } else {
-                condition = triggerCondition.m_projector.run(s) > m_level;
-            }
-
-            if (condition)
-            {
-                if (triggerCondition.m_trues < triggerCondition.m_triggerData.m_triggerHoldoff) {
-                    condition = false;
-                    triggerCondition.m_trues++;
-                } else {
-                    triggerCondition.m_falses = 0;
-                }
-            }
-            else
-            {
-                if (triggerCondition.m_falses < triggerCondition.m_triggerData.m_triggerHoldoff) {
-                    condition = true;
-                    triggerCondition.m_falses++;
-                } else {
-                    triggerCondition.m_trues = 0;
-                }
-            }
-
-            if (m_reset)
-            {
-                triggerCondition.m_prevCondition = condition;
-                m_reset = false;
-                return false;
-            }
-
-            if (triggerCondition.m_triggerData.m_triggerBothEdges) {
-                trigger = triggerCondition.m_prevCondition ? !condition : condition; // This is a XOR between bools
-            } else if (triggerCondition.m_triggerData.m_triggerPositiveEdge) {
-                trigger = !triggerCondition.m_prevCondition && condition;
-            } else {
-                trigger = triggerCondition.m_prevCondition && !condition;
-            }
-
-//            if (trigger) {
-//                qDebug("ScopeVis::triggered: %s/%s %f/%f",
-//                        triggerCondition.m_prevCondition ? "T" : "F",
-//                        condition ? "T" : "F",
-//                        triggerCondition.m_projector->run(s),
-//                        triggerCondition.m_triggerData.m_triggerLevel);
-//            }
-
-            triggerCondition.m_prevCondition = condition;
-            return trigger;
-        }
+        /**
+         * Looks for the trigger in a run of samples.
+         * Returns the index of the sample that fires the trigger or count if the trigger has not fired
+         */
+        int triggered(const Sample *samples, int count, TriggerCondition& triggerCondition);
 
         void reset()
         {
@@ -1127,6 +1209,16 @@ private:
         Real m_levelPowerDB;
         Real m_levelPowerLin;
         bool m_reset;
+        std::vector<Real> m_projected; //!< Trigger projection of a block of samples
+    };
+
+    struct ProjectionBlock
+    {
+        std::vector<Real> m_values; //!< Projected samples of the block
+        int m_start;                //!< First projected sample in the block
+        int m_stop;                 //!< Past last projected sample in the block
+
+        ProjectionBlock() : m_values(m_projectionBlockSize), m_start(0), m_stop(0) {}
     };
 
     GLScope* m_glScope;
@@ -1153,7 +1245,8 @@ private:
     int m_maxTraceDelay;                           //!< Maximum trace delay
     TriggerComparator m_triggerComparator;         //!< Compares sample level to trigger level
     QMutex m_mutex;
-    Real m_projectorCache[(int) Projector::nbProjectionTypes];
+    ProjectionBlock m_projectionBlocks[(int) Projector::nbProjectionTypes]; //!< Block projections shared by the traces with the same projection type
+    std::vector<float> m_traceValues;              //!< Displayable values of a decimated trace over a block of samples
     bool m_triggerOneShot;                         //!< True when one shot mode is active
     bool m_triggerWaitForReset;                    //!< In one shot mode suspended until reset by UI
     uint32_t m_currentTraceMemoryIndex;            //!< The current index of trace in memory (0: current)
@@ -1182,6 +1275,23 @@ private:
      */
     int processTraces(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool traceBack = false);
 
+    /**
+     * Process traces over a block of at most m_projectionBlockSize samples
+     * - toEnd is the number of samples from the start of the block to the end of the processed range
+     */
+    void processTracesBlock(const Sample *samples, int count, int toEnd, bool traceBack, uint32_t shift, uint32_t length);
+
+    /**
+     * Projects samples from start to stop of a block unless a trace with the same projection type already did.
+     * Returns the projected values from start
+     */
+    const Real *projectBlock(TraceControl& traceControl, Projector::ProjectionType projectionType, const Sample *samples, int start, int stop);
+
+    /**
+     * Updates the power overlay of a MagSq or MagDB trace with the samples from start to stop of a block
+     */
+    void updatePowerOverlay(TraceControl& traceControl, TraceData& traceData, const Sample *samples, const Real *projected, int start, int stop, uint32_t shift, uint32_t length);
+
     /**
      * Get maximum trace delay
      */
@@ -41,9 +41,17 @@ const GLfloat GLScope::m_q3RadiiConst[] = {
 GLScope::GLScope(QWidget *parent) : QGLWidget(parent),
     m_tracesData(nullptr),
     m_traces(nullptr),
+    m_envelopes(nullptr),
     m_projectionTypes(nullptr),
     m_processingTraceIndex(-1),
     m_bufferIndex(0),
+    m_nbFilledPoints(0),
+    m_traceSerial(0),
+    m_uploadRequest(0),
+    m_traceBuffersValid(false),
+    m_uploadedBufferIndex(0),
+    m_uploadedSerial(0),
+    m_uploadedPoints(0),
     m_displayMode(DisplayX),
     m_displayPolGrid(false),
     m_dataChanged(0),
@@ -52,13 +60,19 @@ GLScope::GLScope(QWidget *parent) : QGLWidget(parent),
     m_timeOfsProMill(0),
     m_triggerPre(0),
     m_traceSize(0),
+    m_traceDecimation(1),
     m_traceModulo(0),
     m_timeBase(1),
     m_timeOffset(0),
     m_focusedTraceIndex(0),
     m_displayGridIntensity(10),
     m_displayTraceIntensity(50),
-    m_displayXYPoints(false)
+    m_displayXYPoints(false),
+    m_frameTimeNs(0),
+    m_uploadedBytes(0),
+    m_frameCount(0),
+    m_frameTimeMs(0.0f),
+    m_uploadedKBPerFrame(0.0f)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);
     connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
@@ -119,25 +133,43 @@ void GLScope::setDisplayTraceIntensity(int intensity)
     update();
 }
 
-void GLScope::setTraces(std::vector<ScopeVis::TraceData> *tracesData, std::vector<float *> *traces)
+void GLScope::setTraces(std::vector<ScopeVis::TraceData> *tracesData, std::vector<float *> *traces, std::vector<ScopeEnvelope> *envelopes)
 {
     m_tracesData = tracesData;
     m_traces = traces;
+    m_envelopes = envelopes;
 }
 
-void GLScope::newTraces(std::vector<float *> *traces, int traceIndex, std::vector<Projector::ProjectionType> *projectionTypes)
+void GLScope::newTraces(
+    std::vector<float *> *traces,
+    int traceIndex,
+    std::vector<Projector::ProjectionType> *projectionTypes,
+    std::vector<ScopeEnvelope> *envelopes,
+    uint32_t nbFilledPoints,
+    uint32_t serial)
 {
     if (traces->size() > 0)
     {
-        if (!m_mutex.tryLock(0)) {
+        if (!m_mutex.tryLock(0))
+        {
+            m_uploadRequest.store(1); // the points of this call may never be seen as new
             return;
         }
 
         if (m_dataChanged.testAndSetOrdered(0, 1))
         {
             m_processingTraceIndex.store(traceIndex);
+            m_bufferIndex = traceIndex;
             m_traces = &traces[traceIndex];
+            m_envelopes = &envelopes[traceIndex];
             m_projectionTypes = projectionTypes;
+            m_nbFilledPoints = nbFilledPoints;
+            m_traceSerial = serial;
+        }
+        else if (m_traces == &traces[traceIndex]) // more points of the trace not displayed yet
+        {
+            m_nbFilledPoints = nbFilledPoints;
+            m_traceSerial = serial;
         }
 
         m_mutex.unlock();
@@ -197,13 +229,14 @@ void GLScope::initializeGL()
 
     //glDisable(GL_DEPTH_TEST);
     m_glShaderSimple.initializeGL();
-    m_glShaderColors.initializeGL();
     m_glShaderLeft1Scale.initializeGL();
     m_glShaderBottom1Scale.initializeGL();
     m_glShaderLeft2Scale.initializeGL();
     m_glShaderBottom2Scale.initializeGL();
     m_glShaderPowerOverlay.initializeGL();
     m_glShaderTextOverlay.initializeGL();
+    m_glShaderTrace.initializeGL();
+    m_traceBuffersValid = false;
 }
 
 void GLScope::resizeGL(int width, int height)
@@ -220,12 +253,16 @@ void GLScope::paintGL()
         return;
     }
 
+    m_frameTimer.start();
+
     if (m_configChanged)
     {
         applyConfig();
         m_configChanged = false;
     }
 
+    uploadTraces();
+
     //    qDebug("GLScope::paintGL: m_traceCounter: %d", m_traceCounter);
     //    m_traceCounter = 0;
 
@@ -339,12 +376,12 @@ void GLScope::paintGL()
         // paint trace #1
         if (m_traceSize > 0)
         {
-            const float *trace = (*m_traces)[0];
             const ScopeVis::TraceData &traceData = (*m_tracesData)[0];
 
             if (traceData.m_viewTrace)
             {
-                int start = (m_timeOfsProMill / 1000.0) * m_traceSize;
+                int shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
+                int start = shift;
                 int end = std::min(start + m_traceSize / m_timeBase, m_traceSize);
 
                 if (end - start < 2) {
@@ -363,7 +400,16 @@ void GLScope::paintGL()
                 mat.setToIdentity();
                 mat.translate(-1.0f + 2.0f * rectX, 1.0f - 2.0f * rectY);
                 mat.scale(2.0f * rectW, -2.0f * rectH);
-                m_glShaderSimple.drawPolyline(mat, color, (GLfloat *)&trace[2 * start], end - start);
+
+                if (m_traceDecimation > 1)
+                {
+                    drawEnvelope((*m_envelopes)[0], mat, color, start, end, m_glScopeRect1.width() * width());
+                }
+                else
+                {
+                    mat.translate(-shift, 0.0f); // points are at their index
+                    m_glShaderTrace.drawTime(0, mat, color, false, start, end - start);
+                }
 
                 // Paint trigger level if any
                 if ((traceData.m_triggerDisplayLevel > -1.0f) && (traceData.m_triggerDisplayLevel < 1.0f))
@@ -423,7 +469,8 @@ void GLScope::paintGL()
         // paint traces #1..n
         if (m_traceSize > 0)
         {
-            int start = (m_timeOfsProMill / 1000.0) * m_traceSize;
+            int shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
+            int start = shift;
             int end = std::min(start + m_traceSize / m_timeBase, m_traceSize);
 
             if (end - start < 2) {
@@ -432,7 +479,6 @@ void GLScope::paintGL()
 
             for (unsigned int i = 1; i < m_traces->size(); i++)
             {
-                const float *trace = (*m_traces)[i];
                 const ScopeVis::TraceData &traceData = (*m_tracesData)[i];
 
                 if (!traceData.m_viewTrace) {
@@ -451,7 +497,16 @@ void GLScope::paintGL()
                 mat.setToIdentity();
                 mat.translate(-1.0f + 2.0f * rectX, 1.0f - 2.0f * rectY);
                 mat.scale(2.0f * rectW, -2.0f * rectH);
-                m_glShaderSimple.drawPolyline(mat, color, (GLfloat *)&trace[2 * start], end - start);
+
+                if (m_traceDecimation > 1)
+                {
+                    drawEnvelope((*m_envelopes)[i], mat, color, start, end, m_glScopeRect2.width() * width());
+                }
+                else
+                {
+                    mat.translate(-shift, 0.0f); // points are at their index
+                    m_glShaderTrace.drawTime(i, mat, color, false, start, end - start);
+                }
 
                 // Paint trigger level if any
                 if ((traceData.m_triggerDisplayLevel > -1.0f) && (traceData.m_triggerDisplayLevel < 1.0f))
@@ -642,7 +697,8 @@ void GLScope::paintGL()
         // paint all traces
         if (m_traceSize > 0)
         {
-            int start = (m_timeOfsProMill / 1000.0) * m_traceSize;
+            int shift = (m_timeOfsProMill / 1000.0) * m_traceSize;
+            int start = shift;
             int end = std::min(start + m_traceSize / m_timeBase, m_traceSize);
 
             if (end - start < 2) {
@@ -651,7 +707,6 @@ void GLScope::paintGL()
 
             for (unsigned int i = 0; i < m_traces->size(); i++)
             {
-                const float *trace = (*m_traces)[i];
                 const ScopeVis::TraceData &traceData = (*m_tracesData)[i];
 
                 if (!traceData.m_viewTrace) {
@@ -671,10 +726,14 @@ void GLScope::paintGL()
                 mat.translate(-1.0f + 2.0f * rectX, 1.0f - 2.0f * rectY);
                 mat.scale(2.0f * rectW, -2.0f * rectH);
 
-                if (i == 1) { // Y1 in rainbow color
-                    m_glShaderColors.drawPolyline(mat, (GLfloat *)&trace[2 * start], m_q3Colors.m_array, m_displayTraceIntensity / 100.0f, end - start);
-                } else {
-                    m_glShaderSimple.drawPolyline(mat, color, (GLfloat *)&trace[2 * start], end - start);
+                if (m_traceDecimation > 1)
+                {
+                    drawEnvelope((*m_envelopes)[i], mat, color, start, end, m_glScopeRect1.width() * width());
+                }
+                else
+                {
+                    mat.translate(-shift, 0.0f); // points are at their index
+                    m_glShaderTrace.drawTime(i, mat, color, i == 1, start, end - start); // Y1 in rainbow color
                 }
 
                 // Paint trigger level if any
@@ -742,14 +801,16 @@ void GLScope::paintGL()
             int start = (m_timeOfsProMill / 1000.0) * m_traceSize;
             int end = std::min(start + m_traceSize / m_timeBase, m_traceSize);
 
+            if (m_traceDecimation > 1) // decimated points
+            {
+                start /= m_traceDecimation;
+                end = (end + m_traceDecimation - 1) / m_traceDecimation;
+            }
+
             if (end - start < 2)
                 start--;
 
-            //GLfloat q3[2*(end - start)];
-            GLfloat *q3 = m_q3Polar.m_array;
-            const float *trace0 = (*m_traces)[0];
-
-            // If X is an angle and XY display is in polar grid we will perform polar conversion of traces
+            // If X is an angle and XY display is in polar grid the vertex shader performs the polar conversion of traces
             bool polarConversion = m_projectionTypes ?
                 (*m_projectionTypes).size() > 0 ?
                     ((*m_projectionTypes)[0] == Projector::ProjectionPhase)
@@ -759,47 +820,16 @@ void GLScope::paintGL()
                 : false;
             polarConversion &= m_displayPolGrid;
 
-            if (!polarConversion) { // When there is no polar conversion X values are fixed
-                memcpy(q3, &(trace0[2*start + 1]), (2*(end-start) - 1)*sizeof(float)); // copy X values
-            } // TODO: with polar conversion X can be converted to fixed sin(theta) and cos(theta)
-
             for (unsigned int i = 1; i < m_traces->size(); i++)
             {
-                const float *trace = (*m_traces)[i];
                 const ScopeVis::TraceData &traceData = (*m_tracesData)[i];
 
                 if (!traceData.m_viewTrace) {
                     continue;
                 }
 
-                if (polarConversion)
-                {
-                    bool positiveProjection = m_projectionTypes && (i < m_projectionTypes->size()) ?
-                        isPositiveProjection((*m_projectionTypes)[i]) : false;
-
-                    for (int j = start; j < end; j++)
-                    {
-                        float r;
-                        if (positiveProjection) {
-                            r = 0.5f*trace[2*j + 1] + 0.5f;
-                        } else {
-                            r = trace[2*j + 1];
-                        }
-                        float theta = M_PI*trace0[2*j + 1]; // TODO: fixed X to theta conversion (see above)
-                        float x = r*cos(theta);
-                        float y = r*sin(theta);
-                        q3[2*(j-start)] = x;
-                        q3[2*(j-start) + 1] = y;
-                    }
-                }
-                else
-                {
-                    for (int j = start; j < end; j++)
-                    {
-                        float y = trace[2*j + 1];
-                        q3[2*(j-start) + 1] = y;
-                    }
-                }
+                bool positiveProjection = m_projectionTypes && (i < m_projectionTypes->size()) ?
+                    isPositiveProjection((*m_projectionTypes)[i]) : false;
 
                 float rectX = m_glScopeRect2.x() + m_glScopeRect2.width() / 2.0f;
                 float rectY = m_glScopeRect2.y() + m_glScopeRect2.height() / 2.0f;
@@ -811,23 +841,17 @@ void GLScope::paintGL()
                 mat.setToIdentity();
                 mat.translate(-1.0f + 2.0f * rectX, 1.0f - 2.0f * rectY);
                 mat.scale(2.0f * rectW, -2.0f * rectH);
-
-                if (i == 1) // Y1 in rainbow color
-                {
-                    if (m_displayXYPoints) {
-                        m_glShaderColors.drawPoints(mat, q3, m_q3Colors.m_array, m_displayTraceIntensity / 100.0f, end - start);
-                    } else {
-                        m_glShaderColors.drawPolyline(mat, q3, m_q3Colors.m_array, m_displayTraceIntensity / 100.0f, end - start);
-                    }
-                }
-                else
-                {
-                    if (m_displayXYPoints) {
-                        m_glShaderSimple.drawPoints(mat, color, q3, end - start);
-                    } else {
-                        m_glShaderSimple.drawPolyline(mat, color, q3, end - start);
-                    }
-                }
+                m_glShaderTrace.drawXY(
+                    0,
+                    i,
+                    mat,
+                    color,
+                    i == 1, // Y1 in rainbow color
+                    m_displayXYPoints,
+                    polarConversion,
+                    positiveProjection,
+                    start,
+                    end - start);
             } // XY polar display
         } // trace length > 0
     } // XY mixed + polar display
@@ -837,6 +861,17 @@ void GLScope::paintGL()
     m_dataChanged.store(0);
     m_processingTraceIndex.store(-1);
     m_mutex.unlock();
+
+    m_frameTimeNs += m_frameTimer.nsecsElapsed();
+
+    if (++m_frameCount == m_frameStatsPeriod)
+    {
+        m_frameTimeMs = (m_frameTimeNs / 1e6) / m_frameCount;
+        m_uploadedKBPerFrame = (m_uploadedBytes / 1024.0) / m_frameCount;
+        m_frameTimeNs = 0;
+        m_uploadedBytes = 0;
+        m_frameCount = 0;
+    }
 }
 
 void GLScope::drawMarkers()
@@ -1038,8 +1073,10 @@ void GLScope::setTraceSize(int traceSize, bool emitSignal)
 {
     m_mutex.lock();
     m_traceSize = traceSize;
-    m_q3Colors.allocate(3*traceSize);
-    setColorPalette(traceSize, m_traceModulo, m_q3Colors.m_array);
+    m_traceDecimation = ScopeEnvelope::getBinSize(traceSize);
+    int nbPoints = ScopeEnvelope::getNbBins(traceSize);
+    m_q3Colors.allocate(3*nbPoints);
+    setColorPalette(nbPoints, m_traceModulo, m_q3Colors.m_array);
     m_configChanged = true;
     m_mutex.unlock();
     update();
@@ -1101,13 +1138,58 @@ void GLScope::applyConfig()
     m_q3TickX1.allocate(4 * m_x1Scale.getTickList().count());
     m_q3TickX2.allocate(4 * m_x2Scale.getTickList().count());
 
-    int start = (m_timeOfsProMill / 1000.0) * m_traceSize;
-    int end = std::min(start + m_traceSize / m_timeBase, m_traceSize);
+    m_traceBuffersValid = false; // trace size or palette may have changed
+}
+
+void GLScope::uploadTraces()
+{
+    if (!m_traces || (m_traceSize == 0)) {
+        return;
+    }
+
+    int nbTraces = m_traces->size();
+    int nbPoints = ScopeEnvelope::getNbBins(m_traceSize);
+
+    if (!m_traceBuffersValid)
+    {
+        if ((nbTraces != m_glShaderTrace.getNbTraces()) || (nbPoints != m_glShaderTrace.getNbPoints())) {
+            m_glShaderTrace.resize(nbTraces, nbPoints);
+        }
 
-    if (end - start < 2)
-        start--;
+        m_glShaderTrace.setColors(m_q3Colors.m_array);
+    }
 
-    m_q3Polar.allocate(2 * (end - start));
+    uint32_t nbFilledPoints = std::min(m_nbFilledPoints, (uint32_t) nbPoints);
+    uint32_t uploadStart, uploadEnd;
+
+    if (!m_traceBuffersValid
+        || m_uploadRequest.testAndSetOrdered(1, 0)
+        || (m_bufferIndex != m_uploadedBufferIndex)
+        || (m_traceSerial != m_uploadedSerial)
+        || (nbFilledPoints < m_uploadedPoints))
+    {
+        uploadStart = 0;
+        uploadEnd = nbPoints; // points not filled yet are the ones of the previous trace
+    }
+    else
+    {
+        uploadStart = m_uploadedPoints;
+        uploadEnd = nbFilledPoints;
+    }
+
+    if (uploadEnd > uploadStart)
+    {
+        for (int i = 0; i < nbTraces; i++) {
+            m_glShaderTrace.upload(i, (*m_traces)[i], uploadStart, uploadEnd - uploadStart);
+        }
+
+        m_uploadedBytes += nbTraces * (uploadEnd - uploadStart) * sizeof(GLfloat);
+    }
+
+    m_traceBuffersValid = true;
+    m_uploadedBufferIndex = m_bufferIndex;
+    m_uploadedSerial = m_traceSerial;
+    m_uploadedPoints = nbFilledPoints;
 }
 
 void GLScope::setUniqueDisplays()
@@ -2012,7 +2094,7 @@ void GLScope::drawTextOverlay(
 
 void GLScope::tick()
 {
-    if (m_dataChanged.load()) {
+    if (m_dataChanged.load() || m_uploadRequest.load()) {
         update();
     }
 }
@@ -2034,9 +2116,60 @@ void GLScope::cleanup()
     m_glShaderLeft1Scale.cleanup();
     m_glShaderPowerOverlay.cleanup();
     m_glShaderTextOverlay.cleanup();
+    m_glShaderTrace.cleanup();
     //doneCurrent();
 }
 
+void GLScope::drawEnvelope(
+        const ScopeEnvelope& envelope,
+        const QMatrix4x4& mat,
+        const QVector4D& color,
+        int start,
+        int end,
+        float pixelWidth)
+{
+    if ((envelope.getNbLevels() == 0) || (pixelWidth < 1.0f)) {
+        return;
+    }
+
+    // coarsest level that still has a bin per pixel column
+    int level = envelope.getLevelForSamplesPerPixel((end - start) / pixelWidth);
+    int binSize = envelope.getLevelBinSize(level);
+    int firstBin = start / binSize;
+    int endBin = std::min((end + binSize - 1) / binSize, (int) envelope.getLevelNbFilledBins(level));
+    int nbBins = endBin - firstBin;
+
+    if (nbBins <= 0) {
+        return;
+    }
+
+    const float *bins = envelope.getLevel(level);
+    m_q3Envelope.allocate(4*nbBins);
+    m_q3EnvelopeTop.allocate(2*nbBins);
+    m_q3EnvelopeBottom.allocate(2*nbBins);
+
+    for (int i = 0; i < nbBins; i++)
+    {
+        float x = std::max(0, (firstBin + i)*binSize - start); // same x as the trace points
+        float yMin = bins[2*(firstBin + i)];
+        float yMax = bins[2*(firstBin + i) + 1];
+        m_q3Envelope.m_array[4*i] = x;
+        m_q3Envelope.m_array[4*i + 1] = yMin;
+        m_q3Envelope.m_array[4*i + 2] = x;
+        m_q3Envelope.m_array[4*i + 3] = yMax;
+        m_q3EnvelopeTop.m_array[2*i] = x;
+        m_q3EnvelopeTop.m_array[2*i + 1] = yMax;
+        m_q3EnvelopeBottom.m_array[2*i] = x;
+        m_q3EnvelopeBottom.m_array[2*i + 1] = yMin;
+    }
+
+    // filled band with its edges so that flat parts remain visible
+    QVector4D fillColor(color.x(), color.y(), color.z(), color.w() * 0.5f);
+    m_glShaderSimple.drawStrip(mat, fillColor, m_q3Envelope.m_array, 2*nbBins);
+    m_glShaderSimple.drawPolyline(mat, color, m_q3EnvelopeTop.m_array, nbBins);
+    m_glShaderSimple.drawPolyline(mat, color, m_q3EnvelopeBottom.m_array, nbBins);
+}
+
 void GLScope::drawRectGrid2()
 {
     const ScaleEngine::TickList *tickList;
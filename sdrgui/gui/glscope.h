@@ -26,13 +26,14 @@
 #include <QFont>
 #include <QMatrix4x4>
 #include <QAtomicInt>
+#include <QElapsedTimer>
 
 #include "dsp/dsptypes.h"
 #include "dsp/scopevis.h"
 #include "gui/scaleengine.h"
-#include "gui/glshadercolors.h"
 #include "gui/glshadersimple.h"
 #include "gui/glshadertextured.h"
+#include "gui/glshadertrace.h"
 #include "export.h"
 #include "util/bitfieldindex.h"
 #include "util/incrementalarray.h"
@@ -56,8 +57,14 @@ public:
 
     void connectTimer(const QTimer& timer);
 
-    void setTraces(std::vector<ScopeVis::TraceData>* tracesData, std::vector<float *>* traces);
-    void newTraces(std::vector<float *>* traces, int traceIndex, std::vector<Projector::ProjectionType>* projectionTypes);
+    void setTraces(std::vector<ScopeVis::TraceData>* tracesData, std::vector<float *>* traces, std::vector<ScopeEnvelope>* envelopes);
+    void newTraces(
+        std::vector<float *>* traces,
+        int traceIndex,
+        std::vector<Projector::ProjectionType>* projectionTypes,
+        std::vector<ScopeEnvelope>* envelopes,
+        uint32_t nbFilledPoints,
+        uint32_t serial);
 
     int getSampleRate() const { return m_sampleRate; }
     int getTraceSize() const { return m_traceSize; }
@@ -82,6 +89,8 @@ public:
     void setDisplayXYPolarGrid(bool value) { m_displayPolGrid = value; }
     const QAtomicInt& getProcessingTraceIndex() const { return m_processingTraceIndex; }
     void setTraceModulo(int modulo) { m_traceModulo = modulo; }
+    float getFrameTimeMs() const { return m_frameTimeMs; } //!< Average CPU time spent in painting a frame
+    float getUploadedKBPerFrame() const { return m_uploadedKBPerFrame; } //!< Average trace data uploaded per frame in kB
 
 signals:
     void sampleRateChanged(int);
@@ -140,11 +149,19 @@ private:
 
     std::vector<ScopeVis::TraceData> *m_tracesData;
     std::vector<float *> *m_traces;
+    std::vector<ScopeEnvelope> *m_envelopes; //!< Envelopes of the traces when they are decimated
     std::vector<Projector::ProjectionType> *m_projectionTypes;
     QAtomicInt m_processingTraceIndex;
     ScopeVis::TriggerData m_focusedTriggerData;
     //int m_traceCounter;
     uint32_t m_bufferIndex;
+    uint32_t m_nbFilledPoints;     //!< Points filled from start in the traces of the buffer
+    uint32_t m_traceSerial;        //!< Serial of the buffers content given by ScopeVis
+    QAtomicInt m_uploadRequest;    //!< New trace data were dropped so the traces must be uploaded in full
+    bool m_traceBuffersValid;      //!< GPU trace buffers hold the traces of m_uploadedBufferIndex
+    uint32_t m_uploadedBufferIndex;
+    uint32_t m_uploadedSerial;
+    uint32_t m_uploadedPoints;     //!< Points from start already in the GPU trace buffers
     DisplayMode m_displayMode;
     bool m_displayPolGrid;
     QTimer m_timer;
@@ -155,6 +172,7 @@ private:
     int m_timeOfsProMill;
     uint32_t m_triggerPre;
     int m_traceSize;
+    int m_traceDecimation; //!< Number of samples per point of the traces. Time traces are drawn as envelopes if more than 1
     int m_traceModulo; //!< ineffective if <2
     int m_timeBase;
     int m_timeOffset;
@@ -191,15 +209,14 @@ private:
     QFont m_textOverlayFont;
 
     GLShaderSimple m_glShaderSimple;
-    GLShaderColors m_glShaderColors;
     GLShaderTextured m_glShaderLeft1Scale;
     GLShaderTextured m_glShaderBottom1Scale;
     GLShaderTextured m_glShaderLeft2Scale;
     GLShaderTextured m_glShaderBottom2Scale;
     GLShaderTextured m_glShaderPowerOverlay;
     GLShaderTextured m_glShaderTextOverlay;
+    GLShaderTrace m_glShaderTrace;
 
-    IncrementalArray<GLfloat> m_q3Polar;
     IncrementalArray<GLfloat> m_q3TickY1;
     IncrementalArray<GLfloat> m_q3TickY2;
     IncrementalArray<GLfloat> m_q3TickX1;
@@ -207,11 +224,22 @@ private:
     IncrementalArray<GLfloat> m_q3Radii;  //!< Polar grid radii
     IncrementalArray<GLfloat> m_q3Circle; //!< Polar grid unit circle
     IncrementalArray<GLfloat> m_q3Colors; //!< Colors for trace rainbow palette
+    IncrementalArray<GLfloat> m_q3Envelope;       //!< Envelope band as a triangle strip
+    IncrementalArray<GLfloat> m_q3EnvelopeTop;    //!< Envelope maximum line
+    IncrementalArray<GLfloat> m_q3EnvelopeBottom; //!< Envelope minimum line
 
     static const int m_topMargin = 5;
     static const int m_botMargin = 20;
     static const int m_leftMargin = 35;
     static const int m_rightMargin = 5;
+    static const int m_frameStatsPeriod = 100; //!< Number of frames over which frame statistics are averaged
+
+    QElapsedTimer m_frameTimer;
+    qint64 m_frameTimeNs;       //!< Painting time accumulated over the statistics period
+    qint64 m_uploadedBytes;     //!< Trace data uploaded over the statistics period
+    int m_frameCount;
+    float m_frameTimeMs;
+    float m_uploadedKBPerFrame;
 
     static const GLfloat m_q3RadiiConst[];
 
@@ -221,6 +249,7 @@ private:
     void drawMarkers();
 
     void applyConfig();
+    void uploadTraces();          //!< Updates the GPU trace buffers with the new points
     void setYScale(ScaleEngine& scale, uint32_t highlightedTraceIndex);
     void setUniqueDisplays();     //!< Arrange displays when X and Y are unique on screen
     void setVerticalDisplays();   //!< Arrange displays when X and Y are stacked vertically
@@ -251,6 +280,13 @@ private:
             || (projectionType == Projector::ProjectionMagSq);
     }
 
+    void drawEnvelope(
+            const ScopeEnvelope& envelope,
+            const QMatrix4x4& mat,
+            const QVector4D& color,
+            int start,
+            int end,
+            float pixelWidth);
     void drawRectGrid2();
     void drawPolarGrid2();
     QString displayScaled(float value, char type, int precision);
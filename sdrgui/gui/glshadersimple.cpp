@@ -85,6 +85,11 @@ void GLShaderSimple::drawSurface(const QMatrix4x4& transformMatrix, const QVecto
 	draw(GL_TRIANGLE_FAN, transformMatrix, color, vertices, nbVertices);
 }
 
+void GLShaderSimple::drawStrip(const QMatrix4x4& transformMatrix, const QVector4D& color, GLfloat *vertices, int nbVertices)
+{
+	draw(GL_TRIANGLE_STRIP, transformMatrix, color, vertices, nbVertices);
+}
+
 void GLShaderSimple::draw(unsigned int mode, const QMatrix4x4& transformMatrix, const QVector4D& color, GLfloat *vertices, int nbVertices)
 {
 	QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
@@ -0,0 +1,327 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QOpenGLShaderProgram>
+#include <QOpenGLFunctions>
+#include <QOpenGLContext>
+#include <QMatrix4x4>
+#include <QVector4D>
+#include <QDebug>
+
+#include "gui/glshadertrace.h"
+
+// attribute locations
+static const int xAttribute = 0;     // point index or X trace value
+static const int valueAttribute = 1;
+static const int colorAttribute = 2;
+
+static const void *bufferOffset(int start)
+{
+    return reinterpret_cast<const void*>(start * sizeof(GLfloat));
+}
+
+GLShaderTrace::GLShaderTrace() :
+    m_timeProgram(nullptr),
+    m_timeMatrixLoc(0),
+    m_timeAlphaLoc(0),
+    m_xyProgram(nullptr),
+    m_xyMatrixLoc(0),
+    m_xyPolarLoc(0),
+    m_xyPositiveLoc(0),
+    m_xyAlphaLoc(0),
+    m_nbPoints(0)
+{ }
+
+GLShaderTrace::~GLShaderTrace()
+{
+    cleanup();
+}
+
+void GLShaderTrace::initializeGL()
+{
+    m_timeProgram = createProgram(m_vertexShaderSourceTime, "index");
+    m_timeProgram->bind();
+    m_timeMatrixLoc = m_timeProgram->uniformLocation("uMatrix");
+    m_timeAlphaLoc = m_timeProgram->uniformLocation("uAlpha");
+    m_timeProgram->release();
+
+    m_xyProgram = createProgram(m_vertexShaderSourceXY, "xvalue");
+    m_xyProgram->bind();
+    m_xyMatrixLoc = m_xyProgram->uniformLocation("uMatrix");
+    m_xyPolarLoc = m_xyProgram->uniformLocation("uPolar");
+    m_xyPositiveLoc = m_xyProgram->uniformLocation("uPositive");
+    m_xyAlphaLoc = m_xyProgram->uniformLocation("uAlpha");
+    m_xyProgram->release();
+}
+
+QOpenGLShaderProgram *GLShaderTrace::createProgram(const QString& vertexShaderSource, const char *xAttributeName)
+{
+    QOpenGLShaderProgram *program = new QOpenGLShaderProgram;
+
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShaderSource)) {
+        qDebug() << "GLShaderTrace::createProgram: error in vertex shader: " << program->log();
+    }
+
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Fragment, m_fragmentShaderSource)) {
+        qDebug() << "GLShaderTrace::createProgram: error in fragment shader: " << program->log();
+    }
+
+    program->bindAttributeLocation(xAttributeName, xAttribute);
+    program->bindAttributeLocation("value", valueAttribute);
+    program->bindAttributeLocation("v_color", colorAttribute);
+
+    if (!program->link()) {
+        qDebug() << "GLShaderTrace::createProgram: error linking shader: " << program->log();
+    }
+
+    return program;
+}
+
+void GLShaderTrace::resize(int nbTraces, int nbPoints)
+{
+    m_nbPoints = nbPoints;
+
+    if (!m_indexBuffer.isCreated()) {
+        m_indexBuffer.create();
+    }
+
+    std::vector<GLfloat> indexes(nbPoints);
+
+    for (int i = 0; i < nbPoints; i++) {
+        indexes[i] = i;
+    }
+
+    m_indexBuffer.bind();
+    m_indexBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    m_indexBuffer.allocate(indexes.data(), nbPoints * sizeof(GLfloat));
+
+    if (!m_colorBuffer.isCreated()) {
+        m_colorBuffer.create();
+    }
+
+    m_colorBuffer.bind();
+    m_colorBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    m_colorBuffer.allocate(3 * nbPoints * sizeof(GLfloat));
+
+    while ((int) m_traceBuffers.size() > nbTraces)
+    {
+        m_traceBuffers.back().destroy();
+        m_traceBuffers.pop_back();
+    }
+
+    while ((int) m_traceBuffers.size() < nbTraces)
+    {
+        m_traceBuffers.push_back(QOpenGLBuffer(QOpenGLBuffer::VertexBuffer));
+        m_traceBuffers.back().create();
+    }
+
+    for (auto& traceBuffer : m_traceBuffers)
+    {
+        traceBuffer.bind();
+        traceBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        traceBuffer.allocate(nbPoints * sizeof(GLfloat));
+    }
+
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+}
+
+void GLShaderTrace::setColors(const GLfloat *colors)
+{
+    if (m_nbPoints == 0) {
+        return;
+    }
+
+    m_colorBuffer.bind();
+    m_colorBuffer.write(0, colors, 3 * m_nbPoints * sizeof(GLfloat));
+    m_colorBuffer.release();
+}
+
+void GLShaderTrace::upload(int traceIndex, const GLfloat *values, int start, int count)
+{
+    if ((traceIndex >= (int) m_traceBuffers.size()) || !clip(start, count)) {
+        return;
+    }
+
+    m_traceBuffers[traceIndex].bind();
+    m_traceBuffers[traceIndex].write(start * sizeof(GLfloat), &values[start], count * sizeof(GLfloat));
+    m_traceBuffers[traceIndex].release();
+}
+
+bool GLShaderTrace::clip(int& start, int& count) const
+{
+    if (start < 0)
+    {
+        count += start;
+        start = 0;
+    }
+
+    count = std::min(count, m_nbPoints - start);
+    return count > 0;
+}
+
+void GLShaderTrace::drawTime(int traceIndex, const QMatrix4x4& transformMatrix, const QVector4D& color, bool rainbow, int start, int count)
+{
+    if ((traceIndex >= (int) m_traceBuffers.size()) || !clip(start, count)) {
+        return;
+    }
+
+    QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
+    m_timeProgram->bind();
+    m_timeProgram->setUniformValue(m_timeMatrixLoc, transformMatrix);
+    m_timeProgram->setUniformValue(m_timeAlphaLoc, color.w());
+    m_indexBuffer.bind();
+    f->glEnableVertexAttribArray(xAttribute);
+    f->glVertexAttribPointer(xAttribute, 1, GL_FLOAT, GL_FALSE, 0, bufferOffset(start));
+    m_traceBuffers[traceIndex].bind();
+    f->glEnableVertexAttribArray(valueAttribute);
+    f->glVertexAttribPointer(valueAttribute, 1, GL_FLOAT, GL_FALSE, 0, bufferOffset(start));
+    setColor(f, color, rainbow);
+    draw(f, GL_LINE_STRIP, count);
+    m_timeProgram->release();
+}
+
+void GLShaderTrace::drawXY(
+        int xTraceIndex,
+        int yTraceIndex,
+        const QMatrix4x4& transformMatrix,
+        const QVector4D& color,
+        bool rainbow,
+        bool points,
+        bool polar,
+        bool positive,
+        int start,
+        int count)
+{
+    if ((xTraceIndex >= (int) m_traceBuffers.size()) || (yTraceIndex >= (int) m_traceBuffers.size()) || !clip(start, count)) {
+        return;
+    }
+
+    QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
+    m_xyProgram->bind();
+    m_xyProgram->setUniformValue(m_xyMatrixLoc, transformMatrix);
+    m_xyProgram->setUniformValue(m_xyPolarLoc, polar);
+    m_xyProgram->setUniformValue(m_xyPositiveLoc, positive);
+    m_xyProgram->setUniformValue(m_xyAlphaLoc, color.w());
+    m_traceBuffers[xTraceIndex].bind();
+    f->glEnableVertexAttribArray(xAttribute);
+    f->glVertexAttribPointer(xAttribute, 1, GL_FLOAT, GL_FALSE, 0, bufferOffset(start));
+    m_traceBuffers[yTraceIndex].bind();
+    f->glEnableVertexAttribArray(valueAttribute);
+    f->glVertexAttribPointer(valueAttribute, 1, GL_FLOAT, GL_FALSE, 0, bufferOffset(start));
+    setColor(f, color, rainbow);
+    draw(f, points ? GL_POINTS : GL_LINE_STRIP, count);
+    m_xyProgram->release();
+}
+
+void GLShaderTrace::setColor(QOpenGLFunctions *f, const QVector4D& color, bool rainbow)
+{
+    if (rainbow) // the palette starts at the first drawn point
+    {
+        m_colorBuffer.bind();
+        f->glEnableVertexAttribArray(colorAttribute);
+        f->glVertexAttribPointer(colorAttribute, 3, GL_FLOAT, GL_FALSE, 0, bufferOffset(0));
+    }
+    else // constant attribute
+    {
+        f->glDisableVertexAttribArray(colorAttribute);
+        f->glVertexAttrib3f(colorAttribute, color.x(), color.y(), color.z());
+    }
+}
+
+void GLShaderTrace::draw(QOpenGLFunctions *f, unsigned int mode, int count)
+{
+    f->glEnable(GL_BLEND);
+    f->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    f->glLineWidth(1.0f);
+    f->glDrawArrays(mode, 0, count);
+    f->glDisableVertexAttribArray(xAttribute);
+    f->glDisableVertexAttribArray(valueAttribute);
+    f->glDisableVertexAttribArray(colorAttribute);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+}
+
+void GLShaderTrace::cleanup()
+{
+    if (!QOpenGLContext::currentContext()) { // buffers cannot be destroyed without the context
+        return;
+    }
+
+    for (auto& traceBuffer : m_traceBuffers) {
+        traceBuffer.destroy();
+    }
+
+    m_traceBuffers.clear();
+    m_indexBuffer.destroy();
+    m_colorBuffer.destroy();
+    m_nbPoints = 0;
+
+    if (m_timeProgram)
+    {
+        delete m_timeProgram;
+        m_timeProgram = nullptr;
+    }
+
+    if (m_xyProgram)
+    {
+        delete m_xyProgram;
+        m_xyProgram = nullptr;
+    }
+}
+
+const QString GLShaderTrace::m_vertexShaderSourceTime = QString(
+        "uniform highp mat4 uMatrix;\n"
+        "attribute highp float index;\n"
+        "attribute highp float value;\n"
+        "attribute vec3 v_color;\n"
+        "varying vec3 f_color;\n"
+        "void main() {\n"
+        "    gl_Position = uMatrix * vec4(index, value, 0.0, 1.0);\n"
+        "    f_color = v_color;\n"
+        "}\n"
+        );
+
+const QString GLShaderTrace::m_vertexShaderSourceXY = QString(
+        "uniform highp mat4 uMatrix;\n"
+        "uniform bool uPolar;\n"
+        "uniform bool uPositive;\n"
+        "attribute highp float xvalue;\n"
+        "attribute highp float value;\n"
+        "attribute vec3 v_color;\n"
+        "varying vec3 f_color;\n"
+        "void main() {\n"
+        "    highp vec2 p;\n"
+        "    if (uPolar) {\n"
+        "        highp float r = uPositive ? 0.5*value + 0.5 : value;\n"
+        "        highp float theta = 3.14159265*xvalue;\n"
+        "        p = vec2(r*cos(theta), r*sin(theta));\n"
+        "    } else {\n"
+        "        p = vec2(xvalue, value);\n"
+        "    }\n"
+        "    gl_Position = uMatrix * vec4(p, 0.0, 1.0);\n"
+        "    f_color = v_color;\n"
+        "}\n"
+        );
+
+const QString GLShaderTrace::m_fragmentShaderSource = QString(
+        "uniform mediump float uAlpha;\n"
+        "varying vec3 f_color;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(f_color.r, f_color.g, f_color.b, uAlpha);\n"
+        "}\n"
+        );
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Shader for scope traces kept in vertex buffer objects                         //
+//                                                                               //
+// Each trace is a buffer of one value per point that lives in the GPU as long   //
+// as the trace size and number of traces do not change so that only the new    //
+// points have to be uploaded. Coordinates are computed by the vertex shader     //
+// either from the point index (time displays) or from the values of another    //
+// trace (XY displays with optional polar conversion).                           //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INCLUDE_GUI_GLSHADERTRACE_H_
+#define INCLUDE_GUI_GLSHADERTRACE_H_
+
+#include <vector>
+
+#include <QString>
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+
+#include "export.h"
+
+class QOpenGLShaderProgram;
+class QMatrix4x4;
+class QVector4D;
+
+class SDRGUI_API GLShaderTrace
+{
+public:
+    GLShaderTrace();
+    ~GLShaderTrace();
+
+    void initializeGL();
+    void resize(int nbTraces, int nbPoints); //!< (Re)allocates the buffers. Trace values are undefined until uploaded
+    int getNbTraces() const { return m_traceBuffers.size(); }
+    int getNbPoints() const { return m_nbPoints; }
+    void setColors(const GLfloat *colors);   //!< Uploads the RGB colors of the points of rainbow traces
+    void upload(int traceIndex, const GLfloat *values, int start, int count); //!< Uploads count values of a trace from start
+    /** Draws count values of a trace from start as a function of the point index */
+    void drawTime(int traceIndex, const QMatrix4x4& transformMatrix, const QVector4D& color, bool rainbow, int start, int count);
+    /** Draws count values of a Y trace from start as a function of the values of a X trace. With polar conversion X is an angle divided by pi */
+    void drawXY(
+            int xTraceIndex,
+            int yTraceIndex,
+            const QMatrix4x4& transformMatrix,
+            const QVector4D& color,
+            bool rainbow,
+            bool points,
+            bool polar,
+            bool positive,
+            int start,
+            int count);
+    void cleanup();
+
+private:
+    QOpenGLShaderProgram *m_timeProgram;
+    int m_timeMatrixLoc;
+    int m_timeAlphaLoc;
+    QOpenGLShaderProgram *m_xyProgram;
+    int m_xyMatrixLoc;
+    int m_xyPolarLoc;
+    int m_xyPositiveLoc;
+    int m_xyAlphaLoc;
+    QOpenGLBuffer m_indexBuffer;                //!< Point indexes for the time displays
+    QOpenGLBuffer m_colorBuffer;                //!< Point colors for the rainbow traces
+    std::vector<QOpenGLBuffer> m_traceBuffers;  //!< Values of the traces
+    int m_nbPoints;
+
+    static const QString m_vertexShaderSourceTime;
+    static const QString m_vertexShaderSourceXY;
+    static const QString m_fragmentShaderSource;
+
+    static QOpenGLShaderProgram *createProgram(const QString& vertexShaderSource, const char *xAttributeName);
+    bool clip(int& start, int& count) const;    //!< Restricts the range to the buffers. Returns false if empty
+    void setColor(QOpenGLFunctions *f, const QVector4D& color, bool rainbow);
+    void draw(QOpenGLFunctions *f, unsigned int mode, int count);
+};
+
+#endif /* INCLUDE_GUI_GLSHADERTRACE_H_ */
@@ -26,6 +26,7 @@
 #include <QPainter>
 #include <QFontDatabase>
 #include "gui/glspectrum.h"
+#include "dsp/spectrumpalette.h"
 #include "util/messagequeue.h"
 
 #include <QDebug>
@@ -45,6 +46,8 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 	m_decay(1),
 	m_sampleRate(500000),
 	m_timingRate(1),
+	m_zoomFrequencyOffset(0),
+	m_zoomLog2Decim(0),
 	m_fftSize(512),
 	m_displayGrid(true),
 	m_displayGridIntensity(5),
@@ -88,15 +91,13 @@ GLSpectrum::GLSpectrum(QWidget* parent) :
 
 	for (int i = 0; i <= 239; i++)
     {
-	    QColor c;
-	    c.setHsv(239 - i, 255, 15 + i);
+	    QColor c = SpectrumPalette::getWaterfallColor(i);
 	    ((quint8*)&m_waterfallPalette[i])[0] = c.red();
 	    ((quint8*)&m_waterfallPalette[i])[1] = c.green();
 	    ((quint8*)&m_waterfallPalette[i])[2] = c.blue();
 	    ((quint8*)&m_waterfallPalette[i])[3] = c.alpha();
 	}
 
-	m_waterfallPalette[239] = 0xffffffff;
 	m_histogramPalette[0] = 0;
 
 	for (int i = 1; i < 240; i++)
@@ -241,6 +242,16 @@ void GLSpectrum::setSampleRate(qint32 sampleRate)
 	update();
 }
 
+void GLSpectrum::setZoom(qint64 frequencyOffset, int log2Decim)
+{
+	m_mutex.lock();
+	m_zoomFrequencyOffset = log2Decim > 0 ? frequencyOffset : 0;
+	m_zoomLog2Decim = log2Decim < 0 ? 0 : log2Decim;
+	m_changesPending = true;
+	m_mutex.unlock();
+	update();
+}
+
 void GLSpectrum::setTimingRate(qint32 timingRate)
 {
     m_mutex.lock();
@@ -1260,6 +1271,10 @@ void GLSpectrum::applyChanges()
 	m_frequencyScaleHeight = fm.height() * 3; // +1 line for marker frequency scale
 	int frequencyScaleTop = 0;
 	int histogramTop = 0;
+
+	// displayed band is the zoomed sub-band if any
+	qint64 centerFrequency = m_centerFrequency + m_zoomFrequencyOffset;
+	quint32 sampleRate = m_sampleRate >> m_zoomLog2Decim;
 	//int m_leftMargin;
 	m_rightMargin = fm.width("000");
 
@@ -1289,9 +1304,9 @@ void GLSpectrum::applyChanges()
 
 		m_timeScale.setSize(m_waterfallHeight);
 
-		if (m_sampleRate > 0)
+		if (sampleRate > 0)
 		{
-			float scaleDiv = ((float)m_sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
+			float scaleDiv = ((float)sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
 
 			if (!m_invertedWaterfall) {
 				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (m_waterfallHeight * m_fftSize) / scaleDiv, 0);
@@ -1321,7 +1336,7 @@ void GLSpectrum::applyChanges()
 		m_leftMargin += 2 * M;
 
 		m_frequencyScale.setSize(width() - m_leftMargin - m_rightMargin);
-		m_frequencyScale.setRange(Unit::Frequency, m_centerFrequency - m_sampleRate / 2, m_centerFrequency + m_sampleRate / 2);
+		m_frequencyScale.setRange(Unit::Frequency, centerFrequency - sampleRate / 2, centerFrequency + sampleRate / 2);
 		m_frequencyScale.setMakeOpposite(m_lsbDisplay);
 
 		m_glWaterfallBoxMatrix.setToIdentity();
@@ -1390,9 +1405,9 @@ void GLSpectrum::applyChanges()
 
 		m_timeScale.setSize(m_waterfallHeight);
 
-		if (m_sampleRate > 0)
+		if (sampleRate > 0)
 		{
-			float scaleDiv = ((float)m_sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
+			float scaleDiv = ((float)sampleRate / (float)m_timingRate) * (m_ssbSpectrum ? 2 : 1);
 
 			if (!m_invertedWaterfall) {
 				m_timeScale.setRange(m_timingRate > 1 ? Unit::TimeHMS : Unit::Time, (m_waterfallHeight * m_fftSize) / scaleDiv, 0);
@@ -1413,7 +1428,7 @@ void GLSpectrum::applyChanges()
 		m_leftMargin += 2 * M;
 
 		m_frequencyScale.setSize(width() - m_leftMargin - m_rightMargin);
-		m_frequencyScale.setRange(Unit::Frequency, m_centerFrequency - m_sampleRate / 2.0, m_centerFrequency + m_sampleRate / 2.0);
+		m_frequencyScale.setRange(Unit::Frequency, centerFrequency - sampleRate / 2.0, centerFrequency + sampleRate / 2.0);
 		m_frequencyScale.setMakeOpposite(m_lsbDisplay);
 
 		m_glWaterfallBoxMatrix.setToIdentity();
@@ -1465,7 +1480,7 @@ void GLSpectrum::applyChanges()
 		m_leftMargin += 2 * M;
 
 		m_frequencyScale.setSize(width() - m_leftMargin - m_rightMargin);
-		m_frequencyScale.setRange(Unit::Frequency, m_centerFrequency - m_sampleRate / 2, m_centerFrequency + m_sampleRate / 2);
+		m_frequencyScale.setRange(Unit::Frequency, centerFrequency - sampleRate / 2, centerFrequency + sampleRate / 2);
 		m_frequencyScale.setMakeOpposite(m_lsbDisplay);
 
 		m_glHistogramSpectrumMatrix.setToIdentity();
@@ -1602,7 +1617,7 @@ void GLSpectrum::applyChanges()
 			 1.0f
 		);
 		glMatrixDsb.scale(
-			2.0f * (dsbw / (float)m_sampleRate),
+			2.0f * (dsbw / (float)sampleRate),
 			-2.0f
 		);
 
@@ -1645,7 +1660,7 @@ void GLSpectrum::applyChanges()
 			 1.0f
 		);
 		glMatrix.scale(
-			2.0f * ((pw-nw) / (float)m_sampleRate),
+			2.0f * ((pw-nw) / (float)sampleRate),
 			-2.0f
 		);
 
@@ -1684,7 +1699,7 @@ void GLSpectrum::applyChanges()
 		dv->m_glRect.setRect(
 			m_frequencyScale.getPosFromValue(m_centerFrequency + dv->m_channelMarker->getCenterFrequency() - dv->m_channelMarker->getBandwidth() / 2) / (float)(width() - m_leftMargin - m_rightMargin),
 			0,
-			(dv->m_channelMarker->getBandwidth() / (float)m_sampleRate),
+			(dv->m_channelMarker->getBandwidth() / (float)sampleRate),
 			1);
 		*/
 
@@ -67,6 +67,7 @@ public:
 	void setCenterFrequency(qint64 frequency);
 	void setSampleRate(qint32 sampleRate);
 	void setTimingRate(qint32 timingRate);
+	void setZoom(qint64 frequencyOffset, int log2Decim); //!< displayed sub-band when spectrum is zoomed
 	void setReferenceLevel(Real referenceLevel);
 	void setPowerRange(Real powerRange);
 	void setDecay(int decay);
@@ -101,6 +102,9 @@ public:
         m_displaySourceOrSink = sourceOrSink;
         m_displayStreamIndex = streamIndex;
     }
+    bool getDisplayedSourceOrSink() const { return m_displaySourceOrSink; }
+    int getDisplayedStreamIndex() const { return m_displayStreamIndex; }
+    qint64 getZoomFrequencyOffset() const { return m_zoomFrequencyOffset; } //!< 0 when not zoomed
 
 private:
 	struct ChannelMarkerState {
@@ -239,6 +243,8 @@ private:
 	int m_decay;
 	quint32 m_sampleRate;
 	quint32 m_timingRate;
+	qint64 m_zoomFrequencyOffset; //!< zoomed sub-band center offset from device center frequency
+	int m_zoomLog2Decim;          //!< zoomed sub-band span as log2 of decimation of device sample rate
 
 	int m_fftSize;
 
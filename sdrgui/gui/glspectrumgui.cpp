@@ -123,6 +123,9 @@ void GLSpectrumGUI::displaySettings()
 	ui->fftWindow->blockSignals(true);
 	ui->averaging->blockSignals(true);
 	ui->averagingMode->blockSignals(true);
+	ui->fftOverlap->blockSignals(true);
+	ui->zoomFactor->blockSignals(true);
+	ui->zoomOffset->blockSignals(true);
 	ui->linscale->blockSignals(true);
 
 	ui->fftWindow->setCurrentIndex(m_settings.m_fftWindow);
@@ -138,12 +141,20 @@ void GLSpectrumGUI::displaySettings()
 
 	ui->averaging->setCurrentIndex(m_settings.m_averagingIndex);
 	ui->averagingMode->setCurrentIndex((int) m_settings.m_averagingMode);
+	ui->fftOverlap->setValue(m_settings.m_fftOverlap);
+	ui->zoomFactor->setCurrentIndex(m_settings.m_zoomLog2Decim);
+	setZoomOffsetRange();
+	ui->zoomOffset->setValue(getZoomFrequencyOffset() / 1000);
+	ui->zoomOffset->setEnabled(m_settings.m_zoomLog2Decim > 0);
 	ui->linscale->setChecked(m_settings.m_linear);
 	setAveragingToolitp();
 
 	ui->fftWindow->blockSignals(false);
 	ui->averaging->blockSignals(false);
 	ui->averagingMode->blockSignals(false);
+	ui->fftOverlap->blockSignals(false);
+	ui->zoomFactor->blockSignals(false);
+	ui->zoomOffset->blockSignals(false);
 	ui->linscale->blockSignals(false);
     blockApplySettings(false);
 }
@@ -174,7 +185,9 @@ void GLSpectrumGUI::applySettings()
         m_glSpectrum->setDisplayGridIntensity(m_settings.m_displayGridIntensity);
         m_glSpectrum->setDisplayTraceIntensity(m_settings.m_displayTraceIntensity);
 
-        if ((m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed) || (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)) {
+        if ((m_settings.m_averagingMode == GLSpectrumSettings::AvgModeFixed)
+         || (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeMax)
+         || (m_settings.m_averagingMode == GLSpectrumSettings::AvgModeWelch)) {
             m_glSpectrum->setTimingRate(getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode) == 0 ?
                 1 :
                 getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode));
@@ -188,20 +201,13 @@ void GLSpectrumGUI::applySettings()
         m_glSpectrum->setReferenceLevel(refLevel);
         m_glSpectrum->setPowerRange(powerRange);
         m_glSpectrum->setLinear(m_settings.m_linear);
+        m_glSpectrum->setZoom(getZoomFrequencyOffset(), m_settings.m_zoomLog2Decim);
     }
 
     if (m_spectrumVis)
     {
-	    m_spectrumVis->configure(
-            m_settings.m_fftSize,
-            m_settings.m_refLevel,
-            m_settings.m_powerRange,
-            m_settings.m_fftOverlap,
-            getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode),
-            (SpectrumVis::AvgMode) m_settings.m_averagingMode,
-            (FFTWindow::Function) m_settings.m_fftWindow,
-            m_settings.m_linear
-		);
+        SpectrumVis::MsgConfigureSpectrumVis *msg = SpectrumVis::MsgConfigureSpectrumVis::create(m_settings, false);
+        m_spectrumVis->getInputMessageQueue()->push(msg);
     }
 }
 
@@ -220,13 +226,37 @@ void GLSpectrumGUI::on_fftSize_currentIndexChanged(int index)
 	setAveragingToolitp();
 }
 
+void GLSpectrumGUI::on_fftOverlap_valueChanged(int value)
+{
+	qDebug("GLSpectrumGUI::on_fftOverlap_valueChanged: %d", value);
+	m_settings.m_fftOverlap = value;
+	applySettings();
+	setAveragingToolitp();
+}
+
+void GLSpectrumGUI::on_zoomFactor_currentIndexChanged(int index)
+{
+	qDebug("GLSpectrumGUI::on_zoomFactor_currentIndexChanged: %d", index);
+	m_settings.m_zoomLog2Decim = index < 0 ? 0 : index;
+	ui->zoomOffset->setEnabled(m_settings.m_zoomLog2Decim > 0);
+	setZoomOffsetRange();
+	applySettings();
+	setAveragingToolitp();
+}
+
+void GLSpectrumGUI::on_zoomOffset_valueChanged(int value)
+{
+	m_settings.m_zoomFrequencyOffset = value * 1000LL;
+	applySettings();
+}
+
 void GLSpectrumGUI::on_averagingMode_currentIndexChanged(int index)
 {
 	qDebug("GLSpectrumGUI::on_averagingMode_currentIndexChanged: %d", index);
     m_settings.m_averagingMode = index < 0 ?
         GLSpectrumSettings::AvgModeNone :
-        index > 3 ?
-            GLSpectrumSettings::AvgModeMax :
+        index > 4 ?
+            GLSpectrumSettings::AvgModeWelch :
             (GLSpectrumSettings::AveragingMode) index;
 
     setAveragingCombo();
@@ -473,9 +503,10 @@ void GLSpectrumGUI::setAveragingToolitp()
     if (m_glSpectrum)
     {
         QString s;
-        float averagingTime = (m_settings.m_fftSize * (getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode) == 0 ?
+        int fftStep = (m_settings.m_fftSize * (100 - m_settings.m_fftOverlap)) / 100;
+        float averagingTime = (fftStep * (getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode) == 0 ?
             1 :
-            getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode))) / (float) m_glSpectrum->getSampleRate();
+            getAveragingValue(m_settings.m_averagingIndex, m_settings.m_averagingMode))) / (float) (m_glSpectrum->getSampleRate() >> m_settings.m_zoomLog2Decim);
         setNumberStr(averagingTime, 2, s);
         ui->averaging->setToolTip(QString("Number of averaging samples (avg time: %1s)").arg(s));
     }
@@ -485,11 +516,40 @@ void GLSpectrumGUI::setAveragingToolitp()
     }
 }
 
+void GLSpectrumGUI::setZoomOffsetRange()
+{
+    // the spin box follows the current sample rate but the requested offset is kept in the settings
+    if (m_glSpectrum && (m_glSpectrum->getSampleRate() > 0))
+    {
+        qint64 zoomMaxOffset = GLSpectrumSettings::getZoomMaxFrequencyOffset(m_glSpectrum->getSampleRate(), m_settings.m_zoomLog2Decim);
+        bool blocked = ui->zoomOffset->blockSignals(true);
+        ui->zoomOffset->setRange(-zoomMaxOffset / 1000, zoomMaxOffset / 1000);
+        ui->zoomOffset->setValue(getZoomFrequencyOffset() / 1000);
+        ui->zoomOffset->blockSignals(blocked);
+    }
+}
+
+qint64 GLSpectrumGUI::getZoomFrequencyOffset() const
+{
+    // offset effectively applied by the spectrum vis for the current sample rate
+    if (m_glSpectrum && (m_glSpectrum->getSampleRate() > 0))
+    {
+        qint64 zoomMaxOffset = GLSpectrumSettings::getZoomMaxFrequencyOffset(m_glSpectrum->getSampleRate(), m_settings.m_zoomLog2Decim);
+        return qBound(-zoomMaxOffset, m_settings.m_zoomFrequencyOffset, zoomMaxOffset);
+    }
+    else
+    {
+        return m_settings.m_zoomFrequencyOffset;
+    }
+}
+
 bool GLSpectrumGUI::handleMessage(const Message& message)
 {
     if (GLSpectrum::MsgReportSampleRate::match(message))
     {
         setAveragingToolitp();
+        setZoomOffsetRange();
+        m_glSpectrum->setZoom(getZoomFrequencyOffset(), m_settings.m_zoomLog2Decim);
         return true;
     }
     else if (SpectrumVis::MsgStartStop::match(message))
@@ -46,7 +46,8 @@ public:
         AvgModeNone,
         AvgModeMoving,
         AvgModeFixed,
-        AvgModeMax
+        AvgModeMax,
+        AvgModeWelch
     };
 
 	explicit GLSpectrumGUI(QWidget* parent = NULL);
@@ -78,6 +79,8 @@ private:
 	void setNumberStr(int n, QString& s);
 	void setNumberStr(float v, int decimalPlaces, QString& s);
 	void setAveragingToolitp();
+    void setZoomOffsetRange();
+    qint64 getZoomFrequencyOffset() const;
 	bool handleMessage(const Message& message);
 
 private slots:
@@ -90,6 +93,9 @@ private slots:
 	void on_stroke_valueChanged(int index);
 	void on_gridIntensity_valueChanged(int index);
 	void on_traceIntensity_valueChanged(int index);
+	void on_fftOverlap_valueChanged(int value);
+	void on_zoomFactor_currentIndexChanged(int index);
+	void on_zoomOffset_valueChanged(int value);
 	void on_averagingMode_currentIndexChanged(int index);
     void on_averaging_currentIndexChanged(int index);
     void on_linscale_toggled(bool checked);
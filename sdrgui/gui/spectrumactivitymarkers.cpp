@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QTimer>
+
+#include "dsp/channelmarker.h"
+#include "gui/glspectrum.h"
+
+#include "spectrumactivitymarkers.h"
+
+#define SPECTRUMACTIVITYMARKERS_TICKS 5 // refresh every 5 master timer ticks (250 ms)
+#define SPECTRUMACTIVITYMARKERS_MAX 64  // do not clutter the display beyond this number of markers
+
+SpectrumActivityMarkers::SpectrumActivityMarkers(SpectrumActivity *spectrumActivity, GLSpectrum *glSpectrum, const QTimer& timer) :
+    m_spectrumActivity(spectrumActivity),
+    m_glSpectrum(glSpectrum),
+    m_updateCount(0),
+    m_tickCount(0)
+{
+    connect(&timer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+SpectrumActivityMarkers::~SpectrumActivityMarkers()
+{
+    for (ChannelMarker *channelMarker : m_channelMarkers)
+    {
+        m_glSpectrum->removeChannelMarker(channelMarker);
+        delete channelMarker;
+    }
+}
+
+void SpectrumActivityMarkers::tick()
+{
+    if ((++m_tickCount < SPECTRUMACTIVITYMARKERS_TICKS) || (m_spectrumActivity->getUpdateCount() == m_updateCount)) {
+        return;
+    }
+
+    m_tickCount = 0;
+    m_updateCount = m_spectrumActivity->getUpdateCount();
+    // Frames are centered on the zoomed sub-band if any while channel markers are relative to the
+    // device center frequency that is the frame center minus the zoom NCO offset
+    qint64 deviceCenterFrequency = m_spectrumActivity->getSignals(m_signals) - m_glSpectrum->getZoomFrequencyOffset();
+    std::size_t nbMarkers = std::min(m_signals.size(), (std::size_t) SPECTRUMACTIVITYMARKERS_MAX);
+
+    while (m_channelMarkers.size() < nbMarkers)
+    {
+        ChannelMarker *channelMarker = new ChannelMarker();
+        channelMarker->setColor(Qt::yellow);
+        channelMarker->setMovable(false);
+        channelMarker->setVisible(false);
+        m_channelMarkers.push_back(channelMarker);
+        m_glSpectrum->addChannelMarker(channelMarker);
+    }
+
+    for (std::size_t i = 0; i < m_channelMarkers.size(); i++)
+    {
+        ChannelMarker *channelMarker = m_channelMarkers[i];
+
+        if (i >= nbMarkers)
+        {
+            if (channelMarker->getVisible()) {
+                channelMarker->setVisible(false);
+            }
+
+            continue;
+        }
+
+        const SpectrumActivity::Signal& signal = m_signals[i];
+        QString title = QString("S%1").arg(signal.m_id);
+        int offset = (int) (signal.getCenterFrequency() - deviceCenterFrequency);
+
+        // the spectrum only redraws on actual changes
+        if (channelMarker->getTitle() != title) {
+            channelMarker->setTitle(title);
+        }
+        if (channelMarker->getCenterFrequency() != offset) {
+            channelMarker->setCenterFrequency(offset);
+        }
+        if (channelMarker->getBandwidth() != signal.getBandwidth()) {
+            channelMarker->setBandwidth(signal.getBandwidth());
+        }
+        if (channelMarker->getSourceOrSinkStream() != m_glSpectrum->getDisplayedSourceOrSink())
+        {
+            channelMarker->setSourceOrSinkStream(m_glSpectrum->getDisplayedSourceOrSink());
+            channelMarker->emitChangedByAPI();
+        }
+        if (!channelMarker->streamIndexApplies(m_glSpectrum->getDisplayedStreamIndex()))
+        {
+            channelMarker->clearStreamIndexes();
+            channelMarker->addStreamIndex(m_glSpectrum->getDisplayedStreamIndex());
+            channelMarker->emitChangedByAPI();
+        }
+        if (!channelMarker->getVisible()) {
+            channelMarker->setVisible(true);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Shows the signals of the spectrum activity detector as channel markers        //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRGUI_GUI_SPECTRUMACTIVITYMARKERS_H_
+#define SDRGUI_GUI_SPECTRUMACTIVITYMARKERS_H_
+
+#include <vector>
+
+#include <QObject>
+
+#include "dsp/spectrumactivity.h"
+#include "export.h"
+
+class QTimer;
+class GLSpectrum;
+class ChannelMarker;
+
+class SDRGUI_API SpectrumActivityMarkers : public QObject
+{
+    Q_OBJECT
+public:
+    SpectrumActivityMarkers(SpectrumActivity *spectrumActivity, GLSpectrum *glSpectrum, const QTimer& timer);
+    virtual ~SpectrumActivityMarkers();
+
+private:
+    SpectrumActivity *m_spectrumActivity;
+    GLSpectrum *m_glSpectrum;
+    std::vector<ChannelMarker*> m_channelMarkers; //!< pool of markers, the ones in excess are hidden
+    std::vector<SpectrumActivity::Signal> m_signals;
+    unsigned int m_updateCount;
+    unsigned int m_tickCount;
+
+private slots:
+    void tick();
+};
+
+#endif // SDRGUI_GUI_SPECTRUMACTIVITYMARKERS_H_
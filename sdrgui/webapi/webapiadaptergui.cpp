@@ -34,6 +34,7 @@
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/spectrumhistory.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelapi.h"
@@ -59,10 +60,13 @@
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceActions.h"
+#include "SWGDeviceRecord.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGSpectrumActivity.h"
+#include "SWGSpectrumHistory.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -428,6 +432,8 @@ int WebAPIAdapterGUI::instanceAudioGet(
     outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
     outputDevices->back()->setUdpChannelCodec((int) outputDeviceInfo.udpChannelCodec);
     outputDevices->back()->setUdpDecimationFactor((int) outputDeviceInfo.udpDecimationFactor);
+    outputDevices->back()->setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    outputDevices->back()->setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
 
@@ -448,6 +454,8 @@ int WebAPIAdapterGUI::instanceAudioGet(
         outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
         outputDevices->back()->setUdpChannelCodec((int) outputDeviceInfo.udpChannelCodec);
         outputDevices->back()->setUdpDecimationFactor((int) outputDeviceInfo.udpDecimationFactor);
+        outputDevices->back()->setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+        outputDevices->back()->setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
     }
@@ -526,6 +534,12 @@ int WebAPIAdapterGUI::instanceAudioOutputPatch(
     if (audioOutputKeys.contains("udpDecimationFactor")) {
         outputDeviceInfo.udpDecimationFactor = response.getUdpDecimationFactor();
     }
+    if (audioOutputKeys.contains("udpMulticastTTL")) {
+        outputDeviceInfo.udpMulticastTTL = qBound(1, response.getUdpMulticastTtl(), 255);
+    }
+    if (audioOutputKeys.contains("udpFramesPerDatagram")) {
+        outputDeviceInfo.udpFramesPerDatagram = qBound(1, response.getUdpFramesPerDatagram(), 6);
+    }
     if (audioOutputKeys.contains("udpAddress")) {
         outputDeviceInfo.udpAddress = *response.getUdpAddress();
     }
@@ -542,6 +556,8 @@ int WebAPIAdapterGUI::instanceAudioOutputPatch(
     response.setUdpChannelMode(outputDeviceInfo.udpChannelMode);
     response.setUdpChannelCodec(outputDeviceInfo.udpChannelCodec);
     response.setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+    response.setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    response.setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
 
     if (response.getUdpAddress()) {
         *response.getUdpAddress() = outputDeviceInfo.udpAddress;
@@ -602,6 +618,8 @@ int WebAPIAdapterGUI::instanceAudioOutputDelete(
     response.setUdpChannelMode(outputDeviceInfo.udpChannelMode);
     response.setUdpChannelCodec(outputDeviceInfo.udpChannelCodec);
     response.setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+    response.setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    response.setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
 
     if (response.getUdpAddress()) {
         *response.getUdpAddress() = outputDeviceInfo.udpAddress;
@@ -2018,6 +2036,176 @@ int WebAPIAdapterGUI::devicesetChannelsReportGet(
     }
 }
 
+int WebAPIAdapterGUI::devicesetDeviceRecordGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGDeviceRecord& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_deviceAPI->webapiRecordGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceRecordPut(
+        int deviceSetIndex,
+        SWGSDRangel::SWGDeviceRecord& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_deviceAPI->webapiRecordPut(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetDeviceRecordPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        int status = deviceSet->m_deviceAPI->webapiRecordPost(*error.getMessage());
+
+        if (status/100 == 2)
+        {
+            response.init();
+            *response.getMessage() = QString("Armed recorders of device set %1 were triggered").arg(deviceSetIndex);
+        }
+
+        return status;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumActivityGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumActivity& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumActivity->webapiSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumActivityPut(
+        int deviceSetIndex,
+        const QStringList& spectrumActivityKeys,
+        SWGSDRangel::SWGSpectrumActivity& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumActivity->webapiSettingsPut(spectrumActivityKeys, response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumHistoryGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumHistory& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->webapiSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumHistoryPut(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumHistory& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->webapiSettingsPut(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumHistoryDataGet(
+        int deviceSetIndex,
+        const SpectrumHistory::Query& query,
+        const SpectrumHistory::QueryOutput& output,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->query(query, output, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
 int WebAPIAdapterGUI::devicesetChannelPost(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelSettings& query,
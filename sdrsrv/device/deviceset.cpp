@@ -19,6 +19,10 @@
 
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/spectrumvis.h"
+#include "dsp/spectrumactivity.h"
+#include "dsp/spectrumhistory.h"
+#include "dsp/spectrumwaterfall.h"
 #include "plugin/pluginapi.h"
 #include "plugin/plugininterface.h"
 #include "settings/preset.h"
@@ -34,17 +38,34 @@ DeviceSet::ChannelInstanceRegistration::ChannelInstanceRegistration(const QStrin
     m_channelAPI(channelAPI)
 {}
 
-DeviceSet::DeviceSet(int tabIndex)
+DeviceSet::DeviceSet(int tabIndex, int deviceType)
 {
     m_deviceAPI = nullptr;
     m_deviceSourceEngine = nullptr;
     m_deviceSinkEngine = nullptr;
     m_deviceMIMOEngine = nullptr;
     m_deviceTabIndex = tabIndex;
+
+    if (deviceType == 1) { // Single Tx
+        m_spectrumVis = new SpectrumVis(SDR_TX_SCALEF);
+    } else { // Single Rx or MIMO
+        m_spectrumVis = new SpectrumVis(SDR_RX_SCALEF);
+    }
+
+    m_spectrumActivity = new SpectrumActivity(); // enabled from the web API
+    m_spectrumVis->addFrameSink(m_spectrumActivity);
+    m_spectrumHistory = new SpectrumHistory(); // enabled from the web API
+    m_spectrumVis->addFrameSink(m_spectrumHistory);
+    m_spectrumWaterfall = new SpectrumWaterfall(); // enabled from the web API
+    m_spectrumVis->addFrameSink(m_spectrumWaterfall);
 }
 
 DeviceSet::~DeviceSet()
 {
+    delete m_spectrumVis;
+    delete m_spectrumActivity;
+    delete m_spectrumHistory;
+    delete m_spectrumWaterfall;
 }
 
 void DeviceSet::registerRxChannelInstance(const QString& channelName, ChannelAPI* channelAPI)
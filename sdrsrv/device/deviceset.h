@@ -24,6 +24,10 @@ class DeviceAPI;
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
 class DSPDeviceMIMOEngine;
+class SpectrumVis;
+class SpectrumActivity;
+class SpectrumHistory;
+class SpectrumWaterfall;
 class PluginAPI;
 class ChannelAPI;
 class Preset;
@@ -35,8 +39,12 @@ public:
     DSPDeviceSourceEngine *m_deviceSourceEngine;
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DSPDeviceMIMOEngine *m_deviceMIMOEngine;
+    SpectrumVis *m_spectrumVis;         //!< no display: feeds the spectrum frame sinks only
+    SpectrumActivity *m_spectrumActivity;
+    SpectrumHistory *m_spectrumHistory;
+    SpectrumWaterfall *m_spectrumWaterfall;
 
-    DeviceSet(int tabIndex);
+    DeviceSet(int tabIndex, int deviceType);
     ~DeviceSet();
 
     int getNumberOfChannels() const { return m_channelInstanceRegistrations.size(); }
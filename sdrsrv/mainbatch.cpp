@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+
+#include "SWGDeviceSettings.h"
+#include "SWGFileInputSettings.h"
+#include "SWGDeviceState.h"
+#include "SWGDeviceReport.h"
+#include "SWGFileInputReport.h"
+
+#include "audio/audiodevicemanager.h"
+#include "dsp/dspengine.h"
+#include "dsp/devicesamplesource.h"
+#include "device/deviceapi.h"
+#include "device/deviceset.h"
+#include "settings/preset.h"
+#include "mainparser.h"
+#include "maincore.h"
+#include "mainbatch.h"
+
+MainBatch::MainBatch(MainCore& mainCore, const MainParser& parser, QObject *parent) :
+    QObject(parent),
+    m_mainCore(mainCore),
+    m_presetNames(parser.getBatchPresets()),
+    m_inputFileName(QFileInfo(parser.getBatchInput()).absoluteFilePath()),
+    m_outputDirectory(QFileInfo(parser.getBatchOutput()).absoluteFilePath()),
+    m_pollCount(0),
+    m_lastAudioSamples(0),
+    m_settleCount(0)
+{
+    connect(&m_pollTimer, SIGNAL(timeout()), this, SLOT(poll()));
+    QTimer::singleShot(0, this, SLOT(start())); // when the event loop runs
+}
+
+MainBatch::~MainBatch()
+{
+    m_pollTimer.stop();
+}
+
+void MainBatch::start()
+{
+    qInfo("MainBatch::start: %s with %d presets to %s",
+        qPrintable(m_inputFileName), m_presetNames.size(), qPrintable(m_outputDirectory));
+
+    if (!QFileInfo(m_inputFileName).exists())
+    {
+        qCritical("MainBatch::start: %s not found", qPrintable(m_inputFileName));
+        finish(1);
+        return;
+    }
+
+    if (!QDir().mkpath(m_outputDirectory))
+    {
+        qCritical("MainBatch::start: cannot create %s", qPrintable(m_outputDirectory));
+        finish(1);
+        return;
+    }
+
+    // before channels are created
+    DSPEngine::instance()->getAudioDeviceManager()->setFileOutput(m_outputDirectory);
+
+    for (const auto& presetName : m_presetNames)
+    {
+        m_items.push_back(BatchItem());
+        BatchItem& item = m_items.back();
+        item.m_presetName = presetName;
+        item.m_deviceSetIndex = -1;
+        item.m_nbChannels = 0;
+        item.m_sampleRate = 0;
+        item.m_nbSamples = 0;
+        item.m_endOfFile = false;
+
+        if (!startItem(item))
+        {
+            finish(1);
+            return;
+        }
+    }
+
+    m_elapsedTimer.start();
+    m_pollTimer.start(m_pollPeriodMs);
+}
+
+const Preset *MainBatch::findPreset(const QString& presetName) const
+{
+    const MainSettings& settings = m_mainCore.m_settings;
+
+    for (int i = 0; i < settings.getPresetCount(); i++)
+    {
+        const Preset *preset = settings.getPreset(i);
+
+        if ((preset->getDescription() == presetName)
+         || (preset->getGroup() + "/" + preset->getDescription() == presetName)) {
+            return preset;
+        }
+    }
+
+    return nullptr;
+}
+
+bool MainBatch::startItem(BatchItem& item)
+{
+    const Preset *preset = findPreset(item.m_presetName);
+
+    if (!preset)
+    {
+        qCritical("MainBatch::startItem: preset %s not found", qPrintable(item.m_presetName));
+        return false;
+    }
+
+    if (!preset->isSourcePreset())
+    {
+        qCritical("MainBatch::startItem: preset %s is not a receive preset", qPrintable(item.m_presetName));
+        return false;
+    }
+
+    // the device set has a File Input by default. The preset device settings apply only if they are for a File Input
+    item.m_deviceSetIndex = m_mainCore.m_deviceSets.size();
+    DSPEngine::instance()->getAudioDeviceManager()->getWavWriter().setFilePrefix(QString("ds%1_").arg(item.m_deviceSetIndex));
+    m_mainCore.addSourceDevice();
+    m_mainCore.loadPresetSettings(preset, item.m_deviceSetIndex);
+    DeviceSet *deviceSet = m_mainCore.m_deviceSets[item.m_deviceSetIndex];
+    item.m_nbChannels = deviceSet->getNumberOfChannels();
+
+    DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
+    QString errorMessage;
+    QStringList deviceSettingsKeys;
+    deviceSettingsKeys << "fileName" << "loop" << "unthrottled";
+    SWGSDRangel::SWGDeviceSettings deviceSettings;
+    deviceSettings.setFileInputSettings(new SWGSDRangel::SWGFileInputSettings());
+    deviceSettings.getFileInputSettings()->init();
+    *deviceSettings.getFileInputSettings()->getFileName() = m_inputFileName;
+    deviceSettings.getFileInputSettings()->setLoop(0);
+    deviceSettings.getFileInputSettings()->setUnthrottled(1); // as fast as the channels can process
+    int status = source->webapiSettingsPutPatch(false, deviceSettingsKeys, deviceSettings, errorMessage);
+
+    if (status/100 != 2)
+    {
+        qCritical("MainBatch::startItem: preset %s: cannot set input file %s: %s",
+            qPrintable(item.m_presetName), qPrintable(m_inputFileName), qPrintable(errorMessage));
+        return false;
+    }
+
+    SWGSDRangel::SWGDeviceState deviceState;
+    deviceState.init();
+    status = source->webapiRun(true, deviceState, errorMessage);
+
+    if (status/100 != 2)
+    {
+        qCritical("MainBatch::startItem: preset %s: cannot start the device: %s",
+            qPrintable(item.m_presetName), qPrintable(errorMessage));
+        return false;
+    }
+
+    qInfo("MainBatch::startItem: preset %s in device set %d with %d channels",
+        qPrintable(item.m_presetName), item.m_deviceSetIndex, item.m_nbChannels);
+    return true;
+}
+
+void MainBatch::poll()
+{
+    m_pollCount++;
+    bool endOfFile = true;
+
+    for (auto& item : m_items)
+    {
+        QString errorMessage;
+
+        if (!pollItem(item, errorMessage))
+        {
+            qCritical("MainBatch::poll: preset %s: %s", qPrintable(item.m_presetName), qPrintable(errorMessage));
+            finish(1);
+            return;
+        }
+
+        endOfFile = endOfFile && item.m_endOfFile;
+    }
+
+    if (!endOfFile) {
+        return;
+    }
+
+    // the samples in the FIFOs of the DSP chains are still processed after the end of file
+    quint64 audioSamples = DSPEngine::instance()->getAudioDeviceManager()->getWavWriter().getTotalSamples();
+
+    if (audioSamples != m_lastAudioSamples)
+    {
+        m_lastAudioSamples = audioSamples;
+        m_settleCount = 0;
+        return;
+    }
+
+    if (++m_settleCount < m_settlePolls) {
+        return;
+    }
+
+    finish(0);
+}
+
+bool MainBatch::pollItem(BatchItem& item, QString& errorMessage)
+{
+    DeviceAPI *deviceAPI = m_mainCore.m_deviceSets[item.m_deviceSetIndex]->m_deviceAPI;
+    QString state;
+    deviceAPI->getDeviceEngineStateStr(state);
+
+    if (state == "error")
+    {
+        errorMessage = deviceAPI->errorMessage();
+        return false;
+    }
+
+    if ((state != "running") && (m_pollCount > m_startTimeoutPolls))
+    {
+        errorMessage = QString("device is %1").arg(state);
+        return false;
+    }
+
+    SWGSDRangel::SWGDeviceReport deviceReport;
+    deviceAPI->getSampleSource()->webapiReportGet(deviceReport, errorMessage);
+    SWGSDRangel::SWGFileInputReport *fileInputReport = deviceReport.getFileInputReport();
+
+    if (!fileInputReport)
+    {
+        errorMessage = QString("source is not a File Input");
+        return false;
+    }
+
+    item.m_sampleRate = fileInputReport->getSampleRate();
+    item.m_nbSamples = fileInputReport->getSamplesCount();
+    item.m_endOfFile = fileInputReport->getEndOfFile() != 0;
+    return true;
+}
+
+void MainBatch::finish(int exitCode)
+{
+    m_pollTimer.stop();
+
+    for (const auto& item : m_items)
+    {
+        if (item.m_deviceSetIndex >= 0) {
+            m_mainCore.m_deviceSets[item.m_deviceSetIndex]->m_deviceAPI->stopDeviceEngine();
+        }
+    }
+
+    DSPEngine::instance()->getAudioDeviceManager()->getWavWriter().close(); // completes the WAV files
+
+    if (exitCode == 0) {
+        printStats();
+    }
+
+    QCoreApplication::exit(exitCode);
+}
+
+void MainBatch::printStats()
+{
+    double elapsed = m_elapsedTimer.elapsed() / 1000.0;
+    double recordTime = 0.0;
+
+    for (const auto& item : m_items)
+    {
+        double itemRecordTime = item.m_sampleRate > 0 ? (double) item.m_nbSamples / item.m_sampleRate : 0.0;
+        recordTime = std::max(recordTime, itemRecordTime);
+        qInfo("MainBatch: device set %d: preset %s: %d channels: %llu samples at %d S/s: %.3f s of recording",
+            item.m_deviceSetIndex, qPrintable(item.m_presetName), item.m_nbChannels,
+            item.m_nbSamples, item.m_sampleRate, itemRecordTime);
+    }
+
+    std::vector<AudioWavWriter::FileStats> audioStats;
+    DSPEngine::instance()->getAudioDeviceManager()->getWavWriter().getStats(audioStats);
+
+    for (const auto& fileStats : audioStats)
+    {
+        qInfo("MainBatch: %s: %llu samples at %u S/s: %.3f s",
+            qPrintable(fileStats.m_fileName), fileStats.m_nbSamples, fileStats.m_sampleRate,
+            fileStats.m_sampleRate > 0 ? (double) fileStats.m_nbSamples / fileStats.m_sampleRate : 0.0);
+    }
+
+    qInfo("MainBatch: %.3f s of recording processed in %.3f s (x%.1f real time)",
+        recordTime, elapsed, elapsed > 0.0 ? recordTime / elapsed : 0.0);
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2020 Edouard Griffiths, F4EXB.                                  //
+//                                                                               //
+// Offline batch processing of an I/Q recording with presets                     //
+//                                                                               //
+// Each preset is loaded in its own device set with a File Input source playing  //
+// the recording unthrottled. Audio goes to WAV files instead of the audio       //
+// devices. The application exits when all device sets have reached the end of   //
+// the file with processing statistics.                                          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRSRV_MAINBATCH_H_
+#define SDRSRV_MAINBATCH_H_
+
+#include <vector>
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include "export.h"
+
+class MainCore;
+class MainParser;
+class Preset;
+
+class SDRSRV_API MainBatch : public QObject {
+    Q_OBJECT
+
+public:
+    MainBatch(MainCore& mainCore, const MainParser& parser, QObject *parent = nullptr);
+    ~MainBatch();
+
+private:
+    struct BatchItem
+    {
+        QString m_presetName;
+        int m_deviceSetIndex;
+        int m_nbChannels;
+        int m_sampleRate;
+        quint64 m_nbSamples;  //!< samples read from the file
+        bool m_endOfFile;
+    };
+
+    MainCore& m_mainCore;
+    QStringList m_presetNames;
+    QString m_inputFileName;
+    QString m_outputDirectory;
+    std::vector<BatchItem> m_items;
+    QTimer m_pollTimer;
+    QElapsedTimer m_elapsedTimer;
+    int m_pollCount;
+    quint64 m_lastAudioSamples;
+    int m_settleCount;                 //!< polls without new audio after the end of file
+
+    static const int m_pollPeriodMs = 100;
+    static const int m_startTimeoutPolls = 50;  //!< device sets must be running within this number of polls
+    static const int m_settlePolls = 5;         //!< polls without new audio to consider the DSP chains drained
+
+    const Preset *findPreset(const QString& presetName) const;
+    bool startItem(BatchItem& item);
+    bool pollItem(BatchItem& item, QString& errorMessage);
+    void finish(int exitCode);
+    void printStats();
+
+private slots:
+    void start();
+    void poll();
+};
+
+#endif // SDRSRV_MAINBATCH_H_
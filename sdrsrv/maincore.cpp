@@ -25,6 +25,7 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
+#include "dsp/spectrumvis.h"
 #include "device/deviceapi.h"
 #include "device/deviceset.h"
 #include "device/deviceenumerator.h"
@@ -35,6 +36,7 @@
 #include "webapi/webapiadaptersrv.h"
 
 #include "maincore.h"
+#include "mainbatch.h"
 
 MESSAGE_CLASS_DEFINITION(MainCore::MsgDeleteInstance, Message)
 MESSAGE_CLASS_DEFINITION(MainCore::MsgLoadPreset, Message)
@@ -55,7 +57,11 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_masterTabIndex(-1),
     m_dspEngine(DSPEngine::instance()),
     m_lastEngineState(DSPDeviceSourceEngine::StNotStarted),
-    m_logger(logger)
+    m_logger(logger),
+    m_requestMapper(nullptr),
+    m_apiServer(nullptr),
+    m_apiAdapter(nullptr),
+    m_batch(nullptr)
 {
     qDebug() << "MainCore::MainCore: start";
 
@@ -79,11 +85,19 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     qDebug() << "MainCore::MainCore: finishing...";
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
 
-    m_apiAdapter = new WebAPIAdapterSrv(*this);
-    m_requestMapper = new WebAPIRequestMapper(this);
-    m_requestMapper->setAdapter(m_apiAdapter);
-    m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
-    m_apiServer->start();
+    if (parser.isBatch())
+    {
+        // several batches can run at the same time
+        m_batch = new MainBatch(*this, parser, this);
+    }
+    else
+    {
+        m_apiAdapter = new WebAPIAdapterSrv(*this);
+        m_requestMapper = new WebAPIRequestMapper(this);
+        m_requestMapper->setAdapter(m_apiAdapter);
+        m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+        m_apiServer->start();
+    }
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
 
@@ -96,11 +110,14 @@ MainCore::~MainCore()
         removeLastDevice();
     }
 
-	m_apiServer->stop();
-	m_settings.save();
-    delete m_apiServer;
-    delete m_requestMapper;
-    delete m_apiAdapter;
+    if (m_apiServer)
+    {
+        m_apiServer->stop();
+        m_settings.save(); // batch mode leaves the settings untouched
+        delete m_apiServer;
+        delete m_requestMapper;
+        delete m_apiAdapter;
+    }
 
     delete m_pluginManager;
 
@@ -285,10 +302,11 @@ void MainCore::addSinkDevice()
     sprintf(uidCStr, "UID:%d", dspDeviceSinkEngineUID);
 
     int deviceTabIndex = m_deviceSets.size();
-    m_deviceSets.push_back(new DeviceSet(deviceTabIndex));
+    m_deviceSets.push_back(new DeviceSet(deviceTabIndex, 1));
     m_deviceSets.back()->m_deviceSourceEngine = nullptr;
     m_deviceSets.back()->m_deviceSinkEngine = dspDeviceSinkEngine;
     m_deviceSets.back()->m_deviceMIMOEngine = nullptr;
+    dspDeviceSinkEngine->addSpectrumSink(m_deviceSets.back()->m_spectrumVis);
 
     char tabNameCStr[16];
     sprintf(tabNameCStr, "T%d", deviceTabIndex);
@@ -331,10 +349,11 @@ void MainCore::addSourceDevice()
     sprintf(uidCStr, "UID:%d", dspDeviceSourceEngineUID);
 
     int deviceTabIndex = m_deviceSets.size();
-    m_deviceSets.push_back(new DeviceSet(deviceTabIndex));
+    m_deviceSets.push_back(new DeviceSet(deviceTabIndex, 0));
     m_deviceSets.back()->m_deviceSourceEngine = dspDeviceSourceEngine;
     m_deviceSets.back()->m_deviceSinkEngine = nullptr;
     m_deviceSets.back()->m_deviceMIMOEngine = nullptr;
+    dspDeviceSourceEngine->addSink(m_deviceSets.back()->m_spectrumVis);
 
     char tabNameCStr[16];
     sprintf(tabNameCStr, "R%d", deviceTabIndex);
@@ -372,6 +391,7 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSourceEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSourceEngine;
         lastDeviceEngine->stopAcquistion();
+        lastDeviceEngine->removeSink(m_deviceSets.back()->m_spectrumVis);
 
         // deletes old UI and input object
         m_deviceSets.back()->freeChannels();      // destroys the channel instances
@@ -392,6 +412,7 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSinkEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSinkEngine;
         lastDeviceEngine->stopGeneration();
+        lastDeviceEngine->removeSpectrumSink(m_deviceSets.back()->m_spectrumVis);
 
         // deletes old UI and output object
         m_deviceSets.back()->freeChannels();
@@ -653,6 +674,13 @@ void MainCore::loadPresetSettings(const Preset* preset, int tabIndex)
 	{
         DeviceSet *deviceSet = m_deviceSets[tabIndex];
         deviceSet->m_deviceAPI->loadSamplingDeviceSettings(preset);
+        GLSpectrumSettings spectrumSettings;
+
+        if (spectrumSettings.deserialize(preset->getSpectrumConfig()))
+        {
+            SpectrumVis::MsgConfigureSpectrumVis *msg = SpectrumVis::MsgConfigureSpectrumVis::create(spectrumSettings, false);
+            deviceSet->m_spectrumVis->getInputMessageQueue()->push(msg);
+        }
 
         if (deviceSet->m_deviceSourceEngine) { // source device
         	deviceSet->loadRxChannelSettings(preset, m_pluginManager->getPluginAPI());
@@ -40,6 +40,7 @@ class DeviceSet;
 class WebAPIRequestMapper;
 class WebAPIServer;
 class WebAPIAdapterSrv;
+class MainBatch;
 
 namespace qtwebapp {
     class LoggerWithFile;
@@ -69,6 +70,7 @@ public:
     void deleteChannel(int deviceSetIndex, int channelIndex);
 
     friend class WebAPIAdapterSrv;
+    friend class MainBatch;
 
 signals:
     void finished();
@@ -297,6 +299,7 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     WebAPIServer *m_apiServer;
     WebAPIAdapterSrv *m_apiAdapter;
+    MainBatch *m_batch;            //!< batch mode runner. No API server in batch mode
 
 	void loadSettings();
     void applySettings();
@@ -37,10 +37,14 @@
 #include "SWGPresetTransfer.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceActions.h"
+#include "SWGDeviceRecord.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelActions.h"
+#include "SWGSpectrumActivity.h"
+#include "SWGSpectrumHistory.h"
+#include "SWGSpectrumWaterfall.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -61,6 +65,7 @@
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/spectrumhistory.h"
 #include "channel/channelapi.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
@@ -423,6 +428,8 @@ int WebAPIAdapterSrv::instanceAudioGet(
     outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
     outputDevices->back()->setUdpChannelCodec((int) outputDeviceInfo.udpChannelCodec);
     outputDevices->back()->setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+    outputDevices->back()->setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    outputDevices->back()->setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
     *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
     outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
 
@@ -443,6 +450,8 @@ int WebAPIAdapterSrv::instanceAudioGet(
         outputDevices->back()->setUdpChannelMode((int) outputDeviceInfo.udpChannelMode);
         outputDevices->back()->setUdpChannelCodec((int) outputDeviceInfo.udpChannelCodec);
         outputDevices->back()->setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+        outputDevices->back()->setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+        outputDevices->back()->setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
         *outputDevices->back()->getUdpAddress() = outputDeviceInfo.udpAddress;
         outputDevices->back()->setUdpPort(outputDeviceInfo.udpPort);
     }
@@ -521,6 +530,12 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     if (audioOutputKeys.contains("udpDecimationFactor")) {
         outputDeviceInfo.udpDecimationFactor = response.getUdpDecimationFactor();
     }
+    if (audioOutputKeys.contains("udpMulticastTTL")) {
+        outputDeviceInfo.udpMulticastTTL = qBound(1, response.getUdpMulticastTtl(), 255);
+    }
+    if (audioOutputKeys.contains("udpFramesPerDatagram")) {
+        outputDeviceInfo.udpFramesPerDatagram = qBound(1, response.getUdpFramesPerDatagram(), 6);
+    }
     if (audioOutputKeys.contains("udpAddress")) {
         outputDeviceInfo.udpAddress = *response.getUdpAddress();
     }
@@ -537,6 +552,8 @@ int WebAPIAdapterSrv::instanceAudioOutputPatch(
     response.setUdpChannelMode(outputDeviceInfo.udpChannelMode);
     response.setUdpChannelCodec(outputDeviceInfo.udpChannelCodec);
     response.setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+    response.setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    response.setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
 
     if (response.getUdpAddress()) {
         *response.getUdpAddress() = outputDeviceInfo.udpAddress;
@@ -597,6 +614,8 @@ int WebAPIAdapterSrv::instanceAudioOutputDelete(
     response.setUdpChannelMode(outputDeviceInfo.udpChannelMode);
     response.setUdpChannelCodec(outputDeviceInfo.udpChannelCodec);
     response.setUdpDecimationFactor(outputDeviceInfo.udpDecimationFactor);
+    response.setUdpMulticastTtl(outputDeviceInfo.udpMulticastTTL);
+    response.setUdpFramesPerDatagram(outputDeviceInfo.udpFramesPerDatagram);
 
     if (response.getUdpAddress()) {
         *response.getUdpAddress() = outputDeviceInfo.udpAddress;
@@ -2121,6 +2140,237 @@ int WebAPIAdapterSrv::devicesetChannelsReportGet(
     }
 }
 
+int WebAPIAdapterSrv::devicesetDeviceRecordGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGDeviceRecord& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_deviceAPI->webapiRecordGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetDeviceRecordPut(
+        int deviceSetIndex,
+        SWGSDRangel::SWGDeviceRecord& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_deviceAPI->webapiRecordPut(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetDeviceRecordPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        int status = deviceSet->m_deviceAPI->webapiRecordPost(*error.getMessage());
+
+        if (status/100 == 2)
+        {
+            response.init();
+            *response.getMessage() = QString("Armed recorders of device set %1 were triggered").arg(deviceSetIndex);
+        }
+
+        return status;
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumActivityGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumActivity& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumActivity->webapiSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumActivityPut(
+        int deviceSetIndex,
+        const QStringList& spectrumActivityKeys,
+        SWGSDRangel::SWGSpectrumActivity& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumActivity->webapiSettingsPut(spectrumActivityKeys, response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumHistoryGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumHistory& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->webapiSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumHistoryPut(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumHistory& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->webapiSettingsPut(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumHistoryDataGet(
+        int deviceSetIndex,
+        const SpectrumHistory::Query& query,
+        const SpectrumHistory::QueryOutput& output,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumHistory->query(query, output, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumWaterfallGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumWaterfall& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumWaterfall->webapiSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumWaterfallPut(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumWaterfall& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumWaterfall->webapiSettingsPut(response, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumWaterfallTileGet(
+        int deviceSetIndex,
+        const SpectrumWaterfall::TileQuery& query,
+        SpectrumWaterfall::Tile& tile,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+        error.init();
+        return deviceSet->m_spectrumWaterfall->getTile(query, tile, *error.getMessage());
+    }
+    else
+    {
+        error.init();
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+
+        return 404;
+    }
+}
+
 int WebAPIAdapterSrv::devicesetChannelPost(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelSettings& query,
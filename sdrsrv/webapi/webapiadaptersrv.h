@@ -290,6 +290,64 @@ public:
             SWGSDRangel::SWGChannelsDetail& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetDeviceRecordGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceRecordPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGDeviceRecord& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetDeviceRecordPost(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSuccessResponse& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumActivityGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumActivity& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumActivityPut(
+            int deviceSetIndex,
+            const QStringList& spectrumActivityKeys,
+            SWGSDRangel::SWGSpectrumActivity& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumHistoryGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumHistory& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumHistoryPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumHistory& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumHistoryDataGet(
+            int deviceSetIndex,
+            const SpectrumHistory::Query& query,
+            const SpectrumHistory::QueryOutput& output,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumWaterfallGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumWaterfallPut(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumWaterfall& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int devicesetSpectrumWaterfallTileGet(
+            int deviceSetIndex,
+            const SpectrumWaterfall::TileQuery& query,
+            SpectrumWaterfall::Tile& tile,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetChannelPost(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelSettings& query,
@@ -48,6 +48,10 @@ SWGAudioOutputDevice::SWGAudioOutputDevice() {
     m_udp_channel_codec_isSet = false;
     udp_decimation_factor = 0;
     m_udp_decimation_factor_isSet = false;
+    udp_multicast_ttl = 0;
+    m_udp_multicast_ttl_isSet = false;
+    udp_frames_per_datagram = 0;
+    m_udp_frames_per_datagram_isSet = false;
     udp_address = nullptr;
     m_udp_address_isSet = false;
     udp_port = 0;
@@ -80,6 +84,10 @@ SWGAudioOutputDevice::init() {
     m_udp_channel_codec_isSet = false;
     udp_decimation_factor = 0;
     m_udp_decimation_factor_isSet = false;
+    udp_multicast_ttl = 0;
+    m_udp_multicast_ttl_isSet = false;
+    udp_frames_per_datagram = 0;
+    m_udp_frames_per_datagram_isSet = false;
     udp_address = new QString("");
     m_udp_address_isSet = false;
     udp_port = 0;
@@ -100,6 +108,8 @@ SWGAudioOutputDevice::cleanup() {
 
 
 
+
+
     if(udp_address != nullptr) { 
         delete udp_address;
     }
@@ -137,6 +147,10 @@ SWGAudioOutputDevice::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&udp_decimation_factor, pJson["udpDecimationFactor"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&udp_multicast_ttl, pJson["udpMulticastTTL"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&udp_frames_per_datagram, pJson["udpFramesPerDatagram"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&udp_address, pJson["udpAddress"], "QString", "QString");
     
     ::SWGSDRangel::setValue(&udp_port, pJson["udpPort"], "qint32", "");
@@ -187,6 +201,12 @@ SWGAudioOutputDevice::asJsonObject() {
     if(m_udp_decimation_factor_isSet){
         obj->insert("udpDecimationFactor", QJsonValue(udp_decimation_factor));
     }
+    if(m_udp_multicast_ttl_isSet){
+        obj->insert("udpMulticastTTL", QJsonValue(udp_multicast_ttl));
+    }
+    if(m_udp_frames_per_datagram_isSet){
+        obj->insert("udpFramesPerDatagram", QJsonValue(udp_frames_per_datagram));
+    }
     if(udp_address != nullptr && *udp_address != QString("")){
         toJsonValue(QString("udpAddress"), udp_address, obj, QString("QString"));
     }
@@ -297,6 +317,26 @@ SWGAudioOutputDevice::setUdpDecimationFactor(qint32 udp_decimation_factor) {
     this->m_udp_decimation_factor_isSet = true;
 }
 
+qint32
+SWGAudioOutputDevice::getUdpMulticastTtl() {
+    return udp_multicast_ttl;
+}
+void
+SWGAudioOutputDevice::setUdpMulticastTtl(qint32 udp_multicast_ttl) {
+    this->udp_multicast_ttl = udp_multicast_ttl;
+    this->m_udp_multicast_ttl_isSet = true;
+}
+
+qint32
+SWGAudioOutputDevice::getUdpFramesPerDatagram() {
+    return udp_frames_per_datagram;
+}
+void
+SWGAudioOutputDevice::setUdpFramesPerDatagram(qint32 udp_frames_per_datagram) {
+    this->udp_frames_per_datagram = udp_frames_per_datagram;
+    this->m_udp_frames_per_datagram_isSet = true;
+}
+
 QString*
 SWGAudioOutputDevice::getUdpAddress() {
     return udp_address;
@@ -352,6 +392,12 @@ SWGAudioOutputDevice::isSet(){
         if(m_udp_decimation_factor_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_udp_multicast_ttl_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_udp_frames_per_datagram_isSet){
+            isObjectUpdated = true; break;
+        }
         if(udp_address && *udp_address != QString("")){
             isObjectUpdated = true; break;
         }
@@ -72,6 +72,12 @@ public:
     qint32 getUdpDecimationFactor();
     void setUdpDecimationFactor(qint32 udp_decimation_factor);
 
+    qint32 getUdpMulticastTtl();
+    void setUdpMulticastTtl(qint32 udp_multicast_ttl);
+
+    qint32 getUdpFramesPerDatagram();
+    void setUdpFramesPerDatagram(qint32 udp_frames_per_datagram);
+
     QString* getUdpAddress();
     void setUdpAddress(QString* udp_address);
 
@@ -112,6 +118,12 @@ private:
     qint32 udp_decimation_factor;
     bool m_udp_decimation_factor_isSet;
 
+    qint32 udp_multicast_ttl;
+    bool m_udp_multicast_ttl_isSet;
+
+    qint32 udp_frames_per_datagram;
+    bool m_udp_frames_per_datagram_isSet;
+
     QString* udp_address;
     bool m_udp_address_isSet;
 
@@ -56,6 +56,8 @@ SWGChannelReport::SWGChannelReport() {
     m_nfm_mod_report_isSet = false;
     ssb_demod_report = nullptr;
     m_ssb_demod_report_isSet = false;
+    remote_sink_report = nullptr;
+    m_remote_sink_report_isSet = false;
     remote_source_report = nullptr;
     m_remote_source_report_isSet = false;
     ssb_mod_report = nullptr;
@@ -104,6 +106,8 @@ SWGChannelReport::init() {
     m_nfm_mod_report_isSet = false;
     ssb_demod_report = new SWGSSBDemodReport();
     m_ssb_demod_report_isSet = false;
+    remote_sink_report = new SWGRemoteSinkReport();
+    m_remote_sink_report_isSet = false;
     remote_source_report = new SWGRemoteSourceReport();
     m_remote_source_report_isSet = false;
     ssb_mod_report = new SWGSSBModReport();
@@ -160,6 +164,9 @@ SWGChannelReport::cleanup() {
     if(ssb_demod_report != nullptr) { 
         delete ssb_demod_report;
     }
+    if(remote_sink_report != nullptr) { 
+        delete remote_sink_report;
+    }
     if(remote_source_report != nullptr) { 
         delete remote_source_report;
     }
@@ -219,6 +226,8 @@ SWGChannelReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&ssb_demod_report, pJson["SSBDemodReport"], "SWGSSBDemodReport", "SWGSSBDemodReport");
     
+    ::SWGSDRangel::setValue(&remote_sink_report, pJson["RemoteSinkReport"], "SWGRemoteSinkReport", "SWGRemoteSinkReport");
+    
     ::SWGSDRangel::setValue(&remote_source_report, pJson["RemoteSourceReport"], "SWGRemoteSourceReport", "SWGRemoteSourceReport");
     
     ::SWGSDRangel::setValue(&ssb_mod_report, pJson["SSBModReport"], "SWGSSBModReport", "SWGSSBModReport");
@@ -289,6 +298,9 @@ SWGChannelReport::asJsonObject() {
     if((ssb_demod_report != nullptr) && (ssb_demod_report->isSet())){
         toJsonValue(QString("SSBDemodReport"), ssb_demod_report, obj, QString("SWGSSBDemodReport"));
     }
+    if((remote_sink_report != nullptr) && (remote_sink_report->isSet())){
+        toJsonValue(QString("RemoteSinkReport"), remote_sink_report, obj, QString("SWGRemoteSinkReport"));
+    }
     if((remote_source_report != nullptr) && (remote_source_report->isSet())){
         toJsonValue(QString("RemoteSourceReport"), remote_source_report, obj, QString("SWGRemoteSourceReport"));
     }
@@ -451,6 +463,16 @@ SWGChannelReport::setSsbDemodReport(SWGSSBDemodReport* ssb_demod_report) {
     this->m_ssb_demod_report_isSet = true;
 }
 
+SWGRemoteSinkReport*
+SWGChannelReport::getRemoteSinkReport() {
+    return remote_sink_report;
+}
+void
+SWGChannelReport::setRemoteSinkReport(SWGRemoteSinkReport* remote_sink_report) {
+    this->remote_sink_report = remote_sink_report;
+    this->m_remote_sink_report_isSet = true;
+}
+
 SWGRemoteSourceReport*
 SWGChannelReport::getRemoteSourceReport() {
     return remote_source_report;
@@ -558,6 +580,9 @@ SWGChannelReport::isSet(){
         if(ssb_demod_report && ssb_demod_report->isSet()){
             isObjectUpdated = true; break;
         }
+        if(remote_sink_report && remote_sink_report->isSet()){
+            isObjectUpdated = true; break;
+        }
         if(remote_source_report && remote_source_report->isSet()){
             isObjectUpdated = true; break;
         }
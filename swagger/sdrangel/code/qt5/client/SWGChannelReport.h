@@ -33,6 +33,7 @@
 #include "SWGFreqTrackerReport.h"
 #include "SWGNFMDemodReport.h"
 #include "SWGNFMModReport.h"
+#include "SWGRemoteSinkReport.h"
 #include "SWGRemoteSourceReport.h"
 #include "SWGSSBDemodReport.h"
 #include "SWGSSBModReport.h"
@@ -102,6 +103,9 @@ public:
     SWGSSBDemodReport* getSsbDemodReport();
     void setSsbDemodReport(SWGSSBDemodReport* ssb_demod_report);
 
+    SWGRemoteSinkReport* getRemoteSinkReport();
+    void setRemoteSinkReport(SWGRemoteSinkReport* remote_sink_report);
+
     SWGRemoteSourceReport* getRemoteSourceReport();
     void setRemoteSourceReport(SWGRemoteSourceReport* remote_source_report);
 
@@ -166,6 +170,9 @@ private:
     SWGSSBDemodReport* ssb_demod_report;
     bool m_ssb_demod_report_isSet;
 
+    SWGRemoteSinkReport* remote_sink_report;
+    bool m_remote_sink_report_isSet;
+
     SWGRemoteSourceReport* remote_source_report;
     bool m_remote_source_report_isSet;
 
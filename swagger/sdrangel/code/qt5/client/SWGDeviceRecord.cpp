@@ -0,0 +1,481 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGDeviceRecord.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceRecord::SWGDeviceRecord(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceRecord::SWGDeviceRecord() {
+    buffer_size_mb = 0;
+    m_buffer_size_mb_isSet = false;
+    block_size_kb = 0;
+    m_block_size_kb_isSet = false;
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    preallocate_mb = 0;
+    m_preallocate_mb_isSet = false;
+    recorders = nullptr;
+    m_recorders_isSet = false;
+    compression = 0;
+    m_compression_isSet = false;
+    compression_threads = 0;
+    m_compression_threads_isSet = false;
+    chunk_samples = 0;
+    m_chunk_samples_isSet = false;
+    sig_mf = 0;
+    m_sig_mf_isSet = false;
+    triggered = 0;
+    m_triggered_isSet = false;
+    pre_trigger_time = 0.0f;
+    m_pre_trigger_time_isSet = false;
+    hang_time = 0.0f;
+    m_hang_time_isSet = false;
+    level_trigger = 0;
+    m_level_trigger_isSet = false;
+    trigger_level = 0.0f;
+    m_trigger_level_isSet = false;
+    segment_time = 0;
+    m_segment_time_isSet = false;
+    segment_size_mb = 0;
+    m_segment_size_mb_isSet = false;
+    quota_mb = 0;
+    m_quota_mb_isSet = false;
+}
+
+SWGDeviceRecord::~SWGDeviceRecord() {
+    this->cleanup();
+}
+
+void
+SWGDeviceRecord::init() {
+    buffer_size_mb = 0;
+    m_buffer_size_mb_isSet = false;
+    block_size_kb = 0;
+    m_block_size_kb_isSet = false;
+    direct_io = 0;
+    m_direct_io_isSet = false;
+    preallocate_mb = 0;
+    m_preallocate_mb_isSet = false;
+    recorders = new QList<SWGFileRecordReport*>();
+    m_recorders_isSet = false;
+    compression = 0;
+    m_compression_isSet = false;
+    compression_threads = 0;
+    m_compression_threads_isSet = false;
+    chunk_samples = 0;
+    m_chunk_samples_isSet = false;
+    sig_mf = 0;
+    m_sig_mf_isSet = false;
+    triggered = 0;
+    m_triggered_isSet = false;
+    pre_trigger_time = 0.0f;
+    m_pre_trigger_time_isSet = false;
+    hang_time = 0.0f;
+    m_hang_time_isSet = false;
+    level_trigger = 0;
+    m_level_trigger_isSet = false;
+    trigger_level = 0.0f;
+    m_trigger_level_isSet = false;
+    segment_time = 0;
+    m_segment_time_isSet = false;
+    segment_size_mb = 0;
+    m_segment_size_mb_isSet = false;
+    quota_mb = 0;
+    m_quota_mb_isSet = false;
+}
+
+void
+SWGDeviceRecord::cleanup() {
+
+
+
+
+    if(recorders != nullptr) { 
+        auto arr = recorders;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete recorders;
+    }
+
+
+
+
+
+
+
+
+
+
+
+
+}
+
+SWGDeviceRecord*
+SWGDeviceRecord::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceRecord::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&buffer_size_mb, pJson["bufferSizeMB"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&block_size_kb, pJson["blockSizeKB"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&direct_io, pJson["directIO"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&preallocate_mb, pJson["preallocateMB"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&recorders, pJson["recorders"], "QList", "SWGFileRecordReport");
+    
+    ::SWGSDRangel::setValue(&compression, pJson["compression"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&compression_threads, pJson["compressionThreads"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&chunk_samples, pJson["chunkSamples"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&sig_mf, pJson["sigMF"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&triggered, pJson["triggered"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&pre_trigger_time, pJson["preTriggerTime"], "float", "");
+    
+    ::SWGSDRangel::setValue(&hang_time, pJson["hangTime"], "float", "");
+    
+    ::SWGSDRangel::setValue(&level_trigger, pJson["levelTrigger"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&trigger_level, pJson["triggerLevel"], "float", "");
+    
+    ::SWGSDRangel::setValue(&segment_time, pJson["segmentTime"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&segment_size_mb, pJson["segmentSizeMB"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&quota_mb, pJson["quotaMB"], "qint32", "");
+    
+}
+
+QString
+SWGDeviceRecord::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceRecord::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_buffer_size_mb_isSet){
+        obj->insert("bufferSizeMB", QJsonValue(buffer_size_mb));
+    }
+    if(m_block_size_kb_isSet){
+        obj->insert("blockSizeKB", QJsonValue(block_size_kb));
+    }
+    if(m_direct_io_isSet){
+        obj->insert("directIO", QJsonValue(direct_io));
+    }
+    if(m_preallocate_mb_isSet){
+        obj->insert("preallocateMB", QJsonValue(preallocate_mb));
+    }
+    if(recorders && recorders->size() > 0){
+        toJsonArray((QList<void*>*)recorders, obj, "recorders", "SWGFileRecordReport");
+    }
+    if(m_compression_isSet){
+        obj->insert("compression", QJsonValue(compression));
+    }
+    if(m_compression_threads_isSet){
+        obj->insert("compressionThreads", QJsonValue(compression_threads));
+    }
+    if(m_chunk_samples_isSet){
+        obj->insert("chunkSamples", QJsonValue(chunk_samples));
+    }
+    if(m_sig_mf_isSet){
+        obj->insert("sigMF", QJsonValue(sig_mf));
+    }
+    if(m_triggered_isSet){
+        obj->insert("triggered", QJsonValue(triggered));
+    }
+    if(m_pre_trigger_time_isSet){
+        obj->insert("preTriggerTime", QJsonValue(pre_trigger_time));
+    }
+    if(m_hang_time_isSet){
+        obj->insert("hangTime", QJsonValue(hang_time));
+    }
+    if(m_level_trigger_isSet){
+        obj->insert("levelTrigger", QJsonValue(level_trigger));
+    }
+    if(m_trigger_level_isSet){
+        obj->insert("triggerLevel", QJsonValue(trigger_level));
+    }
+    if(m_segment_time_isSet){
+        obj->insert("segmentTime", QJsonValue(segment_time));
+    }
+    if(m_segment_size_mb_isSet){
+        obj->insert("segmentSizeMB", QJsonValue(segment_size_mb));
+    }
+    if(m_quota_mb_isSet){
+        obj->insert("quotaMB", QJsonValue(quota_mb));
+    }
+
+    return obj;
+}
+
+qint32
+SWGDeviceRecord::getBufferSizeMb() {
+    return buffer_size_mb;
+}
+void
+SWGDeviceRecord::setBufferSizeMb(qint32 buffer_size_mb) {
+    this->buffer_size_mb = buffer_size_mb;
+    this->m_buffer_size_mb_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getBlockSizeKb() {
+    return block_size_kb;
+}
+void
+SWGDeviceRecord::setBlockSizeKb(qint32 block_size_kb) {
+    this->block_size_kb = block_size_kb;
+    this->m_block_size_kb_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getDirectIo() {
+    return direct_io;
+}
+void
+SWGDeviceRecord::setDirectIo(qint32 direct_io) {
+    this->direct_io = direct_io;
+    this->m_direct_io_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getPreallocateMb() {
+    return preallocate_mb;
+}
+void
+SWGDeviceRecord::setPreallocateMb(qint32 preallocate_mb) {
+    this->preallocate_mb = preallocate_mb;
+    this->m_preallocate_mb_isSet = true;
+}
+
+QList<SWGFileRecordReport*>*
+SWGDeviceRecord::getRecorders() {
+    return recorders;
+}
+void
+SWGDeviceRecord::setRecorders(QList<SWGFileRecordReport*>* recorders) {
+    this->recorders = recorders;
+    this->m_recorders_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getCompression() {
+    return compression;
+}
+void
+SWGDeviceRecord::setCompression(qint32 compression) {
+    this->compression = compression;
+    this->m_compression_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getCompressionThreads() {
+    return compression_threads;
+}
+void
+SWGDeviceRecord::setCompressionThreads(qint32 compression_threads) {
+    this->compression_threads = compression_threads;
+    this->m_compression_threads_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getChunkSamples() {
+    return chunk_samples;
+}
+void
+SWGDeviceRecord::setChunkSamples(qint32 chunk_samples) {
+    this->chunk_samples = chunk_samples;
+    this->m_chunk_samples_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getSigMf() {
+    return sig_mf;
+}
+void
+SWGDeviceRecord::setSigMf(qint32 sig_mf) {
+    this->sig_mf = sig_mf;
+    this->m_sig_mf_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getTriggered() {
+    return triggered;
+}
+void
+SWGDeviceRecord::setTriggered(qint32 triggered) {
+    this->triggered = triggered;
+    this->m_triggered_isSet = true;
+}
+
+float
+SWGDeviceRecord::getPreTriggerTime() {
+    return pre_trigger_time;
+}
+void
+SWGDeviceRecord::setPreTriggerTime(float pre_trigger_time) {
+    this->pre_trigger_time = pre_trigger_time;
+    this->m_pre_trigger_time_isSet = true;
+}
+
+float
+SWGDeviceRecord::getHangTime() {
+    return hang_time;
+}
+void
+SWGDeviceRecord::setHangTime(float hang_time) {
+    this->hang_time = hang_time;
+    this->m_hang_time_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getLevelTrigger() {
+    return level_trigger;
+}
+void
+SWGDeviceRecord::setLevelTrigger(qint32 level_trigger) {
+    this->level_trigger = level_trigger;
+    this->m_level_trigger_isSet = true;
+}
+
+float
+SWGDeviceRecord::getTriggerLevel() {
+    return trigger_level;
+}
+void
+SWGDeviceRecord::setTriggerLevel(float trigger_level) {
+    this->trigger_level = trigger_level;
+    this->m_trigger_level_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getSegmentTime() {
+    return segment_time;
+}
+void
+SWGDeviceRecord::setSegmentTime(qint32 segment_time) {
+    this->segment_time = segment_time;
+    this->m_segment_time_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getSegmentSizeMb() {
+    return segment_size_mb;
+}
+void
+SWGDeviceRecord::setSegmentSizeMb(qint32 segment_size_mb) {
+    this->segment_size_mb = segment_size_mb;
+    this->m_segment_size_mb_isSet = true;
+}
+
+qint32
+SWGDeviceRecord::getQuotaMb() {
+    return quota_mb;
+}
+void
+SWGDeviceRecord::setQuotaMb(qint32 quota_mb) {
+    this->quota_mb = quota_mb;
+    this->m_quota_mb_isSet = true;
+}
+
+
+bool
+SWGDeviceRecord::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_buffer_size_mb_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_block_size_kb_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_direct_io_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_preallocate_mb_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(recorders && (recorders->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+        if(m_compression_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_compression_threads_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_chunk_samples_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sig_mf_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_triggered_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_pre_trigger_time_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_hang_time_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_level_trigger_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_trigger_level_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_segment_time_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_segment_size_mb_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_quota_mb_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,156 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGDeviceRecord.h
+ *
+ * Device set I/Q recorders writer settings and status
+ */
+
+#ifndef SWGDeviceRecord_H_
+#define SWGDeviceRecord_H_
+
+#include <QJsonObject>
+
+
+#include "SWGFileRecordReport.h"
+#include <QList>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGDeviceRecord: public SWGObject {
+public:
+    SWGDeviceRecord();
+    SWGDeviceRecord(QString* json);
+    virtual ~SWGDeviceRecord();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGDeviceRecord* fromJson(QString &jsonString) override;
+
+    qint32 getBufferSizeMb();
+    void setBufferSizeMb(qint32 buffer_size_mb);
+
+    qint32 getBlockSizeKb();
+    void setBlockSizeKb(qint32 block_size_kb);
+
+    qint32 getDirectIo();
+    void setDirectIo(qint32 direct_io);
+
+    qint32 getPreallocateMb();
+    void setPreallocateMb(qint32 preallocate_mb);
+
+    QList<SWGFileRecordReport*>* getRecorders();
+    void setRecorders(QList<SWGFileRecordReport*>* recorders);
+
+    qint32 getCompression();
+    void setCompression(qint32 compression);
+
+    qint32 getCompressionThreads();
+    void setCompressionThreads(qint32 compression_threads);
+
+    qint32 getChunkSamples();
+    void setChunkSamples(qint32 chunk_samples);
+
+    qint32 getSigMf();
+    void setSigMf(qint32 sig_mf);
+
+    qint32 getTriggered();
+    void setTriggered(qint32 triggered);
+
+    float getPreTriggerTime();
+    void setPreTriggerTime(float pre_trigger_time);
+
+    float getHangTime();
+    void setHangTime(float hang_time);
+
+    qint32 getLevelTrigger();
+    void setLevelTrigger(qint32 level_trigger);
+
+    float getTriggerLevel();
+    void setTriggerLevel(float trigger_level);
+
+    qint32 getSegmentTime();
+    void setSegmentTime(qint32 segment_time);
+
+    qint32 getSegmentSizeMb();
+    void setSegmentSizeMb(qint32 segment_size_mb);
+
+    qint32 getQuotaMb();
+    void setQuotaMb(qint32 quota_mb);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 buffer_size_mb;
+    bool m_buffer_size_mb_isSet;
+
+    qint32 block_size_kb;
+    bool m_block_size_kb_isSet;
+
+    qint32 direct_io;
+    bool m_direct_io_isSet;
+
+    qint32 preallocate_mb;
+    bool m_preallocate_mb_isSet;
+
+    QList<SWGFileRecordReport*>* recorders;
+    bool m_recorders_isSet;
+
+    qint32 compression;
+    bool m_compression_isSet;
+
+    qint32 compression_threads;
+    bool m_compression_threads_isSet;
+
+    qint32 chunk_samples;
+    bool m_chunk_samples_isSet;
+
+    qint32 sig_mf;
+    bool m_sig_mf_isSet;
+
+    qint32 triggered;
+    bool m_triggered_isSet;
+
+    float pre_trigger_time;
+    bool m_pre_trigger_time_isSet;
+
+    float hang_time;
+    bool m_hang_time_isSet;
+
+    qint32 level_trigger;
+    bool m_level_trigger_isSet;
+
+    float trigger_level;
+    bool m_trigger_level_isSet;
+
+    qint32 segment_time;
+    bool m_segment_time_isSet;
+
+    qint32 segment_size_mb;
+    bool m_segment_size_mb_isSet;
+
+    qint32 quota_mb;
+    bool m_quota_mb_isSet;
+
+};
+
+}
+
+#endif /* SWGDeviceRecord_H_ */
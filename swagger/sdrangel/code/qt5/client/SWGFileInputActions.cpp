@@ -0,0 +1,155 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGFileInputActions.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileInputActions::SWGFileInputActions(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileInputActions::SWGFileInputActions() {
+    seek_sample = 0L;
+    m_seek_sample_isSet = false;
+    seek_annotation = 0;
+    m_seek_annotation_isSet = false;
+    seek_date_time = nullptr;
+    m_seek_date_time_isSet = false;
+}
+
+SWGFileInputActions::~SWGFileInputActions() {
+    this->cleanup();
+}
+
+void
+SWGFileInputActions::init() {
+    seek_sample = 0L;
+    m_seek_sample_isSet = false;
+    seek_annotation = 0;
+    m_seek_annotation_isSet = false;
+    seek_date_time = new QString("");
+    m_seek_date_time_isSet = false;
+}
+
+void
+SWGFileInputActions::cleanup() {
+
+
+    if(seek_date_time != nullptr) { 
+        delete seek_date_time;
+    }
+}
+
+SWGFileInputActions*
+SWGFileInputActions::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileInputActions::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&seek_sample, pJson["seekSample"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&seek_annotation, pJson["seekAnnotation"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&seek_date_time, pJson["seekDateTime"], "QString", "QString");
+    
+}
+
+QString
+SWGFileInputActions::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileInputActions::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_seek_sample_isSet){
+        obj->insert("seekSample", QJsonValue(seek_sample));
+    }
+    if(m_seek_annotation_isSet){
+        obj->insert("seekAnnotation", QJsonValue(seek_annotation));
+    }
+    if(seek_date_time != nullptr && *seek_date_time != QString("")){
+        toJsonValue(QString("seekDateTime"), seek_date_time, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+qint64
+SWGFileInputActions::getSeekSample() {
+    return seek_sample;
+}
+void
+SWGFileInputActions::setSeekSample(qint64 seek_sample) {
+    this->seek_sample = seek_sample;
+    this->m_seek_sample_isSet = true;
+}
+
+qint32
+SWGFileInputActions::getSeekAnnotation() {
+    return seek_annotation;
+}
+void
+SWGFileInputActions::setSeekAnnotation(qint32 seek_annotation) {
+    this->seek_annotation = seek_annotation;
+    this->m_seek_annotation_isSet = true;
+}
+
+QString*
+SWGFileInputActions::getSeekDateTime() {
+    return seek_date_time;
+}
+void
+SWGFileInputActions::setSeekDateTime(QString* seek_date_time) {
+    this->seek_date_time = seek_date_time;
+    this->m_seek_date_time_isSet = true;
+}
+
+
+bool
+SWGFileInputActions::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_seek_sample_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_seek_annotation_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(seek_date_time && *seek_date_time != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,205 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGFileInputAnnotation.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileInputAnnotation::SWGFileInputAnnotation(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileInputAnnotation::SWGFileInputAnnotation() {
+    sample_start = 0L;
+    m_sample_start_isSet = false;
+    sample_count = 0L;
+    m_sample_count_isSet = false;
+    label = nullptr;
+    m_label_isSet = false;
+    comment = nullptr;
+    m_comment_isSet = false;
+    date_time = nullptr;
+    m_date_time_isSet = false;
+}
+
+SWGFileInputAnnotation::~SWGFileInputAnnotation() {
+    this->cleanup();
+}
+
+void
+SWGFileInputAnnotation::init() {
+    sample_start = 0L;
+    m_sample_start_isSet = false;
+    sample_count = 0L;
+    m_sample_count_isSet = false;
+    label = new QString("");
+    m_label_isSet = false;
+    comment = new QString("");
+    m_comment_isSet = false;
+    date_time = new QString("");
+    m_date_time_isSet = false;
+}
+
+void
+SWGFileInputAnnotation::cleanup() {
+
+
+    if(label != nullptr) { 
+        delete label;
+    }
+    if(comment != nullptr) { 
+        delete comment;
+    }
+    if(date_time != nullptr) { 
+        delete date_time;
+    }
+}
+
+SWGFileInputAnnotation*
+SWGFileInputAnnotation::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileInputAnnotation::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&sample_start, pJson["sampleStart"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&sample_count, pJson["sampleCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&label, pJson["label"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&comment, pJson["comment"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&date_time, pJson["dateTime"], "QString", "QString");
+    
+}
+
+QString
+SWGFileInputAnnotation::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileInputAnnotation::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_sample_start_isSet){
+        obj->insert("sampleStart", QJsonValue(sample_start));
+    }
+    if(m_sample_count_isSet){
+        obj->insert("sampleCount", QJsonValue(sample_count));
+    }
+    if(label != nullptr && *label != QString("")){
+        toJsonValue(QString("label"), label, obj, QString("QString"));
+    }
+    if(comment != nullptr && *comment != QString("")){
+        toJsonValue(QString("comment"), comment, obj, QString("QString"));
+    }
+    if(date_time != nullptr && *date_time != QString("")){
+        toJsonValue(QString("dateTime"), date_time, obj, QString("QString"));
+    }
+
+    return obj;
+}
+
+qint64
+SWGFileInputAnnotation::getSampleStart() {
+    return sample_start;
+}
+void
+SWGFileInputAnnotation::setSampleStart(qint64 sample_start) {
+    this->sample_start = sample_start;
+    this->m_sample_start_isSet = true;
+}
+
+qint64
+SWGFileInputAnnotation::getSampleCount() {
+    return sample_count;
+}
+void
+SWGFileInputAnnotation::setSampleCount(qint64 sample_count) {
+    this->sample_count = sample_count;
+    this->m_sample_count_isSet = true;
+}
+
+QString*
+SWGFileInputAnnotation::getLabel() {
+    return label;
+}
+void
+SWGFileInputAnnotation::setLabel(QString* label) {
+    this->label = label;
+    this->m_label_isSet = true;
+}
+
+QString*
+SWGFileInputAnnotation::getComment() {
+    return comment;
+}
+void
+SWGFileInputAnnotation::setComment(QString* comment) {
+    this->comment = comment;
+    this->m_comment_isSet = true;
+}
+
+QString*
+SWGFileInputAnnotation::getDateTime() {
+    return date_time;
+}
+void
+SWGFileInputAnnotation::setDateTime(QString* date_time) {
+    this->date_time = date_time;
+    this->m_date_time_isSet = true;
+}
+
+
+bool
+SWGFileInputAnnotation::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_sample_start_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sample_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(label && *label != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(comment && *comment != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(date_time && *date_time != QString("")){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,83 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGFileInputAnnotation.h
+ *
+ * Annotation of a SigMF recording
+ */
+
+#ifndef SWGFileInputAnnotation_H_
+#define SWGFileInputAnnotation_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGFileInputAnnotation: public SWGObject {
+public:
+    SWGFileInputAnnotation();
+    SWGFileInputAnnotation(QString* json);
+    virtual ~SWGFileInputAnnotation();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGFileInputAnnotation* fromJson(QString &jsonString) override;
+
+    qint64 getSampleStart();
+    void setSampleStart(qint64 sample_start);
+
+    qint64 getSampleCount();
+    void setSampleCount(qint64 sample_count);
+
+    QString* getLabel();
+    void setLabel(QString* label);
+
+    QString* getComment();
+    void setComment(QString* comment);
+
+    QString* getDateTime();
+    void setDateTime(QString* date_time);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint64 sample_start;
+    bool m_sample_start_isSet;
+
+    qint64 sample_count;
+    bool m_sample_count_isSet;
+
+    QString* label;
+    bool m_label_isSet;
+
+    QString* comment;
+    bool m_comment_isSet;
+
+    QString* date_time;
+    bool m_date_time_isSet;
+
+};
+
+}
+
+#endif /* SWGFileInputAnnotation_H_ */
@@ -40,6 +40,12 @@ SWGFileInputReport::SWGFileInputReport() {
     m_elapsed_time_isSet = false;
     duration_time = nullptr;
     m_duration_time_isSet = false;
+    annotations = nullptr;
+    m_annotations_isSet = false;
+    samples_count = 0L;
+    m_samples_count_isSet = false;
+    end_of_file = 0;
+    m_end_of_file_isSet = false;
 }
 
 SWGFileInputReport::~SWGFileInputReport() {
@@ -60,6 +66,12 @@ SWGFileInputReport::init() {
     m_elapsed_time_isSet = false;
     duration_time = new QString("");
     m_duration_time_isSet = false;
+    annotations = new QList<SWGFileInputAnnotation*>();
+    m_annotations_isSet = false;
+    samples_count = 0L;
+    m_samples_count_isSet = false;
+    end_of_file = 0;
+    m_end_of_file_isSet = false;
 }
 
 void
@@ -78,6 +90,15 @@ SWGFileInputReport::cleanup() {
     if(duration_time != nullptr) { 
         delete duration_time;
     }
+    if(annotations != nullptr) { 
+        auto arr = annotations;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete annotations;
+    }
+
+
 }
 
 SWGFileInputReport*
@@ -103,6 +124,12 @@ SWGFileInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&duration_time, pJson["durationTime"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&annotations, pJson["annotations"], "QList", "SWGFileInputAnnotation");
+    
+    ::SWGSDRangel::setValue(&samples_count, pJson["samplesCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&end_of_file, pJson["endOfFile"], "qint32", "");
+    
 }
 
 QString
@@ -137,6 +164,15 @@ SWGFileInputReport::asJsonObject() {
     if(duration_time != nullptr && *duration_time != QString("")){
         toJsonValue(QString("durationTime"), duration_time, obj, QString("QString"));
     }
+    if(annotations && annotations->size() > 0){
+        toJsonArray((QList<void*>*)annotations, obj, "annotations", "SWGFileInputAnnotation");
+    }
+    if(m_samples_count_isSet){
+        obj->insert("samplesCount", QJsonValue(samples_count));
+    }
+    if(m_end_of_file_isSet){
+        obj->insert("endOfFile", QJsonValue(end_of_file));
+    }
 
     return obj;
 }
@@ -201,6 +237,36 @@ SWGFileInputReport::setDurationTime(QString* duration_time) {
     this->m_duration_time_isSet = true;
 }
 
+QList<SWGFileInputAnnotation*>*
+SWGFileInputReport::getAnnotations() {
+    return annotations;
+}
+void
+SWGFileInputReport::setAnnotations(QList<SWGFileInputAnnotation*>* annotations) {
+    this->annotations = annotations;
+    this->m_annotations_isSet = true;
+}
+
+qint64
+SWGFileInputReport::getSamplesCount() {
+    return samples_count;
+}
+void
+SWGFileInputReport::setSamplesCount(qint64 samples_count) {
+    this->samples_count = samples_count;
+    this->m_samples_count_isSet = true;
+}
+
+qint32
+SWGFileInputReport::getEndOfFile() {
+    return end_of_file;
+}
+void
+SWGFileInputReport::setEndOfFile(qint32 end_of_file) {
+    this->end_of_file = end_of_file;
+    this->m_end_of_file_isSet = true;
+}
+
 
 bool
 SWGFileInputReport::isSet(){
@@ -224,6 +290,15 @@ SWGFileInputReport::isSet(){
         if(duration_time && *duration_time != QString("")){
             isObjectUpdated = true; break;
         }
+        if(annotations && (annotations->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+        if(m_samples_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_end_of_file_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
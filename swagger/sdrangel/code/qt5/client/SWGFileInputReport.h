@@ -22,6 +22,8 @@
 #include <QJsonObject>
 
 
+#include "SWGFileInputAnnotation.h"
+#include <QList>
 #include <QString>
 
 #include "SWGObject.h"
@@ -60,6 +62,15 @@ public:
     QString* getDurationTime();
     void setDurationTime(QString* duration_time);
 
+    QList<SWGFileInputAnnotation*>* getAnnotations();
+    void setAnnotations(QList<SWGFileInputAnnotation*>* annotations);
+
+    qint64 getSamplesCount();
+    void setSamplesCount(qint64 samples_count);
+
+    qint32 getEndOfFile();
+    void setEndOfFile(qint32 end_of_file);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +93,15 @@ private:
     QString* duration_time;
     bool m_duration_time_isSet;
 
+    QList<SWGFileInputAnnotation*>* annotations;
+    bool m_annotations_isSet;
+
+    qint64 samples_count;
+    bool m_samples_count_isSet;
+
+    qint32 end_of_file;
+    bool m_end_of_file_isSet;
+
 };
 
 }
@@ -42,6 +42,8 @@ SWGFileInputSettings::SWGFileInputSettings() {
     m_reverse_api_port_isSet = false;
     reverse_api_device_index = 0;
     m_reverse_api_device_index_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
 }
 
 SWGFileInputSettings::~SWGFileInputSettings() {
@@ -64,6 +66,8 @@ SWGFileInputSettings::init() {
     m_reverse_api_port_isSet = false;
     reverse_api_device_index = 0;
     m_reverse_api_device_index_isSet = false;
+    unthrottled = 0;
+    m_unthrottled_isSet = false;
 }
 
 void
@@ -79,6 +83,7 @@ SWGFileInputSettings::cleanup() {
     }
 
 
+
 }
 
 SWGFileInputSettings*
@@ -106,6 +111,8 @@ SWGFileInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&reverse_api_device_index, pJson["reverseAPIDeviceIndex"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&unthrottled, pJson["unthrottled"], "qint32", "");
+    
 }
 
 QString
@@ -143,6 +150,9 @@ SWGFileInputSettings::asJsonObject() {
     if(m_reverse_api_device_index_isSet){
         obj->insert("reverseAPIDeviceIndex", QJsonValue(reverse_api_device_index));
     }
+    if(m_unthrottled_isSet){
+        obj->insert("unthrottled", QJsonValue(unthrottled));
+    }
 
     return obj;
 }
@@ -217,6 +227,16 @@ SWGFileInputSettings::setReverseApiDeviceIndex(qint32 reverse_api_device_index)
     this->m_reverse_api_device_index_isSet = true;
 }
 
+qint32
+SWGFileInputSettings::getUnthrottled() {
+    return unthrottled;
+}
+void
+SWGFileInputSettings::setUnthrottled(qint32 unthrottled) {
+    this->unthrottled = unthrottled;
+    this->m_unthrottled_isSet = true;
+}
+
 
 bool
 SWGFileInputSettings::isSet(){
@@ -243,6 +263,9 @@ SWGFileInputSettings::isSet(){
         if(m_reverse_api_device_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_unthrottled_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
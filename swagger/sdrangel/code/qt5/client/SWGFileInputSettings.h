@@ -63,6 +63,9 @@ public:
     qint32 getReverseApiDeviceIndex();
     void setReverseApiDeviceIndex(qint32 reverse_api_device_index);
 
+    qint32 getUnthrottled();
+    void setUnthrottled(qint32 unthrottled);
+
 
     virtual bool isSet() override;
 
@@ -88,6 +91,9 @@ private:
     qint32 reverse_api_device_index;
     bool m_reverse_api_device_index_isSet;
 
+    qint32 unthrottled;
+    bool m_unthrottled_isSet;
+
 };
 
 }
@@ -0,0 +1,454 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGFileRecordReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileRecordReport::SWGFileRecordReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileRecordReport::SWGFileRecordReport() {
+    stream_index = 0;
+    m_stream_index_isSet = false;
+    file_name = nullptr;
+    m_file_name_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    bytes_written = 0L;
+    m_bytes_written_isSet = false;
+    bytes_dropped = 0L;
+    m_bytes_dropped_isSet = false;
+    writes_dropped = 0;
+    m_writes_dropped_isSet = false;
+    bandwidth = 0.0f;
+    m_bandwidth_isSet = false;
+    queue_fill = 0.0f;
+    m_queue_fill_isSet = false;
+    max_queue_fill = 0.0f;
+    m_max_queue_fill_isSet = false;
+    write_error = 0;
+    m_write_error_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    chunks_dropped = 0;
+    m_chunks_dropped_isSet = false;
+    armed = 0;
+    m_armed_isSet = false;
+    events = 0;
+    m_events_isSet = false;
+    segments = 0;
+    m_segments_isSet = false;
+    segments_deleted = 0;
+    m_segments_deleted_isSet = false;
+}
+
+SWGFileRecordReport::~SWGFileRecordReport() {
+    this->cleanup();
+}
+
+void
+SWGFileRecordReport::init() {
+    stream_index = 0;
+    m_stream_index_isSet = false;
+    file_name = new QString("");
+    m_file_name_isSet = false;
+    recording = 0;
+    m_recording_isSet = false;
+    bytes_written = 0L;
+    m_bytes_written_isSet = false;
+    bytes_dropped = 0L;
+    m_bytes_dropped_isSet = false;
+    writes_dropped = 0;
+    m_writes_dropped_isSet = false;
+    bandwidth = 0.0f;
+    m_bandwidth_isSet = false;
+    queue_fill = 0.0f;
+    m_queue_fill_isSet = false;
+    max_queue_fill = 0.0f;
+    m_max_queue_fill_isSet = false;
+    write_error = 0;
+    m_write_error_isSet = false;
+    compression_ratio = 0.0f;
+    m_compression_ratio_isSet = false;
+    chunks_dropped = 0;
+    m_chunks_dropped_isSet = false;
+    armed = 0;
+    m_armed_isSet = false;
+    events = 0;
+    m_events_isSet = false;
+    segments = 0;
+    m_segments_isSet = false;
+    segments_deleted = 0;
+    m_segments_deleted_isSet = false;
+}
+
+void
+SWGFileRecordReport::cleanup() {
+
+    if(file_name != nullptr) { 
+        delete file_name;
+    }
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+}
+
+SWGFileRecordReport*
+SWGFileRecordReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileRecordReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&stream_index, pJson["streamIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&bytes_written, pJson["bytesWritten"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&bytes_dropped, pJson["bytesDropped"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&writes_dropped, pJson["writesDropped"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&bandwidth, pJson["bandwidth"], "float", "");
+    
+    ::SWGSDRangel::setValue(&queue_fill, pJson["queueFill"], "float", "");
+    
+    ::SWGSDRangel::setValue(&max_queue_fill, pJson["maxQueueFill"], "float", "");
+    
+    ::SWGSDRangel::setValue(&write_error, pJson["writeError"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&compression_ratio, pJson["compressionRatio"], "float", "");
+    
+    ::SWGSDRangel::setValue(&chunks_dropped, pJson["chunksDropped"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&armed, pJson["armed"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&events, pJson["events"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&segments, pJson["segments"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&segments_deleted, pJson["segmentsDeleted"], "qint32", "");
+    
+}
+
+QString
+SWGFileRecordReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileRecordReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_stream_index_isSet){
+        obj->insert("streamIndex", QJsonValue(stream_index));
+    }
+    if(file_name != nullptr && *file_name != QString("")){
+        toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
+    }
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(m_bytes_written_isSet){
+        obj->insert("bytesWritten", QJsonValue(bytes_written));
+    }
+    if(m_bytes_dropped_isSet){
+        obj->insert("bytesDropped", QJsonValue(bytes_dropped));
+    }
+    if(m_writes_dropped_isSet){
+        obj->insert("writesDropped", QJsonValue(writes_dropped));
+    }
+    if(m_bandwidth_isSet){
+        obj->insert("bandwidth", QJsonValue(bandwidth));
+    }
+    if(m_queue_fill_isSet){
+        obj->insert("queueFill", QJsonValue(queue_fill));
+    }
+    if(m_max_queue_fill_isSet){
+        obj->insert("maxQueueFill", QJsonValue(max_queue_fill));
+    }
+    if(m_write_error_isSet){
+        obj->insert("writeError", QJsonValue(write_error));
+    }
+    if(m_compression_ratio_isSet){
+        obj->insert("compressionRatio", QJsonValue(compression_ratio));
+    }
+    if(m_chunks_dropped_isSet){
+        obj->insert("chunksDropped", QJsonValue(chunks_dropped));
+    }
+    if(m_armed_isSet){
+        obj->insert("armed", QJsonValue(armed));
+    }
+    if(m_events_isSet){
+        obj->insert("events", QJsonValue(events));
+    }
+    if(m_segments_isSet){
+        obj->insert("segments", QJsonValue(segments));
+    }
+    if(m_segments_deleted_isSet){
+        obj->insert("segmentsDeleted", QJsonValue(segments_deleted));
+    }
+
+    return obj;
+}
+
+qint32
+SWGFileRecordReport::getStreamIndex() {
+    return stream_index;
+}
+void
+SWGFileRecordReport::setStreamIndex(qint32 stream_index) {
+    this->stream_index = stream_index;
+    this->m_stream_index_isSet = true;
+}
+
+QString*
+SWGFileRecordReport::getFileName() {
+    return file_name;
+}
+void
+SWGFileRecordReport::setFileName(QString* file_name) {
+    this->file_name = file_name;
+    this->m_file_name_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getRecording() {
+    return recording;
+}
+void
+SWGFileRecordReport::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getBytesWritten() {
+    return bytes_written;
+}
+void
+SWGFileRecordReport::setBytesWritten(qint64 bytes_written) {
+    this->bytes_written = bytes_written;
+    this->m_bytes_written_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getBytesDropped() {
+    return bytes_dropped;
+}
+void
+SWGFileRecordReport::setBytesDropped(qint64 bytes_dropped) {
+    this->bytes_dropped = bytes_dropped;
+    this->m_bytes_dropped_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getWritesDropped() {
+    return writes_dropped;
+}
+void
+SWGFileRecordReport::setWritesDropped(qint32 writes_dropped) {
+    this->writes_dropped = writes_dropped;
+    this->m_writes_dropped_isSet = true;
+}
+
+float
+SWGFileRecordReport::getBandwidth() {
+    return bandwidth;
+}
+void
+SWGFileRecordReport::setBandwidth(float bandwidth) {
+    this->bandwidth = bandwidth;
+    this->m_bandwidth_isSet = true;
+}
+
+float
+SWGFileRecordReport::getQueueFill() {
+    return queue_fill;
+}
+void
+SWGFileRecordReport::setQueueFill(float queue_fill) {
+    this->queue_fill = queue_fill;
+    this->m_queue_fill_isSet = true;
+}
+
+float
+SWGFileRecordReport::getMaxQueueFill() {
+    return max_queue_fill;
+}
+void
+SWGFileRecordReport::setMaxQueueFill(float max_queue_fill) {
+    this->max_queue_fill = max_queue_fill;
+    this->m_max_queue_fill_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getWriteError() {
+    return write_error;
+}
+void
+SWGFileRecordReport::setWriteError(qint32 write_error) {
+    this->write_error = write_error;
+    this->m_write_error_isSet = true;
+}
+
+float
+SWGFileRecordReport::getCompressionRatio() {
+    return compression_ratio;
+}
+void
+SWGFileRecordReport::setCompressionRatio(float compression_ratio) {
+    this->compression_ratio = compression_ratio;
+    this->m_compression_ratio_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getChunksDropped() {
+    return chunks_dropped;
+}
+void
+SWGFileRecordReport::setChunksDropped(qint32 chunks_dropped) {
+    this->chunks_dropped = chunks_dropped;
+    this->m_chunks_dropped_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getArmed() {
+    return armed;
+}
+void
+SWGFileRecordReport::setArmed(qint32 armed) {
+    this->armed = armed;
+    this->m_armed_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getEvents() {
+    return events;
+}
+void
+SWGFileRecordReport::setEvents(qint32 events) {
+    this->events = events;
+    this->m_events_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getSegments() {
+    return segments;
+}
+void
+SWGFileRecordReport::setSegments(qint32 segments) {
+    this->segments = segments;
+    this->m_segments_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getSegmentsDeleted() {
+    return segments_deleted;
+}
+void
+SWGFileRecordReport::setSegmentsDeleted(qint32 segments_deleted) {
+    this->segments_deleted = segments_deleted;
+    this->m_segments_deleted_isSet = true;
+}
+
+
+bool
+SWGFileRecordReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_stream_index_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(file_name && *file_name != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_recording_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_bytes_written_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_bytes_dropped_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_writes_dropped_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_bandwidth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_queue_fill_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_max_queue_fill_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_write_error_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_compression_ratio_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_chunks_dropped_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_armed_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_events_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_segments_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_segments_deleted_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,149 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGFileRecordReport.h
+ *
+ * I/Q file recorder status
+ */
+
+#ifndef SWGFileRecordReport_H_
+#define SWGFileRecordReport_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGFileRecordReport: public SWGObject {
+public:
+    SWGFileRecordReport();
+    SWGFileRecordReport(QString* json);
+    virtual ~SWGFileRecordReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGFileRecordReport* fromJson(QString &jsonString) override;
+
+    qint32 getStreamIndex();
+    void setStreamIndex(qint32 stream_index);
+
+    QString* getFileName();
+    void setFileName(QString* file_name);
+
+    qint32 getRecording();
+    void setRecording(qint32 recording);
+
+    qint64 getBytesWritten();
+    void setBytesWritten(qint64 bytes_written);
+
+    qint64 getBytesDropped();
+    void setBytesDropped(qint64 bytes_dropped);
+
+    qint32 getWritesDropped();
+    void setWritesDropped(qint32 writes_dropped);
+
+    float getBandwidth();
+    void setBandwidth(float bandwidth);
+
+    float getQueueFill();
+    void setQueueFill(float queue_fill);
+
+    float getMaxQueueFill();
+    void setMaxQueueFill(float max_queue_fill);
+
+    qint32 getWriteError();
+    void setWriteError(qint32 write_error);
+
+    float getCompressionRatio();
+    void setCompressionRatio(float compression_ratio);
+
+    qint32 getChunksDropped();
+    void setChunksDropped(qint32 chunks_dropped);
+
+    qint32 getArmed();
+    void setArmed(qint32 armed);
+
+    qint32 getEvents();
+    void setEvents(qint32 events);
+
+    qint32 getSegments();
+    void setSegments(qint32 segments);
+
+    qint32 getSegmentsDeleted();
+    void setSegmentsDeleted(qint32 segments_deleted);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 stream_index;
+    bool m_stream_index_isSet;
+
+    QString* file_name;
+    bool m_file_name_isSet;
+
+    qint32 recording;
+    bool m_recording_isSet;
+
+    qint64 bytes_written;
+    bool m_bytes_written_isSet;
+
+    qint64 bytes_dropped;
+    bool m_bytes_dropped_isSet;
+
+    qint32 writes_dropped;
+    bool m_writes_dropped_isSet;
+
+    float bandwidth;
+    bool m_bandwidth_isSet;
+
+    float queue_fill;
+    bool m_queue_fill_isSet;
+
+    float max_queue_fill;
+    bool m_max_queue_fill_isSet;
+
+    qint32 write_error;
+    bool m_write_error_isSet;
+
+    float compression_ratio;
+    bool m_compression_ratio_isSet;
+
+    qint32 chunks_dropped;
+    bool m_chunks_dropped_isSet;
+
+    qint32 armed;
+    bool m_armed_isSet;
+
+    qint32 events;
+    bool m_events_isSet;
+
+    qint32 segments;
+    bool m_segments_isSet;
+
+    qint32 segments_deleted;
+    bool m_segments_deleted_isSet;
+
+};
+
+}
+
+#endif /* SWGFileRecordReport_H_ */
@@ -70,6 +70,10 @@ SWGGLSpectrum::SWGGLSpectrum() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    zoom_frequency_offset = 0L;
+    m_zoom_frequency_offset_isSet = false;
+    zoom_log2_decim = 0;
+    m_zoom_log2_decim_isSet = false;
 }
 
 SWGGLSpectrum::~SWGGLSpectrum() {
@@ -120,6 +124,10 @@ SWGGLSpectrum::init() {
     m_averaging_value_isSet = false;
     linear = 0;
     m_linear_isSet = false;
+    zoom_frequency_offset = 0L;
+    m_zoom_frequency_offset_isSet = false;
+    zoom_log2_decim = 0;
+    m_zoom_log2_decim_isSet = false;
 }
 
 void
@@ -142,6 +150,8 @@ SWGGLSpectrum::cleanup() {
 
 
 
+
+
 
 
 
@@ -200,6 +210,10 @@ SWGGLSpectrum::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&linear, pJson["linear"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&zoom_frequency_offset, pJson["zoomFrequencyOffset"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&zoom_log2_decim, pJson["zoomLog2Decim"], "qint32", "");
+    
 }
 
 QString
@@ -279,6 +293,12 @@ SWGGLSpectrum::asJsonObject() {
     if(m_linear_isSet){
         obj->insert("linear", QJsonValue(linear));
     }
+    if(m_zoom_frequency_offset_isSet){
+        obj->insert("zoomFrequencyOffset", QJsonValue(zoom_frequency_offset));
+    }
+    if(m_zoom_log2_decim_isSet){
+        obj->insert("zoomLog2Decim", QJsonValue(zoom_log2_decim));
+    }
 
     return obj;
 }
@@ -493,6 +513,26 @@ SWGGLSpectrum::setLinear(qint32 linear) {
     this->m_linear_isSet = true;
 }
 
+qint64
+SWGGLSpectrum::getZoomFrequencyOffset() {
+    return zoom_frequency_offset;
+}
+void
+SWGGLSpectrum::setZoomFrequencyOffset(qint64 zoom_frequency_offset) {
+    this->zoom_frequency_offset = zoom_frequency_offset;
+    this->m_zoom_frequency_offset_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getZoomLog2Decim() {
+    return zoom_log2_decim;
+}
+void
+SWGGLSpectrum::setZoomLog2Decim(qint32 zoom_log2_decim) {
+    this->zoom_log2_decim = zoom_log2_decim;
+    this->m_zoom_log2_decim_isSet = true;
+}
+
 
 bool
 SWGGLSpectrum::isSet(){
@@ -561,6 +601,12 @@ SWGGLSpectrum::isSet(){
         if(m_linear_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_zoom_frequency_offset_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_zoom_log2_decim_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -104,6 +104,12 @@ public:
     qint32 getLinear();
     void setLinear(qint32 linear);
 
+    qint64 getZoomFrequencyOffset();
+    void setZoomFrequencyOffset(qint64 zoom_frequency_offset);
+
+    qint32 getZoomLog2Decim();
+    void setZoomLog2Decim(qint32 zoom_log2_decim);
+
 
     virtual bool isSet() override;
 
@@ -171,6 +177,12 @@ private:
     qint32 linear;
     bool m_linear_isSet;
 
+    qint64 zoom_frequency_offset;
+    bool m_zoom_frequency_offset_isSet;
+
+    qint32 zoom_log2_decim;
+    bool m_zoom_log2_decim_isSet;
+
 };
 
 }
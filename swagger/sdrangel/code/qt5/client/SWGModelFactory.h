@@ -65,6 +65,7 @@
 #include "SWGDeviceActions.h"
 #include "SWGDeviceConfig.h"
 #include "SWGDeviceListItem.h"
+#include "SWGDeviceRecord.h"
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
 #include "SWGDeviceSetList.h"
@@ -75,8 +76,11 @@
 #include "SWGFCDProPlusActions.h"
 #include "SWGFCDProPlusSettings.h"
 #include "SWGFCDProSettings.h"
+#include "SWGFileInputActions.h"
+#include "SWGFileInputAnnotation.h"
 #include "SWGFileInputReport.h"
 #include "SWGFileInputSettings.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFileSourceActions.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFileSourceSettings.h"
@@ -151,6 +155,7 @@
 #include "SWGRemoteInputSettings.h"
 #include "SWGRemoteOutputReport.h"
 #include "SWGRemoteOutputSettings.h"
+#include "SWGRemoteSinkReport.h"
 #include "SWGRemoteSinkSettings.h"
 #include "SWGRemoteSourceReport.h"
 #include "SWGRemoteSourceSettings.h"
@@ -172,6 +177,10 @@
 #include "SWGSoapySDRInputSettings.h"
 #include "SWGSoapySDROutputSettings.h"
 #include "SWGSoapySDRReport.h"
+#include "SWGSpectrumActivity.h"
+#include "SWGSpectrumActivitySignal.h"
+#include "SWGSpectrumHistory.h"
+#include "SWGSpectrumWaterfall.h"
 #include "SWGSuccessResponse.h"
 #include "SWGTestSourceActions.h"
 #include "SWGTestSourceSettings.h"
@@ -347,6 +356,9 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceListItem").compare(type) == 0) {
       return new SWGDeviceListItem();
     }
+    if(QString("SWGDeviceRecord").compare(type) == 0) {
+      return new SWGDeviceRecord();
+    }
     if(QString("SWGDeviceReport").compare(type) == 0) {
       return new SWGDeviceReport();
     }
@@ -377,12 +389,21 @@ namespace SWGSDRangel {
     if(QString("SWGFCDProSettings").compare(type) == 0) {
       return new SWGFCDProSettings();
     }
+    if(QString("SWGFileInputActions").compare(type) == 0) {
+      return new SWGFileInputActions();
+    }
+    if(QString("SWGFileInputAnnotation").compare(type) == 0) {
+      return new SWGFileInputAnnotation();
+    }
     if(QString("SWGFileInputReport").compare(type) == 0) {
       return new SWGFileInputReport();
     }
     if(QString("SWGFileInputSettings").compare(type) == 0) {
       return new SWGFileInputSettings();
     }
+    if(QString("SWGFileRecordReport").compare(type) == 0) {
+      return new SWGFileRecordReport();
+    }
     if(QString("SWGFileSourceActions").compare(type) == 0) {
       return new SWGFileSourceActions();
     }
@@ -605,6 +626,9 @@ namespace SWGSDRangel {
     if(QString("SWGRemoteOutputSettings").compare(type) == 0) {
       return new SWGRemoteOutputSettings();
     }
+    if(QString("SWGRemoteSinkReport").compare(type) == 0) {
+      return new SWGRemoteSinkReport();
+    }
     if(QString("SWGRemoteSinkSettings").compare(type) == 0) {
       return new SWGRemoteSinkSettings();
     }
@@ -668,6 +692,18 @@ namespace SWGSDRangel {
     if(QString("SWGSoapySDRReport").compare(type) == 0) {
       return new SWGSoapySDRReport();
     }
+    if(QString("SWGSpectrumActivity").compare(type) == 0) {
+      return new SWGSpectrumActivity();
+    }
+    if(QString("SWGSpectrumActivitySignal").compare(type) == 0) {
+      return new SWGSpectrumActivitySignal();
+    }
+    if(QString("SWGSpectrumHistory").compare(type) == 0) {
+      return new SWGSpectrumHistory();
+    }
+    if(QString("SWGSpectrumWaterfall").compare(type) == 0) {
+      return new SWGSpectrumWaterfall();
+    }
     if(QString("SWGSuccessResponse").compare(type) == 0) {
       return new SWGSuccessResponse();
     }
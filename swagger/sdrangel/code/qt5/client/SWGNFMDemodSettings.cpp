@@ -70,6 +70,12 @@ SWGNFMDemodSettings::SWGNFMDemodSettings() {
     m_reverse_api_device_index_isSet = false;
     reverse_api_channel_index = 0;
     m_reverse_api_channel_index_isSet = false;
+    ws_stream_enable = 0;
+    m_ws_stream_enable_isSet = false;
+    ws_stream_address = nullptr;
+    m_ws_stream_address_isSet = false;
+    ws_stream_port = 0;
+    m_ws_stream_port_isSet = false;
 }
 
 SWGNFMDemodSettings::~SWGNFMDemodSettings() {
@@ -120,6 +126,12 @@ SWGNFMDemodSettings::init() {
     m_reverse_api_device_index_isSet = false;
     reverse_api_channel_index = 0;
     m_reverse_api_channel_index_isSet = false;
+    ws_stream_enable = 0;
+    m_ws_stream_enable_isSet = false;
+    ws_stream_address = new QString("");
+    m_ws_stream_address_isSet = false;
+    ws_stream_port = 0;
+    m_ws_stream_port_isSet = false;
 }
 
 void
@@ -151,6 +163,11 @@ SWGNFMDemodSettings::cleanup() {
 
 
 
+
+    if(ws_stream_address != nullptr) { 
+        delete ws_stream_address;
+    }
+
 }
 
 SWGNFMDemodSettings*
@@ -206,6 +223,12 @@ SWGNFMDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&reverse_api_channel_index, pJson["reverseAPIChannelIndex"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&ws_stream_enable, pJson["wsStreamEnable"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&ws_stream_address, pJson["wsStreamAddress"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&ws_stream_port, pJson["wsStreamPort"], "qint32", "");
+    
 }
 
 QString
@@ -285,6 +308,15 @@ SWGNFMDemodSettings::asJsonObject() {
     if(m_reverse_api_channel_index_isSet){
         obj->insert("reverseAPIChannelIndex", QJsonValue(reverse_api_channel_index));
     }
+    if(m_ws_stream_enable_isSet){
+        obj->insert("wsStreamEnable", QJsonValue(ws_stream_enable));
+    }
+    if(ws_stream_address != nullptr && *ws_stream_address != QString("")){
+        toJsonValue(QString("wsStreamAddress"), ws_stream_address, obj, QString("QString"));
+    }
+    if(m_ws_stream_port_isSet){
+        obj->insert("wsStreamPort", QJsonValue(ws_stream_port));
+    }
 
     return obj;
 }
@@ -499,6 +531,36 @@ SWGNFMDemodSettings::setReverseApiChannelIndex(qint32 reverse_api_channel_index)
     this->m_reverse_api_channel_index_isSet = true;
 }
 
+qint32
+SWGNFMDemodSettings::getWsStreamEnable() {
+    return ws_stream_enable;
+}
+void
+SWGNFMDemodSettings::setWsStreamEnable(qint32 ws_stream_enable) {
+    this->ws_stream_enable = ws_stream_enable;
+    this->m_ws_stream_enable_isSet = true;
+}
+
+QString*
+SWGNFMDemodSettings::getWsStreamAddress() {
+    return ws_stream_address;
+}
+void
+SWGNFMDemodSettings::setWsStreamAddress(QString* ws_stream_address) {
+    this->ws_stream_address = ws_stream_address;
+    this->m_ws_stream_address_isSet = true;
+}
+
+qint32
+SWGNFMDemodSettings::getWsStreamPort() {
+    return ws_stream_port;
+}
+void
+SWGNFMDemodSettings::setWsStreamPort(qint32 ws_stream_port) {
+    this->ws_stream_port = ws_stream_port;
+    this->m_ws_stream_port_isSet = true;
+}
+
 
 bool
 SWGNFMDemodSettings::isSet(){
@@ -567,6 +629,15 @@ SWGNFMDemodSettings::isSet(){
         if(m_reverse_api_channel_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_ws_stream_enable_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(ws_stream_address && *ws_stream_address != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_ws_stream_port_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
@@ -105,6 +105,15 @@ public:
     qint32 getReverseApiChannelIndex();
     void setReverseApiChannelIndex(qint32 reverse_api_channel_index);
 
+    qint32 getWsStreamEnable();
+    void setWsStreamEnable(qint32 ws_stream_enable);
+
+    QString* getWsStreamAddress();
+    void setWsStreamAddress(QString* ws_stream_address);
+
+    qint32 getWsStreamPort();
+    void setWsStreamPort(qint32 ws_stream_port);
+
 
     virtual bool isSet() override;
 
@@ -172,6 +181,15 @@ private:
     qint32 reverse_api_channel_index;
     bool m_reverse_api_channel_index_isSet;
 
+    qint32 ws_stream_enable;
+    bool m_ws_stream_enable_isSet;
+
+    QString* ws_stream_address;
+    bool m_ws_stream_address_isSet;
+
+    qint32 ws_stream_port;
+    bool m_ws_stream_port_isSet;
+
 };
 
 }
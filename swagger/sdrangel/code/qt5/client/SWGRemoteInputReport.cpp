@@ -40,6 +40,22 @@ SWGRemoteInputReport::SWGRemoteInputReport() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    datagrams_count = 0;
+    m_datagrams_count_isSet = false;
+    kernel_drops_count = 0;
+    m_kernel_drops_count_isSet = false;
+    queue_drops_count = 0;
+    m_queue_drops_count_isSet = false;
+    latency_ms = 0.0f;
+    m_latency_ms_isSet = false;
+    target_latency_ms = 0.0f;
+    m_target_latency_ms_isSet = false;
+    jitter_ms = 0.0f;
+    m_jitter_ms_isSet = false;
+    correction_ppm = 0.0f;
+    m_correction_ppm_isSet = false;
+    shm_lost_samples = 0;
+    m_shm_lost_samples_isSet = false;
 }
 
 SWGRemoteInputReport::~SWGRemoteInputReport() {
@@ -60,6 +76,22 @@ SWGRemoteInputReport::init() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    datagrams_count = 0;
+    m_datagrams_count_isSet = false;
+    kernel_drops_count = 0;
+    m_kernel_drops_count_isSet = false;
+    queue_drops_count = 0;
+    m_queue_drops_count_isSet = false;
+    latency_ms = 0.0f;
+    m_latency_ms_isSet = false;
+    target_latency_ms = 0.0f;
+    m_target_latency_ms_isSet = false;
+    jitter_ms = 0.0f;
+    m_jitter_ms_isSet = false;
+    correction_ppm = 0.0f;
+    m_correction_ppm_isSet = false;
+    shm_lost_samples = 0;
+    m_shm_lost_samples_isSet = false;
 }
 
 void
@@ -72,6 +104,14 @@ SWGRemoteInputReport::cleanup() {
     }
 
 
+
+
+
+
+
+
+
+
 }
 
 SWGRemoteInputReport*
@@ -97,6 +137,22 @@ SWGRemoteInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&max_nb_recovery, pJson["maxNbRecovery"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&datagrams_count, pJson["datagramsCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&kernel_drops_count, pJson["kernelDropsCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&queue_drops_count, pJson["queueDropsCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&latency_ms, pJson["latencyMs"], "float", "");
+    
+    ::SWGSDRangel::setValue(&target_latency_ms, pJson["targetLatencyMs"], "float", "");
+    
+    ::SWGSDRangel::setValue(&jitter_ms, pJson["jitterMs"], "float", "");
+    
+    ::SWGSDRangel::setValue(&correction_ppm, pJson["correctionPPM"], "float", "");
+    
+    ::SWGSDRangel::setValue(&shm_lost_samples, pJson["shmLostSamples"], "qint32", "");
+    
 }
 
 QString
@@ -131,6 +187,30 @@ SWGRemoteInputReport::asJsonObject() {
     if(m_max_nb_recovery_isSet){
         obj->insert("maxNbRecovery", QJsonValue(max_nb_recovery));
     }
+    if(m_datagrams_count_isSet){
+        obj->insert("datagramsCount", QJsonValue(datagrams_count));
+    }
+    if(m_kernel_drops_count_isSet){
+        obj->insert("kernelDropsCount", QJsonValue(kernel_drops_count));
+    }
+    if(m_queue_drops_count_isSet){
+        obj->insert("queueDropsCount", QJsonValue(queue_drops_count));
+    }
+    if(m_latency_ms_isSet){
+        obj->insert("latencyMs", QJsonValue(latency_ms));
+    }
+    if(m_target_latency_ms_isSet){
+        obj->insert("targetLatencyMs", QJsonValue(target_latency_ms));
+    }
+    if(m_jitter_ms_isSet){
+        obj->insert("jitterMs", QJsonValue(jitter_ms));
+    }
+    if(m_correction_ppm_isSet){
+        obj->insert("correctionPPM", QJsonValue(correction_ppm));
+    }
+    if(m_shm_lost_samples_isSet){
+        obj->insert("shmLostSamples", QJsonValue(shm_lost_samples));
+    }
 
     return obj;
 }
@@ -195,6 +275,86 @@ SWGRemoteInputReport::setMaxNbRecovery(qint32 max_nb_recovery) {
     this->m_max_nb_recovery_isSet = true;
 }
 
+qint32
+SWGRemoteInputReport::getDatagramsCount() {
+    return datagrams_count;
+}
+void
+SWGRemoteInputReport::setDatagramsCount(qint32 datagrams_count) {
+    this->datagrams_count = datagrams_count;
+    this->m_datagrams_count_isSet = true;
+}
+
+qint32
+SWGRemoteInputReport::getKernelDropsCount() {
+    return kernel_drops_count;
+}
+void
+SWGRemoteInputReport::setKernelDropsCount(qint32 kernel_drops_count) {
+    this->kernel_drops_count = kernel_drops_count;
+    this->m_kernel_drops_count_isSet = true;
+}
+
+qint32
+SWGRemoteInputReport::getQueueDropsCount() {
+    return queue_drops_count;
+}
+void
+SWGRemoteInputReport::setQueueDropsCount(qint32 queue_drops_count) {
+    this->queue_drops_count = queue_drops_count;
+    this->m_queue_drops_count_isSet = true;
+}
+
+float
+SWGRemoteInputReport::getLatencyMs() {
+    return latency_ms;
+}
+void
+SWGRemoteInputReport::setLatencyMs(float latency_ms) {
+    this->latency_ms = latency_ms;
+    this->m_latency_ms_isSet = true;
+}
+
+float
+SWGRemoteInputReport::getTargetLatencyMs() {
+    return target_latency_ms;
+}
+void
+SWGRemoteInputReport::setTargetLatencyMs(float target_latency_ms) {
+    this->target_latency_ms = target_latency_ms;
+    this->m_target_latency_ms_isSet = true;
+}
+
+float
+SWGRemoteInputReport::getJitterMs() {
+    return jitter_ms;
+}
+void
+SWGRemoteInputReport::setJitterMs(float jitter_ms) {
+    this->jitter_ms = jitter_ms;
+    this->m_jitter_ms_isSet = true;
+}
+
+float
+SWGRemoteInputReport::getCorrectionPpm() {
+    return correction_ppm;
+}
+void
+SWGRemoteInputReport::setCorrectionPpm(float correction_ppm) {
+    this->correction_ppm = correction_ppm;
+    this->m_correction_ppm_isSet = true;
+}
+
+qint32
+SWGRemoteInputReport::getShmLostSamples() {
+    return shm_lost_samples;
+}
+void
+SWGRemoteInputReport::setShmLostSamples(qint32 shm_lost_samples) {
+    this->shm_lost_samples = shm_lost_samples;
+    this->m_shm_lost_samples_isSet = true;
+}
+
 
 bool
 SWGRemoteInputReport::isSet(){
@@ -218,6 +378,30 @@ SWGRemoteInputReport::isSet(){
         if(m_max_nb_recovery_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_datagrams_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_kernel_drops_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_queue_drops_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_latency_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_target_latency_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_jitter_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_correction_ppm_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_shm_lost_samples_isSet){
+            isObjectUpdated = true; break;
+        }
     }while(false);
     return isObjectUpdated;
 }
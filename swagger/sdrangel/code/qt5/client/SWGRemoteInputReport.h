@@ -60,6 +60,30 @@ public:
     qint32 getMaxNbRecovery();
     void setMaxNbRecovery(qint32 max_nb_recovery);
 
+    qint32 getDatagramsCount();
+    void setDatagramsCount(qint32 datagrams_count);
+
+    qint32 getKernelDropsCount();
+    void setKernelDropsCount(qint32 kernel_drops_count);
+
+    qint32 getQueueDropsCount();
+    void setQueueDropsCount(qint32 queue_drops_count);
+
+    float getLatencyMs();
+    void setLatencyMs(float latency_ms);
+
+    float getTargetLatencyMs();
+    void setTargetLatencyMs(float target_latency_ms);
+
+    float getJitterMs();
+    void setJitterMs(float jitter_ms);
+
+    float getCorrectionPpm();
+    void setCorrectionPpm(float correction_ppm);
+
+    qint32 getShmLostSamples();
+    void setShmLostSamples(qint32 shm_lost_samples);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +106,30 @@ private:
     qint32 max_nb_recovery;
     bool m_max_nb_recovery_isSet;
 
+    qint32 datagrams_count;
+    bool m_datagrams_count_isSet;
+
+    qint32 kernel_drops_count;
+    bool m_kernel_drops_count_isSet;
+
+    qint32 queue_drops_count;
+    bool m_queue_drops_count_isSet;
+
+    float latency_ms;
+    bool m_latency_ms_isSet;
+
+    float target_latency_ms;
+    bool m_target_latency_ms_isSet;
+
+    float jitter_ms;
+    bool m_jitter_ms_isSet;
+
+    float correction_ppm;
+    bool m_correction_ppm_isSet;
+
+    qint32 shm_lost_samples;
+    bool m_shm_lost_samples_isSet;
+
 };
 
 }
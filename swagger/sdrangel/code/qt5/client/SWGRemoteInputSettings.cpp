@@ -42,6 +42,14 @@ SWGRemoteInputSettings::SWGRemoteInputSettings() {
     m_iq_correction_isSet = false;
     file_record_name = nullptr;
     m_file_record_name_isSet = false;
+    fec_pipeline_depth = 0;
+    m_fec_pipeline_depth_isSet = false;
+    target_latency_ms = 0;
+    m_target_latency_ms_isSet = false;
+    shared_memory = 0;
+    m_shared_memory_isSet = false;
+    shm_name = nullptr;
+    m_shm_name_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -72,6 +80,14 @@ SWGRemoteInputSettings::init() {
     m_iq_correction_isSet = false;
     file_record_name = new QString("");
     m_file_record_name_isSet = false;
+    fec_pipeline_depth = 0;
+    m_fec_pipeline_depth_isSet = false;
+    target_latency_ms = 0;
+    m_target_latency_ms_isSet = false;
+    shared_memory = 0;
+    m_shared_memory_isSet = false;
+    shm_name = new QString("");
+    m_shm_name_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -98,6 +114,12 @@ SWGRemoteInputSettings::cleanup() {
         delete file_record_name;
     }
 
+
+
+    if(shm_name != nullptr) { 
+        delete shm_name;
+    }
+
     if(reverse_api_address != nullptr) { 
         delete reverse_api_address;
     }
@@ -130,6 +152,14 @@ SWGRemoteInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&file_record_name, pJson["fileRecordName"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&fec_pipeline_depth, pJson["fecPipelineDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&target_latency_ms, pJson["targetLatencyMs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&shared_memory, pJson["sharedMemory"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&shm_name, pJson["shmName"], "QString", "QString");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -175,6 +205,18 @@ SWGRemoteInputSettings::asJsonObject() {
     if(file_record_name != nullptr && *file_record_name != QString("")){
         toJsonValue(QString("fileRecordName"), file_record_name, obj, QString("QString"));
     }
+    if(m_fec_pipeline_depth_isSet){
+        obj->insert("fecPipelineDepth", QJsonValue(fec_pipeline_depth));
+    }
+    if(m_target_latency_ms_isSet){
+        obj->insert("targetLatencyMs", QJsonValue(target_latency_ms));
+    }
+    if(m_shared_memory_isSet){
+        obj->insert("sharedMemory", QJsonValue(shared_memory));
+    }
+    if(shm_name != nullptr && *shm_name != QString("")){
+        toJsonValue(QString("shmName"), shm_name, obj, QString("QString"));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -261,6 +303,46 @@ SWGRemoteInputSettings::setFileRecordName(QString* file_record_name) {
     this->m_file_record_name_isSet = true;
 }
 
+qint32
+SWGRemoteInputSettings::getFecPipelineDepth() {
+    return fec_pipeline_depth;
+}
+void
+SWGRemoteInputSettings::setFecPipelineDepth(qint32 fec_pipeline_depth) {
+    this->fec_pipeline_depth = fec_pipeline_depth;
+    this->m_fec_pipeline_depth_isSet = true;
+}
+
+qint32
+SWGRemoteInputSettings::getTargetLatencyMs() {
+    return target_latency_ms;
+}
+void
+SWGRemoteInputSettings::setTargetLatencyMs(qint32 target_latency_ms) {
+    this->target_latency_ms = target_latency_ms;
+    this->m_target_latency_ms_isSet = true;
+}
+
+qint32
+SWGRemoteInputSettings::getSharedMemory() {
+    return shared_memory;
+}
+void
+SWGRemoteInputSettings::setSharedMemory(qint32 shared_memory) {
+    this->shared_memory = shared_memory;
+    this->m_shared_memory_isSet = true;
+}
+
+QString*
+SWGRemoteInputSettings::getShmName() {
+    return shm_name;
+}
+void
+SWGRemoteInputSettings::setShmName(QString* shm_name) {
+    this->shm_name = shm_name;
+    this->m_shm_name_isSet = true;
+}
+
 qint32
 SWGRemoteInputSettings::getUseReverseApi() {
     return use_reverse_api;
@@ -327,6 +409,18 @@ SWGRemoteInputSettings::isSet(){
         if(file_record_name && *file_record_name != QString("")){
             isObjectUpdated = true; break;
         }
+        if(m_fec_pipeline_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_target_latency_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_shared_memory_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(shm_name && *shm_name != QString("")){
+            isObjectUpdated = true; break;
+        }
         if(m_use_reverse_api_isSet){
             isObjectUpdated = true; break;
         }
@@ -63,6 +63,18 @@ public:
     QString* getFileRecordName();
     void setFileRecordName(QString* file_record_name);
 
+    qint32 getFecPipelineDepth();
+    void setFecPipelineDepth(qint32 fec_pipeline_depth);
+
+    qint32 getTargetLatencyMs();
+    void setTargetLatencyMs(qint32 target_latency_ms);
+
+    qint32 getSharedMemory();
+    void setSharedMemory(qint32 shared_memory);
+
+    QString* getShmName();
+    void setShmName(QString* shm_name);
+
     qint32 getUseReverseApi();
     void setUseReverseApi(qint32 use_reverse_api);
 
@@ -100,6 +112,18 @@ private:
     QString* file_record_name;
     bool m_file_record_name_isSet;
 
+    qint32 fec_pipeline_depth;
+    bool m_fec_pipeline_depth_isSet;
+
+    qint32 target_latency_ms;
+    bool m_target_latency_ms_isSet;
+
+    qint32 shared_memory;
+    bool m_shared_memory_isSet;
+
+    QString* shm_name;
+    bool m_shm_name_isSet;
+
     qint32 use_reverse_api;
     bool m_use_reverse_api_isSet;
 
@@ -0,0 +1,246 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGRemoteSinkReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGRemoteSinkReport::SWGRemoteSinkReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGRemoteSinkReport::SWGRemoteSinkReport() {
+    packets_count = 0;
+    m_packets_count_isSet = false;
+    packets_per_second = 0.0f;
+    m_packets_per_second_isSet = false;
+    syscalls_count = 0;
+    m_syscalls_count_isSet = false;
+    packets_per_syscall = 0.0f;
+    m_packets_per_syscall_isSet = false;
+    send_mode = 0;
+    m_send_mode_isSet = false;
+    lossy_blocks_count = 0;
+    m_lossy_blocks_count_isSet = false;
+    dropped_bits_count = 0;
+    m_dropped_bits_count_isSet = false;
+}
+
+SWGRemoteSinkReport::~SWGRemoteSinkReport() {
+    this->cleanup();
+}
+
+void
+SWGRemoteSinkReport::init() {
+    packets_count = 0;
+    m_packets_count_isSet = false;
+    packets_per_second = 0.0f;
+    m_packets_per_second_isSet = false;
+    syscalls_count = 0;
+    m_syscalls_count_isSet = false;
+    packets_per_syscall = 0.0f;
+    m_packets_per_syscall_isSet = false;
+    send_mode = 0;
+    m_send_mode_isSet = false;
+    lossy_blocks_count = 0;
+    m_lossy_blocks_count_isSet = false;
+    dropped_bits_count = 0;
+    m_dropped_bits_count_isSet = false;
+}
+
+void
+SWGRemoteSinkReport::cleanup() {
+
+
+
+
+
+
+
+}
+
+SWGRemoteSinkReport*
+SWGRemoteSinkReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGRemoteSinkReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&packets_count, pJson["packetsCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&packets_per_second, pJson["packetsPerSecond"], "float", "");
+    
+    ::SWGSDRangel::setValue(&syscalls_count, pJson["syscallsCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&packets_per_syscall, pJson["packetsPerSyscall"], "float", "");
+    
+    ::SWGSDRangel::setValue(&send_mode, pJson["sendMode"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&lossy_blocks_count, pJson["lossyBlocksCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&dropped_bits_count, pJson["droppedBitsCount"], "qint32", "");
+    
+}
+
+QString
+SWGRemoteSinkReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGRemoteSinkReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_packets_count_isSet){
+        obj->insert("packetsCount", QJsonValue(packets_count));
+    }
+    if(m_packets_per_second_isSet){
+        obj->insert("packetsPerSecond", QJsonValue(packets_per_second));
+    }
+    if(m_syscalls_count_isSet){
+        obj->insert("syscallsCount", QJsonValue(syscalls_count));
+    }
+    if(m_packets_per_syscall_isSet){
+        obj->insert("packetsPerSyscall", QJsonValue(packets_per_syscall));
+    }
+    if(m_send_mode_isSet){
+        obj->insert("sendMode", QJsonValue(send_mode));
+    }
+    if(m_lossy_blocks_count_isSet){
+        obj->insert("lossyBlocksCount", QJsonValue(lossy_blocks_count));
+    }
+    if(m_dropped_bits_count_isSet){
+        obj->insert("droppedBitsCount", QJsonValue(dropped_bits_count));
+    }
+
+    return obj;
+}
+
+qint32
+SWGRemoteSinkReport::getPacketsCount() {
+    return packets_count;
+}
+void
+SWGRemoteSinkReport::setPacketsCount(qint32 packets_count) {
+    this->packets_count = packets_count;
+    this->m_packets_count_isSet = true;
+}
+
+float
+SWGRemoteSinkReport::getPacketsPerSecond() {
+    return packets_per_second;
+}
+void
+SWGRemoteSinkReport::setPacketsPerSecond(float packets_per_second) {
+    this->packets_per_second = packets_per_second;
+    this->m_packets_per_second_isSet = true;
+}
+
+qint32
+SWGRemoteSinkReport::getSyscallsCount() {
+    return syscalls_count;
+}
+void
+SWGRemoteSinkReport::setSyscallsCount(qint32 syscalls_count) {
+    this->syscalls_count = syscalls_count;
+    this->m_syscalls_count_isSet = true;
+}
+
+float
+SWGRemoteSinkReport::getPacketsPerSyscall() {
+    return packets_per_syscall;
+}
+void
+SWGRemoteSinkReport::setPacketsPerSyscall(float packets_per_syscall) {
+    this->packets_per_syscall = packets_per_syscall;
+    this->m_packets_per_syscall_isSet = true;
+}
+
+qint32
+SWGRemoteSinkReport::getSendMode() {
+    return send_mode;
+}
+void
+SWGRemoteSinkReport::setSendMode(qint32 send_mode) {
+    this->send_mode = send_mode;
+    this->m_send_mode_isSet = true;
+}
+
+qint32
+SWGRemoteSinkReport::getLossyBlocksCount() {
+    return lossy_blocks_count;
+}
+void
+SWGRemoteSinkReport::setLossyBlocksCount(qint32 lossy_blocks_count) {
+    this->lossy_blocks_count = lossy_blocks_count;
+    this->m_lossy_blocks_count_isSet = true;
+}
+
+qint32
+SWGRemoteSinkReport::getDroppedBitsCount() {
+    return dropped_bits_count;
+}
+void
+SWGRemoteSinkReport::setDroppedBitsCount(qint32 dropped_bits_count) {
+    this->dropped_bits_count = dropped_bits_count;
+    this->m_dropped_bits_count_isSet = true;
+}
+
+
+bool
+SWGRemoteSinkReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_packets_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_packets_per_second_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_syscalls_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_packets_per_syscall_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_send_mode_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_lossy_blocks_count_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_dropped_bits_count_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,94 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGRemoteSinkReport.h
+ *
+ * Remote channel sink report
+ */
+
+#ifndef SWGRemoteSinkReport_H_
+#define SWGRemoteSinkReport_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGRemoteSinkReport: public SWGObject {
+public:
+    SWGRemoteSinkReport();
+    SWGRemoteSinkReport(QString* json);
+    virtual ~SWGRemoteSinkReport();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGRemoteSinkReport* fromJson(QString &jsonString) override;
+
+    qint32 getPacketsCount();
+    void setPacketsCount(qint32 packets_count);
+
+    float getPacketsPerSecond();
+    void setPacketsPerSecond(float packets_per_second);
+
+    qint32 getSyscallsCount();
+    void setSyscallsCount(qint32 syscalls_count);
+
+    float getPacketsPerSyscall();
+    void setPacketsPerSyscall(float packets_per_syscall);
+
+    qint32 getSendMode();
+    void setSendMode(qint32 send_mode);
+
+    qint32 getLossyBlocksCount();
+    void setLossyBlocksCount(qint32 lossy_blocks_count);
+
+    qint32 getDroppedBitsCount();
+    void setDroppedBitsCount(qint32 dropped_bits_count);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 packets_count;
+    bool m_packets_count_isSet;
+
+    float packets_per_second;
+    bool m_packets_per_second_isSet;
+
+    qint32 syscalls_count;
+    bool m_syscalls_count_isSet;
+
+    float packets_per_syscall;
+    bool m_packets_per_syscall_isSet;
+
+    qint32 send_mode;
+    bool m_send_mode_isSet;
+
+    qint32 lossy_blocks_count;
+    bool m_lossy_blocks_count_isSet;
+
+    qint32 dropped_bits_count;
+    bool m_dropped_bits_count_isSet;
+
+};
+
+}
+
+#endif /* SWGRemoteSinkReport_H_ */
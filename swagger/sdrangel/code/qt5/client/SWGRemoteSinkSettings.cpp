@@ -46,6 +46,14 @@ SWGRemoteSinkSettings::SWGRemoteSinkSettings() {
     m_filter_chain_hash_isSet = false;
     stream_index = 0;
     m_stream_index_isSet = false;
+    fec_pipeline_depth = 0;
+    m_fec_pipeline_depth_isSet = false;
+    codec = 0;
+    m_codec_isSet = false;
+    shared_memory = 0;
+    m_shared_memory_isSet = false;
+    shm_name = nullptr;
+    m_shm_name_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -82,6 +90,14 @@ SWGRemoteSinkSettings::init() {
     m_filter_chain_hash_isSet = false;
     stream_index = 0;
     m_stream_index_isSet = false;
+    fec_pipeline_depth = 0;
+    m_fec_pipeline_depth_isSet = false;
+    codec = 0;
+    m_codec_isSet = false;
+    shared_memory = 0;
+    m_shared_memory_isSet = false;
+    shm_name = new QString("");
+    m_shm_name_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -110,6 +126,12 @@ SWGRemoteSinkSettings::cleanup() {
 
 
 
+
+
+    if(shm_name != nullptr) { 
+        delete shm_name;
+    }
+
     if(reverse_api_address != nullptr) { 
         delete reverse_api_address;
     }
@@ -147,6 +169,14 @@ SWGRemoteSinkSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&stream_index, pJson["streamIndex"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&fec_pipeline_depth, pJson["fecPipelineDepth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&codec, pJson["codec"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&shared_memory, pJson["sharedMemory"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&shm_name, pJson["shmName"], "QString", "QString");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -200,6 +230,18 @@ SWGRemoteSinkSettings::asJsonObject() {
     if(m_stream_index_isSet){
         obj->insert("streamIndex", QJsonValue(stream_index));
     }
+    if(m_fec_pipeline_depth_isSet){
+        obj->insert("fecPipelineDepth", QJsonValue(fec_pipeline_depth));
+    }
+    if(m_codec_isSet){
+        obj->insert("codec", QJsonValue(codec));
+    }
+    if(m_shared_memory_isSet){
+        obj->insert("sharedMemory", QJsonValue(shared_memory));
+    }
+    if(shm_name != nullptr && *shm_name != QString("")){
+        toJsonValue(QString("shmName"), shm_name, obj, QString("QString"));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -309,6 +351,46 @@ SWGRemoteSinkSettings::setStreamIndex(qint32 stream_index) {
     this->m_stream_index_isSet = true;
 }
 
+qint32
+SWGRemoteSinkSettings::getFecPipelineDepth() {
+    return fec_pipeline_depth;
+}
+void
+SWGRemoteSinkSettings::setFecPipelineDepth(qint32 fec_pipeline_depth) {
+    this->fec_pipeline_depth = fec_pipeline_depth;
+    this->m_fec_pipeline_depth_isSet = true;
+}
+
+qint32
+SWGRemoteSinkSettings::getCodec() {
+    return codec;
+}
+void
+SWGRemoteSinkSettings::setCodec(qint32 codec) {
+    this->codec = codec;
+    this->m_codec_isSet = true;
+}
+
+qint32
+SWGRemoteSinkSettings::getSharedMemory() {
+    return shared_memory;
+}
+void
+SWGRemoteSinkSettings::setSharedMemory(qint32 shared_memory) {
+    this->shared_memory = shared_memory;
+    this->m_shared_memory_isSet = true;
+}
+
+QString*
+SWGRemoteSinkSettings::getShmName() {
+    return shm_name;
+}
+void
+SWGRemoteSinkSettings::setShmName(QString* shm_name) {
+    this->shm_name = shm_name;
+    this->m_shm_name_isSet = true;
+}
+
 qint32
 SWGRemoteSinkSettings::getUseReverseApi() {
     return use_reverse_api;
@@ -391,6 +473,18 @@ SWGRemoteSinkSettings::isSet(){
         if(m_stream_index_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_fec_pipeline_depth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_codec_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_shared_memory_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(shm_name && *shm_name != QString("")){
+            isObjectUpdated = true; break;
+        }
         if(m_use_reverse_api_isSet){
             isObjectUpdated = true; break;
         }
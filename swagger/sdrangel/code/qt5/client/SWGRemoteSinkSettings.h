@@ -69,6 +69,18 @@ public:
     qint32 getStreamIndex();
     void setStreamIndex(qint32 stream_index);
 
+    qint32 getFecPipelineDepth();
+    void setFecPipelineDepth(qint32 fec_pipeline_depth);
+
+    qint32 getCodec();
+    void setCodec(qint32 codec);
+
+    qint32 getSharedMemory();
+    void setSharedMemory(qint32 shared_memory);
+
+    QString* getShmName();
+    void setShmName(QString* shm_name);
+
     qint32 getUseReverseApi();
     void setUseReverseApi(qint32 use_reverse_api);
 
@@ -115,6 +127,18 @@ private:
     qint32 stream_index;
     bool m_stream_index_isSet;
 
+    qint32 fec_pipeline_depth;
+    bool m_fec_pipeline_depth_isSet;
+
+    qint32 codec;
+    bool m_codec_isSet;
+
+    qint32 shared_memory;
+    bool m_shared_memory_isSet;
+
+    QString* shm_name;
+    bool m_shm_name_isSet;
+
     qint32 use_reverse_api;
     bool m_use_reverse_api_isSet;
 
@@ -0,0 +1,319 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGSpectrumActivity.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGSpectrumActivity::SWGSpectrumActivity(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumActivity::SWGSpectrumActivity() {
+    enable = 0;
+    m_enable_isSet = false;
+    threshold_db = 0.0f;
+    m_threshold_db_isSet = false;
+    hysteresis_db = 0.0f;
+    m_hysteresis_db_isSet = false;
+    percentile = 0.0f;
+    m_percentile_isSet = false;
+    nb_regions = 0;
+    m_nb_regions_isSet = false;
+    min_bandwidth = 0;
+    m_min_bandwidth_isSet = false;
+    hold_ms = 0;
+    m_hold_ms_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    noise_floor_db = 0.0f;
+    m_noise_floor_db_isSet = false;
+    active_signals = nullptr;
+    m_active_signals_isSet = false;
+}
+
+SWGSpectrumActivity::~SWGSpectrumActivity() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumActivity::init() {
+    enable = 0;
+    m_enable_isSet = false;
+    threshold_db = 0.0f;
+    m_threshold_db_isSet = false;
+    hysteresis_db = 0.0f;
+    m_hysteresis_db_isSet = false;
+    percentile = 0.0f;
+    m_percentile_isSet = false;
+    nb_regions = 0;
+    m_nb_regions_isSet = false;
+    min_bandwidth = 0;
+    m_min_bandwidth_isSet = false;
+    hold_ms = 0;
+    m_hold_ms_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    noise_floor_db = 0.0f;
+    m_noise_floor_db_isSet = false;
+    active_signals = new QList<SWGSpectrumActivitySignal*>();
+    m_active_signals_isSet = false;
+}
+
+void
+SWGSpectrumActivity::cleanup() {
+
+
+
+
+
+
+
+
+    if(active_signals != nullptr) { 
+        auto arr = active_signals;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete active_signals;
+    }
+}
+
+SWGSpectrumActivity*
+SWGSpectrumActivity::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumActivity::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&enable, pJson["enable"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&threshold_db, pJson["thresholdDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&hysteresis_db, pJson["hysteresisDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&percentile, pJson["percentile"], "float", "");
+    
+    ::SWGSDRangel::setValue(&nb_regions, pJson["nbRegions"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&min_bandwidth, pJson["minBandwidth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&hold_ms, pJson["holdMs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&noise_floor_db, pJson["noiseFloorDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&active_signals, pJson["activeSignals"], "QList", "SWGSpectrumActivitySignal");
+    
+}
+
+QString
+SWGSpectrumActivity::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumActivity::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_enable_isSet){
+        obj->insert("enable", QJsonValue(enable));
+    }
+    if(m_threshold_db_isSet){
+        obj->insert("thresholdDb", QJsonValue(threshold_db));
+    }
+    if(m_hysteresis_db_isSet){
+        obj->insert("hysteresisDb", QJsonValue(hysteresis_db));
+    }
+    if(m_percentile_isSet){
+        obj->insert("percentile", QJsonValue(percentile));
+    }
+    if(m_nb_regions_isSet){
+        obj->insert("nbRegions", QJsonValue(nb_regions));
+    }
+    if(m_min_bandwidth_isSet){
+        obj->insert("minBandwidth", QJsonValue(min_bandwidth));
+    }
+    if(m_hold_ms_isSet){
+        obj->insert("holdMs", QJsonValue(hold_ms));
+    }
+    if(m_center_frequency_isSet){
+        obj->insert("centerFrequency", QJsonValue(center_frequency));
+    }
+    if(m_noise_floor_db_isSet){
+        obj->insert("noiseFloorDb", QJsonValue(noise_floor_db));
+    }
+    if(active_signals && active_signals->size() > 0){
+        toJsonArray((QList<void*>*)active_signals, obj, "activeSignals", "SWGSpectrumActivitySignal");
+    }
+
+    return obj;
+}
+
+qint32
+SWGSpectrumActivity::getEnable() {
+    return enable;
+}
+void
+SWGSpectrumActivity::setEnable(qint32 enable) {
+    this->enable = enable;
+    this->m_enable_isSet = true;
+}
+
+float
+SWGSpectrumActivity::getThresholdDb() {
+    return threshold_db;
+}
+void
+SWGSpectrumActivity::setThresholdDb(float threshold_db) {
+    this->threshold_db = threshold_db;
+    this->m_threshold_db_isSet = true;
+}
+
+float
+SWGSpectrumActivity::getHysteresisDb() {
+    return hysteresis_db;
+}
+void
+SWGSpectrumActivity::setHysteresisDb(float hysteresis_db) {
+    this->hysteresis_db = hysteresis_db;
+    this->m_hysteresis_db_isSet = true;
+}
+
+float
+SWGSpectrumActivity::getPercentile() {
+    return percentile;
+}
+void
+SWGSpectrumActivity::setPercentile(float percentile) {
+    this->percentile = percentile;
+    this->m_percentile_isSet = true;
+}
+
+qint32
+SWGSpectrumActivity::getNbRegions() {
+    return nb_regions;
+}
+void
+SWGSpectrumActivity::setNbRegions(qint32 nb_regions) {
+    this->nb_regions = nb_regions;
+    this->m_nb_regions_isSet = true;
+}
+
+qint32
+SWGSpectrumActivity::getMinBandwidth() {
+    return min_bandwidth;
+}
+void
+SWGSpectrumActivity::setMinBandwidth(qint32 min_bandwidth) {
+    this->min_bandwidth = min_bandwidth;
+    this->m_min_bandwidth_isSet = true;
+}
+
+qint32
+SWGSpectrumActivity::getHoldMs() {
+    return hold_ms;
+}
+void
+SWGSpectrumActivity::setHoldMs(qint32 hold_ms) {
+    this->hold_ms = hold_ms;
+    this->m_hold_ms_isSet = true;
+}
+
+qint64
+SWGSpectrumActivity::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGSpectrumActivity::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+    this->m_center_frequency_isSet = true;
+}
+
+float
+SWGSpectrumActivity::getNoiseFloorDb() {
+    return noise_floor_db;
+}
+void
+SWGSpectrumActivity::setNoiseFloorDb(float noise_floor_db) {
+    this->noise_floor_db = noise_floor_db;
+    this->m_noise_floor_db_isSet = true;
+}
+
+QList<SWGSpectrumActivitySignal*>*
+SWGSpectrumActivity::getActiveSignals() {
+    return active_signals;
+}
+void
+SWGSpectrumActivity::setActiveSignals(QList<SWGSpectrumActivitySignal*>* active_signals) {
+    this->active_signals = active_signals;
+    this->m_active_signals_isSet = true;
+}
+
+
+bool
+SWGSpectrumActivity::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_enable_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_threshold_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_hysteresis_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_percentile_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_regions_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_min_bandwidth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_hold_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_center_frequency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_noise_floor_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(active_signals && (active_signals->size() > 0)){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
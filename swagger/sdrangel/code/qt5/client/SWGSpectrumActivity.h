@@ -0,0 +1,114 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumActivity.h
+ *
+ * Spectrum activity detector settings and active signals
+ */
+
+#ifndef SWGSpectrumActivity_H_
+#define SWGSpectrumActivity_H_
+
+#include <QJsonObject>
+
+
+#include "SWGSpectrumActivitySignal.h"
+#include <QList>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGSpectrumActivity: public SWGObject {
+public:
+    SWGSpectrumActivity();
+    SWGSpectrumActivity(QString* json);
+    virtual ~SWGSpectrumActivity();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGSpectrumActivity* fromJson(QString &jsonString) override;
+
+    qint32 getEnable();
+    void setEnable(qint32 enable);
+
+    float getThresholdDb();
+    void setThresholdDb(float threshold_db);
+
+    float getHysteresisDb();
+    void setHysteresisDb(float hysteresis_db);
+
+    float getPercentile();
+    void setPercentile(float percentile);
+
+    qint32 getNbRegions();
+    void setNbRegions(qint32 nb_regions);
+
+    qint32 getMinBandwidth();
+    void setMinBandwidth(qint32 min_bandwidth);
+
+    qint32 getHoldMs();
+    void setHoldMs(qint32 hold_ms);
+
+    qint64 getCenterFrequency();
+    void setCenterFrequency(qint64 center_frequency);
+
+    float getNoiseFloorDb();
+    void setNoiseFloorDb(float noise_floor_db);
+
+    QList<SWGSpectrumActivitySignal*>* getActiveSignals();
+    void setActiveSignals(QList<SWGSpectrumActivitySignal*>* active_signals);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 enable;
+    bool m_enable_isSet;
+
+    float threshold_db;
+    bool m_threshold_db_isSet;
+
+    float hysteresis_db;
+    bool m_hysteresis_db_isSet;
+
+    float percentile;
+    bool m_percentile_isSet;
+
+    qint32 nb_regions;
+    bool m_nb_regions_isSet;
+
+    qint32 min_bandwidth;
+    bool m_min_bandwidth_isSet;
+
+    qint32 hold_ms;
+    bool m_hold_ms_isSet;
+
+    qint64 center_frequency;
+    bool m_center_frequency_isSet;
+
+    float noise_floor_db;
+    bool m_noise_floor_db_isSet;
+
+    QList<SWGSpectrumActivitySignal*>* active_signals;
+    bool m_active_signals_isSet;
+
+};
+
+}
+
+#endif /* SWGSpectrumActivity_H_ */
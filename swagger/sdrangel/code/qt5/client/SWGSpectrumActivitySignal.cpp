@@ -0,0 +1,245 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGSpectrumActivitySignal.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGSpectrumActivitySignal::SWGSpectrumActivitySignal(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumActivitySignal::SWGSpectrumActivitySignal() {
+    id = 0;
+    m_id_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    bandwidth = 0;
+    m_bandwidth_isSet = false;
+    power_db = 0.0f;
+    m_power_db_isSet = false;
+    snr_db = 0.0f;
+    m_snr_db_isSet = false;
+    first_seen_ms = 0L;
+    m_first_seen_ms_isSet = false;
+    last_seen_ms = 0L;
+    m_last_seen_ms_isSet = false;
+}
+
+SWGSpectrumActivitySignal::~SWGSpectrumActivitySignal() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumActivitySignal::init() {
+    id = 0;
+    m_id_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    bandwidth = 0;
+    m_bandwidth_isSet = false;
+    power_db = 0.0f;
+    m_power_db_isSet = false;
+    snr_db = 0.0f;
+    m_snr_db_isSet = false;
+    first_seen_ms = 0L;
+    m_first_seen_ms_isSet = false;
+    last_seen_ms = 0L;
+    m_last_seen_ms_isSet = false;
+}
+
+void
+SWGSpectrumActivitySignal::cleanup() {
+
+
+
+
+
+
+
+}
+
+SWGSpectrumActivitySignal*
+SWGSpectrumActivitySignal::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumActivitySignal::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&id, pJson["id"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&bandwidth, pJson["bandwidth"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&power_db, pJson["powerDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&snr_db, pJson["snrDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&first_seen_ms, pJson["firstSeenMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&last_seen_ms, pJson["lastSeenMs"], "qint64", "");
+    
+}
+
+QString
+SWGSpectrumActivitySignal::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumActivitySignal::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_id_isSet){
+        obj->insert("id", QJsonValue(id));
+    }
+    if(m_center_frequency_isSet){
+        obj->insert("centerFrequency", QJsonValue(center_frequency));
+    }
+    if(m_bandwidth_isSet){
+        obj->insert("bandwidth", QJsonValue(bandwidth));
+    }
+    if(m_power_db_isSet){
+        obj->insert("powerDb", QJsonValue(power_db));
+    }
+    if(m_snr_db_isSet){
+        obj->insert("snrDb", QJsonValue(snr_db));
+    }
+    if(m_first_seen_ms_isSet){
+        obj->insert("firstSeenMs", QJsonValue(first_seen_ms));
+    }
+    if(m_last_seen_ms_isSet){
+        obj->insert("lastSeenMs", QJsonValue(last_seen_ms));
+    }
+
+    return obj;
+}
+
+qint32
+SWGSpectrumActivitySignal::getId() {
+    return id;
+}
+void
+SWGSpectrumActivitySignal::setId(qint32 id) {
+    this->id = id;
+    this->m_id_isSet = true;
+}
+
+qint64
+SWGSpectrumActivitySignal::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGSpectrumActivitySignal::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+    this->m_center_frequency_isSet = true;
+}
+
+qint32
+SWGSpectrumActivitySignal::getBandwidth() {
+    return bandwidth;
+}
+void
+SWGSpectrumActivitySignal::setBandwidth(qint32 bandwidth) {
+    this->bandwidth = bandwidth;
+    this->m_bandwidth_isSet = true;
+}
+
+float
+SWGSpectrumActivitySignal::getPowerDb() {
+    return power_db;
+}
+void
+SWGSpectrumActivitySignal::setPowerDb(float power_db) {
+    this->power_db = power_db;
+    this->m_power_db_isSet = true;
+}
+
+float
+SWGSpectrumActivitySignal::getSnrDb() {
+    return snr_db;
+}
+void
+SWGSpectrumActivitySignal::setSnrDb(float snr_db) {
+    this->snr_db = snr_db;
+    this->m_snr_db_isSet = true;
+}
+
+qint64
+SWGSpectrumActivitySignal::getFirstSeenMs() {
+    return first_seen_ms;
+}
+void
+SWGSpectrumActivitySignal::setFirstSeenMs(qint64 first_seen_ms) {
+    this->first_seen_ms = first_seen_ms;
+    this->m_first_seen_ms_isSet = true;
+}
+
+qint64
+SWGSpectrumActivitySignal::getLastSeenMs() {
+    return last_seen_ms;
+}
+void
+SWGSpectrumActivitySignal::setLastSeenMs(qint64 last_seen_ms) {
+    this->last_seen_ms = last_seen_ms;
+    this->m_last_seen_ms_isSet = true;
+}
+
+
+bool
+SWGSpectrumActivitySignal::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_id_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_center_frequency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_bandwidth_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_power_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_snr_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_first_seen_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_last_seen_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
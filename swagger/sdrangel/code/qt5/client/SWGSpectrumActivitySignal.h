@@ -0,0 +1,94 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumActivitySignal.h
+ *
+ * Signal detected by the spectrum activity detector
+ */
+
+#ifndef SWGSpectrumActivitySignal_H_
+#define SWGSpectrumActivitySignal_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGSpectrumActivitySignal: public SWGObject {
+public:
+    SWGSpectrumActivitySignal();
+    SWGSpectrumActivitySignal(QString* json);
+    virtual ~SWGSpectrumActivitySignal();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGSpectrumActivitySignal* fromJson(QString &jsonString) override;
+
+    qint32 getId();
+    void setId(qint32 id);
+
+    qint64 getCenterFrequency();
+    void setCenterFrequency(qint64 center_frequency);
+
+    qint32 getBandwidth();
+    void setBandwidth(qint32 bandwidth);
+
+    float getPowerDb();
+    void setPowerDb(float power_db);
+
+    float getSnrDb();
+    void setSnrDb(float snr_db);
+
+    qint64 getFirstSeenMs();
+    void setFirstSeenMs(qint64 first_seen_ms);
+
+    qint64 getLastSeenMs();
+    void setLastSeenMs(qint64 last_seen_ms);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 id;
+    bool m_id_isSet;
+
+    qint64 center_frequency;
+    bool m_center_frequency_isSet;
+
+    qint32 bandwidth;
+    bool m_bandwidth_isSet;
+
+    float power_db;
+    bool m_power_db_isSet;
+
+    float snr_db;
+    bool m_snr_db_isSet;
+
+    qint64 first_seen_ms;
+    bool m_first_seen_ms_isSet;
+
+    qint64 last_seen_ms;
+    bool m_last_seen_ms_isSet;
+
+};
+
+}
+
+#endif /* SWGSpectrumActivitySignal_H_ */
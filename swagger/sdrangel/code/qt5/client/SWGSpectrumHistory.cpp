@@ -0,0 +1,316 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGSpectrumHistory.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGSpectrumHistory::SWGSpectrumHistory(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumHistory::SWGSpectrumHistory() {
+    enable = 0;
+    m_enable_isSet = false;
+    file_name = nullptr;
+    m_file_name_isSet = false;
+    nb_bins = 0;
+    m_nb_bins_isSet = false;
+    capacity = 0;
+    m_capacity_isSet = false;
+    frame_interval_ms = 0;
+    m_frame_interval_ms_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    oldest_timestamp_ms = 0L;
+    m_oldest_timestamp_ms_isSet = false;
+    newest_timestamp_ms = 0L;
+    m_newest_timestamp_ms_isSet = false;
+    floor_db = 0.0f;
+    m_floor_db_isSet = false;
+    step_db = 0.0f;
+    m_step_db_isSet = false;
+}
+
+SWGSpectrumHistory::~SWGSpectrumHistory() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumHistory::init() {
+    enable = 0;
+    m_enable_isSet = false;
+    file_name = new QString("");
+    m_file_name_isSet = false;
+    nb_bins = 0;
+    m_nb_bins_isSet = false;
+    capacity = 0;
+    m_capacity_isSet = false;
+    frame_interval_ms = 0;
+    m_frame_interval_ms_isSet = false;
+    nb_frames = 0;
+    m_nb_frames_isSet = false;
+    oldest_timestamp_ms = 0L;
+    m_oldest_timestamp_ms_isSet = false;
+    newest_timestamp_ms = 0L;
+    m_newest_timestamp_ms_isSet = false;
+    floor_db = 0.0f;
+    m_floor_db_isSet = false;
+    step_db = 0.0f;
+    m_step_db_isSet = false;
+}
+
+void
+SWGSpectrumHistory::cleanup() {
+    if(file_name != nullptr) { 
+        delete file_name;
+    }
+
+
+
+
+
+
+
+
+
+}
+
+SWGSpectrumHistory*
+SWGSpectrumHistory::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumHistory::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&enable, pJson["enable"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&nb_bins, pJson["nbBins"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&capacity, pJson["capacity"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&frame_interval_ms, pJson["frameIntervalMs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_frames, pJson["nbFrames"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&oldest_timestamp_ms, pJson["oldestTimestampMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&newest_timestamp_ms, pJson["newestTimestampMs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&floor_db, pJson["floorDb"], "float", "");
+    
+    ::SWGSDRangel::setValue(&step_db, pJson["stepDb"], "float", "");
+    
+}
+
+QString
+SWGSpectrumHistory::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumHistory::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_enable_isSet){
+        obj->insert("enable", QJsonValue(enable));
+    }
+    if(file_name != nullptr && *file_name != QString("")){
+        toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
+    }
+    if(m_nb_bins_isSet){
+        obj->insert("nbBins", QJsonValue(nb_bins));
+    }
+    if(m_capacity_isSet){
+        obj->insert("capacity", QJsonValue(capacity));
+    }
+    if(m_frame_interval_ms_isSet){
+        obj->insert("frameIntervalMs", QJsonValue(frame_interval_ms));
+    }
+    if(m_nb_frames_isSet){
+        obj->insert("nbFrames", QJsonValue(nb_frames));
+    }
+    if(m_oldest_timestamp_ms_isSet){
+        obj->insert("oldestTimestampMs", QJsonValue(oldest_timestamp_ms));
+    }
+    if(m_newest_timestamp_ms_isSet){
+        obj->insert("newestTimestampMs", QJsonValue(newest_timestamp_ms));
+    }
+    if(m_floor_db_isSet){
+        obj->insert("floorDb", QJsonValue(floor_db));
+    }
+    if(m_step_db_isSet){
+        obj->insert("stepDb", QJsonValue(step_db));
+    }
+
+    return obj;
+}
+
+qint32
+SWGSpectrumHistory::getEnable() {
+    return enable;
+}
+void
+SWGSpectrumHistory::setEnable(qint32 enable) {
+    this->enable = enable;
+    this->m_enable_isSet = true;
+}
+
+QString*
+SWGSpectrumHistory::getFileName() {
+    return file_name;
+}
+void
+SWGSpectrumHistory::setFileName(QString* file_name) {
+    this->file_name = file_name;
+    this->m_file_name_isSet = true;
+}
+
+qint32
+SWGSpectrumHistory::getNbBins() {
+    return nb_bins;
+}
+void
+SWGSpectrumHistory::setNbBins(qint32 nb_bins) {
+    this->nb_bins = nb_bins;
+    this->m_nb_bins_isSet = true;
+}
+
+qint32
+SWGSpectrumHistory::getCapacity() {
+    return capacity;
+}
+void
+SWGSpectrumHistory::setCapacity(qint32 capacity) {
+    this->capacity = capacity;
+    this->m_capacity_isSet = true;
+}
+
+qint32
+SWGSpectrumHistory::getFrameIntervalMs() {
+    return frame_interval_ms;
+}
+void
+SWGSpectrumHistory::setFrameIntervalMs(qint32 frame_interval_ms) {
+    this->frame_interval_ms = frame_interval_ms;
+    this->m_frame_interval_ms_isSet = true;
+}
+
+qint32
+SWGSpectrumHistory::getNbFrames() {
+    return nb_frames;
+}
+void
+SWGSpectrumHistory::setNbFrames(qint32 nb_frames) {
+    this->nb_frames = nb_frames;
+    this->m_nb_frames_isSet = true;
+}
+
+qint64
+SWGSpectrumHistory::getOldestTimestampMs() {
+    return oldest_timestamp_ms;
+}
+void
+SWGSpectrumHistory::setOldestTimestampMs(qint64 oldest_timestamp_ms) {
+    this->oldest_timestamp_ms = oldest_timestamp_ms;
+    this->m_oldest_timestamp_ms_isSet = true;
+}
+
+qint64
+SWGSpectrumHistory::getNewestTimestampMs() {
+    return newest_timestamp_ms;
+}
+void
+SWGSpectrumHistory::setNewestTimestampMs(qint64 newest_timestamp_ms) {
+    this->newest_timestamp_ms = newest_timestamp_ms;
+    this->m_newest_timestamp_ms_isSet = true;
+}
+
+float
+SWGSpectrumHistory::getFloorDb() {
+    return floor_db;
+}
+void
+SWGSpectrumHistory::setFloorDb(float floor_db) {
+    this->floor_db = floor_db;
+    this->m_floor_db_isSet = true;
+}
+
+float
+SWGSpectrumHistory::getStepDb() {
+    return step_db;
+}
+void
+SWGSpectrumHistory::setStepDb(float step_db) {
+    this->step_db = step_db;
+    this->m_step_db_isSet = true;
+}
+
+
+bool
+SWGSpectrumHistory::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_enable_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(file_name && *file_name != QString("")){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_bins_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_capacity_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_frame_interval_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_nb_frames_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_oldest_timestamp_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_newest_timestamp_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_floor_db_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_step_db_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,113 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumHistory.h
+ *
+ * Spectrum history store settings and status
+ */
+
+#ifndef SWGSpectrumHistory_H_
+#define SWGSpectrumHistory_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGSpectrumHistory: public SWGObject {
+public:
+    SWGSpectrumHistory();
+    SWGSpectrumHistory(QString* json);
+    virtual ~SWGSpectrumHistory();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGSpectrumHistory* fromJson(QString &jsonString) override;
+
+    qint32 getEnable();
+    void setEnable(qint32 enable);
+
+    QString* getFileName();
+    void setFileName(QString* file_name);
+
+    qint32 getNbBins();
+    void setNbBins(qint32 nb_bins);
+
+    qint32 getCapacity();
+    void setCapacity(qint32 capacity);
+
+    qint32 getFrameIntervalMs();
+    void setFrameIntervalMs(qint32 frame_interval_ms);
+
+    qint32 getNbFrames();
+    void setNbFrames(qint32 nb_frames);
+
+    qint64 getOldestTimestampMs();
+    void setOldestTimestampMs(qint64 oldest_timestamp_ms);
+
+    qint64 getNewestTimestampMs();
+    void setNewestTimestampMs(qint64 newest_timestamp_ms);
+
+    float getFloorDb();
+    void setFloorDb(float floor_db);
+
+    float getStepDb();
+    void setStepDb(float step_db);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 enable;
+    bool m_enable_isSet;
+
+    QString* file_name;
+    bool m_file_name_isSet;
+
+    qint32 nb_bins;
+    bool m_nb_bins_isSet;
+
+    qint32 capacity;
+    bool m_capacity_isSet;
+
+    qint32 frame_interval_ms;
+    bool m_frame_interval_ms_isSet;
+
+    qint32 nb_frames;
+    bool m_nb_frames_isSet;
+
+    qint64 oldest_timestamp_ms;
+    bool m_oldest_timestamp_ms_isSet;
+
+    qint64 newest_timestamp_ms;
+    bool m_newest_timestamp_ms_isSet;
+
+    float floor_db;
+    bool m_floor_db_isSet;
+
+    float step_db;
+    bool m_step_db_isSet;
+
+};
+
+}
+
+#endif /* SWGSpectrumHistory_H_ */
@@ -0,0 +1,314 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+#include "SWGSpectrumWaterfall.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGSpectrumWaterfall::SWGSpectrumWaterfall(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumWaterfall::SWGSpectrumWaterfall() {
+    enable = 0;
+    m_enable_isSet = false;
+    width = 0;
+    m_width_isSet = false;
+    height = 0;
+    m_height_isSet = false;
+    ref_level = 0.0f;
+    m_ref_level_isSet = false;
+    power_range = 0.0f;
+    m_power_range_isSet = false;
+    rows = 0;
+    m_rows_isSet = false;
+    frames_dropped = 0;
+    m_frames_dropped_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    newest_timestamp_ms = 0L;
+    m_newest_timestamp_ms_isSet = false;
+}
+
+SWGSpectrumWaterfall::~SWGSpectrumWaterfall() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumWaterfall::init() {
+    enable = 0;
+    m_enable_isSet = false;
+    width = 0;
+    m_width_isSet = false;
+    height = 0;
+    m_height_isSet = false;
+    ref_level = 0.0f;
+    m_ref_level_isSet = false;
+    power_range = 0.0f;
+    m_power_range_isSet = false;
+    rows = 0;
+    m_rows_isSet = false;
+    frames_dropped = 0;
+    m_frames_dropped_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    newest_timestamp_ms = 0L;
+    m_newest_timestamp_ms_isSet = false;
+}
+
+void
+SWGSpectrumWaterfall::cleanup() {
+
+
+
+
+
+
+
+
+
+
+}
+
+SWGSpectrumWaterfall*
+SWGSpectrumWaterfall::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumWaterfall::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&enable, pJson["enable"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&width, pJson["width"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&height, pJson["height"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&ref_level, pJson["refLevel"], "float", "");
+    
+    ::SWGSDRangel::setValue(&power_range, pJson["powerRange"], "float", "");
+    
+    ::SWGSDRangel::setValue(&rows, pJson["rows"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&frames_dropped, pJson["framesDropped"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&sample_rate, pJson["sampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&newest_timestamp_ms, pJson["newestTimestampMs"], "qint64", "");
+    
+}
+
+QString
+SWGSpectrumWaterfall::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumWaterfall::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_enable_isSet){
+        obj->insert("enable", QJsonValue(enable));
+    }
+    if(m_width_isSet){
+        obj->insert("width", QJsonValue(width));
+    }
+    if(m_height_isSet){
+        obj->insert("height", QJsonValue(height));
+    }
+    if(m_ref_level_isSet){
+        obj->insert("refLevel", QJsonValue(ref_level));
+    }
+    if(m_power_range_isSet){
+        obj->insert("powerRange", QJsonValue(power_range));
+    }
+    if(m_rows_isSet){
+        obj->insert("rows", QJsonValue(rows));
+    }
+    if(m_frames_dropped_isSet){
+        obj->insert("framesDropped", QJsonValue(frames_dropped));
+    }
+    if(m_center_frequency_isSet){
+        obj->insert("centerFrequency", QJsonValue(center_frequency));
+    }
+    if(m_sample_rate_isSet){
+        obj->insert("sampleRate", QJsonValue(sample_rate));
+    }
+    if(m_newest_timestamp_ms_isSet){
+        obj->insert("newestTimestampMs", QJsonValue(newest_timestamp_ms));
+    }
+
+    return obj;
+}
+
+qint32
+SWGSpectrumWaterfall::getEnable() {
+    return enable;
+}
+void
+SWGSpectrumWaterfall::setEnable(qint32 enable) {
+    this->enable = enable;
+    this->m_enable_isSet = true;
+}
+
+qint32
+SWGSpectrumWaterfall::getWidth() {
+    return width;
+}
+void
+SWGSpectrumWaterfall::setWidth(qint32 width) {
+    this->width = width;
+    this->m_width_isSet = true;
+}
+
+qint32
+SWGSpectrumWaterfall::getHeight() {
+    return height;
+}
+void
+SWGSpectrumWaterfall::setHeight(qint32 height) {
+    this->height = height;
+    this->m_height_isSet = true;
+}
+
+float
+SWGSpectrumWaterfall::getRefLevel() {
+    return ref_level;
+}
+void
+SWGSpectrumWaterfall::setRefLevel(float ref_level) {
+    this->ref_level = ref_level;
+    this->m_ref_level_isSet = true;
+}
+
+float
+SWGSpectrumWaterfall::getPowerRange() {
+    return power_range;
+}
+void
+SWGSpectrumWaterfall::setPowerRange(float power_range) {
+    this->power_range = power_range;
+    this->m_power_range_isSet = true;
+}
+
+qint32
+SWGSpectrumWaterfall::getRows() {
+    return rows;
+}
+void
+SWGSpectrumWaterfall::setRows(qint32 rows) {
+    this->rows = rows;
+    this->m_rows_isSet = true;
+}
+
+qint32
+SWGSpectrumWaterfall::getFramesDropped() {
+    return frames_dropped;
+}
+void
+SWGSpectrumWaterfall::setFramesDropped(qint32 frames_dropped) {
+    this->frames_dropped = frames_dropped;
+    this->m_frames_dropped_isSet = true;
+}
+
+qint64
+SWGSpectrumWaterfall::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGSpectrumWaterfall::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+    this->m_center_frequency_isSet = true;
+}
+
+qint32
+SWGSpectrumWaterfall::getSampleRate() {
+    return sample_rate;
+}
+void
+SWGSpectrumWaterfall::setSampleRate(qint32 sample_rate) {
+    this->sample_rate = sample_rate;
+    this->m_sample_rate_isSet = true;
+}
+
+qint64
+SWGSpectrumWaterfall::getNewestTimestampMs() {
+    return newest_timestamp_ms;
+}
+void
+SWGSpectrumWaterfall::setNewestTimestampMs(qint64 newest_timestamp_ms) {
+    this->newest_timestamp_ms = newest_timestamp_ms;
+    this->m_newest_timestamp_ms_isSet = true;
+}
+
+
+bool
+SWGSpectrumWaterfall::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_enable_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_width_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_height_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_ref_level_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_power_range_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_rows_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_frames_dropped_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_center_frequency_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_sample_rate_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_newest_timestamp_ms_isSet){
+            isObjectUpdated = true; break;
+        }
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,112 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.14.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumWaterfall.h
+ *
+ * Headless spectrum waterfall renderer settings and status
+ */
+
+#ifndef SWGSpectrumWaterfall_H_
+#define SWGSpectrumWaterfall_H_
+
+#include <QJsonObject>
+
+
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGSpectrumWaterfall: public SWGObject {
+public:
+    SWGSpectrumWaterfall();
+    SWGSpectrumWaterfall(QString* json);
+    virtual ~SWGSpectrumWaterfall();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGSpectrumWaterfall* fromJson(QString &jsonString) override;
+
+    qint32 getEnable();
+    void setEnable(qint32 enable);
+
+    qint32 getWidth();
+    void setWidth(qint32 width);
+
+    qint32 getHeight();
+    void setHeight(qint32 height);
+
+    float getRefLevel();
+    void setRefLevel(float ref_level);
+
+    float getPowerRange();
+    void setPowerRange(float power_range);
+
+    qint32 getRows();
+    void setRows(qint32 rows);
+
+    qint32 getFramesDropped();
+    void setFramesDropped(qint32 frames_dropped);
+
+    qint64 getCenterFrequency();
+    void setCenterFrequency(qint64 center_frequency);
+
+    qint32 getSampleRate();
+    void setSampleRate(qint32 sample_rate);
+
+    qint64 getNewestTimestampMs();
+    void setNewestTimestampMs(qint64 newest_timestamp_ms);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 enable;
+    bool m_enable_isSet;
+
+    qint32 width;
+    bool m_width_isSet;
+
+    qint32 height;
+    bool m_height_isSet;
+
+    float ref_level;
+    bool m_ref_level_isSet;
+
+    float power_range;
+    bool m_power_range_isSet;
+
+    qint32 rows;
+    bool m_rows_isSet;
+
+    qint32 frames_dropped;
+    bool m_frames_dropped_isSet;
+
+    qint64 center_frequency;
+    bool m_center_frequency_isSet;
+
+    qint32 sample_rate;
+    bool m_sample_rate_isSet;
+
+    qint64 newest_timestamp_ms;
+    bool m_newest_timestamp_ms_isSet;
+
+};
+
+}
+
+#endif /* SWGSpectrumWaterfall_H_ */
@@ -62,6 +62,10 @@ SWGUDPSinkSettings::SWGUDPSinkSettings() {
     m_udp_port_isSet = false;
     audio_port = 0;
     m_audio_port_isSet = false;
+    datagram_size = 0;
+    m_datagram_size_isSet = false;
+    multicast_ttl = 0;
+    m_multicast_ttl_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = nullptr;
@@ -120,6 +124,10 @@ SWGUDPSinkSettings::init() {
     m_udp_port_isSet = false;
     audio_port = 0;
     m_audio_port_isSet = false;
+    datagram_size = 0;
+    m_datagram_size_isSet = false;
+    multicast_ttl = 0;
+    m_multicast_ttl_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = new QString("");
@@ -160,6 +168,8 @@ SWGUDPSinkSettings::cleanup() {
 
 
 
+
+
     if(title != nullptr) { 
         delete title;
     }
@@ -218,6 +228,10 @@ SWGUDPSinkSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&audio_port, pJson["audioPort"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&datagram_size, pJson["datagramSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&multicast_ttl, pJson["multicastTTL"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&rgb_color, pJson["rgbColor"], "qint32", "");
     
     ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
@@ -301,6 +315,12 @@ SWGUDPSinkSettings::asJsonObject() {
     if(m_audio_port_isSet){
         obj->insert("audioPort", QJsonValue(audio_port));
     }
+    if(m_datagram_size_isSet){
+        obj->insert("datagramSize", QJsonValue(datagram_size));
+    }
+    if(m_multicast_ttl_isSet){
+        obj->insert("multicastTTL", QJsonValue(multicast_ttl));
+    }
     if(m_rgb_color_isSet){
         obj->insert("rgbColor", QJsonValue(rgb_color));
     }
@@ -499,6 +519,26 @@ SWGUDPSinkSettings::setAudioPort(qint32 audio_port) {
     this->m_audio_port_isSet = true;
 }
 
+qint32
+SWGUDPSinkSettings::getDatagramSize() {
+    return datagram_size;
+}
+void
+SWGUDPSinkSettings::setDatagramSize(qint32 datagram_size) {
+    this->datagram_size = datagram_size;
+    this->m_datagram_size_isSet = true;
+}
+
+qint32
+SWGUDPSinkSettings::getMulticastTtl() {
+    return multicast_ttl;
+}
+void
+SWGUDPSinkSettings::setMulticastTtl(qint32 multicast_ttl) {
+    this->multicast_ttl = multicast_ttl;
+    this->m_multicast_ttl_isSet = true;
+}
+
 qint32
 SWGUDPSinkSettings::getRgbColor() {
     return rgb_color;
@@ -635,6 +675,12 @@ SWGUDPSinkSettings::isSet(){
         if(m_audio_port_isSet){
             isObjectUpdated = true; break;
         }
+        if(m_datagram_size_isSet){
+            isObjectUpdated = true; break;
+        }
+        if(m_multicast_ttl_isSet){
+            isObjectUpdated = true; break;
+        }
         if(m_rgb_color_isSet){
             isObjectUpdated = true; break;
         }
@@ -93,6 +93,12 @@ public:
     qint32 getAudioPort();
     void setAudioPort(qint32 audio_port);
 
+    qint32 getDatagramSize();
+    void setDatagramSize(qint32 datagram_size);
+
+    qint32 getMulticastTtl();
+    void setMulticastTtl(qint32 multicast_ttl);
+
     qint32 getRgbColor();
     void setRgbColor(qint32 rgb_color);
 
@@ -172,6 +178,12 @@ private:
     qint32 audio_port;
     bool m_audio_port_isSet;
 
+    qint32 datagram_size;
+    bool m_datagram_size_isSet;
+
+    qint32 multicast_ttl;
+    bool m_multicast_ttl_isSet;
+
     qint32 rgb_color;
     bool m_rgb_color_isSet;
 